@@ -48,6 +48,16 @@ run_benchmark() {
   ${CMD_LINE_CLIENT}
 }
 
+run_mt_benchmark() {
+  SERVER_PORT=$1
+  WORKER_MODE=$2
+
+  CMD_LINE="timeout 1m ${BINARY_PATH}/benchmarks/libucxx/ucxx_mt_perftest -T 4 -E 4 -n 100 -x ${WORKER_MODE} -p ${SERVER_PORT}"
+
+  log_command "${CMD_LINE}"
+  UCX_TCP_CM_REUSEADDR=y ${CMD_LINE}
+}
+
 run_example() {
   SERVER_PORT=$1
   PROGRESS_MODE=$2
@@ -71,6 +81,8 @@ run_port_retry() {
 
     if [[ "${RUN_TYPE}" == "benchmark" ]]; then
       run_benchmark ${_SERVER_PORT} ${PROGRESS_MODE}
+    elif [[ "${RUN_TYPE}" == "mt_benchmark" ]]; then
+      run_mt_benchmark ${_SERVER_PORT} ${PROGRESS_MODE}
     elif [[ "${RUN_TYPE}" == "example" ]]; then
       run_example ${_SERVER_PORT} ${PROGRESS_MODE}
     else
@@ -113,6 +125,8 @@ run_port_retry 10 "benchmark" "blocking"
 run_port_retry 10 "benchmark" "thread-polling"
 run_port_retry 10 "benchmark" "thread-blocking"
 run_port_retry 10 "benchmark" "wait"
+run_port_retry 10 "mt_benchmark" "shared"
+run_port_retry 10 "mt_benchmark" "per-thread"
 
 rapids-logger "C++ Examples"
 # run_port_retry MAX_ATTEMPTS RUN_TYPE PROGRESS_MODE
@@ -0,0 +1,192 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ucxx/api.h>
+#include <ucxx/delayed_submission.h>
+
+namespace {
+
+/**
+ * @brief Loopback context shared by all benchmarks.
+ *
+ * A context, worker and an endpoint connected to the worker itself, created once since
+ * their creation is much more expensive than any of the operations being benchmarked.
+ */
+class Loopback {
+ public:
+  std::shared_ptr<ucxx::Context> context{nullptr};
+  std::shared_ptr<ucxx::Worker> worker{nullptr};
+  std::shared_ptr<ucxx::Worker> delayedWorker{nullptr};
+  std::shared_ptr<ucxx::Endpoint> endpoint{nullptr};
+  std::shared_ptr<ucxx::Endpoint> delayedEndpoint{nullptr};
+
+  Loopback()
+    : context{ucxx::createContext({}, ucxx::Context::defaultFeatureFlags)},
+      worker{context->createWorker()},
+      delayedWorker{context->createWorker(true)},
+      endpoint{worker->createEndpointFromWorkerAddress(worker->getAddress())},
+      delayedEndpoint{delayedWorker->createEndpointFromWorkerAddress(delayedWorker->getAddress())}
+  {
+  }
+
+  static Loopback& get()
+  {
+    static Loopback loopback;
+    return loopback;
+  }
+};
+
+void waitRequests(std::shared_ptr<ucxx::Worker> worker,
+                  const std::vector<std::shared_ptr<ucxx::Request>>& requests)
+{
+  for (auto& r : requests) {
+    while (!r->isCompleted())
+      worker->progress();
+    r->checkError();
+  }
+}
+
+std::vector<std::shared_ptr<ucxx::Request>> completedRequests(size_t count)
+{
+  auto& loopback = Loopback::get();
+  std::vector<int> buffer(1);
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  for (size_t i = 0; i < count; ++i) {
+    requests.push_back(loopback.endpoint->tagSend(buffer.data(), sizeof(int), ucxx::Tag{0}));
+    requests.push_back(loopback.endpoint->tagRecv(
+      buffer.data(), sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull));
+  }
+  waitRequests(loopback.worker, requests);
+  return requests;
+}
+
+void BM_HeaderBuildHeaders(benchmark::State& state)
+{
+  const std::vector<size_t> size(state.range(0), 1024);
+  const std::vector<int> isCUDA(state.range(0), 0);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(ucxx::Header::buildHeaders(size, isCUDA));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HeaderBuildHeaders)->RangeMultiplier(4)->Range(1, 1024);
+
+void BM_HeaderSerialize(benchmark::State& state)
+{
+  const std::vector<size_t> size(state.range(0), 1024);
+  const std::vector<int> isCUDA(state.range(0), 0);
+  const auto header = ucxx::Header::buildHeaders(size, isCUDA).front();
+  std::vector<char> serialized(ucxx::Header::dataSize());
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+      header.serialize(serialized.data(), serialized.size(), ucxx::HeaderFormat::Compact));
+  state.SetBytesProcessed(state.iterations() * header.serializedSize(ucxx::HeaderFormat::Compact));
+}
+BENCHMARK(BM_HeaderSerialize)->RangeMultiplier(4)->Range(1, ucxx::HeaderFramesSize);
+
+void BM_HeaderDeserialize(benchmark::State& state)
+{
+  const std::vector<size_t> size(state.range(0), 1024);
+  const std::vector<int> isCUDA(state.range(0), 0);
+  const auto header = ucxx::Header::buildHeaders(size, isCUDA).front();
+  std::vector<char> serialized(header.serializedSize(ucxx::HeaderFormat::Compact));
+  header.serialize(serialized.data(), serialized.size(), ucxx::HeaderFormat::Compact);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(ucxx::Header(serialized.data(), serialized.size()));
+  state.SetBytesProcessed(state.iterations() * serialized.size());
+}
+BENCHMARK(BM_HeaderDeserialize)->RangeMultiplier(4)->Range(1, ucxx::HeaderFramesSize);
+
+void BM_InflightRequestsInsertRemove(benchmark::State& state)
+{
+  const auto requests = completedRequests(state.range(0) / 2);
+
+  for (auto _ : state) {
+    ucxx::InflightRequests inflightRequests;
+    for (const auto& r : requests)
+      inflightRequests.insert(r);
+    for (const auto& r : requests)
+      inflightRequests.remove(r.get());
+  }
+  state.SetItemsProcessed(state.iterations() * requests.size());
+}
+BENCHMARK(BM_InflightRequestsInsertRemove)->RangeMultiplier(8)->Range(2, 4096);
+
+void BM_DelayedSubmissionScheduleProcess(benchmark::State& state)
+{
+  ucxx::DelayedSubmissionCollection delayedSubmissionCollection{false};
+  size_t processed = 0;
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i)
+      delayedSubmissionCollection.registerGenericPre([&processed]() { ++processed; });
+    delayedSubmissionCollection.processPre();
+  }
+  benchmark::DoNotOptimize(processed);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DelayedSubmissionScheduleProcess)->RangeMultiplier(8)->Range(1, 4096);
+
+void BM_RequestConstruction(benchmark::State& state)
+{
+  // Requests are only submitted when the worker with delayed submission enabled is
+  // progressed, which is excluded from the measurement
+  auto& loopback = Loopback::get();
+  std::vector<int> buffer(1);
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.reserve(2 * state.range(0));
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      requests.push_back(
+        loopback.delayedEndpoint->tagSend(buffer.data(), sizeof(int), ucxx::Tag{0}));
+      requests.push_back(loopback.delayedEndpoint->tagRecv(
+        buffer.data(), sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull));
+    }
+
+    state.PauseTiming();
+    waitRequests(loopback.delayedWorker, requests);
+    requests.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * 2 * state.range(0));
+}
+BENCHMARK(BM_RequestConstruction)->RangeMultiplier(8)->Range(1, 512);
+
+void BM_TagSendRecvLoopback(benchmark::State& state)
+{
+  auto& loopback = Loopback::get();
+  std::vector<char> sendBuffer(state.range(0), 0xaa);
+  std::vector<char> recvBuffer(state.range(0));
+
+  for (auto _ : state) {
+    std::vector<std::shared_ptr<ucxx::Request>> requests{
+      loopback.endpoint->tagSend(sendBuffer.data(), sendBuffer.size(), ucxx::Tag{0}),
+      loopback.endpoint->tagRecv(
+        recvBuffer.data(), recvBuffer.size(), ucxx::Tag{0}, ucxx::TagMaskFull)};
+    waitRequests(loopback.worker, requests);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TagSendRecvLoopback)->RangeMultiplier(64)->Range(8, 8 << 18);
+
+void BM_AllocateBuffer(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(ucxx::allocateBuffer(ucxx::BufferType::Host, state.range(0)));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AllocateBuffer)->RangeMultiplier(64)->Range(8, 8 << 18);
+
+}  // namespace
+
+BENCHMARK_MAIN();
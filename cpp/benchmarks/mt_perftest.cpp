@@ -0,0 +1,413 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <unistd.h>  // for getopt, optarg
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ucxx/api.h>
+
+enum class TransferType {
+  Tag,
+  Am,
+  Stream,
+};
+
+enum class WorkerMode {
+  Shared,
+  PerThread,
+};
+
+struct app_context_t {
+  TransferType transfer_type = TransferType::Tag;
+  WorkerMode worker_mode     = WorkerMode::Shared;
+  uint16_t listener_port     = 12345;
+  size_t n_threads           = 4;
+  size_t n_endpoints         = 1;
+  size_t message_size        = 8;
+  size_t n_iter              = 1000;
+  bool delayed_submission    = false;
+};
+
+struct thread_result_t {
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point stop;
+  size_t messages{0};
+};
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief Server accepting connections from all clients of all threads.
+ *
+ * Holds the server-side endpoint of every client connection, which are all created on the
+ * same worker, the server is thus a single worker handling all client endpoints.
+ */
+class ServerContext {
+ private:
+  std::shared_ptr<ucxx::Listener> _listener{nullptr};
+  std::vector<std::shared_ptr<ucxx::Endpoint>> _endpoints{};
+  std::mutex _mutex{};
+
+ public:
+  void setListener(std::shared_ptr<ucxx::Listener> listener) { _listener = listener; }
+
+  void createEndpointFromConnRequest(ucp_conn_request_h conn_request)
+  {
+    auto endpoint = _listener->createEndpointFromConnRequest(conn_request, true);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _endpoints.push_back(endpoint);
+  }
+
+  size_t getEndpointCount()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _endpoints.size();
+  }
+
+  std::vector<std::shared_ptr<ucxx::Endpoint>> getEndpoints()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _endpoints;
+  }
+};
+
+static void listener_cb(ucp_conn_request_h conn_request, void* arg)
+{
+  reinterpret_cast<ServerContext*>(arg)->createEndpointFromConnRequest(conn_request);
+}
+
+static void printUsage()
+{
+  std::cerr << " multi-threaded, multi-endpoint scaling benchmark" << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "Usage: ucxx_mt_perftest [options]" << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "A server worker and T client threads with E endpoints each are created in the"
+            << std::endl;
+  std::cerr << "same process, clients connect to the server over the loopback interface and"
+            << std::endl;
+  std::cerr << "each endpoint sends one message per iteration to the server." << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "Parameters are:" << std::endl;
+  std::cerr << "  -o <type>   transfer type to use, valid values are: 'tag', 'am' and 'stream'"
+            << std::endl;
+  std::cerr << "              (default: 'tag')" << std::endl;
+  std::cerr << "  -x <mode>   client worker mode, valid values are: 'shared' (one worker with a"
+            << std::endl;
+  std::cerr << "              progress thread shared by all threads) and 'per-thread' (each"
+            << std::endl;
+  std::cerr << "              thread progresses its own worker) (default: 'shared')" << std::endl;
+  std::cerr << "  -D          use delayed submission on the shared worker (disabled)" << std::endl;
+  std::cerr << "  -T <int>    number of client threads (4)" << std::endl;
+  std::cerr << "  -E <int>    number of endpoints per client thread (1)" << std::endl;
+  std::cerr << "  -p <port>   port number to listen at (12345)" << std::endl;
+  std::cerr << "  -s <bytes>  message size (8)" << std::endl;
+  std::cerr << "  -n <int>    number of iterations to run (1000)" << std::endl;
+  std::cerr << "  -h          print this help" << std::endl;
+  std::cerr << std::endl;
+}
+
+ucs_status_t parseCommand(app_context_t* app_context, int argc, char* const argv[])
+{
+  optind = 1;
+  int c;
+  while ((c = getopt(argc, argv, "o:x:DT:E:p:s:n:h")) != -1) {
+    switch (c) {
+      case 'o':
+        if (strcmp(optarg, "tag") == 0) {
+          app_context->transfer_type = TransferType::Tag;
+          break;
+        } else if (strcmp(optarg, "am") == 0) {
+          app_context->transfer_type = TransferType::Am;
+          break;
+        } else if (strcmp(optarg, "stream") == 0) {
+          app_context->transfer_type = TransferType::Stream;
+          break;
+        } else {
+          std::cerr << "Invalid transfer type: " << optarg << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+      case 'x':
+        if (strcmp(optarg, "shared") == 0) {
+          app_context->worker_mode = WorkerMode::Shared;
+          break;
+        } else if (strcmp(optarg, "per-thread") == 0) {
+          app_context->worker_mode = WorkerMode::PerThread;
+          break;
+        } else {
+          std::cerr << "Invalid worker mode: " << optarg << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+      case 'D': app_context->delayed_submission = true; break;
+      case 'T':
+        app_context->n_threads = atoi(optarg);
+        if (app_context->n_threads <= 0) {
+          std::cerr << "Wrong number of threads: " << app_context->n_threads << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+        break;
+      case 'E':
+        app_context->n_endpoints = atoi(optarg);
+        if (app_context->n_endpoints <= 0) {
+          std::cerr << "Wrong number of endpoints: " << app_context->n_endpoints << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+        break;
+      case 'p':
+        app_context->listener_port = atoi(optarg);
+        if (app_context->listener_port <= 0) {
+          std::cerr << "Wrong listener port: " << app_context->listener_port << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+        break;
+      case 's':
+        app_context->message_size = atoi(optarg);
+        if (app_context->message_size <= 0) {
+          std::cerr << "Wrong message size: " << app_context->message_size << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+        break;
+      case 'n':
+        app_context->n_iter = atoi(optarg);
+        if (app_context->n_iter <= 0) {
+          std::cerr << "Wrong number of iterations: " << app_context->n_iter << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+        break;
+      case 'h':
+      default: printUsage(); return UCS_ERR_INVALID_PARAM;
+    }
+  }
+
+  if (app_context->delayed_submission && app_context->worker_mode != WorkerMode::Shared) {
+    std::cerr << "Delayed submission requires the 'shared' worker mode" << std::endl;
+    return UCS_ERR_INVALID_PARAM;
+  }
+
+  return UCS_OK;
+}
+
+void waitRequests(std::shared_ptr<ucxx::Worker> worker,
+                  const std::vector<std::shared_ptr<ucxx::Request>>& requests,
+                  bool progress)
+{
+  for (auto& r : requests) {
+    while (!r->isCompleted())
+      if (progress) worker->progress();
+    r->checkError();
+  }
+}
+
+std::string parseMessageRate(double rate)
+{
+  if (rate < 1e3)
+    return std::to_string(rate) + std::string("msg/s");
+  else if (rate < 1e6)
+    return std::to_string(rate / 1e3) + std::string("Kmsg/s");
+  else
+    return std::to_string(rate / 1e6) + std::string("Mmsg/s");
+}
+
+std::string parseBandwidth(double bw)
+{
+  if (bw < 1024)
+    return std::to_string(bw) + std::string("B/s");
+  else if (bw < (1024 * 1024))
+    return std::to_string(bw / 1024) + std::string("KB/s");
+  else if (bw < (1024 * 1024 * 1024))
+    return std::to_string(bw / (1024 * 1024)) + std::string("MB/s");
+  else
+    return std::to_string(bw / (1024 * 1024 * 1024)) + std::string("GB/s");
+}
+
+std::shared_ptr<ucxx::Request> postSend(const app_context_t& app_context,
+                                        std::shared_ptr<ucxx::Endpoint> endpoint,
+                                        std::vector<char>& buffer)
+{
+  switch (app_context.transfer_type) {
+    case TransferType::Am:
+      return endpoint->amSend(buffer.data(), buffer.size(), UCS_MEMORY_TYPE_HOST);
+    case TransferType::Stream: return endpoint->streamSend(buffer.data(), buffer.size(), false);
+    case TransferType::Tag:
+    default: return endpoint->tagSend(buffer.data(), buffer.size(), ucxx::Tag{0});
+  }
+}
+
+std::shared_ptr<ucxx::Request> postRecv(const app_context_t& app_context,
+                                        std::shared_ptr<ucxx::Worker> worker,
+                                        std::shared_ptr<ucxx::Endpoint> endpoint,
+                                        std::vector<char>& buffer)
+{
+  switch (app_context.transfer_type) {
+    case TransferType::Am: return endpoint->amRecv();
+    case TransferType::Stream: return endpoint->streamRecv(buffer.data(), buffer.size(), false);
+    case TransferType::Tag:
+    default:
+      // Tag receives are matched by the worker, regardless of which endpoint sent them
+      return worker->tagRecv(buffer.data(), buffer.size(), ucxx::Tag{0}, ucxx::TagMaskFull);
+  }
+}
+
+/**
+ * @brief Receive all messages sent by all clients.
+ *
+ * Receive `n_iter` rounds of one message per client endpoint, the server worker is
+ * progressed by its progress thread.
+ */
+void runServer(const app_context_t& app_context,
+               std::shared_ptr<ucxx::Worker> worker,
+               std::vector<std::shared_ptr<ucxx::Endpoint>> endpoints)
+{
+  std::vector<std::vector<char>> buffers(endpoints.size(),
+                                         std::vector<char>(app_context.message_size));
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.reserve(endpoints.size());
+
+  for (size_t n = 0; n < app_context.n_iter; ++n) {
+    for (size_t i = 0; i < endpoints.size(); ++i)
+      requests.push_back(postRecv(app_context, worker, endpoints[i], buffers[i]));
+    waitRequests(worker, requests, false);
+    requests.clear();
+  }
+}
+
+/**
+ * @brief Send messages from all endpoints of a client thread.
+ *
+ * Each iteration sends one message from each of the thread's endpoints and waits for all of
+ * them to complete, progressing the worker unless it is progressed by a progress thread.
+ */
+void runClient(const app_context_t& app_context,
+               std::shared_ptr<ucxx::Worker> worker,
+               std::vector<std::shared_ptr<ucxx::Endpoint>> endpoints,
+               std::atomic<bool>& startFlag,
+               thread_result_t& result)
+{
+  const bool progress = app_context.worker_mode == WorkerMode::PerThread;
+  std::vector<char> buffer(app_context.message_size, 0xaa);
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.reserve(endpoints.size());
+
+  while (!startFlag)
+    if (progress) worker->progress();
+
+  result.start = Clock::now();
+  for (size_t n = 0; n < app_context.n_iter; ++n) {
+    for (auto& endpoint : endpoints)
+      requests.push_back(postSend(app_context, endpoint, buffer));
+    waitRequests(worker, requests, progress);
+    requests.clear();
+  }
+  result.stop     = Clock::now();
+  result.messages = app_context.n_iter * endpoints.size();
+}
+
+int main(int argc, char** argv)
+{
+  app_context_t app_context;
+  if (parseCommand(&app_context, argc, argv) != UCS_OK) return -1;
+
+  auto context      = ucxx::createContext({}, ucxx::Context::defaultFeatureFlags);
+  auto serverWorker = context->createWorker();
+  auto serverCtx    = std::make_shared<ServerContext>();
+  serverCtx->setListener(
+    serverWorker->createListener(app_context.listener_port, listener_cb, serverCtx.get()));
+  serverWorker->startProgressThread(true);
+
+  // Create client workers, a single one shared by all threads or one per thread
+  std::vector<std::shared_ptr<ucxx::Worker>> clientWorkers;
+  if (app_context.worker_mode == WorkerMode::Shared) {
+    auto worker = context->createWorker(app_context.delayed_submission);
+    worker->startProgressThread(true);
+    clientWorkers.assign(app_context.n_threads, worker);
+  } else {
+    for (size_t t = 0; t < app_context.n_threads; ++t)
+      clientWorkers.push_back(context->createWorker());
+  }
+
+  std::vector<std::vector<std::shared_ptr<ucxx::Endpoint>>> clientEndpoints(
+    app_context.n_threads);
+  for (size_t t = 0; t < app_context.n_threads; ++t)
+    for (size_t e = 0; e < app_context.n_endpoints; ++e)
+      clientEndpoints[t].push_back(clientWorkers[t]->createEndpointFromHostname(
+        "127.0.0.1", app_context.listener_port, true));
+
+  // Wait for the server to accept all connections
+  const size_t totalEndpoints = app_context.n_threads * app_context.n_endpoints;
+  while (serverCtx->getEndpointCount() < totalEndpoints) {
+    if (app_context.worker_mode == WorkerMode::PerThread)
+      for (auto& worker : clientWorkers)
+        worker->progress();
+  }
+
+  std::atomic<bool> startFlag{false};
+  std::vector<thread_result_t> results(app_context.n_threads);
+  std::vector<std::thread> clientThreads;
+  for (size_t t = 0; t < app_context.n_threads; ++t)
+    clientThreads.emplace_back(runClient,
+                               std::cref(app_context),
+                               clientWorkers[t],
+                               clientEndpoints[t],
+                               std::ref(startFlag),
+                               std::ref(results[t]));
+  std::thread serverThread(
+    runServer, std::cref(app_context), serverWorker, serverCtx->getEndpoints());
+
+  startFlag = true;
+  for (auto& thread : clientThreads)
+    thread.join();
+  serverThread.join();
+
+  // Aggregate throughput over the time all threads were running, fairness as the Jain's
+  // fairness index of the per-thread message rates, where 1 means all threads had the same
+  // rate and `1 / n_threads` that a single thread monopolized the transfers
+  auto start = std::min_element(results.begin(), results.end(), [](const auto& a, const auto& b) {
+                 return a.start < b.start;
+               })->start;
+  auto stop  = std::max_element(results.begin(), results.end(), [](const auto& a, const auto& b) {
+                return a.stop < b.stop;
+              })->stop;
+  double totalSeconds  = std::chrono::duration<double>(stop - start).count();
+  size_t totalMessages = 0;
+  std::vector<double> rates;
+  for (const auto& r : results) {
+    totalMessages += r.messages;
+    rates.push_back(r.messages / std::chrono::duration<double>(r.stop - r.start).count());
+  }
+  double sumRates   = std::accumulate(rates.begin(), rates.end(), 0.0);
+  double sumSquares = std::inner_product(rates.begin(), rates.end(), rates.begin(), 0.0);
+  double fairness   = sumRates * sumRates / (rates.size() * sumSquares);
+
+  std::cout << "Threads, endpoints per thread, worker mode: " << app_context.n_threads << ", "
+            << app_context.n_endpoints << ", "
+            << (app_context.worker_mode == WorkerMode::Shared ? "shared" : "per-thread")
+            << std::endl;
+  for (size_t t = 0; t < rates.size(); ++t)
+    std::cout << "Thread " << t << " message rate: " << parseMessageRate(rates[t]) << std::endl;
+  std::cout << "Aggregate message rate, bandwidth: "
+            << parseMessageRate(totalMessages / totalSeconds) << ", "
+            << parseBandwidth(totalMessages * app_context.message_size / totalSeconds)
+            << std::endl;
+  std::cout << "Per-thread message rate min, max: "
+            << parseMessageRate(*std::min_element(rates.begin(), rates.end())) << ", "
+            << parseMessageRate(*std::max_element(rates.begin(), rates.end())) << std::endl;
+  std::cout << "Fairness index: " << fairness << std::endl;
+
+  // Stop progress threads
+  if (app_context.worker_mode == WorkerMode::Shared) clientWorkers[0]->stopProgressThread();
+  serverWorker->stopProgressThread();
+
+  return 0;
+}
@@ -4,10 +4,14 @@
  */
 #include <unistd.h>  // for getopt, optarg
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -19,6 +23,12 @@
 #include <ucxx/utils/sockaddr.h>
 #include <ucxx/utils/ucx.h>
 
+#if UCXX_ENABLE_RMM
+#include <cuda_runtime_api.h>
+
+#include <rmm/detail/error.hpp>
+#endif
+
 enum class ProgressMode {
   Polling,
   Blocking,
@@ -27,23 +37,116 @@ enum class ProgressMode {
   ThreadBlocking,
 };
 
+enum class TransferMode {
+  Bandwidth,
+  OneWayLatency,
+  RoundTripLatency,
+};
+
+enum class TransferOp {
+  Tag,
+  Am,
+  Stream,
+  TagMulti,
+};
+
 enum transfer_type_t { SEND, RECV };
 
-typedef std::unordered_map<transfer_type_t, std::vector<char>> BufferMap;
+typedef std::unordered_map<transfer_type_t, std::shared_ptr<ucxx::Buffer>> BufferMap;
 typedef std::unordered_map<transfer_type_t, ucxx::Tag> TagMap;
 
 typedef std::shared_ptr<BufferMap> BufferMapPtr;
 typedef std::shared_ptr<TagMap> TagMapPtr;
 
 struct app_context_t {
-  ProgressMode progress_mode = ProgressMode::Blocking;
-  const char* server_addr    = NULL;
-  uint16_t listener_port     = 12345;
-  size_t message_size        = 8;
-  size_t n_iter              = 100;
-  size_t warmup_iter         = 3;
-  bool reuse_alloc           = false;
-  bool verify_results        = false;
+  ProgressMode progress_mode   = ProgressMode::Blocking;
+  TransferMode transfer_mode   = TransferMode::Bandwidth;
+  TransferOp transfer_op       = TransferOp::Tag;
+  ucxx::BufferType buffer_type = ucxx::BufferType::Host;
+  const char* server_addr      = NULL;
+  const char* json_output      = NULL;
+  uint16_t listener_port       = 12345;
+  size_t message_size          = 8;
+  size_t max_message_size      = 0;
+  size_t window_size           = 1;
+  size_t n_iter                = 100;
+  size_t warmup_iter           = 3;
+  bool reuse_alloc             = false;
+  bool verify_results          = false;
+};
+
+/**
+ * @brief Log-linear histogram of latencies in nanoseconds.
+ *
+ * Histogram in the fashion of HdrHistogram, where values are grouped by their most
+ * significant bit, and each group is subdivided in linear sub-buckets, bounding the relative
+ * error of reported values to `2 / SubBuckets` at a constant cost for recording values,
+ * which is only an index computation and an increment.
+ */
+class LatencyHistogram {
+ private:
+  static constexpr size_t SubBucketBits = 8;
+  static constexpr size_t SubBuckets    = 1 << SubBucketBits;
+  static constexpr size_t HalfBuckets   = SubBuckets / 2;
+
+  std::vector<uint64_t> _counts = std::vector<uint64_t>((64 - SubBucketBits + 2) * HalfBuckets);
+  uint64_t _total{0};
+  uint64_t _min{std::numeric_limits<uint64_t>::max()};
+  uint64_t _max{0};
+  long double _sum{0};
+
+  static size_t index(uint64_t value)
+  {
+    if (value < SubBuckets) return value;
+    const size_t shift = 64 - __builtin_clzll(value) - SubBucketBits;
+    return shift * HalfBuckets + (value >> shift);
+  }
+
+  static uint64_t highestEquivalentValue(size_t index)
+  {
+    if (index < SubBuckets) return index;
+    const size_t shift = index / HalfBuckets - 1;
+    return ((index - shift * HalfBuckets) << shift) + (1ULL << shift) - 1;
+  }
+
+ public:
+  void record(uint64_t value)
+  {
+    ++_counts[index(value)];
+    ++_total;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+    _sum += value;
+  }
+
+  uint64_t count() const { return _total; }
+
+  uint64_t min() const { return _total == 0 ? 0 : _min; }
+
+  uint64_t max() const { return _max; }
+
+  double mean() const { return _total == 0 ? 0 : static_cast<double>(_sum / _total); }
+
+  uint64_t percentile(double percentile) const
+  {
+    if (_total == 0) return 0;
+    const uint64_t target =
+      std::max<uint64_t>(1, std::ceil(percentile / 100.0 * static_cast<double>(_total)));
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < _counts.size(); ++i) {
+      cumulative += _counts[i];
+      if (cumulative >= target) return std::min(highestEquivalentValue(i), _max);
+    }
+    return _max;
+  }
+};
+
+struct benchmark_result_t {
+  size_t message_size;
+  size_t total_duration_ns;
+  double bandwidth;
+  double message_rate;
+  LatencyHistogram latency;
 };
 
 class ListenerContext {
@@ -120,8 +223,26 @@ static void printUsage()
   std::cerr << "              'thread-polling' and 'thread-blocking' (default: 'blocking')"
             << std::endl;
   std::cerr << "  -t          use thread progress mode (disabled)" << std::endl;
+  std::cerr << "  -L <mode>   transfer mode to use, valid values are: 'bandwidth' (bidirectional"
+            << std::endl;
+  std::cerr << "              transfers), 'round-trip' and 'one-way' (ping-pong latency, where"
+            << std::endl;
+  std::cerr << "              one-way is half the round-trip time) (default: 'bandwidth')"
+            << std::endl;
+  std::cerr << "  -j <file>   write results in JSON format to file (disabled)" << std::endl;
+  std::cerr << "  -o <op>     transfer operation to use, valid values are: 'tag', 'am', 'stream'"
+            << std::endl;
+  std::cerr << "              and 'tagmulti' (default: 'tag')" << std::endl;
+  std::cerr << "  -M <type>   memory type of buffers, valid values are: 'host' and 'cuda', where"
+            << std::endl;
+  std::cerr << "              'cuda' requires RMM support (default: 'host')" << std::endl;
   std::cerr << "  -p <port>   port number to listen at (12345)" << std::endl;
   std::cerr << "  -s <bytes>  message size (8)" << std::endl;
+  std::cerr << "  -S <bytes>  sweep message sizes in powers of two from '-s' up to this size"
+            << std::endl;
+  std::cerr << "              (disabled)" << std::endl;
+  std::cerr << "  -W <int>    window size, number of messages in flight per direction (1)"
+            << std::endl;
   std::cerr << "  -n <int>    number of iterations to run (100)" << std::endl;
   std::cerr << "  -r          reuse memory allocation (disabled)" << std::endl;
   std::cerr << "  -v          verify results (disabled)" << std::endl;
@@ -134,7 +255,7 @@ ucs_status_t parseCommand(app_context_t* app_context, int argc, char* const argv
 {
   optind = 1;
   int c;
-  while ((c = getopt(argc, argv, "m:p:s:w:n:rvh")) != -1) {
+  while ((c = getopt(argc, argv, "m:L:j:o:M:p:s:S:W:w:n:rvh")) != -1) {
     switch (c) {
       case 'm':
         if (strcmp(optarg, "blocking") == 0) {
@@ -156,6 +277,54 @@ ucs_status_t parseCommand(app_context_t* app_context, int argc, char* const argv
           std::cerr << "Invalid progress mode: " << optarg << std::endl;
           return UCS_ERR_INVALID_PARAM;
         }
+      case 'L':
+        if (strcmp(optarg, "bandwidth") == 0) {
+          app_context->transfer_mode = TransferMode::Bandwidth;
+          break;
+        } else if (strcmp(optarg, "one-way") == 0) {
+          app_context->transfer_mode = TransferMode::OneWayLatency;
+          break;
+        } else if (strcmp(optarg, "round-trip") == 0) {
+          app_context->transfer_mode = TransferMode::RoundTripLatency;
+          break;
+        } else {
+          std::cerr << "Invalid transfer mode: " << optarg << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+      case 'j': app_context->json_output = optarg; break;
+      case 'o':
+        if (strcmp(optarg, "tag") == 0) {
+          app_context->transfer_op = TransferOp::Tag;
+          break;
+        } else if (strcmp(optarg, "am") == 0) {
+          app_context->transfer_op = TransferOp::Am;
+          break;
+        } else if (strcmp(optarg, "stream") == 0) {
+          app_context->transfer_op = TransferOp::Stream;
+          break;
+        } else if (strcmp(optarg, "tagmulti") == 0) {
+          app_context->transfer_op = TransferOp::TagMulti;
+          break;
+        } else {
+          std::cerr << "Invalid transfer operation: " << optarg << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+      case 'M':
+        if (strcmp(optarg, "host") == 0) {
+          app_context->buffer_type = ucxx::BufferType::Host;
+          break;
+        } else if (strcmp(optarg, "cuda") == 0) {
+#if UCXX_ENABLE_RMM
+          app_context->buffer_type = ucxx::BufferType::RMM;
+          break;
+#else
+          std::cerr << "CUDA memory requires UCXX built with RMM support" << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+#endif
+        } else {
+          std::cerr << "Invalid memory type: " << optarg << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
       case 'p':
         app_context->listener_port = atoi(optarg);
         if (app_context->listener_port <= 0) {
@@ -170,6 +339,21 @@ ucs_status_t parseCommand(app_context_t* app_context, int argc, char* const argv
           return UCS_ERR_INVALID_PARAM;
         }
         break;
+      case 'S':
+        app_context->max_message_size = atoi(optarg);
+        if (app_context->max_message_size <= 0) {
+          std::cerr << "Wrong maximum message size: " << app_context->max_message_size
+                    << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+        break;
+      case 'W':
+        app_context->window_size = atoi(optarg);
+        if (app_context->window_size <= 0) {
+          std::cerr << "Wrong window size: " << app_context->window_size << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+        break;
       case 'w':
         app_context->warmup_iter = atoi(optarg);
         if (app_context->warmup_iter <= 0) {
@@ -194,6 +378,13 @@ ucs_status_t parseCommand(app_context_t* app_context, int argc, char* const argv
 
   if (optind < argc) { app_context->server_addr = argv[optind]; }
 
+  if (app_context->max_message_size == 0) {
+    app_context->max_message_size = app_context->message_size;
+  } else if (app_context->max_message_size < app_context->message_size) {
+    std::cerr << "Maximum message size must not be smaller than message size" << std::endl;
+    return UCS_ERR_INVALID_PARAM;
+  }
+
   return UCS_OK;
 }
 
@@ -234,6 +425,18 @@ std::string parseTime(size_t countNs)
     return std::to_string(countNs / 1e9) + std::string("s");
 }
 
+std::string parseMessageRate(size_t totalMessages, size_t countNs)
+{
+  double rate = totalMessages / (countNs / 1e9);
+
+  if (rate < 1e3)
+    return std::to_string(rate) + std::string("msg/s");
+  else if (rate < 1e6)
+    return std::to_string(rate / 1e3) + std::string("Kmsg/s");
+  else
+    return std::to_string(rate / 1e6) + std::string("Mmsg/s");
+}
+
 std::string parseBandwidth(size_t totalBytes, size_t countNs)
 {
   double bw = totalBytes / (countNs / 1e9);
@@ -248,40 +451,222 @@ std::string parseBandwidth(size_t totalBytes, size_t countNs)
     return std::to_string(bw / (1024 * 1024 * 1024)) + std::string("GB/s");
 }
 
-BufferMapPtr allocateTransferBuffers(size_t message_size)
+BufferMapPtr allocateTransferBuffers(ucxx::BufferType bufferType,
+                                     size_t message_size,
+                                     size_t window_size)
+{
+  // One buffer per message in the window, all contiguous
+  auto bufferMap = std::make_shared<BufferMap>(
+    BufferMap{{SEND, ucxx::allocateBuffer(bufferType, message_size * window_size)},
+              {RECV, ucxx::allocateBuffer(bufferType, message_size * window_size)}});
+
+  auto send = (*bufferMap)[SEND];
+  if (bufferType == ucxx::BufferType::Host) {
+    std::fill_n(reinterpret_cast<char*>(send->data()), send->getSize(), 0xaa);
+#if UCXX_ENABLE_RMM
+  } else {
+    RMM_CUDA_TRY(cudaMemset(send->data(), 0xaa, send->getSize()));
+#endif
+  }
+
+  return bufferMap;
+}
+
+std::vector<char> copyToHost(void* data, size_t size, ucxx::BufferType bufferType)
 {
-  return std::make_shared<BufferMap>(BufferMap{{SEND, std::vector<char>(message_size, 0xaa)},
-                                               {RECV, std::vector<char>(message_size)}});
+  std::vector<char> host(size);
+  if (bufferType == ucxx::BufferType::Host) {
+    std::copy_n(reinterpret_cast<char*>(data), size, host.begin());
+#if UCXX_ENABLE_RMM
+  } else {
+    RMM_CUDA_TRY(cudaMemcpy(host.data(), data, size, cudaMemcpyDefault));
+#endif
+  }
+  return host;
 }
 
 auto doTransfer(const app_context_t& app_context,
                 std::shared_ptr<ucxx::Worker> worker,
                 std::shared_ptr<ucxx::Endpoint> endpoint,
                 TagMapPtr tagMap,
-                BufferMapPtr bufferMapReuse)
+                BufferMapPtr bufferMapReuse,
+                bool is_server)
 {
+  const size_t messageSize = app_context.message_size;
+  const size_t windowSize  = app_context.window_size;
+
+  const auto bufferType = app_context.buffer_type;
+  const auto memoryType =
+    bufferType == ucxx::BufferType::RMM ? UCS_MEMORY_TYPE_CUDA : UCS_MEMORY_TYPE_HOST;
+
   BufferMapPtr localBufferMap;
-  if (!app_context.reuse_alloc) localBufferMap = allocateTransferBuffers(app_context.message_size);
+  if (!app_context.reuse_alloc)
+    localBufferMap = allocateTransferBuffers(bufferType, messageSize, windowSize);
   BufferMapPtr bufferMap = app_context.reuse_alloc ? bufferMapReuse : localBufferMap;
+  auto sendPtr           = reinterpret_cast<char*>((*bufferMap)[SEND]->data());
+  auto recvPtr           = reinterpret_cast<char*>((*bufferMap)[RECV]->data());
 
-  auto start                                           = std::chrono::high_resolution_clock::now();
-  std::vector<std::shared_ptr<ucxx::Request>> requests = {
-    endpoint->tagSend((*bufferMap)[SEND].data(), app_context.message_size, (*tagMap)[SEND]),
-    endpoint->tagRecv(
-      (*bufferMap)[RECV].data(), app_context.message_size, (*tagMap)[RECV], ucxx::TagMaskFull)};
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.reserve(2 * windowSize);
+
+  // The window is transferred as one message per buffer, except for `TagMulti` which
+  // transfers it as a single multi-buffer message of one frame per buffer. Buffers of `Am`
+  // and `TagMulti` receives are allocated by UCXX, with the registered AM allocator and
+  // `allocateBuffer()` respectively.
+  auto postRecvs = [&]() {
+    if (app_context.transfer_op == TransferOp::TagMulti) {
+      requests.push_back(endpoint->tagMultiRecv((*tagMap)[RECV], ucxx::TagMaskFull, false));
+      return;
+    }
+    for (size_t i = 0; i < windowSize; ++i) {
+      auto buffer = recvPtr + i * messageSize;
+      switch (app_context.transfer_op) {
+        case TransferOp::Am: requests.push_back(endpoint->amRecv()); break;
+        case TransferOp::Stream:
+          requests.push_back(endpoint->streamRecv(buffer, messageSize, false));
+          break;
+        default:
+          requests.push_back(
+            endpoint->tagRecv(buffer, messageSize, (*tagMap)[RECV], ucxx::TagMaskFull));
+      }
+    }
+  };
+  auto postSends = [&]() {
+    if (app_context.transfer_op == TransferOp::TagMulti) {
+      std::vector<void*> buffers;
+      for (size_t i = 0; i < windowSize; ++i)
+        buffers.push_back(sendPtr + i * messageSize);
+      std::vector<size_t> sizes(windowSize, messageSize);
+      std::vector<int> isCUDA(windowSize, bufferType == ucxx::BufferType::RMM);
+      requests.push_back(endpoint->tagMultiSend(buffers, sizes, isCUDA, (*tagMap)[SEND], false));
+      return;
+    }
+    for (size_t i = 0; i < windowSize; ++i) {
+      auto buffer = sendPtr + i * messageSize;
+      switch (app_context.transfer_op) {
+        case TransferOp::Am:
+          requests.push_back(endpoint->amSend(buffer, messageSize, memoryType));
+          break;
+        case TransferOp::Stream:
+          requests.push_back(endpoint->streamSend(buffer, messageSize, false));
+          break;
+        default: requests.push_back(endpoint->tagSend(buffer, messageSize, (*tagMap)[SEND]));
+      }
+    }
+  };
+
+  // Keep the entire window in flight before waiting for any request to complete, receives
+  // are posted first so that sends of the window don't arrive as unexpected messages
+  auto start = std::chrono::high_resolution_clock::now();
+  std::vector<std::shared_ptr<ucxx::Request>> recvRequests;
+  if (app_context.transfer_mode != TransferMode::Bandwidth && is_server) {
+    // Ping-pong: the server only replies once the entire window was received
+    postRecvs();
+    waitRequests(app_context.progress_mode, worker, requests);
+    recvRequests.swap(requests);
+  } else {
+    postRecvs();
+    recvRequests = requests;
+  }
+  postSends();
 
   // Wait for requests and clear requests
   waitRequests(app_context.progress_mode, worker, requests);
   auto stop = std::chrono::high_resolution_clock::now();
 
   if (app_context.verify_results) {
-    for (size_t j = 0; j < (*bufferMap)[SEND].size(); ++j)
-      assert((*bufferMap)[RECV][j] == (*bufferMap)[RECV][j]);
+    // Gather pointers to all received messages, whose buffers may have been allocated by UCXX
+    std::vector<void*> received;
+    if (app_context.transfer_op == TransferOp::Am) {
+      for (const auto& r : recvRequests)
+        received.push_back(r->getRecvBuffer()->data());
+    } else if (app_context.transfer_op == TransferOp::TagMulti) {
+      for (const auto& br :
+           std::dynamic_pointer_cast<ucxx::RequestTagMulti>(recvRequests[0])->_bufferRequests)
+        if (br->buffer) received.push_back(br->buffer->data());
+    } else {
+      for (size_t i = 0; i < windowSize; ++i)
+        received.push_back(recvPtr + i * messageSize);
+    }
+
+    assert(received.size() == windowSize);
+    auto expected = copyToHost(sendPtr, messageSize, bufferType);
+    for (const auto& r : received) {
+      auto result = copyToHost(r, messageSize, bufferType);
+      assert(result == expected);
+    }
   }
 
   return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
 }
 
+std::string progressModeName(ProgressMode progressMode)
+{
+  switch (progressMode) {
+    case ProgressMode::Polling: return "polling";
+    case ProgressMode::Blocking: return "blocking";
+    case ProgressMode::Wait: return "wait";
+    case ProgressMode::ThreadPolling: return "thread-polling";
+    case ProgressMode::ThreadBlocking: return "thread-blocking";
+    default: return "unknown";
+  }
+}
+
+std::string transferModeName(TransferMode transferMode)
+{
+  switch (transferMode) {
+    case TransferMode::Bandwidth: return "bandwidth";
+    case TransferMode::OneWayLatency: return "one-way";
+    case TransferMode::RoundTripLatency: return "round-trip";
+    default: return "unknown";
+  }
+}
+
+std::string transferOpName(TransferOp transferOp)
+{
+  switch (transferOp) {
+    case TransferOp::Tag: return "tag";
+    case TransferOp::Am: return "am";
+    case TransferOp::Stream: return "stream";
+    case TransferOp::TagMulti: return "tagmulti";
+    default: return "unknown";
+  }
+}
+
+void writeJsonResults(const app_context_t& app_context,
+                      const std::vector<benchmark_result_t>& results)
+{
+  std::ofstream out(app_context.json_output);
+  if (!out) throw std::runtime_error(std::string("Cannot open ") + app_context.json_output);
+
+  out << "{\n"
+      << "  \"benchmark\": \"ucxx_perftest\",\n"
+      << "  \"role\": \"" << (app_context.server_addr == NULL ? "server" : "client") << "\",\n"
+      << "  \"progress_mode\": \"" << progressModeName(app_context.progress_mode) << "\",\n"
+      << "  \"transfer_mode\": \"" << transferModeName(app_context.transfer_mode) << "\",\n"
+      << "  \"transfer_op\": \"" << transferOpName(app_context.transfer_op) << "\",\n"
+      << "  \"memory_type\": \""
+      << (app_context.buffer_type == ucxx::BufferType::RMM ? "cuda" : "host") << "\",\n"
+      << "  \"window_size\": " << app_context.window_size << ",\n"
+      << "  \"iterations\": " << app_context.n_iter << ",\n"
+      << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto& r = results[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\n"
+        << "      \"message_size\": " << r.message_size << ",\n"
+        << "      \"total_duration_ns\": " << r.total_duration_ns << ",\n"
+        << "      \"bandwidth_bytes_per_second\": " << r.bandwidth << ",\n"
+        << "      \"message_rate_per_second\": " << r.message_rate << ",\n"
+        << "      \"latency_ns\": {\"min\": " << r.latency.min()
+        << ", \"mean\": " << r.latency.mean() << ", \"p50\": " << r.latency.percentile(50)
+        << ", \"p99\": " << r.latency.percentile(99)
+        << ", \"p99.9\": " << r.latency.percentile(99.9) << ", \"max\": " << r.latency.max()
+        << "}\n"
+        << "    }";
+  }
+  out << "\n  ]\n}\n";
+}
+
 int main(int argc, char** argv)
 {
   app_context_t app_context;
@@ -306,6 +691,18 @@ int main(int argc, char** argv)
     listener_ctx->setListener(listener);
   }
 
+#if UCXX_ENABLE_RMM
+  if (app_context.buffer_type == ucxx::BufferType::RMM) {
+    // Receive CUDA active messages directly into RMM-allocated device memory
+    worker->registerAmAllocator(UCS_MEMORY_TYPE_CUDA, [](size_t length) {
+      return std::make_shared<ucxx::RMMBuffer>(length);
+    });
+
+    // Progress threads require a CUDA context for transfers of device memory
+    worker->setProgressThreadStartCallback([](void*) { cudaFree(0); }, nullptr);
+  }
+#endif
+
   // Initialize worker progress
   if (app_context.progress_mode == ProgressMode::Blocking)
     worker->initBlockingProgressMode();
@@ -329,52 +726,83 @@ int main(int argc, char** argv)
   std::vector<std::shared_ptr<ucxx::Request>> requests;
 
   // Allocate wireup buffers
-  auto wireupBufferMap = std::make_shared<BufferMap>(
-    BufferMap{{SEND, std::vector<char>{1, 2, 3}}, {RECV, std::vector<char>(3, 0)}});
+  std::vector<int> wireupSend{1, 2, 3};
+  std::vector<int> wireupRecv(wireupSend.size(), 0);
 
   // Schedule small wireup messages to let UCX identify capabilities between endpoints
-  requests.push_back(endpoint->tagSend((*wireupBufferMap)[SEND].data(),
-                                       (*wireupBufferMap)[SEND].size() * sizeof(int),
-                                       (*tagMap)[SEND]));
-  requests.push_back(endpoint->tagRecv((*wireupBufferMap)[RECV].data(),
-                                       (*wireupBufferMap)[RECV].size() * sizeof(int),
-                                       (*tagMap)[RECV],
-                                       ucxx::TagMaskFull));
+  requests.push_back(
+    endpoint->tagSend(wireupSend.data(), wireupSend.size() * sizeof(int), (*tagMap)[SEND]));
+  requests.push_back(endpoint->tagRecv(
+    wireupRecv.data(), wireupRecv.size() * sizeof(int), (*tagMap)[RECV], ucxx::TagMaskFull));
 
   // Wait for wireup requests and clear requests
   waitRequests(app_context.progress_mode, worker, requests);
   requests.clear();
 
   // Verify wireup result
-  for (size_t i = 0; i < (*wireupBufferMap)[SEND].size(); ++i)
-    assert((*wireupBufferMap)[RECV][i] == (*wireupBufferMap)[SEND][i]);
-
-  BufferMapPtr bufferMapReuse;
-  if (app_context.reuse_alloc) bufferMapReuse = allocateTransferBuffers(app_context.message_size);
-
-  // Warmup
-  for (size_t n = 0; n < app_context.warmup_iter; ++n)
-    doTransfer(app_context, worker, endpoint, tagMap, bufferMapReuse);
-
-  // Schedule send and recv messages on different tags and different ordering
-  size_t total_duration_ns = 0;
-  for (size_t n = 0; n < app_context.n_iter; ++n) {
-    auto duration_ns = doTransfer(app_context, worker, endpoint, tagMap, bufferMapReuse);
-    total_duration_ns += duration_ns;
-    auto elapsed   = parseTime(duration_ns);
-    auto bandwidth = parseBandwidth(app_context.message_size * 2, duration_ns);
-
-    if (!is_server)
-      std::cout << "Elapsed, bandwidth: " << elapsed << ", " << bandwidth << std::endl;
-  }
+  assert(wireupRecv == wireupSend);
+
+  // Run the benchmark for each message size of the sweep, or only `message_size` by default
+  std::vector<benchmark_result_t> results;
+  const size_t max_message_size = app_context.max_message_size;
+  for (size_t message_size = app_context.message_size; message_size <= max_message_size;
+       message_size *= 2) {
+    app_context.message_size = message_size;
+    const size_t window_size = app_context.window_size;
+
+    BufferMapPtr bufferMapReuse;
+    if (app_context.reuse_alloc)
+      bufferMapReuse = allocateTransferBuffers(app_context.buffer_type, message_size, window_size);
+
+    // Warmup
+    for (size_t n = 0; n < app_context.warmup_iter; ++n)
+      doTransfer(app_context, worker, endpoint, tagMap, bufferMapReuse, is_server);
+
+    // Schedule send and recv messages on different tags and different ordering
+    benchmark_result_t result{message_size};
+    size_t total_duration_ns = 0;
+    for (size_t n = 0; n < app_context.n_iter; ++n) {
+      auto duration_ns =
+        doTransfer(app_context, worker, endpoint, tagMap, bufferMapReuse, is_server);
+      total_duration_ns += duration_ns;
+      result.latency.record(app_context.transfer_mode == TransferMode::OneWayLatency
+                              ? duration_ns / 2
+                              : duration_ns);
+
+      // Latency modes run many short iterations, only their percentiles are reported
+      if (!is_server && app_context.transfer_mode == TransferMode::Bandwidth) {
+        auto elapsed      = parseTime(duration_ns);
+        auto bandwidth    = parseBandwidth(message_size * window_size * 2, duration_ns);
+        auto message_rate = parseMessageRate(window_size, duration_ns);
+        std::cout << "Elapsed, bandwidth, message rate: " << elapsed << ", " << bandwidth << ", "
+                  << message_rate << std::endl;
+      }
+    }
 
-  auto total_elapsed = parseTime(total_duration_ns);
-  auto total_bandwidth =
-    parseBandwidth(app_context.n_iter * app_context.message_size * 2, total_duration_ns);
+    auto total_elapsed = parseTime(total_duration_ns);
+    auto total_bandwidth =
+      parseBandwidth(app_context.n_iter * message_size * window_size * 2, total_duration_ns);
+    auto total_message_rate = parseMessageRate(app_context.n_iter * window_size, total_duration_ns);
+
+    if (!is_server) {
+      std::cout << "Total elapsed, bandwidth, message rate (message size " << message_size
+                << ", window size " << window_size << "): " << total_elapsed << ", "
+                << total_bandwidth << ", " << total_message_rate << std::endl;
+      std::cout << "Latency min, p50, p99, p99.9, max: " << parseTime(result.latency.min())
+                << ", " << parseTime(result.latency.percentile(50)) << ", "
+                << parseTime(result.latency.percentile(99)) << ", "
+                << parseTime(result.latency.percentile(99.9)) << ", "
+                << parseTime(result.latency.max()) << std::endl;
+    }
+
+    result.total_duration_ns = total_duration_ns;
+    result.bandwidth = app_context.n_iter * message_size * window_size * 2 /
+                       (total_duration_ns / 1e9);
+    result.message_rate = app_context.n_iter * window_size / (total_duration_ns / 1e9);
+    results.push_back(std::move(result));
+  }
 
-  if (!is_server)
-    std::cout << "Total elapsed, bandwidth: " << total_elapsed << ", " << total_bandwidth
-              << std::endl;
+  if (app_context.json_output != NULL) writeJsonResults(app_context, results);
 
   // Stop progress thread
   if (app_context.progress_mode == ProgressMode::ThreadBlocking ||
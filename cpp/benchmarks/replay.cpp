@@ -0,0 +1,515 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <unistd.h>  // for getopt, optarg
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <ucxx/api.h>
+
+typedef std::chrono::steady_clock Clock;
+
+constexpr uint64_t controlTag = 1ull << 63;
+constexpr size_t rankShift    = 48;
+
+struct app_context_t {
+  std::vector<std::string> traces{};
+  std::vector<std::string> hosts{"127.0.0.1"};
+  size_t rank            = 0;
+  uint16_t listener_port = 12345;
+  double time_scale      = 1.0;
+  bool as_fast           = false;
+  bool host_memory       = false;
+  size_t recv_window     = 64;
+};
+
+/**
+ * @brief An operation to replay.
+ *
+ * A send of the local trace or a receive expected from a peer's trace, where `peer` is
+ * the rank it is sent to or received from, and `time` is its offset from the start of the
+ * trace it was recorded in.
+ */
+struct operation_t {
+  ucxx::CaptureOperation operation;
+  ucs_memory_type_t memoryType;
+  size_t peer;
+  uint64_t time;
+  uint64_t size;
+  uint64_t tag;
+};
+
+/**
+ * @brief Endpoints connected to every other rank.
+ *
+ * Endpoints of connections accepted by the listener, which are only assigned to their rank
+ * once the handshake carrying the rank of the connecting process is received.
+ */
+class PeerContext {
+ private:
+  std::shared_ptr<ucxx::Listener> _listener{nullptr};
+  std::vector<std::shared_ptr<ucxx::Endpoint>> _accepted{};
+  std::mutex _mutex{};
+
+ public:
+  void setListener(std::shared_ptr<ucxx::Listener> listener) { _listener = listener; }
+
+  void createEndpointFromConnRequest(ucp_conn_request_h conn_request)
+  {
+    auto endpoint = _listener->createEndpointFromConnRequest(conn_request, true);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _accepted.push_back(endpoint);
+  }
+
+  std::vector<std::shared_ptr<ucxx::Endpoint>> popAccepted()
+  {
+    std::vector<std::shared_ptr<ucxx::Endpoint>> accepted;
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::swap(accepted, _accepted);
+    return accepted;
+  }
+};
+
+static void listener_cb(ucp_conn_request_h conn_request, void* arg)
+{
+  reinterpret_cast<PeerContext*>(arg)->createEndpointFromConnRequest(conn_request);
+}
+
+static void printUsage()
+{
+  std::cerr << " replay of traffic captured by ucxx::TrafficCapture" << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "Usage: ucxx_replay [options] <trace 0> <trace 1> ... <trace N-1>" << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "Replays the traces captured by N processes, e.g., with UCXX_TRAFFIC_CAPTURE,"
+            << std::endl;
+  std::cerr << "one process per trace is started with the same list of traces and its rank."
+            << std::endl;
+  std::cerr << "Each rank posts the sends of its own trace at the recorded times, and the"
+            << std::endl;
+  std::cerr << "receives matching the sends of the other traces addressed to it. Endpoint E"
+            << std::endl;
+  std::cerr << "of the trace of rank R is replayed as the connection to rank" << std::endl;
+  std::cerr << "(R + 1 + (E - 1) % (N - 1)) % N, ranks are thus assigned to traces in the"
+            << std::endl;
+  std::cerr << "order the captured processes first communicated with each other. Remote"
+            << std::endl;
+  std::cerr << "memory operations are replayed as tag messages of the same size, payloads"
+            << std::endl;
+  std::cerr << "share scratch buffers and are not verified." << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "Parameters are:" << std::endl;
+  std::cerr << "  -r <int>    rank of this process, index of its trace (0)" << std::endl;
+  std::cerr << "  -H <hosts>  comma-separated hosts of each rank, a single host is used for"
+            << std::endl;
+  std::cerr << "              all ranks (127.0.0.1)" << std::endl;
+  std::cerr << "  -p <port>   base port number, rank R listens at port + R (12345)" << std::endl;
+  std::cerr << "  -S <float>  time scale, 2 replays twice as fast as recorded (1)" << std::endl;
+  std::cerr << "  -a          replay as fast as possible, ignoring recorded times (disabled)"
+            << std::endl;
+  std::cerr << "  -m          use host memory for all operations, otherwise CUDA memory is"
+            << std::endl;
+  std::cerr << "              used where recorded if built with RMM support (disabled)"
+            << std::endl;
+  std::cerr << "  -w <int>    maximum number of receives in flight (64)" << std::endl;
+  std::cerr << "  -h          print this help" << std::endl;
+  std::cerr << std::endl;
+}
+
+ucs_status_t parseCommand(app_context_t* app_context, int argc, char* const argv[])
+{
+  optind = 1;
+  int c;
+  while ((c = getopt(argc, argv, "r:H:p:S:amw:h")) != -1) {
+    switch (c) {
+      case 'r': app_context->rank = atoi(optarg); break;
+      case 'H': {
+        app_context->hosts.clear();
+        std::stringstream hosts(optarg);
+        for (std::string host; std::getline(hosts, host, ',');)
+          app_context->hosts.push_back(host);
+        break;
+      }
+      case 'p':
+        app_context->listener_port = atoi(optarg);
+        if (app_context->listener_port <= 0) {
+          std::cerr << "Wrong listener port: " << app_context->listener_port << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+        break;
+      case 'S':
+        app_context->time_scale = atof(optarg);
+        if (app_context->time_scale <= 0) {
+          std::cerr << "Wrong time scale: " << app_context->time_scale << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+        break;
+      case 'a': app_context->as_fast = true; break;
+      case 'm': app_context->host_memory = true; break;
+      case 'w':
+        app_context->recv_window = atoi(optarg);
+        if (app_context->recv_window <= 0) {
+          std::cerr << "Wrong receive window: " << app_context->recv_window << std::endl;
+          return UCS_ERR_INVALID_PARAM;
+        }
+        break;
+      case 'h':
+      default: printUsage(); return UCS_ERR_INVALID_PARAM;
+    }
+  }
+
+  for (int i = optind; i < argc; ++i)
+    app_context->traces.push_back(argv[i]);
+
+  if (app_context->traces.size() < 2) {
+    std::cerr << "At least two traces are required" << std::endl;
+    printUsage();
+    return UCS_ERR_INVALID_PARAM;
+  }
+  if (app_context->rank >= app_context->traces.size()) {
+    std::cerr << "Wrong rank: " << app_context->rank << std::endl;
+    return UCS_ERR_INVALID_PARAM;
+  }
+  if (app_context->hosts.size() != 1 && app_context->hosts.size() != app_context->traces.size()) {
+    std::cerr << "Expected 1 or " << app_context->traces.size() << " hosts" << std::endl;
+    return UCS_ERR_INVALID_PARAM;
+  }
+
+  return UCS_OK;
+}
+
+void waitRequests(const std::vector<std::shared_ptr<ucxx::Request>>& requests)
+{
+  for (auto& r : requests) {
+    while (!r->isCompleted())
+      ;
+    r->checkError();
+  }
+}
+
+std::string parseTime(size_t totalTime)
+{
+  if (totalTime < 1000) {
+    return std::to_string(totalTime) + std::string("ns");
+  } else if (totalTime < 1000000) {
+    return std::to_string(totalTime / 1e3) + std::string("us");
+  } else if (totalTime < 1000000000) {
+    return std::to_string(totalTime / 1e6) + std::string("ms");
+  } else {
+    return std::to_string(totalTime / 1e9) + std::string("s");
+  }
+}
+
+std::string parseBandwidth(double bw)
+{
+  if (bw < 1024)
+    return std::to_string(bw) + std::string("B/s");
+  else if (bw < (1024 * 1024))
+    return std::to_string(bw / 1024) + std::string("KB/s");
+  else if (bw < (1024 * 1024 * 1024))
+    return std::to_string(bw / (1024 * 1024)) + std::string("MB/s");
+  else
+    return std::to_string(bw / (1024 * 1024 * 1024)) + std::string("GB/s");
+}
+
+bool isSend(ucxx::CaptureOperation operation)
+{
+  switch (operation) {
+    case ucxx::CaptureOperation::TagSend:
+    case ucxx::CaptureOperation::StreamSend:
+    case ucxx::CaptureOperation::AmSend:
+    case ucxx::CaptureOperation::MemPut:
+    case ucxx::CaptureOperation::MemGet: return true;
+    default: return false;
+  }
+}
+
+/**
+ * @brief Get the sends of a trace.
+ *
+ * Get the sends of the trace of rank `source` with their peer ranks and absolute times,
+ * each tagged with a tag unique to the job, remote memory operations become tag sends.
+ */
+std::vector<operation_t> getSends(const std::vector<ucxx::CaptureRecord>& records,
+                                  size_t source,
+                                  size_t ranks)
+{
+  std::vector<operation_t> sends;
+  uint64_t time = 0;
+  for (size_t i = 0; i < records.size(); ++i) {
+    const auto& record = records[i];
+    time += record.interArrivalNs;
+    if (!isSend(record.operation) || record.endpoint == 0) continue;
+
+    auto operation = record.operation;
+    if (operation == ucxx::CaptureOperation::MemPut || operation == ucxx::CaptureOperation::MemGet)
+      operation = ucxx::CaptureOperation::TagSend;
+    const size_t peer = (source + 1 + (record.endpoint - 1) % (ranks - 1)) % ranks;
+    sends.push_back(operation_t{operation,
+                                record.memoryType,
+                                peer,
+                                time,
+                                record.size,
+                                (static_cast<uint64_t>(source) << rankShift) | i});
+  }
+  return sends;
+}
+
+/**
+ * @brief Scratch buffers shared by all operations of a direction.
+ */
+class ScratchBuffers {
+ private:
+  bool _hostMemory{false};
+  std::unordered_map<ucs_memory_type_t, std::shared_ptr<ucxx::Buffer>> _buffers{};
+
+ public:
+  explicit ScratchBuffers(bool hostMemory) : _hostMemory(hostMemory) {}
+
+  ucs_memory_type_t getMemoryType(ucs_memory_type_t memoryType) const
+  {
+#if UCXX_ENABLE_RMM
+    if (!_hostMemory &&
+        (memoryType == UCS_MEMORY_TYPE_CUDA || memoryType == UCS_MEMORY_TYPE_CUDA_MANAGED))
+      return UCS_MEMORY_TYPE_CUDA;
+#endif
+    return UCS_MEMORY_TYPE_HOST;
+  }
+
+  void reserve(const std::vector<operation_t>& operations)
+  {
+    std::unordered_map<ucs_memory_type_t, size_t> sizes;
+    for (const auto& op : operations) {
+      auto& size = sizes[getMemoryType(op.memoryType)];
+      size       = std::max<size_t>(size, op.size);
+    }
+    for (const auto& [memoryType, size] : sizes)
+      _buffers[memoryType] = ucxx::allocateBuffer(
+        memoryType == UCS_MEMORY_TYPE_CUDA ? ucxx::BufferType::RMM : ucxx::BufferType::Host,
+        std::max<size_t>(size, 1));
+  }
+
+  void* get(ucs_memory_type_t memoryType) { return _buffers.at(getMemoryType(memoryType))->data(); }
+};
+
+std::shared_ptr<ucxx::Request> postSend(std::shared_ptr<ucxx::Endpoint> endpoint,
+                                        ScratchBuffers& buffers,
+                                        const operation_t& op)
+{
+  void* buffer = buffers.get(op.memoryType);
+  switch (op.operation) {
+    case ucxx::CaptureOperation::AmSend:
+      return endpoint->amSend(buffer, op.size, buffers.getMemoryType(op.memoryType));
+    case ucxx::CaptureOperation::StreamSend: return endpoint->streamSend(buffer, op.size, false);
+    case ucxx::CaptureOperation::TagSend:
+    default: return endpoint->tagSend(buffer, op.size, ucxx::Tag{op.tag});
+  }
+}
+
+std::shared_ptr<ucxx::Request> postRecv(std::shared_ptr<ucxx::Worker> worker,
+                                        std::shared_ptr<ucxx::Endpoint> endpoint,
+                                        ScratchBuffers& buffers,
+                                        const operation_t& op)
+{
+  void* buffer = buffers.get(op.memoryType);
+  switch (op.operation) {
+    case ucxx::CaptureOperation::AmSend: return endpoint->amRecv();
+    case ucxx::CaptureOperation::StreamSend: return endpoint->streamRecv(buffer, op.size, false);
+    case ucxx::CaptureOperation::TagSend:
+    default: return worker->tagRecv(buffer, op.size, ucxx::Tag{op.tag}, ucxx::TagMaskFull);
+  }
+}
+
+/**
+ * @brief Connect to all other ranks.
+ *
+ * Connect to all lower ranks, retrying until their listeners are up, sending them the
+ * local rank, and accept connections from all higher ranks, receiving their ranks.
+ */
+std::vector<std::shared_ptr<ucxx::Endpoint>> connectPeers(const app_context_t& app_context,
+                                                          std::shared_ptr<ucxx::Worker> worker,
+                                                          PeerContext& peerContext)
+{
+  const size_t ranks = app_context.traces.size();
+  std::vector<std::shared_ptr<ucxx::Endpoint>> endpoints(ranks);
+
+  uint64_t localRank = app_context.rank;
+  for (size_t peer = 0; peer < app_context.rank; ++peer) {
+    const auto& host = app_context.hosts[app_context.hosts.size() == 1 ? 0 : peer];
+    while (!endpoints[peer]) {
+      auto endpoint = worker->createEndpointFromHostname(host, app_context.listener_port + peer);
+      try {
+        waitRequests({endpoint->streamSend(&localRank, sizeof(localRank), false)});
+        endpoints[peer] = endpoint;
+      } catch (const std::exception&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }
+    }
+  }
+
+  for (size_t accepted = app_context.rank + 1; accepted < ranks;) {
+    for (auto& endpoint : peerContext.popAccepted()) {
+      uint64_t peer = 0;
+      waitRequests({endpoint->streamRecv(&peer, sizeof(peer), false)});
+      if (peer <= app_context.rank || peer >= ranks || endpoints[peer])
+        throw std::runtime_error("Unexpected connection from rank " + std::to_string(peer));
+      endpoints[peer] = endpoint;
+      ++accepted;
+    }
+  }
+
+  return endpoints;
+}
+
+/**
+ * @brief Wait for all ranks to reach the barrier.
+ */
+void barrier(std::shared_ptr<ucxx::Worker> worker,
+             const std::vector<std::shared_ptr<ucxx::Endpoint>>& endpoints,
+             uint64_t phase)
+{
+  std::vector<uint8_t> buffers(endpoints.size() * 2);
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  for (size_t peer = 0; peer < endpoints.size(); ++peer) {
+    if (!endpoints[peer]) continue;
+    requests.push_back(endpoints[peer]->tagSend(&buffers[peer], 1, ucxx::Tag{controlTag | phase}));
+    requests.push_back(worker->tagRecv(&buffers[endpoints.size() + peer],
+                                       1,
+                                       ucxx::Tag{controlTag | phase},
+                                       ucxx::TagMaskFull));
+  }
+  waitRequests(requests);
+}
+
+/**
+ * @brief Post all expected receives, with at most `recv_window` in flight.
+ */
+void runReceiver(const app_context_t& app_context,
+                 std::shared_ptr<ucxx::Worker> worker,
+                 const std::vector<std::shared_ptr<ucxx::Endpoint>>& endpoints,
+                 const std::vector<operation_t>& receives,
+                 ScratchBuffers& buffers)
+{
+  std::vector<std::shared_ptr<ucxx::Request>> inflight;
+  for (const auto& op : receives) {
+    while (inflight.size() >= app_context.recv_window) {
+      waitRequests({inflight.front()});
+      inflight.erase(inflight.begin());
+    }
+    inflight.push_back(postRecv(worker, endpoints[op.peer], buffers, op));
+  }
+  waitRequests(inflight);
+}
+
+int main(int argc, char** argv)
+{
+  app_context_t app_context;
+  if (parseCommand(&app_context, argc, argv) != UCS_OK) return -1;
+
+  const size_t ranks = app_context.traces.size();
+
+  // Sends of the local trace, and receives of all sends addressed to this rank in the
+  // order they were sent by each peer, sorted by time to post them as they are expected
+  std::vector<operation_t> sends;
+  std::vector<operation_t> receives;
+  for (size_t source = 0; source < ranks; ++source) {
+    auto records     = ucxx::TrafficCapture::read(app_context.traces[source]);
+    auto sourceSends = getSends(records, source, ranks);
+    if (source == app_context.rank) {
+      sends = std::move(sourceSends);
+      continue;
+    }
+    for (auto& op : sourceSends) {
+      if (op.peer != app_context.rank) continue;
+      op.peer = source;
+      receives.push_back(op);
+    }
+  }
+  std::stable_sort(receives.begin(), receives.end(), [](const auto& a, const auto& b) {
+    return a.time < b.time;
+  });
+
+  ScratchBuffers sendBuffers(app_context.host_memory);
+  ScratchBuffers recvBuffers(app_context.host_memory);
+  sendBuffers.reserve(sends);
+  recvBuffers.reserve(receives);
+
+  auto context     = ucxx::createContext({}, ucxx::Context::defaultFeatureFlags);
+  auto worker      = context->createWorker();
+  auto peerContext = std::make_shared<PeerContext>();
+  // Do not capture the replay itself if `UCXX_TRAFFIC_CAPTURE` is set
+  worker->stopTrafficCapture();
+  peerContext->setListener(worker->createListener(
+    app_context.listener_port + app_context.rank, listener_cb, peerContext.get()));
+  worker->startProgressThread(true);
+
+  auto endpoints = connectPeers(app_context, worker, *peerContext);
+  barrier(worker, endpoints, 0);
+
+  std::thread receiverThread(runReceiver,
+                             std::cref(app_context),
+                             worker,
+                             std::cref(endpoints),
+                             std::cref(receives),
+                             std::ref(recvBuffers));
+
+  // Post sends at their recorded times, relative to the first operation of the trace
+  const auto start   = Clock::now();
+  uint64_t sentBytes = 0;
+  uint64_t totalLag  = 0;
+  uint64_t maxLag    = 0;
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.reserve(sends.size());
+  for (const auto& op : sends) {
+    if (!app_context.as_fast) {
+      auto due = start + std::chrono::nanoseconds(
+                           static_cast<uint64_t>(op.time / app_context.time_scale));
+      std::this_thread::sleep_until(due);
+      auto lag = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - due).count();
+      totalLag += lag;
+      maxLag = std::max<uint64_t>(maxLag, lag);
+    }
+    requests.push_back(postSend(endpoints[op.peer], sendBuffers, op));
+    sentBytes += op.size;
+  }
+  waitRequests(requests);
+  receiverThread.join();
+  const auto stop = Clock::now();
+
+  barrier(worker, endpoints, 1);
+
+  uint64_t receivedBytes = 0;
+  for (const auto& op : receives)
+    receivedBytes += op.size;
+  const uint64_t tracedNs = std::max(sends.empty() ? 0 : sends.back().time,
+                                     receives.empty() ? 0 : receives.back().time);
+  const uint64_t elapsedNs =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+  const double elapsedSeconds = std::max<double>(elapsedNs, 1) / 1e9;
+
+  std::cout << "Rank " << app_context.rank << " of " << ranks << std::endl;
+  std::cout << "Sends, receives: " << sends.size() << ", " << receives.size() << std::endl;
+  std::cout << "Bytes sent, received: " << sentBytes << ", " << receivedBytes << std::endl;
+  std::cout << "Elapsed, traced time: " << parseTime(elapsedNs) << ", " << parseTime(tracedNs)
+            << std::endl;
+  std::cout << "Send, receive bandwidth: " << parseBandwidth(sentBytes / elapsedSeconds) << ", "
+            << parseBandwidth(receivedBytes / elapsedSeconds) << std::endl;
+  if (!app_context.as_fast && !sends.empty())
+    std::cout << "Send lag mean, max: " << parseTime(totalLag / sends.size()) << ", "
+              << parseTime(maxLag) << std::endl;
+
+  worker->stopProgressThread();
+
+  return 0;
+}
@@ -0,0 +1,24 @@
+# =============================================================================
+# Copyright (c) 2023, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+# in compliance with the License. You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software distributed under the License
+# is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+# or implied. See the License for the specific language governing permissions and limitations under
+# the License.
+# =============================================================================
+
+# This function finds Google Benchmark and sets any additional necessary environment variables.
+function(find_and_configure_gbench)
+  include(${rapids-cmake-dir}/cpm/gbench.cmake)
+
+  # Find or install Google Benchmark
+  rapids_cpm_gbench(BUILD_STATIC)
+
+endfunction()
+
+find_and_configure_gbench()
@@ -24,6 +24,7 @@ class Address : public Component {
  private:
   ucp_address_t* _handle{nullptr};
   size_t _length{0};
+  std::string _buffer{};  ///< Storage of the address if not owned by a worker
 
   /**
    * @brief Private constructor of `ucxx::Address`.
@@ -44,6 +45,16 @@ class Address : public Component {
    */
   Address(std::shared_ptr<Worker> worker, ucp_address_t* address, size_t length);
 
+  /**
+   * @brief Private constructor of `ucxx::Address` from a byte-string.
+   *
+   * Construct an address of a remote worker taking ownership of the byte-string
+   * containing it, avoiding copies when the string is moved in.
+   *
+   * @param[in] addressString  the byte-string containing the address.
+   */
+  explicit Address(std::string addressString);
+
  public:
   Address()                          = delete;
   Address(const Address&)            = delete;
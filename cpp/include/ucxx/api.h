@@ -10,14 +10,32 @@
 
 #include <ucxx/address.h>
 #include <ucxx/buffer.h>
+#include <ucxx/buffer_pool.h>
+#include <ucxx/collectives.h>
+#include <ucxx/completion_executor.h>
+#include <ucxx/completion_queue.h>
 #include <ucxx/constructors.h>
 #include <ucxx/context.h>
 #include <ucxx/endpoint.h>
 #include <ucxx/header.h>
 #include <ucxx/inflight_requests.h>
 #include <ucxx/listener.h>
+#include <ucxx/memory_handle.h>
+#include <ucxx/remote_key.h>
 #include <ucxx/request.h>
+#include <ucxx/request_file.h>
 #include <ucxx/request_tag_multi.h>
+#include <ucxx/request_trace.h>
+#include <ucxx/statistics.h>
+#include <ucxx/stream_data.h>
+#include <ucxx/tag_recv_ring.h>
+#include <ucxx/timer_wheel.h>
+#include <ucxx/traffic_capture.h>
 #include <ucxx/typedefs.h>
 #include <ucxx/utils/callback_notifier.h>
+#include <ucxx/utils/compression.h>
+#include <ucxx/utils/cuda.h>
+#include <ucxx/utils/tag.h>
+#include <ucxx/utils/topology.h>
 #include <ucxx/worker.h>
+#include <ucxx/worker_pool.h>
@@ -4,13 +4,20 @@
  */
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
+#include <ucp/api/ucp.h>
+
 #include <ucxx/log.h>
+#include <ucxx/typedefs.h>
 
 #if UCXX_ENABLE_RMM
+#include <rmm/cuda_stream_view.hpp>
 #include <rmm/device_buffer.hpp>
+#include <rmm/mr/device/device_memory_resource.hpp>
+#include <rmm/mr/device/per_device_resource.hpp>
 #endif
 
 namespace ucxx {
@@ -23,9 +30,42 @@ namespace ucxx {
 enum class BufferType {
   Host = 0,
   RMM,
+  AmData,
+  Pinned,
   Invalid,
 };
 
+/**
+ * @brief The huge pages backing a host buffer.
+ *
+ * The pages backing a `ucxx::HostBuffer`, huge pages reduce TLB pressure when accessing
+ * large buffers and the number of pages UCX must register with network devices.
+ */
+enum class HugePages {
+  Disabled = 0,  ///< Regular pages, allocated with `malloc` unless bound to a NUMA node
+  Transparent,   ///< Transparent huge pages, mapping aligned to 2MiB and `MADV_HUGEPAGE`
+  Size2MB,       ///< Explicit 2MiB huge pages with `MAP_HUGETLB`
+  Size1GB,       ///< Explicit 1GiB huge pages with `MAP_HUGETLB`
+};
+
+/**
+ * @brief Options of the memory allocated by `ucxx::HostBuffer`.
+ *
+ * Explicit huge pages are only available if reserved by the system administrator, e.g.,
+ * via `/proc/sys/vm/nr_hugepages`, allocations fall back to transparent huge pages when
+ * none are available. Buffers smaller than half the huge page size use regular pages, as
+ * rounding them up would waste most of the huge page.
+ */
+struct HostAllocationOptions {
+  HugePages hugePages{HugePages::Disabled};  ///< The pages backing the buffer
+  int numaNode{-1};                          ///< The NUMA node to bind to, `-1` for none
+  bool prefault{false};  ///< Whether to touch all pages when allocating, moving the cost
+                         ///< of first-touch page faults out of the transfers
+};
+
+class BufferPool;
+class Worker;
+
 /**
  * @brief A simple object to simplify managing buffers.
  *
@@ -35,6 +75,8 @@ enum class BufferType {
  * this type to describe the internally-allocated buffers.
  */
 class Buffer {
+  friend class BufferPool;
+
  protected:
   BufferType _bufferType{BufferType::Invalid};  ///< Buffer type
   size_t _size;                                 ///< Buffer size
@@ -102,7 +144,8 @@ class Buffer {
  */
 class HostBuffer : public Buffer {
  private:
-  void* _buffer;  ///< Pointer to the allocated buffer
+  void* _buffer;          ///< Pointer to the allocated buffer
+  size_t _mappedSize{0};  ///< Size of the mapping holding the buffer, `0` if `malloc`ed
 
  public:
   HostBuffer()                             = delete;
@@ -126,6 +169,26 @@ class HostBuffer : public Buffer {
    */
   explicit HostBuffer(const size_t size);
 
+  /**
+   * @brief Constructor of concrete type `HostBuffer` with allocation options.
+   *
+   * Constructor to materialize a buffer holding host memory allocated as specified by
+   * `options`. Buffers backed by huge pages or bound to a NUMA node are mapped with `mmap`
+   * instead, and can not be released to the caller, see `isMapped()`.
+   *
+   * @throws std::bad_alloc     if the allocation fails.
+   * @throws std::runtime_error if the memory could not be bound to `options.numaNode`.
+   *
+   * @param[in] size    the size of the host buffer to allocate.
+   * @param[in] options the options of the allocated memory.
+   *
+   * @code{.cpp}
+   * // Allocate host buffer of 1GiB backed by 2MiB huge pages on NUMA node 0
+   * auto buffer = HostBuffer(1 << 30, {ucxx::HugePages::Size2MB, 0});
+   * @endcode
+   */
+  HostBuffer(const size_t size, const HostAllocationOptions& options);
+
   /**
    * @brief Destructor of concrete type `HostBuffer`.
    *
@@ -155,12 +218,23 @@ class HostBuffer : public Buffer {
    * free(bufferPtr);
    * @endcode
    *
-   * @throws std::runtime_error if object has been released.
+   * @throws std::runtime_error if object has been released or the buffer is mapped, see
+   *                            `isMapped()`.
    *
    * @return the void pointer to the buffer.
    */
   void* release();
 
+  /**
+   * @brief Check whether the buffer is mapped with `mmap`.
+   *
+   * Buffers backed by huge pages or bound to a NUMA node are mapped with `mmap` and can
+   * not be disposed of with `free`, thus can not be released to the caller.
+   *
+   * @return `true` if the buffer is mapped, `false` if allocated with `malloc`.
+   */
+  bool isMapped() const noexcept;
+
   /**
    * @brief Get a pointer to the allocated raw host buffer.
    *
@@ -183,13 +257,182 @@ class HostBuffer : public Buffer {
   virtual void* data();
 };
 
+/**
+ * @brief A host buffer holding active message data owned by UCX.
+ *
+ * A buffer encapsulating the data of an eager active message that UCX allowed the receiver
+ * to hold, avoiding an allocation and copy upon receiving. The data remains owned by UCX
+ * and is returned to it with `ucp_am_data_release()` when the object is destroyed, thus it
+ * cannot be released to the caller. The object keeps a reference to the worker that
+ * received the message, which therefore stays alive while the buffer is in use.
+ *
+ * Whether the data is retained past the active message callback is decided atomically by
+ * either `retain()` or the destructor, whichever runs first, so that the data is never
+ * released by `ucp_am_data_release()` while UCX may still take it back.
+ */
+class AmDataBuffer : public Buffer {
+ private:
+  std::shared_ptr<Worker> _worker{nullptr};  ///< The worker that received the data
+  void* _buffer{nullptr};                    ///< Pointer to the UCX-owned data
+  std::shared_ptr<std::atomic<bool>> _decided{
+    std::make_shared<std::atomic<bool>>(false)};  ///< Whether ownership was decided
+
+ public:
+  AmDataBuffer()                               = delete;
+  AmDataBuffer(const AmDataBuffer&)            = delete;
+  AmDataBuffer& operator=(AmDataBuffer const&) = delete;
+  AmDataBuffer(AmDataBuffer&& o)               = delete;
+  AmDataBuffer& operator=(AmDataBuffer&& o)    = delete;
+
+  /**
+   * @brief Constructor of concrete type `AmDataBuffer`.
+   *
+   * Constructor taking ownership of UCX-owned active message data, which must have been
+   * received with `UCP_AM_RECV_ATTR_FLAG_DATA` set and retained by returning
+   * `UCS_INPROGRESS` from the active message callback.
+   *
+   * @param[in] worker  the worker that received the data.
+   * @param[in] data    the data pointer received by the active message callback.
+   * @param[in] size    the size of the data in bytes.
+   */
+  AmDataBuffer(std::shared_ptr<Worker> worker, void* data, const size_t size);
+
+  /**
+   * @brief Destructor of concrete type `AmDataBuffer`.
+   *
+   * Return the data to UCX with `ucp_am_data_release()`, unless it was released to the
+   * caller after a call to `release`. If destroyed before `retain()` was called, the data
+   * is not released, `retain()` then returns `false` and the active message callback must
+   * give it back to UCX by returning `UCS_OK`.
+   */
+  ~AmDataBuffer();
+
+  /**
+   * @brief Decide whether the data is retained past the active message callback.
+   *
+   * Drop the reference held by the active message callback that received the data and
+   * decide whether it is retained. Must be called by that callback only, right before
+   * returning, after which the reference passed becomes invalid.
+   *
+   * @param[in] buffer  the reference held by the active message callback.
+   *
+   * @returns `true` if other references remain, in which case the callback must return
+   *          `UCS_INPROGRESS` and the data is released once the last one is dropped,
+   *          `false` if all references were dropped, in which case the callback must return
+   *          `UCS_OK`.
+   */
+  static bool retain(std::shared_ptr<AmDataBuffer>&& buffer);
+
+  /**
+   * @brief Release the active message data to the caller.
+   *
+   * Release ownership of the data to the caller, which becomes responsible for returning
+   * it to UCX with `ucp_am_data_release()`. The original `AmDataBuffer` object becomes
+   * invalid.
+   *
+   * @throws std::runtime_error if object has been released.
+   *
+   * @return the void pointer to the buffer.
+   */
+  void* release();
+
+  /**
+   * @brief Get a pointer to the active message data.
+   *
+   * Get a pointer to the UCX-owned active message data, valid for the lifetime of the
+   * object.
+   *
+   * @throws std::runtime_error if object has been released.
+   *
+   * @return the void pointer to the buffer.
+   */
+  virtual void* data();
+};
+
 #if UCXX_ENABLE_RMM
+/**
+ * @brief A simple object containing a page-locked host buffer.
+ *
+ * A buffer encapsulating a page-locked (pinned) host buffer allocated with
+ * `cudaHostAlloc`. Copies between pinned host memory and device memory are performed
+ * directly by DMA, achieving higher bandwidth than pageable `ucxx::HostBuffer` memory, thus
+ * pinned buffers are suitable for staging host<->device transfers, such as of data spilled
+ * from device memory. Pinning memory is expensive and reduces memory available to the
+ * system, allocations should preferably be reused with a `ucxx::BufferPool` of
+ * `ucxx::BufferType::Pinned` buffers.
+ */
+class PinnedHostBuffer : public Buffer {
+ private:
+  void* _buffer{nullptr};  ///< Pointer to the allocated buffer
+
+ public:
+  PinnedHostBuffer()                                   = delete;
+  PinnedHostBuffer(const PinnedHostBuffer&)            = delete;
+  PinnedHostBuffer& operator=(PinnedHostBuffer const&) = delete;
+  PinnedHostBuffer(PinnedHostBuffer&& o)               = delete;
+  PinnedHostBuffer& operator=(PinnedHostBuffer&& o)    = delete;
+
+  /**
+   * @brief Constructor of concrete type `PinnedHostBuffer`.
+   *
+   * Constructor to materialize a buffer holding pinned host memory. The internal buffer
+   * is allocated using `cudaHostAlloc`, and thus should be freed with `cudaFreeHost`.
+   *
+   * @throws std::bad_alloc if the allocation fails.
+   *
+   * @param[in] size the size of the pinned host buffer to allocate.
+   *
+   * @code{.cpp}
+   * // Allocate pinned host buffer of 1KiB
+   * auto buffer = PinnedHostBuffer(1024);
+   * @endcode
+   */
+  explicit PinnedHostBuffer(const size_t size);
+
+  /**
+   * @brief Destructor of concrete type `PinnedHostBuffer`.
+   *
+   * Frees the underlying buffer, unless the underlying buffer was released to
+   * the user after a call to `release`.
+   */
+  ~PinnedHostBuffer();
+
+  /**
+   * @brief Release the allocated pinned host buffer to the caller.
+   *
+   * Release ownership of the buffer to the caller. After this method is called,
+   * the caller becomes responsible for its deallocation once it is not needed
+   * anymore. The buffer is allocated with `cudaHostAlloc`, and should be properly
+   * disposed of by a call to `cudaFreeHost`.
+   *
+   * The original `PinnedHostBuffer` object becomes invalid.
+   *
+   * @throws std::runtime_error if object has been released.
+   *
+   * @return the void pointer to the buffer.
+   */
+  void* release();
+
+  /**
+   * @brief Get a pointer to the allocated raw pinned host buffer.
+   *
+   * Get a pointer to the underlying buffer, but does not release ownership.
+   *
+   * @throws std::runtime_error if object has been released.
+   *
+   * @return the void pointer to the buffer.
+   */
+  virtual void* data();
+};
+
 /**
  * @brief A simple object containing a RMM (CUDA) buffer.
  *
  * A buffer encapsulating an RMM (CUDA) buffer with its properties.
  */
 class RMMBuffer : public Buffer {
+  friend class BufferPool;
+
  private:
   std::unique_ptr<rmm::device_buffer> _buffer;  ///< RMM-allocated device buffer
 
@@ -207,14 +450,37 @@ class RMMBuffer : public Buffer {
    * buffer holds a `std::unique_ptr<rmm::device_buffer>` and is destroyed
    * when the object goes out-of-scope or is explicitly deleted.
    *
-   * @param[in] size the size of the device buffer to allocate.
+   * The allocation, and later deallocation, is ordered on `stream` and served by the
+   * memory resource `mr`. Allocating on a non-default stream prevents synchronizing with
+   * work submitted to the legacy default stream, the caller must ensure the memory is safe
+   * to access by UCX when the transfer is posted, for example by using a memory resource
+   * whose allocations are immediately usable or by synchronizing `stream`.
+   *
+   * @param[in] size    the size of the device buffer to allocate.
+   * @param[in] stream  the CUDA stream the allocation is ordered on.
+   * @param[in] mr      the memory resource to allocate from.
    *
    * @code{.cpp}
-   * // Allocate host buffer of 1KiB
+   * // Allocate device buffer of 1KiB
    * auto buffer = RMMBuffer(1024);
+   *
+   * // Allocate device buffer of 1KiB ordered on `stream`
+   * auto streamBuffer = RMMBuffer(1024, stream);
    * @endcode
    */
-  explicit RMMBuffer(const size_t size);
+  explicit RMMBuffer(
+    const size_t size,
+    rmm::cuda_stream_view stream        = rmm::cuda_stream_default,
+    rmm::mr::device_memory_resource* mr = rmm::mr::get_current_device_resource());
+
+  /**
+   * @brief Get the CUDA stream the buffer allocation is ordered on.
+   *
+   * @throws std::runtime_error if object has been released.
+   *
+   * @return the CUDA stream the buffer was allocated on.
+   */
+  rmm::cuda_stream_view getStream() const;
 
   /**
    * @brief Release the allocated `rmm::device_buffer` to the caller.
@@ -274,6 +540,21 @@ class RMMBuffer : public Buffer {
  * Allocate a buffer of the specified type and size pair, returning the `ucxx::Buffer`
  * object wrapped in a `std::shared_ptr`.
  *
+ * Buffers of type `ucxx::BufferType::Pinned` are host buffers suitable for registering
+ * with `ucxx::Worker::registerBufferAllocator()` or `ucxx::Worker::registerAmAllocator()`
+ * for receiving host data that is later copied to or from device memory.
+ *
+ * @code{.cpp}
+ * // `worker` is `std::shared_ptr<ucxx::Worker>`
+ * auto pool = std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Pinned);
+ * worker->registerBufferAllocator(ucxx::BufferType::Host, pool->getAmAllocator());
+ * worker->registerAmAllocator(UCS_MEMORY_TYPE_HOST, pool->getAmAllocator());
+ * @endcode
+ *
+ * @throws std::runtime_error if `bufferType` is `ucxx::BufferType::RMM` or
+ *                            `ucxx::BufferType::Pinned` and UCXX was built without RMM
+ *                            support.
+ *
  * @param[in] bufferType  the type of buffer to allocate.
  * @param[in] size        the size (in bytes) of the buffer to allocate.
  *
@@ -281,4 +562,92 @@ class RMMBuffer : public Buffer {
  */
 std::shared_ptr<Buffer> allocateBuffer(BufferType bufferType, const size_t size);
 
+/**
+ * @brief Allocate a buffer of specified type and size, host buffers with options.
+ *
+ * Allocate a buffer of the specified type and size pair, as `allocateBuffer()`, but
+ * allocating `ucxx::HostBuffer` objects as specified by `options`.
+ *
+ * @throws std::runtime_error if `bufferType` is `ucxx::BufferType::RMM` or
+ *                            `ucxx::BufferType::Pinned` and UCXX was built without RMM
+ *                            support, or the memory could not be bound to the NUMA node.
+ *
+ * @param[in] bufferType  the type of buffer to allocate.
+ * @param[in] size        the size (in bytes) of the buffer to allocate.
+ * @param[in] options     the options of host buffers.
+ *
+ * @returns the `std::shared_ptr` to the allocated buffer.
+ */
+std::shared_ptr<Buffer> allocateBuffer(BufferType bufferType,
+                                       const size_t size,
+                                       const HostAllocationOptions& options);
+
+/**
+ * @brief Create an allocator of host buffers with options.
+ *
+ * Create an allocator of `ucxx::HostBuffer` objects allocated as specified by `options`,
+ * that may be registered with `ucxx::Worker::registerBufferAllocator()` for buffers
+ * allocated internally, such as received `ucxx::RequestTagMulti` frames, and with
+ * `ucxx::Worker::registerAmAllocator()` for active messages. To also reuse buffers, use
+ * a `ucxx::BufferPool` created with the same options instead.
+ *
+ * @code{.cpp}
+ * // `worker` is `std::shared_ptr<ucxx::Worker>`
+ * auto allocator = ucxx::createHostAllocator({ucxx::HugePages::Transparent, 1});
+ * worker->registerBufferAllocator(ucxx::BufferType::Host, allocator);
+ * worker->registerAmAllocator(UCS_MEMORY_TYPE_HOST, allocator);
+ * @endcode
+ *
+ * @param[in] options  the options of the allocated memory.
+ *
+ * @returns the allocator.
+ */
+AmAllocatorType createHostAllocator(const HostAllocationOptions& options);
+
+#if UCXX_ENABLE_RMM
+/**
+ * @brief Allocate a buffer of specified type and size, RMM buffers on a stream.
+ *
+ * Allocate a buffer of the specified type and size pair, as `allocateBuffer()`, but
+ * allocating `ucxx::RMMBuffer` objects on `stream` from the memory resource `mr`.
+ *
+ * @param[in] bufferType  the type of buffer to allocate.
+ * @param[in] size        the size (in bytes) of the buffer to allocate.
+ * @param[in] stream      the CUDA stream RMM allocations are ordered on.
+ * @param[in] mr          the memory resource RMM allocations are served from.
+ *
+ * @returns the `std::shared_ptr` to the allocated buffer.
+ */
+std::shared_ptr<Buffer> allocateBuffer(
+  BufferType bufferType,
+  const size_t size,
+  rmm::cuda_stream_view stream,
+  rmm::mr::device_memory_resource* mr = rmm::mr::get_current_device_resource());
+
+/**
+ * @brief Create a stream-ordered allocator of RMM buffers.
+ *
+ * Create an allocator of `ucxx::RMMBuffer` objects ordered on `stream` and served by `mr`,
+ * that may be registered with `ucxx::Worker::registerBufferAllocator()` for buffers
+ * allocated internally, such as received `ucxx::RequestTagMulti` frames, and with
+ * `ucxx::Worker::registerAmAllocator()` for active messages.
+ *
+ * @code{.cpp}
+ * // `worker` is `std::shared_ptr<ucxx::Worker>`, `stream` is `rmm::cuda_stream_view`
+ * auto allocator = ucxx::createRMMAllocator(stream);
+ * worker->registerBufferAllocator(ucxx::BufferType::RMM, allocator);
+ * worker->registerAmAllocator(UCS_MEMORY_TYPE_CUDA, allocator);
+ * @endcode
+ *
+ * @param[in] stream  the CUDA stream allocations are ordered on.
+ * @param[in] mr      the memory resource allocations are served from, which must outlive
+ *                    the allocator and all buffers it allocates.
+ *
+ * @returns the allocator.
+ */
+AmAllocatorType createRMMAllocator(
+  rmm::cuda_stream_view stream,
+  rmm::mr::device_memory_resource* mr = rmm::mr::get_current_device_resource());
+#endif
+
 }  // namespace ucxx
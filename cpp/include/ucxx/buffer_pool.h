@@ -0,0 +1,203 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ucxx/buffer.h>
+#include <ucxx/typedefs.h>
+
+namespace ucxx {
+
+/**
+ * @brief A thread-safe pool of reusable buffers divided in size classes.
+ *
+ * A thread-safe pool of `ucxx::HostBuffer`, `ucxx::PinnedHostBuffer` or `ucxx::RMMBuffer`
+ * objects divided in power-of-two size classes. A buffer handed out by the pool is returned
+ * to it when the last reference to its `std::shared_ptr` is dropped, and reused by
+ * subsequent allocations of the same size class, thus avoiding allocating and freeing
+ * memory for each message, which is particularly important for pinned host buffers whose
+ * allocation is expensive.
+ * Allocations larger than the largest size class, or exceeding the cache limit upon
+ * return, are not cached.
+ *
+ * Buffers handed out report the requested size from `getSize()` and are of the regular
+ * buffer types, thus they can be used wherever a `ucxx::Buffer` is expected. Buffers whose
+ * underlying memory is released to the user with `release()` are not returned to the pool.
+ *
+ * The pool must be managed by a `std::shared_ptr`, all buffers handed out keep a
+ * reference to it.
+ *
+ * @code{.cpp}
+ * // `worker` is `std::shared_ptr<ucxx::Worker>`
+ * auto pool = std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Host);
+ * worker->registerAmAllocator(UCS_MEMORY_TYPE_HOST, pool->getAmAllocator());
+ * worker->registerBufferPool(pool);
+ * @endcode
+ */
+class BufferPool : public std::enable_shared_from_this<BufferPool> {
+ public:
+  static constexpr size_t MinBufferSize = 256;  ///< Size of the smallest size class
+  static constexpr size_t SizeClasses   = 20;   ///< Number of size classes
+  static constexpr size_t MaxBufferSize =
+    MinBufferSize << (SizeClasses - 1);  ///< Size of the largest size class
+
+ private:
+  /**
+   * @brief Cached buffers of a single size class.
+   */
+  struct FreeList {
+    std::mutex mutex{};                              ///< Mutex to control access to the buffers
+    std::vector<std::unique_ptr<Buffer>> buffers{};  ///< The cached buffers
+  };
+
+  BufferType _bufferType{BufferType::Invalid};     ///< The type of buffers in the pool
+  size_t _maxCachedBytes{0};                       ///< Maximum total size of cached buffers
+  HostAllocationOptions _hostOptions{};            ///< Options of host buffers allocated
+  std::array<FreeList, SizeClasses> _freeLists{};  ///< Cached buffers of each size class
+  std::atomic<size_t> _cachedBytes{0};             ///< Total size of cached buffers
+  std::atomic<size_t> _hits{0};                    ///< Number of allocations served from cache
+  std::atomic<size_t> _misses{0};                  ///< Number of allocations needing new memory
+
+  /**
+   * @brief Get the size class of a buffer size.
+   *
+   * @param[in] size  the size in bytes.
+   *
+   * @returns The size class index, or `SizeClasses` if larger than `MaxBufferSize`.
+   */
+  static size_t getSizeClass(const size_t size);
+
+  /**
+   * @brief Allocate a new buffer.
+   *
+   * @param[in] size  the size of the buffer in bytes.
+   *
+   * @returns The newly allocated buffer.
+   */
+  std::unique_ptr<Buffer> createBuffer(const size_t size);
+
+  /**
+   * @brief Set the size a buffer reports.
+   *
+   * Set the size a buffer reports to `size`, which must not exceed its allocated size.
+   *
+   * @param[in] buffer  the buffer.
+   * @param[in] size    the size in bytes.
+   */
+  void setBufferSize(Buffer& buffer, const size_t size);
+
+  /**
+   * @brief Return a buffer to the pool.
+   *
+   * Return a buffer to the free list of its size class, or destroy it if it was released
+   * or the cache is full.
+   *
+   * @param[in] buffer    the buffer to return.
+   * @param[in] sizeClass the size class of the buffer.
+   */
+  void deallocate(std::unique_ptr<Buffer> buffer, const size_t sizeClass);
+
+ public:
+  BufferPool()                             = delete;
+  BufferPool(const BufferPool&)            = delete;
+  BufferPool& operator=(BufferPool const&) = delete;
+  BufferPool(BufferPool&& o)               = delete;
+  BufferPool& operator=(BufferPool&& o)    = delete;
+
+  /**
+   * @brief Constructor of a buffer pool.
+   *
+   * Construct a pool of buffers of type `bufferType`, caching up to `maxCachedBytes` of
+   * returned buffers across all size classes. Host buffers are allocated as specified by
+   * `hostOptions`, e.g., backed by huge pages bound to the NUMA node of the network device,
+   * which also amortizes the cost of mapping them over all messages reusing them.
+   *
+   * @code{.cpp}
+   * // `worker` is `std::shared_ptr<ucxx::Worker>`
+   * auto pool = std::make_shared<ucxx::BufferPool>(
+   *   ucxx::BufferType::Host, 4ul << 30, ucxx::HostAllocationOptions{ucxx::HugePages::Size2MB, 0});
+   * worker->registerBufferPool(pool);
+   * @endcode
+   *
+   * @throws std::runtime_error if `bufferType` is not `ucxx::BufferType::Host` or, when
+   *                            built with RMM support, `ucxx::BufferType::Pinned` or
+   *                            `ucxx::BufferType::RMM`.
+   *
+   * @param[in] bufferType      the type of buffers in the pool.
+   * @param[in] maxCachedBytes  maximum total size in bytes of cached buffers.
+   * @param[in] hostOptions     the options of host buffers allocated by the pool, ignored
+   *                            for other buffer types.
+   */
+  explicit BufferPool(const BufferType bufferType,
+                      const size_t maxCachedBytes              = 256 << 20,
+                      const HostAllocationOptions& hostOptions = {});
+
+  /**
+   * @brief Get a buffer from the pool.
+   *
+   * Get a buffer of at least `size` bytes from the pool, reusing a cached buffer of the
+   * same size class if available or allocating a new one otherwise. The buffer returns to
+   * the pool once the last reference to it is dropped.
+   *
+   * @param[in] size  the size of the buffer in bytes.
+   *
+   * @returns The buffer, reporting `size` from `getSize()`.
+   */
+  std::shared_ptr<Buffer> allocate(const size_t size);
+
+  /**
+   * @brief Get an active message allocator backed by the pool.
+   *
+   * Get an allocator that can be registered with `ucxx::Worker::registerAmAllocator()`,
+   * allocating active message receive buffers from the pool.
+   *
+   * @returns The active message allocator.
+   */
+  AmAllocatorType getAmAllocator();
+
+  /**
+   * @brief Get the type of buffers in the pool.
+   *
+   * @returns The type of buffers in the pool.
+   */
+  BufferType getType() const noexcept;
+
+  /**
+   * @brief Get the number of allocations served from the cache.
+   *
+   * @returns The number of allocations that reused a cached buffer.
+   */
+  size_t getHits() const noexcept;
+
+  /**
+   * @brief Get the number of allocations not served from the cache.
+   *
+   * @returns The number of allocations that required allocating new memory.
+   */
+  size_t getMisses() const noexcept;
+
+  /**
+   * @brief Get the total size of cached buffers.
+   *
+   * @returns The total size in bytes of buffers currently cached.
+   */
+  size_t getCachedBytes() const noexcept;
+
+  /**
+   * @brief Free all cached buffers.
+   *
+   * Free all cached buffers, buffers currently in use are unaffected and are still
+   * returned to the pool when released.
+   */
+  void clear();
+};
+
+}  // namespace ucxx
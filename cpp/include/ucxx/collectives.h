@@ -0,0 +1,344 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <ucxx/typedefs.h>
+
+namespace ucxx {
+
+class Endpoint;
+class Request;
+class Worker;
+
+/**
+ * @brief A group of ranks performing collective operations over endpoints.
+ *
+ * A group of ranks, each owning one worker, performing collective operations, such as
+ * broadcast, allgather and all-to-all, over the tag API of the endpoints connecting them.
+ * Each rank must call the same collective operations in the same order with matching
+ * arguments, as it would with MPI. The algorithm implementing each operation is selected
+ * by the message size and the number of ranks, latency-bound algorithms are used for
+ * small messages, while large messages are split in chunks of
+ * `CollectiveConfig::chunkSize` bytes and pipelined along bandwidth-optimal algorithms,
+ * so that ranks forward a chunk while receiving the next ones.
+ *
+ * Buffers may be host or CUDA memory, transfers are handled by UCX according to the
+ * memory type of each buffer, thus CUDA buffers require UCX to be built with CUDA support.
+ *
+ * Messages of collective operations are matched with tags derived from the tag base of
+ * the group, the rank of their sender and the sequence number of the operation, which
+ * must thus not be used by other messages received by the same worker. Operations block
+ * until they complete locally, progressing the worker unless it runs a progress thread,
+ * and a group must thus only be used by one thread at a time.
+ */
+class CollectiveGroup {
+ private:
+  std::shared_ptr<Worker> _worker{nullptr};              ///< The worker of the local rank
+  std::vector<std::shared_ptr<Endpoint>> _endpoints{};  ///< The endpoints to each rank
+  size_t _rank{0};                                       ///< The local rank
+  Tag _tagBase{0};                                       ///< The tag base of all messages
+  CollectiveConfig _config{};                            ///< The tuning parameters
+  uint64_t _sequence{0};                                 ///< Sequence number of the operation
+
+  /**
+   * @brief Private constructor of `ucxx::CollectiveGroup`.
+   *
+   * This is the internal implementation of `ucxx::CollectiveGroup` constructor, made
+   * private not to be called directly. Instead the user should call
+   * `ucxx::createCollectiveGroup()`.
+   *
+   * @throws std::invalid_argument if `rank` is not smaller than the number of endpoints,
+   *                               if an endpoint of a remote rank is missing or if the
+   *                               chunk size or pairwise window are zero.
+   *
+   * @param[in] worker    the worker of the local rank.
+   * @param[in] endpoints the endpoints to each rank, indexed by rank.
+   * @param[in] rank      the local rank.
+   * @param[in] tagBase   the tag base of all messages of the group.
+   * @param[in] config    the tuning parameters of the collective operations.
+   */
+  CollectiveGroup(std::shared_ptr<Worker> worker,
+                  std::vector<std::shared_ptr<Endpoint>> endpoints,
+                  size_t rank,
+                  Tag tagBase,
+                  CollectiveConfig config);
+
+  /**
+   * @brief Get the tag of a message of the current operation.
+   *
+   * @param[in] source  the rank sending the message.
+   * @param[in] index   the index of the message among those the source sends in the
+   *                    current operation to the same rank.
+   *
+   * @returns The tag of the message.
+   */
+  [[nodiscard]] Tag getTag(size_t source, uint64_t index) const;
+
+  /**
+   * @brief Get the size of the chunks to split blocks of a given length in.
+   *
+   * Get the size of the chunks to split blocks in, `CollectiveConfig::chunkSize` unless
+   * the chunks of all blocks sent to the same rank would exceed the indices of the tags.
+   *
+   * @param[in] length  the length in bytes of the blocks.
+   * @param[in] blocks  the number of blocks sent to the same rank.
+   *
+   * @returns The size in bytes of the chunks, never zero.
+   */
+  [[nodiscard]] size_t getChunkSize(size_t length, size_t blocks = 1) const;
+
+  /**
+   * @brief Begin a collective operation, advancing the sequence number.
+   */
+  void begin();
+
+  /**
+   * @brief Send a block to a rank, split in chunks.
+   *
+   * @param[in]  peer       the rank to send to.
+   * @param[in]  buffer     the block to send.
+   * @param[in]  length     the length in bytes of the block.
+   * @param[in]  chunkSize  the size in bytes of the chunks to split the block in.
+   * @param[in]  index      the index of the first chunk.
+   * @param[out] requests   the requests to append the requests of each chunk to.
+   */
+  void sendBlock(size_t peer,
+                 const void* buffer,
+                 size_t length,
+                 size_t chunkSize,
+                 uint64_t index,
+                 std::vector<std::shared_ptr<Request>>& requests);
+
+  /**
+   * @brief Receive a block from a rank, split in chunks.
+   *
+   * @param[in]  peer       the rank to receive from.
+   * @param[in]  buffer     the buffer to receive the block into.
+   * @param[in]  length     the length in bytes of the block.
+   * @param[in]  chunkSize  the size in bytes of the chunks to split the block in.
+   * @param[in]  index      the index of the first chunk.
+   * @param[out] requests   the requests to append the requests of each chunk to.
+   */
+  void recvBlock(size_t peer,
+                 void* buffer,
+                 size_t length,
+                 size_t chunkSize,
+                 uint64_t index,
+                 std::vector<std::shared_ptr<Request>>& requests);
+
+  /**
+   * @brief Wait for a request to complete, progressing the worker if needed.
+   *
+   * @throws ucxx::Error  if the request failed.
+   *
+   * @param[in] request the request to wait for.
+   */
+  void wait(const std::shared_ptr<Request>& request);
+
+  /**
+   * @brief Wait for requests to complete, cancelling the others if one fails.
+   *
+   * Wait for all requests to complete. If one fails, all other requests are canceled and
+   * waited for before rethrowing, so that no transfer accesses the buffers of an operation
+   * after it returned.
+   *
+   * @throws ucxx::Error  the error of the first request that failed.
+   *
+   * @param[in] requests  the requests to wait for.
+   */
+  void waitAll(const std::vector<std::shared_ptr<Request>>& requests);
+
+  /**
+   * @brief Cancel and wait for all requests that did not complete yet.
+   *
+   * @param[in] requests  the requests to cancel.
+   */
+  void cancelAll(const std::vector<std::shared_ptr<Request>>& requests);
+
+  /**
+   * @brief Broadcast along a tree, the parent of each rank forwarding to its children.
+   *
+   * @param[in] buffer    the buffer to broadcast from or receive into.
+   * @param[in] length    the length in bytes of the buffer.
+   * @param[in] parent    the rank to receive from, ignored if `isRoot`.
+   * @param[in] isRoot    whether the local rank is the root and thus does not receive.
+   * @param[in] children  the ranks to forward to.
+   */
+  void forward(void* buffer,
+               size_t length,
+               size_t parent,
+               bool isRoot,
+               const std::vector<size_t>& children);
+
+ public:
+  CollectiveGroup()                                  = delete;
+  CollectiveGroup(const CollectiveGroup&)            = delete;
+  CollectiveGroup& operator=(CollectiveGroup const&) = delete;
+  CollectiveGroup(CollectiveGroup&& o)               = delete;
+  CollectiveGroup& operator=(CollectiveGroup&& o)    = delete;
+
+  /**
+   * @brief Constructor of `shared_ptr<ucxx::CollectiveGroup>`.
+   *
+   * The constructor for a `shared_ptr<ucxx::CollectiveGroup>` object, a group of ranks
+   * performing collective operations over the endpoints connecting them. The endpoint
+   * to the local rank, if given, is used to copy blocks of the local rank in operations
+   * where they are not transferred in place, otherwise an endpoint to the local worker is
+   * created, so that copies of CUDA blocks are also handled by UCX.
+   *
+   * @code{.cpp}
+   * // `endpoints[i]` is connected to the worker of rank `i`
+   * auto group = ucxx::createCollectiveGroup(worker, endpoints, rank, ucxx::Tag{0xc011}, {});
+   * group->broadcast(buffer.data(), buffer.size(), 0);
+   * @endcode
+   *
+   * @throws std::invalid_argument if `rank` is not smaller than the number of endpoints,
+   *                               if an endpoint of a remote rank is missing or if the
+   *                               chunk size or pairwise window are zero.
+   *
+   * @param[in] worker    the worker of the local rank.
+   * @param[in] endpoints the endpoints to each rank, indexed by rank, the endpoint to the
+   *                      local rank may be `nullptr`.
+   * @param[in] rank      the local rank.
+   * @param[in] tagBase   the tag base of all messages of the group, identical in all ranks.
+   * @param[in] config    the tuning parameters of the collective operations, identical in
+   *                      all ranks.
+   *
+   * @returns The `shared_ptr<ucxx::CollectiveGroup>` object.
+   */
+  friend std::shared_ptr<CollectiveGroup> createCollectiveGroup(
+    std::shared_ptr<Worker> worker,
+    std::vector<std::shared_ptr<Endpoint>> endpoints,
+    size_t rank,
+    Tag tagBase,
+    CollectiveConfig config);
+
+  /**
+   * @brief Get the local rank.
+   *
+   * @returns The local rank.
+   */
+  [[nodiscard]] size_t getRank() const;
+
+  /**
+   * @brief Get the number of ranks in the group.
+   *
+   * @returns The number of ranks.
+   */
+  [[nodiscard]] size_t getSize() const;
+
+  /**
+   * @brief Get the algorithm `broadcast()` uses for a length.
+   *
+   * Get the algorithm `broadcast()` uses when called with `CollectiveAlgorithm::Auto`,
+   * `BinomialTree` for messages up to `CollectiveConfig::smallMessageSize` bytes, which
+   * reaches all ranks in a logarithmic number of steps, `Chain` for larger ones, which
+   * pipelines chunks along all ranks such that each rank sends the message only once.
+   *
+   * @param[in] length  the length in bytes of the message broadcast.
+   *
+   * @returns The algorithm used.
+   */
+  [[nodiscard]] CollectiveAlgorithm getBroadcastAlgorithm(size_t length) const;
+
+  /**
+   * @brief Get the algorithm `allgather()` uses for a block length.
+   *
+   * Get the algorithm `allgather()` uses when called with `CollectiveAlgorithm::Auto`,
+   * `Direct` if the gathered message is up to `CollectiveConfig::smallMessageSize` bytes,
+   * which exchanges all blocks in a single step, `Ring` otherwise, which pipelines chunks
+   * around all ranks such that each rank only sends to the next one.
+   *
+   * @param[in] length  the length in bytes of the block of each rank.
+   *
+   * @returns The algorithm used.
+   */
+  [[nodiscard]] CollectiveAlgorithm getAllgatherAlgorithm(size_t length) const;
+
+  /**
+   * @brief Get the algorithm `allToAll()` uses for a block length.
+   *
+   * Get the algorithm `allToAll()` uses when called with `CollectiveAlgorithm::Auto`,
+   * `Direct` if the blocks sent by each rank total up to
+   * `CollectiveConfig::smallMessageSize` bytes, which exchanges all blocks in a single
+   * step, `PairwiseExchange` otherwise, which limits the ranks each rank exchanges with at
+   * once to `CollectiveConfig::pairwiseWindow`, avoiding congestion.
+   *
+   * @param[in] length  the length in bytes of each block.
+   *
+   * @returns The algorithm used.
+   */
+  [[nodiscard]] CollectiveAlgorithm getAllToAllAlgorithm(size_t length) const;
+
+  /**
+   * @brief Broadcast a message from a rank to all ranks.
+   *
+   * Broadcast `length` bytes of `buffer` of the `root` rank into `buffer` of all other
+   * ranks. Supports the `BinomialTree` and `Chain` algorithms.
+   *
+   * @throws std::invalid_argument if `root` is not a rank of the group or the algorithm is
+   *                               not supported.
+   * @throws ucxx::Error           if a transfer failed.
+   *
+   * @param[in,out] buffer    the buffer to broadcast from the root or receive into.
+   * @param[in]     length    the length in bytes of the message.
+   * @param[in]     root      the rank broadcasting the message.
+   * @param[in]     algorithm the algorithm to use.
+   */
+  void broadcast(void* buffer,
+                 size_t length,
+                 size_t root,
+                 CollectiveAlgorithm algorithm = CollectiveAlgorithm::Auto);
+
+  /**
+   * @brief Gather a block from all ranks into all ranks.
+   *
+   * Gather `length` bytes of `sendBuffer` of each rank `i` at offset `i * length` of
+   * `recvBuffer` of all ranks. If `sendBuffer` is the block of the local rank within
+   * `recvBuffer` the operation is performed in place. Supports the `Direct` and `Ring`
+   * algorithms.
+   *
+   * @throws std::invalid_argument if the algorithm is not supported.
+   * @throws ucxx::Error           if a transfer failed.
+   *
+   * @param[in]  sendBuffer  the block of the local rank.
+   * @param[out] recvBuffer  the buffer to gather blocks into, of `getSize() * length`
+   *                         bytes.
+   * @param[in]  length      the length in bytes of the block of each rank.
+   * @param[in]  algorithm   the algorithm to use.
+   */
+  void allgather(const void* sendBuffer,
+                 void* recvBuffer,
+                 size_t length,
+                 CollectiveAlgorithm algorithm = CollectiveAlgorithm::Auto);
+
+  /**
+   * @brief Exchange a distinct block between all pairs of ranks.
+   *
+   * Send the block at offset `j * length` of `sendBuffer` of each rank `i` to offset
+   * `i * length` of `recvBuffer` of rank `j`. Supports the `Direct` and `PairwiseExchange`
+   * algorithms.
+   *
+   * @throws std::invalid_argument if the algorithm is not supported.
+   * @throws ucxx::Error           if a transfer failed.
+   *
+   * @param[in]  sendBuffer  the blocks to send, of `getSize() * length` bytes.
+   * @param[out] recvBuffer  the buffer to receive blocks into, of `getSize() * length`
+   *                         bytes, must not overlap `sendBuffer`.
+   * @param[in]  length      the length in bytes of each block.
+   * @param[in]  algorithm   the algorithm to use.
+   */
+  void allToAll(const void* sendBuffer,
+                void* recvBuffer,
+                size_t length,
+                CollectiveAlgorithm algorithm = CollectiveAlgorithm::Auto);
+};
+
+}  // namespace ucxx
@@ -0,0 +1,186 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ucxx/utils/mpsc_queue.h>
+
+namespace ucxx {
+
+/**
+ * @brief A request completion callback deferred for execution.
+ *
+ * A deferred invocation of a user-defined `ucxx::Request` completion callback, already
+ * bound to the request status and the user-defined callback data.
+ */
+typedef std::function<void()> CompletionCallback;
+
+/**
+ * @brief A user-defined executor of request completion callbacks.
+ *
+ * A user-defined function receiving a batch of deferred completion callbacks, which must
+ * arrange for each of them to be executed, for example by submitting them to an
+ * application thread pool or event loop. The executor is called from the thread that
+ * dispatches the batch, usually the worker progress thread, and should return quickly.
+ */
+typedef std::function<void(std::vector<CompletionCallback>)> CompletionCallbackExecutor;
+
+/**
+ * @brief Execute request completion callbacks off the progress thread.
+ *
+ * Collects the user-defined completion callbacks of `ucxx::Request` objects as they
+ * complete, and dispatches them in batches either to a user-defined executor or to
+ * internal threads, so that the thread completing requests, usually the worker progress
+ * thread, only enqueues them instead of executing them. Enqueuing is lock-free, pending
+ * callbacks are dispatched with `flush()`, which the worker calls after each progress.
+ *
+ * Internal threads each own a queue of batches, batches are distributed among queues in
+ * turn and idle threads steal batches from the queues of other threads, balancing the load
+ * without contending on a single queue. A single executor may be shared by multiple
+ * workers, see `ucxx::Worker::setCompletionExecutor()`, so that completion processing
+ * scales independently of the number of workers.
+ *
+ * When executed by multiple internal threads, or by a user-defined executor that runs
+ * callbacks concurrently, completion callbacks may execute in a different order than
+ * requests completed.
+ */
+class CompletionExecutor {
+ private:
+  /**
+   * @brief The queue of batches owned by an internal thread.
+   */
+  struct WorkQueue {
+    std::mutex mutex{};                                     ///< Mutex to access the batches
+    std::deque<std::vector<CompletionCallback>> batches{};  ///< Batches awaiting execution
+  };
+
+  utils::MPSCQueue<CompletionCallback> _pending{};    ///< Callbacks awaiting dispatch
+  std::mutex _flushMutex{};                           ///< Mutex serializing dispatches
+  size_t _batchSize{0};                               ///< Maximum callbacks per batch
+  CompletionCallbackExecutor _executor{nullptr};      ///< User-defined executor, if any
+  std::vector<std::thread> _threads{};                ///< Internal threads, if any
+  std::vector<std::unique_ptr<WorkQueue>> _queues{};  ///< Queues of internal threads
+  size_t _nextQueue{0};                               ///< The queue to dispatch the next batch to
+  std::atomic<size_t> _queuedBatches{0};              ///< Batches queued, not yet taken by a thread
+  std::atomic<uint64_t> _stolenBatches{0};            ///< Batches taken from another queue
+  std::mutex _sleepMutex{};                           ///< Mutex to wait for batches with
+  std::condition_variable _sleepCondition{};          ///< Signals new batches or stop
+  bool _stop{false};                                  ///< Stop once all batches execute
+
+  /**
+   * @brief Hand a batch of completion callbacks over for execution.
+   *
+   * @param[in] batch the completion callbacks to execute.
+   */
+  void dispatch(std::vector<CompletionCallback> batch);
+
+  /**
+   * @brief Take a batch for an internal thread to execute.
+   *
+   * Take the oldest batch from the thread's own queue or, if empty, steal the newest batch
+   * from the queue of another thread.
+   *
+   * @param[in]  index  the index of the thread taking a batch.
+   * @param[out] batch  the batch taken.
+   *
+   * @returns `true` if a batch was taken, `false` if all queues are empty.
+   */
+  bool take(size_t index, std::vector<CompletionCallback>& batch);
+
+  /**
+   * @brief The function executed by internal threads.
+   *
+   * Executes batches of completion callbacks as they are dispatched, until signaled to
+   * stop and no batches are left.
+   *
+   * @param[in] index the index of the thread, identifying the queue it owns.
+   */
+  void run(size_t index);
+
+ public:
+  CompletionExecutor() = delete;
+
+  CompletionExecutor(const CompletionExecutor&)            = delete;
+  CompletionExecutor& operator=(CompletionExecutor const&) = delete;
+  CompletionExecutor(CompletionExecutor&& o)               = delete;
+  CompletionExecutor& operator=(CompletionExecutor&& o)    = delete;
+
+  /**
+   * @brief Constructor of a completion executor dispatching to a user-defined executor.
+   *
+   * @throws std::invalid_argument if `executor` is empty or `batchSize` is `0`.
+   *
+   * @param[in] executor  user-defined executor of the batches of completion callbacks.
+   * @param[in] batchSize maximum number of completion callbacks per batch.
+   */
+  CompletionExecutor(CompletionCallbackExecutor executor, size_t batchSize);
+
+  /**
+   * @brief Constructor of a completion executor dispatching to internal threads.
+   *
+   * @throws std::invalid_argument if `numThreads` or `batchSize` is `0`.
+   *
+   * @param[in] numThreads  number of internal threads executing completion callbacks.
+   * @param[in] batchSize   maximum number of completion callbacks per batch, batches are
+   *                        distributed among internal threads, smaller batches can be
+   *                        balanced more evenly.
+   */
+  CompletionExecutor(size_t numThreads, size_t batchSize);
+
+  /**
+   * @brief `ucxx::CompletionExecutor` destructor.
+   *
+   * Dispatches all pending completion callbacks and, if using internal threads, waits for
+   * all of them to execute before joining the threads.
+   */
+  ~CompletionExecutor();
+
+  /**
+   * @brief Enqueue a completion callback.
+   *
+   * Enqueue a completion callback to be dispatched by the next call to `flush()`. This
+   * method is lock-free and may be called from any thread.
+   *
+   * @param[in] callback  the completion callback.
+   */
+  void enqueue(CompletionCallback callback);
+
+  /**
+   * @brief Dispatch all pending completion callbacks.
+   *
+   * Dispatch all completion callbacks enqueued since the last call, in batches of at most
+   * `batchSize` callbacks.
+   *
+   * @returns The number of completion callbacks dispatched.
+   */
+  size_t flush();
+
+  /**
+   * @brief Get the number of internal threads.
+   *
+   * @returns The number of internal threads, `0` if dispatching to a user-defined executor.
+   */
+  size_t getNumThreads() const;
+
+  /**
+   * @brief Get the number of batches stolen.
+   *
+   * @returns The number of batches executed by an internal thread other than the one they
+   *          were dispatched to.
+   */
+  uint64_t getStolenBatches() const;
+};
+
+}  // namespace ucxx
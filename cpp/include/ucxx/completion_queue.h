@@ -0,0 +1,330 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/future.h>
+#include <ucxx/notifier.h>
+
+namespace ucxx {
+
+class CompletionQueue;
+
+/**
+ * @brief A completed future harvested from a `ucxx::CompletionQueue`.
+ */
+struct Completion {
+  std::shared_ptr<Future> future{nullptr};  ///< The completed future, whose handle equals
+                                            ///< `ucxx::Request::getFuture()` of its request
+  ucs_status_t status{UCS_OK};              ///< The completion status of the request
+};
+
+/**
+ * @brief A native C++ future notified through a `ucxx::CompletionQueue`.
+ *
+ * A future of a `ucxx::Request` that does not depend on Python, created by workers with
+ * future support enabled unless a specialized worker implementation, such as the Python
+ * one, provides its own futures. The future may be waited on directly, similar to
+ * `std::future`, or harvested in batches with other futures from the completion queue of
+ * the worker, see `ucxx::CompletionQueue`.
+ *
+ * The handle returned by `getHandle()`, and thus by `ucxx::Request::getFuture()`, is a
+ * pointer to the `ucxx::CompletionFuture` object itself, valid while the request or a
+ * harvested `ucxx::Completion` references the future.
+ */
+class CompletionFuture : public Future {
+ private:
+  std::atomic<ucs_status_t> _status{UCS_INPROGRESS};  ///< The completion status
+  std::mutex _mutex{};                                ///< Mutex to wait for completion
+  std::condition_variable _conditionVariable{};       ///< Signals completion to waiters
+
+  /**
+   * @brief Private constructor of `ucxx::CompletionFuture`.
+   *
+   * This is the internal implementation of `ucxx::CompletionFuture` constructor, made
+   * private not to be called directly. Instead the user should call
+   * `ucxx::createCompletionFuture()`.
+   *
+   * @param[in] completionQueue the completion queue to notify upon completion.
+   */
+  explicit CompletionFuture(std::shared_ptr<CompletionQueue> completionQueue);
+
+ public:
+  CompletionFuture()                                   = delete;
+  CompletionFuture(const CompletionFuture&)            = delete;
+  CompletionFuture& operator=(CompletionFuture const&) = delete;
+  CompletionFuture(CompletionFuture&& o)               = delete;
+  CompletionFuture& operator=(CompletionFuture&& o)    = delete;
+
+  /**
+   * @brief Constructor of `shared_ptr<ucxx::CompletionFuture>`.
+   *
+   * The constructor for a `shared_ptr<ucxx::CompletionFuture>` object, usually called by
+   * `ucxx::Worker::getFuture()`.
+   *
+   * @param[in] completionQueue the completion queue to notify upon completion.
+   *
+   * @returns The `shared_ptr<ucxx::CompletionFuture>` object.
+   */
+  friend std::shared_ptr<CompletionFuture> createCompletionFuture(
+    std::shared_ptr<CompletionQueue> completionQueue);
+
+  /**
+   * @brief Inform the completion queue that the future has completed.
+   *
+   * Set the future status and enqueue it in the completion queue, called by
+   * `ucxx::Request` upon completion.
+   *
+   * @param[in] status  request completion status.
+   */
+  void notify(ucs_status_t status) override;
+
+  /**
+   * @brief Set the future completion status.
+   *
+   * Set the future status as completed and wake all threads waiting on it, without
+   * enqueuing it in the completion queue.
+   *
+   * @param[in] status  request completion status.
+   */
+  void set(ucs_status_t status) override;
+
+  /**
+   * @brief Get the handle of the future.
+   *
+   * @returns A pointer to this object.
+   */
+  void* getHandle() override;
+
+  /**
+   * @brief Get the handle of the future.
+   *
+   * Native futures are owned by their `std::shared_ptr`, thus ownership cannot be
+   * released and this is equivalent to `getHandle()`.
+   *
+   * @returns A pointer to this object.
+   */
+  void* release() override;
+
+  /**
+   * @brief Check whether the future has completed.
+   *
+   * @returns `true` if the future has completed, `false` otherwise.
+   */
+  bool isReady() const;
+
+  /**
+   * @brief Get the completion status.
+   *
+   * @returns The completion status, `UCS_INPROGRESS` if the future has not completed yet.
+   */
+  ucs_status_t getStatus() const;
+
+  /**
+   * @brief Block until the future completes.
+   *
+   * @returns The completion status.
+   */
+  ucs_status_t wait();
+
+  /**
+   * @brief Block until the future completes or a timeout elapses.
+   *
+   * @param[in] timeout the maximum time to wait.
+   *
+   * @returns `true` if the future completed, `false` if the timeout elapsed first.
+   */
+  bool waitFor(std::chrono::nanoseconds timeout);
+};
+
+/**
+ * @brief A queue of completed native C++ futures.
+ *
+ * A native C++ notifier collecting the `ucxx::CompletionFuture` objects of requests as
+ * they complete, similar to a completion queue in verbs. An application thread may
+ * harvest completions in batches, either without blocking with `poll()` or blocking until
+ * at least one completion is available with `waitFor()`, thus handling thousands of
+ * completions per wakeup instead of one wakeup per request. Futures are completed when
+ * enqueued, there is no need to run `runRequestNotifier()` before harvesting them.
+ *
+ * A worker created with future support enabled creates a completion queue, see
+ * `ucxx::Worker::getCompletionQueue()`. Harvesting is opt-in, so that applications only
+ * waiting on individual futures do not accumulate completions nobody harvests: only once
+ * enabled with `setHarvestEnabled()` are futures of requests created with
+ * `enablePythonFuture` set enqueued in it upon completion.
+ *
+ * @code{.cpp}
+ * // `worker` is `std::shared_ptr<ucxx::Worker>` created with `enableFuture=true`
+ * auto completionQueue = worker->getCompletionQueue();
+ * completionQueue->setHarvestEnabled(true);
+ *
+ * std::vector<ucxx::Completion> completions;
+ * while (completionQueue->waitFor(completions, std::chrono::milliseconds(100)) > 0) {
+ *   for (auto& completion : completions)
+ *     handleCompletion(completion.future->getHandle(), completion.status);
+ *   completions.clear();
+ * }
+ * @endcode
+ */
+class CompletionQueue : public Notifier {
+ private:
+  mutable std::mutex _mutex{};                   ///< Mutex to access the completions
+  std::condition_variable _conditionVariable{};  ///< Signals new completions or stop
+  std::deque<Completion> _completions{};         ///< Completions awaiting to be harvested
+  bool _futuresPoolRefillRequested{false};       ///< Whether the waiter was woken to refill
+  std::atomic<bool> _harvestEnabled{false};      ///< Whether completions are enqueued
+  RequestNotifierThreadState _state{
+    RequestNotifierThreadState::NotRunning};  ///< Whether waiters should stop
+
+  /**
+   * @brief Private constructor of `ucxx::CompletionQueue`.
+   *
+   * This is the internal implementation of `ucxx::CompletionQueue` constructor, made
+   * private not to be called directly. Instead the user should call
+   * `ucxx::createCompletionQueue()`.
+   */
+  CompletionQueue() = default;
+
+  /**
+   * @brief Move up to `maxCompletions` completions to `completions`.
+   *
+   * Must be called with `_mutex` held.
+   *
+   * @param[out] completions    the container to append completions to.
+   * @param[in]  maxCompletions maximum number of completions to harvest.
+   *
+   * @returns The number of completions harvested.
+   */
+  size_t harvest(std::vector<Completion>& completions, size_t maxCompletions);
+
+ public:
+  CompletionQueue(const CompletionQueue&)            = delete;
+  CompletionQueue& operator=(CompletionQueue const&) = delete;
+  CompletionQueue(CompletionQueue&& o)               = delete;
+  CompletionQueue& operator=(CompletionQueue&& o)    = delete;
+
+  /**
+   * @brief Constructor of `shared_ptr<ucxx::CompletionQueue>`.
+   *
+   * The constructor for a `shared_ptr<ucxx::CompletionQueue>` object, usually called by
+   * `ucxx::Worker` when created with future support enabled.
+   *
+   * @returns The `shared_ptr<ucxx::CompletionQueue>` object.
+   */
+  friend std::shared_ptr<CompletionQueue> createCompletionQueue();
+
+  /**
+   * @brief Enable or disable harvesting completions.
+   *
+   * Enable or disable enqueuing completed futures to be harvested with `poll()` or
+   * `waitFor()`, disabled by default. Futures are completed regardless and can always be
+   * waited on individually, completions enqueued before disabling remain pending.
+   *
+   * @param[in] enabled whether completed futures should be enqueued.
+   */
+  void setHarvestEnabled(bool enabled);
+
+  /**
+   * @brief Inquire if harvesting completions is enabled.
+   *
+   * @returns `true` if completed futures are enqueued to be harvested, `false` otherwise.
+   */
+  bool isHarvestEnabled() const;
+
+  /**
+   * @brief Complete a future and enqueue it.
+   *
+   * Set the status of the future and, if harvesting is enabled, enqueue it to be harvested,
+   * waking a thread blocked in `waitFor()` or `waitRequestNotifier()`, if any.
+   *
+   * @param[in] future  future to complete.
+   * @param[in] status  the request completion status.
+   */
+  void scheduleFutureNotify(std::shared_ptr<Future> future, ucs_status_t status) override;
+
+  /**
+   * @brief Wait for completions with a timeout in nanoseconds.
+   *
+   * Block until completions are available, the queue is stopped or, if `period > 0`, the
+   * period elapses, without harvesting completions.
+   *
+   * @param[in] period the time in nanoseconds to wait, `0` waits indefinitely.
+   *
+   * @returns `RequestNotifierWaitState::Ready` if completions are available,
+   *          `RequestNotifierWaitState::Timeout` if the period elapsed, or
+   *          `RequestNotifierWaitState::Shutdown` if the queue was stopped.
+   */
+  RequestNotifierWaitState waitRequestNotifier(uint64_t period) override;
+
+  /**
+   * @brief No-op, futures are completed when enqueued.
+   */
+  void runRequestNotifier() override;
+
+  /**
+   * @brief Wake a thread blocked in `waitRequestNotifier()`.
+   */
+  void requestFuturesPoolRefill() override;
+
+  /**
+   * @brief Stop the completion queue.
+   *
+   * Wake all threads blocked in `waitFor()` or `waitRequestNotifier()`, which return
+   * immediately afterwards. The next call to `waitRequestNotifier()` returns
+   * `RequestNotifierWaitState::Shutdown` once and restarts the queue.
+   */
+  void stopRequestNotifierThread() override;
+
+  /**
+   * @brief Harvest completions without blocking.
+   *
+   * Move up to `maxCompletions` pending completions to `completions`, in the order the
+   * requests completed.
+   *
+   * @param[out] completions    the container to append completions to.
+   * @param[in]  maxCompletions maximum number of completions to harvest.
+   *
+   * @returns The number of completions harvested.
+   */
+  size_t poll(std::vector<Completion>& completions,
+              size_t maxCompletions = std::numeric_limits<size_t>::max());
+
+  /**
+   * @brief Harvest completions, blocking until at least one is available.
+   *
+   * Block until at least one completion is available, the timeout elapses or the queue is
+   * stopped, then move up to `maxCompletions` pending completions to `completions`.
+   *
+   * @param[out] completions    the container to append completions to.
+   * @param[in]  timeout        the maximum time to wait.
+   * @param[in]  maxCompletions maximum number of completions to harvest.
+   *
+   * @returns The number of completions harvested, `0` if the timeout elapsed or the queue
+   *          was stopped first.
+   */
+  size_t waitFor(std::vector<Completion>& completions,
+                 std::chrono::nanoseconds timeout,
+                 size_t maxCompletions = std::numeric_limits<size_t>::max());
+
+  /**
+   * @brief Get the number of completions pending to be harvested.
+   *
+   * @returns The number of pending completions.
+   */
+  size_t size() const;
+};
+
+}  // namespace ucxx
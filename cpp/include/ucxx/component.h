@@ -8,6 +8,9 @@
 
 namespace ucxx {
 
+class Endpoint;
+class Worker;
+
 /**
  * @brief A UCXX component class to prevent early destruction of parent object.
  *
@@ -38,6 +41,28 @@ class Component : public std::enable_shared_from_this<Component> {
    * @returns the reference-counted pointer to the parent.
    */
   std::shared_ptr<Component> getParent() const;
+
+  /**
+   * @brief Get the component as a `ucxx::Endpoint`.
+   *
+   * Get a non-owning pointer to the component if it is a `ucxx::Endpoint`, allowing
+   * per-operation paths to resolve the component type without RTTI.
+   *
+   * @returns The non-owning pointer to the `ucxx::Endpoint`, or `nullptr` if the component
+   *          is not an endpoint.
+   */
+  virtual Endpoint* asEndpoint() noexcept;
+
+  /**
+   * @brief Get the component as a `ucxx::Worker`.
+   *
+   * Get a non-owning pointer to the component if it is a `ucxx::Worker`, allowing
+   * per-operation paths to resolve the component type without RTTI.
+   *
+   * @returns The non-owning pointer to the `ucxx::Worker`, or `nullptr` if the component
+   *          is not a worker.
+   */
+  virtual Worker* asWorker() noexcept;
 };
 
 }  // namespace ucxx
@@ -4,6 +4,8 @@
  */
 #pragma once
 
+#include <memory>
+
 #include <ucp/api/ucp.h>
 
 #include <ucxx/typedefs.h>
@@ -15,17 +17,24 @@ namespace ucxx {
  *
  * The UCP layer provides a handle to its configuration in form of `ucp_config_t*` object,
  * this class encapsulates that object and provides methods to simplify its handling.
+ *
+ * Reading and parsing the UCP configuration is comparatively expensive, thus results are
+ * cached process-wide and shared by all `ucxx::Config` objects constructed with the same
+ * user options while the `UCX_*` environment variables remain unchanged. Changes to UCX
+ * configuration files are not detected, `clearCache()` may be called to read them again.
  */
 class Config {
  private:
-  ucp_config_t* _handle{nullptr};  ///< Handle to the UCP config
-  ConfigMap _configMap;            ///< Map containing all visible UCP configurations
+  struct Cached;                    ///< A UCP configuration shared by `ucxx::Config` objects
+  std::shared_ptr<Cached> _cached{};  ///< The shared UCP configuration
+  ucp_config_t* _handle{nullptr};     ///< Handle to the UCP config
 
   /**
    * @brief Read UCX configuration and apply user options.
    *
    * Read UCX configuration defaults and environment variable modifiers and apply user
-   * configurations overriding previously set configurations.
+   * configurations overriding previously set configurations, or reuse a previously read
+   * configuration with the same user options and environment variables.
    *
    * @param[in] userOptions user-defined options overriding defaults and environment
    *                        variable modifiers.
@@ -38,11 +47,12 @@ class Config {
    * @brief Parse UCP configurations and convert them to a map.
    *
    * Parse UCP configurations obtained from `ucp_config_print()` and convert them to a map
-   * for easy access.
+   * for easy access. Configurations are parsed only once and shared with other
+   * `ucxx::Config` objects using the same UCP configuration.
    *
    * @returns The map to the UCP configurations defined for the process.
    */
-  ConfigMap ucxConfigToMap();
+  const ConfigMap& ucxConfigToMap();
 
  public:
   Config()                         = delete;
@@ -72,7 +82,17 @@ class Config {
    *
    * @returns The map to the UCP configurations defined for the process.
    */
-  ConfigMap get();
+  const ConfigMap& get();
+
+  /**
+   * @brief Clear the process-wide configuration cache.
+   *
+   * Clear the process-wide cache of UCP configurations, causing the configuration to be
+   * read and parsed again by `ucxx::Config` objects constructed afterwards, for example
+   * after UCX configuration files have changed. Existing `ucxx::Config` objects are not
+   * affected.
+   */
+  static void clearCache();
 
   /**
    * @brief Get the underlying `ucp_config_t*` handle
@@ -80,7 +100,8 @@ class Config {
    * Lifetime of the `ucp_config_t*` handle is managed by the `ucxx::Config` object and
    * its ownership is non-transferrable. Once the `ucxx::Config` is destroyed the handle
    * is not valid anymore, it is the user's responsibility to ensure the owner's lifetime
-   * while using the handle.
+   * while using the handle. The handle may be shared with other `ucxx::Config` objects,
+   * thus it must not be modified, e.g., with `ucp_config_modify()`.
    *
    * @code{.cpp}
    * // config is `ucxx::Config`
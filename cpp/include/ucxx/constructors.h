@@ -6,6 +6,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <ucxx/component.h>
 #include <ucxx/request_data.h>
@@ -14,24 +16,43 @@
 namespace ucxx {
 
 class Address;
+class CollectiveGroup;
+class CompletionFuture;
+class CompletionQueue;
 class Context;
 class Endpoint;
 class Future;
 class Listener;
+class MemoryHandle;
 class Notifier;
+class RemoteKey;
 class Request;
 class RequestAm;
+class RequestEndpointClose;
+class RequestFile;
+class RequestFlush;
+class RequestMem;
 class RequestStream;
 class RequestTag;
 class RequestTagMulti;
+class StreamData;
+class TagRecvRing;
 class Worker;
+class WorkerPool;
 
 // Components
 std::shared_ptr<Address> createAddressFromWorker(std::shared_ptr<Worker> worker);
 
 std::shared_ptr<Address> createAddressFromString(std::string addressString);
 
-std::shared_ptr<Context> createContext(const ConfigMap ucxConfig, const uint64_t featureFlags);
+std::shared_ptr<CompletionFuture> createCompletionFuture(
+  std::shared_ptr<CompletionQueue> completionQueue);
+
+std::shared_ptr<CompletionQueue> createCompletionQueue();
+
+std::shared_ptr<Context> createContext(const ConfigMap ucxConfig,
+                                       const uint64_t featureFlags,
+                                       const bool enableMtWorkersShared = false);
 
 std::shared_ptr<Endpoint> createEndpointFromHostname(std::shared_ptr<Worker> worker,
                                                      std::string ipAddress,
@@ -46,14 +67,70 @@ std::shared_ptr<Endpoint> createEndpointFromWorkerAddress(std::shared_ptr<Worker
                                                           std::shared_ptr<Address> address,
                                                           bool endpointErrorHandling);
 
+std::vector<std::shared_ptr<Endpoint>> createEndpointsFromConnRequests(
+  std::shared_ptr<Listener> listener,
+  const std::vector<ucp_conn_request_h>& connRequests,
+  bool endpointErrorHandling);
+
+std::vector<std::shared_ptr<Endpoint>> createEndpointsFromHostnames(
+  std::shared_ptr<Worker> worker,
+  const std::vector<std::pair<std::string, uint16_t>>& hosts,
+  bool endpointErrorHandling);
+
+std::vector<std::shared_ptr<Endpoint>> createEndpointsFromWorkerAddresses(
+  std::shared_ptr<Worker> worker,
+  const std::vector<std::shared_ptr<Address>>& addresses,
+  bool endpointErrorHandling);
+
 std::shared_ptr<Listener> createListener(std::shared_ptr<Worker> worker,
                                          uint16_t port,
                                          ucp_listener_conn_callback_t callback,
                                          void* callbackArgs);
 
+std::shared_ptr<Listener> createListener(std::shared_ptr<Worker> worker,
+                                         uint16_t port,
+                                         size_t backlog);
+
+std::shared_ptr<MemoryHandle> createMemoryHandle(std::shared_ptr<Context> context,
+                                                 const size_t size,
+                                                 void* buffer,
+                                                 const ucs_memory_type_t memoryType);
+
+std::shared_ptr<RemoteKey> createRemoteKeyFromMemoryHandle(
+  std::shared_ptr<MemoryHandle> memoryHandle);
+
+std::shared_ptr<RemoteKey> createRemoteKeyFromSerialized(std::shared_ptr<Endpoint> endpoint,
+                                                         const std::string& serializedRemoteKey);
+
+std::shared_ptr<StreamData> createStreamData(std::shared_ptr<Endpoint> endpoint,
+                                             void* data,
+                                             size_t length);
+
+std::shared_ptr<CollectiveGroup> createCollectiveGroup(
+  std::shared_ptr<Worker> worker,
+  std::vector<std::shared_ptr<Endpoint>> endpoints,
+  size_t rank,
+  Tag tagBase,
+  CollectiveConfig config);
+
+std::shared_ptr<TagRecvRing> createTagRecvRing(std::shared_ptr<Worker> worker,
+                                               size_t numBuffers,
+                                               size_t bufferSize,
+                                               Tag tag,
+                                               TagMask tagMask,
+                                               TagRecvRingCallback callback);
+
+std::shared_ptr<WorkerPool> createWorkerPool(std::shared_ptr<Context> context,
+                                             size_t numWorkers,
+                                             WorkerPoolPlacement placement,
+                                             const bool enableDelayedSubmission,
+                                             const bool enableFuture,
+                                             WorkerPoolFactory factory);
+
 std::shared_ptr<Worker> createWorker(std::shared_ptr<Context> context,
                                      const bool enableDelayedSubmission,
-                                     const bool enableFuture);
+                                     const bool enableFuture,
+                                     const bool enableSerializedThreadMode = false);
 
 // Transfers
 std::shared_ptr<RequestAm> createRequestAm(
@@ -63,6 +140,26 @@ std::shared_ptr<RequestAm> createRequestAm(
   RequestCallbackUserFunction callbackFunction,
   RequestCallbackUserData callbackData);
 
+std::shared_ptr<RequestEndpointClose> createRequestEndpointClose(
+  std::shared_ptr<Endpoint> endpoint,
+  const data::EndpointClose requestData,
+  const bool enablePythonFuture,
+  RequestCallbackUserFunction callbackFunction,
+  RequestCallbackUserData callbackData);
+
+std::shared_ptr<RequestFlush> createRequestFlush(std::shared_ptr<Component> endpointOrWorker,
+                                                 const data::Flush requestData,
+                                                 const bool enablePythonFuture,
+                                                 RequestCallbackUserFunction callbackFunction,
+                                                 RequestCallbackUserData callbackData);
+
+std::shared_ptr<RequestMem> createRequestMem(
+  std::shared_ptr<Endpoint> endpoint,
+  const std::variant<data::MemPut, data::MemGet, data::MemAtomic> requestData,
+  const bool enablePythonFuture,
+  RequestCallbackUserFunction callbackFunction,
+  RequestCallbackUserData callbackData);
+
 std::shared_ptr<RequestStream> createRequestStream(
   std::shared_ptr<Endpoint> endpoint,
   const std::variant<data::StreamSend, data::StreamReceive> requestData,
@@ -75,9 +172,21 @@ std::shared_ptr<RequestTag> createRequestTag(
   RequestCallbackUserFunction callbackFunction,
   RequestCallbackUserData callbackData);
 
+std::vector<std::shared_ptr<RequestTag>> createRequestTagBatch(
+  std::shared_ptr<Endpoint> endpoint,
+  const std::vector<std::variant<data::TagSend, data::TagReceive>>& requestData,
+  const bool enablePythonFuture,
+  RequestCallbackUserFunction callbackFunction,
+  RequestCallbackUserData callbackData);
+
 std::shared_ptr<RequestTagMulti> createRequestTagMulti(
   std::shared_ptr<Endpoint> endpoint,
   const std::variant<data::TagMultiSend, data::TagMultiReceive> requestData,
   const bool enablePythonFuture);
 
+std::shared_ptr<RequestFile> createRequestFile(
+  std::shared_ptr<Endpoint> endpoint,
+  const std::variant<data::FileSend, data::FileReceive> requestData,
+  const bool enablePythonFuture);
+
 }  // namespace ucxx
@@ -7,7 +7,9 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <ucp/api/ucp.h>
 
@@ -17,6 +19,8 @@
 
 namespace ucxx {
 
+class Address;
+class MemoryHandle;
 class Worker;
 
 /**
@@ -31,6 +35,11 @@ class Context : public Component {
   Config _config{{}};              ///< UCP context configuration variables
   uint64_t _featureFlags{0};       ///< Feature flags used to construct UCP context
   bool _cudaSupport{false};        ///< Whether CUDA support is enabled
+  bool _mtWorkersShared{false};    ///< Whether workers may be progressed concurrently
+  std::mutex _addressCacheMutex{};  ///< Mutex to access the address cache
+  std::unordered_map<std::string, std::weak_ptr<Address>>
+    _addressCache{};  ///< Interned addresses of remote workers, keyed by their contents
+  size_t _addressCachePruneSize{64};  ///< Cache size at which to prune expired entries
 
   /**
    * @brief Private constructor of `shared_ptr<ucxx::Context>`.
@@ -41,13 +50,18 @@ class Context : public Component {
    * @param[in] ucxConfig configurations overriding `UCX_*` defaults and environment
    *                      variables.
    * @param[in] featureFlags feature flags to be used at UCP context construction time.
+   * @param[in] enableMtWorkersShared if `true`, initializes the UCP context with
+   *                                  `mt_workers_shared`, see
+   *                                  `isMtWorkersSharedEnabled()`.
    */
-  Context(const ConfigMap ucxConfig, const uint64_t featureFlags);
+  Context(const ConfigMap ucxConfig,
+          const uint64_t featureFlags,
+          const bool enableMtWorkersShared = false);
 
  public:
   static constexpr uint64_t defaultFeatureFlags =
-    UCP_FEATURE_TAG | UCP_FEATURE_WAKEUP | UCP_FEATURE_STREAM | UCP_FEATURE_AM |
-    UCP_FEATURE_RMA;  ///< Suggested default context feature flags to use.
+    UCP_FEATURE_TAG | UCP_FEATURE_WAKEUP | UCP_FEATURE_STREAM | UCP_FEATURE_AM | UCP_FEATURE_RMA |
+    UCP_FEATURE_AMO64;  ///< Suggested default context feature flags to use.
 
   Context()                          = delete;
   Context(const Context&)            = delete;
@@ -69,9 +83,15 @@ class Context : public Component {
    * @param[in] ucxConfig configurations overriding `UCX_*` defaults and environment
    *                      variables.
    * @param[in] featureFlags feature flags to be used at UCP context construction time.
+   * @param[in] enableMtWorkersShared if `true`, initializes the UCP context with
+   *                                  `mt_workers_shared`, required if multiple workers
+   *                                  created from the context are progressed
+   *                                  concurrently by different threads.
    * @return The `shared_ptr<ucxx::Context>` object
    */
-  friend std::shared_ptr<Context> createContext(ConfigMap ucxConfig, const uint64_t featureFlags);
+  friend std::shared_ptr<Context> createContext(ConfigMap ucxConfig,
+                                                const uint64_t featureFlags,
+                                                const bool enableMtWorkersShared);
 
   /**
    * @brief `ucxx::Context` destructor
@@ -158,6 +178,18 @@ class Context : public Component {
    */
   bool hasCudaSupport() const;
 
+  /**
+   * @brief Inquire if workers of the context may be progressed concurrently.
+   *
+   * Check whether the UCP context was initialized with `mt_workers_shared`, which UCX
+   * requires for multiple workers created from the same context to be progressed
+   * concurrently by different threads, e.g., each by its own progress thread. Disabled by
+   * default, as it adds locking to resources shared by all workers of the context.
+   *
+   * @return Whether the UCP context was initialized with `mt_workers_shared`.
+   */
+  bool isMtWorkersSharedEnabled() const;
+
   /**
    * @brief Create a new `ucxx::Worker`.
    *
@@ -174,10 +206,95 @@ class Context : public Component {
    *                                    transfer requests to the worker thread.
    * @param[in] enableFuture if `true`, notifies the future associated with each
    *                         `ucxx::Request`, currently used only by `ucxx::python::Worker`.
+   * @param[in] enableSerializedThreadMode  if `true`, the worker only accesses the UCP
+   *                                        worker from one thread at a time, sparing UCX
+   *                                        from locking it, see
+   *                                        `ucxx::Worker::isSerializedThreadModeEnabled()`.
+   *                                        Requires `enableDelayedSubmission`.
    * @return Shared pointer to the `ucxx::Worker` object.
    */
-  std::shared_ptr<Worker> createWorker(const bool enableDelayedSubmission = false,
-                                       const bool enableFuture            = false);
+  std::shared_ptr<Worker> createWorker(const bool enableDelayedSubmission    = false,
+                                       const bool enableFuture               = false,
+                                       const bool enableSerializedThreadMode = false);
+
+  /**
+   * @brief Create a new `ucxx::WorkerPool`.
+   *
+   * Create a new `ucxx::WorkerPool` of `numWorkers` workers that are children of the
+   * current `ucxx::Context`, see `ucxx::WorkerPool`.
+   *
+   * @code{.cpp}
+   *   // context is `std::shared_ptr<ucxx::Context>`
+   *   auto pool = context->createWorkerPool(4, ucxx::WorkerPoolPlacement::LeastLoaded);
+   * @endcode
+   *
+   * @throws std::invalid_argument if `numWorkers` is `0`.
+   *
+   * @param[in] numWorkers              the number of workers in the pool.
+   * @param[in] placement               the policy to place endpoints and listeners.
+   * @param[in] enableDelayedSubmission whether workers delay transfer requests to their
+   *                                    progress threads.
+   * @param[in] enableFuture            whether workers notify futures of requests.
+   * @param[in] factory                 function to create each worker, or `nullptr` to
+   *                                    create `ucxx::Worker` objects.
+   * @return Shared pointer to the `ucxx::WorkerPool` object.
+   */
+  std::shared_ptr<WorkerPool> createWorkerPool(
+    size_t numWorkers,
+    WorkerPoolPlacement placement      = WorkerPoolPlacement::RoundRobin,
+    const bool enableDelayedSubmission = false,
+    const bool enableFuture            = false,
+    WorkerPoolFactory factory          = nullptr);
+
+  /**
+   * @brief Register memory with the context.
+   *
+   * Register `size` bytes of memory at `buffer` with the current `ucxx::Context`, or let
+   * UCX allocate and register it if `buffer` is `nullptr`, returning a `ucxx::MemoryHandle`
+   * that may be passed to transfer operations to skip the registration lookup. The
+   * `ucxx::Context` will not be destroyed until all `ucxx::MemoryHandle` objects are
+   * destroyed first.
+   *
+   * @code{.cpp}
+   *   // context is `std::shared_ptr<ucxx::Context>`
+   *   auto memoryHandle = context->createMemoryHandle(1 << 20);
+   * @endcode
+   *
+   * @throws ucxx::Error if the memory could not be registered.
+   *
+   * @param[in] size        the size of the memory in bytes.
+   * @param[in] buffer      the memory to register, or `nullptr` to let UCX allocate it.
+   * @param[in] memoryType  the memory type of the memory, or `UCS_MEMORY_TYPE_UNKNOWN` to
+   *                        let UCX detect it or, when allocating, use host memory.
+   * @return Shared pointer to the `ucxx::MemoryHandle` object.
+   */
+  std::shared_ptr<MemoryHandle> createMemoryHandle(
+    const size_t size,
+    void* buffer                       = nullptr,
+    const ucs_memory_type_t memoryType = UCS_MEMORY_TYPE_UNKNOWN);
+
+  /**
+   * @brief Get an interned address of a remote worker.
+   *
+   * Get the `ucxx::Address` of the remote worker serialized in `addressString`, as
+   * `ucxx::createAddressFromString()` would, but reusing the same `ucxx::Address` object
+   * while it is alive for all requests of the same address. This prevents applications
+   * that repeatedly receive addresses of the same workers, for example to reconnect, from
+   * allocating a copy of the address each time, and allows caching per-address state
+   * by the address object's identity. The context holds no ownership of the addresses,
+   * an address is removed from the cache once all references to it are released.
+   *
+   * @code{.cpp}
+   *   // context is `std::shared_ptr<ucxx::Context>`, addressString is the result of
+   *   // `getString()` of a remote worker's address received from the remote process
+   *   auto address = context->internAddress(addressString);
+   *   auto sameAddress = context->internAddress(addressString);  // address == sameAddress
+   * @endcode
+   *
+   * @param[in] addressString the byte-string containing the address of the remote worker.
+   * @return Shared pointer to the `ucxx::Address` object.
+   */
+  std::shared_ptr<Address> internAddress(const std::string& addressString);
 };
 
 }  // namespace ucxx
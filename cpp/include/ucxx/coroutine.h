@@ -0,0 +1,312 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#if !defined(__cpp_impl_coroutine)
+#error "<ucxx/coroutine.h> requires a compiler with C++20 coroutine support"
+#endif
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <ucxx/log.h>
+#include <ucxx/request.h>
+#include <ucxx/worker.h>
+
+namespace ucxx {
+
+namespace coro {
+
+class Scheduler;
+
+/**
+ * @brief An awaitable suspending a coroutine until requests complete.
+ *
+ * An awaitable created by `ucxx::coro::Scheduler::wait()`, suspending the awaiting
+ * coroutine until all of its requests complete. Awaiting does not suspend if all requests
+ * already completed. Resuming checks each request for errors, rethrowing the error of the
+ * first failed request in the awaiting coroutine.
+ */
+class RequestAwaitable {
+ private:
+  Scheduler& _scheduler;                            ///< The scheduler to resume from
+  std::vector<std::shared_ptr<Request>> _requests;  ///< The requests to await
+
+ public:
+  /**
+   * @brief Constructor of a request awaitable.
+   *
+   * @param[in] scheduler the scheduler resuming the awaiting coroutine.
+   * @param[in] requests  the requests to await.
+   */
+  RequestAwaitable(Scheduler& scheduler, std::vector<std::shared_ptr<Request>> requests)
+    : _scheduler(scheduler), _requests(std::move(requests))
+  {
+  }
+
+  /**
+   * @brief Check whether all requests already completed.
+   *
+   * @returns `true` if all requests completed, in which case the coroutine is not
+   *          suspended, `false` otherwise.
+   */
+  bool await_ready() const noexcept
+  {
+    for (const auto& request : _requests)
+      if (!request->isCompleted()) return false;
+    return true;
+  }
+
+  /**
+   * @brief Suspend the awaiting coroutine until all requests complete.
+   *
+   * @param[in] handle  the handle of the awaiting coroutine.
+   */
+  void await_suspend(std::coroutine_handle<> handle);
+
+  /**
+   * @brief Check the completed requests for errors.
+   *
+   * @throws ucxx::Error  the error of the first failed request, if any.
+   */
+  void await_resume()
+  {
+    for (const auto& request : _requests)
+      request->checkError();
+  }
+};
+
+/**
+ * @brief Resume coroutines awaiting `ucxx::Request` objects from the progress loop.
+ *
+ * A scheduler of coroutines awaiting requests of a worker, allowing transfers to be written
+ * as structured asynchronous code by awaiting `wait()` from any coroutine type, e.g., asio
+ * awaitables or `ucxx::coro::DetachedTask`. Coroutines awaiting requests are resumed by
+ * `progress()` in the thread calling it once their requests complete, without additional
+ * threads or per-request synchronization.
+ *
+ * The thread calling `progress()` also progresses the worker, unless the worker is running
+ * a progress thread, in which case `progress()` only resumes coroutines and may be called,
+ * e.g., from an application event loop.
+ *
+ * @code{.cpp}
+ * // `worker` is `std::shared_ptr<ucxx::Worker>`, `endpoint` is
+ * // `std::shared_ptr<ucxx::Endpoint>`
+ * ucxx::coro::Scheduler scheduler(worker);
+ *
+ * auto pingPong = [&](std::vector<int>& buffer) -> ucxx::coro::DetachedTask {
+ *   const size_t length = buffer.size() * sizeof(int);
+ *   co_await scheduler.wait(endpoint->tagSend(buffer.data(), length, ucxx::Tag{0}));
+ *   co_await scheduler.wait(
+ *     endpoint->tagRecv(buffer.data(), length, ucxx::Tag{1}, ucxx::TagMaskFull));
+ * };
+ * pingPong(buffer);
+ *
+ * scheduler.run();
+ * @endcode
+ */
+class Scheduler {
+ private:
+  /**
+   * @brief A coroutine suspended until its requests complete.
+   */
+  struct Waiter {
+    std::vector<std::shared_ptr<Request>> requests{};  ///< The requests awaited
+    std::coroutine_handle<> handle{};                  ///< The suspended coroutine
+  };
+
+  std::shared_ptr<Worker> _worker{nullptr};  ///< The worker the requests belong to
+  mutable std::mutex _mutex{};               ///< Mutex to access the waiters
+  std::vector<Waiter> _waiters{};            ///< The suspended coroutines
+
+ public:
+  Scheduler()                            = delete;
+  Scheduler(const Scheduler&)            = delete;
+  Scheduler& operator=(Scheduler const&) = delete;
+  Scheduler(Scheduler&& o)               = delete;
+  Scheduler& operator=(Scheduler&& o)    = delete;
+
+  /**
+   * @brief Constructor of a coroutine scheduler.
+   *
+   * @param[in] worker  the worker whose requests are awaited.
+   */
+  explicit Scheduler(std::shared_ptr<Worker> worker) : _worker(worker) {}
+
+  /**
+   * @brief `ucxx::coro::Scheduler` destructor.
+   *
+   * Coroutines still suspended are never resumed, since their frames may be owned by other
+   * coroutine types they cannot be destroyed and a warning is logged instead.
+   */
+  ~Scheduler()
+  {
+    if (!_waiters.empty())
+      ucxx_warn("ucxx::coro::Scheduler destroyed with %lu suspended coroutines",
+                _waiters.size());
+  }
+
+  /**
+   * @brief Create an awaitable for the completion of a request.
+   *
+   * @param[in] request the request to await.
+   *
+   * @returns The awaitable.
+   */
+  RequestAwaitable wait(std::shared_ptr<Request> request)
+  {
+    return RequestAwaitable(*this, {std::move(request)});
+  }
+
+  /**
+   * @brief Create an awaitable for the completion of multiple requests.
+   *
+   * @param[in] requests  the requests to await, the coroutine is resumed once all of them
+   *                      complete.
+   *
+   * @returns The awaitable.
+   */
+  RequestAwaitable wait(std::vector<std::shared_ptr<Request>> requests)
+  {
+    return RequestAwaitable(*this, std::move(requests));
+  }
+
+  /**
+   * @brief Suspend a coroutine until requests complete.
+   *
+   * Register a suspended coroutine to be resumed by `progress()` once all `requests`
+   * complete. Called by `ucxx::coro::RequestAwaitable`, the user should `co_await`
+   * `wait()` instead.
+   *
+   * @param[in] requests  the requests awaited.
+   * @param[in] handle    the suspended coroutine.
+   */
+  void suspend(std::vector<std::shared_ptr<Request>> requests, std::coroutine_handle<> handle)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _waiters.push_back({std::move(requests), handle});
+  }
+
+  /**
+   * @brief Resume coroutines whose requests completed.
+   *
+   * Resume, in the calling thread, all suspended coroutines whose requests completed,
+   * without progressing the worker.
+   *
+   * @returns The number of coroutines resumed.
+   */
+  size_t resumeCompleted()
+  {
+    std::vector<Waiter> ready;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (size_t i = 0; i < _waiters.size();) {
+        bool completed = true;
+        for (const auto& request : _waiters[i].requests)
+          if (!request->isCompleted()) {
+            completed = false;
+            break;
+          }
+
+        if (completed) {
+          ready.push_back(std::move(_waiters[i]));
+          if (i != _waiters.size() - 1) _waiters[i] = std::move(_waiters.back());
+          _waiters.pop_back();
+        } else {
+          ++i;
+        }
+      }
+    }
+
+    // Resumed coroutines may suspend again, thus the lock must not be held.
+    for (auto& waiter : ready)
+      waiter.handle.resume();
+
+    return ready.size();
+  }
+
+  /**
+   * @brief Progress the worker and resume coroutines whose requests completed.
+   *
+   * Progress the worker once, unless it is running a progress thread, and resume all
+   * suspended coroutines whose requests completed in the calling thread.
+   *
+   * @returns The number of coroutines resumed.
+   */
+  size_t progress()
+  {
+    if (!_worker->isProgressThreadRunning()) _worker->progress();
+    return resumeCompleted();
+  }
+
+  /**
+   * @brief Get the number of suspended coroutines.
+   *
+   * @returns The number of coroutines suspended awaiting requests.
+   */
+  size_t getSuspendedCount() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _waiters.size();
+  }
+
+  /**
+   * @brief Progress until no coroutines are suspended.
+   *
+   * Call `progress()` until all suspended coroutines, including those suspended while
+   * running, resumed and completed or suspended on something other than a request.
+   */
+  void run()
+  {
+    while (getSuspendedCount() > 0)
+      progress();
+  }
+};
+
+inline void RequestAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+  // The coroutine may be resumed by another thread as soon as it is registered, thus the
+  // awaitable must not be accessed afterwards.
+  _scheduler.suspend(_requests, handle);
+}
+
+/**
+ * @brief A fire-and-forget coroutine.
+ *
+ * A minimal coroutine type for applications that do not use a coroutine framework. The
+ * coroutine starts executing immediately when called, runs until its first suspension and
+ * its frame is destroyed once it completes. It cannot be awaited nor return values, and
+ * exceptions escaping it are logged and discarded.
+ */
+struct DetachedTask {
+  /**
+   * @brief The promise type of `ucxx::coro::DetachedTask`.
+   */
+  struct promise_type {
+    DetachedTask get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept
+    {
+      try {
+        std::rethrow_exception(std::current_exception());
+      } catch (const std::exception& e) {
+        ucxx_error("ucxx::coro::DetachedTask raised: %s", e.what());
+      } catch (...) {
+        ucxx_error("ucxx::coro::DetachedTask raised an unknown exception");
+      }
+    }
+  };
+};
+
+}  // namespace coro
+
+}  // namespace ucxx
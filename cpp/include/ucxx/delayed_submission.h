@@ -4,9 +4,13 @@
  */
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <array>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
-#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -19,6 +23,8 @@
 
 #include <ucxx/log.h>
 #include <ucxx/request_data.h>
+#include <ucxx/typedefs.h>
+#include <ucxx/utils/mpsc_queue.h>
 
 namespace ucxx {
 
@@ -41,8 +47,8 @@ class BaseDelayedSubmissionCollection {
  protected:
   std::string _name{"undefined"};  ///< The human-readable name of the collection, used for logging
   bool _enabled{true};  ///< Whether the resource required to process the collection is enabled.
-  std::vector<T> _collection{};  ///< The collection.
-  std::mutex _mutex{};           ///< Mutex to provide access to `_collection`.
+  utils::MPSCQueue<T> _collection{};  ///< The lock-free collection.
+  std::deque<T> _backlog{};  ///< Items consumed but left unprocessed by a budgeted `process()`
 
   /**
    * @brief Log message during `schedule()`.
@@ -72,6 +78,10 @@ class BaseDelayedSubmissionCollection {
    * operation into the collection, whereas the `process()` will invoke all callbacks that
    * were previously pushed into the collection and clear the collection.
    *
+   * The collection is lock-free, multiple threads may call `schedule()` concurrently
+   * without ever blocking on each other or on the thread calling `process()`, which must
+   * be a single thread at a time (usually the worker progress thread).
+   *
    * @param[in] name    human-readable name of the collection, used for logging.
    * @param[in] enabled whether the resource is enabled, if `false` an exception is raised
    *                    when attempting to schedule a callable. Disabled instances of this
@@ -107,35 +117,65 @@ class BaseDelayedSubmissionCollection {
   {
     if (!_enabled) throw std::runtime_error("Resource is disabled.");
 
-    {
-      std::lock_guard<std::mutex> lock(_mutex);
-      _collection.push_back(item);
-    }
     scheduleLog(item);
+    _collection.push(std::move(item));
   }
 
   /**
-   * @brief Process all pending callbacks.
+   * @brief Process pending callbacks.
+   *
+   * Process pending callbacks. Generic callbacks are deemed completed when their
+   * execution completes. Only callbacks scheduled before `process()` was called are
+   * processed, those scheduled in the meantime (e.g., by the callbacks themselves) are
+   * left for the next call. Must not be called concurrently from multiple threads.
+   *
+   * If `budget` is non-zero, at most `budget` callbacks are processed, the remaining ones
+   * are kept in order and processed before any others by subsequent calls.
    *
-   * Process all pending generic. Generic callbacks are deemed completed when their
-   * execution completes.
+   * @param[in] budget  the maximum number of callbacks to process, `0` for no limit.
+   *
+   * @returns The number of callbacks processed.
    */
-  void process()
+  size_t process(size_t budget = 0)
   {
-    decltype(_collection) itemsToProcess;
-    {
-      std::lock_guard<std::mutex> lock(_mutex);
-      // Move _collection to a local copy in order to to hold the lock for as
-      // short as possible
-      itemsToProcess = std::move(_collection);
-    }
+    size_t processed = 0;
 
-    if (itemsToProcess.size() > 0) {
-      ucxx_trace_req("Submitting %lu %s callbacks", itemsToProcess.size(), _name.c_str());
-      for (auto& item : itemsToProcess)
-        processItem(item);
+    if (budget == 0 && _backlog.empty()) {
+      processed = _collection.consume([this](T& item) { processItem(std::move(item)); });
+    } else {
+      _collection.consume([this](T& item) { _backlog.push_back(std::move(item)); });
+      while (!_backlog.empty() && (budget == 0 || processed < budget)) {
+        T item = std::move(_backlog.front());
+        _backlog.pop_front();
+        processItem(std::move(item));
+        ++processed;
+      }
     }
+
+    if (processed > 0) ucxx_trace_req("Submitted %lu %s callbacks", processed, _name.c_str());
+
+    return processed;
   }
+
+  /**
+   * @brief Check whether there are no pending callbacks.
+   *
+   * Check whether there are no pending callbacks. The result is only a snapshot, callbacks
+   * may be scheduled concurrently. Must only be called from the thread calling `process()`.
+   *
+   * @returns `true` if there are no pending callbacks, `false` otherwise.
+   */
+  bool empty() const { return _backlog.empty() && _collection.empty(); }
+
+  /**
+   * @brief Check whether callbacks were left unprocessed by a budgeted `process()`.
+   *
+   * Check whether callbacks were left unprocessed by the last `process()` call because its
+   * budget was exhausted. Must only be called from the thread calling `process()`.
+   *
+   * @returns `true` if callbacks were left unprocessed, `false` otherwise.
+   */
+  bool hasBacklog() const { return !_backlog.empty(); }
 };
 
 /**
@@ -206,9 +246,41 @@ class DelayedSubmissionCollection {
     "generic pre"};  ///< The collection of all known generic pre-progress operations.
   GenericDelayedSubmissionCollection _genericPost{
     "generic post"};  ///< The collection of all known generic post-progress operations.
-  RequestDelayedSubmissionCollection _requests{
-    "request", false};  ///< The collection of all known delayed request submission operations.
+  std::array<RequestDelayedSubmissionCollection, 3>
+    _requests;  ///< The collections of delayed request submissions, indexed by priority class.
   bool _enableDelayedRequestSubmission{false};
+  std::atomic<size_t> _requestBudget{
+    0};  ///< Maximum `Normal` and `Bulk` request submissions per `processPre()`, `0` unlimited
+  std::atomic<bool> _preSignalPending{
+    false};  ///< Whether the owner was requested to signal since the last `processPre()`.
+  std::atomic<bool> _postSignalPending{
+    false};  ///< Whether the owner was requested to signal since the last `processPost()`.
+  std::atomic<uint64_t> _processedCallbacks{0};  ///< Number of callbacks processed
+  std::atomic<uint64_t> _processNanoseconds{
+    0};  ///< Total time in nanoseconds spent processing callbacks
+
+  /**
+   * @brief Check whether the owner must signal after a registration.
+   *
+   * Mark a signal as pending, returning whether the caller is the first one to do so since
+   * `pending` was last cleared by the corresponding `processPre()` or `processPost()`.
+   *
+   * @param[in] pending the flag of the collection the registration was made to.
+   *
+   * @returns `true` if the caller must signal the owner, `false` if a signal is pending.
+   */
+  static bool requireSignal(std::atomic<bool>& pending);
+
+  /**
+   * @brief Update the processing statistics.
+   *
+   * Update the processing statistics after callbacks were processed by `processPre()` or
+   * `processPost()`.
+   *
+   * @param[in] processed the number of callbacks processed.
+   * @param[in] start     the time processing started.
+   */
+  void updateStatistics(size_t processed, std::chrono::steady_clock::time_point start);
 
  public:
   /**
@@ -243,14 +315,33 @@ class DelayedSubmissionCollection {
    * Generic callbacks may be used to to pass information between threads on the subject
    * that requests have been in fact processed, therefore, requests are processed first,
    * then generic callbacks are.
+   *
+   * Requests of the `ucxx::SubmissionPriority::High` class are all submitted first,
+   * followed by `Normal` and `Bulk` requests within the limits of the budget set with
+   * `setRequestBudget()`. When `Bulk` requests are pending and the budget is at least 2, a
+   * quarter of the budget (at least one submission) is reserved for them, thus preventing
+   * their starvation by `Normal` requests, and any budget `Normal` requests leave unused is
+   * given to `Bulk` requests as well. Requests exceeding the budget are submitted in order
+   * by subsequent calls, before any requests of the same class registered later.
+   *
+   * Clears the pending signal state of delayed request submissions and generic-pre
+   * callbacks before processing, see `registerRequest()`, unless requests were left
+   * unsubmitted because the budget was exhausted, in which case the caller is expected to
+   * call `processPre()` again without waiting for a signal.
+   *
+   * @returns `true` if requests were left unsubmitted because the budget was exhausted,
+   *          `false` otherwise.
    */
-  void processPre();
+  bool processPre();
 
   /**
    * @brief Process all pending generic-post callback operations.
    *
    * Process all pending generic-post callbacks. Generic callbacks are deemed completed when
    * their execution completes.
+   *
+   * Clears the pending signal state of generic-post callbacks before processing, see
+   * `registerGenericPost()`.
    */
   void processPost();
 
@@ -260,34 +351,70 @@ class DelayedSubmissionCollection {
    * Register a request for delayed submission with a callback that will be executed when
    * the request is in fact submitted when `processPre()` is called.
    *
+   * The return value indicates whether the caller must wake the thread calling
+   * `processPre()`, which is only the case for the first registration since the last
+   * `processPre()` call, subsequent registrations will be processed by the wakeup that
+   * is already pending.
+   *
    * @throws std::runtime_error if delayed request submission was disabled at construction.
    *
    * @param[in] request   the request to which the callback belongs, ensuring it remains
    *                      alive until the callback is invoked.
    * @param[in] callback  the callback that will be executed by `processPre()` when the
    *                      operation is submitted.
+   * @param[in] priority  the priority class of the submission, see `processPre()`.
+   *
+   * @returns `true` if the caller must signal the processing thread, `false` otherwise.
+   */
+  bool registerRequest(std::shared_ptr<Request> request,
+                       DelayedSubmissionCallbackType callback,
+                       SubmissionPriority priority = SubmissionPriority::Normal);
+
+  /**
+   * @brief Set the budget of request submissions per `processPre()` call.
+   *
+   * Set the maximum number of `ucxx::SubmissionPriority::Normal` and `Bulk` request
+   * submissions per `processPre()` call, bounding the time each iteration of the progress
+   * loop spends submitting requests, so that `High` requests registered meanwhile are
+   * submitted without waiting for a large burst of lower priority requests to be
+   * submitted entirely. `High` requests are not limited by the budget.
+   *
+   * @param[in] budget  the maximum number of submissions, `0` (the default) for no limit.
+   */
+  void setRequestBudget(size_t budget);
+
+  /**
+   * @brief Get the budget of request submissions per `processPre()` call.
+   *
+   * @returns The maximum number of submissions, or `0` if there is no limit.
    */
-  void registerRequest(std::shared_ptr<Request> request, DelayedSubmissionCallbackType callback);
+  size_t getRequestBudget() const;
 
   /**
    * @brief Register a generic callback to execute during `processPre()`.
    *
    * Register a generic callback that will be executed when `processPre()` is called.
-   * Lifetime of the callback must be ensured by the caller.
+   * Lifetime of the callback must be ensured by the caller. See `registerRequest()` for
+   * the meaning of the return value.
    *
    * @param[in] callback  the callback that will be executed by `processPre()`.
+   *
+   * @returns `true` if the caller must signal the processing thread, `false` otherwise.
    */
-  void registerGenericPre(DelayedSubmissionCallbackType callback);
+  bool registerGenericPre(DelayedSubmissionCallbackType callback);
 
   /**
    * @brief Register a generic callback to execute during `processPost()`.
    *
    * Register a generic callback that will be executed when `processPost()` is called.
-   * Lifetime of the callback must be ensured by the caller.
+   * Lifetime of the callback must be ensured by the caller. See `registerRequest()` for
+   * the meaning of the return value.
    *
    * @param[in] callback  the callback that will be executed by `processPre()`.
+   *
+   * @returns `true` if the caller must signal the processing thread, `false` otherwise.
    */
-  void registerGenericPost(DelayedSubmissionCallbackType callback);
+  bool registerGenericPost(DelayedSubmissionCallbackType callback);
 
   /**
    * @brief Inquire if delayed request submission is enabled.
@@ -298,6 +425,27 @@ class DelayedSubmissionCollection {
    * @returns `true` if a delayed request submission is enabled, `false` otherwise.
    */
   bool isDelayedRequestSubmissionEnabled() const;
+
+  /**
+   * @brief Get the number of callbacks processed.
+   *
+   * Get the number of delayed request submissions and generic callbacks processed by
+   * `processPre()` and `processPost()`.
+   *
+   * @returns The number of callbacks processed.
+   */
+  uint64_t getProcessedCallbacks() const;
+
+  /**
+   * @brief Get the time spent processing callbacks.
+   *
+   * Get the total time spent executing delayed request submissions and generic callbacks
+   * by `processPre()` and `processPost()`. Calls where no callbacks were pending are not
+   * timed, thus not adding any overhead to an idle progress loop.
+   *
+   * @returns The total time spent processing callbacks in nanoseconds.
+   */
+  uint64_t getProcessNanoseconds() const;
 };
 
 }  // namespace ucxx
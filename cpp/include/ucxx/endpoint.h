@@ -6,8 +6,16 @@
 
 #include <netdb.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <ucp/api/ucp.h>
@@ -16,30 +24,20 @@
 #include <ucxx/component.h>
 #include <ucxx/exception.h>
 #include <ucxx/inflight_requests.h>
+#include <ucxx/internal/request_tag_multi.h>
 #include <ucxx/listener.h>
 #include <ucxx/request.h>
+#include <ucxx/statistics.h>
+#include <ucxx/stream_data.h>
 #include <ucxx/typedefs.h>
 #include <ucxx/utils/sockaddr.h>
 #include <ucxx/worker.h>
 
 namespace ucxx {
 
-/**
- * @brief Deleter for a endpoint parameters object.
- *
- * Deleter used during allocation of a `ucp_ep_params_t*` to handle automated deletion of
- * the object when its reference count goes to zero.
- */
-struct EpParamsDeleter {
-  /**
-   * @brief Execute the deletion.
-   *
-   * Execute the deletion of the `ucp_ep_params_t*` object.
-   *
-   * param[in] ptr  the point to the object to be deleted.
-   */
-  void operator()(ucp_ep_params_t* ptr);
-};
+namespace internal {
+struct AmAggregationBatch;
+}  // namespace internal
 
 /**
  * @brief The endpoint data that is accessible by the error callback.
@@ -48,11 +46,11 @@ struct EpParamsDeleter {
  * callback to modify the `ucxx::Endpoint` with information relevant to the error occurred.
  */
 struct ErrorCallbackData {
-  ucs_status_t status;                                 ///< Endpoint status
-  std::shared_ptr<InflightRequests> inflightRequests;  ///< Endpoint inflight requests
-  std::function<void(void*)> closeCallback;            ///< Close callback to call
-  void* closeCallbackArg;                              ///< Argument to be passed to close callback
-  std::shared_ptr<Worker> worker;  ///< Worker the endpoint has been created from
+  ucs_status_t status{UCS_OK};                 ///< Endpoint status
+  InflightRequests inflightRequests{};         ///< Endpoint inflight requests
+  std::function<void(void*)> closeCallback{};  ///< Close callback to call
+  void* closeCallbackArg{nullptr};             ///< Argument to be passed to close callback
+  std::shared_ptr<Worker> worker{nullptr};     ///< Worker the endpoint has been created from
 };
 
 /**
@@ -67,10 +65,37 @@ class Endpoint : public Component {
   ucp_ep_h _originalHandle{nullptr};  ///< Handle to the UCP endpoint, after it was previously
                                       ///< closed, used for logging purposes only
   bool _endpointErrorHandling{true};  ///< Whether the endpoint enables error handling
-  std::unique_ptr<ErrorCallbackData> _callbackData{
-    nullptr};  ///< Data struct to pass to endpoint error handling callback
-  std::shared_ptr<InflightRequests> _inflightRequests{
-    std::make_shared<InflightRequests>()};  ///< The inflight requests
+  ErrorCallbackData _callbackData{};  ///< Data struct to pass to endpoint error handling
+                                     ///< callback, including the inflight requests
+  internal::RequestCounters _requestCounters{};  ///< Counters of requests of the endpoint
+  SendHints _sendHints{};                        ///< Hints on how to send messages
+  std::atomic<ucp_tag_t> _sendTagBase{0};        ///< Base tag to derive send tags from
+  std::atomic<ucp_tag_t> _recvTagBase{0};        ///< Base tag to derive receive tags from
+  mutable std::mutex _sendHintsMutex{};          ///< Mutex to access the send hints
+  mutable std::mutex _amFlowControlMutex{};      ///< Mutex to access the AM flow control state
+  bool _amFlowControlEnabled{false};             ///< Whether AM flow control is enabled
+  uint64_t _amFlowControlMaxMessages{0};  ///< Maximum AM messages in flight, `0` if unlimited
+  uint64_t _amFlowControlMaxBytes{0};     ///< Maximum AM bytes in flight, `0` if unlimited
+  uint64_t _amInflightMessages{0};        ///< AM messages sent awaiting their credit
+  uint64_t _amInflightBytes{0};           ///< AM bytes sent awaiting their credit
+  std::deque<std::pair<size_t, std::function<void()>>>
+    _amPendingSends{};  ///< AM sends awaiting credits, with their length and submit function
+  mutable std::mutex _amAggregationMutex{};  ///< Mutex to access the AM aggregation state
+  size_t _amAggregationMaxMessageSize{0};    ///< Largest AM aggregated, `0` if disabled
+  size_t _amAggregationMaxBatchBytes{0};     ///< Largest batch of aggregated AMs in bytes
+  std::chrono::nanoseconds _amAggregationWindow{0};  ///< Time AMs may wait to be aggregated
+  std::shared_ptr<internal::AmAggregationBatch>
+    _amAggregationBatch{};  ///< The batch of AMs being aggregated, if any
+  mutable std::mutex _tagMultiPrepostMutex{};  ///< Mutex to access the preposted headers
+  bool _tagMultiPrepostEnabled{false};         ///< Whether to prepost multi-buffer headers
+  std::map<std::pair<ucp_tag_t, ucp_tag_t>, std::shared_ptr<internal::TagMultiPrepostedHeader>>
+    _tagMultiPrepostedHeaders{};  ///< Preposted multi-buffer headers, by tag and tag mask
+  std::atomic<bool> _trafficCaptureEnabled{
+    true};  ///< Whether operations are captured when the worker captures traffic
+
+  friend class Request;
+  friend class RequestEndpointClose;
+  friend class Worker;
 
   /**
    * @brief Private constructor of `ucxx::Endpoint`.
@@ -98,6 +123,120 @@ class Endpoint : public Component {
            ucp_ep_params_t* params,
            bool endpointErrorHandling);
 
+  /**
+   * @brief Private constructor of `ucxx::Endpoint` without a UCP endpoint.
+   *
+   * Construct the `ucxx::Endpoint` object without creating the underlying UCP endpoint,
+   * which the caller is responsible for creating with parameters prepared by
+   * `setErrorHandlerParams()`. Used to create multiple endpoints at once.
+   *
+   * @param[in] workerOrListener      the parent component, which may either be a
+   *                                  `std::shared_ptr<Listener>` or
+   *                                  `std::shared_ptr<Worker>`.
+   * @param[in] endpointErrorHandling whether to enable endpoint error handling.
+   */
+  Endpoint(std::shared_ptr<Component> workerOrListener, bool endpointErrorHandling);
+
+  /**
+   * @brief Set the error handling fields of the UCP endpoint parameters.
+   *
+   * Set the error handling mode and the error handler of `params` for this endpoint,
+   * must be called before the UCP endpoint is created with `params`.
+   *
+   * @param[in,out] params  parameters specifying UCP endpoint capabilities.
+   */
+  void setErrorHandlerParams(ucp_ep_params_t* params);
+
+  /**
+   * @brief Create multiple endpoints at once.
+   *
+   * Create one endpoint for each element of `params`. If the worker is running a progress
+   * thread, all UCP endpoints are created by it in a single batch, rather than waiting for
+   * the progress thread once per endpoint.
+   *
+   * @throws ucxx::Error if an error occurred while attempting to create any endpoint.
+   *
+   * @param[in] workerOrListener      the parent component, which may either be a
+   *                                  `std::shared_ptr<Listener>` or
+   *                                  `std::shared_ptr<Worker>`.
+   * @param[in] params                parameters specifying UCP endpoint capabilities of
+   *                                  each endpoint.
+   * @param[in] endpointErrorHandling whether to enable endpoint error handling.
+   *
+   * @returns The `shared_ptr<ucxx::Endpoint>` objects, in the same order as `params`.
+   */
+  static std::vector<std::shared_ptr<Endpoint>> createEndpoints(
+    std::shared_ptr<Component> workerOrListener,
+    std::vector<ucp_ep_params_t>& params,
+    bool endpointErrorHandling);
+
+  /**
+   * @brief Detach the UCP endpoint handle to close it.
+   *
+   * Cancel all inflight requests and detach the UCP endpoint handle from the object,
+   * returning it so that the caller may close it with `ucp_ep_close_nbx`. After this
+   * method is called `getHandle()` returns `nullptr`, preventing new requests from being
+   * created and the endpoint from being closed again. Must be called from the worker
+   * progress thread if one is running.
+   *
+   * @returns The UCP endpoint handle, or `nullptr` if the endpoint was already closed.
+   */
+  ucp_ep_h detachHandle();
+
+  /**
+   * @brief Flush the endpoint, waiting for a bounded period.
+   *
+   * Flush all operations previously issued on the endpoint and wait for the flush to
+   * complete, progressing the worker if it's not running a progress thread or if called
+   * from the progress thread.
+   *
+   * @param[in] timeout maximum period in nanoseconds to wait for the flush to complete.
+   *
+   * @returns `true` if the flush completed successfully within `timeout`, `false`
+   *          otherwise.
+   */
+  bool flushWithTimeout(uint64_t timeout);
+
+  /**
+   * @brief Execute the user-defined close callback, if registered.
+   *
+   * Execute the user-defined close callback registered with `setCloseCallback()` once, if
+   * one was registered and it hasn't yet been executed by the error callback.
+   */
+  void invokeCloseCallback();
+
+  /**
+   * @brief Take the batch of aggregated active messages, if any.
+   *
+   * Detach the batch of aggregated active messages from the endpoint, unregistering it
+   * from the worker, must be called with `_amAggregationMutex` held.
+   *
+   * @returns The batch detached, or `nullptr` if there was none.
+   */
+  std::shared_ptr<internal::AmAggregationBatch> takeAmAggregationBatch();
+
+  /**
+   * @brief Submit a batch of aggregated active messages.
+   *
+   * Submit a batch previously detached with `takeAmAggregationBatch()` as a single active
+   * message, completing the requests of all messages it contains upon completion.
+   *
+   * @param[in] batch the batch to submit, nothing is done if `nullptr`.
+   */
+  void submitAmAggregationBatch(std::shared_ptr<internal::AmAggregationBatch> batch);
+
+  /**
+   * @brief Flush the batch of aggregated active messages if its time window expired.
+   *
+   * Submit the batch of aggregated active messages if it was created at least the
+   * aggregation time window before `now`, called by the worker upon progress.
+   *
+   * @param[in] now the current time.
+   *
+   * @returns `true` if a batch remains pending, `false` otherwise.
+   */
+  bool flushExpiredAmAggregation(std::chrono::steady_clock::time_point now);
+
   /**
    * @brief Register an inflight request.
    *
@@ -111,6 +250,19 @@ class Endpoint : public Component {
    */
   std::shared_ptr<Request> registerInflightRequest(std::shared_ptr<Request> request);
 
+  /**
+   * @brief Register multiple inflight requests.
+   *
+   * Register multiple inflight requests at once, acquiring the inflight requests lock only
+   * a single time for the entire batch. See `registerInflightRequest()` for details.
+   *
+   * @param[in] requests  the requests to register.
+   *
+   * @return the requests that were registered (i.e., the `requests` argument itself).
+   */
+  std::vector<std::shared_ptr<Request>> registerInflightRequests(
+    std::vector<std::shared_ptr<Request>> requests);
+
  public:
   Endpoint()                           = delete;
   Endpoint(const Endpoint&)            = delete;
@@ -173,6 +325,37 @@ class Endpoint : public Component {
                                                                  ucp_conn_request_h connRequest,
                                                                  bool endpointErrorHandling);
 
+  /**
+   * @brief Constructor for multiple `shared_ptr<ucxx::Endpoint>` from connection requests.
+   *
+   * Create one endpoint for each `ucp_conn_request_h` in `connRequests`, as
+   * `createEndpointFromConnRequest()` would, but creating all of them at once. If the
+   * worker is running a progress thread, all UCP endpoints are created by it in a single
+   * batch.
+   *
+   * @code{.cpp}
+   * // listener is `std::shared_ptr<ucxx::Listener>` created with a backlog
+   * auto endpoints = listener->acceptEndpoints();
+   *
+   * // Roughly equivalent to line above, given `connRequests` popped from the listener
+   * // auto endpoints = ucxx::createEndpointsFromConnRequests(listener, connRequests, true);
+   * @endcode
+   *
+   * @throws ucxx::Error if an error occurred while attempting to create any endpoint.
+   *
+   * @param[in] listener              listener from which to create the endpoints.
+   * @param[in] connRequests          handles to connection requests delivered by the
+   *                                  listener.
+   * @param[in] endpointErrorHandling whether to enable endpoint error handling.
+   *
+   * @returns The `shared_ptr<ucxx::Endpoint>` objects, in the same order as
+   *          `connRequests`.
+   */
+  friend std::vector<std::shared_ptr<Endpoint>> createEndpointsFromConnRequests(
+    std::shared_ptr<Listener> listener,
+    const std::vector<ucp_conn_request_h>& connRequests,
+    bool endpointErrorHandling);
+
   /**
    * @brief Constructor for `shared_ptr<ucxx::Endpoint>`.
    *
@@ -196,6 +379,70 @@ class Endpoint : public Component {
                                                                    std::shared_ptr<Address> address,
                                                                    bool endpointErrorHandling);
 
+  /**
+   * @brief Constructor for multiple `shared_ptr<ucxx::Endpoint>` from hostnames.
+   *
+   * Create one endpoint to each remote worker listening on the hostname or IP address and
+   * port pairs in `hosts`, as `createEndpointFromHostname()` would, but creating all of
+   * them at once. If the worker is running a progress thread, all UCP endpoints are
+   * created by it in a single batch.
+   *
+   * @code{.cpp}
+   * // worker is `std::shared_ptr<ucxx::Worker>`
+   * auto endpoints = worker->createEndpointsFromHostnames({{"10.10.10.10", 12345},
+   *                                                        {"10.10.10.11", 12345}});
+   *
+   * // Equivalent to line above
+   * // auto endpoints = ucxx::createEndpointsFromHostnames(
+   * //   worker, {{"10.10.10.10", 12345}, {"10.10.10.11", 12345}}, true);
+   * @endcode
+   *
+   * @throws std::invalid_argument if any IP address or hostname is invalid.
+   * @throws ucxx::Error if an error occurred while attempting to create any endpoint.
+   *
+   * @param[in] worker                parent worker from which to create the endpoints.
+   * @param[in] hosts                 hostname or IP address and port pairs the listeners
+   *                                  are bound to.
+   * @param[in] endpointErrorHandling whether to enable endpoint error handling.
+   *
+   * @returns The `shared_ptr<ucxx::Endpoint>` objects, in the same order as `hosts`.
+   */
+  friend std::vector<std::shared_ptr<Endpoint>> createEndpointsFromHostnames(
+    std::shared_ptr<Worker> worker,
+    const std::vector<std::pair<std::string, uint16_t>>& hosts,
+    bool endpointErrorHandling);
+
+  /**
+   * @brief Constructor for multiple `shared_ptr<ucxx::Endpoint>` from worker addresses.
+   *
+   * Create one endpoint to each remote worker in `addresses`, as
+   * `createEndpointFromWorkerAddress()` would, but creating all of them at once. If the
+   * worker is running a progress thread, all UCP endpoints are created by it in a single
+   * batch.
+   *
+   * @code{.cpp}
+   * // worker is `std::shared_ptr<ucxx::Worker>`, addresses is
+   * // `std::vector<std::shared_ptr<ucxx::Address>>`
+   * auto endpoints = worker->createEndpointsFromWorkerAddresses(addresses, true);
+   *
+   * // Equivalent to line above
+   * // auto endpoints = ucxx::createEndpointsFromWorkerAddresses(worker, addresses, true);
+   * @endcode
+   *
+   * @throws ucxx::Error if any address is not initialized or an error occurred while
+   *                     attempting to create any endpoint.
+   *
+   * @param[in] worker                parent worker from which to create the endpoints.
+   * @param[in] addresses             addresses of the remote UCX workers.
+   * @param[in] endpointErrorHandling whether to enable endpoint error handling.
+   *
+   * @returns The `shared_ptr<ucxx::Endpoint>` objects, in the same order as `addresses`.
+   */
+  friend std::vector<std::shared_ptr<Endpoint>> createEndpointsFromWorkerAddresses(
+    std::shared_ptr<Worker> worker,
+    const std::vector<std::shared_ptr<Address>>& addresses,
+    bool endpointErrorHandling);
+
   /**
    * @brief Get the underlying `ucp_ep_h` handle.
    *
@@ -236,6 +483,21 @@ class Endpoint : public Component {
    */
   void raiseOnError();
 
+  /**
+   * @brief Get the error of the endpoint without throwing.
+   *
+   * Get the error that occurred if error handling is enabled for the endpoint, additionally
+   * writing the message `raiseOnError()` would throw with to `message`. The non-throwing
+   * variant of `raiseOnError()`, e.g., to check the endpoint before each submission.
+   *
+   * @param[out] message  the message describing the error, only written if an error
+   *                      occurred, may be `nullptr` if not needed.
+   *
+   * @returns the error that occurred, or `UCS_OK` if no error occurred or error handling
+   *          is disabled.
+   */
+  ucs_status_t getError(std::string* message = nullptr) noexcept;
+
   /**
    * @brief Remove reference to request from internal container.
    *
@@ -288,6 +550,331 @@ class Endpoint : public Component {
    */
   void setCloseCallback(std::function<void(void*)> closeCallback, void* closeCallbackArg);
 
+  /**
+   * @brief Set hints on how the endpoint sends messages.
+   *
+   * Set hints passed to UCX when sending messages from this endpoint, applying to all
+   * messages submitted after this call, including each frame of multi-buffer transfers.
+   * See `ucxx::SendHints` for details.
+   *
+   * @code{.cpp}
+   * // `endpoint` is `std::shared_ptr<ucxx::Endpoint>`, used for small control messages
+   * ucxx::SendHints sendHints{};
+   * sendHints.amProtocol     = ucxx::SendProtocol::Eager;
+   * sendHints.fastCompletion = true;
+   * endpoint->setSendHints(sendHints);
+   * @endcode
+   *
+   * @param[in] sendHints the hints on how to send messages.
+   */
+  void setSendHints(const SendHints& sendHints);
+
+  /**
+   * @brief Get the hints on how the endpoint sends messages.
+   *
+   * @returns The hints on how the endpoint sends messages.
+   */
+  SendHints getSendHints() const;
+
+  /**
+   * @brief Set the base tags to derive send and receive tags from.
+   *
+   * Set the base tags that namespace the messages of this endpoint, typically agreed upon
+   * with the remote endpoint at connection time, where the send base tag of one end is
+   * the receive base tag of the other. Tags are then derived from small user tags with
+   * `deriveSendTag()` and `deriveRecvTag()`, without requiring applications to hash them.
+   *
+   * @code{.cpp}
+   * // `endpoint` is `std::shared_ptr<ucxx::Endpoint>`, the remote endpoint has the base
+   * // tags swapped
+   * endpoint->setTagBases(ucxx::Tag{peerTag}, ucxx::Tag{localTag});
+   * auto request = endpoint->tagSend(buffer, length, endpoint->deriveSendTag(42));
+   * @endcode
+   *
+   * @param[in] sendTagBase the base tag to derive send tags from.
+   * @param[in] recvTagBase the base tag to derive receive tags from.
+   */
+  void setTagBases(Tag sendTagBase, Tag recvTagBase);
+
+  /**
+   * @brief Get the base tag to derive send tags from.
+   *
+   * @returns The base tag to derive send tags from, `0` if never set.
+   */
+  [[nodiscard]] Tag getSendTagBase() const;
+
+  /**
+   * @brief Get the base tag to derive receive tags from.
+   *
+   * @returns The base tag to derive receive tags from, `0` if never set.
+   */
+  [[nodiscard]] Tag getRecvTagBase() const;
+
+  /**
+   * @brief Derive the tag to send a message with from a user tag.
+   *
+   * Derive the tag combining the send base tag with a user tag, matching the tag derived
+   * by `deriveRecvTag()` from the same user tag on the remote endpoint. See
+   * `ucxx::utils::deriveTag()`.
+   *
+   * @param[in] userTag the user tag.
+   *
+   * @returns The tag to send a message with.
+   */
+  [[nodiscard]] Tag deriveSendTag(uint64_t userTag) const;
+
+  /**
+   * @brief Derive the tag to receive a message with from a user tag.
+   *
+   * Derive the tag combining the receive base tag with a user tag, matching the tag
+   * derived by `deriveSendTag()` from the same user tag on the remote endpoint. See
+   * `ucxx::utils::deriveTag()`.
+   *
+   * @param[in] userTag the user tag.
+   *
+   * @returns The tag to receive a message with.
+   */
+  [[nodiscard]] Tag deriveRecvTag(uint64_t userTag) const;
+
+  /**
+   * @brief Apply the send hints to the parameters of a send operation.
+   *
+   * Apply the endpoint send hints to the parameters of a UCP send operation of `length`
+   * bytes, setting operation attribute flags and, for active messages, the protocol flags.
+   * Called by send requests when the operation is submitted.
+   *
+   * WARNING: This is not intended to be called by the user, but it currently needs to be
+   * a public method so that requests may access it.
+   *
+   * @param[in,out] param         the parameters of the send operation.
+   * @param[in]     length        the length of the message in bytes.
+   * @param[in]     activeMessage whether the operation is an active message send.
+   */
+  void applySendHints(ucp_request_param_t& param, size_t length, bool activeMessage) const;
+
+  /**
+   * @brief Enable or disable credit-based flow control of active messages.
+   *
+   * Limit the number of active messages, and the number of bytes they carry, sent by this
+   * endpoint that the remote worker has not yet delivered to the application. A message
+   * is delivered when the remote application receives it with `amRecv()`, or when it is
+   * handed to a receiver callback, upon which its credit is returned to this endpoint.
+   * Sends exceeding the budget are not submitted, the requests returned by `amSend()`
+   * remain pending until credits are returned, bounding the memory the remote worker
+   * buffers for messages it received but its application did not yet consume.
+   *
+   * A message is always sent if no other messages are in flight, even if it exceeds the
+   * budget on its own. Both workers must be using UCXX, the active message ID `0xffff` is
+   * reserved to return credits. Pending sends are submitted, and thus canceled, when the
+   * endpoint is closed.
+   *
+   * @code{.cpp}
+   * // `endpoint` is `std::shared_ptr<ucxx::Endpoint>`, allow at most 64 messages and
+   * // 16 MiB to be buffered by the remote worker.
+   * endpoint->setAmFlowControl(64, 16 << 20);
+   * @endcode
+   *
+   * @param[in] maxMessages maximum number of messages in flight, `0` for unlimited.
+   * @param[in] maxBytes    maximum number of bytes in flight, `0` for unlimited. Passing
+   *                        `0` for both disables flow control, submitting pending sends.
+   */
+  void setAmFlowControl(uint64_t maxMessages, uint64_t maxBytes);
+
+  /**
+   * @brief Check whether credit-based flow control of active messages is enabled.
+   *
+   * @returns Whether flow control is enabled, see `setAmFlowControl()`.
+   */
+  bool isAmFlowControlEnabled() const;
+
+  /**
+   * @brief Get the number of active message sends awaiting credits.
+   *
+   * @returns The number of sends not yet submitted due to flow control.
+   */
+  size_t getAmPendingSendCount() const;
+
+  /**
+   * @brief Submit an active message send subject to flow control.
+   *
+   * Reserve credits for an active message of `length` bytes and call `submit`, or defer
+   * calling `submit` until enough credits are returned if the budget is exhausted.
+   *
+   * WARNING: This is not intended to be called by the user, but it currently needs to be
+   * a public method so that requests may access it.
+   *
+   * @param[in] length  the length of the message in bytes.
+   * @param[in] submit  the function submitting the send.
+   *
+   * @returns `false` if flow control is disabled, in which case `submit` is not called and
+   *          the caller must submit the send itself, `true` otherwise.
+   */
+  bool submitWithAmCredits(size_t length, std::function<void()> submit);
+
+  /**
+   * @brief Return active message credits, submitting pending sends that fit the budget.
+   *
+   * WARNING: This is not intended to be called by the user, but it currently needs to be
+   * a public method so that the worker may access it.
+   *
+   * @param[in] messages  the number of messages delivered by the remote worker.
+   * @param[in] bytes     the number of bytes delivered by the remote worker.
+   */
+  void grantAmCredits(uint64_t messages, uint64_t bytes);
+
+  /**
+   * @brief Enable or disable aggregation of small active messages.
+   *
+   * Coalesce active messages of at most `maxMessageSize` bytes of host memory sent by this
+   * endpoint into batches, each sent as a single active message and split back into the
+   * individual messages by the remote worker, delivering them as if they were sent
+   * individually. This trades a small increase in latency for a higher message rate when
+   * sending many small messages, such as metrics or heartbeats.
+   *
+   * A batch is submitted once adding another message would exceed `maxBatchBytes`, when
+   * the worker is progressed at least `window` nanoseconds after its first message was
+   * added, when `flushAmAggregation()` or `flush()` is called, before a message that is not
+   * aggregated is sent and when the endpoint is closed, preserving the order of all active
+   * messages sent by the endpoint. The requests returned by `amSend()` for aggregated
+   * messages complete when the batch completes. With a progress thread in blocking mode the
+   * worker is only progressed on events, thus `window` should be `0` in that case,
+   * submitting batches upon the next progress.
+   *
+   * Both workers must be using UCXX, the active message ID `0xfffe` is reserved for batches.
+   * Aggregation can not be enabled together with flow control, see `setAmFlowControl()`.
+   *
+   * @code{.cpp}
+   * // `endpoint` is `std::shared_ptr<ucxx::Endpoint>`, aggregate messages up to 256 bytes
+   * // into batches of up to 8 KiB, waiting up to 10 microseconds for more messages.
+   * endpoint->setAmAggregation(256, 8192, 10000);
+   * @endcode
+   *
+   * @throws std::invalid_argument  if `maxMessageSize` does not fit in `maxBatchBytes`.
+   * @throws std::runtime_error     if flow control is enabled.
+   * @throws ucxx::Error            if the endpoint is closed.
+   *
+   * @param[in] maxMessageSize  largest message in bytes to aggregate, `0` disables
+   *                            aggregation, submitting the pending batch.
+   * @param[in] maxBatchBytes   largest batch in bytes, including the framing overhead of
+   *                            each message.
+   * @param[in] window          period in nanoseconds messages may wait for others to be
+   *                            aggregated with.
+   */
+  void setAmAggregation(size_t maxMessageSize, size_t maxBatchBytes = 8192, uint64_t window = 0);
+
+  /**
+   * @brief Check whether aggregation of small active messages is enabled.
+   *
+   * @returns Whether aggregation is enabled, see `setAmAggregation()`.
+   */
+  bool isAmAggregationEnabled() const;
+
+  /**
+   * @brief Submit the batch of aggregated active messages immediately.
+   *
+   * Submit the pending batch of aggregated active messages, if any, without waiting for
+   * its time or size windows, see `setAmAggregation()`.
+   */
+  void flushAmAggregation();
+
+  /**
+   * @brief Aggregate an active message send if eligible.
+   *
+   * Add the message of an active message send request to the pending batch if aggregation
+   * is enabled and the message is eligible, otherwise submit the pending batch, if any, so
+   * that the caller may submit the message in order.
+   *
+   * WARNING: This is not intended to be called by the user, but it currently needs to be
+   * a public method so that requests may access it.
+   *
+   * @param[in] request  the active message send request.
+   * @param[in] amSend   the data of the active message send request.
+   *
+   * @returns `true` if the message was aggregated, in which case `request` completes with
+   *          the batch, `false` if the caller must submit the send itself.
+   */
+  bool aggregateAmSend(std::shared_ptr<Request> request, const data::AmSend& amSend);
+
+  /**
+   * @brief Enable or disable preposting of multi-buffer tag message headers.
+   *
+   * Enable or disable preposting the header receive of the next multi-buffer tag message.
+   * When enabled, a multi-buffer tag receive posts the receive of the first header of the
+   * next message with the same tag and tag mask as soon as it posted the receives of all
+   * its frames, the next multi-buffer tag receive with the same tag and tag mask then
+   * adopts the preposted header receive instead of posting its own. Applications calling
+   * `tagMultiRecv()` in a loop thus have the next header receive posted while they process
+   * the current message, reducing the number of headers arriving as unexpected messages
+   * and the latency of each message.
+   *
+   * Only applications receiving all messages with the tag and tag mask exclusively with
+   * `tagMultiRecv()`, one at a time, may enable it, otherwise a preposted header receive
+   * may match a message not meant for it. Header receives preposted before disabling are
+   * still adopted by subsequent multi-buffer tag receives, and are canceled when the
+   * endpoint is closed.
+   *
+   * @param[in] enable  whether to prepost the header receive of the next message.
+   */
+  void setTagMultiPrepost(bool enable);
+
+  /**
+   * @brief Inquire if preposting of multi-buffer tag message headers is enabled.
+   *
+   * @returns Whether preposting is enabled, see `setTagMultiPrepost()`.
+   */
+  bool isTagMultiPrepostEnabled() const;
+
+  /**
+   * @brief Enable or disable traffic capture of the endpoint.
+   *
+   * Operations of all endpoints are captured while the worker captures traffic, see
+   * `ucxx::Worker::startTrafficCapture()`, disabling capture excludes the operations of
+   * this endpoint from the trace, e.g., those of an out-of-band control connection that
+   * is not part of the workload being replayed.
+   *
+   * @param[in] enable  whether to capture the operations of the endpoint.
+   */
+  void setTrafficCaptureEnabled(bool enable);
+
+  /**
+   * @brief Inquire if traffic capture of the endpoint is enabled.
+   *
+   * @returns Whether traffic capture is enabled, see `setTrafficCaptureEnabled()`.
+   */
+  bool isTrafficCaptureEnabled() const;
+
+  /**
+   * @brief Prepost the header receive of the next multi-buffer tag message.
+   *
+   * Post the receive of the first header of the next multi-buffer tag message with `tag`
+   * and `tagMask` if preposting is enabled and no header receive with them is already
+   * preposted. Called by multi-buffer tag receives once all frame receives were posted.
+   *
+   * WARNING: This is not intended to be called by the user, but it currently needs to be
+   * a public method so that requests may access it.
+   *
+   * @param[in] tag       the tag to match.
+   * @param[in] tagMask   the tag mask to use.
+   */
+  void prepostTagMultiHeader(Tag tag, TagMask tagMask);
+
+  /**
+   * @brief Take the preposted header receive of a multi-buffer tag message.
+   *
+   * Take the header receive preposted with `tag` and `tagMask`, if any, to be adopted by
+   * the calling multi-buffer tag receive.
+   *
+   * WARNING: This is not intended to be called by the user, but it currently needs to be
+   * a public method so that requests may access it.
+   *
+   * @param[in] tag       the tag to match.
+   * @param[in] tagMask   the tag mask to use.
+   *
+   * @returns The preposted header receive, or `nullptr` if none was preposted.
+   */
+  std::shared_ptr<internal::TagMultiPrepostedHeader> takeTagMultiPrepostedHeader(
+    Tag tag, TagMask tagMask);
+
   /**
    * @brief Enqueue an active message send operation.
    *
@@ -300,6 +887,11 @@ class Endpoint : public Component {
    * Python future is requested, the Python application must then await on this future to
    * ensure the transfer has completed. Requires UCXX Python support.
    *
+   * An opaque user-defined `header` may be sent as part of the same active message, the
+   * receiver may then access it via the receive request's `getRecvHeader()` method. This
+   * allows sending small control messages, or metadata describing the payload, without
+   * additional messages or copies.
+   *
    * @param[in] buffer              a raw pointer to the data to be sent.
    * @param[in] length              the size in bytes of the tag message to be sent.
    * @param[in] memoryType          the memory type of the buffer.
@@ -307,6 +899,14 @@ class Endpoint : public Component {
    *                                subsequently notified.
    * @param[in] callbackFunction    user-defined callback function to call upon completion.
    * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   * @param[in] header              opaque user-defined header to send with the message.
+   * @param[in] amId                the active message ID to send to, must be registered
+   *                                with the remote worker.
+   * @param[in] memoryHandle        the registered memory containing the buffer, or `nullptr`
+   *                                to let UCX look up or register it.
+   * @param[in] readiness           whether the buffer is ready to be sent, e.g., from
+   *                                `ucxx::utils::cudaEventReadiness()`, deferring the
+   *                                submission until it is, or `nullptr` if it already is.
    *
    * @returns Request to be subsequently checked for the completion and its state.
    */
@@ -315,17 +915,21 @@ class Endpoint : public Component {
                                   ucs_memory_type_t memoryType,
                                   const bool enablePythonFuture                = false,
                                   RequestCallbackUserFunction callbackFunction = nullptr,
-                                  RequestCallbackUserData callbackData         = nullptr);
+                                  RequestCallbackUserData callbackData         = nullptr,
+                                  const std::string& header                    = {},
+                                  const unsigned int amId                      = 0,
+                                  std::shared_ptr<MemoryHandle> memoryHandle   = nullptr,
+                                  RequestReadinessCallback readiness           = nullptr);
 
   /**
    * @brief Enqueue an active message receive operation.
    *
    * Enqueue an active message receive operation, returning a
    * `std::shared_ptr<ucxx::Request>` that can be later awaited and checked for errors,
-   * making data available via the return value's `getRecvBuffer()` method once the
-   * operation completes successfully. This is a non-blocking operation, and the status of
-   * the transfer must be verified from the resulting request object before the data can be
-   * consumed.
+   * making data available via the return value's `getRecvBuffer()` method, and the
+   * user-defined header via `getRecvHeader()`, once the operation completes successfully.
+   * This is a non-blocking operation, and the status of the transfer must be verified from
+   * the resulting request object before the data can be consumed.
    *
    * Using a Python future may be requested by specifying `enablePythonFuture`. If a
    * Python future is requested, the Python application must then await on this future to
@@ -335,12 +939,217 @@ class Endpoint : public Component {
    *                                subsequently notified.
    * @param[in] callbackFunction    user-defined callback function to call upon completion.
    * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   * @param[in] amId                the active message ID to receive from, must be
+   *                                registered with the local worker without a receiver
+   *                                callback.
    *
    * @returns Request to be subsequently checked for the completion state and data.
    */
   std::shared_ptr<Request> amRecv(const bool enablePythonFuture                = false,
                                   RequestCallbackUserFunction callbackFunction = nullptr,
-                                  RequestCallbackUserData callbackData         = nullptr);
+                                  RequestCallbackUserData callbackData         = nullptr,
+                                  const unsigned int amId                      = 0);
+
+  /**
+   * @brief Enqueue a remote memory put operation.
+   *
+   * Enqueue a one-sided remote memory access (RMA) put operation, writing `length` bytes
+   * from `buffer` to `remoteAddr` in the remote memory described by `remoteKey`, returning
+   * a `std::shared_ptr<ucxx::Request>` that can be later awaited and checked for errors.
+   * This is a non-blocking operation, and the status of the transfer must be verified from
+   * the resulting request object before the data can be released. The remote process is
+   * not involved in the transfer, and completion of the request does not guarantee the
+   * data is visible in the remote memory.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the transfer has completed. Requires UCXX Python support.
+   *
+   * @throws std::runtime_error if `remoteKey` was not unpacked on this endpoint, or if the
+   *                            remote memory range is not contained in `remoteKey`.
+   *
+   * @param[in] buffer              a raw pointer to the data to be put.
+   * @param[in] length              the size in bytes of the data to be put.
+   * @param[in] remoteAddr          the remote address where to put the data.
+   * @param[in] remoteKey           the remote key unpacked on this endpoint.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   * @param[in] memoryHandle        the registered memory containing the buffer, or `nullptr`
+   *                                to let UCX look up or register it.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> memPut(void* buffer,
+                                  size_t length,
+                                  uint64_t remoteAddr,
+                                  std::shared_ptr<RemoteKey> remoteKey,
+                                  const bool enablePythonFuture                = false,
+                                  RequestCallbackUserFunction callbackFunction = nullptr,
+                                  RequestCallbackUserData callbackData         = nullptr,
+                                  std::shared_ptr<MemoryHandle> memoryHandle   = nullptr);
+
+  /**
+   * @brief Enqueue a remote memory get operation.
+   *
+   * Enqueue a one-sided remote memory access (RMA) get operation, reading `length` bytes
+   * from `remoteAddr` in the remote memory described by `remoteKey` into `buffer`,
+   * returning a `std::shared_ptr<ucxx::Request>` that can be later awaited and checked for
+   * errors. This is a non-blocking operation, and the status of the transfer must be
+   * verified from the resulting request object before the data can be consumed. The remote
+   * process is not involved in the transfer.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the transfer has completed. Requires UCXX Python support.
+   *
+   * @throws std::runtime_error if `remoteKey` was not unpacked on this endpoint, or if the
+   *                            remote memory range is not contained in `remoteKey`.
+   *
+   * @param[in] buffer              a raw pointer to pre-allocated memory where resulting
+   *                                data will be stored.
+   * @param[in] length              the size in bytes of the data to be fetched.
+   * @param[in] remoteAddr          the remote address from where to get the data.
+   * @param[in] remoteKey           the remote key unpacked on this endpoint.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   * @param[in] memoryHandle        the registered memory containing the buffer, or `nullptr`
+   *                                to let UCX look up or register it.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> memGet(void* buffer,
+                                  size_t length,
+                                  uint64_t remoteAddr,
+                                  std::shared_ptr<RemoteKey> remoteKey,
+                                  const bool enablePythonFuture                = false,
+                                  RequestCallbackUserFunction callbackFunction = nullptr,
+                                  RequestCallbackUserData callbackData         = nullptr,
+                                  std::shared_ptr<MemoryHandle> memoryHandle   = nullptr);
+
+  /**
+   * @brief Enqueue a remote memory atomic operation.
+   *
+   * Enqueue a one-sided atomic operation on the 64-bit value at `remoteAddr` in the remote
+   * memory described by `remoteKey`, returning a `std::shared_ptr<ucxx::Request>` that can
+   * be later awaited and checked for errors. If `fetch` is `true`, the original remote
+   * value is available via the return value's `getAtomicResult()` method once the
+   * operation completes successfully. The remote process is not involved in the operation.
+   *
+   * @code{.cpp}
+   * // ep is `std::shared_ptr<ucxx::Endpoint>`, rkey is `std::shared_ptr<ucxx::RemoteKey>`
+   * auto addr = rkey->getBaseAddress();
+   *
+   * // Fetch-and-add 1
+   * auto fetchAdd = ep->memAtomic(UCP_ATOMIC_OP_ADD, 1, addr, rkey, true);
+   *
+   * // Compare-and-swap, replacing 0 with 1
+   * auto cswap = ep->memAtomic(UCP_ATOMIC_OP_CSWAP, 1, addr, rkey, true, 0);
+   * @endcode
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the operation has completed. Requires UCXX Python support.
+   *
+   * @throws std::runtime_error if `remoteKey` was not unpacked on this endpoint, or if the
+   *                            remote operand is not contained in `remoteKey`.
+   *
+   * @param[in] opcode              the atomic operation to execute.
+   * @param[in] value               the operand of the atomic operation, the value to swap
+   *                                in for `UCP_ATOMIC_OP_SWAP` and `UCP_ATOMIC_OP_CSWAP`.
+   * @param[in] remoteAddr          the remote address of the 64-bit remote operand.
+   * @param[in] remoteKey           the remote key unpacked on this endpoint.
+   * @param[in] fetch               whether to fetch the original remote value, always
+   *                                fetched for `UCP_ATOMIC_OP_SWAP` and
+   *                                `UCP_ATOMIC_OP_CSWAP`.
+   * @param[in] compare             the value to compare the remote value to, only used for
+   *                                `UCP_ATOMIC_OP_CSWAP`.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> memAtomic(ucp_atomic_op_t opcode,
+                                     uint64_t value,
+                                     uint64_t remoteAddr,
+                                     std::shared_ptr<RemoteKey> remoteKey,
+                                     const bool fetch                             = false,
+                                     const uint64_t compare                       = 0,
+                                     const bool enablePythonFuture                = false,
+                                     RequestCallbackUserFunction callbackFunction = nullptr,
+                                     RequestCallbackUserData callbackData         = nullptr);
+
+  /**
+   * @brief Enqueue a flush of the endpoint.
+   *
+   * Enqueue a flush of all operations previously issued on the endpoint, returning a
+   * `std::shared_ptr<ucxx::Request>` that completes once those operations are completed
+   * both locally and remotely, e.g., once data of previous `memPut()` operations is
+   * visible in the remote memory. Unlike `close()`, the endpoint remains usable.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the flush has completed. Requires UCXX Python support.
+   *
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> flush(const bool enablePythonFuture                = false,
+                                 RequestCallbackUserFunction callbackFunction = nullptr,
+                                 RequestCallbackUserData callbackData         = nullptr);
+
+  /**
+   * @brief Enqueue a non-blocking close of the endpoint.
+   *
+   * Enqueue closing the endpoint, returning a `std::shared_ptr<ucxx::Request>` that
+   * completes once the UCP endpoint is closed. Unlike `close()`, this method never blocks
+   * the caller, which allows closing many endpoints concurrently instead of serially, see
+   * also `ucxx::Worker::closeEndpoints()`. All inflight requests of the endpoint are
+   * canceled, and the user-defined callback registered with `setCloseCallback()`, if any,
+   * is executed before the request completes. Once the close is submitted the endpoint
+   * can't be used to create new requests and `close()` becomes a no-op.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the close has completed. Requires UCXX Python support.
+   *
+   * @throws ucxx::Error  if the endpoint is already closed.
+   *
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> closeAsync(const bool enablePythonFuture                = false,
+                                      RequestCallbackUserFunction callbackFunction = nullptr,
+                                      RequestCallbackUserData callbackData         = nullptr);
+
+  /**
+   * @brief Unpack a serialized remote key for use with this endpoint.
+   *
+   * Unpack a remote key serialized with `ucxx::RemoteKey::serialize()` by the remote
+   * process to which this endpoint is connected, so that it may be used with `memPut()`
+   * and `memGet()`. The endpoint will not be destroyed until the remote key is destroyed.
+   *
+   * @throws std::runtime_error if the serialized remote key is malformed.
+   * @throws ucxx::Error        if the remote key could not be unpacked.
+   *
+   * @param[in] serializedRemoteKey the serialized remote key.
+   *
+   * @returns The unpacked `std::shared_ptr<ucxx::RemoteKey>`.
+   */
+  std::shared_ptr<RemoteKey> createRemoteKeyFromSerialized(const std::string& serializedRemoteKey);
 
   /**
    * @brief Enqueue a stream send operation.
@@ -363,6 +1172,34 @@ class Endpoint : public Component {
    */
   std::shared_ptr<Request> streamSend(void* buffer, size_t length, const bool enablePythonFuture);
 
+  /**
+   * @brief Enqueue a vectored stream send operation.
+   *
+   * Enqueue a vectored (IOV) stream send operation, returning a
+   * `std::shared<ucxx::Request>` that can be later awaited and checked for errors. All
+   * buffers are gathered by UCX into a single stream message in the order they are
+   * specified, without staging copies nor one request per buffer. This is a non-blocking
+   * operation, and the status of the transfer must be verified from the resulting request
+   * object before the data can be released.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the transfer has completed. Requires UCXX Python support.
+   *
+   * @throws  std::runtime_error  if sizes of `buffer` and `length` do not match, or if
+   *                              the total length is zero.
+   *
+   * @param[in] buffer              raw pointers to the data to be sent.
+   * @param[in] length              the size in bytes of each of the buffers to be sent.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> streamSendIov(const std::vector<void*>& buffer,
+                                         const std::vector<size_t>& length,
+                                         const bool enablePythonFuture = false);
+
   /**
    * @brief Enqueue a stream receive operation.
    *
@@ -385,6 +1222,51 @@ class Endpoint : public Component {
    */
   std::shared_ptr<Request> streamRecv(void* buffer, size_t length, const bool enablePythonFuture);
 
+  /**
+   * @brief Enqueue a partial stream receive operation.
+   *
+   * Enqueue a stream receive operation that completes as soon as any data is available,
+   * receiving up to `length` bytes instead of waiting for all of them to arrive. The number
+   * of bytes received is then available with `getRecvLength()` on the resulting request,
+   * allowing data to be consumed as it arrives.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the transfer has completed. Requires UCXX Python support.
+   *
+   * @code{.cpp}
+   * // `endpoint` is `std::shared_ptr<ucxx::Endpoint>`
+   * auto request = endpoint->streamRecvPartial(buffer, bufferSize);
+   * // ... wait for `request` to complete
+   * consume(buffer, request->getRecvLength());
+   * @endcode
+   *
+   * @param[in] buffer              a raw pointer to pre-allocated memory where resulting
+   *                                data will be stored.
+   * @param[in] length              the maximum size in bytes to be received.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   *
+   * @returns Request to be subsequently checked for the completion, its state and length.
+   */
+  std::shared_ptr<Request> streamRecvPartial(void* buffer,
+                                             size_t length,
+                                             const bool enablePythonFuture = false);
+
+  /**
+   * @brief Receive stream data available without copying.
+   *
+   * Get data already received by the endpoint directly from UCX internal buffers with
+   * `ucp_stream_recv_data_nb`, without posting a request nor copying it to a user buffer,
+   * allowing consumers to begin parsing as soon as data lands. The data remains valid until
+   * the returned object is released or destroyed. This is a non-blocking operation.
+   *
+   * @throws ucxx::Error  if the endpoint is closed or receiving fails.
+   *
+   * @returns The data received, or `nullptr` if no data is currently available.
+   */
+  std::shared_ptr<StreamData> streamRecvData();
+
   /**
    * @brief Enqueue a tag send operation.
    *
@@ -404,6 +1286,11 @@ class Endpoint : public Component {
    *                                subsequently notified.
    * @param[in] callbackFunction    user-defined callback function to call upon completion.
    * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   * @param[in] memoryHandle        the registered memory containing the buffer, or `nullptr`
+   *                                to let UCX look up or register it.
+   * @param[in] readiness           whether the buffer is ready to be sent, e.g., from
+   *                                `ucxx::utils::cudaEventReadiness()`, deferring the
+   *                                submission until it is, or `nullptr` if it already is.
    *
    * @returns Request to be subsequently checked for the completion and its state.
    */
@@ -412,7 +1299,9 @@ class Endpoint : public Component {
                                    Tag tag,
                                    const bool enablePythonFuture                = false,
                                    RequestCallbackUserFunction callbackFunction = nullptr,
-                                   RequestCallbackUserData callbackData         = nullptr);
+                                   RequestCallbackUserData callbackData         = nullptr,
+                                   std::shared_ptr<MemoryHandle> memoryHandle   = nullptr,
+                                   RequestReadinessCallback readiness           = nullptr);
 
   /**
    * @brief Enqueue a tag receive operation.
@@ -435,6 +1324,8 @@ class Endpoint : public Component {
    *                                subsequently notified.
    * @param[in] callbackFunction    user-defined callback function to call upon completion.
    * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   * @param[in] memoryHandle        the registered memory containing the buffer, or `nullptr`
+   *                                to let UCX look up or register it.
    *
    * @returns Request to be subsequently checked for the completion and its state.
    */
@@ -444,7 +1335,158 @@ class Endpoint : public Component {
                                    TagMask tagMask,
                                    const bool enablePythonFuture                = false,
                                    RequestCallbackUserFunction callbackFunction = nullptr,
-                                   RequestCallbackUserData callbackData         = nullptr);
+                                   RequestCallbackUserData callbackData         = nullptr,
+                                   std::shared_ptr<MemoryHandle> memoryHandle   = nullptr);
+
+  /**
+   * @brief Enqueue a vectored tag send operation.
+   *
+   * Enqueue a vectored (IOV) tag send operation, returning a `std::shared<ucxx::Request>`
+   * that can be later awaited and checked for errors. All buffers are gathered by UCX into
+   * a single tag message in the order they are specified, e.g., a header and its payload
+   * can be sent without staging them into a contiguous buffer, and matched only once by
+   * the receiver. The message may be received by either `tagRecv()` or `tagRecvIov()`.
+   * This is a non-blocking operation, and the status of the transfer must be verified
+   * from the resulting request object before the data can be released.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the transfer has completed. Requires UCXX Python support.
+   *
+   * @throws  std::runtime_error  if sizes of `buffer` and `length` do not match.
+   *
+   * @param[in] buffer              raw pointers to the data to be sent.
+   * @param[in] length              the size in bytes of each of the buffers to be sent.
+   * @param[in] tag                 the tag to match.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   * @param[in] readiness           whether the buffers are ready to be sent, deferring the
+   *                                submission until they are, or `nullptr` if they already
+   *                                are.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> tagSendIov(const std::vector<void*>& buffer,
+                                      const std::vector<size_t>& length,
+                                      Tag tag,
+                                      const bool enablePythonFuture                = false,
+                                      RequestCallbackUserFunction callbackFunction = nullptr,
+                                      RequestCallbackUserData callbackData         = nullptr,
+                                      RequestReadinessCallback readiness           = nullptr);
+
+  /**
+   * @brief Enqueue a vectored tag receive operation.
+   *
+   * Enqueue a vectored (IOV) tag receive operation, returning a
+   * `std::shared<ucxx::Request>` that can be later awaited and checked for errors. A single
+   * tag message is scattered by UCX into all buffers in the order they are specified,
+   * which may have been sent by either `tagSend()` or `tagSendIov()`. This is a
+   * non-blocking operation, and the status of the transfer must be verified from the
+   * resulting request object before the data can be consumed.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the transfer has completed. Requires UCXX Python support.
+   *
+   * @throws  std::runtime_error  if sizes of `buffer` and `length` do not match.
+   *
+   * @param[in] buffer              raw pointers to pre-allocated memory where resulting
+   *                                data will be stored.
+   * @param[in] length              the size in bytes of each of the buffers.
+   * @param[in] tag                 the tag to match.
+   * @param[in] tagMask             the tag mask to use.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> tagRecvIov(const std::vector<void*>& buffer,
+                                      const std::vector<size_t>& length,
+                                      Tag tag,
+                                      TagMask tagMask                              = TagMaskFull,
+                                      const bool enablePythonFuture                = false,
+                                      RequestCallbackUserFunction callbackFunction = nullptr,
+                                      RequestCallbackUserData callbackData         = nullptr);
+
+  /**
+   * @brief Enqueue a batch of tag send operations.
+   *
+   * Enqueue a batch of tag send operations, returning one `std::shared<ucxx::Request>` per
+   * message that can be later awaited and checked for errors. Each message is sent as an
+   * independent tag message, exactly as if `tagSend()` had been called for each one of
+   * them, but all requests are registered under a single inflight requests lock and, if
+   * delayed submission is enabled, submitted as a single delayed submission item that
+   * wakes the worker only once. This is a non-blocking operation, and the status of the
+   * transfers must be verified from the resulting request objects before the data can be
+   * released.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`, in which
+   * case one future is created for each request. Requires UCXX Python support.
+   *
+   * @throws  std::runtime_error  if sizes of `buffer`, `length` and `tag` do not match.
+   *
+   * @param[in] buffer              raw pointers to the data to be sent.
+   * @param[in] length              the size in bytes of each tag message to be sent.
+   * @param[in] tag                 the tag of each message.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified for each request.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion
+   *                                of each request.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   *
+   * @returns Requests to be subsequently checked for the completion and their states, in
+   *          the same order as the input messages.
+   */
+  std::vector<std::shared_ptr<Request>> tagSendBatch(
+    const std::vector<void*>& buffer,
+    const std::vector<size_t>& length,
+    const std::vector<Tag>& tag,
+    const bool enablePythonFuture                = false,
+    RequestCallbackUserFunction callbackFunction = nullptr,
+    RequestCallbackUserData callbackData         = nullptr);
+
+  /**
+   * @brief Enqueue a batch of tag receive operations.
+   *
+   * Enqueue a batch of tag receive operations, returning one `std::shared<ucxx::Request>`
+   * per message that can be later awaited and checked for errors. Each message is received
+   * independently, exactly as if `tagRecv()` had been called for each one of them, but all
+   * requests are registered under a single inflight requests lock and, if delayed
+   * submission is enabled, submitted as a single delayed submission item that wakes the
+   * worker only once. This is a non-blocking operation, and the status of the transfers
+   * must be verified from the resulting request objects before the data can be consumed.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`, in which
+   * case one future is created for each request. Requires UCXX Python support.
+   *
+   * @throws  std::runtime_error  if sizes of `buffer`, `length` and `tag` do not match.
+   *
+   * @param[in] buffer              raw pointers to pre-allocated memory where resulting
+   *                                data will be stored.
+   * @param[in] length              the size in bytes of each tag message to be received.
+   * @param[in] tag                 the tag to match for each message.
+   * @param[in] tagMask             the tag mask to use for all messages.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified for each request.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion
+   *                                of each request.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   *
+   * @returns Requests to be subsequently checked for the completion and their states, in
+   *          the same order as the input messages.
+   */
+  std::vector<std::shared_ptr<Request>> tagRecvBatch(
+    const std::vector<void*>& buffer,
+    const std::vector<size_t>& length,
+    const std::vector<Tag>& tag,
+    const TagMask tagMask                        = TagMaskFull,
+    const bool enablePythonFuture                = false,
+    RequestCallbackUserFunction callbackFunction = nullptr,
+    RequestCallbackUserData callbackData         = nullptr);
 
   /**
    * @brief Enqueue a multi-buffer tag send operation.
@@ -461,6 +1503,13 @@ class Endpoint : public Component {
    * (depending on the number of frames being transferred), followed by one `tagSend` for
    * each data frame.
    *
+   * If `packThreshold` is non-zero, all host frames of up to `packThreshold` bytes are
+   * instead packed into a single vectored `tagSendIov` message, which saves the matching
+   * and completion costs of one message per frame when sending many small frames. Large
+   * and CUDA frames are still sent as one message each. Packed frames are flagged in the
+   * header, which is otherwise unchanged, therefore any receiver understands messages sent
+   * without packing, but packing should only be enabled if the receiver supports it.
+   *
    * Using a Python future may be requested by specifying `enablePythonFuture`. If a
    * Python future is requested, the Python application must then await on this future to
    * ensure the transfer has completed. Requires UCXX Python support.
@@ -476,6 +1525,12 @@ class Endpoint : public Component {
    * @param[in] tag                 the tag to match.
    * @param[in] enablePythonFuture  whether a python future should be created and
    *                                subsequently notified.
+   * @param[in] packThreshold       the size in bytes of the largest host frame to pack
+   *                                into a single message, `0` disables packing.
+   * @param[in] readiness           whether the frames are ready to be sent, e.g., from
+   *                                `ucxx::utils::cudaEventReadiness()`, deferring the
+   *                                submission of frames until they are, or `nullptr` if
+   *                                they already are. Headers are sent immediately.
    *
    * @returns Request to be subsequently checked for the completion and its state.
    */
@@ -483,7 +1538,9 @@ class Endpoint : public Component {
                                         const std::vector<size_t>& size,
                                         const std::vector<int>& isCUDA,
                                         const Tag tag,
-                                        const bool enablePythonFuture);
+                                        const bool enablePythonFuture,
+                                        const size_t packThreshold         = 0,
+                                        RequestReadinessCallback readiness = nullptr);
 
   /**
    * @brief Enqueue a multi-buffer tag receive operation.
@@ -500,16 +1557,94 @@ class Endpoint : public Component {
    * Python future is requested, the Python application must then await on this future to
    * ensure the transfer has completed. Requires UCXX Python support.
    *
+   * A custom `allocator` may be specified to receive frames directly into user-provided
+   * buffers, e.g., pre-allocated or from a memory pool, instead of internally allocated
+   * ones. It is called once all headers are received with the size and CUDA flag of each
+   * frame, and must return one buffer per frame of at least its size. If the allocator
+   * throws or does not return a valid buffer for each frame, the frames are received into
+   * internal buffers and discarded, and the request completes with `UCS_ERR_INVALID_PARAM`.
+   *
    * @param[in] tag                 the tag to match.
    * @param[in] tagMask             the tag mask to use.
    * @param[in] enablePythonFuture  whether a python future should be created and
    *                                subsequently notified.
+   * @param[in] allocator           allocator of the buffers to receive frames into,
+   *                                `nullptr` allocates them internally.
    *
    * @returns Request to be subsequently checked for the completion and its state.
    */
   std::shared_ptr<Request> tagMultiRecv(const Tag tag,
                                         const TagMask tagMask,
-                                        const bool enablePythonFuture);
+                                        const bool enablePythonFuture,
+                                        TagMultiRecvAllocatorType allocator = nullptr);
+
+  /**
+   * @brief Enqueue a file send operation.
+   *
+   * Enqueue the send of the file at `path` in chunks of `chunkSize` bytes, returning a
+   * `std::shared<ucxx::RequestFile>` that can be later awaited and checked for errors. A
+   * header with the file and chunk sizes is sent first, followed by each chunk, all with
+   * `tag`, and must be received with `fileRecv()`. Chunks are read into a ring of
+   * `numBuffers` registered buffers and sent as soon as read, reading the next chunk into a
+   * buffer once the send of its previous chunk completes, so that reading from disk
+   * overlaps with the transfers and at most `numBuffers` chunks are held in memory.
+   *
+   * This is a non-blocking operation, chunks are read by a helper thread owned by the
+   * request rather than by the thread progressing the worker, and the file must not be
+   * modified until the request completes.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the transfer has completed. Requires UCXX Python support.
+   *
+   * @throws std::invalid_argument  if `chunkSize` or `numBuffers` is zero.
+   * @throws std::ios_base::failure if the file could not be opened.
+   *
+   * @param[in] path                path of the file to send.
+   * @param[in] tag                 the tag to match.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   * @param[in] chunkSize           the size in bytes of each chunk read and sent.
+   * @param[in] numBuffers          the number of chunk buffers, thus the maximum number of
+   *                                chunks in flight.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> fileSend(const std::string& path,
+                                    const Tag tag,
+                                    const bool enablePythonFuture = false,
+                                    const size_t chunkSize        = 4 << 20,
+                                    const size_t numBuffers       = 4);
+
+  /**
+   * @brief Enqueue a file receive operation.
+   *
+   * Enqueue the receive of a file sent with `fileSend()` into the file at `path`, which is
+   * created or truncated immediately, returning a `std::shared<ucxx::RequestFile>` that can
+   * be later awaited and checked for errors. Once the header is received, the file is
+   * resized and memory-mapped, and chunks are received directly into the mapping, with at
+   * most `numBuffers` chunk receives in flight. The contents of the file are only complete
+   * once the request completed successfully.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the transfer has completed. Requires UCXX Python support.
+   *
+   * @throws std::invalid_argument  if `numBuffers` is zero.
+   * @throws std::ios_base::failure if the file could not be opened.
+   *
+   * @param[in] path                path of the file to write.
+   * @param[in] tag                 the tag to match.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   * @param[in] numBuffers          the maximum number of chunk receives in flight.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> fileRecv(const std::string& path,
+                                    const Tag tag,
+                                    const bool enablePythonFuture = false,
+                                    const size_t numBuffers       = 4);
 
   /**
    * @brief Get `ucxx::Worker` component from a worker or listener object.
@@ -521,7 +1656,76 @@ class Endpoint : public Component {
    *
    * @returns The `std::shared_ptr<ucxx::Worker>` which the endpoint is associated with.
    */
-  std::shared_ptr<Worker> getWorker();
+  const std::shared_ptr<Worker>& getWorker() const;
+
+  /**
+   * @brief Get the component as a `ucxx::Endpoint`.
+   *
+   * @returns The non-owning pointer to this endpoint.
+   */
+  Endpoint* asEndpoint() noexcept override;
+
+  /**
+   * @brief Get a snapshot of the endpoint statistics.
+   *
+   * Get a snapshot of the counters of requests created by the endpoint, the same requests
+   * are also accounted for in the statistics of the worker, see
+   * `ucxx::Worker::getStatistics()`.
+   *
+   * @returns The snapshot of the endpoint statistics.
+   */
+  EndpointStatistics getStatistics() const;
+
+  /**
+   * @brief Get information about the underlying `ucp_ep_h` object.
+   *
+   * Convenience wrapper for `ucp_ep_print_info()` to get information about the underlying
+   * UCP endpoint handle, including the configuration of its lanes, and return it as a
+   * string.
+   *
+   * @returns String containing information about the UCP endpoint.
+   */
+  std::string getInfo();
+
+  /**
+   * @brief Get the transports selected for the endpoint lanes.
+   *
+   * Get the transport and device selected by UCX for each lane of the endpoint, as
+   * reported by `ucp_ep_query()`. Lanes may be reconfigured by UCX while the endpoint is
+   * being connected, thus the transports should be queried once the endpoint is
+   * connected, for example after a message was exchanged with the remote endpoint.
+   *
+   * @throws ucxx::Error if the endpoint is closed or querying it failed.
+   *
+   * @returns The transports of each lane of the endpoint.
+   */
+  std::vector<EndpointTransport> getTransports();
+
+  /**
+   * @brief Check whether the endpoint connects to a peer on the same host.
+   *
+   * Check whether any lane of the endpoint uses an intra-node transport, i.e., shared
+   * memory (`sysv`, `posix`, `cma`, `knem`, `xpmem`), CUDA IPC (`cuda_ipc`) or loopback
+   * (`self`), implying the remote endpoint is on the same host, see `getTransports()`.
+   *
+   * @returns `true` if the endpoint uses an intra-node transport, `false` otherwise.
+   */
+  bool isIntraNode();
+
+  /**
+   * @brief Check whether the endpoint uses any of the given transports.
+   *
+   * Check whether any lane of the endpoint uses one of the transports in `transportNames`,
+   * as reported by `getTransports()`, for example `{"tcp"}` to identify endpoints
+   * communicating over TCP. An empty `transportNames` matches any endpoint.
+   *
+   * @throws ucxx::Error if the endpoint is closed or querying it failed.
+   *
+   * @param[in] transportNames  the names of the transports to look for.
+   *
+   * @returns `true` if the endpoint uses any of the transports, `false` otherwise.
+   */
+  bool usesTransport(const std::vector<std::string>& transportNames);
 
   /**
    * @brief The error callback registered at endpoint creation time.
@@ -552,13 +1756,27 @@ class Endpoint : public Component {
    * `~Endpoint()` will call this method for which we can't release the GIL when the garbage
    * collector runs and destroys the object.
    *
-   * @param[in] period      maximum period to wait for a generic pre/post progress thread
-   *                        operation will wait for.
-   * @param[in] maxAttempts maximum number of attempts to close endpoint, only applicable
-   *                        if worker is running a progress thread and `period > 0`.
-   *
+   * With `ucxx::EndpointCloseMode::Force` (default) all inflight requests are canceled and
+   * the endpoint is closed immediately. With `ucxx::EndpointCloseMode::Flush` the endpoint
+   * is first flushed to let inflight send and remote memory access operations complete
+   * and then closed with `UCP_EP_CLOSE_MODE_FLUSH`, notifying the remote endpoint. If the
+   * flush doesn't complete within `flushTimeout` nanoseconds, or if the endpoint has
+   * errored, the close falls back to `ucxx::EndpointCloseMode::Force`. Inflight receive
+   * operations are canceled in both modes, as remote endpoints may never send them.
+   *
+   * @param[in] period        maximum period to wait for a generic pre/post progress thread
+   *                          operation will wait for.
+   * @param[in] maxAttempts   maximum number of attempts to close endpoint, only applicable
+   *                          if worker is running a progress thread and `period > 0`.
+   * @param[in] mode          the mode to close the endpoint with.
+   * @param[in] flushTimeout  maximum period in nanoseconds to wait for the flush to
+   *                          complete before forcing the close, only applicable if
+   *                          `mode` is `ucxx::EndpointCloseMode::Flush`.
    */
-  void close(uint64_t period = 0, uint64_t maxAttempts = 1);
+  void close(uint64_t period        = 0,
+             uint64_t maxAttempts   = 1,
+             EndpointCloseMode mode = EndpointCloseMode::Force,
+             uint64_t flushTimeout  = 10000000000 /* 10s */);
 };
 
 }  // namespace ucxx
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -13,29 +14,61 @@ namespace ucxx {
 const size_t HeaderFramesSize =
   100;  ///< The number of buffers contained in a single `ucxx::Header` object.
 
+const int HeaderFramePacked =
+  2;  ///< `ucxx::Header::isCUDA` value of a host frame packed into the single IOV message.
+
+/**
+ * @brief The format a `ucxx::Header` is serialized in.
+ */
+enum class HeaderFormat : uint8_t {
+  Legacy = 0,  ///< The fixed-size format understood by all peers
+  Compact,     ///< The compact variable-length format, requires peers supporting it
+};
+
 /**
  * @brief A serializable object containing metadata of multiple buffers.
  *
  * A serializable object containing metadata of a pre-defined number of buffers used to
  * inform the remote endpoint of multiple incoming messages from buffers of given
  * properties.
+ *
+ * Headers are serialized in the legacy fixed-size format by default, which is understood
+ * by all peers. They may instead be serialized in a compact variable-length format, where
+ * the frame sizes are varint-encoded and the frame types stored in bitmaps, thus the
+ * serialized size is proportional to the number of frames it contains. The compact format
+ * is versioned and deserialization accepts both formats, but peers predating it only parse
+ * the legacy format, thus it must only be used when all peers support it, see
+ * `ucxx::Worker::setCompactHeaders()`.
+ *
+ * Frames may be compressed, in which case the header is flagged as containing compressed
+ * frames and carries the `ucxx::CompressionCodec` they were compressed with, informing
+ * the receiver the frame is sent as `compressedSize` bytes that must be decompressed
+ * into `size` bytes. Compressed frames cannot be described by the legacy format, thus
+ * headers containing them are always serialized in the compact format.
  */
 class Header {
  private:
   /**
    * @brief Deserialize header.
    *
-   * Deserialize a fixed-size header from serialized data.
+   * Deserialize a header from serialized data in either the compact or legacy format.
    *
    * @param[in] serializedHeader  the header in serialized format.
+   * @param[in] length            the size in bytes of `serializedHeader`, which may be
+   *                              larger than the serialized header.
+   *
+   * @throws std::runtime_error if the serialized header is malformed.
    */
-  void deserialize(const std::string& serializedHeader);
+  void deserialize(const void* serializedHeader, const size_t length);
 
  public:
   bool next;                                  ///< Whether there is a next header
   size_t nframes;                             ///< Number of frames
-  std::array<int, HeaderFramesSize> isCUDA;   ///< Flag for whether each frame is CUDA or host
+  std::array<int, HeaderFramesSize> isCUDA;   ///< Whether each frame is CUDA, host or packed
   std::array<size_t, HeaderFramesSize> size;  ///< Size in bytes of each frame
+  std::array<size_t, HeaderFramesSize>
+    compressedSize;     ///< Size in bytes each frame is sent as, `0` if not compressed
+  uint8_t compression;  ///< The `ucxx::CompressionCodec` compressed frames are encoded with
 
   Header() = delete;
 
@@ -49,7 +82,10 @@ class Header {
    * receiver should expect is another header (in case the number of frames is larger than
    * the pre-defined size), the number of frames `nframes` it contains information for,
    * and pointers to `nframes` arrays of whether each frame is CUDA (`isCUDA == true`) or
-   * host (`isCUDA == false`) and the size `size` of each frame in bytes.
+   * host (`isCUDA == false`) and the size `size` of each frame in bytes. A host frame may
+   * also be marked as `isCUDA == HeaderFramePacked`, meaning it is not sent as a message of
+   * its own but packed together with all other such frames into a single vectored
+   * message, which is sent before all unpacked frames.
    *
    * @param[in] next    whether the receiver should expect a next header.
    * @param[in] nframes the number of frames the header contains information for (must be
@@ -58,8 +94,17 @@ class Header {
    *                    frames being transferred are CUDA (`true`) or host (`false`).
    * @param[in] size    array with length `nframes` containing the size in bytes of each
    *                    frame.
+   * @param[in] compressedSize  array with length `nframes` containing the size in bytes
+   *                            each frame is sent as once compressed, `0` for frames that
+   *                            are not compressed, or `nullptr` if none is.
+   * @param[in] compression     the `ucxx::CompressionCodec` of compressed frames.
    */
-  Header(bool next, size_t nframes, int* isCUDA, size_t* size);
+  Header(bool next,
+         size_t nframes,
+         int* isCUDA,
+         size_t* size,
+         size_t* compressedSize = nullptr,
+         uint8_t compression    = 0);
 
   /**
    * @brief Constructor of a fixed-size header from serialized data.
@@ -67,27 +112,76 @@ class Header {
    * Reconstruct (i.e., deserialize) a fixed-size header from serialized data.
    *
    * @param[in] serializedHeader  the header in serialized format.
+   *
+   * @throws std::runtime_error if the serialized header is malformed.
    */
   explicit Header(std::string serializedHeader);
 
   /**
-   * @brief Get the size of the underlying data.
+   * @brief Constructor of a fixed-size header from serialized data in raw memory.
+   *
+   * Reconstruct (i.e., deserialize) a fixed-size header from serialized data stored in
+   * raw memory, such as the buffer a header was received into, without copying it first.
+   *
+   * @param[in] serializedHeader  the header in serialized format.
+   * @param[in] length            the size in bytes of `serializedHeader`, which may be
+   *                              larger than the serialized header.
+   *
+   * @throws std::runtime_error if the serialized header is malformed.
+   */
+  Header(const void* serializedHeader, const size_t length);
+
+  /**
+   * @brief Get the maximum size of the underlying data.
    *
-   * Get the size of the underlying data, in other words, the size of a serialized
-   * `ucxx::Header` ready for transfer.
+   * Get the maximum size of the underlying data, in other words, the size of the largest
+   * serialized `ucxx::Header` in any supported format, which is the size a buffer must
+   * have to receive any header.
    *
-   * @returns the size of the underlying data.
+   * @returns the maximum size of the underlying data.
    */
   static size_t dataSize();
 
+  /**
+   * @brief Get the size of the serialized data.
+   *
+   * Get the size of this header when serialized in `format`, which in the compact format
+   * is often much smaller than `dataSize()`.
+   *
+   * @param[in] format  the format the header is serialized in.
+   *
+   * @returns the size in bytes of the serialized data.
+   */
+  size_t serializedSize(const HeaderFormat format = HeaderFormat::Legacy) const;
+
+  /**
+   * @brief Serialize into caller-provided storage.
+   *
+   * Serialize the header in `format` directly into caller-provided storage, which must be
+   * at least `serializedSize(format)` bytes long.
+   *
+   * @param[out] buffer  the storage where to write the serialized header.
+   * @param[in]  length  the size in bytes of `buffer`.
+   * @param[in]  format  the format to serialize the header in.
+   *
+   * @throws std::length_error if `buffer` is smaller than `serializedSize(format)`.
+   *
+   * @returns the number of bytes written to `buffer`.
+   */
+  size_t serialize(void* buffer,
+                   const size_t length,
+                   const HeaderFormat format = HeaderFormat::Legacy) const;
+
   /**
    * @brief Get the serialized data.
    *
-   * Get the serialized data ready for transfer.
+   * Get the data serialized in `format`, ready for transfer.
+   *
+   * @param[in] format  the format to serialize the header in.
    *
    * @returns the serialized data.
    */
-  const std::string serialize() const;
+  const std::string serialize(const HeaderFormat format = HeaderFormat::Legacy) const;
 
   /**
    * @brief Convenience method to build headers given arbitrary-sized input.
@@ -98,11 +192,23 @@ class Header {
    * @param[in] isCUDA  vector containing flag of whether each frame being transferred are
    *                    CUDA (`1`) or host (`0`).
    * @param[in] size    vector containing the size in bytes of eachf frame.
+   * @param[in] compressedSize  vector containing the size in bytes each frame is sent as
+   *                            once compressed, `0` for frames that are not compressed, or
+   *                            empty if none is.
+   * @param[in] compression     the `ucxx::CompressionCodec` of compressed frames.
+   *
+   * Headers with compressed frames may carry fewer than `HeaderFramesSize` frames, so
+   * that no serialized header exceeds `dataSize()`.
+   *
+   * @throws std::length_error if `size`, `isCUDA` and a non-empty `compressedSize` do not
+   *                           have the same length.
    *
    * @returns A vector of one or more `ucxx::Header` objects.
    */
   static std::vector<Header> buildHeaders(const std::vector<size_t>& size,
-                                          const std::vector<int>& isCUDA);
+                                          const std::vector<int>& isCUDA,
+                                          const std::vector<size_t>& compressedSize = {},
+                                          const uint8_t compression                 = 0);
 };
 
 }  // namespace ucxx
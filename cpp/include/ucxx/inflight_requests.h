@@ -4,29 +4,178 @@
  */
 #pragma once
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 namespace ucxx {
 
+class InflightRequestsList;
 class Request;
 
 /**
- * @brief An inflight request map.
+ * @brief Maximum number of inflight request lists a request can be tracked by.
  *
- * A map of inflight requests, where keys are a unique identifier of the request and
- * value is the reference-counted `ucxx::Request`.
+ * The maximum number of `ucxx::InflightRequestsList` objects a single request may be
+ * tracked by simultaneously, typically its parent endpoint and its worker.
  */
-typedef std::map<const Request* const, std::shared_ptr<Request>> InflightRequestsMap;
+constexpr size_t InflightRequestsMaxOwners = 2;
 
 /**
- * @brief Pre-defined type for a pointer to an inflight request map.
+ * @brief Intrusive hook to track a request in an inflight request list.
  *
- * A pre-defined type for a pointer to an inflight request map, used as a convenience type.
+ * Intrusive hook stored within each `ucxx::Request` allowing it to be linked into a
+ * `ucxx::InflightRequestsList` without additional allocations. While linked, the hook
+ * holds a reference to the request, keeping it alive until it is removed from the list.
  */
-typedef std::unique_ptr<InflightRequestsMap> InflightRequestsMapPtr;
+struct InflightRequestHook {
+  InflightRequestHook* prev{nullptr};                 ///< Previous hook in the list
+  InflightRequestHook* next{nullptr};                 ///< Next hook in the list
+  std::atomic<InflightRequestsList*> owner{nullptr};  ///< The list the hook is linked into
+  std::shared_ptr<Request> request{nullptr};          ///< Reference to the request while linked
+};
+
+/**
+ * @brief Pre-defined type for the hooks of a request.
+ *
+ * A pre-defined type for the container of all hooks of a request, one for each
+ * `ucxx::InflightRequestsList` the request may be tracked by simultaneously.
+ */
+typedef std::array<InflightRequestHook, InflightRequestsMaxOwners> InflightRequestHooks;
+
+/**
+ * @brief An inflight request list.
+ *
+ * An intrusive doubly-linked list of inflight requests, where each request stores its own
+ * `ucxx::InflightRequestHook` for each list it is tracked by. Insertion and removal are
+ * O(1) and allocation-free, iteration occurs in insertion order. The list is not
+ * thread-safe, access must be synchronized by its owner.
+ */
+class InflightRequestsList {
+ private:
+  InflightRequestHook* _head{nullptr};  ///< The first hook in the list
+  InflightRequestHook* _tail{nullptr};  ///< The last hook in the list
+  size_t _size{0};                      ///< The number of requests in the list
+
+  /**
+   * @brief Unlink a hook from the list.
+   *
+   * Unlink a hook from the list, returning the reference to the request it held.
+   *
+   * @param[in] hook  the hook to unlink, must currently be linked into this list.
+   *
+   * @returns The reference to the request the hook held.
+   */
+  std::shared_ptr<Request> unlink(InflightRequestHook* hook);
+
+ public:
+  InflightRequestsList() = default;
+
+  InflightRequestsList(const InflightRequestsList&)            = delete;
+  InflightRequestsList& operator=(InflightRequestsList const&) = delete;
+  InflightRequestsList(InflightRequestsList&& o)               = delete;
+  InflightRequestsList& operator=(InflightRequestsList&& o)    = delete;
+
+  /**
+   * @brief Destructor.
+   *
+   * Unlink all requests and drop the references held to them.
+   */
+  ~InflightRequestsList();
+
+  /**
+   * @brief Query the number of requests in the list.
+   *
+   * @returns The number of requests in the list.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Insert a request into the list.
+   *
+   * Link one of the request's free hooks into the list. Inserting a request that is
+   * already in the list is a no-op.
+   *
+   * @throws std::runtime_error if the request is already tracked by the maximum number of
+   *                            lists.
+   *
+   * @param[in] request the request to insert.
+   */
+  void insert(std::shared_ptr<Request> request);
+
+  /**
+   * @brief Remove a request from the list.
+   *
+   * Unlink the request from the list if it is linked into it, returning the reference
+   * that was held so that the caller may control when it is released (e.g., after
+   * releasing locks).
+   *
+   * @param[in] request raw pointer to the request.
+   *
+   * @returns The reference to the removed request or `nullptr` if the request is not in
+   *          the list.
+   */
+  std::shared_ptr<Request> remove(const Request* const request);
+
+  /**
+   * @brief Move all requests of another list to the end of this list.
+   *
+   * Move all requests of another list to the end of this list, leaving `other` empty.
+   *
+   * @param[in] other the list to move requests from.
+   */
+  void merge(InflightRequestsList& other);
+
+  /**
+   * @brief Call a function for each request in the list.
+   *
+   * @param[in] function  the callable to invoke for each request, receiving
+   *                      `const std::shared_ptr<Request>&` as argument.
+   */
+  template <typename F>
+  void forEach(F&& function) const
+  {
+    for (auto hook = _head; hook != nullptr; hook = hook->next)
+      function(hook->request);
+  }
+
+  /**
+   * @brief Remove requests satisfying a predicate.
+   *
+   * Remove all requests for which `predicate` returns `true`.
+   *
+   * @param[in] predicate the callable to invoke for each request, receiving
+   *                      `const std::shared_ptr<Request>&` as argument.
+   *
+   * @returns The number of requests removed.
+   */
+  template <typename P>
+  size_t removeIf(P&& predicate)
+  {
+    size_t removed = 0;
+    for (auto hook = _head; hook != nullptr;) {
+      auto next = hook->next;
+      if (predicate(hook->request)) {
+        unlink(hook);
+        ++removed;
+      }
+      hook = next;
+    }
+    return removed;
+  }
+};
+
+/**
+ * @brief Pre-defined type for a pointer to an inflight request list.
+ *
+ * A pre-defined type for a pointer to an inflight request list, used as a convenience type.
+ */
+typedef std::unique_ptr<InflightRequestsList> InflightRequestsListPtr;
 
 /**
  * @brief A container for the different types of tracked requests.
@@ -35,12 +184,12 @@ typedef std::unique_ptr<InflightRequestsMap> InflightRequestsMapPtr;
  * those still valid (inflight), and those scheduled for cancelation (canceling).
  */
 typedef struct TrackedRequests {
-  InflightRequestsMapPtr _inflight;   ///< Valid requests awaiting completion.
-  InflightRequestsMapPtr _canceling;  ///< Requests scheduled for cancelation.
+  InflightRequestsListPtr _inflight;   ///< Valid requests awaiting completion.
+  InflightRequestsListPtr _canceling;  ///< Requests scheduled for cancelation.
 
   TrackedRequests()
-    : _inflight(std::make_unique<InflightRequestsMap>()),
-      _canceling(std::make_unique<InflightRequestsMap>())
+    : _inflight(std::make_unique<InflightRequestsList>()),
+      _canceling(std::make_unique<InflightRequestsList>())
   {
   }
 } TrackedRequests;
@@ -61,10 +210,10 @@ typedef std::unique_ptr<TrackedRequests> TrackedRequestsPtr;
  */
 class InflightRequests {
  private:
-  TrackedRequestsPtr _trackedRequests{
-    std::make_unique<TrackedRequests>()};  ///< Container storing pointers to all inflight
-                                           ///< and in cancelation process requests known to
-                                           ///< the owner of this object
+  TrackedRequestsPtr _trackedRequests{nullptr};  ///< Container storing pointers to all
+                                                 ///< inflight and in cancelation process
+                                                 ///< requests known to the owner of this
+                                                 ///< object, allocated upon first use
   std::mutex _mutex{};  ///< Mutex to control access to inflight requests container
   std::mutex
     _cancelMutex{};  ///< Mutex to allow cancelation and prevent removing requests simultaneously
@@ -78,6 +227,30 @@ class InflightRequests {
    */
   size_t dropCanceled();
 
+  /**
+   * @brief Lock the inflight requests container, allocating it if necessary.
+   *
+   * The tracked requests container is only allocated when the first request is inserted,
+   * so that owners that never track requests, such as idle endpoints, don't pay for it.
+   * The container may only be replaced while holding both mutexes, so that it may be
+   * read while holding either of them.
+   *
+   * @returns The lock of the inflight requests mutex, with the container allocated.
+   */
+  std::unique_lock<std::mutex> lockForInsertion();
+
+  /**
+   * @brief Issue `function` on all inflight requests and clear the internal container.
+   *
+   * Implementation of `cancelAll()` and `abortAll()`, issuing `function` on all inflight
+   * requests outside of the locks and tracking them until they complete.
+   *
+   * @param[in] function  the function issuing cancelation of a request.
+   *
+   * @returns The total number of requests `function` was issued on.
+   */
+  size_t cancelAllWith(const std::function<void(const std::shared_ptr<Request>&)>& function);
+
  public:
   /**
    * @brief Default constructor.
@@ -110,6 +283,16 @@ class InflightRequests {
    */
   void insert(std::shared_ptr<Request> request);
 
+  /**
+   * @brief Insert multiple inflight requests to the container.
+   *
+   * Insert multiple inflight requests to the container, acquiring the internal lock only
+   * once for the entire batch.
+   *
+   * @param[in] requests  a vector of `std::shared_ptr<Request>` with the inflight requests.
+   */
+  void insert(const std::vector<std::shared_ptr<Request>>& requests);
+
   /**
    * @brief Merge containers of inflight requests with the internal containers.
    *
@@ -128,8 +311,7 @@ class InflightRequests {
    * be called when a request has completed and the `InflightRequests` owner does not need
    * to keep track of it anymore. The raw pointer to a `ucxx::Request` is passed here as
    * opposed to the usual `std::shared_ptr<ucxx::Request>` used elsewhere, this is because
-   * the raw pointer address is used as key to the requests reference, and this is called
-   * called from the object's destructor.
+   * this is called from within the request object itself.
    *
    * @param[in] request raw pointer to the request
    */
@@ -145,6 +327,18 @@ class InflightRequests {
    */
   size_t cancelAll();
 
+  /**
+   * @brief Abort all inflight requests and clear the internal container.
+   *
+   * Abort all inflight requests known to this object with `ucxx::Request::abort()` and
+   * clear the internal container. Requests that were not submitted to UCX yet complete
+   * immediately, the others are tracked until their cancelation completes. The total
+   * number of aborted requests is returned.
+   *
+   * @returns The total number of aborted requests.
+   */
+  size_t abortAll();
+
   /**
    * @brief Releases the internally-tracked containers.
    *
@@ -152,7 +346,7 @@ class InflightRequests {
    * `InflightRequests` object with `InflightRequests::merge()`. Effectively leaves the
    * internal state as a clean, new object.
    *
-   * @returns The internally-tracked containers.
+   * @returns The internally-tracked containers, `nullptr` if no request was ever tracked.
    */
   TrackedRequestsPtr release();
 
@@ -2,12 +2,16 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <ucp/api/ucp.h>
 
@@ -25,6 +29,67 @@ namespace internal {
 
 class AmData;
 
+/**
+ * @brief The active message ID reserved for returning flow control credits.
+ */
+static constexpr unsigned int AmFlowControlId = 0xffff;
+
+/**
+ * @brief Flag set in the memory type header of active messages sent with flow control.
+ *
+ * Set by senders in the memory type preceding the user-defined header of active messages
+ * sent from endpoints with flow control enabled, requesting the receiver to return a credit
+ * once the message is delivered to the application.
+ */
+static constexpr uint32_t AmFlowControlFlag = 1u << 31;
+
+/**
+ * @brief Flow control credits returned by the receiver of active messages.
+ */
+struct AmCredit {
+  uint64_t messages{0};  ///< The number of messages delivered to the application
+  uint64_t bytes{0};     ///< The number of bytes delivered to the application
+};
+
+/**
+ * @brief The active message ID reserved for aggregated batches of small active messages.
+ */
+static constexpr unsigned int AmAggregationId = 0xfffe;
+
+/**
+ * @brief The record preceding each message in an aggregated batch.
+ *
+ * Each message of a batch sent with `AmAggregationId` is encoded as this record, followed
+ * by `headerLength` bytes of header, i.e., the memory type and user-defined header as
+ * expected by `ucxx::RequestAm::recvCallback()`, followed by `length` bytes of data.
+ */
+struct AmAggregationRecord {
+  uint32_t amId{0};          ///< The active message ID the message was sent to
+  uint32_t headerLength{0};  ///< The length in bytes of the header following the record
+  uint32_t length{0};        ///< The length in bytes of the data following the header
+};
+
+/**
+ * @brief A batch of small active messages being aggregated by an endpoint.
+ */
+struct AmAggregationBatch {
+  std::string buffer{};  ///< The encoded messages, see `AmAggregationRecord`
+  std::vector<std::shared_ptr<Request>>
+    requests{};  ///< The send requests of each message, completed with the batch
+  std::chrono::steady_clock::time_point created{};  ///< When the first message was added
+};
+
+/**
+ * @brief Return flow control credits of an active message to its sender.
+ *
+ * Send an `AmCredit` for a single message of `length` bytes to the sender of a message
+ * received with `AmFlowControlFlag` set, once the message is delivered to the application.
+ *
+ * @param[in] ep      the reply endpoint of the message received.
+ * @param[in] length  the length in bytes of the message received.
+ */
+void sendAmCredit(ucp_ep_h ep, size_t length);
+
 /**
  * @brief Handle receiving of a `ucxx::RequestAm`.
  *
@@ -55,11 +120,13 @@ class RecvAmMessage {
    *                    where user is requesting to receive).
    * @param[in] request request to be later notified/delivered to user.
    * @param[in] buffer  buffer containing the received data
+   * @param[in] header  the user-defined header received with the data
    */
   RecvAmMessage(internal::AmData* amData,
                 ucp_ep_h ep,
                 std::shared_ptr<RequestAm> request,
-                std::shared_ptr<Buffer> buffer);
+                std::shared_ptr<Buffer> buffer,
+                std::string header = {});
 
   /**
    * @brief Set the UCP request.
@@ -85,13 +152,16 @@ class RecvAmMessage {
 
 typedef std::unordered_map<ucp_ep_h, std::queue<std::shared_ptr<RequestAm>>> AmPoolType;
 typedef std::unordered_map<RequestAm*, std::shared_ptr<RecvAmMessage>> RecvAmMessageMapType;
+typedef std::unordered_map<RequestAm*, std::pair<ucp_ep_h, size_t>> AmPendingCreditMapType;
 
 /**
  * @brief Active Message data owned by a `ucxx::Worker`.
  *
  * Receiving Active Messages are handled directly by a `ucxx::Worker` without the user
  * necessarily creating a `ucxx::RequestAm` for it. When there is an incoming message, the
- * worker will populate the internal pool of received messages in an orderly-fashion.
+ * worker will populate the internal pool of received messages in an orderly-fashion, or
+ * deliver it to the receiver callback if one is registered. Each active message ID
+ * registered with the worker has its own `AmData`.
  */
 class AmData {
  public:
@@ -101,11 +171,17 @@ class AmData {
   AmPoolType _recvWait{};  ///< The pool of user receive requests (waiting for message arrival)
   RecvAmMessageMapType
     _recvAmMessageMap{};  ///< The active messages waiting to be handled by callback
-  std::mutex _mutex{};    ///< Mutex to provide access to pools/maps
+  AmPendingCreditMapType
+    _pendingCredits{};  ///< Reply endpoint and length of pooled messages owing a credit
+  std::mutex _mutex{};  ///< Mutex to provide access to pools/maps
   std::function<void(std::shared_ptr<Request>)>
     _registerInflightRequest{};  ///< Worker function to register inflight requests with
   std::unordered_map<ucs_memory_type_t, AmAllocatorType>
-    _allocators{};  ///< Default and user-defined active message allocators
+    _allocators{};             ///< Default and user-defined active message allocators
+  unsigned int _amId{0};       ///< The active message ID this data handles
+  bool _zeroCopyEager{false};  ///< Whether eager messages are delivered without a copy
+  AmReceiverCallbackType
+    _receiverCallback{};  ///< Callback to deliver messages to, instead of queueing them
 };
 
 }  // namespace internal
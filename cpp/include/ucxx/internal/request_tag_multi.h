@@ -0,0 +1,65 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <ucp/api/ucp.h>
+
+namespace ucxx {
+
+class Request;
+
+namespace internal {
+
+/**
+ * @brief A header receive of a multi-buffer tag message posted ahead of its request.
+ *
+ * The receive of the first header of the next multi-buffer tag message, posted by a
+ * `ucxx::RequestTagMulti` receive as soon as it posted the receives of all its frames,
+ * before the application creates the request to receive the next message. The header
+ * receive may thus complete before it is adopted by that request, in which case its
+ * completion is delivered when it is adopted.
+ */
+class TagMultiPrepostedHeader {
+ private:
+  std::mutex _mutex{};                   ///< Mutex to access the completion state
+  bool _completed{false};                ///< Whether the header receive completed
+  ucs_status_t _status{UCS_INPROGRESS};  ///< The status the header receive completed with
+  std::function<void(ucs_status_t)> _callback{
+    nullptr};  ///< The completion callback of the adopting request, if adopted
+
+ public:
+  std::shared_ptr<std::string> stringBuffer{nullptr};  ///< Buffer to receive the header into
+  std::shared_ptr<Request> request{nullptr};           ///< The header receive request
+
+  /**
+   * @brief Register the completion of the header receive.
+   *
+   * Register the completion of the header receive, calling the callback of the adopting
+   * request if already adopted, otherwise storing the status until it is adopted.
+   *
+   * @param[in] status  the status the header receive completed with.
+   */
+  void complete(ucs_status_t status);
+
+  /**
+   * @brief Adopt the header receive by a multi-buffer tag receive request.
+   *
+   * Set the callback to call upon completion of the header receive, calling it
+   * immediately if the header receive already completed. The callback is released once
+   * called, and may thus hold a reference to the preposted header to keep it alive.
+   *
+   * @param[in] callback  the completion callback of the adopting request.
+   */
+  void adopt(std::function<void(ucs_status_t)> callback);
+};
+
+}  // namespace internal
+
+}  // namespace ucxx
@@ -4,12 +4,17 @@
  */
 #pragma once
 
+#include <deque>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <ucp/api/ucp.h>
 
 #include <ucxx/component.h>
+#include <ucxx/statistics.h>
 #include <ucxx/worker.h>
 
 namespace ucxx {
@@ -25,6 +30,10 @@ class Listener : public Component {
   ucp_listener_h _handle{nullptr};  ///< The UCP listener handle
   std::string _ip{};                ///< The IP address to which the listener is bound to
   uint16_t _port{0};                ///< The port to which the listener is bound to
+  size_t _backlog{0};  ///< Maximum number of queued connection requests, `0` if not queued
+  std::mutex _connRequestsMutex{};  ///< Mutex to access the connection requests queue
+  std::deque<ucp_conn_request_h> _connRequests{};  ///< Queued connection requests
+  ListenerStatistics _statistics{};  ///< Statistics, protected by `_connRequestsMutex`
 
   /**
    * @brief Private constructor of `ucxx::Listener`.
@@ -37,13 +46,38 @@ class Listener : public Component {
    * @param[in] worker        the worker from which to create the listener.
    * @param[in] port          the port which the listener should be bound to.
    * @param[in] callback      user-defined callback to be executed on incoming client
-   *                          connections.
+   *                          connections, ignored if `backlog > 0`.
    * @param[in] callbackArgs  argument to be passed to the callback.
+   * @param[in] backlog       maximum number of connection requests to queue, or `0` to
+   *                          execute `callback` on each incoming client connection
+   *                          instead.
    */
   Listener(std::shared_ptr<Worker> worker,
            uint16_t port,
            ucp_listener_conn_callback_t callback,
-           void* callbackArgs);
+           void* callbackArgs,
+           size_t backlog = 0);
+
+  /**
+   * @brief Queue an incoming connection request.
+   *
+   * Connection callback of listeners created with a backlog, executed by UCX from the
+   * worker progress thread. Queues the connection request to be later accepted by the
+   * application with `acceptEndpoints()`, or rejects it if the queue is full so that the
+   * progress thread never stalls creating endpoints.
+   *
+   * @param[in] connRequest handle to the incoming connection request.
+   * @param[in] arg         pointer to the `ucxx::Listener` object.
+   */
+  static void queueConnRequestCallback(ucp_conn_request_h connRequest, void* arg);
+
+  /**
+   * @brief Reject all queued connection requests.
+   *
+   * Reject all connection requests that were queued but not accepted by the application,
+   * must be called before the UCP listener is destroyed.
+   */
+  void rejectConnRequests();
 
  public:
   Listener()                           = delete;
@@ -97,6 +131,41 @@ class Listener : public Component {
                                                   ucp_listener_conn_callback_t callback,
                                                   void* callbackArgs);
 
+  /**
+   * @brief Constructor of `shared_ptr<ucxx::Listener>` with a connection request queue.
+   *
+   * The constructor for a `shared_ptr<ucxx::Listener>` object that queues incoming client
+   * connection requests instead of executing a user-defined callback for each one of them
+   * from the worker progress thread. Endpoints to the queued clients are created by the
+   * application with `acceptEndpoints()`, in batches and in the calling thread. Once
+   * `backlog` connection requests are queued any further requests are rejected until the
+   * application accepts the pending ones, providing backpressure against connection storms
+   * and preventing the progress thread from stalling.
+   *
+   * @code{.cpp}
+   * // worker is `std::shared_ptr<ucxx::Worker>`
+   * auto listener = worker->createListener(12345, 1024);
+   *
+   * // Equivalent to line above
+   * // auto listener = ucxx::createListener(worker, 12345, 1024);
+   *
+   * // Periodically, from an application thread
+   * for (auto& endpoint : listener->acceptEndpoints())
+   *   handleClient(endpoint);
+   * @endcode
+   *
+   * @throws std::invalid_argument if `backlog` is `0`.
+   *
+   * @param[in] worker  the worker from which to create the listener.
+   * @param[in] port    the port which the listener should be bound to.
+   * @param[in] backlog maximum number of connection requests to queue.
+   *
+   * @returns The `shared_ptr<ucxx::Listener>` object.
+   */
+  friend std::shared_ptr<Listener> createListener(std::shared_ptr<Worker> worker,
+                                                  uint16_t port,
+                                                  size_t backlog);
+
   /**
    * @brief Constructor for `shared_ptr<ucxx::Endpoint>`.
    *
@@ -121,6 +190,47 @@ class Listener : public Component {
   std::shared_ptr<Endpoint> createEndpointFromConnRequest(ucp_conn_request_h connRequest,
                                                           bool endpointErrorHandling = true);
 
+  /**
+   * @brief Create endpoints to the queued client connection requests.
+   *
+   * Pop up to `maxEndpoints` connection requests queued by a listener created with a
+   * backlog, and create one endpoint for each of them. If the worker is running a progress
+   * thread, all UCP endpoints are created by it in a single batch. This is meant to be
+   * called periodically from an application thread, returning an empty vector if there
+   * are no queued connection requests.
+   *
+   * @throws std::runtime_error if the listener was not created with a backlog.
+   * @throws ucxx::Error if an error occurred while attempting to create any endpoint.
+   *
+   * @param[in] maxEndpoints          maximum number of endpoints to create.
+   * @param[in] endpointErrorHandling whether to enable endpoint error handling.
+   *
+   * @returns The `shared_ptr<ucxx::Endpoint>` objects, in the order clients connected.
+   */
+  std::vector<std::shared_ptr<Endpoint>> acceptEndpoints(
+    size_t maxEndpoints = std::numeric_limits<size_t>::max(), bool endpointErrorHandling = true);
+
+  /**
+   * @brief Get the number of queued connection requests.
+   *
+   * Get the number of connection requests queued by a listener created with a backlog
+   * that have not yet been accepted with `acceptEndpoints()`.
+   *
+   * @returns The number of queued connection requests.
+   */
+  size_t getPendingConnectionRequests();
+
+  /**
+   * @brief Get a snapshot of the listener statistics.
+   *
+   * Get the counters of connection requests received, accepted and rejected, and the
+   * depth of the connection request queue. Only listeners created with a backlog keep
+   * track of statistics.
+   *
+   * @returns The listener statistics.
+   */
+  ListenerStatistics getStatistics();
+
   /**
    * @brief Get the underlying `ucp_listener_h` handle.
    *
@@ -21,30 +21,40 @@ namespace ucxx {
 extern ucs_log_component_config_t ucxx_log_component_config;
 
 // Macros
+
+/**
+ * The most verbose log level compiled in, set with the `UCXX_MAX_LOG_LEVEL` CMake option.
+ * Logging calls of more verbose levels are discarded at compile time, including the
+ * evaluation of their arguments, regardless of the level set with `UCXX_LOG_LEVEL`.
+ */
 #ifndef UCXX_MAX_LOG_LEVEL
 #define UCXX_MAX_LOG_LEVEL ucxx::UCXX_LOG_LEVEL_LAST
 #endif
 
+#define ucxx_log_level_is_compiled(_level) ((_level) <= UCXX_MAX_LOG_LEVEL)
+
 #define ucxx_log_component_is_enabled(_level, _comp_log_config) \
   ucs_unlikely(                                                 \
-    ((_level) <= UCXX_MAX_LOG_LEVEL) &&                         \
+    ucxx_log_level_is_compiled(_level) &&                       \
     ((_level) <= (ucxx::ucxx_log_level_t)(                      \
                    reinterpret_cast<ucs_log_component_config_t*>(_comp_log_config)->log_level)))
 
 #define ucxx_log_is_enabled(_level) \
   ucxx_log_component_is_enabled(_level, &ucxx::ucxx_log_component_config)
 
-#define ucxx_log_component(_level, _comp_log_config, _fmt, ...)    \
-  do {                                                             \
-    if (ucxx_log_component_is_enabled(_level, _comp_log_config)) { \
-      ucs_log_dispatch(__FILE__,                                   \
-                       __LINE__,                                   \
-                       __func__,                                   \
-                       (ucs_log_level_t)(_level),                  \
-                       _comp_log_config,                           \
-                       _fmt,                                       \
-                       ##__VA_ARGS__);                             \
-    }                                                              \
+#define ucxx_log_component(_level, _comp_log_config, _fmt, ...)      \
+  do {                                                               \
+    if constexpr (ucxx_log_level_is_compiled(_level)) {              \
+      if (ucxx_log_component_is_enabled(_level, _comp_log_config)) { \
+        ucs_log_dispatch(__FILE__,                                   \
+                         __LINE__,                                   \
+                         __func__,                                   \
+                         (ucs_log_level_t)(_level),                  \
+                         _comp_log_config,                           \
+                         _fmt,                                       \
+                         ##__VA_ARGS__);                             \
+      }                                                              \
+    }                                                                \
   } while (0)
 
 #define ucxx_log(_level, _fmt, ...)                                                    \
@@ -0,0 +1,157 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <memory>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/component.h>
+#include <ucxx/context.h>
+
+namespace ucxx {
+
+/**
+ * @brief Component encapsulating memory registered with a UCP context.
+ *
+ * Memory registered with `ucp_mem_map()`, either allocated by UCX or provided by the user.
+ * Passing the handle to transfer operations avoids looking up or creating the memory
+ * registration on every transfer, which is beneficial when the same buffers (e.g., staging
+ * buffers) are transferred repeatedly. The memory is unregistered with `ucp_mem_unmap()`,
+ * and if it was allocated by UCX also freed, when the object is destroyed.
+ */
+class MemoryHandle : public Component {
+ private:
+  ucp_mem_h _handle{nullptr};                              ///< The UCP memory handle
+  void* _baseAddress{nullptr};                             ///< Base address of the memory
+  size_t _size{0};                                         ///< Size of the memory in bytes
+  ucs_memory_type_t _memoryType{UCS_MEMORY_TYPE_UNKNOWN};  ///< Memory type of the memory
+
+  /**
+   * @brief Private constructor of `ucxx::MemoryHandle`.
+   *
+   * This is the internal implementation of `ucxx::MemoryHandle` constructor, made private
+   * not to be called directly. This constructor is made private to ensure all UCXX objects
+   * are shared pointers and the correct lifetime management of each one.
+   *
+   * Instead the user should use one of the following:
+   *
+   * - `ucxx::createMemoryHandle()`
+   * - `ucxx::Context::createMemoryHandle()`
+   *
+   * @throws ucxx::Error if the memory could not be registered.
+   *
+   * @param[in] context     the parent `std::shared_ptr<Context>` component.
+   * @param[in] size        the size of the memory in bytes.
+   * @param[in] buffer      the memory to register, or `nullptr` to let UCX allocate it.
+   * @param[in] memoryType  the memory type of the memory, or `UCS_MEMORY_TYPE_UNKNOWN` to
+   *                        let UCX detect it or, when allocating, use host memory.
+   */
+  MemoryHandle(std::shared_ptr<Context> context,
+               const size_t size,
+               void* buffer,
+               const ucs_memory_type_t memoryType);
+
+ public:
+  MemoryHandle()                               = delete;
+  MemoryHandle(const MemoryHandle&)            = delete;
+  MemoryHandle& operator=(MemoryHandle const&) = delete;
+  MemoryHandle(MemoryHandle&& o)               = delete;
+  MemoryHandle& operator=(MemoryHandle&& o)    = delete;
+
+  ~MemoryHandle();
+
+  /**
+   * @brief Constructor for `shared_ptr<ucxx::MemoryHandle>`.
+   *
+   * The constructor for a `shared_ptr<ucxx::MemoryHandle>` object, registering `size`
+   * bytes of memory at `buffer` with the context, or allocating it if `buffer` is
+   * `nullptr`.
+   *
+   * @code{.cpp}
+   * // context is `std::shared_ptr<ucxx::Context>`
+   * auto memoryHandle = ucxx::createMemoryHandle(context, 1 << 20);
+   * @endcode
+   *
+   * @throws ucxx::Error if the memory could not be registered.
+   *
+   * @param[in] context     parent context with which to register the memory.
+   * @param[in] size        the size of the memory in bytes.
+   * @param[in] buffer      the memory to register, or `nullptr` to let UCX allocate it.
+   * @param[in] memoryType  the memory type of the memory, or `UCS_MEMORY_TYPE_UNKNOWN` to
+   *                        let UCX detect it or, when allocating, use host memory.
+   *
+   * @returns The `shared_ptr<ucxx::MemoryHandle>` object.
+   */
+  friend std::shared_ptr<MemoryHandle> createMemoryHandle(std::shared_ptr<Context> context,
+                                                          const size_t size,
+                                                          void* buffer,
+                                                          const ucs_memory_type_t memoryType);
+
+  /**
+   * @brief Get the underlying `ucp_mem_h` handle.
+   *
+   * Lifetime of the `ucp_mem_h` handle is managed by the `ucxx::MemoryHandle` object and
+   * its ownership is non-transferrable. Once the `ucxx::MemoryHandle` is destroyed the
+   * handle is not valid anymore, it is the user's responsibility to ensure the owner's
+   * lifetime while using the handle.
+   *
+   * @returns The underlying `ucp_mem_h` handle.
+   */
+  ucp_mem_h getHandle() const;
+
+  /**
+   * @brief Get the base address of the registered memory.
+   *
+   * @returns The base address of the registered memory.
+   */
+  void* getBaseAddress() const;
+
+  /**
+   * @brief Get the size of the registered memory.
+   *
+   * @returns The size of the registered memory in bytes.
+   */
+  size_t getSize() const;
+
+  /**
+   * @brief Get the memory type of the registered memory.
+   *
+   * @returns The memory type of the registered memory.
+   */
+  ucs_memory_type_t getMemoryType() const;
+
+  /**
+   * @brief Check whether a memory range is within the registered memory.
+   *
+   * @param[in] buffer  the start of the memory range.
+   * @param[in] length  the length of the memory range in bytes.
+   *
+   * @returns `true` if the memory range is entirely within the registered memory, `false`
+   *          otherwise.
+   */
+  bool contains(const void* buffer, const size_t length) const;
+
+  /**
+   * @brief Pack the remote key of the registered memory.
+   *
+   * Pack the remote key of the registered memory, which may then be serialized and
+   * transferred to remote processes to allow them to access the memory with remote memory
+   * access operations. The memory handle will not be destroyed until the remote key is
+   * destroyed.
+   *
+   * @code{.cpp}
+   * // memoryHandle is `std::shared_ptr<ucxx::MemoryHandle>`
+   * std::string serialized = memoryHandle->createRemoteKey()->serialize();
+   * @endcode
+   *
+   * @throws ucxx::Error if the remote key could not be packed.
+   *
+   * @returns The packed `std::shared_ptr<ucxx::RemoteKey>`.
+   */
+  std::shared_ptr<RemoteKey> createRemoteKey();
+};
+
+}  // namespace ucxx
@@ -90,6 +90,16 @@ class Notifier {
    */
   virtual void runRequestNotifier() = 0;
 
+  /**
+   * @brief Wake the notifier thread to refill the futures pool.
+   *
+   * Wake the notifier thread blocked in `waitRequestNotifier()`, which then returns
+   * `RequestNotifierWaitState::Timeout` unless there are also futures to notify, so that
+   * the thread refills the futures pool ahead of its usual period. Called when the futures
+   * pool crosses its low watermark, the default implementation is a no-op.
+   */
+  virtual void requestFuturesPoolRefill() {}
+
   /**
    * @brief Make known to the notifier thread that it should stop.
    *
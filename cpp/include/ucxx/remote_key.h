@@ -0,0 +1,187 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/component.h>
+#include <ucxx/endpoint.h>
+#include <ucxx/memory_handle.h>
+
+namespace ucxx {
+
+/**
+ * @brief Component encapsulating the remote key of registered memory.
+ *
+ * A remote key is required by remote processes to access memory registered with a
+ * `ucxx::MemoryHandle` via remote memory access (RMA) operations. The key is packed from
+ * the local `ucxx::MemoryHandle`, serialized and transferred to the remote process by
+ * the user, and then unpacked by the remote process using the `ucxx::Endpoint` to the
+ * owner of the memory, after which it can be used with `ucxx::Endpoint::memPut()` and
+ * `ucxx::Endpoint::memGet()`.
+ *
+ * The serialized form contains the base address and size of the registered memory,
+ * followed by the packed `ucp_rkey_pack()` buffer.
+ */
+class RemoteKey : public Component {
+ private:
+  ucp_rkey_h _remoteKey{nullptr};  ///< The unpacked UCP remote key handle, if unpacked
+  std::string _packedRemoteKey{};  ///< The packed UCP remote key
+  uint64_t _memoryBaseAddress{0};  ///< Base address of the registered memory
+  size_t _memorySize{0};           ///< Size of the registered memory in bytes
+
+  /**
+   * @brief Private constructor of `ucxx::RemoteKey` from a memory handle.
+   *
+   * This is the internal implementation of `ucxx::RemoteKey` constructor from a local
+   * memory handle, made private not to be called directly. This constructor is made
+   * private to ensure all UCXX objects are shared pointers and the correct lifetime
+   * management of each one.
+   *
+   * Instead the user should use one of the following:
+   *
+   * - `ucxx::createRemoteKeyFromMemoryHandle()`
+   * - `ucxx::MemoryHandle::createRemoteKey()`
+   *
+   * @throws ucxx::Error if the remote key could not be packed.
+   *
+   * @param[in] memoryHandle  the parent `std::shared_ptr<MemoryHandle>` component.
+   */
+  explicit RemoteKey(std::shared_ptr<MemoryHandle> memoryHandle);
+
+  /**
+   * @brief Private constructor of `ucxx::RemoteKey` from a serialized remote key.
+   *
+   * This is the internal implementation of `ucxx::RemoteKey` constructor from a
+   * serialized remote key, made private not to be called directly. This constructor is
+   * made private to ensure all UCXX objects are shared pointers and the correct lifetime
+   * management of each one.
+   *
+   * Instead the user should use one of the following:
+   *
+   * - `ucxx::createRemoteKeyFromSerialized()`
+   * - `ucxx::Endpoint::createRemoteKeyFromSerialized()`
+   *
+   * @throws std::runtime_error if the serialized remote key is malformed.
+   * @throws ucxx::Error        if the remote key could not be unpacked.
+   *
+   * @param[in] endpoint            the parent `std::shared_ptr<Endpoint>` component,
+   *                                connected to the owner of the registered memory.
+   * @param[in] serializedRemoteKey the serialized remote key.
+   */
+  RemoteKey(std::shared_ptr<Endpoint> endpoint, const std::string& serializedRemoteKey);
+
+ public:
+  RemoteKey()                            = delete;
+  RemoteKey(const RemoteKey&)            = delete;
+  RemoteKey& operator=(RemoteKey const&) = delete;
+  RemoteKey(RemoteKey&& o)               = delete;
+  RemoteKey& operator=(RemoteKey&& o)    = delete;
+
+  ~RemoteKey();
+
+  /**
+   * @brief Constructor for `shared_ptr<ucxx::RemoteKey>` from a memory handle.
+   *
+   * The constructor for a `shared_ptr<ucxx::RemoteKey>` object, packing the remote key of
+   * the local memory handle so that it can be serialized and transferred to a remote
+   * process.
+   *
+   * @code{.cpp}
+   * // memoryHandle is `std::shared_ptr<ucxx::MemoryHandle>`
+   * auto remoteKey = ucxx::createRemoteKeyFromMemoryHandle(memoryHandle);
+   * std::string serialized = remoteKey->serialize();
+   * @endcode
+   *
+   * @throws ucxx::Error if the remote key could not be packed.
+   *
+   * @param[in] memoryHandle  the memory handle whose remote key to pack.
+   *
+   * @returns The `shared_ptr<ucxx::RemoteKey>` object.
+   */
+  friend std::shared_ptr<RemoteKey> createRemoteKeyFromMemoryHandle(
+    std::shared_ptr<MemoryHandle> memoryHandle);
+
+  /**
+   * @brief Constructor for `shared_ptr<ucxx::RemoteKey>` from a serialized remote key.
+   *
+   * The constructor for a `shared_ptr<ucxx::RemoteKey>` object, unpacking a serialized
+   * remote key received from the owner of the registered memory, so that it may be used
+   * for remote memory access operations on `endpoint`.
+   *
+   * @code{.cpp}
+   * // endpoint is `std::shared_ptr<ucxx::Endpoint>`, serialized is `std::string`
+   * auto remoteKey = ucxx::createRemoteKeyFromSerialized(endpoint, serialized);
+   * endpoint->memGet(buffer, length, remoteKey->getBaseAddress(), remoteKey);
+   * @endcode
+   *
+   * @throws std::runtime_error if the serialized remote key is malformed.
+   * @throws ucxx::Error        if the remote key could not be unpacked.
+   *
+   * @param[in] endpoint            the endpoint connected to the owner of the memory.
+   * @param[in] serializedRemoteKey the serialized remote key.
+   *
+   * @returns The `shared_ptr<ucxx::RemoteKey>` object.
+   */
+  friend std::shared_ptr<RemoteKey> createRemoteKeyFromSerialized(
+    std::shared_ptr<Endpoint> endpoint, const std::string& serializedRemoteKey);
+
+  /**
+   * @brief Get the underlying `ucp_rkey_h` handle.
+   *
+   * Get the underlying `ucp_rkey_h` handle, only available to remote keys unpacked from a
+   * serialized remote key. Lifetime of the `ucp_rkey_h` handle is managed by the
+   * `ucxx::RemoteKey` object and its ownership is non-transferrable.
+   *
+   * @returns The underlying `ucp_rkey_h` handle, or `nullptr` if this is a packed remote
+   *          key of a local memory handle.
+   */
+  ucp_rkey_h getHandle() const;
+
+  /**
+   * @brief Get the base address of the registered memory.
+   *
+   * Get the base address of the registered memory in the address space of the owner
+   * process, which is the address to use for remote memory access operations.
+   *
+   * @returns The base address of the registered memory.
+   */
+  uint64_t getBaseAddress() const;
+
+  /**
+   * @brief Get the size of the registered memory.
+   *
+   * @returns The size of the registered memory in bytes.
+   */
+  size_t getSize() const;
+
+  /**
+   * @brief Check whether a remote memory range is within the registered memory.
+   *
+   * @param[in] remoteAddress the start of the remote memory range.
+   * @param[in] length        the length of the memory range in bytes.
+   *
+   * @returns `true` if the memory range is entirely within the registered memory, `false`
+   *          otherwise.
+   */
+  bool contains(const uint64_t remoteAddress, const size_t length) const;
+
+  /**
+   * @brief Serialize the remote key.
+   *
+   * Serialize the remote key, including the base address and size of the registered
+   * memory, so that it may be transferred to a remote process and unpacked there with
+   * `ucxx::createRemoteKeyFromSerialized()`.
+   *
+   * @returns The serialized remote key.
+   */
+  std::string serialize() const;
+};
+
+}  // namespace ucxx
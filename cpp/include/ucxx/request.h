@@ -6,7 +6,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <ucp/api/ucp.h>
@@ -14,8 +16,11 @@
 #include <ucxx/component.h>
 #include <ucxx/endpoint.h>
 #include <ucxx/future.h>
+#include <ucxx/inflight_requests.h>
 #include <ucxx/request_data.h>
+#include <ucxx/request_trace.h>
 #include <ucxx/typedefs.h>
+#include <ucxx/utils/memory_pool.h>
 
 #define ucxx_trace_req_f(_owner, _req, _handle, _name, _message, ...)          \
   ucxx_trace_req("ucxx::Request: %p on %s, UCP handle: %p, op: %s, " _message, \
@@ -37,23 +42,42 @@ namespace ucxx {
  */
 class Request : public Component {
  protected:
-  ucs_status_t _status{UCS_INPROGRESS};            ///< Requests status
+  std::atomic<ucs_status_t> _status{
+    UCS_INPROGRESS};  ///< Request status, published with release semantics for lock-free polling
+  std::atomic<bool> _completed{
+    false};  ///< Whether completion was published to pollers, after notifying and callbacks
   std::string _status_msg{};                       ///< Human-readable status message
   void* _request{nullptr};                         ///< Pointer to UCP request
   std::shared_ptr<Future> _future{nullptr};        ///< Future to notify upon completion
   RequestCallbackUserFunction _callback{nullptr};  ///< Completion callback
   RequestCallbackUserData _callbackData{nullptr};  ///< Completion callback data
+  InflightRequestHooks _inflightHooks{};           ///< Hooks to track the request as inflight
+  mutable std::once_flag _ownerStringFlag{};       ///< Flag to build `_ownerString` only once
   std::shared_ptr<Worker> _worker{
     nullptr};  ///< Worker that generated request (if not from endpoint)
   std::shared_ptr<Endpoint> _endpoint{
     nullptr};  ///< Endpoint that generated request (if not from worker)
-  std::string _ownerString{
-    "undetermined owner"};           ///< String to print owner (endpoint or worker) when logging
-  data::RequestData _requestData{};  ///< The operation-specific data to be used in the request
+  mutable std::string _ownerString{};  ///< String to print owner (endpoint or worker) when logging
+  data::RequestData _requestData{};    ///< The operation-specific data to be used in the request
   std::string _operationName{
     "request_undefined"};          ///< Human-readable operation name, mostly used for log messages
-  std::recursive_mutex _mutex{};   ///< Mutex to prevent checking status while it's being set
+  std::recursive_mutex _mutex{};   ///< Mutex serializing submission and completion
   bool _enablePythonFuture{true};  ///< Whether Python future is enabled for this request
+  std::unique_ptr<RequestTrace> _trace{
+    nullptr};  ///< Lifecycle trace, only allocated if the request was sampled for tracing
+  std::atomic<bool> _deadlineExpired{
+    false};  ///< Whether the request was canceled because its deadline expired
+  RequestReadinessCallback _readiness{nullptr};  ///< Whether the data to send is ready, if awaited
+  bool _awaitingReadiness{false};  ///< Whether the submission awaits readiness, guarded by `_mutex`
+  bool _submitted{false};          ///< Whether submission to UCX started, guarded by `_mutex`
+  bool _aborted{false};            ///< Whether the request was aborted, guarded by `_mutex`
+  RequestCompletionFlagWriter _completionFlagWriter{
+    nullptr};  ///< Writer of the completion word, if set, guarded by `_mutex`
+  uint32_t _completionFlagValue{0};  ///< The completion word written upon success
+  bool _completionFlagSet{false};    ///< Whether a completion flag was set, guarded by `_mutex`
+
+  friend class InflightRequestsList;
+  friend class Worker;
 
   /**
    * @brief Protected constructor of an abstract `ucxx::Request`.
@@ -79,6 +103,21 @@ class Request : public Component {
           const std::string operationName,
           const bool enablePythonFuture = false);
 
+  /**
+   * @brief Get the memory pool to allocate a request from.
+   *
+   * Get the memory pool of the worker a request created for `endpointOrWorker` should be
+   * allocated from, to be used by factories with `ucxx::utils::makePooledShared()`.
+   *
+   * @param[in] endpointOrWorker    the parent component, which may either be a
+   *                                `std::shared_ptr<Endpoint>` or
+   *                                `std::shared_ptr<Worker>`.
+   *
+   * @returns The memory pool, or `nullptr` if the worker could not be determined.
+   */
+  static std::shared_ptr<utils::MemoryPool> getRequestMemoryPool(
+    std::shared_ptr<Component> endpointOrWorker);
+
   /**
    * @brief Perform initial processing of the request to determine if immediate completion.
    *
@@ -100,6 +139,38 @@ class Request : public Component {
    */
   void setStatus(ucs_status_t status);
 
+  /**
+   * @brief Account for the completion of the request in the owners' statistics.
+   *
+   * Update the request counters of the worker and endpoint (if any) owning the request,
+   * called by `setStatus()` and by derived classes that set their final status directly.
+   *
+   * @param[in] status the final status of the request.
+   */
+  void countCompletion(ucs_status_t status);
+
+  /**
+   * @brief Write the completion word to the completion flag, if set.
+   *
+   * Write the completion word of `status` with the writer set by `setCompletionFlag()`,
+   * at most once, called by `setStatus()` and by derived classes that set their final
+   * status directly, right after publishing it.
+   *
+   * @param[in] status the final status of the request.
+   */
+  void writeCompletionFlag(ucs_status_t status);
+
+  /**
+   * @brief Start submitting the request to UCX.
+   *
+   * Mark the request as submitted, must be called by `populateDelayedSubmission()` before
+   * submitting the UCX operation, which must not be submitted if this returns `false`
+   * because the request was aborted while awaiting submission.
+   *
+   * @returns `true` if the request must be submitted, `false` if it already completed.
+   */
+  bool startSubmission();
+
  public:
   Request()                          = delete;
   Request(const Request&)            = delete;
@@ -123,6 +194,95 @@ class Request : public Component {
    */
   virtual void cancel();
 
+  /**
+   * @brief Abort the request.
+   *
+   * Cancel the request, completing it immediately with `UCS_ERR_CANCELED` if it was not
+   * submitted to UCX yet, e.g., because it is still awaiting delayed submission or
+   * readiness, instead of waiting for it to be submitted and canceled afterwards.
+   * Requests submitted to UCX are canceled as with `cancel()` and may complete later.
+   * Called when the endpoint of the request fails, so that all of its requests complete
+   * in a single pass.
+   */
+  virtual void abort();
+
+  /**
+   * @brief Set a deadline for the request to complete.
+   *
+   * Set a deadline by which the request must complete, otherwise it is canceled by the
+   * first worker progress after the deadline and completes with `UCS_ERR_TIMED_OUT`
+   * instead of `UCS_ERR_CANCELED`. Deadlines are tracked by the worker in a timer wheel
+   * with millisecond resolution, advanced upon each `ucxx::Worker::progress()`, thus
+   * avoiding per-request timers. A request never expires before its deadline, but may
+   * expire later by up to one millisecond plus the time between progress calls, when the
+   * worker progresses in blocking mode this is bounded by the epoll timeout.
+   *
+   * A deadline can not be removed or extended, if set multiple times the earliest applies.
+   * Has no effect if the request already completed.
+   *
+   * @param[in] deadline  the time by which the request must complete.
+   */
+  void setDeadline(std::chrono::steady_clock::time_point deadline);
+
+  /**
+   * @brief Set a timeout for the request to complete.
+   *
+   * Set a deadline `timeout` nanoseconds from now for the request to complete, see
+   * `setDeadline()`.
+   *
+   * @param[in] timeout  the timeout in nanoseconds.
+   */
+  void setTimeout(uint64_t timeout);
+
+  /**
+   * @brief Write the completion of the request to a flag in host-accessible memory.
+   *
+   * Write the 32-bit completion word to `flag` when the request completes, immediately
+   * after its status is published and before the Python future is notified or the
+   * user-defined callback executes. The word is `value` if the request completed
+   * successfully, or `value | ucxx::CompletionFlagError` otherwise. This allows a CUDA
+   * kernel to start as soon as received data arrives without a host round trip, by
+   * spinning on the flag or waiting on it with `cuStreamWaitValue32()` using
+   * `CU_STREAM_WAIT_VALUE_GEQ`, launched before the request completes. Using increasing
+   * values allows reusing the same flag for successive requests.
+   *
+   * `flag` must be accessible by the host, e.g., pinned host memory allocated with
+   * `cudaHostAlloc()`, which is the preferred memory for flags awaited by the device, or
+   * managed memory, and remain valid until the request completed. Flags in device memory
+   * need a writer copying the word to the device, see `ucxx::utils::cudaCompletionFlag()`.
+   * If the request already completed the word is written immediately.
+   *
+   * @code{.cpp}
+   * // `request` is `std::shared_ptr<ucxx::Request>` receiving data into device memory and
+   * // `flag` is `uint32_t*` in pinned host memory, initialized to `0`
+   * request->setCompletionFlag(flag);
+   * // Launch on `stream` the kernel consuming the data once `*flag >= 1`
+   * @endcode
+   *
+   * @throws std::invalid_argument if `flag` is in device memory, or `value` has the
+   *                               `ucxx::CompletionFlagError` bit set.
+   * @throws std::runtime_error    if a completion flag was already set.
+   *
+   * @param[in] flag   the flag to write the completion word to.
+   * @param[in] value  the completion word upon success.
+   */
+  void setCompletionFlag(uint32_t* flag, uint32_t value = 1);
+
+  /**
+   * @brief Write the completion of the request with a user-defined writer.
+   *
+   * Call `writer` with the completion word when the request completes, as
+   * `setCompletionFlag(uint32_t*, uint32_t)` writes it to host-accessible memory, e.g.,
+   * with `ucxx::utils::cudaCompletionFlag()` copying it to device memory.
+   *
+   * @throws std::invalid_argument if `value` has the `ucxx::CompletionFlagError` bit set.
+   * @throws std::runtime_error    if a completion flag was already set.
+   *
+   * @param[in] writer the function writing the completion word.
+   * @param[in] value  the completion word upon success.
+   */
+  void setCompletionFlag(RequestCompletionFlagWriter writer, uint32_t value = 1);
+
   /**
    * @brief Return the status of the request.
    *
@@ -130,9 +290,29 @@ class Request : public Component {
    * relying on `checkError()` alone, which does not currently implement all error
    * statuses supported by UCX.
    *
+   * This method is lock-free, the status remains `UCS_INPROGRESS` until `isCompleted()`
+   * returns `true`.
+   *
    * @return the current status of the request.
    */
-  ucs_status_t getStatus();
+  ucs_status_t getStatus() noexcept;
+
+  /**
+   * @brief Get the error of the request without throwing.
+   *
+   * Get the status of the request, as `getStatus()`, additionally writing the message
+   * `checkError()` would throw with to `message` if the request completed with an error.
+   * The non-throwing variant of `checkError()` for when failures are routine, e.g.,
+   * truncated or canceled receives, where throwing and catching exceptions would dominate
+   * the cost of handling the failure.
+   *
+   * @param[out] message  the message describing the error, only written if an error
+   *                      occurred, may be `nullptr` if not needed.
+   *
+   * @returns the current status of the request, an error occurred unless it is `UCS_OK` or
+   *          `UCS_INPROGRESS`.
+   */
+  ucs_status_t getError(std::string* message = nullptr) noexcept;
 
   /**
    * @brief Return the future used to check on state.
@@ -164,9 +344,16 @@ class Request : public Component {
    * Check whether the request has already completed. The status of the request must be
    * verified with `getStatus()` before consumption.
    *
+   * This method is lock-free and never contends with the thread completing the request,
+   * so it may be polled in a tight loop. Completion is only published once the Python
+   * future was notified and the user-defined callback executed inline. If they are
+   * deferred to a completion executor, completion is published right before enqueuing
+   * them, so they observe the request as completed but may still be pending when this
+   * returns `true`.
+   *
    * @return whether the request has completed.
    */
-  bool isCompleted();
+  bool isCompleted() noexcept;
 
   /**
    * @brief Callback executed by UCX when request is completed.
@@ -203,10 +390,24 @@ class Request : public Component {
    * not a member attribute of `ucxx::Request` or derived class, but a static method
    * or external function instead.
    *
+   * The string is only built the first time this method is called, thus requests whose
+   * owner is never logged do not pay the cost of formatting it.
+   *
    * @returns the formatted string containing the owner type and its handle.
    */
   const std::string& getOwnerString() const;
 
+  /**
+   * @brief Get the priority class of the delayed submission of the request.
+   *
+   * Get the priority class the request is submitted with when delayed submission is
+   * enabled, as set in the send hints of the endpoint that generated it, requests
+   * generated by a worker have `ucxx::SubmissionPriority::Normal` priority.
+   *
+   * @returns The priority class of the delayed submission of the request.
+   */
+  SubmissionPriority getSubmissionPriority() const;
+
   /**
    * @brief Get the received buffer.
    *
@@ -220,6 +421,46 @@ class Request : public Component {
    * @return The received buffer (if applicable) or `nullptr`.
    */
   virtual std::shared_ptr<Buffer> getRecvBuffer();
+
+  /**
+   * @brief Get the received user-defined header.
+   *
+   * This method is used to get the opaque user-defined header received along with the
+   * message for applicable derived classes (e.g., `RequestAm` receive operations), in all
+   * other cases this will return an empty string. The same completion checks described in
+   * `getRecvBuffer()` apply before the header may be accessed.
+   *
+   * @return The received user-defined header (if applicable) or an empty string.
+   */
+  virtual std::string getRecvHeader();
+
+  /**
+   * @brief Get the fetched result of an atomic operation.
+   *
+   * This method is used to get the original remote value fetched by an atomic operation
+   * for applicable derived classes (e.g., `RequestMem` fetching atomic operations). The
+   * same completion checks described in `getRecvBuffer()` apply before the result may be
+   * accessed.
+   *
+   * @throws std::runtime_error if the request is not a fetching atomic operation.
+   *
+   * @return The original remote value.
+   */
+  virtual uint64_t getAtomicResult();
+
+  /**
+   * @brief Get the length of the data received.
+   *
+   * This method is used to get the number of bytes actually received for applicable
+   * derived classes (e.g., `RequestStream` receive operations), which may be smaller than
+   * the requested length for partial receives. The same completion checks described in
+   * `getRecvBuffer()` apply before the length may be accessed.
+   *
+   * @throws std::runtime_error if the request is not a stream receive operation.
+   *
+   * @return The number of bytes received.
+   */
+  virtual size_t getRecvLength();
 };
 
 }  // namespace ucxx
@@ -31,6 +31,8 @@ class RequestAm : public Request {
  private:
   friend class internal::RecvAmMessage;
 
+  bool _flowControlled{false};  ///< Whether the send is subject to endpoint flow control
+
   /**
    * @brief Private constructor of `ucxx::RequestAm`.
    *
@@ -129,7 +131,8 @@ class RequestAm : public Request {
    *
    * param[in,out] arg  pointer to the `AmData` object held by the `ucxx::Worker` who
    *                    registered this callback.
-   * param[in] header pointer to the header containing the sender buffer's memory type.
+   * param[in] header pointer to the header containing the sender buffer's memory type,
+   *                  followed by the user-defined header.
    * param[in] header_length  length in bytes of the receive header.
    * param[in] data pointer to the buffer containing the remote endpoint's send data.
    * param[in] length the length in bytes of the message to be received.
@@ -143,6 +146,8 @@ class RequestAm : public Request {
                                    const ucp_am_recv_param_t* param);
 
   std::shared_ptr<Buffer> getRecvBuffer() override;
+
+  std::string getRecvHeader() override;
 };
 
 }  // namespace ucxx
@@ -4,7 +4,9 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <variant>
 #include <vector>
 
@@ -15,6 +17,8 @@
 namespace ucxx {
 
 class Buffer;
+class MemoryHandle;
+class RemoteKey;
 
 namespace data {
 
@@ -29,19 +33,36 @@ class AmSend {
   const void* _buffer{nullptr};  ///< The raw pointer where data to be sent is stored.
   const size_t _length{0};       ///< The length of the message.
   const ucs_memory_type_t _memoryType{UCS_MEMORY_TYPE_HOST};  ///< Memory type used on the operation
+  const std::string _header{};    ///< The opaque user-defined header sent with the message.
+  const unsigned int _amId{0};    ///< The active message ID to send to.
+  const std::shared_ptr<::ucxx::MemoryHandle> _memoryHandle{
+    nullptr};  ///< The registered memory containing the buffer, if any.
+  const ::ucxx::RequestReadinessCallback _readiness{
+    nullptr};  ///< Whether the buffer is ready to be sent, if it must be awaited.
 
   /**
    * @brief Constructor for Active Message-specific send data.
    *
    * Construct an object containing Active Message-specific send data.
    *
-   * @param[in] buffer      a raw pointer to the data to be sent.
-   * @param[in] length      the size in bytes of the message to be sent.
-   * @param[in] memoryType  the memory type of the buffer.
+   * @param[in] buffer        a raw pointer to the data to be sent.
+   * @param[in] length        the size in bytes of the message to be sent.
+   * @param[in] memoryType    the memory type of the buffer.
+   * @param[in] header        the opaque user-defined header to send with the message.
+   * @param[in] amId          the active message ID to send to.
+   * @param[in] memoryHandle  the registered memory containing the buffer, or `nullptr`.
+   * @param[in] readiness     whether the buffer is ready to be sent, or `nullptr` if it
+   *                          already is.
+   *
+   * @throws std::runtime_error if the buffer is not contained in `memoryHandle`.
    */
   explicit AmSend(const decltype(_buffer) buffer,
                   const decltype(_length) length,
-                  const decltype(_memoryType) memoryType = UCS_MEMORY_TYPE_HOST);
+                  const decltype(_memoryType) memoryType     = UCS_MEMORY_TYPE_HOST,
+                  const decltype(_header) header             = {},
+                  const decltype(_amId) amId                 = 0,
+                  const decltype(_memoryHandle) memoryHandle = nullptr,
+                  const decltype(_readiness) readiness       = nullptr);
 
   AmSend() = delete;
 };
@@ -55,15 +76,177 @@ class AmSend {
 class AmReceive {
  public:
   std::shared_ptr<::ucxx::Buffer> _buffer{nullptr};  ///< The AM received message buffer
+  std::string _header{};                             ///< The AM received user-defined header
+  unsigned int _amId{0};                             ///< The active message ID to receive from
 
   /**
    * @brief Constructor for Active Message-specific receive data.
    *
-   * Construct an object containing Active Message-specific receive data. Currently no
-   * specific data to receive Active Message is supported, but this class exists to act as
-   * an operation identifier, providing interface compatibility.
+   * Construct an object containing Active Message-specific receive data.
+   *
+   * @param[in] amId  the active message ID to receive from.
    */
-  AmReceive();
+  explicit AmReceive(const decltype(_amId) amId = 0);
+};
+
+/**
+ * @brief Data for a remote memory put.
+ *
+ * Type identifying a remote memory access (RMA) put operation and containing data specific
+ * to this request type.
+ */
+class MemPut {
+ public:
+  const void* _buffer{nullptr};   ///< The raw pointer where data to be put is stored.
+  const size_t _length{0};        ///< The length of the data.
+  const uint64_t _remoteAddr{0};  ///< The remote address where to put the data.
+  const std::shared_ptr<::ucxx::RemoteKey> _remoteKey{
+    nullptr};  ///< The unpacked remote key of the remote memory.
+  const std::shared_ptr<::ucxx::MemoryHandle> _memoryHandle{
+    nullptr};  ///< The registered memory containing the buffer, if any.
+
+  /**
+   * @brief Constructor for remote memory put-specific data.
+   *
+   * Construct an object containing remote memory put-specific data.
+   *
+   * @param[in] buffer        a raw pointer to the data to be put.
+   * @param[in] length        the size in bytes of the data to be put.
+   * @param[in] remoteAddr    the remote address where to put the data.
+   * @param[in] remoteKey     the unpacked remote key of the remote memory.
+   * @param[in] memoryHandle  the registered memory containing the buffer, or `nullptr`.
+   *
+   * @throws std::runtime_error if the remote key is not unpacked, the remote memory range
+   *                            is not contained in `remoteKey`, or the buffer is not
+   *                            contained in `memoryHandle`.
+   */
+  explicit MemPut(const decltype(_buffer) buffer,
+                  const decltype(_length) length,
+                  const decltype(_remoteAddr) remoteAddr,
+                  const decltype(_remoteKey) remoteKey,
+                  const decltype(_memoryHandle) memoryHandle = nullptr);
+
+  MemPut() = delete;
+};
+
+/**
+ * @brief Data for a remote memory get.
+ *
+ * Type identifying a remote memory access (RMA) get operation and containing data specific
+ * to this request type.
+ */
+class MemGet {
+ public:
+  void* _buffer{nullptr};         ///< The raw pointer where data should be stored.
+  const size_t _length{0};        ///< The length of the data.
+  const uint64_t _remoteAddr{0};  ///< The remote address from where to get the data.
+  const std::shared_ptr<::ucxx::RemoteKey> _remoteKey{
+    nullptr};  ///< The unpacked remote key of the remote memory.
+  const std::shared_ptr<::ucxx::MemoryHandle> _memoryHandle{
+    nullptr};  ///< The registered memory containing the buffer, if any.
+
+  /**
+   * @brief Constructor for remote memory get-specific data.
+   *
+   * Construct an object containing remote memory get-specific data.
+   *
+   * @param[out] buffer        a raw pointer where the data should be stored.
+   * @param[in]  length        the size in bytes of the data to be fetched.
+   * @param[in]  remoteAddr    the remote address from where to get the data.
+   * @param[in]  remoteKey     the unpacked remote key of the remote memory.
+   * @param[in]  memoryHandle  the registered memory containing the buffer, or `nullptr`.
+   *
+   * @throws std::runtime_error if the remote key is not unpacked, the remote memory range
+   *                            is not contained in `remoteKey`, or the buffer is not
+   *                            contained in `memoryHandle`.
+   */
+  explicit MemGet(decltype(_buffer) buffer,
+                  const decltype(_length) length,
+                  const decltype(_remoteAddr) remoteAddr,
+                  const decltype(_remoteKey) remoteKey,
+                  const decltype(_memoryHandle) memoryHandle = nullptr);
+
+  MemGet() = delete;
+};
+
+/**
+ * @brief Data for a remote memory atomic operation.
+ *
+ * Type identifying a 64-bit remote memory atomic operation and containing data specific to
+ * this request type.
+ */
+class MemAtomic {
+ public:
+  const ucp_atomic_op_t _opcode{UCP_ATOMIC_OP_ADD};  ///< The atomic operation to execute.
+  const uint64_t _value{0};                          ///< The operand of the atomic operation.
+  const uint64_t _remoteAddr{0};                     ///< The remote address of the operand.
+  const bool _fetch{false};                          ///< Whether to fetch the remote value.
+  uint64_t _result{0};                               ///< CSWAP compare value, or fetched value
+  const std::shared_ptr<::ucxx::RemoteKey> _remoteKey{
+    nullptr};  ///< The unpacked remote key of the remote memory.
+
+  /**
+   * @brief Constructor for remote memory atomic-specific data.
+   *
+   * Construct an object containing remote memory atomic-specific data.
+   *
+   * @param[in] opcode      the atomic operation to execute.
+   * @param[in] value       the operand of the atomic operation.
+   * @param[in] remoteAddr  the remote address of the 64-bit remote operand.
+   * @param[in] remoteKey   the unpacked remote key of the remote memory.
+   * @param[in] fetch       whether to fetch the original remote value, always `true` for
+   *                        `UCP_ATOMIC_OP_SWAP` and `UCP_ATOMIC_OP_CSWAP`.
+   * @param[in] compare     the value to compare the remote value to, only used for
+   *                        `UCP_ATOMIC_OP_CSWAP`.
+   *
+   * @throws std::runtime_error if the remote key is not unpacked, or the remote operand is
+   *                            not contained in `remoteKey`.
+   */
+  explicit MemAtomic(const decltype(_opcode) opcode,
+                     const decltype(_value) value,
+                     const decltype(_remoteAddr) remoteAddr,
+                     const decltype(_remoteKey) remoteKey,
+                     const decltype(_fetch) fetch = false,
+                     const uint64_t compare       = 0);
+
+  MemAtomic() = delete;
+};
+
+/**
+ * @brief Data for a flush.
+ *
+ * Type identifying a flush operation of an endpoint or worker, completing once all
+ * operations previously issued on it are completed both locally and remotely.
+ */
+class Flush {
+ public:
+  /**
+   * @brief Constructor for flush-specific data.
+   *
+   * Construct an object identifying a flush operation.
+   */
+  Flush() = default;
+};
+
+/**
+ * @brief Data for an endpoint close.
+ *
+ * Type identifying a non-blocking close operation of an endpoint, completing once the
+ * underlying UCP endpoint is closed.
+ */
+class EndpointClose {
+ public:
+  bool _submit{true};  ///< Whether the close is submitted when the request is created
+
+  /**
+   * @brief Constructor for endpoint close-specific data.
+   *
+   * Construct an object identifying an endpoint close operation.
+   *
+   * @param[in] submit  whether the close is submitted when the request is created,
+   *                    otherwise the creator must call `populateDelayedSubmission()`.
+   */
+  explicit EndpointClose(const decltype(_submit) submit = true);
 };
 
 /**
@@ -74,8 +257,9 @@ class AmReceive {
  */
 class StreamSend {
  public:
-  const void* _buffer{nullptr};  ///< The raw pointer where data to be sent is stored.
-  const size_t _length{0};       ///< The length of the message.
+  const void* _buffer{nullptr};            ///< The raw pointer where data to be sent is stored.
+  const size_t _length{0};                 ///< The length of the message.
+  const std::vector<ucp_dt_iov_t> _iov{};  ///< The scattered buffers, if sending an IOV.
 
   /**
    * @brief Constructor for stream-specific data.
@@ -87,6 +271,20 @@ class StreamSend {
    */
   explicit StreamSend(const decltype(_buffer) buffer, const decltype(_length) length);
 
+  /**
+   * @brief Constructor for vectored stream-specific data.
+   *
+   * Construct an object containing stream-specific data for a vectored (IOV) send, where
+   * all buffers are sent as a single message in the order they are specified.
+   *
+   * @param[in] buffer  raw pointers to the data to be sent.
+   * @param[in] length  the size in bytes of each of the buffers to be sent.
+   *
+   * @throws std::runtime_error if sizes of `buffer` and `length` do not match, or if the
+   *                            total length is zero.
+   */
+  explicit StreamSend(const std::vector<void*>& buffer, const std::vector<size_t>& length);
+
   StreamSend() = delete;
 };
 
@@ -98,9 +296,10 @@ class StreamSend {
  */
 class StreamReceive {
  public:
-  void* _buffer{nullptr};     ///< The raw pointer where received data should be stored.
-  const size_t _length{0};    ///< The expected messaged length.
-  size_t _lengthReceived{0};  ///< The actual received message length.
+  void* _buffer{nullptr};      ///< The raw pointer where received data should be stored.
+  const size_t _length{0};     ///< The expected messaged length.
+  size_t _lengthReceived{0};   ///< The actual received message length.
+  const bool _partial{false};  ///< Whether to complete with any data received up to `_length`.
 
   /**
    * @brief Constructor for stream-specific data.
@@ -109,8 +308,12 @@ class StreamReceive {
    *
    * @param[out] buffer   a raw pointer to the received data.
    * @param[in]  length   the size in bytes of the tag message to be received.
+   * @param[in]  partial  whether to complete as soon as any data is received, instead of
+   *                      waiting for `length` bytes.
    */
-  explicit StreamReceive(decltype(_buffer) buffer, const decltype(_length) length);
+  explicit StreamReceive(decltype(_buffer) buffer,
+                         const decltype(_length) length,
+                         const decltype(_partial) partial = false);
 
   StreamReceive() = delete;
 };
@@ -125,19 +328,50 @@ class TagSend {
   const void* _buffer{nullptr};  ///< The raw pointer where data to be sent is stored.
   const size_t _length{0};       ///< The length of the message.
   const ::ucxx::Tag _tag{0};     ///< Tag to match
+  const std::shared_ptr<::ucxx::MemoryHandle> _memoryHandle{
+    nullptr};  ///< The registered memory containing the buffer, if any.
+  const std::vector<ucp_dt_iov_t> _iov{};  ///< The scattered buffers, if sending an IOV.
+  const ::ucxx::RequestReadinessCallback _readiness{
+    nullptr};  ///< Whether the buffer is ready to be sent, if it must be awaited.
 
   /**
    * @brief Constructor for tag/multi-buffer tag-specific data.
    *
    * Construct an object containing tag-specific data.
    *
-   * @param[in] buffer  a raw pointer to the data to be sent.
-   * @param[in] length  the size in bytes of the tag message to be sent.
-   * @param[in] tag     the tag to match.
+   * @param[in] buffer        a raw pointer to the data to be sent.
+   * @param[in] length        the size in bytes of the tag message to be sent.
+   * @param[in] tag           the tag to match.
+   * @param[in] memoryHandle  the registered memory containing the buffer, or `nullptr`.
+   * @param[in] readiness     whether the buffer is ready to be sent, or `nullptr` if it
+   *                          already is.
+   *
+   * @throws std::runtime_error if the buffer is not contained in `memoryHandle`.
    */
   explicit TagSend(const decltype(_buffer) buffer,
                    const decltype(_length) length,
-                   const decltype(_tag) tag);
+                   const decltype(_tag) tag,
+                   const decltype(_memoryHandle) memoryHandle = nullptr,
+                   const decltype(_readiness) readiness       = nullptr);
+
+  /**
+   * @brief Constructor for vectored tag-specific data.
+   *
+   * Construct an object containing tag-specific data for a vectored (IOV) send, where all
+   * buffers are sent as a single tag message in the order they are specified.
+   *
+   * @param[in] buffer     raw pointers to the data to be sent.
+   * @param[in] length     the size in bytes of each of the buffers to be sent.
+   * @param[in] tag        the tag to match.
+   * @param[in] readiness  whether the buffers are ready to be sent, or `nullptr` if they
+   *                       already are.
+   *
+   * @throws std::runtime_error if sizes of `buffer` and `length` do not match.
+   */
+  explicit TagSend(const std::vector<void*>& buffer,
+                   const std::vector<size_t>& length,
+                   const decltype(_tag) tag,
+                   const decltype(_readiness) readiness = nullptr);
 
   TagSend() = delete;
 };
@@ -154,22 +388,70 @@ class TagReceive {
   const size_t _length{0};            ///< The length of the message.
   const ::ucxx::Tag _tag{0};          ///< Tag to match
   const ::ucxx::TagMask _tagMask{0};  ///< Tag mask to use
+  const std::shared_ptr<::ucxx::MemoryHandle> _memoryHandle{
+    nullptr};  ///< The registered memory containing the buffer, if any.
+  const std::vector<ucp_dt_iov_t> _iov{};     ///< The scattered buffers, if receiving an IOV.
+  const ucp_tag_message_h _message{nullptr};  ///< The probed message, if receiving one.
 
   /**
    * @brief Constructor send tag-specific data.
    *
    * Construct an object containing send tag-specific data.
    *
-   * @param[out] buffer   a raw pointer to the received data.
-   * @param[in]  length   the size in bytes of the tag message to be received.
-   * @param[in]  tag      the tag to match.
-   * @param[in]  tagMask  the tag mask to use (only used for receive operations).
+   * @param[out] buffer        a raw pointer to the received data.
+   * @param[in]  length        the size in bytes of the tag message to be received.
+   * @param[in]  tag           the tag to match.
+   * @param[in]  tagMask       the tag mask to use (only used for receive operations).
+   * @param[in]  memoryHandle  the registered memory containing the buffer, or `nullptr`.
+   *
+   * @throws std::runtime_error if the buffer is not contained in `memoryHandle`.
    */
   explicit TagReceive(decltype(_buffer) buffer,
                       const decltype(_length) length,
                       const decltype(_tag) tag,
+                      const decltype(_tagMask) tagMask,
+                      const decltype(_memoryHandle) memoryHandle = nullptr);
+
+  /**
+   * @brief Constructor for vectored receive tag-specific data.
+   *
+   * Construct an object containing receive tag-specific data for a vectored (IOV) receive,
+   * where a single tag message is scattered into all buffers in the order they are
+   * specified.
+   *
+   * @param[out] buffer   raw pointers to pre-allocated memory where received data will be
+   *                      stored.
+   * @param[in]  length   the size in bytes of each of the buffers.
+   * @param[in]  tag      the tag to match.
+   * @param[in]  tagMask  the tag mask to use.
+   *
+   * @throws std::runtime_error if sizes of `buffer` and `length` do not match.
+   */
+  explicit TagReceive(const std::vector<void*>& buffer,
+                      const std::vector<size_t>& length,
+                      const decltype(_tag) tag,
                       const decltype(_tagMask) tagMask);
 
+  /**
+   * @brief Constructor for receive tag-specific data of a probed message.
+   *
+   * Construct an object containing receive tag-specific data for a message previously
+   * probed and removed with `ucxx::Worker::tagProbeMessage()`, which is received without
+   * being matched again.
+   *
+   * @param[in]  message       the probed message.
+   * @param[out] buffer        a raw pointer to the received data.
+   * @param[in]  length        the size in bytes of the buffer.
+   * @param[in]  memoryHandle  the registered memory containing the buffer, or `nullptr`.
+   *
+   * @throws std::invalid_argument  if `message` has no valid handle.
+   * @throws std::runtime_error     if the buffer is not contained in `memoryHandle`.
+   */
+  explicit TagReceive(const ::ucxx::TagMessage& message,
+                      decltype(_buffer) buffer,
+                      const decltype(_length) length,
+                      const decltype(_memoryHandle) memoryHandle = nullptr);
+
   TagReceive() = delete;
 };
 
@@ -185,21 +467,30 @@ class TagMultiSend {
   const std::vector<size_t> _length{};  ///< Lengths of messages.
   const std::vector<int> _isCUDA{};     ///< Flags indicating whether the buffer is CUDA or not.
   const ::ucxx::Tag _tag{0};            ///< Tag to match
+  const size_t _packThreshold{0};       ///< Largest host frame to pack, `0` disables packing.
+  const ::ucxx::RequestReadinessCallback _readiness{
+    nullptr};  ///< Whether the frames are ready to be sent, if it must be awaited.
 
   /**
    * @brief Constructor for send multi-buffer tag-specific data.
    *
    * Construct an object containing tag/multi-buffer tag-specific data.
    *
-   * @param[in] buffer  a raw pointers to the data to be sent.
-   * @param[in] length  the size in bytes of the tag messages to be sent.
-   * @param[in] isCUDA  flags indicating whether buffers being sent are CUDA.
-   * @param[in] tag     the tags to match.
+   * @param[in] buffer         a raw pointers to the data to be sent.
+   * @param[in] length         the size in bytes of the tag messages to be sent.
+   * @param[in] isCUDA         flags indicating whether buffers being sent are CUDA.
+   * @param[in] tag            the tags to match.
+   * @param[in] packThreshold  host frames of up to this size in bytes are packed into a
+   *                           single vectored message, `0` sends one message per frame.
+   * @param[in] readiness      whether the frames are ready to be sent, or `nullptr` if
+   *                           they already are.
    */
   explicit TagMultiSend(const decltype(_buffer)& buffer,
                         const decltype(_length)& length,
                         const decltype(_isCUDA)& isCUDA,
-                        const decltype(_tag) tag);
+                        const decltype(_tag) tag,
+                        const decltype(_packThreshold) packThreshold = 0,
+                        const decltype(_readiness) readiness         = nullptr);
 
   TagMultiSend() = delete;
 };
@@ -212,31 +503,107 @@ class TagMultiSend {
  */
 class TagMultiReceive {
  public:
-  const ::ucxx::Tag _tag{0};          ///< Tag to match
-  const ::ucxx::TagMask _tagMask{0};  ///< Tag mask to use
+  const ::ucxx::Tag _tag{0};                                    ///< Tag to match
+  const ::ucxx::TagMask _tagMask{0};                            ///< Tag mask to use
+  const ::ucxx::TagMultiRecvAllocatorType _allocator{nullptr};  ///< Frames allocator
 
   /**
    * @brief Constructor for receive multi-buffer tag-specific data.
    *
    * Construct an object containing receive multi-buffer tag-specific data.
    *
-   * @param[in]  tag      the tag to match.
-   * @param[in]  tagMask  the tag mask to use (only used for receive operations).
+   * @param[in]  tag        the tag to match.
+   * @param[in]  tagMask    the tag mask to use (only used for receive operations).
+   * @param[in]  allocator  allocator of the buffers to receive frames into, `nullptr`
+   *                        allocates them internally.
    */
-  explicit TagMultiReceive(const decltype(_tag) tag, const decltype(_tagMask) tagMask);
+  explicit TagMultiReceive(const decltype(_tag) tag,
+                           const decltype(_tagMask) tagMask,
+                           const decltype(_allocator) allocator = nullptr);
 
   TagMultiReceive() = delete;
 };
 
+/**
+ * @brief Data for a file send.
+ *
+ * Type identifying a file send operation and containing data specific to this request
+ * type.
+ */
+class FileSend {
+ public:
+  const std::string _path{};    ///< Path of the file to send.
+  const ::ucxx::Tag _tag{0};    ///< Tag to match
+  const size_t _chunkSize{0};   ///< The size in bytes of each chunk read and sent.
+  const size_t _numBuffers{0};  ///< The number of chunk buffers in the ring.
+
+  /**
+   * @brief Constructor for file send-specific data.
+   *
+   * Construct an object containing file send-specific data.
+   *
+   * @param[in] path        path of the file to send.
+   * @param[in] tag         the tag to match.
+   * @param[in] chunkSize   the size in bytes of each chunk read and sent.
+   * @param[in] numBuffers  the number of chunk buffers in the ring, thus the maximum number
+   *                        of chunks in flight.
+   *
+   * @throws std::invalid_argument if `chunkSize` or `numBuffers` is zero.
+   */
+  explicit FileSend(const decltype(_path)& path,
+                    const decltype(_tag) tag,
+                    const decltype(_chunkSize) chunkSize,
+                    const decltype(_numBuffers) numBuffers);
+
+  FileSend() = delete;
+};
+
+/**
+ * @brief Data for a file receive.
+ *
+ * Type identifying a file receive operation and containing data specific to this request
+ * type.
+ */
+class FileReceive {
+ public:
+  const std::string _path{};    ///< Path of the file to write.
+  const ::ucxx::Tag _tag{0};    ///< Tag to match
+  const size_t _numBuffers{0};  ///< The maximum number of chunk receives in flight.
+
+  /**
+   * @brief Constructor for file receive-specific data.
+   *
+   * Construct an object containing file receive-specific data.
+   *
+   * @param[in] path        path of the file to write, created or truncated.
+   * @param[in] tag         the tag to match.
+   * @param[in] numBuffers  the maximum number of chunk receives in flight.
+   *
+   * @throws std::invalid_argument if `numBuffers` is zero.
+   */
+  explicit FileReceive(const decltype(_path)& path,
+                       const decltype(_tag) tag,
+                       const decltype(_numBuffers) numBuffers);
+
+  FileReceive() = delete;
+};
+
 using RequestData = std::variant<std::monostate,
                                  AmSend,
                                  AmReceive,
+                                 MemPut,
+                                 MemGet,
+                                 MemAtomic,
+                                 Flush,
+                                 EndpointClose,
                                  StreamSend,
                                  StreamReceive,
                                  TagSend,
                                  TagReceive,
                                  TagMultiSend,
-                                 TagMultiReceive>;
+                                 TagMultiReceive,
+                                 FileSend,
+                                 FileReceive>;
 
 template <class... Ts>
 struct dispatch : Ts... {
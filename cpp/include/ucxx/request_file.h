@@ -0,0 +1,231 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/endpoint.h>
+#include <ucxx/memory_handle.h>
+#include <ucxx/request.h>
+#include <ucxx/typedefs.h>
+
+namespace ucxx {
+
+/**
+ * @brief Send or receive a file with the UCX Tag API.
+ *
+ * Send or receive a file in fixed-size chunks pipelined with `ucxx::RequestTag`, first
+ * sending/receiving a header with the size of the file and of its chunks, followed by
+ * sending/receiving each chunk with the same tag. The sender reads chunks into a small
+ * ring of registered buffers on a helper thread, reading the next chunk into a buffer as
+ * soon as the send of its previous chunk completes, so that reading from disk overlaps
+ * with the transfers, never blocks the worker progress thread and the file is never fully
+ * held in memory. The receiver writes chunks straight into a
+ * memory mapping of the destination file, with a bounded number of chunk receives in
+ * flight.
+ */
+class RequestFile : public Request {
+ private:
+  std::recursive_mutex _transferMutex{};  ///< Mutex serializing the transfer state
+  int _fileDescriptor{-1};                ///< The file being read or written
+  void* _mapping{nullptr};                ///< The mapping of the file being written
+  std::array<uint64_t, 2> _header{};      ///< The file size and chunk size, in bytes
+  std::shared_ptr<MemoryHandle> _memoryHandle{nullptr};  ///< The ring of chunk buffers
+  std::shared_ptr<Request> _headerRequest{nullptr};      ///< The header send or receive
+  std::vector<std::shared_ptr<Request>> _chunkRequests{};  ///< The chunk request of each slot
+  std::vector<size_t> _freeSlots{};                        ///< Slots without chunks in flight
+  std::condition_variable_any _slotAvailable{};            ///< Signals free slots to the reader
+  std::thread _readerThread{};                             ///< The thread reading chunks to send
+  size_t _totalChunks{0};        ///< The number of chunks of the file
+  size_t _nextChunk{0};          ///< The next chunk to send or receive
+  size_t _completedChunks{0};    ///< The number of chunks transferred successfully
+  size_t _inflightChunks{0};     ///< The number of chunks currently in flight
+  bool _headerCompleted{false};  ///< Whether the header request completed
+  bool _postingChunks{false};    ///< Whether `postChunks()` is running, avoids recursion
+  bool _reading{false};          ///< Whether the reader thread is running
+  bool _completed{false};        ///< Whether the final status was already set
+  ucs_status_t _finalStatus{
+    UCS_OK};  ///< Shortcut to the final status, a.k.a. the first error to occur
+
+  RequestFile()                              = delete;
+  RequestFile(const RequestFile&)            = delete;
+  RequestFile& operator=(RequestFile const&) = delete;
+  RequestFile(RequestFile&& o)               = delete;
+  RequestFile& operator=(RequestFile&& o)    = delete;
+
+  /**
+   * @brief Private constructor of `ucxx::RequestFile`.
+   *
+   * This is the internal implementation of `ucxx::RequestFile` constructor, made private
+   * not to be called directly. This constructor is made private to ensure all UCXX
+   * objects are shared pointers and the correct lifetime management of each one.
+   *
+   * Instead the user should use one of the following:
+   *
+   * - `ucxx::Endpoint::fileSend()`
+   * - `ucxx::Endpoint::fileRecv()`
+   * - `ucxx::createRequestFile()`
+   *
+   * @throws std::ios_base::failure if the file could not be opened.
+   *
+   * @param[in] endpoint            the `std::shared_ptr<Endpoint>` parent component.
+   * @param[in] requestData         container of the specified message type, including all
+   *                                type-specific data.
+   * @param[in] operationName       a human-readable operation name to help identifying
+   *                                requests by their types when UCXX logging is enabled.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   */
+  RequestFile(std::shared_ptr<Endpoint> endpoint,
+              const std::variant<data::FileSend, data::FileReceive> requestData,
+              const std::string operationName,
+              const bool enablePythonFuture);
+
+  /**
+   * @brief Send the header and start sending chunks.
+   *
+   * Send the header, allocate the ring of chunk buffers and post the sends of the first
+   * chunks, one per buffer.
+   */
+  void send();
+
+  /**
+   * @brief Receive the header.
+   *
+   * Post the receive of the header, once it completes the destination file is resized and
+   * mapped, and the receives of the first chunks are posted.
+   */
+  void recvHeader();
+
+  /**
+   * @brief Resize and map the file being received.
+   *
+   * Resize the destination file to `fileSize` bytes and map it for chunks to be received
+   * directly into it.
+   *
+   * @param[in] fileSize  the size of the file being received.
+   *
+   * @returns `true` if the file was resized and mapped, `false` otherwise with `errno` set.
+   */
+  bool mapFile(size_t fileSize);
+
+  /**
+   * @brief Read and send chunks as slots become free.
+   *
+   * Executed by the reader thread, wait for a free slot, read the next chunk into the
+   * slot's buffer without holding `_transferMutex` and post its send, until all chunks
+   * were sent or an error occurred.
+   */
+  void readChunks();
+
+  /**
+   * @brief Post chunk receives while slots are free.
+   *
+   * Post the receive of the next chunks while there are free slots and chunks remaining.
+   * Chunk requests completing immediately only free their slots, which are then reused by
+   * the same call. Must be called with `_transferMutex` locked.
+   */
+  void postChunks();
+
+  /**
+   * @brief Set the final status once nothing is in flight anymore.
+   *
+   * Release the file and its mapping and set the final status once the header and all
+   * chunks completed, or once all requests in flight completed after an error. Must be
+   * called with `_transferMutex` locked.
+   */
+  void checkCompleted();
+
+  /**
+   * @brief Handle the completion of the header request.
+   *
+   * @param[in] status  the status of the header request.
+   */
+  void headerCompleted(ucs_status_t status);
+
+  /**
+   * @brief Handle the completion of a chunk request.
+   *
+   * @param[in] slot    the slot the chunk was transferred with, freed for the next chunk.
+   * @param[in] status  the status of the chunk request.
+   */
+  void chunkCompleted(size_t slot, ucs_status_t status);
+
+ public:
+  /**
+   * @brief Enqueue a file send or receive operation.
+   *
+   * Initiate a file send or receive operation, returning a
+   * `std::shared<ucxx::RequestFile>` that can be later awaited and checked for errors.
+   *
+   * This is a non-blocking operation. When sending, the file is read by a helper thread
+   * owned by the request and must not be modified until the request completes. When
+   * receiving, the destination file is created or truncated immediately and its contents
+   * are only complete once the request completed successfully.
+   *
+   * Using a Python future may be requested by specifying `enablePythonFuture`. If a
+   * Python future is requested, the Python application must then await on this future to
+   * ensure the transfer has completed. Requires UCXX to be compiled with
+   * `UCXX_ENABLE_PYTHON=1`.
+   *
+   * @throws std::ios_base::failure if the file could not be opened.
+   *
+   * @param[in] endpoint            the `std::shared_ptr<Endpoint>` parent component
+   * @param[in] requestData         container of the specified message type, including all
+   *                                type-specific data.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  friend std::shared_ptr<RequestFile> createRequestFile(
+    std::shared_ptr<Endpoint> endpoint,
+    const std::variant<data::FileSend, data::FileReceive> requestData,
+    const bool enablePythonFuture);
+
+  /**
+   * @brief `ucxx::RequestFile` destructor.
+   *
+   * Release the file and its mapping, if still held, and join the reader thread.
+   */
+  virtual ~RequestFile();
+
+  void populateDelayedSubmission() override;
+
+  /**
+   * @brief Cancel the request.
+   *
+   * Cancel the header and all chunk requests in flight, no further chunks are read or
+   * posted and the request completes with `UCS_ERR_CANCELED` once they completed.
+   */
+  void cancel() override;
+
+  /**
+   * @brief Abort the request.
+   *
+   * Cancel the request, the header and chunk requests are tracked by the endpoint and
+   * aborted along with it, completing this request once they all completed.
+   */
+  void abort() override;
+};
+
+/**
+ * @brief Pre-defined type for a pointer to an `ucxx::RequestFile`.
+ *
+ * A pre-defined type for a pointer to a `ucxx::RequestFile`, used as a convenience type.
+ */
+typedef std::shared_ptr<RequestFile> RequestFilePtr;
+
+}  // namespace ucxx
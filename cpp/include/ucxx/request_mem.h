@@ -0,0 +1,135 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/delayed_submission.h>
+#include <ucxx/request.h>
+#include <ucxx/request_data.h>
+#include <ucxx/typedefs.h>
+
+namespace ucxx {
+
+/**
+ * @brief Access remote memory with the UCX RMA and atomic APIs.
+ *
+ * Put or get data to or from remote memory with the UCX remote memory access (RMA) API,
+ * or execute atomic operations on remote memory, using non-blocking UCP calls
+ * `ucp_put_nbx`, `ucp_get_nbx` or `ucp_atomic_op_nbx`. These are one-sided operations that
+ * do not involve the remote process, which must have previously registered the memory and
+ * shared its remote key, see `ucxx::RemoteKey`.
+ *
+ * Completion of a put request only guarantees the local buffer may be reused, it does not
+ * guarantee the data is visible in the remote memory, which requires a flush.
+ */
+class RequestMem : public Request {
+ private:
+  /**
+   * @brief Private constructor of `ucxx::RequestMem`.
+   *
+   * This is the internal implementation of `ucxx::RequestMem` constructor, made private
+   * not to be called directly. This constructor is made private to ensure all UCXX objects
+   * are shared pointers and the correct lifetime management of each one.
+   *
+   * Instead the user should use one of the following:
+   *
+   * - `ucxx::Endpoint::memAtomic()`
+   * - `ucxx::Endpoint::memGet()`
+   * - `ucxx::Endpoint::memPut()`
+   * - `ucxx::createRequestMem()`
+   *
+   * @param[in] endpoint            the `std::shared_ptr<Endpoint>` parent component
+   * @param[in] requestData         container of the specified operation type, including all
+   *                                type-specific data.
+   * @param[in] operationName       a human-readable operation name to help identifying
+   *                                requests by their types when UCXX logging is enabled.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   */
+  RequestMem(std::shared_ptr<Endpoint> endpoint,
+             const std::variant<data::MemPut, data::MemGet, data::MemAtomic> requestData,
+             const std::string operationName,
+             const bool enablePythonFuture                = false,
+             RequestCallbackUserFunction callbackFunction = nullptr,
+             RequestCallbackUserData callbackData         = nullptr);
+
+ public:
+  /**
+   * @brief Constructor for `std::shared_ptr<ucxx::RequestMem>`.
+   *
+   * The constructor for a `std::shared_ptr<ucxx::RequestMem>` object, creating a put, get
+   * or atomic remote memory access request, returning a pointer to a request object that
+   * can be later awaited and checked for errors. This is a non-blocking operation, and the
+   * status of the transfer must be verified from the resulting request object before the
+   * data can be released (for a put operation) or consumed (for a get or fetching atomic
+   * operation).
+   *
+   * @param[in] endpoint            the `std::shared_ptr<Endpoint>` parent component
+   * @param[in] requestData         container of the specified operation type, including all
+   *                                type-specific data.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   *
+   * @returns The `shared_ptr<ucxx::RequestMem>` object
+   */
+  friend std::shared_ptr<RequestMem> createRequestMem(
+    std::shared_ptr<Endpoint> endpoint,
+    const std::variant<data::MemPut, data::MemGet, data::MemAtomic> requestData,
+    const bool enablePythonFuture,
+    RequestCallbackUserFunction callbackFunction,
+    RequestCallbackUserData callbackData);
+
+  virtual void populateDelayedSubmission();
+
+  /**
+   * @brief Create and submit a remote memory access request.
+   *
+   * This is the method that should be called to actually submit a remote memory access
+   * request. It is meant to be called from `populateDelayedSubmission()`, which is decided
+   * at the discretion of `std::shared_ptr<ucxx::Worker>`. See `populateDelayedSubmission()`
+   * for more details.
+   */
+  void request();
+
+  /**
+   * @brief Callback executed by UCX when a remote memory access request is completed.
+   *
+   * Callback executed by UCX when a put, get or atomic request is completed, that will dispatch
+   * `ucxx::Request::callback()`.
+   *
+   * WARNING: This is not intended to be called by the user, but it currently needs to be
+   * a public method so that UCX may access it. In future changes this will be moved to
+   * an internal object and remove this method from the public API.
+   *
+   * @param[in] request the UCX request pointer.
+   * @param[in] status  the completion status of the request.
+   * @param[in] arg     the pointer to the `ucxx::Request` object that created the
+   *                    transfer, effectively `this` pointer as seen by `request()`.
+   */
+  static void memCallback(void* request, ucs_status_t status, void* arg);
+
+  /**
+   * @brief Get the fetched result of an atomic operation.
+   *
+   * Get the original remote value fetched by an atomic operation, only valid after the
+   * request completed successfully and if the value was fetched.
+   *
+   * @throws std::runtime_error if this is not an atomic operation or the value was not
+   *                            fetched.
+   *
+   * @returns The original remote value.
+   */
+  uint64_t getAtomicResult() override;
+};
+
+}  // namespace ucxx
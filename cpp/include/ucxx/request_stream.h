@@ -33,6 +33,7 @@ class RequestStream : public Request {
    * Instead the user should use one of the following:
    *
    * - `ucxx::Endpoint::streamRecv()`
+   * - `ucxx::Endpoint::streamRecvPartial()`
    * - `ucxx::Endpoint::streamSend()`
    * - `ucxx::createRequestStream()`
    *
@@ -135,6 +136,18 @@ class RequestStream : public Request {
    *                    transfer, effectively `this` pointer as seen by `request()`.
    */
   static void streamRecvCallback(void* request, ucs_status_t status, size_t length, void* arg);
+
+  /**
+   * @brief Get the length of the data received.
+   *
+   * Get the number of bytes received by a stream receive operation, equal to the requested
+   * length unless the receive was posted with `ucxx::Endpoint::streamRecvPartial()`.
+   *
+   * @throws std::runtime_error if the request is a stream send operation.
+   *
+   * @return The number of bytes received.
+   */
+  size_t getRecvLength() override;
 };
 
 }  // namespace ucxx
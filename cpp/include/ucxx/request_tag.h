@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <ucp/api/ucp.h>
 
@@ -23,6 +24,8 @@ namespace ucxx {
  */
 class RequestTag : public Request {
  private:
+  TagRecvInfo _recvInfo{};  ///< Information of the completed tag receive
+
   /**
    * @brief Private constructor of `ucxx::RequestTag`.
    *
@@ -91,6 +94,35 @@ class RequestTag : public Request {
     RequestCallbackUserFunction callbackFunction,
     RequestCallbackUserData callbackData);
 
+  /**
+   * @brief Constructor for a batch of `std::shared_ptr<ucxx::RequestTag>`.
+   *
+   * Create multiple send and/or receive tag requests at once, equivalent to calling
+   * `createRequestTag()` for each element of `requestData`, except that all requests are
+   * registered as a single delayed submission item, thus the worker is signaled only
+   * once for the entire batch. All requests share the same `enablePythonFuture`,
+   * `callbackFunction` and `callbackData`.
+   *
+   * @throws ucxx::Error  if `endpoint` is not a valid `std::shared_ptr<ucxx::Endpoint>`.
+   *
+   * @param[in] endpoint            the `std::shared_ptr<Endpoint>` parent component.
+   * @param[in] requestData         container of the specified message type of each
+   *                                request, including all type-specific data.
+   * @param[in] enablePythonFuture  whether a python future should be created and
+   *                                subsequently notified for each request.
+   * @param[in] callbackFunction    user-defined callback function to call upon completion.
+   * @param[in] callbackData        user-defined data to pass to the `callbackFunction`.
+   *
+   * @returns The `shared_ptr<ucxx::RequestTag>` objects, in the same order as
+   *          `requestData`.
+   */
+  friend std::vector<std::shared_ptr<RequestTag>> createRequestTagBatch(
+    std::shared_ptr<Endpoint> endpoint,
+    const std::vector<std::variant<data::TagSend, data::TagReceive>>& requestData,
+    const bool enablePythonFuture,
+    RequestCallbackUserFunction callbackFunction,
+    RequestCallbackUserData callbackData);
+
   virtual void populateDelayedSubmission();
 
   /**
@@ -158,6 +190,16 @@ class RequestTag : public Request {
    *                    length of message received used to verify for truncation.
    */
   void callback(void* request, ucs_status_t status, const ucp_tag_recv_info_t* info);
+
+  /**
+   * @brief Get the information of the completed tag receive.
+   *
+   * Get the tag and length of the message received, only valid after a tag receive
+   * request completed successfully.
+   *
+   * @returns The information of the completed tag receive.
+   */
+  TagRecvInfo getRecvInfo();
 };
 
 }  // namespace ucxx
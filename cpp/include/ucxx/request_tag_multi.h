@@ -15,6 +15,7 @@
 #include <ucxx/endpoint.h>
 #include <ucxx/future.h>
 #include <ucxx/request.h>
+#include <ucxx/typedefs.h>
 
 namespace ucxx {
 
@@ -30,7 +31,9 @@ class RequestTagMulti;
 struct BufferRequest {
   std::shared_ptr<Request> request{nullptr};  ///< The `ucxx::RequestTag` of a header or frame
   std::shared_ptr<std::string> stringBuffer{nullptr};  ///< Serialized `Header`
-  std::shared_ptr<Buffer> buffer{nullptr};  ///< Internally allocated buffer to receive a frame
+  std::shared_ptr<Buffer> buffer{nullptr};  ///< Buffer to receive a frame
+  std::shared_ptr<Buffer> compressedBuffer{
+    nullptr};  ///< Buffer to send or receive a compressed frame, if compressed
 
   BufferRequest();
   ~BufferRequest();
@@ -55,11 +58,13 @@ typedef std::shared_ptr<BufferRequest> BufferRequestPtr;
  * messages with `ucxx::RequestTag`, first sending/receiving a header, followed by
  * sending/receiving the user messages. Intended primarily for use with Python, such that
  * the program can then only wait for the completion of one future and thus reduce
- * potentially expensive iterations over multiple futures.
+ * potentially expensive iterations over multiple futures. Host frames may be compressed
+ * before being sent, see `ucxx::Worker::setCompression()`.
  */
 class RequestTagMulti : public Request {
  private:
-  size_t _totalFrames{0};  ///< The total number of frames handled by this request
+  size_t _totalFrames{0};         ///< The total number of frames handled by this request
+  size_t _totalFrameRequests{0};  ///< The number of requests transferring frames
   std::mutex
     _completedRequestsMutex{};   ///< Mutex to control access to completed requests container
   size_t _completedRequests{0};  ///< Count requests that already completed
@@ -107,7 +112,8 @@ class RequestTagMulti : public Request {
    * Once the header(s) has(have) been received, receiving frames containing the actual data
    * is the next step. This method parses the header(s) and creates as many
    * `ucxx::RequestTag` objects as necessary, each one that will handle a single sending or
-   * receiving a single frame.
+   * receiving a single frame, except for frames the sender packed, which are all received
+   * by a single vectored request.
    *
    * Finally, the object is marked as filled, meaning that all requests were already
    * scheduled and are waiting for completion.
@@ -130,10 +136,50 @@ class RequestTagMulti : public Request {
   /**
    * @brief Send all header(s) and frame(s).
    *
-   * Build header request(s) and send them, followed by requests to send all frame(s).
+   * Build header request(s) and send them, followed by requests to send all frame(s). If
+   * packing is enabled, all packed frames are sent first with a single vectored request,
+   * followed by one request for each of the remaining frames.
    */
   void send();
 
+  /**
+   * @brief Compress the frames eligible for compression.
+   *
+   * Compress the host frames of a send eligible for compression according to the worker
+   * configuration, see `ucxx::Worker::setCompression()`, in parallel if the worker has
+   * compression threads, and block until all of them have been compressed.
+   *
+   * @param[in]  tagMultiSend      the send request data.
+   * @param[in]  isCUDA            the header type of each frame, packed frames are skipped.
+   * @param[out] compressedSize    the size of each frame once compressed, `0` for frames
+   *                               sent verbatim, left empty if no frame was compressed.
+   * @param[out] compressedBuffer  the buffer of each compressed frame.
+   *
+   * @returns The codec frames were compressed with.
+   */
+  CompressionCodec compressFrames(const data::TagMultiSend& tagMultiSend,
+                                  const std::vector<int>& isCUDA,
+                                  std::vector<size_t>& compressedSize,
+                                  std::vector<std::shared_ptr<Buffer>>& compressedBuffer);
+
+  /**
+   * @brief Decompress a frame once received.
+   *
+   * Callback of the receive of a compressed frame, decompressing it into the frame buffer
+   * on the worker compression threads, if any, and then marking it completed.
+   *
+   * @param[in] status          the status of the compressed frame receive.
+   * @param[in] request         the `ucxx::BufferRequest` of the frame.
+   * @param[in] codec           the codec the frame was compressed with.
+   * @param[in] compressedSize  the size in bytes of the compressed frame.
+   * @param[in] size            the size in bytes of the frame.
+   */
+  void decompressFrame(ucs_status_t status,
+                       RequestCallbackUserData request,
+                       CompressionCodec codec,
+                       size_t compressedSize,
+                       size_t size);
+
  public:
   /**
    * @brief Enqueue a multi-buffer tag send operation.
@@ -223,6 +269,14 @@ class RequestTagMulti : public Request {
   void populateDelayedSubmission() override;
 
   void cancel() override;
+
+  /**
+   * @brief Abort the request.
+   *
+   * Cancel the request, the requests of its buffers are tracked by the endpoint and
+   * aborted along with it, completing this request once they all completed.
+   */
+  void abort() override;
 };
 
 /**
@@ -0,0 +1,136 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ucs/type/status.h>
+
+namespace ucxx {
+
+/**
+ * @brief Timestamped lifecycle events of a single request.
+ *
+ * The lifecycle events of a sampled request, all timestamps are in nanoseconds of
+ * `std::chrono::steady_clock` and are `0` if the request never went through that stage,
+ * e.g., `submitted` is `0` if the request was canceled before it was handed to UCX.
+ * The difference between consecutive stages tells where the latency of a request comes
+ * from: `submitted - created` is the time spent in the delayed submission queue,
+ * `completed - submitted` the time spent in UCX (i.e., on the wire) and
+ * `notified - completed` the time spent setting the status, which includes notifying the
+ * Python future and executing the user callback.
+ */
+struct RequestTrace {
+  std::string operationName{};          ///< Human-readable operation name of the request
+  ucs_status_t status{UCS_INPROGRESS};  ///< The final status of the request
+  uint64_t created{0};                  ///< Time the request was created
+  uint64_t submitted{0};                ///< Time the request was handed to UCX
+  uint64_t completed{0};                ///< Time UCX completed the request
+  uint64_t notified{0};                 ///< Time the request status was set and future notified
+};
+
+/**
+ * @brief Sampled tracer of request lifecycles.
+ *
+ * Samples 1 in `sampleRate` requests and keeps the traces of the most recently completed
+ * sampled requests in a ring buffer of fixed capacity, from which they can be exported
+ * with `getTraces()`. Deciding whether a request is sampled costs a single relaxed atomic
+ * load when tracing is disabled, and only sampled requests ever acquire the ring buffer
+ * lock.
+ */
+class RequestTracer {
+ private:
+  std::atomic<uint64_t> _sampleRate{0};     ///< Trace 1 in `_sampleRate` requests, 0 disables
+  std::atomic<uint64_t> _sampleCounter{0};  ///< Number of requests considered for sampling
+  mutable std::mutex _mutex{};              ///< Mutex to access the ring buffer
+  std::vector<RequestTrace> _traces{};      ///< The ring buffer of traces
+  size_t _capacity{0};                      ///< Capacity of the ring buffer
+  size_t _next{0};                          ///< Index of the ring buffer to write next
+  uint64_t _dropped{0};  ///< Number of traces overwritten before being exported
+
+ public:
+  RequestTracer() = default;
+
+  RequestTracer(const RequestTracer&)            = delete;
+  RequestTracer& operator=(RequestTracer const&) = delete;
+  RequestTracer(RequestTracer&& o)               = delete;
+  RequestTracer& operator=(RequestTracer&& o)    = delete;
+
+  /**
+   * @brief Configure sampling and the ring buffer capacity.
+   *
+   * Configure the tracer to sample 1 in `sampleRate` requests, keeping up to `capacity`
+   * traces. Reconfiguring the tracer discards all traces currently held.
+   *
+   * @throws std::runtime_error if `sampleRate` is positive and `capacity` is `0`.
+   *
+   * @param[in] sampleRate  trace 1 in `sampleRate` requests, `0` disables tracing.
+   * @param[in] capacity    maximum number of traces kept.
+   */
+  void configure(uint64_t sampleRate, size_t capacity);
+
+  /**
+   * @brief Configure the tracer from environment variables.
+   *
+   * Configure the tracer from `UCXX_REQUEST_TRACE_SAMPLE_RATE` and
+   * `UCXX_REQUEST_TRACE_CAPACITY` (default: 1024), tracing remains disabled if the
+   * former is not set or is `0`.
+   */
+  void configureFromEnvironment();
+
+  /**
+   * @brief Decide whether a new request should be traced.
+   *
+   * @returns `true` if the request should be traced, `false` otherwise.
+   */
+  bool sample()
+  {
+    auto sampleRate = _sampleRate.load(std::memory_order_relaxed);
+    return sampleRate > 0 &&
+           _sampleCounter.fetch_add(1, std::memory_order_relaxed) % sampleRate == 0;
+  }
+
+  /**
+   * @brief Record the trace of a completed request.
+   *
+   * Record the trace of a completed request, overwriting the oldest trace if the ring
+   * buffer is full.
+   *
+   * @param[in] trace the trace to record.
+   */
+  void record(RequestTrace trace);
+
+  /**
+   * @brief Get all traces currently held.
+   *
+   * @param[in] clear whether to discard the traces after copying them.
+   *
+   * @returns The traces, ordered from oldest to newest.
+   */
+  std::vector<RequestTrace> getTraces(bool clear = false);
+
+  /**
+   * @brief Get the number of traces overwritten before being exported.
+   *
+   * A non-zero value indicates the capacity is too small for the rate `getTraces()` is
+   * called at.
+   *
+   * @returns The number of traces overwritten.
+   */
+  uint64_t getDropped() const;
+
+  /**
+   * @brief Get the current time as used for trace timestamps.
+   *
+   * @returns The current time of `std::chrono::steady_clock` in nanoseconds.
+   */
+  static uint64_t now();
+};
+
+}  // namespace ucxx
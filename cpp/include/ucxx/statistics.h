@@ -0,0 +1,215 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <ucs/type/status.h>
+
+namespace ucxx {
+
+/**
+ * @brief Snapshot of the statistics of a `ucxx::Endpoint`.
+ *
+ * Counters of requests created by the endpoint since it was created, counters are
+ * monotonically increasing and can be sampled periodically to compute rates.
+ */
+struct EndpointStatistics {
+  uint64_t requestsSubmitted{0};  ///< Number of requests created
+  uint64_t requestsCompleted{0};  ///< Number of requests completed successfully
+  uint64_t requestsFailed{0};     ///< Number of requests completed with an error
+  uint64_t requestsCanceled{0};   ///< Number of requests canceled
+};
+
+/**
+ * @brief Snapshot of the statistics of a `ucxx::Worker`.
+ *
+ * Counters of requests created by the worker and all its endpoints, and of the worker
+ * progress since the worker was created. Counters are monotonically increasing and can
+ * be sampled periodically to compute rates, e.g., a `requestsSubmitted` rate
+ * consistently higher than the rate of completions indicates a growing backlog, and a
+ * low ratio of `progressCallsWithProgress` to `progressCalls` combined with a high
+ * `delayedSubmissionProcessNs` indicates the progress thread is starved by delayed
+ * submissions. When compression is enabled, the compression ratio is given by
+ * `compressionInputBytes / compressionOutputBytes`.
+ */
+struct WorkerStatistics {
+  uint64_t requestsSubmitted{0};  ///< Number of requests created
+  uint64_t requestsCompleted{0};  ///< Number of requests completed successfully
+  uint64_t requestsFailed{0};     ///< Number of requests completed with an error
+  uint64_t requestsCanceled{0};   ///< Number of requests canceled
+  uint64_t requestsDelayed{0};    ///< Number of requests registered for delayed submission
+  uint64_t requestsTimedOut{0};   ///< Number of requests canceled when their deadline expired
+  uint64_t progressCalls{0};      ///< Number of calls to `ucxx::Worker::progress()`
+  uint64_t progressCallsWithProgress{
+    0};  ///< Number of calls to `ucxx::Worker::progress()` that progressed communication
+  uint64_t progressSpinHits{0};  ///< Number of times `progressHybrid()` did not block
+  uint64_t progressSleeps{0};    ///< Number of times `progressHybrid()` blocked
+  uint64_t progressBudgetExhausted{
+    0};  ///< Number of times `ucxx::Worker::progress()` stopped with communication pending
+  uint64_t delayedSubmissionCallbacks{0};  ///< Number of delayed submission callbacks executed
+  uint64_t delayedSubmissionProcessNs{
+    0};  ///< Total time in nanoseconds spent executing delayed submission callbacks
+  uint64_t futuresPoolRefills{0};  ///< Number of times the futures pool was refilled
+  uint64_t framesCompressed{0};    ///< Number of frames sent compressed
+  uint64_t framesNotCompressed{
+    0};  ///< Number of frames eligible for compression sent verbatim, as they did not shrink
+  uint64_t compressionInputBytes{0};   ///< Total size in bytes of frames before compression
+  uint64_t compressionOutputBytes{0};  ///< Total size in bytes of frames after compression
+  uint64_t compressionNs{0};           ///< Total time in nanoseconds spent compressing frames
+  uint64_t framesDecompressed{0};      ///< Number of frames received compressed
+  uint64_t decompressionNs{0};         ///< Total time in nanoseconds spent decompressing frames
+};
+
+/**
+ * @brief Snapshot of the statistics of a `ucxx::Listener`.
+ *
+ * Counters of connection requests handled by a listener created with a backlog since it
+ * was created, and the current and maximum depth of its connection request queue. A
+ * growing `connectionRequestsRejected` indicates the application is not accepting
+ * endpoints as fast as clients connect and the backlog should be increased or endpoints
+ * accepted more frequently.
+ */
+struct ListenerStatistics {
+  uint64_t connectionRequestsReceived{0};  ///< Number of connection requests received
+  uint64_t connectionRequestsAccepted{0};  ///< Number of endpoints accepted from the queue
+  uint64_t connectionRequestsRejected{0};  ///< Number of requests rejected, queue was full
+  uint64_t queueDepth{0};                  ///< Number of connection requests currently queued
+  uint64_t maxQueueDepth{0};               ///< Maximum number of requests queued at once
+};
+
+namespace internal {
+
+/**
+ * @brief Counters of the requests of a component.
+ *
+ * Thread-safe counters of the requests created and completed by a `ucxx::Worker` or
+ * `ucxx::Endpoint`, using relaxed atomics as the counters are independent of each other
+ * and do not order any other memory operations.
+ */
+class RequestCounters {
+ private:
+  std::atomic<uint64_t> _submitted{0};  ///< Number of requests created
+  std::atomic<uint64_t> _completed{0};  ///< Number of requests completed successfully
+  std::atomic<uint64_t> _failed{0};     ///< Number of requests completed with an error
+  std::atomic<uint64_t> _canceled{0};   ///< Number of requests canceled
+
+ public:
+  /**
+   * @brief Count a request that has been created.
+   */
+  void submitted() { _submitted.fetch_add(1, std::memory_order_relaxed); }
+
+  /**
+   * @brief Count a request that has completed.
+   *
+   * @param[in] status  the final status the request completed with.
+   */
+  void completed(ucs_status_t status)
+  {
+    if (status == UCS_OK)
+      _completed.fetch_add(1, std::memory_order_relaxed);
+    else if (status == UCS_ERR_CANCELED)
+      _canceled.fetch_add(1, std::memory_order_relaxed);
+    else
+      _failed.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Copy the current value of the counters to a statistics snapshot.
+   *
+   * @param[out] statistics the `EndpointStatistics` or `WorkerStatistics` to fill.
+   */
+  template <typename Statistics>
+  void fill(Statistics& statistics) const
+  {
+    statistics.requestsSubmitted = _submitted.load(std::memory_order_relaxed);
+    statistics.requestsCompleted = _completed.load(std::memory_order_relaxed);
+    statistics.requestsFailed    = _failed.load(std::memory_order_relaxed);
+    statistics.requestsCanceled  = _canceled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the number of requests that have finished.
+   *
+   * @returns The number of requests completed successfully, with an error or canceled.
+   */
+  uint64_t finished() const
+  {
+    return _completed.load(std::memory_order_relaxed) + _failed.load(std::memory_order_relaxed) +
+           _canceled.load(std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief Counters of the frames compressed and decompressed by a worker.
+ *
+ * Thread-safe counters of the frames of multi-buffer transfers compressed and
+ * decompressed by a `ucxx::Worker`, using relaxed atomics as the counters are independent
+ * of each other and do not order any other memory operations.
+ */
+class CompressionCounters {
+ private:
+  std::atomic<uint64_t> _compressed{0};       ///< Number of frames sent compressed
+  std::atomic<uint64_t> _notCompressed{0};    ///< Number of frames sent verbatim
+  std::atomic<uint64_t> _inputBytes{0};       ///< Size of frames before compression
+  std::atomic<uint64_t> _outputBytes{0};      ///< Size of frames after compression
+  std::atomic<uint64_t> _compressionNs{0};    ///< Time spent compressing frames
+  std::atomic<uint64_t> _decompressed{0};     ///< Number of frames received compressed
+  std::atomic<uint64_t> _decompressionNs{0};  ///< Time spent decompressing frames
+
+ public:
+  /**
+   * @brief Count a frame that has been compressed.
+   *
+   * @param[in] inputBytes  the size of the frame before compression.
+   * @param[in] outputBytes the size of the frame after compression, `0` if it was sent
+   *                        verbatim as it did not shrink.
+   * @param[in] ns          the time in nanoseconds spent compressing the frame.
+   */
+  void compressed(uint64_t inputBytes, uint64_t outputBytes, uint64_t ns)
+  {
+    if (outputBytes > 0) {
+      _compressed.fetch_add(1, std::memory_order_relaxed);
+      _inputBytes.fetch_add(inputBytes, std::memory_order_relaxed);
+      _outputBytes.fetch_add(outputBytes, std::memory_order_relaxed);
+    } else {
+      _notCompressed.fetch_add(1, std::memory_order_relaxed);
+    }
+    _compressionNs.fetch_add(ns, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Count a frame that has been decompressed.
+   *
+   * @param[in] ns  the time in nanoseconds spent decompressing the frame.
+   */
+  void decompressed(uint64_t ns)
+  {
+    _decompressed.fetch_add(1, std::memory_order_relaxed);
+    _decompressionNs.fetch_add(ns, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Copy the current value of the counters to a statistics snapshot.
+   *
+   * @param[out] statistics the `WorkerStatistics` to fill.
+   */
+  void fill(WorkerStatistics& statistics) const
+  {
+    statistics.framesCompressed       = _compressed.load(std::memory_order_relaxed);
+    statistics.framesNotCompressed    = _notCompressed.load(std::memory_order_relaxed);
+    statistics.compressionInputBytes  = _inputBytes.load(std::memory_order_relaxed);
+    statistics.compressionOutputBytes = _outputBytes.load(std::memory_order_relaxed);
+    statistics.compressionNs          = _compressionNs.load(std::memory_order_relaxed);
+    statistics.framesDecompressed     = _decompressed.load(std::memory_order_relaxed);
+    statistics.decompressionNs        = _decompressionNs.load(std::memory_order_relaxed);
+  }
+};
+
+}  // namespace internal
+
+}  // namespace ucxx
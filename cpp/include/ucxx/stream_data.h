@@ -0,0 +1,102 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include <ucp/api/ucp.h>
+
+namespace ucxx {
+
+class Endpoint;
+
+/**
+ * @brief Stream data received without copying.
+ *
+ * Data received by an endpoint with `ucxx::Endpoint::streamRecvData()`, owned by UCX
+ * internal buffers and accessed in place, avoiding the copy to a user buffer. The data is
+ * returned to UCX when the object is released or destroyed, after which it must not be
+ * accessed anymore.
+ *
+ * @code{.cpp}
+ * // `endpoint` is `std::shared_ptr<ucxx::Endpoint>`
+ * while (auto streamData = endpoint->streamRecvData())
+ *   parse(streamData->data(), streamData->size());
+ * @endcode
+ */
+class StreamData {
+ private:
+  std::shared_ptr<Endpoint> _endpoint{nullptr};  ///< The endpoint the data was received on
+  void* _data{nullptr};                          ///< The data owned by UCX
+  size_t _length{0};                             ///< The length of the data in bytes
+
+  /**
+   * @brief Private constructor of `ucxx::StreamData`.
+   *
+   * This is the internal implementation of `ucxx::StreamData` constructor, made private
+   * not to be called directly. Instead the user should call
+   * `ucxx::Endpoint::streamRecvData()`.
+   *
+   * @param[in] endpoint  the endpoint the data was received on.
+   * @param[in] data      the data returned by `ucp_stream_recv_data_nb`.
+   * @param[in] length    the length of the data in bytes.
+   */
+  StreamData(std::shared_ptr<Endpoint> endpoint, void* data, size_t length);
+
+ public:
+  StreamData()                             = delete;
+  StreamData(const StreamData&)            = delete;
+  StreamData& operator=(StreamData const&) = delete;
+  StreamData(StreamData&& o)               = delete;
+  StreamData& operator=(StreamData&& o)    = delete;
+
+  /**
+   * @brief Constructor of `shared_ptr<ucxx::StreamData>`.
+   *
+   * The constructor for a `shared_ptr<ucxx::StreamData>` object, taking ownership of data
+   * returned by `ucp_stream_recv_data_nb`.
+   *
+   * @param[in] endpoint  the endpoint the data was received on.
+   * @param[in] data      the data returned by `ucp_stream_recv_data_nb`.
+   * @param[in] length    the length of the data in bytes.
+   *
+   * @returns The `shared_ptr<ucxx::StreamData>` object.
+   */
+  friend std::shared_ptr<StreamData> createStreamData(std::shared_ptr<Endpoint> endpoint,
+                                                      void* data,
+                                                      size_t length);
+
+  /**
+   * @brief `ucxx::StreamData` destructor.
+   *
+   * Returns the data to UCX, see `release()`.
+   */
+  ~StreamData();
+
+  /**
+   * @brief Get a pointer to the data.
+   *
+   * @returns The pointer to the data, or `nullptr` if already released.
+   */
+  const void* data() const;
+
+  /**
+   * @brief Get the length of the data.
+   *
+   * @returns The length of the data in bytes, or `0` if already released.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Return the data to UCX.
+   *
+   * Return the data to UCX with `ucp_stream_data_release`, after which it must not be
+   * accessed anymore. Calling it on data already released has no effect.
+   */
+  void release();
+};
+
+}  // namespace ucxx
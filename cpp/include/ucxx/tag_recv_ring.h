@@ -0,0 +1,223 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/typedefs.h>
+
+namespace ucxx {
+
+class RequestTag;
+class Worker;
+
+/**
+ * @brief A ring of tag receives from any endpoint that are posted again upon completion.
+ *
+ * Keep a fixed number of tag receives posted on the worker, each with its own
+ * pre-allocated buffer and matching the same tag and tag mask, posting each receive again
+ * once its message has been handled. Servers handling many small messages from arbitrary
+ * peers thus avoid the latency of posting a receive for each message, and messages are
+ * matched by the UCX expected queue instead of being buffered as unexpected messages.
+ *
+ * Messages are delivered either to a user-defined callback, in which case each buffer is
+ * posted again as soon as the callback returns, or, if no callback is specified, to a
+ * queue the application harvests with `poll()`, in which case each buffer is only posted
+ * again once the application is done with it and calls `release()`.
+ *
+ * @code{.cpp}
+ * // `worker` is `std::shared_ptr<ucxx::Worker>`
+ * auto ring = worker->createTagRecvRing(
+ *   64, 4096, ucxx::Tag{0x10}, ucxx::TagMask{0xff}, [](const ucxx::TagRecvRingCompletion& c) {
+ *     if (c.status == UCS_OK) handleMessage(c.buffer, c.info.length, c.info.senderTag);
+ *   });
+ * @endcode
+ */
+class TagRecvRing : public std::enable_shared_from_this<TagRecvRing> {
+ private:
+  /**
+   * @brief The state of a ring buffer.
+   */
+  struct Slot {
+    std::shared_ptr<std::vector<char>> buffer{nullptr};  ///< The buffer to receive into
+    std::shared_ptr<RequestTag> request{nullptr};        ///< The receive posted, if any
+    bool completed{false};                               ///< Whether it completed early
+    ucs_status_t status{UCS_OK};                         ///< The status if completed early
+  };
+
+  std::shared_ptr<Worker> _worker{nullptr};          ///< The worker receives are posted on
+  Tag _tag{0};                                       ///< The tag receives match
+  TagMask _tagMask{0};                               ///< The tag mask receives match
+  size_t _bufferSize{0};                             ///< The size of each ring buffer
+  TagRecvRingCallback _callback{nullptr};            ///< The user-defined callback, if any
+  std::mutex _mutex{};                               ///< Mutex to access the ring state
+  std::vector<Slot> _slots{};                        ///< The ring buffers
+  std::deque<TagRecvRingCompletion> _completions{};  ///< Completions awaiting `poll()`
+  bool _stopped{false};                              ///< Whether the ring was stopped
+  uint64_t _received{0};                             ///< Number of messages received
+
+  /**
+   * @brief Private constructor of `ucxx::TagRecvRing`.
+   *
+   * This is the internal implementation of `ucxx::TagRecvRing` constructor, made private
+   * not to be called directly. Instead the user should call
+   * `ucxx::Worker::createTagRecvRing()` or `ucxx::createTagRecvRing()`.
+   *
+   * @throws std::invalid_argument if `worker` is `nullptr`, or `numBuffers` or
+   *                               `bufferSize` is `0`.
+   *
+   * @param[in] worker      the worker to post receives on.
+   * @param[in] numBuffers  number of receives kept posted.
+   * @param[in] bufferSize  size in bytes of each buffer, larger messages fail with
+   *                        `UCS_ERR_MESSAGE_TRUNCATED`.
+   * @param[in] tag         the tag to match.
+   * @param[in] tagMask     the tag mask to use.
+   * @param[in] callback    user-defined callback handling received messages, or `nullptr`
+   *                        to harvest them with `poll()`.
+   */
+  TagRecvRing(std::shared_ptr<Worker> worker,
+              size_t numBuffers,
+              size_t bufferSize,
+              Tag tag,
+              TagMask tagMask,
+              TagRecvRingCallback callback);
+
+  /**
+   * @brief Post the receive of a ring buffer.
+   *
+   * @param[in] slot  the index of the ring buffer.
+   */
+  void post(size_t slot);
+
+  /**
+   * @brief Handle the completion of the receive of a ring buffer.
+   *
+   * Called by the request callback, the receive may complete before `post()` stores the
+   * request, in which case the completion is handled by `post()` instead.
+   *
+   * @param[in] slot    the index of the ring buffer.
+   * @param[in] status  the completion status of the receive.
+   */
+  void onCompletion(size_t slot, ucs_status_t status);
+
+  /**
+   * @brief Deliver the completed receive of a ring buffer.
+   *
+   * Call the user-defined callback and post the receive again, or enqueue the completion
+   * to be harvested by `poll()`.
+   *
+   * @param[in] slot    the index of the ring buffer.
+   * @param[in] status  the completion status of the receive.
+   */
+  void deliver(size_t slot, ucs_status_t status);
+
+ public:
+  TagRecvRing()                              = delete;
+  TagRecvRing(const TagRecvRing&)            = delete;
+  TagRecvRing& operator=(TagRecvRing const&) = delete;
+  TagRecvRing(TagRecvRing&& o)               = delete;
+  TagRecvRing& operator=(TagRecvRing&& o)    = delete;
+
+  /**
+   * @brief Constructor of `shared_ptr<ucxx::TagRecvRing>`.
+   *
+   * The constructor for a `shared_ptr<ucxx::TagRecvRing>` object, allocating the ring
+   * buffers and posting a tag receive for each of them.
+   *
+   * @throws std::invalid_argument if `worker` is `nullptr`, or `numBuffers` or
+   *                               `bufferSize` is `0`.
+   *
+   * @param[in] worker      the worker to post receives on.
+   * @param[in] numBuffers  number of receives kept posted.
+   * @param[in] bufferSize  size in bytes of each buffer, larger messages fail with
+   *                        `UCS_ERR_MESSAGE_TRUNCATED`.
+   * @param[in] tag         the tag to match.
+   * @param[in] tagMask     the tag mask to use.
+   * @param[in] callback    user-defined callback handling received messages, or `nullptr`
+   *                        to harvest them with `poll()`.
+   *
+   * @returns The `shared_ptr<ucxx::TagRecvRing>` object.
+   */
+  friend std::shared_ptr<TagRecvRing> createTagRecvRing(std::shared_ptr<Worker> worker,
+                                                        size_t numBuffers,
+                                                        size_t bufferSize,
+                                                        Tag tag,
+                                                        TagMask tagMask,
+                                                        TagRecvRingCallback callback);
+
+  /**
+   * @brief `ucxx::TagRecvRing` destructor.
+   *
+   * Stops the ring, canceling all posted receives, see `stop()`.
+   */
+  ~TagRecvRing();
+
+  /**
+   * @brief Harvest received messages.
+   *
+   * Move up to `maxCompletions` received messages to `completions`, only when the ring was
+   * created without a user-defined callback. The buffer of each harvested message is not
+   * posted again until `release()` is called for its slot.
+   *
+   * @param[out] completions    the container to append completions to.
+   * @param[in]  maxCompletions maximum number of completions to harvest.
+   *
+   * @returns The number of completions harvested.
+   */
+  size_t poll(std::vector<TagRecvRingCompletion>& completions,
+              size_t maxCompletions = std::numeric_limits<size_t>::max());
+
+  /**
+   * @brief Post the receive of a harvested ring buffer again.
+   *
+   * Post the receive of a ring buffer harvested by `poll()` again, after which the
+   * contents of the buffer must not be accessed anymore.
+   *
+   * @throws std::out_of_range if `slot` is not a valid ring buffer index.
+   *
+   * @param[in] slot  the index of the ring buffer, see `ucxx::TagRecvRingCompletion`.
+   */
+  void release(size_t slot);
+
+  /**
+   * @brief Stop posting receives.
+   *
+   * Cancel all posted receives and stop posting receives again, messages received but not
+   * yet harvested can still be harvested with `poll()`.
+   */
+  void stop();
+
+  /**
+   * @brief Get the number of ring buffers.
+   *
+   * @returns The number of ring buffers.
+   */
+  size_t getNumBuffers() const;
+
+  /**
+   * @brief Get the size of each ring buffer.
+   *
+   * @returns The size in bytes of each ring buffer.
+   */
+  size_t getBufferSize() const;
+
+  /**
+   * @brief Get the number of messages received.
+   *
+   * @returns The number of receives completed, successfully or not, excluding canceled
+   *          receives.
+   */
+  uint64_t getReceivedCount();
+};
+
+}  // namespace ucxx
@@ -0,0 +1,203 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ucxx {
+
+/**
+ * @brief A hierarchical timer wheel.
+ *
+ * A hierarchical timer wheel storing values until a deadline, expressed in ticks of a
+ * resolution chosen by the owner. Each of the `TimerWheelLevels` levels holds
+ * `TimerWheelSlots` slots, where a slot of level `l` spans `TimerWheelSlots^l` ticks.
+ * Values are placed in the lowest level whose range covers their deadline and cascade to
+ * lower levels as time advances, scheduling is thus O(1) and advancing is O(1) per tick
+ * plus the number of expired values, regardless of the number of values scheduled.
+ * Deadlines beyond the range of the highest level are placed in its furthest slot and
+ * cascade again when that slot is reached.
+ *
+ * Values can not be removed before their deadline, owners must thus check upon expiration
+ * whether the value is still relevant, for example by storing a `std::weak_ptr`.
+ *
+ * The wheel is not thread-safe, access must be synchronized by its owner.
+ *
+ * @tparam T  the type of the values to be stored.
+ */
+template <typename T>
+class TimerWheel {
+ public:
+  static constexpr size_t TimerWheelSlotBits = 6;  ///< Bits indexing the slots of a level
+  static constexpr size_t TimerWheelSlots    = 1 << TimerWheelSlotBits;  ///< Slots per level
+  static constexpr size_t TimerWheelLevels   = 4;                        ///< Number of levels
+
+ private:
+  /**
+   * @brief A value scheduled with its deadline.
+   */
+  struct Entry {
+    uint64_t deadline;  ///< The tick at which the value expires
+    T value;            ///< The value scheduled
+  };
+
+  std::array<std::array<std::vector<Entry>, TimerWheelSlots>, TimerWheelLevels>
+    _slots{};                     ///< The slots of all levels
+  std::array<size_t, TimerWheelLevels> _levelSizes{};  ///< The number of values in each level
+  std::vector<Entry> _expired{};  ///< Values whose deadline already passed
+  uint64_t _currentTick{0};       ///< The last tick the wheel was advanced to
+  size_t _size{0};                ///< The number of values scheduled
+
+  /**
+   * @brief Place an entry in the slot covering its deadline.
+   *
+   * @param[in] entry the entry to place, its deadline must be later than the current tick.
+   */
+  void place(Entry&& entry)
+  {
+    size_t level = 0;
+    while (level < TimerWheelLevels - 1 &&
+           (entry.deadline >> (TimerWheelSlotBits * level)) -
+               (_currentTick >> (TimerWheelSlotBits * level)) >=
+             TimerWheelSlots)
+      ++level;
+
+    const uint64_t shift    = TimerWheelSlotBits * level;
+    const uint64_t furthest = (_currentTick >> shift) + TimerWheelSlots - 1;
+    const uint64_t slot     = std::min(entry.deadline >> shift, furthest) & (TimerWheelSlots - 1);
+
+    _slots[level][slot].push_back(std::move(entry));
+    ++_levelSizes[level];
+  }
+
+  /**
+   * @brief Cascade the slot of a level reached by the current tick to lower levels.
+   *
+   * @param[in] level the level whose slot to cascade, must be greater than zero.
+   */
+  void cascade(size_t level)
+  {
+    const size_t slot = (_currentTick >> (TimerWheelSlotBits * level)) & (TimerWheelSlots - 1);
+
+    auto entries = std::exchange(_slots[level][slot], {});
+    _levelSizes[level] -= entries.size();
+    for (auto& entry : entries) {
+      if (entry.deadline <= _currentTick)
+        _expired.push_back(std::move(entry));
+      else
+        place(std::move(entry));
+    }
+  }
+
+ public:
+  /**
+   * @brief Constructor of the timer wheel.
+   *
+   * @param[in] currentTick the tick the wheel starts at.
+   */
+  explicit TimerWheel(uint64_t currentTick = 0) : _currentTick(currentTick) {}
+
+  /**
+   * @brief Schedule a value to expire at a deadline.
+   *
+   * Schedule a value to expire when the wheel is advanced to `deadline` or later. Values
+   * whose deadline already passed expire with the next advance.
+   *
+   * @param[in] deadline  the tick at which the value expires.
+   * @param[in] value     the value to schedule.
+   */
+  void schedule(uint64_t deadline, T value)
+  {
+    Entry entry{deadline, std::move(value)};
+    if (deadline <= _currentTick)
+      _expired.push_back(std::move(entry));
+    else
+      place(std::move(entry));
+    ++_size;
+  }
+
+  /**
+   * @brief Advance the wheel, expiring values whose deadline is reached.
+   *
+   * Advance the wheel up to `tick`, calling `function` with each value whose deadline is
+   * at or before `tick`, in no particular order. Ticks at which no values can expire or
+   * cascade are skipped, thus advancing over long idle periods is cheap.
+   *
+   * @param[in] tick      the tick to advance to, earlier ticks are ignored.
+   * @param[in] function  the function to call with each expired value.
+   *
+   * @returns The number of values expired.
+   */
+  template <typename F>
+  size_t advance(uint64_t tick, F&& function)
+  {
+    size_t expired = 0;
+    auto expire    = [this, &expired, &function](std::vector<Entry>& entries) {
+      auto toExpire = std::exchange(entries, {});
+      for (auto& entry : toExpire)
+        function(std::move(entry.value));
+      expired += toExpire.size();
+      _size -= toExpire.size();
+    };
+
+    expire(_expired);
+
+    while (_currentTick < tick) {
+      // Values only move once the slot boundary of their level is reached, skip ahead to the
+      // boundary of the lowest level holding values.
+      size_t lowest = 0;
+      while (lowest < TimerWheelLevels && _levelSizes[lowest] == 0)
+        ++lowest;
+      if (lowest == TimerWheelLevels) {
+        _currentTick = tick;
+        expire(_expired);
+        break;
+      }
+      if (lowest > 0) {
+        const uint64_t span     = uint64_t{1} << (TimerWheelSlotBits * lowest);
+        const uint64_t boundary = (_currentTick | (span - 1)) + 1;
+        _currentTick            = std::min(tick, boundary) - 1;
+      }
+
+      ++_currentTick;
+
+      // Cascade from the highest level whose slot boundary was reached down.
+      size_t level = 1;
+      while (level < TimerWheelLevels &&
+             (_currentTick & ((uint64_t{1} << (TimerWheelSlotBits * level)) - 1)) == 0)
+        ++level;
+      while (--level > 0)
+        cascade(level);
+
+      expire(_expired);
+      auto& slot = _slots[0][_currentTick & (TimerWheelSlots - 1)];
+      _levelSizes[0] -= slot.size();
+      expire(slot);
+    }
+
+    return expired;
+  }
+
+  /**
+   * @brief Get the number of values scheduled and not yet expired.
+   *
+   * @returns The number of values scheduled.
+   */
+  [[nodiscard]] size_t size() const { return _size; }
+
+  /**
+   * @brief Get the last tick the wheel was advanced to.
+   *
+   * @returns The current tick.
+   */
+  [[nodiscard]] uint64_t getCurrentTick() const { return _currentTick; }
+};
+
+}  // namespace ucxx
@@ -0,0 +1,187 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/request_data.h>
+
+namespace ucxx {
+
+/**
+ * @brief The type of a captured operation.
+ */
+enum class CaptureOperation : uint8_t {
+  TagSend = 0,    ///< A tag send
+  TagReceive,     ///< A tag receive
+  StreamSend,     ///< A stream send
+  StreamReceive,  ///< A stream receive
+  AmSend,         ///< An active message send
+  AmReceive,      ///< An active message receive
+  MemPut,         ///< A remote memory put
+  MemGet,         ///< A remote memory get
+};
+
+/**
+ * @brief A single operation of a captured trace.
+ *
+ * An operation as recorded by `ucxx::TrafficCapture` when its request was created.
+ */
+struct CaptureRecord {
+  CaptureOperation operation{CaptureOperation::TagSend};  ///< The type of the operation
+  ucs_memory_type_t memoryType{UCS_MEMORY_TYPE_UNKNOWN};  ///< Memory type of the buffer
+  uint64_t endpoint{0};  ///< Index of the endpoint in order of first use, `0` for the worker
+  uint64_t interArrivalNs{0};  ///< Time in nanoseconds since the previous operation
+  uint64_t size{0};            ///< Size in bytes, `0` if unknown when posted, e.g., AM receives
+  uint64_t count{1};           ///< Number of buffers, larger than `1` for IOV operations
+  uint64_t tag{0};             ///< The tag of tag operations, `0` otherwise
+};
+
+/**
+ * @brief Capture of the traffic of a worker to a binary trace.
+ *
+ * Records the type, size, tag, memory type, endpoint and inter-arrival time of each
+ * communication operation as its request is created, so that the trace can later be
+ * replayed by the `ucxx_replay` benchmark to evaluate changes to UCXX or UCX tuning
+ * against a real workload. Multi-buffer and file transfers are recorded as the tag
+ * messages they are composed of, as they appear on the wire. Endpoints are identified by
+ * their index in order of first use, starting at `1`, operations posted on the worker,
+ * such as worker tag receives, are recorded with endpoint `0`.
+ *
+ * The trace starts with the 7-byte magic `UCXXCAP` followed by the format version, each
+ * operation is then encoded as the operation and memory type bytes, followed by the
+ * endpoint, inter-arrival time, size, count and tag as varints, where most operations
+ * take only a few bytes. Records are buffered and written in blocks, deciding whether to
+ * record an operation costs a single relaxed atomic load when capture is disabled.
+ */
+class TrafficCapture {
+ private:
+  std::atomic<bool> _enabled{false};  ///< Whether operations are being captured
+  std::mutex _mutex{};                ///< Mutex to access the trace
+  std::ofstream _file{};              ///< The file the trace is written to
+  std::string _path{};                ///< The path of the file the trace is written to
+  std::vector<uint8_t> _buffer{};     ///< Encoded records not yet written
+  uint64_t _lastNs{0};                ///< Time of the previous record
+  std::unordered_map<const void*, uint64_t> _endpoints{};  ///< Index of each endpoint seen
+  uint64_t _recorded{0};  ///< Number of operations recorded since capture started
+
+  /**
+   * @brief Write the buffered records to the file.
+   *
+   * Must be called with `_mutex` locked.
+   */
+  void flushBuffer();
+
+ public:
+  TrafficCapture() = default;
+
+  TrafficCapture(const TrafficCapture&)            = delete;
+  TrafficCapture& operator=(TrafficCapture const&) = delete;
+  TrafficCapture(TrafficCapture&& o)               = delete;
+  TrafficCapture& operator=(TrafficCapture&& o)    = delete;
+
+  /**
+   * @brief `ucxx::TrafficCapture` destructor.
+   *
+   * Stops the capture, writing all records still buffered.
+   */
+  ~TrafficCapture();
+
+  /**
+   * @brief Start capturing to a file.
+   *
+   * Start capturing operations to the trace file at `path`, which is truncated. If a
+   * capture is already in progress it is stopped first.
+   *
+   * @throws std::ios_base::failure if the file could not be opened.
+   *
+   * @param[in] path  the path of the trace file.
+   */
+  void start(const std::string& path);
+
+  /**
+   * @brief Start capturing as configured by the environment.
+   *
+   * Start capturing to the path in `UCXX_TRAFFIC_CAPTURE`, where `%p` is replaced by the
+   * process ID and `%w` by the index of the capture within the process, counting each
+   * capture started from the environment, e.g., by each worker, so that each process and
+   * worker of an application writes its own trace. If the path has no `%w`, `.<index>` is
+   * appended to it for all captures but the first one of the process. Capture remains
+   * disabled if the variable is not set.
+   */
+  void startFromEnvironment();
+
+  /**
+   * @brief Stop capturing.
+   *
+   * Stop capturing, writing all records still buffered and closing the file, does
+   * nothing if no capture is in progress.
+   */
+  void stop();
+
+  /**
+   * @brief Check whether operations are being captured.
+   *
+   * @returns `true` if a capture is in progress, `false` otherwise.
+   */
+  bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Record the operation of a request being created.
+   *
+   * Record the operation described by `requestData`, ignoring requests that are not
+   * communication operations or are composed of other requests.
+   *
+   * @param[in] requestData the data of the request being created.
+   * @param[in] endpoint    the endpoint of the request, `nullptr` for worker requests.
+   */
+  void record(const data::RequestData& requestData, const void* endpoint);
+
+  /**
+   * @brief Record an operation.
+   *
+   * @param[in] record    the operation, the inter-arrival time is ignored and computed
+   *                      from the time of the previous record.
+   * @param[in] endpoint  the endpoint of the operation, `nullptr` for worker operations.
+   */
+  void record(CaptureRecord record, const void* endpoint);
+
+  /**
+   * @brief Get the number of operations recorded.
+   *
+   * @returns The number of operations recorded since the capture started.
+   */
+  uint64_t getRecorded();
+
+  /**
+   * @brief Get the path of the trace file.
+   *
+   * @returns The path of the trace file of the current or last capture, empty if no
+   *          capture was ever started.
+   */
+  std::string getPath();
+
+  /**
+   * @brief Read a trace file.
+   *
+   * @throws std::ios_base::failure if the file could not be opened.
+   * @throws std::runtime_error     if the file is not a valid trace.
+   *
+   * @param[in] path  the path of the trace file.
+   *
+   * @returns The operations of the trace, in the order they were recorded.
+   */
+  static std::vector<CaptureRecord> read(const std::string& path);
+};
+
+}  // namespace ucxx
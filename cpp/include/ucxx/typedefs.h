@@ -4,18 +4,23 @@
  */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <ucp/api/ucp.h>
 
 namespace ucxx {
 
 class Buffer;
+class Context;
 class Request;
+class Worker;
 
 /**
  * @brief Available logging levels.
@@ -48,6 +53,170 @@ typedef enum {
  */
 enum class TransferDirection { Send = 0, Receive };
 
+/**
+ * @brief The mode to close a UCXX endpoint with.
+ *
+ * The mode to close a UCXX endpoint with, `Force` cancels all inflight requests of the
+ * endpoint and closes it immediately, `Flush` waits for inflight operations to complete
+ * before closing and notifying the remote endpoint.
+ */
+enum class EndpointCloseMode { Force = 0, Flush };
+
+/**
+ * @brief The protocol to send active messages with.
+ *
+ * The protocol to send active messages with, `Auto` leaves the choice to UCX based on the
+ * message size and the thresholds configured for the `ucxx::Context`, `Eager` and
+ * `Rendezvous` force the respective protocol regardless of the message size.
+ */
+enum class SendProtocol { Auto = 0, Eager, Rendezvous };
+
+/**
+ * @brief The priority class of a delayed request submission.
+ *
+ * The priority class of a request submitted by the worker progress thread when delayed
+ * submission is enabled. `High` requests, e.g., small latency-sensitive control messages,
+ * are all submitted in every iteration of the progress loop, while `Normal` and `Bulk`
+ * requests share the per-iteration budget set with
+ * `ucxx::Worker::setDelayedSubmissionBudget()`, with `Bulk` requests receiving a smaller
+ * share of it.
+ */
+enum class SubmissionPriority { High = 0, Normal, Bulk };
+
+/**
+ * @brief Bounds on the work performed by each iteration of the worker progress loop.
+ *
+ * Bounds on the work performed by each call to `ucxx::Worker::progress()` and each
+ * iteration of the worker progress thread, keeping the latency of each iteration, and
+ * thus of generic callbacks such as endpoint closing or request cancelation, bounded
+ * under heavy load. Work left over by an exhausted budget is resumed by the next
+ * iteration, and a `0` value leaves the respective kind of work unbounded.
+ */
+struct ProgressBudget {
+  size_t maxProgressCalls{0};  ///< Maximum calls to `ucp_worker_progress()` per iteration
+  size_t maxSubmissions{0};    ///< Maximum `SubmissionPriority::Normal` and `Bulk` delayed
+                               ///< request submissions per iteration
+  size_t maxCompletions{0};    ///< Stop calling `ucp_worker_progress()` once at least this many
+                               ///< requests completed within an iteration
+};
+
+/**
+ * @brief The mode to drain unmatched tag messages with when destroying a UCXX worker.
+ *
+ * The mode to drain tag messages that were never matched by a receive when destroying a
+ * `ucxx::Worker`, `Copy` receives each message in full into reusable scratch buffers,
+ * `Discard` receives no data at all, completing each message as truncated, thus avoiding
+ * copying and, for rendezvous messages, transferring their payload.
+ */
+enum class TagDrainMode { Copy = 0, Discard };
+
+/**
+ * @brief Policy used by `ucxx::WorkerPool` to place new endpoints and listeners.
+ */
+enum class WorkerPoolPlacement {
+  RoundRobin = 0,  ///< Cycle through workers in order
+  LeastEndpoints,  ///< Pick the worker with the fewest live endpoints placed on it
+  LeastLoaded,     ///< Pick the worker with the fewest inflight requests, then endpoints
+};
+
+/**
+ * @brief The algorithm implementing a collective operation of `ucxx::CollectiveGroup`.
+ *
+ * The algorithm implementing a collective operation of a `ucxx::CollectiveGroup`, `Auto`
+ * lets the group select one by message size and group size. Not all algorithms implement
+ * all operations, see each operation for the algorithms it supports.
+ */
+enum class CollectiveAlgorithm {
+  Auto = 0,          ///< Selected by message size and group size
+  Direct,            ///< Every rank exchanges with every other rank at once
+  BinomialTree,      ///< Forwarded along a binomial tree rooted at the broadcasting rank
+  Chain,             ///< Forwarded along a chain of all ranks starting at the broadcasting rank
+  Ring,              ///< Forwarded around a ring of all ranks, one block per step
+  PairwiseExchange,  ///< Exchanged with one pair of ranks per step
+};
+
+/**
+ * @brief Tuning parameters of the collective operations of `ucxx::CollectiveGroup`.
+ */
+struct CollectiveConfig {
+  size_t chunkSize{1 << 20};  ///< Size in bytes of the chunks forwarded by pipelined algorithms
+  size_t smallMessageSize{64 << 10};  ///< Largest total size in bytes using latency algorithms
+  size_t pairwiseWindow{4};           ///< Steps of pairwise exchange in flight at once
+};
+
+/**
+ * @brief How close two processes, or the devices they use, are to each other.
+ *
+ * How close two processes, or the devices they use, are to each other, ordered from the
+ * farthest to the closest, thus allowing localities to be compared.
+ */
+enum class TopologyLocality {
+  Remote = 0,      ///< On different hosts, or the host is unknown
+  SameHost,        ///< On the same host, but devices on different NUMA nodes
+  SameNumaNode,    ///< Devices on the same NUMA node
+  SamePcieSwitch,  ///< Devices behind the same PCIe switch, or the same device
+};
+
+/**
+ * @brief A transport selected by UCX for a lane of an endpoint.
+ */
+struct EndpointTransport {
+  std::string transportName{};  ///< The name of the transport, e.g., `"rc_mlx5"` or `"sysv"`
+  std::string deviceName{};     ///< The name of the device, e.g., `"mlx5_0:1"` or `"memory"`
+};
+
+/**
+ * @brief The codec compressing frames of multi-buffer transfers.
+ *
+ * The codec compressing host frames of multi-buffer tag transfers, of which only `None`
+ * is always available, codecs are available if UCXX was built with them, see
+ * `ucxx::utils::isCompressionCodecAvailable()`.
+ */
+enum class CompressionCodec : uint8_t {
+  None = 0,  ///< Frames are sent verbatim
+  LZ4,       ///< LZ4, fast with moderate ratio, requires `UCXX_ENABLE_LZ4`
+  Zstd,      ///< Zstandard, slower with higher ratio, requires `UCXX_ENABLE_ZSTD`
+};
+
+/**
+ * @brief Configuration of the compression of frames of multi-buffer transfers.
+ *
+ * Configuration of the compression of host frames of multi-buffer tag sends, which only
+ * applies to endpoints with a lane using one of `transports`, i.e., transports slow enough
+ * that compressing is expected to be faster than sending the data saved, and to frames of
+ * at least `minFrameSize` bytes.
+ */
+struct CompressionConfig {
+  CompressionCodec codec{CompressionCodec::None};  ///< Codec to compress frames with
+  int level{1};                   ///< Compression level of Zstandard or acceleration of LZ4
+  size_t minFrameSize{64 << 10};  ///< Smallest frame in bytes to compress
+  std::vector<std::string> transports{"tcp"};  ///< Transports compressing frames
+};
+
+/**
+ * @brief Hints on how an endpoint sends messages.
+ *
+ * Hints passed to UCX with each message sent by an endpoint, allowing the protocol of
+ * endpoints exchanging messages of very different sizes, e.g., small control messages and
+ * large bulk transfers, to be tuned individually rather than through the thresholds of
+ * the `ucxx::Context`, which apply to all endpoints. UCP does not allow selecting the
+ * protocol of individual tag and stream messages, thus `amProtocol` and
+ * `amRendezvousThreshold` only apply to active messages. `submissionPriority` applies to
+ * all requests of the endpoint, including receives, and only has effect when the worker
+ * was created with delayed submission enabled.
+ */
+struct SendHints {
+  SendProtocol amProtocol{SendProtocol::Auto};  ///< Protocol to send active messages with
+  size_t amRendezvousThreshold{0};  ///< With `SendProtocol::Auto`, send active messages of at
+                                    ///< least this size with rendezvous and smaller ones
+                                    ///< eagerly, `0` leaves the choice to UCX
+  bool fastCompletion{false};  ///< Favor fast local completion over bandwidth, suitable for
+                               ///< small latency-sensitive messages
+  bool multiSend{false};       ///< Favor bandwidth of many concurrently inflight messages
+  SubmissionPriority submissionPriority{
+    SubmissionPriority::Normal};  ///< Priority class of delayed submission of all requests
+};
+
 /**
  * @brief Strong type for a UCP tag.
  *
@@ -71,6 +240,79 @@ enum TagMask : ucp_tag_t {};
  */
 static constexpr TagMask TagMaskFull{std::numeric_limits<std::underlying_type_t<TagMask>>::max()};
 
+/**
+ * @brief Information of a completed tag receive.
+ *
+ * Information provided by UCX upon completion of a tag receive, useful to identify
+ * messages received with a tag mask that matches multiple tags.
+ */
+struct TagRecvInfo {
+  Tag senderTag{0};  ///< The tag of the message received
+  size_t length{0};  ///< The length in bytes of the message received
+};
+
+/**
+ * @brief A tag message probed and removed from the worker's unexpected queue.
+ *
+ * A tag message matched by `ucxx::Worker::tagProbeMessage()`, which must subsequently be
+ * received with `ucxx::Worker::tagMsgRecv()`.
+ */
+struct TagMessage {
+  ucp_tag_message_h handle{nullptr};  ///< The UCP message handle, `nullptr` if none matched
+  TagRecvInfo info{};                 ///< The tag and length of the message
+};
+
+/**
+ * @brief A message received by a `ucxx::TagRecvRing`.
+ */
+struct TagRecvRingCompletion {
+  size_t slot{0};               ///< The index of the ring buffer the message was received into
+  void* buffer{nullptr};        ///< The ring buffer the message was received into
+  TagRecvInfo info{};           ///< The tag and length of the message received
+  ucs_status_t status{UCS_OK};  ///< The completion status of the receive
+};
+
+/**
+ * @brief A user-defined function handling messages received by a `ucxx::TagRecvRing`.
+ *
+ * A user-defined function called for each message received by a `ucxx::TagRecvRing`,
+ * from the thread completing the receive, usually the worker progress thread, or from the
+ * completion callback executor if one is set. The buffer the message was received into is
+ * only valid until the function returns, it is then posted again to receive another
+ * message, thus the function should return quickly.
+ */
+typedef std::function<void(const TagRecvRingCompletion&)> TagRecvRingCallback;
+
+/**
+ * @brief A user-defined function reporting whether a send is ready for submission.
+ *
+ * A user-defined function reporting whether the data of a send is ready, e.g., whether
+ * the CUDA stream producing it reached an event, returning `UCS_INPROGRESS` while it is
+ * not, `UCS_OK` once it is, or an error status, which then completes the request with
+ * that status instead. Called by the thread progressing the worker, thus it must not
+ * block nor call into the worker.
+ */
+typedef std::function<ucs_status_t()> RequestReadinessCallback;
+
+/**
+ * @brief A function writing the completion word of a request to memory read by a device.
+ *
+ * A function writing the 32-bit completion word of a request to a flag, e.g., in device
+ * memory, that a CUDA kernel spins on or a stream waits on with `cuStreamWaitValue32()`,
+ * see `ucxx::Request::setCompletionFlag()`. Called once by the thread completing the
+ * request, thus it must not block nor call into the worker.
+ */
+typedef std::function<void(uint32_t)> RequestCompletionFlagWriter;
+
+/**
+ * @brief The bit set in the completion word of a request that completed with an error.
+ *
+ * The bit set in the value written by `ucxx::Request::setCompletionFlag()` if the request
+ * did not complete successfully, the word thus still compares greater or equal to the
+ * requested value and waiters must check this bit before consuming the data.
+ */
+static constexpr uint32_t CompletionFlagError{1u << 31};
+
 /**
  * @brief A UCP configuration map.
  *
@@ -103,4 +345,34 @@ typedef std::shared_ptr<void> RequestCallbackUserData;
  */
 typedef std::function<std::shared_ptr<Buffer>(size_t)> AmAllocatorType;
 
+/**
+ * @brief Custom multi-buffer tag receive allocator type.
+ *
+ * Type for a custom allocator that may be specified to `ucxx::Endpoint::tagMultiRecv()`,
+ * allowing frames to be received directly into user-provided buffers, e.g., from a memory
+ * pool, instead of buffers allocated internally. The allocator is called once the headers
+ * have been received, with the size of each frame and whether the sender specified it as
+ * a CUDA frame, and must return one buffer per frame of at least the corresponding size.
+ */
+typedef std::function<std::vector<std::shared_ptr<Buffer>>(const std::vector<size_t>& size,
+                                                           const std::vector<int>& isCUDA)>
+  TagMultiRecvAllocatorType;
+
+/**
+ * @brief Active Message receiver callback type.
+ *
+ * Type for a user-defined callback that is registered for an Active Message ID, receiving
+ * each message sent to that ID as a completed `ucxx::Request` directly, instead of queueing
+ * it for a subsequent `ucxx::Endpoint::amRecv()` call.
+ */
+typedef std::function<void(std::shared_ptr<Request>)> AmReceiverCallbackType;
+
+/**
+ * @brief A function creating a worker for `ucxx::WorkerPool`.
+ *
+ * Type for a function creating each worker of a `ucxx::WorkerPool` from its context,
+ * allowing specialized workers, such as `ucxx::python::Worker`, to be pooled.
+ */
+typedef std::function<std::shared_ptr<Worker>(std::shared_ptr<Context>)> WorkerPoolFactory;
+
 }  // namespace ucxx
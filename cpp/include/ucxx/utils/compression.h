@@ -0,0 +1,88 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+
+#include <ucxx/typedefs.h>
+
+namespace ucxx {
+
+namespace utils {
+
+/**
+ * @brief Check whether a compression codec is available.
+ *
+ * Check whether UCXX was built with support for `codec`, `ucxx::CompressionCodec::None`
+ * is always available.
+ *
+ * @param[in] codec  the compression codec.
+ *
+ * @returns `true` if the codec is available, `false` otherwise.
+ */
+bool isCompressionCodecAvailable(CompressionCodec codec);
+
+/**
+ * @brief Get the largest size of compressed data.
+ *
+ * Get the largest size in bytes `length` bytes may have once compressed with `codec`, the
+ * size of the buffer `compress()` requires to always succeed.
+ *
+ * @param[in] codec   the compression codec.
+ * @param[in] length  the size in bytes of the data to compress.
+ *
+ * @returns The largest size of the compressed data, or `0` if `codec` is not available or
+ *          can not compress `length` bytes.
+ */
+size_t getCompressBound(CompressionCodec codec, size_t length);
+
+/**
+ * @brief Compress data.
+ *
+ * Compress `length` bytes at `source` with `codec` into `destination`, which must be at
+ * least `getCompressBound()` bytes long.
+ *
+ * @param[in]  codec              the compression codec.
+ * @param[in]  level              the compression level of Zstandard or acceleration of LZ4.
+ * @param[in]  source             the data to compress.
+ * @param[in]  length             the size in bytes of the data to compress.
+ * @param[out] destination        the buffer to write the compressed data to.
+ * @param[in]  destinationLength  the size in bytes of `destination`.
+ *
+ * @returns The size in bytes of the compressed data, or `0` if the data could not be
+ *          compressed, in which case it should be sent uncompressed.
+ */
+size_t compress(CompressionCodec codec,
+                int level,
+                const void* source,
+                size_t length,
+                void* destination,
+                size_t destinationLength);
+
+/**
+ * @brief Decompress data.
+ *
+ * Decompress `length` bytes at `source` compressed with `codec` into `destination`, which
+ * must be exactly the size of the uncompressed data.
+ *
+ * @throws std::invalid_argument if `codec` is not available.
+ * @throws std::runtime_error    if the data is malformed or does not decompress to exactly
+ *                               `destinationLength` bytes.
+ *
+ * @param[in]  codec              the compression codec.
+ * @param[in]  source             the compressed data.
+ * @param[in]  length             the size in bytes of the compressed data.
+ * @param[out] destination        the buffer to write the decompressed data to.
+ * @param[in]  destinationLength  the size in bytes of the decompressed data.
+ */
+void decompress(CompressionCodec codec,
+                const void* source,
+                size_t length,
+                void* destination,
+                size_t destinationLength);
+
+}  // namespace utils
+
+}  // namespace ucxx
@@ -0,0 +1,58 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ucxx {
+
+namespace utils {
+
+/**
+ * @brief Parse a list of CPUs in the Linux cpulist format.
+ *
+ * Parse a list of CPUs in the format used by the Linux kernel (e.g., in
+ * `/sys/devices/system/cpu/online`), such as `"0-3,8,10-11"`, returning the individual
+ * CPU indices in ascending order and without duplicates.
+ *
+ * @throws std::invalid_argument if the string is not a valid cpulist.
+ *
+ * @param[in] cpuList  the string in cpulist format.
+ *
+ * @returns the CPU indices contained in `cpuList`.
+ */
+std::vector<int> parseCpuList(const std::string& cpuList);
+
+/**
+ * @brief Get CPUs local to network devices.
+ *
+ * Get the CPUs that are local to (i.e., in the same NUMA node as) the network devices
+ * specified in `netDevices`, using the same format as `UCX_NET_DEVICES` (e.g.,
+ * `"mlx5_0:1,mlx5_1:1"` or `"eth0"`). The local CPUs are obtained from sysfs, devices
+ * whose local CPUs can not be determined are ignored, as is the case of the special value
+ * `"all"`.
+ *
+ * @param[in] netDevices  comma-separated list of network devices.
+ *
+ * @returns the CPU indices local to any of the devices, or an empty vector if no local
+ *          CPUs could be determined.
+ */
+std::vector<int> getNetworkDevicesLocalCpus(const std::string& netDevices);
+
+/**
+ * @brief Set CPU affinity of the calling thread.
+ *
+ * Pin the calling thread to the set of CPUs specified. Nothing is done if `cpus` is empty.
+ *
+ * @throws std::runtime_error if setting the CPU affinity failed.
+ *
+ * @param[in] cpus  the CPU indices the calling thread is allowed to run on.
+ */
+void setThreadCpuAffinity(const std::vector<int>& cpus);
+
+}  // namespace utils
+
+}  // namespace ucxx
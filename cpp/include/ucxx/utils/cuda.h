@@ -0,0 +1,106 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <ucxx/typedefs.h>
+
+#if UCXX_ENABLE_RMM
+#include <cuda_runtime_api.h>
+#endif
+
+namespace ucxx {
+
+namespace utils {
+
+/**
+ * @brief Get the memory type of a pointer.
+ *
+ * Get whether `pointer` refers to host or CUDA memory, querying the CUDA driver if UCXX
+ * was built with RMM support, thus it is not free and should not be called on the
+ * critical path.
+ *
+ * @param[in] pointer the pointer to query.
+ *
+ * @returns `UCS_MEMORY_TYPE_CUDA` or `UCS_MEMORY_TYPE_CUDA_MANAGED` for CUDA memory,
+ *          `UCS_MEMORY_TYPE_HOST` otherwise.
+ */
+ucs_memory_type_t getPointerMemoryType(const void* pointer);
+
+/**
+ * @brief Get the CUDA device of the context current on the calling thread.
+ *
+ * Query the device of the CUDA context current on the calling thread with the CUDA
+ * driver API, which is loaded at runtime, thus UCXX does not depend on CUDA for it.
+ *
+ * @returns The CUDA device ordinal, or `-1` if no context is current on the thread or the
+ *          CUDA driver is not available.
+ */
+int getCudaCurrentDevice();
+
+/**
+ * @brief Make the primary CUDA context of a device current on the calling thread.
+ *
+ * Retain the primary CUDA context of `device`, the same context the CUDA runtime and
+ * libraries such as Numba or CuPy use, and make it current on the calling thread with
+ * the CUDA driver API, which is loaded at runtime, thus UCXX does not depend on CUDA for
+ * it. The primary context is retained for the lifetime of the process.
+ *
+ * @param[in] device  the CUDA device ordinal.
+ *
+ * @returns `true` if the context is current on the thread, `false` if the CUDA driver is
+ *          not available or the context could not be made current.
+ */
+bool setCudaPrimaryContext(int device);
+
+#if UCXX_ENABLE_RMM
+/**
+ * @brief Create a readiness callback for data produced before a CUDA event.
+ *
+ * Create a `ucxx::RequestReadinessCallback` reporting a send ready once all work captured
+ * by `event` has completed, allowing the send to be registered right after the kernel
+ * producing its data is launched, without synchronizing the stream. The event is queried
+ * without blocking and must remain valid until the send is submitted.
+ *
+ * @param[in] event the CUDA event recorded after the work producing the data.
+ *
+ * @returns The readiness callback to pass to the send.
+ */
+RequestReadinessCallback cudaEventReadiness(cudaEvent_t event);
+
+/**
+ * @brief Create a readiness callback for data produced by work on a CUDA stream.
+ *
+ * Create a `ucxx::RequestReadinessCallback` reporting a send ready once all work currently
+ * enqueued on `stream` has completed, recording an event on `stream` that is owned by the
+ * callback and destroyed with it.
+ *
+ * @param[in] stream the CUDA stream where the work producing the data is enqueued.
+ *
+ * @throws std::runtime_error if the CUDA event could not be created or recorded.
+ *
+ * @returns The readiness callback to pass to the send.
+ */
+RequestReadinessCallback cudaStreamReadiness(cudaStream_t stream);
+
+/**
+ * @brief Create a writer of completion words to a flag in device memory.
+ *
+ * Create a `ucxx::RequestCompletionFlagWriter` for `ucxx::Request::setCompletionFlag()`
+ * copying the completion word to `flag` in device memory with `cudaMemcpyAsync()` on
+ * `stream`, which must not be blocked by the kernel waiting on the flag, e.g., a stream
+ * created with `cudaStreamNonBlocking` dedicated to completion flags. Flags in pinned
+ * host memory avoid the copy and should be preferred when possible.
+ *
+ * @param[in] flag    the flag in device memory.
+ * @param[in] stream  the CUDA stream the copies are ordered on.
+ *
+ * @returns The completion flag writer to pass to the request.
+ */
+RequestCompletionFlagWriter cudaCompletionFlag(uint32_t* flag, cudaStream_t stream);
+#endif
+
+}  // namespace utils
+
+}  // namespace ucxx
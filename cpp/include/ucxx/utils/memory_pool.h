@@ -0,0 +1,216 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ucxx {
+
+namespace utils {
+
+/**
+ * @brief A thread-safe pool of fixed-size memory blocks.
+ *
+ * A thread-safe pool of memory blocks divided in size classes. Blocks returned to the pool
+ * are cached and handed out again on subsequent allocations of the same size class, thus
+ * avoiding calls to the system allocator in steady state. Allocations larger than the
+ * largest size class are forwarded to the system allocator. Blocks may be allocated and
+ * deallocated from different threads.
+ */
+class MemoryPool {
+ public:
+  static constexpr size_t BlockGranularity = 64;  ///< Size difference between size classes
+  static constexpr size_t SizeClasses      = 32;  ///< Number of size classes
+  static constexpr size_t MaxBlockSize =
+    BlockGranularity * SizeClasses;  ///< Largest size served by the pool
+
+ private:
+  /**
+   * @brief Cached blocks of a single size class.
+   */
+  struct FreeList {
+    std::mutex mutex{};           ///< Mutex to control access to the cached blocks
+    std::vector<void*> blocks{};  ///< The cached blocks
+  };
+
+  std::array<FreeList, SizeClasses> _freeLists{};  ///< Cached blocks of each size class
+  size_t _maxCachedBlocks{0};                      ///< Maximum cached blocks per size class
+
+ public:
+  /**
+   * @brief Constructor of a memory pool.
+   *
+   * Construct a memory pool caching up to `maxCachedBlocks` blocks of each size class,
+   * blocks returned to the pool in excess are freed immediately.
+   *
+   * @param[in] maxCachedBlocks maximum number of cached blocks per size class.
+   */
+  explicit MemoryPool(size_t maxCachedBlocks = 1024);
+
+  MemoryPool(const MemoryPool&)            = delete;
+  MemoryPool& operator=(MemoryPool const&) = delete;
+  MemoryPool(MemoryPool&& o)               = delete;
+  MemoryPool& operator=(MemoryPool&& o)    = delete;
+
+  /**
+   * @brief Destructor of a memory pool.
+   *
+   * Free all cached blocks. All blocks handed out by the pool must have been returned
+   * before it is destroyed.
+   */
+  ~MemoryPool();
+
+  /**
+   * @brief Allocate a block.
+   *
+   * Allocate a block of at least `size` bytes aligned to `alignof(std::max_align_t)`,
+   * reusing a cached block of the same size class if available.
+   *
+   * @throws std::bad_alloc if the allocation failed.
+   *
+   * @param[in] size  the size of the block in bytes.
+   *
+   * @returns Pointer to the allocated block.
+   */
+  void* allocate(size_t size);
+
+  /**
+   * @brief Return a block to the pool.
+   *
+   * Return a block previously obtained from `allocate()` to the pool.
+   *
+   * @param[in] ptr   pointer to the block.
+   * @param[in] size  the size of the block in bytes, must match the size passed to
+   *                  `allocate()`.
+   */
+  void deallocate(void* ptr, size_t size);
+
+  /**
+   * @brief Query the number of cached blocks.
+   *
+   * @returns The number of blocks currently cached across all size classes.
+   */
+  size_t getCachedBlocks();
+};
+
+/**
+ * @brief Allocator backed by a `ucxx::utils::MemoryPool`.
+ *
+ * A standard-conforming allocator backed by a `ucxx::utils::MemoryPool`, intended to be
+ * used with `std::allocate_shared` or for the control block of `std::shared_ptr` objects.
+ * Holds a reference to the pool, ensuring it outlives all allocations.
+ */
+template <typename T>
+class PoolAllocator {
+ public:
+  typedef T value_type;  ///< The type of allocated objects
+
+  std::shared_ptr<MemoryPool> _pool{nullptr};  ///< The pool to allocate from
+
+  /**
+   * @brief Constructor of a pool allocator.
+   *
+   * @param[in] pool  the pool to allocate from.
+   */
+  explicit PoolAllocator(std::shared_ptr<MemoryPool> pool) : _pool(std::move(pool)) {}
+
+  /**
+   * @brief Rebinding constructor of a pool allocator.
+   *
+   * @param[in] other the allocator of another type to copy the pool from.
+   */
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& other) : _pool(other._pool)
+  {
+  }
+
+  /**
+   * @brief Allocate storage for `n` objects of type `T`.
+   *
+   * @param[in] n the number of objects.
+   *
+   * @returns Pointer to uninitialized storage.
+   */
+  T* allocate(size_t n)
+  {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types not supported");
+    return static_cast<T*>(_pool->allocate(n * sizeof(T)));
+  }
+
+  /**
+   * @brief Deallocate storage previously obtained from `allocate()`.
+   *
+   * @param[in] ptr pointer to the storage.
+   * @param[in] n   the number of objects passed to `allocate()`.
+   */
+  void deallocate(T* ptr, size_t n) { _pool->deallocate(ptr, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const PoolAllocator<U>& other) const
+  {
+    return _pool == other._pool;
+  }
+
+  template <typename U>
+  bool operator!=(const PoolAllocator<U>& other) const
+  {
+    return _pool != other._pool;
+  }
+};
+
+/**
+ * @brief Create a `std::shared_ptr` whose object and control block are pooled.
+ *
+ * Allocate storage for an object of type `T` from `pool`, construct the object by calling
+ * `construct` with a pointer to the storage and return a `std::shared_ptr` owning it, its
+ * control block also allocated from `pool`. The construction is delegated to `construct`
+ * so that types with non-public constructors can be created by their friend factories,
+ * which is not possible with `std::allocate_shared`. If `pool` is `nullptr` the object is
+ * allocated with `new` instead.
+ *
+ * @code{.cpp}
+ * auto obj = ucxx::utils::makePooledShared<MyType>(
+ *   pool, [](void* storage) { return new (storage) MyType(); });
+ * @endcode
+ *
+ * @param[in] pool      the pool to allocate from, or `nullptr` to use `new`.
+ * @param[in] construct callable constructing the object with placement new on the storage
+ *                      passed as argument and returning a `T*` to it.
+ *
+ * @returns The `std::shared_ptr<T>` owning the newly constructed object.
+ */
+template <typename T, typename F>
+std::shared_ptr<T> makePooledShared(std::shared_ptr<MemoryPool> pool, F&& construct)
+{
+  void* storage = pool ? pool->allocate(sizeof(T)) : ::operator new(sizeof(T));
+  T* obj        = nullptr;
+  try {
+    obj = construct(storage);
+  } catch (...) {
+    if (pool)
+      pool->deallocate(storage, sizeof(T));
+    else
+      ::operator delete(storage);
+    throw;
+  }
+
+  if (pool == nullptr) return std::shared_ptr<T>(obj);
+
+  auto deleter = [pool](T* ptr) {
+    ptr->~T();
+    pool->deallocate(ptr, sizeof(T));
+  };
+  return std::shared_ptr<T>(obj, std::move(deleter), PoolAllocator<T>(pool));
+}
+
+}  // namespace utils
+
+}  // namespace ucxx
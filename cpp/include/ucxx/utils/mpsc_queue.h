@@ -0,0 +1,149 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace ucxx {
+
+namespace utils {
+
+/**
+ * @brief A lock-free multi-producer, single-consumer queue.
+ *
+ * A lock-free multi-producer, single-consumer queue. Any number of threads may `push()`
+ * concurrently, producers never block each other nor the consumer, and do not block on
+ * the consumer either. A single consumer thread may `consume()` at any time, detaching all
+ * items that were pushed up to that point with a single atomic exchange and processing
+ * them in FIFO order.
+ *
+ * Internally items are pushed onto an intrusive singly-linked stack, the consumer always
+ * takes the entire stack at once, thus the queue is not susceptible to the ABA problem
+ * typical of lock-free stacks that pop individual nodes.
+ */
+template <typename T>
+class MPSCQueue {
+ private:
+  /**
+   * @brief A node of the intrusive linked list.
+   */
+  struct Node {
+    T item;              ///< The item stored in the node
+    Node* next{nullptr};  ///< The node pushed immediately before this one
+
+    explicit Node(T&& item) : item(std::move(item)) {}
+  };
+
+  std::atomic<Node*> _head{nullptr};  ///< The most recently pushed node
+
+  /**
+   * @brief Delete a linked list of nodes.
+   *
+   * Delete all nodes of a linked list, starting from `node`.
+   *
+   * @param[in] node  the first node of the list to delete.
+   */
+  static void deleteNodes(Node* node)
+  {
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+ public:
+  MPSCQueue() = default;
+
+  MPSCQueue(const MPSCQueue&)            = delete;
+  MPSCQueue& operator=(MPSCQueue const&) = delete;
+  MPSCQueue(MPSCQueue&& o)               = delete;
+  MPSCQueue& operator=(MPSCQueue&& o)    = delete;
+
+  /**
+   * @brief Destructor of the queue.
+   *
+   * Destroy the queue and all items that have been pushed but not yet consumed.
+   */
+  ~MPSCQueue() { deleteNodes(_head.exchange(nullptr, std::memory_order_acquire)); }
+
+  /**
+   * @brief Push an item into the queue.
+   *
+   * Push an item into the queue, may be called concurrently from any number of threads.
+   *
+   * @param[in] item  the item to push.
+   */
+  void push(T item)
+  {
+    Node* node = new Node(std::move(item));
+    node->next = _head.load(std::memory_order_relaxed);
+    while (!_head.compare_exchange_weak(
+      node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+  }
+
+  /**
+   * @brief Consume all items currently in the queue.
+   *
+   * Detach all items pushed until now and call `function` for each one of them in the
+   * order they were pushed. Items pushed while `consume()` is executing, including those
+   * pushed by `function` itself, are left for the next call. Must only be called from a
+   * single thread at a time.
+   *
+   * If `function` throws, the remaining detached items are destroyed without being
+   * processed and the exception is rethrown.
+   *
+   * @param[in] function  the callable to invoke for each item, receiving `T&` as argument.
+   *
+   * @returns the number of items consumed.
+   */
+  template <typename F>
+  size_t consume(F&& function)
+  {
+    Node* node = _head.exchange(nullptr, std::memory_order_acquire);
+    if (node == nullptr) return 0;
+
+    // Reverse the list to process items in FIFO order.
+    Node* reversed = nullptr;
+    while (node != nullptr) {
+      Node* next = node->next;
+      node->next = reversed;
+      reversed   = node;
+      node       = next;
+    }
+
+    size_t count = 0;
+    try {
+      while (reversed != nullptr) {
+        Node* next = reversed->next;
+        function(reversed->item);
+        delete reversed;
+        reversed = next;
+        ++count;
+      }
+    } catch (...) {
+      deleteNodes(reversed);
+      throw;
+    }
+
+    return count;
+  }
+
+  /**
+   * @brief Check whether the queue is empty.
+   *
+   * Check whether the queue is empty. The result is only a snapshot, concurrent producers
+   * may push new items immediately after this method returns.
+   *
+   * @returns `true` if the queue has no items, `false` otherwise.
+   */
+  bool empty() const { return _head.load(std::memory_order_acquire) == nullptr; }
+};
+
+}  // namespace utils
+
+}  // namespace ucxx
@@ -0,0 +1,106 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#ifndef UCXX_ENABLE_NVTX
+#define UCXX_ENABLE_NVTX 0
+#endif
+
+#if UCXX_ENABLE_NVTX
+#include <nvtx3/nvToolsExt.h>
+#endif
+
+namespace ucxx {
+
+namespace utils {
+
+#if UCXX_ENABLE_NVTX
+
+/**
+ * @brief Get the NVTX domain of UCXX.
+ *
+ * Get the NVTX domain all UCXX ranges are pushed to, created on first use, allowing them
+ * to be filtered independently of ranges from other libraries in profilers such as
+ * Nsight Systems.
+ *
+ * @returns The NVTX domain handle.
+ */
+inline nvtxDomainHandle_t getNvtxDomain()
+{
+  static nvtxDomainHandle_t domain = nvtxDomainCreateA("ucxx");
+  return domain;
+}
+
+/**
+ * @brief Register a string in the NVTX domain of UCXX.
+ *
+ * Register a string to be used as the message of NVTX ranges, avoiding copying the string
+ * each time a range is pushed.
+ *
+ * @param[in] name  the string to register.
+ *
+ * @returns The handle to the registered string.
+ */
+inline nvtxStringHandle_t registerNvtxString(const char* name)
+{
+  return nvtxDomainRegisterStringA(getNvtxDomain(), name);
+}
+
+/**
+ * @brief A scoped NVTX range.
+ *
+ * Push an NVTX range to the UCXX domain on construction and pop it on destruction, use
+ * via `UCXX_NVTX_RANGE()` only.
+ */
+class NvtxRange {
+ public:
+  /**
+   * @brief Push an NVTX range with a registered string as message.
+   *
+   * @param[in] name  the registered string with the name of the range.
+   */
+  explicit NvtxRange(nvtxStringHandle_t name)
+  {
+    nvtxEventAttributes_t attributes = {};
+    attributes.version               = NVTX_VERSION;
+    attributes.size                  = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+    attributes.messageType           = NVTX_MESSAGE_TYPE_REGISTERED;
+    attributes.message.registered    = name;
+    nvtxDomainRangePushEx(getNvtxDomain(), &attributes);
+  }
+
+  ~NvtxRange() { nvtxDomainRangePop(getNvtxDomain()); }
+
+  NvtxRange(const NvtxRange&)            = delete;
+  NvtxRange& operator=(NvtxRange const&) = delete;
+  NvtxRange(NvtxRange&& o)               = delete;
+  NvtxRange& operator=(NvtxRange&& o)    = delete;
+};
+
+#define UCXX_NVTX_CONCAT_IMPL(_a, _b) _a##_b
+#define UCXX_NVTX_CONCAT(_a, _b)      UCXX_NVTX_CONCAT_IMPL(_a, _b)
+
+/**
+ * Push a NVTX range named `_name`, which must be a string literal, to the UCXX domain
+ * until the end of the enclosing scope. Compiles to nothing unless UCXX was built with
+ * `UCXX_ENABLE_NVTX`.
+ */
+#define UCXX_NVTX_RANGE(_name)                                               \
+  static const nvtxStringHandle_t UCXX_NVTX_CONCAT(ucxxNvtxName, __LINE__) = \
+    ::ucxx::utils::registerNvtxString(_name);                                \
+  ::ucxx::utils::NvtxRange UCXX_NVTX_CONCAT(ucxxNvtxRange,                   \
+                                            __LINE__)(UCXX_NVTX_CONCAT(ucxxNvtxName, __LINE__))
+
+#else
+
+#define UCXX_NVTX_RANGE(_name) \
+  do {                         \
+  } while (0)
+
+#endif
+
+}  // namespace utils
+
+}  // namespace ucxx
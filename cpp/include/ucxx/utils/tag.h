@@ -0,0 +1,39 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstdint>
+
+#include <ucxx/typedefs.h>
+
+namespace ucxx {
+
+namespace utils {
+
+/**
+ * @brief Derive a tag from a base tag and a user tag.
+ *
+ * Derive a tag combining a base tag, typically agreed upon by both ends of an endpoint at
+ * connection time to namespace their messages, with a user tag. The user tag is mixed
+ * with the base by a multiply-xorshift function, such that derived tags are spread over
+ * the entire tag space. For a given base the derivation is a bijection, so distinct user
+ * tags never derive the same tag.
+ *
+ * @param[in] base     the base tag.
+ * @param[in] userTag  the user tag.
+ *
+ * @returns The derived tag.
+ */
+constexpr Tag deriveTag(Tag base, uint64_t userTag) noexcept
+{
+  uint64_t z = static_cast<uint64_t>(base) ^ (userTag * 0x9e3779b97f4a7c15ULL);
+  z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z          = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return Tag{z ^ (z >> 31)};
+}
+
+}  // namespace utils
+
+}  // namespace ucxx
@@ -0,0 +1,82 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <ucxx/typedefs.h>
+
+namespace ucxx {
+
+namespace utils {
+
+/**
+ * @brief The location of a process and its devices within a host.
+ *
+ * Describes where a process and the devices it uses, such as network devices and GPUs,
+ * are located, allowing to compare with the topology of a peer, usually exchanged
+ * out-of-band via `serializeTopology()`/`deserializeTopology()` together with the worker
+ * address, to determine how close both are with `getTopologyLocality()`.
+ */
+struct Topology {
+  std::string hostId{};  ///< Identifies the host, the kernel boot ID or hostname if unavailable
+  std::vector<int> numaNodes{};  ///< NUMA nodes of the devices, in ascending order
+  std::vector<std::string> pciPaths{};  ///< sysfs PCI paths of the devices, from the root
+                                        ///< complex, e.g., `"pci0000:00/0000:00:01.0"`
+};
+
+/**
+ * @brief Get the topology of the local host and the specified devices.
+ *
+ * Get the topology of the local host and the specified devices, obtained from sysfs.
+ * Devices whose location can not be determined are ignored.
+ *
+ * @param[in] netDevices  comma-separated list of network devices, using the same format
+ *                        as `UCX_NET_DEVICES` (e.g., `"mlx5_0:1,mlx5_1:1"` or `"eth0"`).
+ * @param[in] pciBusIds   PCI bus IDs of other devices, such as GPUs (e.g., as returned by
+ *                        `cudaDeviceGetPCIBusId()`, `"0000:3B:00.0"`).
+ *
+ * @returns the topology of the local host and devices.
+ */
+Topology getTopology(const std::string& netDevices,
+                     const std::vector<std::string>& pciBusIds = {});
+
+/**
+ * @brief Determine how close two topologies are.
+ *
+ * Determine how close two topologies are, the devices of both are only compared when both
+ * are on the same host.
+ *
+ * @param[in] local   the local topology.
+ * @param[in] remote  the topology of the peer.
+ *
+ * @returns the closest locality shared by any devices of both topologies.
+ */
+TopologyLocality getTopologyLocality(const Topology& local, const Topology& remote);
+
+/**
+ * @brief Serialize a topology to be exchanged with a peer.
+ *
+ * @param[in] topology  the topology to serialize.
+ *
+ * @returns the serialized topology.
+ */
+std::string serializeTopology(const Topology& topology);
+
+/**
+ * @brief Deserialize a topology serialized with `serializeTopology()`.
+ *
+ * @throws std::invalid_argument if `serializedTopology` is not a valid serialized topology.
+ *
+ * @param[in] serializedTopology  the serialized topology.
+ *
+ * @returns the deserialized topology.
+ */
+Topology deserializeTopology(const std::string& serializedTopology);
+
+}  // namespace utils
+
+}  // namespace ucxx
@@ -4,15 +4,24 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <ucp/api/ucp.h>
 
+#include <ucxx/buffer_pool.h>
+#include <ucxx/completion_executor.h>
 #include <ucxx/component.h>
 #include <ucxx/constructors.h>
 #include <ucxx/context.h>
@@ -20,15 +29,26 @@
 #include <ucxx/future.h>
 #include <ucxx/inflight_requests.h>
 #include <ucxx/notifier.h>
+#include <ucxx/request_trace.h>
+#include <ucxx/statistics.h>
+#include <ucxx/timer_wheel.h>
+#include <ucxx/traffic_capture.h>
+#include <ucxx/typedefs.h>
+#include <ucxx/utils/memory_pool.h>
+#include <ucxx/utils/mpsc_queue.h>
+#include <ucxx/utils/topology.h>
 #include <ucxx/worker_progress_thread.h>
 
 namespace ucxx {
 
 class Address;
 class Buffer;
+class CompletionQueue;
 class Endpoint;
 class Listener;
 class RequestAm;
+class TagRecvRing;
+struct ErrorCallbackData;
 
 namespace internal {
 class AmData;
@@ -45,21 +65,105 @@ class Worker : public Component {
   ucp_worker_h _handle{nullptr};        ///< The UCP worker handle
   int _epollFileDescriptor{-1};         ///< The epoll file descriptor
   int _workerFileDescriptor{-1};        ///< The worker file descriptor
-  std::mutex _inflightRequestsMutex{};  ///< Mutex to access the inflight requests pool
-  std::unique_ptr<InflightRequests> _inflightRequests{
-    std::make_unique<InflightRequests>()};  ///< The inflight requests
+  std::array<InflightRequests, 16>
+    _inflightRequests{};  ///< The inflight requests, sharded by request to reduce contention
   std::mutex
     _inflightRequestsToCancelMutex{};  ///< Mutex to access the inflight requests to cancel pool
   std::unique_ptr<InflightRequests> _inflightRequestsToCancel{
     std::make_unique<InflightRequests>()};  ///< The inflight requests scheduled to be canceled
+  std::atomic<bool> _hasRequestsToCancel{
+    false};  ///< Whether `_inflightRequestsToCancel` may contain requests, avoids locking
   std::shared_ptr<WorkerProgressThread> _progressThread{nullptr};  ///< The progress thread object
   std::thread::id _progressThreadId{};                             ///< The progress thread ID
   std::function<void(void*)> _progressThreadStartCallback{
     nullptr};  ///< The callback function to execute at progress thread start
   void* _progressThreadStartCallbackArg{
     nullptr};  ///< The argument to be passed to the progress thread start callback
+  bool _progressThreadCudaContext{false};  ///< Whether to bind a CUDA context at thread start
+  int _progressThreadCudaDevice{-1};       ///< The CUDA device to bind, `-1` for the current
   std::shared_ptr<DelayedSubmissionCollection> _delayedSubmissionCollection{
     nullptr};  ///< Collection of enqueued delayed submissions
+  std::chrono::steady_clock::time_point
+    _lastProgressActivity{};  ///< Last time `progressHybrid()` progressed any communication
+  std::atomic<uint64_t> _progressSpinHits{
+    0};  ///< Number of times `progressHybrid()` progressed without blocking
+  std::atomic<uint64_t> _progressSleeps{0};  ///< Number of times `progressHybrid()` blocked
+  std::atomic<uint64_t> _progressCalls{0};   ///< Number of calls to `progress()`
+  std::atomic<uint64_t> _progressCallsWithProgress{
+    0};  ///< Number of calls to `progress()` that progressed any communication
+  bool _enableSerializedThreadMode{
+    false};  ///< Whether the UCP worker was created with `UCS_THREAD_MODE_SERIALIZED`
+  std::atomic<size_t> _progressMaxCalls{
+    0};  ///< Maximum `progressOnce()` calls per `progressPending()`, `0` unlimited
+  std::atomic<size_t> _progressMaxCompletions{
+    0};  ///< Completions stopping `progressPending()`, `0` unlimited
+  std::atomic<uint64_t> _progressBudgetExhausted{
+    0};  ///< Number of times `progressPending()` stopped due to the budget
+  std::atomic<uint64_t> _requestsDelayed{
+    0};  ///< Number of requests registered for delayed submission
+  internal::RequestCounters _requestCounters{};  ///< Counters of requests of the worker
+  RequestTracer _requestTracer{};                ///< Tracer of sampled request lifecycles
+  TrafficCapture _trafficCapture{};              ///< Capture of the worker traffic, if enabled
+  std::shared_ptr<utils::MemoryPool> _requestMemoryPool{
+    std::make_shared<utils::MemoryPool>()};  ///< Pool to allocate requests from
+  std::atomic<bool> _hasCompletionExecutor{
+    false};  ///< Whether `_completionExecutor` is set, avoids locking
+  std::mutex _completionExecutorMutex{};  ///< Mutex to access the completion executor
+  std::shared_ptr<CompletionExecutor> _completionExecutor{
+    nullptr};  ///< Executor of request completion callbacks, inline execution if `nullptr`
+  std::atomic<bool> _completionExecutorNotifiesFutures{
+    false};  ///< Whether `_completionExecutor` also notifies futures of requests
+  /**
+   * @brief An endpoint held by the endpoint cache.
+   *
+   * The cache doesn't own the endpoint, it is released as soon as the application drops its
+   * last reference. The error callback data identifies the entry to evict when the
+   * endpoint errors, without needing to lock the weak reference from the error callback.
+   */
+  struct CachedEndpoint {
+    std::weak_ptr<Endpoint> endpoint{};               ///< The cached endpoint
+    const ErrorCallbackData* callbackData{nullptr};  ///< The endpoint error callback data
+  };
+  std::atomic<bool> _endpointCacheEnabled{false};  ///< Whether the endpoint cache is enabled
+  std::mutex _endpointCacheMutex{};                ///< Mutex to access the endpoint cache
+  std::unordered_map<std::string, CachedEndpoint>
+    _endpointCache{};  ///< Endpoints to remote workers, keyed by address and error handling mode
+  std::mutex _amFlowControlEndpointsMutex{};  ///< Mutex to access flow-controlled endpoints
+  std::unordered_map<ucp_ep_h, std::weak_ptr<Endpoint>>
+    _amFlowControlEndpoints{};  ///< Endpoints with AM flow control, keyed by UCP handle
+  std::mutex _amAggregationEndpointsMutex{};  ///< Mutex to access aggregating endpoints
+  std::unordered_map<Endpoint*, std::weak_ptr<Endpoint>>
+    _amAggregationEndpoints{};  ///< Endpoints with a pending batch of aggregated AMs
+  std::atomic<bool> _hasAmAggregationPending{
+    false};  ///< Whether any endpoint has a pending batch of aggregated AMs
+  std::chrono::steady_clock::time_point _requestDeadlinesEpoch{
+    std::chrono::steady_clock::now()};  ///< Time of tick zero of `_requestDeadlines`
+  std::mutex _requestDeadlinesMutex{};  ///< Mutex to access the request deadlines
+  TimerWheel<std::weak_ptr<Request>>
+    _requestDeadlines{};  ///< Deadlines of requests, in ticks of one millisecond
+  std::atomic<bool> _hasRequestDeadlines{
+    false};  ///< Whether `_requestDeadlines` may contain requests, avoids locking
+  std::atomic<uint64_t> _requestDeadlinesExpired{
+    0};  ///< Number of requests canceled because their deadline expired
+  std::mutex _requestsAwaitingReadinessMutex{};  ///< Mutex to access sends awaiting readiness
+  std::list<std::pair<std::shared_ptr<Request>, DelayedSubmissionCallbackType>>
+    _requestsAwaitingReadiness{};  ///< Sends awaiting readiness, in submission order
+  std::unordered_map<const Endpoint*, size_t>
+    _endpointsAwaitingReadiness{};  ///< Number of sends awaiting readiness on each endpoint
+  std::atomic<bool> _hasRequestsAwaitingReadiness{
+    false};  ///< Whether any send awaits readiness, avoids locking
+  std::mutex _compressionMutex{};          ///< Mutex to access the compression configuration
+  CompressionConfig _compressionConfig{};  ///< Compression of frames of multi-buffer sends
+  std::shared_ptr<CompletionExecutor> _compressionExecutor{
+    nullptr};  ///< Threads compressing and decompressing frames, inline if `nullptr`
+  internal::CompressionCounters
+    _compressionCounters{};  ///< Counters of frames compressed and decompressed
+  std::atomic<bool> _compactHeaders{
+    false};  ///< Whether headers of multi-buffer sends are serialized in the compact format
+
+  friend class Endpoint;
+  friend class Request;
+  friend class RequestTagMulti;
 
   friend std::shared_ptr<RequestAm> createRequestAm(
     std::shared_ptr<Endpoint> endpoint,
@@ -71,21 +175,252 @@ class Worker : public Component {
  protected:
   bool _enableFuture{
     false};  ///< Boolean identifying whether the worker was created with future capability
-  std::mutex _futuresPoolMutex{};  ///< Mutex to access the futures pool
+  std::mutex _futuresPoolMutex{};  ///< Mutex serializing consumers of the futures pool
   std::queue<std::shared_ptr<Future>>
     _futuresPool{};  ///< Futures pool to prevent running out of fresh futures
+  utils::MPSCQueue<std::vector<std::shared_ptr<Future>>>
+    _futuresPoolRefills{};  ///< Batches of new futures handed off lock-free by refills
+  std::atomic<size_t> _futuresPoolAvailable{0};     ///< Futures available, including refills
+  std::atomic<size_t> _futuresPoolSize{100};        ///< Number of futures a refill fills up to
+  std::atomic<size_t> _futuresPoolLowWatermark{50};  ///< Number of futures triggering a refill
+  std::atomic<uint64_t> _futuresPoolRefillCount{0};  ///< Number of refills of the futures pool
   std::shared_ptr<Notifier> _notifier{nullptr};  ///< Notifier object
-  std::shared_ptr<internal::AmData>
-    _amData;  ///< Worker data made available to Active Messages callback
+  std::unordered_map<unsigned int, std::shared_ptr<internal::AmData>>
+    _amData{};  ///< Worker data made available to Active Messages callbacks, per AM ID
+  mutable std::mutex _amDataMutex{};  ///< Mutex to access the Active Messages data map
+  std::unordered_map<BufferType, std::shared_ptr<BufferPool>>
+    _bufferPools{};  ///< Buffer pools used for internally-allocated buffers, per buffer type
+  std::unordered_map<BufferType, AmAllocatorType>
+    _bufferAllocators{};  ///< Allocators used for internally-allocated buffers, per buffer type
+  mutable std::mutex _bufferPoolsMutex{};  ///< Mutex to access the buffer pools and allocators
+
+  TagDrainMode _tagDrainMode{TagDrainMode::Copy};  ///< How to drain unmatched tag messages
+  size_t _tagDrainMaxInflight{16};                 ///< Maximum messages drained at once
 
  private:
   /**
    * @brief Drain the worker for uncaught tag messages received.
    *
    * Called by the destructor, any uncaught tag messages received will be drained so as
-   * not to generate UCX warnings.
+   * not to generate UCX warnings. Up to `_tagDrainMaxInflight` messages are drained
+   * concurrently according to `_tagDrainMode`, see `setTagDrainOptions()`.
+   *
+   * @returns The number of messages drained.
+   */
+  size_t drainWorkerTagRecv();
+
+  /**
+   * @brief Ensure the worker has been progressed at least once.
+   *
+   * Progress the worker, or if the progress thread is running, wait for it to complete a
+   * progress iteration.
+   */
+  void ensureProgressed();
+
+  /**
+   * @brief Evict an endpoint from the endpoint cache.
+   *
+   * Called by the UCP endpoint error callback, evicts the endpoint owning `callbackData`
+   * from the endpoint cache, if cached, so that subsequent calls to
+   * `createEndpointFromWorkerAddress()` create a new endpoint to the remote worker. Entries
+   * of endpoints already released are pruned as well.
+   *
+   * @param[in] callbackData  the error callback data of the endpoint that errored.
+   */
+  void evictCachedEndpoint(const ErrorCallbackData* callbackData);
+
+  /**
+   * @brief Get the executor of request completion callbacks.
+   *
+   * Get the executor of request completion callbacks, if one was set with
+   * `setCompletionCallbackExecutor()` or `startCompletionCallbackThreads()`.
+   *
+   * @returns The completion executor, or `nullptr` if completion callbacks execute inline.
+   */
+  std::shared_ptr<CompletionExecutor> getCompletionExecutor();
+
+  /**
+   * @brief Replace the executor of request completion callbacks.
+   *
+   * Replaces the executor of request completion callbacks, the previous executor, if any,
+   * is destroyed after dispatching all its pending completion callbacks.
+   *
+   * @param[in] completionExecutor  the new completion executor, `nullptr` to execute
+   *                                completion callbacks inline.
+   * @param[in] notifyFutures       whether the executor also notifies futures of requests.
+   */
+  void replaceCompletionExecutor(std::shared_ptr<CompletionExecutor> completionExecutor,
+                                 bool notifyFutures = false);
+
+  /**
+   * @brief Create and register the data for an active message ID.
+   *
+   * Create the data for an active message ID with the default host allocator and register
+   * the UCP active message handler for that ID.
+   *
+   * @throws std::runtime_error if the active message ID is already registered.
+   * @throws ucxx::Error        if the UCP active message handler could not be set.
+   *
+   * @param[in] amId              the active message ID.
+   * @param[in] receiverCallback  the callback to deliver completed messages to, or
+   *                              `nullptr` to queue them for `ucxx::Endpoint::amRecv()`.
+   * @param[in] worker            the worker owning the data, may be empty if not yet
+   *                              available (i.e., during construction).
+   *
+   * @returns The data for the active message ID.
+   */
+  std::shared_ptr<internal::AmData> createAmData(unsigned int amId,
+                                                 AmReceiverCallbackType receiverCallback,
+                                                 std::weak_ptr<Worker> worker);
+
+  /**
+   * @brief Get the data for an active message ID.
+   *
+   * @throws std::runtime_error if the active message ID is not registered.
+   *
+   * @param[in] amId  the active message ID.
+   *
+   * @returns The data for the active message ID.
+   */
+  std::shared_ptr<internal::AmData> getAmData(unsigned int amId) const;
+
+  /**
+   * @brief Active message handler receiving flow control credits.
+   *
+   * Handle credits returned by a remote worker once messages sent with flow control were
+   * delivered to the application, granting them back to the endpoint they were sent from.
+   *
+   * @param[in] arg           the `ucxx::Worker` pointer.
+   * @param[in] header        the `ucxx::internal::AmCredit` being returned.
+   * @param[in] header_length the header length.
+   * @param[in] data          unused, credits carry no data.
+   * @param[in] length        unused, credits carry no data.
+   * @param[in] param         the active message parameters, including the reply endpoint.
+   *
+   * @returns Always `UCS_OK`, the credit is processed immediately.
+   */
+  static ucs_status_t amCreditCallback(void* arg,
+                                       const void* header,
+                                       size_t header_length,
+                                       void* data,
+                                       size_t length,
+                                       const ucp_am_recv_param_t* param);
+
+  /**
+   * @brief Register an endpoint to be granted active message credits.
+   *
+   * @param[in] handle    the UCP handle of the endpoint credits are returned to.
+   * @param[in] endpoint  the endpoint to grant credits to.
+   */
+  void registerAmFlowControlEndpoint(ucp_ep_h handle, std::weak_ptr<Endpoint> endpoint);
+
+  /**
+   * @brief Stop granting active message credits to an endpoint.
+   *
+   * @param[in] handle    the UCP handle of the endpoint.
+   */
+  void unregisterAmFlowControlEndpoint(ucp_ep_h handle);
+
+  /**
+   * @brief Active message handler receiving batches of aggregated active messages.
+   *
+   * Split a batch of active messages aggregated by a remote endpoint and handle each
+   * message as if it was received individually, see `ucxx::Endpoint::setAmAggregation()`.
+   *
+   * @param[in] arg           the `ucxx::Worker` pointer.
+   * @param[in] header        unused, batches carry no header.
+   * @param[in] header_length unused, batches carry no header.
+   * @param[in] data          the batch of encoded messages.
+   * @param[in] length        the length of the batch in bytes.
+   * @param[in] param         the active message parameters, including the reply endpoint.
+   *
+   * @returns Always `UCS_OK`, messages are copied before this returns.
+   */
+  static ucs_status_t amAggregationCallback(void* arg,
+                                            const void* header,
+                                            size_t header_length,
+                                            void* data,
+                                            size_t length,
+                                            const ucp_am_recv_param_t* param);
+
+  /**
+   * @brief Register an endpoint with a pending batch of aggregated active messages.
+   *
+   * Register an endpoint whose batch of aggregated active messages is submitted upon
+   * `progress()` once its time window expires.
+   *
+   * @param[in] endpoint     the endpoint.
+   * @param[in] weakPointer  weak reference to the endpoint.
+   */
+  void registerAmAggregationEndpoint(Endpoint* endpoint, std::weak_ptr<Endpoint> weakPointer);
+
+  /**
+   * @brief Unregister an endpoint whose batch of aggregated active messages was submitted.
+   *
+   * @param[in] endpoint  the endpoint.
+   */
+  void unregisterAmAggregationEndpoint(Endpoint* endpoint);
+
+  /**
+   * @brief Submit batches of aggregated active messages whose time window expired.
+   */
+  void flushExpiredAmAggregations();
+
+  /**
+   * @brief Schedule cancelation of a request once its deadline expires.
+   *
+   * Schedule the request to be canceled by the first `progress()` after `deadline` if it
+   * has not completed by then.
+   *
+   * @param[in] request   the request.
+   * @param[in] deadline  the time by which the request must complete.
+   */
+  void scheduleRequestDeadline(std::shared_ptr<Request> request,
+                               std::chrono::steady_clock::time_point deadline);
+
+  /**
+   * @brief Schedule cancelation of requests whose deadline expired.
+   *
+   * Advance the request deadlines to the current time and schedule the cancelation of
+   * requests whose deadline expired and that have not completed with
+   * `scheduleRequestCancel()`.
+   */
+  void expireRequestDeadlines();
+
+  /**
+   * @brief Submit a request now or with the delayed submissions.
+   *
+   * Submit a request calling `callback` immediately, or register it to be called by the
+   * worker thread if delayed submission is enabled.
+   *
+   * @param[in] request  the request to which the callback belongs.
+   * @param[in] callback the callback executing the UCP transfer routine.
+   */
+  void submitRequest(std::shared_ptr<Request> request, DelayedSubmissionCallbackType callback);
+
+  /**
+   * @brief Defer the submission of a send until it is ready.
+   *
+   * Defer the submission of a send whose readiness callback does not yet report it ready,
+   * or of any send on an endpoint with sends awaiting readiness, so that sends are
+   * submitted to each endpoint in the order they were registered.
+   *
+   * @param[in] request  the request to which the callback belongs.
+   * @param[in] callback the callback executing the UCP transfer routine.
+   *
+   * @returns `true` if the submission was deferred, `false` if it must proceed.
+   */
+  bool awaitRequestReadiness(std::shared_ptr<Request> request,
+                             DelayedSubmissionCallbackType callback);
+
+  /**
+   * @brief Submit sends awaiting readiness that became ready.
+   *
+   * Check the readiness of sends awaiting it, in order, submitting those that became ready
+   * and completing those whose readiness reported an error with that error. Once a send
+   * on an endpoint is not ready the following sends on the same endpoint are not checked.
    */
-  void drainWorkerTagRecv();
+  void submitReadyRequests();
 
   /**
    * @brief Get active message receive request.
@@ -94,15 +429,21 @@ class Worker : public Component {
    * handling a request with the active messages callback, otherwise creates a new request
    * that is later populated with status and buffer by the active messages callback.
    *
-   * @param[in] ep  the endpoint handle where receiving the message, the same handle that
-   *                will later be used to reply to the message.
+   * @throws std::runtime_error if the active message ID is not registered or delivers
+   *                            messages to a receiver callback.
+   *
+   * @param[in] ep    the endpoint handle where receiving the message, the same handle that
+   *                  will later be used to reply to the message.
+   * @param[in] amId  the active message ID to receive from.
    * @param[in] createAmRecvRequestFunction function to create a new request if one is not
    *                                        already available in the pool.
    *
    * @returns Request to be subsequently checked for the completion state and data.
    */
   std::shared_ptr<RequestAm> getAmRecv(
-    ucp_ep_h ep, std::function<std::shared_ptr<RequestAm>()> createAmRecvRequestFunction);
+    ucp_ep_h ep,
+    unsigned int amId,
+    std::function<std::shared_ptr<RequestAm>()> createAmRecvRequestFunction);
 
   /**
    * @brief Stop the progress thread if running without raising warnings.
@@ -124,10 +465,27 @@ class Worker : public Component {
    */
   std::shared_ptr<Request> registerInflightRequest(std::shared_ptr<Request> request);
 
+  /**
+   * @brief Get the inflight requests shard a request belongs to.
+   *
+   * Inflight requests are distributed among multiple independently-locked shards so that
+   * requests submitted and completed concurrently from multiple threads do not serialize
+   * on a single lock. The shard is derived from the request address, thus the same shard
+   * is always selected for a given request.
+   *
+   * @param[in] request raw pointer to the request.
+   *
+   * @returns The inflight requests shard the request belongs to.
+   */
+  InflightRequests& getInflightRequestsShard(const Request* const request);
+
   /**
    * @brief Progress the worker until all communication events are completed.
    *
-   * Iteratively calls `progressOnce()` until all communication events are completed.
+   * Iteratively calls `progressOnce()` until all communication events are completed, or
+   * until the `maxProgressCalls` or `maxCompletions` of the budget set with
+   * `setProgressBudget()` are reached, in which case communication events may still be
+   * pending and `true` is returned, so that callers progress again without blocking.
    *
    * @returns whether any communication events have been progressed.
    */
@@ -150,10 +508,15 @@ class Worker : public Component {
    *                                    progress thread.
    * @param[in] enableFuture if `true`, notifies the future associated with each
    *                         `ucxx::Request`, currently used only by `ucxx::python::Worker`.
+   * @param[in] enableSerializedThreadMode if `true`, creates the UCP worker with
+   *                                       `UCS_THREAD_MODE_SERIALIZED`, see
+   *                                       `isSerializedThreadModeEnabled()`.
+   *                                       Requires `enableDelayedSubmission`.
    */
   explicit Worker(std::shared_ptr<Context> context,
-                  const bool enableDelayedSubmission = false,
-                  const bool enableFuture            = false);
+                  const bool enableDelayedSubmission    = false,
+                  const bool enableFuture               = false,
+                  const bool enableSerializedThreadMode = false);
 
  public:
   Worker()                         = delete;
@@ -184,11 +547,20 @@ class Worker : public Component {
    *                                    progress thread.
    * @param[in] enableFuture if `true`, notifies the future associated with each
    *                         `ucxx::Request`, currently used only by `ucxx::python::Worker`.
+   * @param[in] enableSerializedThreadMode if `true`, creates the UCP worker with
+   *                                       `UCS_THREAD_MODE_SERIALIZED`, see
+   *                                       `isSerializedThreadModeEnabled()`.
+   *                                       Requires `enableDelayedSubmission`.
+   *
+   * @throws std::invalid_argument if `enableSerializedThreadMode` is `true` but
+   *                               `enableDelayedSubmission` is `false`.
+   *
    * @returns The `shared_ptr<ucxx::Worker>` object
    */
   friend std::shared_ptr<Worker> createWorker(std::shared_ptr<Context> context,
                                               const bool enableDelayedSubmission,
-                                              const bool enableFuture);
+                                              const bool enableFuture,
+                                              const bool enableSerializedThreadMode);
 
   /**
    * @brief `ucxx::Worker` destructor.
@@ -212,6 +584,13 @@ class Worker : public Component {
    */
   ucp_worker_h getHandle();
 
+  /**
+   * @brief Get the component as a `ucxx::Worker`.
+   *
+   * @returns The non-owning pointer to this worker.
+   */
+  Worker* asWorker() noexcept override;
+
   /**
    * @brief Get information about the underlying `ucp_worker_h` object.
    *
@@ -264,6 +643,20 @@ class Worker : public Component {
    */
   bool arm();
 
+  /**
+   * @brief Get the epoll file descriptor of the worker.
+   *
+   * Get the epoll file descriptor created by `initBlockingProgressMode()`, which becomes
+   * readable when the UCP worker has events to progress after being armed with `arm()`.
+   * This allows integrating the worker with external event loops, such as Python's
+   * asyncio, that wait on file descriptors instead of calling `progressWorkerEvent()`.
+   *
+   * @throws std::runtime_error if blocking progress mode has not been initialized.
+   *
+   * @returns The epoll file descriptor.
+   */
+  int getEpollFileDescriptor() const;
+
   /**
    * @brief Progress worker event while in blocking progress mode.
    *
@@ -293,6 +686,189 @@ class Worker : public Component {
    */
   bool progressWorkerEvent(const int epollTimeout = -1);
 
+  /**
+   * @brief Progress the worker spinning for a period before blocking.
+   *
+   * Hybrid of polling and blocking progress modes. Progress the worker without blocking
+   * and return immediately while any communication has been progressed within the last
+   * `spinPeriodNs` nanoseconds, providing near-polling latency when busy. Once the worker
+   * has been idle for longer than that period, arm the worker and block until a new worker
+   * event has happened or `epollTimeout` has elapsed, as `progressWorkerEvent()` would, thus
+   * not fully utilizing a CPU core when idle. Waking up due to a worker event resets the
+   * spin period. Requires blocking progress mode to be initialized with
+   * `initBlockingProgressMode()` before the first call to this method.
+   *
+   * The number of times the worker progressed without blocking and the number of times it
+   * blocked are available via `getProgressSpinHits()` and `getProgressSleeps()`.
+   *
+   * @code{.cpp}
+   * // worker is `std::shared_ptr<ucxx::Worker>`
+   *
+   * // Spin for 50us after the last activity, then block for up to 100ms.
+   * worker->initBlockingProgressMode();
+   * while (!stop)
+   *   worker->progressHybrid(50000, 100);
+   * @endcode
+   *
+   * @param[in] spinPeriodNs  period in nanoseconds to keep spinning after the last time
+   *                          any communication was progressed.
+   * @param[in] epollTimeout  timeout in ms when waiting for worker event, or -1 to block
+   *                          indefinitely.
+   *
+   * @returns `true` if any communication was progressed, `false` otherwise.
+   */
+  bool progressHybrid(const uint64_t spinPeriodNs, const int epollTimeout = -1);
+
+  /**
+   * @brief Get the number of times `progressHybrid()` progressed without blocking.
+   *
+   * @returns The number of `progressHybrid()` calls that progressed any communication
+   *          without blocking.
+   */
+  uint64_t getProgressSpinHits() const;
+
+  /**
+   * @brief Get the number of times `progressHybrid()` blocked waiting for an event.
+   *
+   * @returns The number of `progressHybrid()` calls that blocked waiting for a worker
+   *          event.
+   */
+  uint64_t getProgressSleeps() const;
+
+  /**
+   * @brief Get a snapshot of the worker statistics.
+   *
+   * Get a snapshot of the counters of requests created by the worker and all of its
+   * endpoints, of the worker progress, of the delayed submissions processed and of the
+   * futures pool refills. All counters are updated with relaxed atomic operations, thus
+   * each counter is individually consistent but the snapshot may not be consistent across
+   * counters while communication is in progress. Statistics are always collected, this
+   * method may be called from any thread without affecting the progress of the worker.
+   *
+   * @code{.cpp}
+   * // worker is `std::shared_ptr<ucxx::Worker>`
+   * auto statistics = worker->getStatistics();
+   * auto backlog    = statistics.requestsSubmitted - statistics.requestsCompleted -
+   *                statistics.requestsFailed - statistics.requestsCanceled;
+   * @endcode
+   *
+   * @returns The snapshot of the worker statistics.
+   */
+  WorkerStatistics getStatistics() const;
+
+  /**
+   * @brief Configure request lifecycle tracing.
+   *
+   * Trace the lifecycle of 1 in `sampleRate` requests created by the worker and all its
+   * endpoints, recording when each sampled request was created, handed to UCX, completed
+   * and had its status set (including notifying its Python future and executing its user
+   * callback), see `ucxx::RequestTrace`. Traces of the `capacity` most recently completed
+   * sampled requests are kept and can be exported with `getRequestTraces()`. Tracing is
+   * disabled by default, unless the `UCXX_REQUEST_TRACE_SAMPLE_RATE` and (optionally)
+   * `UCXX_REQUEST_TRACE_CAPACITY` environment variables are set when the worker is
+   * created. Reconfiguring discards all traces currently held.
+   *
+   * @code{.cpp}
+   * // worker is `std::shared_ptr<ucxx::Worker>`
+   *
+   * // Trace 1 in 100 requests, keeping the last 4096 traces.
+   * worker->setRequestTracing(100, 4096);
+   * @endcode
+   *
+   * @throws std::runtime_error if `sampleRate` is positive and `capacity` is `0`.
+   *
+   * @param[in] sampleRate  trace 1 in `sampleRate` requests, `0` disables tracing.
+   * @param[in] capacity    maximum number of traces kept.
+   */
+  void setRequestTracing(uint64_t sampleRate, size_t capacity = 1024);
+
+  /**
+   * @brief Get the lifecycle traces of sampled requests.
+   *
+   * Get the traces of the most recently completed sampled requests, see
+   * `setRequestTracing()`.
+   *
+   * @param[in] clear whether to discard the traces after copying them, allowing
+   *                  periodic exports without duplicates.
+   *
+   * @returns The traces, ordered from oldest to newest completion.
+   */
+  std::vector<RequestTrace> getRequestTraces(bool clear = false);
+
+  /**
+   * @brief Start capturing the traffic of the worker.
+   *
+   * Record the type, size, tag, memory type, endpoint and inter-arrival time of every
+   * communication operation of the worker and all its endpoints to a compact binary trace
+   * at `path`, which can be replayed by the `ucxx_replay` benchmark to reproduce the
+   * workload, see `ucxx::TrafficCapture`. Capture may also be started when the worker is
+   * created by setting `UCXX_TRAFFIC_CAPTURE` to the trace path, where `%p` is replaced by
+   * the process ID and `%w` by the index of the worker within the process, see
+   * `ucxx::TrafficCapture::startFromEnvironment()`. Capture is disabled by default, and
+   * costs a single relaxed atomic load per request when disabled.
+   *
+   * @code{.cpp}
+   * // `worker` is `std::shared_ptr<ucxx::Worker>`
+   * worker->startTrafficCapture("/tmp/trace.0");
+   * // Run the workload
+   * worker->stopTrafficCapture();
+   * @endcode
+   *
+   * @throws std::ios_base::failure if the trace file could not be opened.
+   *
+   * @param[in] path  the path of the trace file, truncated if it exists.
+   */
+  void startTrafficCapture(const std::string& path);
+
+  /**
+   * @brief Stop capturing the traffic of the worker.
+   *
+   * Stop capturing and write all operations still buffered to the trace file, does
+   * nothing if no capture is in progress.
+   */
+  void stopTrafficCapture();
+
+  /**
+   * @brief Inquire if the traffic of the worker is being captured.
+   *
+   * @returns Whether a traffic capture is in progress, see `startTrafficCapture()`.
+   */
+  bool isTrafficCaptureEnabled() const;
+
+  /**
+   * @brief Enable or disable the endpoint cache.
+   *
+   * When enabled, `createEndpointFromWorkerAddress()` returns the existing endpoint to a
+   * remote worker if the application still holds a reference to one created with the same
+   * error handling mode and it has neither errored nor been closed, instead of creating a
+   * new UCP endpoint with its own lanes and resources. Application layers that are unaware
+   * of each other's endpoints thus share a single endpoint per remote worker.
+   *
+   * The cache only holds weak references, endpoints are still destroyed when the last
+   * reference is released. Endpoints that error are evicted by the endpoint error
+   * callback. Disabled by default, disabling it discards all cached entries but doesn't
+   * affect endpoints previously returned.
+   *
+   * @code{.cpp}
+   * // worker is `std::shared_ptr<ucxx::Worker>`, `address` is `std::shared_ptr<Address>`
+   * worker->setEndpointCacheEnabled(true);
+   *
+   * auto ep1 = worker->createEndpointFromWorkerAddress(address);
+   * auto ep2 = worker->createEndpointFromWorkerAddress(address);
+   * assert(ep1 == ep2);
+   * @endcode
+   *
+   * @param[in] enabled whether the endpoint cache should be enabled.
+   */
+  void setEndpointCacheEnabled(bool enabled);
+
+  /**
+   * @brief Check whether the endpoint cache is enabled.
+   *
+   * @returns `true` if the endpoint cache is enabled, `false` otherwise.
+   */
+  bool isEndpointCacheEnabled() const;
+
   /**
    * @brief Signal the worker that an event happened.
    *
@@ -396,6 +972,17 @@ class Worker : public Component {
    * thread, thus decreasing computation on the caller thread, but potentially increasing
    * transfer latency.
    *
+   * The worker is only signaled by the first registration after the progress thread last
+   * processed delayed submissions, bursts of registrations thus incur a single wakeup.
+   *
+   * The request is submitted with the priority class returned by
+   * `ucxx::Request::getSubmissionPriority()`, see `setDelayedSubmissionBudget()`.
+   *
+   * Sends with a `ucxx::RequestReadinessCallback` are only submitted once it reports them
+   * ready, which is checked by every `progress()`, while the worker progress thread avoids
+   * blocking on events. Any later send on the same endpoint is then submitted after them,
+   * preserving the order of sends on each endpoint.
+   *
    * @param[in] request  the request to which the callback belongs, ensuring it remains
    *                     alive until the callback is invoked.
    * @param[in] callback the callback set to execute the UCP transfer routine during the
@@ -446,6 +1033,134 @@ class Worker : public Component {
    */
   bool isDelayedRequestSubmissionEnabled() const;
 
+  /**
+   * @brief Set the budget of delayed request submissions per progress iteration.
+   *
+   * Set the maximum number of `ucxx::SubmissionPriority::Normal` and `Bulk` delayed
+   * request submissions per iteration of the progress thread, preventing large bursts of
+   * lower priority requests from delaying submission of `High` priority ones, which are
+   * always submitted in the next iteration. Requests exceeding the budget are submitted
+   * in order by the following iterations, which run without waiting for events. Only has
+   * effect if the worker was created with delayed submission enabled. The priority class
+   * of requests is set per endpoint with `ucxx::SendHints::submissionPriority`.
+   *
+   * @code{.cpp}
+   * // `worker` is `std::shared_ptr<ucxx::Worker>` created with delayed submission enabled
+   * worker->setDelayedSubmissionBudget(64);
+   *
+   * // `control` is `std::shared_ptr<ucxx::Endpoint>`, used for small control messages
+   * ucxx::SendHints sendHints{};
+   * sendHints.submissionPriority = ucxx::SubmissionPriority::High;
+   * control->setSendHints(sendHints);
+   * @endcode
+   *
+   * @param[in] budget  the maximum number of submissions per iteration, `0` (the default)
+   *                    for no limit.
+   */
+  void setDelayedSubmissionBudget(size_t budget);
+
+  /**
+   * @brief Get the budget of delayed request submissions per progress iteration.
+   *
+   * @returns The maximum number of submissions per iteration, or `0` if there is no limit.
+   */
+  size_t getDelayedSubmissionBudget() const;
+
+  /**
+   * @brief Set the bounds on the work performed by each progress iteration.
+   *
+   * Set the bounds on the work performed by each call to `progress()` and each iteration
+   * of the progress thread, see `ucxx::ProgressBudget`. By default `progress()` calls
+   * `ucp_worker_progress()` until no more communication is progressed and the progress
+   * thread submits all pending delayed requests, which under heavy load may take long
+   * enough to noticeably delay callbacks registered with `registerGenericPre()` and
+   * `registerGenericPost()`. Work left over when the budget is exhausted is resumed by
+   * the next iteration without blocking, thus the budget bounds latency without reducing
+   * throughput. `maxSubmissions` is the same budget set by `setDelayedSubmissionBudget()`.
+   *
+   * @code{.cpp}
+   * // `worker` is `std::shared_ptr<ucxx::Worker>`
+   * ucxx::ProgressBudget budget{};
+   * budget.maxProgressCalls = 16;
+   * budget.maxSubmissions   = 64;
+   * budget.maxCompletions   = 256;
+   * worker->setProgressBudget(budget);
+   * @endcode
+   *
+   * @param[in] budget  the bounds on the work performed by each progress iteration.
+   */
+  void setProgressBudget(const ProgressBudget& budget);
+
+  /**
+   * @brief Get the bounds on the work performed by each progress iteration.
+   *
+   * @returns The bounds on the work performed by each progress iteration.
+   */
+  ProgressBudget getProgressBudget() const;
+
+  /**
+   * @brief Inquire if the UCP worker was created with serialized thread mode.
+   *
+   * Check whether the UCP worker was created with `UCS_THREAD_MODE_SERIALIZED`, in which
+   * case UCX does not take its internal worker lock on each progress and transfer call,
+   * relying on UCXX to serialize all accesses to the UCP worker instead. While the
+   * progress thread runs it is the only thread accessing the UCP worker, transfers are
+   * submitted by it as delayed submissions and other operations accessing the UCP
+   * worker, such as creating endpoints, probing tags or releasing received buffers, are
+   * executed by it via `registerGenericPre()`, see `invokeSerialized()`. Calling any of
+   * the `progress` methods from other threads while the progress thread runs raises an
+   * exception. Before the progress thread is started and after it is stopped, the
+   * application must ensure the worker is only used by one thread at a time.
+   *
+   * @returns `true` if serialized thread mode is enabled, `false` otherwise.
+   */
+  bool isSerializedThreadModeEnabled() const;
+
+  /**
+   * @brief Inquire if the calling thread must not access the UCP worker directly.
+   *
+   * Check whether the calling thread must not access the UCP worker directly, which is the
+   * case when serialized thread mode is enabled, the progress thread is running and the
+   * calling thread is not the progress thread.
+   *
+   * WARNING: This is not intended to be called by the user, but it currently needs to be
+   * a public method so that UCXX objects owned by the worker may access it.
+   *
+   * @returns `true` if the UCP worker must only be accessed via `invokeSerialized()` or
+   *          `scheduleSerialized()`, `false` otherwise.
+   */
+  bool requiresSerializedAccess();
+
+  /**
+   * @brief Execute a function accessing the UCP worker and wait for it to complete.
+   *
+   * Execute a function accessing the UCP worker, or any of its endpoints, immediately if
+   * the calling thread may access the UCP worker, otherwise in the progress thread via
+   * `registerGenericPre()`, blocking until it completes. Exceptions raised by `function`
+   * are rethrown in the calling thread.
+   *
+   * WARNING: This is not intended to be called by the user, but it currently needs to be
+   * a public method so that UCXX objects owned by the worker may access it.
+   *
+   * @param[in] function  the function accessing the UCP worker.
+   */
+  void invokeSerialized(std::function<void()> function);
+
+  /**
+   * @brief Execute a function accessing the UCP worker without waiting for it.
+   *
+   * Execute a function accessing the UCP worker, or any of its endpoints, immediately if
+   * the calling thread may access the UCP worker, otherwise schedule it for execution in
+   * the progress thread via `registerGenericPre()` and return immediately. Used to release
+   * UCX resources from destructors, which must not block on the progress thread.
+   *
+   * WARNING: This is not intended to be called by the user, but it currently needs to be
+   * a public method so that UCXX objects owned by the worker may access it.
+   *
+   * @param[in] function  the function accessing the UCP worker, which must not throw.
+   */
+  void scheduleSerialized(std::function<void()> function);
+
   /**
    * @brief Inquire if worker has been created with future support.
    *
@@ -455,29 +1170,73 @@ class Worker : public Component {
    */
   bool isFutureEnabled() const;
 
+  /**
+   * @brief Get the completion queue of native C++ futures.
+   *
+   * Get the completion queue where native C++ futures of requests created with
+   * `enablePythonFuture=true` are enqueued upon completion once harvesting is enabled,
+   * allowing pure C++ applications to harvest completions in batches, see
+   * `ucxx::CompletionQueue`.
+   *
+   * @returns The completion queue if the worker has been created with future support and
+   *          uses native C++ futures, `nullptr` otherwise (e.g., for Python workers).
+   */
+  std::shared_ptr<CompletionQueue> getCompletionQueue() const;
+
+  /**
+   * @brief Get the memory pool requests are allocated from.
+   *
+   * Get the memory pool used to allocate all `ucxx::Request` objects, and their
+   * `std::shared_ptr` control blocks, created for this worker and its endpoints, so that
+   * steady-state request creation does not call the system allocator.
+   *
+   * @returns The memory pool requests are allocated from.
+   */
+  std::shared_ptr<utils::MemoryPool> getRequestMemoryPool() const;
+
   /**
    * @brief Populate the future pool.
    *
    * To avoid taking blocking resources (such as the Python GIL) for every new future
    * required by each `ucxx::Request`, the `ucxx::Worker` maintains a pool of futures
-   * that can be acquired when a new `ucxx::Request` is created. Currently the pool has
+   * that can be acquired when a new `ucxx::Request` is created. By default the pool has
    * a maximum size of 100 objects, and will refill once it goes under 50, otherwise
-   * calling this functions results in a no-op.
+   * calling this functions results in a no-op, see `setFuturesPoolSize()`. Native C++
+   * futures are created on demand, thus this is a no-op unless specialized by a derived
+   * class.
    *
    * @throws std::runtime_error if future support is not implemented.
    */
   virtual void populateFuturesPool();
 
+  /**
+   * @brief Configure the size of the future pool.
+   *
+   * Configure the number of futures `populateFuturesPool()` fills the pool up to, and the
+   * low watermark under which the pool is refilled. Applications posting large bursts of
+   * requests should set a size at least as large as the burst, so that requests never
+   * need to create futures inline. Takes effect on the next refill.
+   *
+   * @param[in] size          the number of futures a refill fills the pool up to.
+   * @param[in] lowWatermark  the number of available futures under which the pool is
+   *                          refilled.
+   *
+   * @throws std::runtime_error if `size` is zero or smaller than `lowWatermark`.
+   */
+  void setFuturesPoolSize(const size_t size, const size_t lowWatermark);
+
   /**
    * @brief Get a future from the pool.
    *
    * Get a future from the pool. If the pool is empty,
    * `ucxx::Worker::populateFuturesPool()` is called and a warning is raised, since
    * that likely means the user is missing to call the aforementioned method regularly.
+   * Unless specialized by a derived class, returns a new `ucxx::CompletionFuture` notified
+   * through the worker's completion queue, see `getCompletionQueue()`.
    *
    * @throws std::runtime_error if future support is not implemented.
    *
-   * @returns The `shared_ptr<ucxx::python::Future>` object
+   * @returns The `shared_ptr<ucxx::Future>` object
    */
   virtual std::shared_ptr<Future> getFuture();
 
@@ -532,19 +1291,204 @@ class Worker : public Component {
    */
   void setProgressThreadStartCallback(std::function<void(void*)> callback, void* callbackArg);
 
+  /**
+   * @brief Bind a CUDA device to the progress thread.
+   *
+   * Make the primary CUDA context of `device` current on progress threads started
+   * afterwards, before the callback set with `setProgressThreadStartCallback()` executes.
+   * The context is set up natively with the CUDA driver API, loaded at runtime, instead of
+   * requiring a start callback to do so, e.g., with Numba in Python. Has no effect if the
+   * parent context does not have CUDA support, see `ucxx::Context::hasCudaSupport()`, or
+   * if the CUDA driver is not available.
+   *
+   * @param[in] device  the CUDA device ordinal, or `-1` for the device of the CUDA context
+   *                    current on the thread calling `startProgressThread()`, falling back
+   *                    to device `0` if no context is current.
+   */
+  void setProgressThreadCudaDevice(const int device = -1);
+
+  /**
+   * @brief Execute request completion callbacks with a user-defined executor.
+   *
+   * By default, the user-defined callback of a request (see `ucxx::Request`) executes
+   * inline when the request completes, usually on the progress thread, where a slow
+   * callback stalls all other communication on the worker. Once an executor is set, the
+   * completion callbacks are only enqueued when requests complete and are dispatched in
+   * batches of at most `batchSize` callbacks to `executor` after each worker progress, or
+   * immediately when a request completes outside of a running progress thread. The
+   * executor must arrange for the callbacks it receives to be executed, for example on an
+   * application thread pool or event loop, and should return quickly.
+   *
+   * Requests are completed, including notifying their Python futures, before their
+   * completion callbacks execute.
+   *
+   * @code{.cpp}
+   * // worker is `std::shared_ptr<ucxx::Worker>`, `pool` an application thread pool
+   * worker->setCompletionCallbackExecutor(
+   *   [&pool](std::vector<ucxx::CompletionCallback> callbacks) {
+   *     pool.submit([callbacks = std::move(callbacks)]() {
+   *       for (const auto& callback : callbacks)
+   *         callback();
+   *     });
+   *   });
+   * @endcode
+   *
+   * @throws std::invalid_argument if `executor` is empty or `batchSize` is `0`.
+   *
+   * @param[in] executor  user-defined executor of batches of completion callbacks.
+   * @param[in] batchSize maximum number of completion callbacks per batch.
+   */
+  void setCompletionCallbackExecutor(CompletionCallbackExecutor executor, size_t batchSize = 64);
+
+  /**
+   * @brief Execute request completion callbacks on internal threads.
+   *
+   * Similar to `setCompletionCallbackExecutor()`, but request completion callbacks are
+   * executed by `numThreads` threads started by the worker. With more than one thread,
+   * completion callbacks may execute concurrently and in a different order than requests
+   * completed.
+   *
+   * @throws std::invalid_argument if `numThreads` or `batchSize` is `0`.
+   *
+   * @param[in] numThreads  number of threads executing completion callbacks.
+   * @param[in] batchSize   maximum number of completion callbacks per batch, batches are
+   *                        distributed among threads.
+   */
+  void startCompletionCallbackThreads(size_t numThreads = 1, size_t batchSize = 64);
+
+  /**
+   * @brief Execute request completion work on a shared executor.
+   *
+   * Similar to `startCompletionCallbackThreads()`, but with an executor that may be shared
+   * by multiple workers, so that completion work of all of them is balanced among the
+   * executor threads, independently of the number of workers. If `notifyFutures` is
+   * `true`, notifying the futures of requests is also executed by the executor rather
+   * than by the thread completing requests.
+   *
+   * @code{.cpp}
+   * // `workers` is `std::vector<std::shared_ptr<ucxx::Worker>>`
+   * auto executor = std::make_shared<ucxx::CompletionExecutor>(4, 16);
+   * for (auto& worker : workers)
+   *   worker->setCompletionExecutor(executor);
+   * @endcode
+   *
+   * @throws std::invalid_argument if `completionExecutor` is `nullptr`.
+   *
+   * @param[in] completionExecutor  the completion executor.
+   * @param[in] notifyFutures       whether the executor also notifies futures of requests.
+   */
+  void setCompletionExecutor(std::shared_ptr<CompletionExecutor> completionExecutor,
+                             bool notifyFutures = false);
+
+  /**
+   * @brief Check whether the completion executor notifies futures of requests.
+   *
+   * @returns `true` if futures are notified by the completion executor, `false` otherwise.
+   */
+  bool isCompletionExecutorNotifyingFutures() const;
+
+  /**
+   * @brief Execute request completion callbacks inline.
+   *
+   * Restores the default behavior of executing request completion callbacks inline when
+   * requests complete. Completion callbacks enqueued before are dispatched, and if
+   * executed by internal threads, this method blocks until all of them have completed,
+   * unless the executor is still shared with other workers.
+   */
+  void resetCompletionCallbackExecutor();
+
+  /**
+   * @brief Set the compression of frames of multi-buffer transfers.
+   *
+   * Set how host frames of multi-buffer tag sends, i.e., `ucxx::Endpoint::tagMultiSend()`,
+   * are compressed, disabled by default. Frames of at least `config.minFrameSize` bytes
+   * sent by endpoints using one of `config.transports` are compressed with `config.codec`
+   * before being sent, frames that do not shrink are sent verbatim. Compressed frames are
+   * flagged in the header of the transfer, so that the receiver decompresses them, thus
+   * receivers need no configuration but must have been built with the codec, otherwise
+   * the frames are discarded and the receive completes with `UCS_ERR_UNSUPPORTED`.
+   *
+   * Frames are compressed and decompressed by `numThreads` internal threads, compressing
+   * the frames of a transfer in parallel, or inline by the thread sending and completing
+   * receives if `numThreads` is `0`. Frames of sends awaiting readiness and those packed
+   * are never compressed. Compression ratio and time are reported by `getStatistics()`.
+   *
+   * @code{.cpp}
+   * // `worker` is `std::shared_ptr<ucxx::Worker>`
+   * ucxx::CompressionConfig config{};
+   * config.codec = ucxx::CompressionCodec::LZ4;
+   * worker->setCompression(config, 4);
+   * @endcode
+   *
+   * @throws std::invalid_argument if `config.codec` is not available.
+   *
+   * @param[in] config      the compression configuration.
+   * @param[in] numThreads  number of internal threads compressing and decompressing
+   *                        frames, `0` to compress and decompress inline.
+   */
+  void setCompression(const CompressionConfig& config, size_t numThreads = 0);
+
+  /**
+   * @brief Get the compression of frames of multi-buffer transfers.
+   *
+   * @returns The compression configuration set with `setCompression()`.
+   */
+  CompressionConfig getCompressionConfig();
+
+  /**
+   * @brief Enable compact headers for multi-buffer sends.
+   *
+   * Serialize the headers of multi-buffer tag sends, i.e., `ucxx::Endpoint::tagMultiSend()`,
+   * in the compact variable-length format instead of the legacy fixed-size format, disabled
+   * by default. Receivers accept both formats, but peers predating the compact format only
+   * parse the legacy one, thus it must only be enabled when all peers support it. Headers
+   * of compressed frames are always compact, see `setCompression()`.
+   *
+   * @param[in] enable  whether headers are serialized in the compact format.
+   */
+  void setCompactHeaders(bool enable);
+
+  /**
+   * @brief Check whether compact headers are enabled for multi-buffer sends.
+   *
+   * @returns `true` if headers are serialized in the compact format, `false` otherwise.
+   */
+  bool isCompactHeadersEnabled() const;
+
+  /**
+   * @brief Run a compression or decompression task.
+   *
+   * Run a task compressing or decompressing frames on the internal compression threads,
+   * or inline if none were started by `setCompression()`. The task must not throw.
+   *
+   * @param[in] task  the task to run.
+   */
+  void runCompressionTask(std::function<void()> task);
+
   /**
    * @brief Start the progress thread.
    *
    * Spawns a new thread that will take care of continuously progressing the worker. The
    * thread can progress the worker in blocking mode, using `progressWorkerEvent()` only
    * when worker events happen, or in polling mode by continuously calling `progress()`
-   * (incurs in high CPU utilization).
+   * (incurs in high CPU utilization). Additionally, blocking mode can spin for a period
+   * after the last activity before blocking by specifying `spinPeriodNs`, see
+   * `progressHybrid()`. The thread may also be pinned to a set of CPUs with
+   * `cpuAffinity`, for example those returned by `getNetworkDevicesLocalCpus()`.
    *
    * @param[in] pollingMode   use polling mode if `true`, or blocking mode if `false`.
    * @param[in] epollTimeout  timeout in ms when waiting for worker event, or -1 to block
-   *                          indefinitely, only applicable if `pollingMode==true`.
+   *                          indefinitely, only applicable if `pollingMode==false`.
+   * @param[in] spinPeriodNs  period in nanoseconds to spin after the last activity before
+   *                          blocking, or `0` to always block, only applicable if
+   *                          `pollingMode==false`.
+   * @param[in] cpuAffinity   CPUs to pin the progress thread to, or empty to leave it
+   *                          unpinned.
    */
-  void startProgressThread(const bool pollingMode = false, const int epollTimeout = 1);
+  void startProgressThread(const bool pollingMode              = false,
+                           const int epollTimeout              = 1,
+                           const uint64_t spinPeriodNs         = 0,
+                           const std::vector<int>& cpuAffinity = {});
 
   /**
    * @brief Stop the progress thread.
@@ -574,6 +1518,52 @@ class Worker : public Component {
    */
   std::thread::id getProgressThreadId();
 
+  /**
+   * @brief Get the CPUs local to the network devices used by the context.
+   *
+   * Get the CPUs local to the network devices selected by the parent context's
+   * `UCX_NET_DEVICES` configuration, as reported by sysfs. Intended to be passed as
+   * `cpuAffinity` to `startProgressThread()` to place the progress thread on the NUMA node
+   * closest to the network devices.
+   *
+   * @returns the CPUs local to the network devices, or an empty vector if the devices are
+   *          not explicitly configured or their locality is unknown.
+   */
+  std::vector<int> getNetworkDevicesLocalCpus();
+
+  /**
+   * @brief Get the topology of the network devices used by the context.
+   *
+   * Get the topology of the host and the network devices selected by the parent context's
+   * `UCX_NET_DEVICES` configuration, plus any other devices specified by their PCI bus IDs,
+   * such as GPUs used by the application. The topology is intended to be serialized with
+   * `ucxx::utils::serializeTopology()` and exchanged with peers, for example together with
+   * the worker address, so that each side can determine its locality w.r.t. the peer with
+   * `getTopologyLocality()`.
+   *
+   * @param[in] pciBusIds PCI bus IDs of other devices to include, e.g., as returned by
+   *                      `cudaDeviceGetPCIBusId()`.
+   *
+   * @returns the topology of the host and devices.
+   */
+  utils::Topology getTopology(const std::vector<std::string>& pciBusIds = {});
+
+  /**
+   * @brief Determine the locality of a peer.
+   *
+   * Determine how close a peer is by comparing its topology, as obtained by the peer with
+   * `getTopology()`, with the local topology, allowing for example schedulers to group
+   * transfers among peers on the same host or behind the same PCIe switch.
+   *
+   * @param[in] remoteTopology  the topology of the peer.
+   * @param[in] pciBusIds       PCI bus IDs of other local devices to include, see
+   *                            `getTopology()`.
+   *
+   * @returns the locality of the peer.
+   */
+  TopologyLocality getTopologyLocality(const utils::Topology& remoteTopology,
+                                       const std::vector<std::string>& pciBusIds = {});
+
   /**
    * @brief Cancel inflight requests.
    *
@@ -610,6 +1600,22 @@ class Worker : public Component {
    */
   void scheduleRequestCancel(TrackedRequestsPtr trackedRequests);
 
+  /**
+   * @brief Abort inflight requests immediately.
+   *
+   * Abort inflight requests in a single pass with `ucxx::Request::abort()`, called by a
+   * `ucxx::Endpoint` when its error callback was called. As opposed to
+   * `scheduleRequestCancel()`, requests that were not submitted to UCX yet complete
+   * immediately instead of waiting for their submission, and no further progress is
+   * awaited, so that failures propagate without delay. Requests submitted to UCX are
+   * canceled, those that do not complete immediately are then scheduled for cancelation.
+   *
+   * @param[in] trackedRequests the requests tracked by a child of this class to abort.
+   *
+   * @returns Number of requests that were aborted.
+   */
+  size_t abortInflightRequests(TrackedRequestsPtr trackedRequests);
+
   /**
    * @brief Remove reference to request from internal container.
    *
@@ -617,8 +1623,8 @@ class Worker : public Component {
    * be called when a request has completed and the `ucxx::Worker` does not need to keep
    * track of it anymore. The raw pointer to a `ucxx::Request` is passed here as opposed
    * to the usual `std::shared_ptr<ucxx::Request>` used elsewhere, this is because the
-   * raw pointer address is used as key to the requests reference, and this is called
-   * from the object's destructor.
+   * raw pointer address is used to select the shard the request is tracked by, and this
+   * is called from within the request object itself.
    *
    * @param[in] request raw pointer to the request
    */
@@ -645,6 +1651,120 @@ class Worker : public Component {
    */
   bool tagProbe(const Tag tag);
 
+  /**
+   * @brief Probe and remove an uncaught tag message.
+   *
+   * Checks the worker for an uncaught tag message matching `tag` and `tagMask`, like
+   * `tagProbe()`, and if one is found removes it from the worker's unexpected queue and
+   * returns its handle along with its length and sender tag. The message must then be
+   * received with `tagMsgRecv()`, which does not match it again, allowing messages of
+   * unknown size to be received into exactly sized buffers, e.g., from a buffer pool.
+   *
+   * @code{.cpp}
+   * // `worker` is `std::shared_ptr<ucxx::Worker>`
+   * auto message = worker->tagProbeMessage(ucxx::Tag{0});
+   * if (message.handle != nullptr) {
+   *   auto buffer  = std::make_shared<ucxx::HostBuffer>(message.info.length);
+   *   auto request = worker->tagMsgRecv(message, buffer->data(), buffer->getSize());
+   * }
+   * @endcode
+   *
+   * @param[in] tag     the tag to match.
+   * @param[in] tagMask the tag mask to use.
+   *
+   * @returns The message matched, with a `nullptr` handle if no message matched.
+   */
+  TagMessage tagProbeMessage(const Tag tag, const TagMask tagMask = TagMaskFull);
+
+  /**
+   * @brief Enqueue the receive of a probed tag message.
+   *
+   * Enqueue the receive of a tag message probed and removed with `tagProbeMessage()`,
+   * returning a `std::shared<ucxx::Request>` that can be later awaited and checked for
+   * errors, like `tagRecv()`. Each probed message must be received exactly once.
+   *
+   * @throws std::invalid_argument  if `message` has no valid handle.
+   *
+   * @param[in] message           the message probed and removed with `tagProbeMessage()`.
+   * @param[in] buffer            a raw pointer to pre-allocated memory where resulting
+   *                              data will be stored.
+   * @param[in] length            the size in bytes of the buffer, which should be at least
+   *                              `message.info.length` to prevent truncation.
+   * @param[in] enableFuture      whether a future should be created and subsequently
+   *                              notified.
+   * @param[in] callbackFunction  user-defined callback function to call upon completion.
+   * @param[in] callbackData      user-defined data to pass to the `callbackFunction`.
+   * @param[in] memoryHandle      the registered memory containing the buffer, or `nullptr`
+   *                              to let UCX look up or register it.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> tagMsgRecv(const TagMessage& message,
+                                      void* buffer,
+                                      size_t length,
+                                      const bool enableFuture                      = false,
+                                      RequestCallbackUserFunction callbackFunction = nullptr,
+                                      RequestCallbackUserData callbackData         = nullptr,
+                                      std::shared_ptr<MemoryHandle> memoryHandle   = nullptr);
+
+  /**
+   * @brief Order remote memory access operations issued by the worker.
+   *
+   * Ensure all remote memory access operations issued on the worker's endpoints before
+   * this call are completed at the remote side before any operations issued after it,
+   * without waiting for the operations to complete. Use `flush()` instead to wait for
+   * completion.
+   *
+   * @throws ucxx::Error if an error occurred while attempting to fence the worker.
+   */
+  void fence();
+
+  /**
+   * @brief Enqueue a flush of the worker.
+   *
+   * Enqueue a flush of all operations previously issued on all of the worker's endpoints,
+   * returning a `std::shared_ptr<ucxx::Request>` that completes once those operations are
+   * completed both locally and remotely.
+   *
+   * Using a future may be requested by specifying `enableFuture` if the worker
+   * implementation has support for it. If a future is requested, the application must then
+   * await on this future to ensure the flush has completed.
+   *
+   * @param[in] enableFuture      whether a future should be created and subsequently
+   *                              notified.
+   * @param[in] callbackFunction  user-defined callback function to call upon completion.
+   * @param[in] callbackData      user-defined data to pass to the `callbackFunction`.
+   *
+   * @returns Request to be subsequently checked for the completion and its state.
+   */
+  std::shared_ptr<Request> flush(const bool enableFuture                      = false,
+                                 RequestCallbackUserFunction callbackFunction = nullptr,
+                                 RequestCallbackUserData callbackData         = nullptr);
+
+  /**
+   * @brief Enqueue non-blocking closes of multiple endpoints.
+   *
+   * Enqueue closing all `endpoints` like `ucxx::Endpoint::closeAsync()`, returning one
+   * `std::shared_ptr<ucxx::Request>` per endpoint, at the same index, that completes once
+   * that endpoint is closed. All closes are submitted from a single callback of the
+   * progress thread if one is running, thus the time to close all endpoints is bound by
+   * the slowest endpoint instead of the sum of the time to close each of them, as when
+   * calling `ucxx::Endpoint::close()` for each one. Endpoints that are `nullptr` or already
+   * closed are skipped and have `nullptr` returned at their index.
+   *
+   * Using a future may be requested by specifying `enableFuture` if the worker
+   * implementation has support for it. If a future is requested, the application must then
+   * await on each future to ensure the closes have completed.
+   *
+   * @param[in] endpoints     the endpoints to close, all must have been created by this
+   *                          worker or its listeners.
+   * @param[in] enableFuture  whether a future should be created and subsequently notified.
+   *
+   * @returns Requests to be subsequently checked for the completion and their state.
+   */
+  std::vector<std::shared_ptr<Request>> closeEndpoints(
+    const std::vector<std::shared_ptr<Endpoint>>& endpoints, const bool enableFuture = false);
+
   /**
    * @brief Enqueue a tag receive operation.
    *
@@ -666,6 +1786,8 @@ class Worker : public Component {
    *                              notified.
    * @param[in] callbackFunction  user-defined callback function to call upon completion.
    * @param[in] callbackData      user-defined data to pass to the `callbackFunction`.
+   * @param[in] memoryHandle      the registered memory containing the buffer, or `nullptr`
+   *                              to let UCX look up or register it.
    *
    * @returns Request to be subsequently checked for the completion and its state.
    */
@@ -675,7 +1797,51 @@ class Worker : public Component {
                                    TagMask tagMask,
                                    const bool enableFuture                      = false,
                                    RequestCallbackUserFunction callbackFunction = nullptr,
-                                   RequestCallbackUserData callbackData         = nullptr);
+                                   RequestCallbackUserData callbackData         = nullptr,
+                                   std::shared_ptr<MemoryHandle> memoryHandle   = nullptr);
+
+  /**
+   * @brief Configure how unmatched tag messages are drained upon destruction.
+   *
+   * Tag messages that were never matched by a receive are drained when the worker is
+   * destroyed, which may take a long time if large unexpected messages accumulated, e.g.,
+   * after an application failure. Draining receives up to `maxInflight` messages at once,
+   * each into a reusable scratch buffer in `TagDrainMode::Copy` mode, or without receiving
+   * any data in `TagDrainMode::Discard` mode. Defaults to `TagDrainMode::Copy` with up to
+   * 16 messages in flight.
+   *
+   * @throws std::invalid_argument if `maxInflight` is `0`.
+   *
+   * @param[in] mode        the mode to drain unmatched tag messages with.
+   * @param[in] maxInflight the maximum number of messages drained concurrently.
+   */
+  void setTagDrainOptions(TagDrainMode mode, size_t maxInflight);
+
+  /**
+   * @brief Create a ring of tag receives that are posted again upon completion.
+   *
+   * Create a ring of `numBuffers` tag receives from any endpoint, each with its own buffer
+   * of `bufferSize` bytes and matching `tag` and `tagMask`, that are posted again once
+   * their messages are handled, see `ucxx::TagRecvRing` for details. The ring keeps
+   * receiving until it is stopped or destroyed.
+   *
+   * @throws std::invalid_argument if `numBuffers` or `bufferSize` is `0`.
+   *
+   * @param[in] numBuffers  number of receives kept posted.
+   * @param[in] bufferSize  size in bytes of each buffer, larger messages fail with
+   *                        `UCS_ERR_MESSAGE_TRUNCATED`.
+   * @param[in] tag         the tag to match.
+   * @param[in] tagMask     the tag mask to use.
+   * @param[in] callback    user-defined callback handling received messages, or `nullptr`
+   *                        to harvest them with `ucxx::TagRecvRing::poll()`.
+   *
+   * @returns The `shared_ptr<ucxx::TagRecvRing>` object.
+   */
+  std::shared_ptr<TagRecvRing> createTagRecvRing(size_t numBuffers,
+                                                 size_t bufferSize,
+                                                 Tag tag,
+                                                 TagMask tagMask,
+                                                 TagRecvRingCallback callback = nullptr);
 
   /**
    * @brief Get the address of the UCX worker object.
@@ -740,6 +1906,10 @@ class Worker : public Component {
    *
    * @throws ucxx::Error if an error occurred while attempting to create the endpoint.
    *
+   * If the endpoint cache is enabled, see `setEndpointCacheEnabled()`, a live endpoint
+   * previously created to the same remote worker with the same `endpointErrorHandling` is
+   * returned instead of creating a new one.
+   *
    * @param[in] address address of the remote UCX worker.
    * @param[in] endpointErrorHandling enable endpoint error handling if `true`,
    *                                  disable otherwise.
@@ -749,6 +1919,70 @@ class Worker : public Component {
   std::shared_ptr<Endpoint> createEndpointFromWorkerAddress(std::shared_ptr<Address> address,
                                                             bool endpointErrorHandling = true);
 
+  /**
+   * @brief Create endpoints to multiple workers listening on specific IPs and ports.
+   *
+   * Creates one endpoint to each remote worker listening on the IP address or hostname and
+   * port pairs in `hosts`, as `createEndpointFromHostname()` would. If the worker is
+   * running a progress thread, all UCP endpoints are created by it in a single batch,
+   * rather than waiting for the progress thread once per endpoint.
+   *
+   * UCX establishes connections lazily, upon the first operation posted to an endpoint.
+   * Specifying `eagerWireup` posts a flush to every endpoint as soon as it is created,
+   * starting all connection handshakes concurrently so that the first transfer to each
+   * peer doesn't pay the connection establishment latency. The flush requests are tracked
+   * by the endpoints' inflight requests and need not be awaited, operations posted to an
+   * endpoint afterwards are ordered after its connection is established.
+   *
+   * @code{.cpp}
+   * // `worker` is `std::shared_ptr<ucxx::Worker>`
+   * // Create endpoints to workers listening on `10.10.10.10:12345` and `10.10.10.11:12345`.
+   * auto eps = worker->createEndpointsFromHostnames(
+   *   {{"10.10.10.10", 12345}, {"10.10.10.11", 12345}}, true, true);
+   * @endcode
+   *
+   * @throws std::invalid_argument if any IP address or hostname is invalid.
+   * @throws ucxx::Error if an error occurred while attempting to create any endpoint.
+   *
+   * @param[in] hosts IP address or hostname and port pairs where the remote workers are
+   *                  listening at.
+   * @param[in] endpointErrorHandling enable endpoint error handling if `true`,
+   *                                  disable otherwise.
+   * @param[in] eagerWireup           establish connections immediately if `true`,
+   *                                  upon the first operation otherwise.
+   *
+   * @returns The `shared_ptr<ucxx::Endpoint>` objects, in the same order as `hosts`.
+   */
+  std::vector<std::shared_ptr<Endpoint>> createEndpointsFromHostnames(
+    const std::vector<std::pair<std::string, uint16_t>>& hosts,
+    bool endpointErrorHandling = true,
+    bool eagerWireup           = false);
+
+  /**
+   * @brief Create endpoints to multiple workers located at UCX addresses.
+   *
+   * Creates one endpoint to each listener-independent remote worker in `addresses`, as
+   * `createEndpointFromWorkerAddress()` would. If the worker is running a progress thread,
+   * all UCP endpoints are created by it in a single batch, rather than waiting for the
+   * progress thread once per endpoint. See `createEndpointsFromHostnames()` for details on
+   * `eagerWireup`.
+   *
+   * @throws ucxx::Error if any address is not initialized or an error occurred while
+   *                     attempting to create any endpoint.
+   *
+   * @param[in] addresses addresses of the remote UCX workers.
+   * @param[in] endpointErrorHandling enable endpoint error handling if `true`,
+   *                                  disable otherwise.
+   * @param[in] eagerWireup           establish connections immediately if `true`,
+   *                                  upon the first operation otherwise.
+   *
+   * @returns The `shared_ptr<ucxx::Endpoint>` objects, in the same order as `addresses`.
+   */
+  std::vector<std::shared_ptr<Endpoint>> createEndpointsFromWorkerAddresses(
+    const std::vector<std::shared_ptr<Address>>& addresses,
+    bool endpointErrorHandling = true,
+    bool eagerWireup           = false);
+
   /**
    * @brief Listen for remote connections on given port.
    *
@@ -770,6 +2004,27 @@ class Worker : public Component {
                                            ucp_listener_conn_callback_t callback,
                                            void* callbackArgs);
 
+  /**
+   * @brief Listen for remote connections on given port, queuing connection requests.
+   *
+   * Starts a listener on given port that queues up to `backlog` incoming connection
+   * requests, rejecting further requests while the queue is full. Endpoints to queued
+   * clients are then created by the application with `ucxx::Listener::acceptEndpoints()`,
+   * preventing the worker progress thread from stalling while creating endpoints when
+   * many clients connect at once.
+   *
+   * @throws std::invalid_argument if `backlog` is `0`.
+   * @throws std::bad_alloc if there was an error allocating space to handle the address.
+   * @throws ucxx::Error if an error occurred while attempting to create the listener or
+   *                     to acquire its address.
+   *
+   * @param[in] port port number where to listen at.
+   * @param[in] backlog maximum number of connection requests to queue.
+   *
+   * @returns The `shared_ptr<ucxx::Listener>` object
+   */
+  std::shared_ptr<Listener> createListener(uint16_t port, size_t backlog);
+
   /**
    * @brief Register allocator for active messages.
    *
@@ -793,11 +2048,128 @@ class Worker : public Component {
    * worker->registerAmAllocator(`UCS_MEMORY_TYPE_CUDA`, ucxx::RMMBuffer);
    * @endcode
    *
+   * Allocators are registered per active message ID, the allocator is only used for
+   * messages received on `amId`.
+   *
+   * @throws std::runtime_error if the active message ID is not registered.
+   *
    * @param[in] memoryType  the memory type the allocator will be used for.
    * @param[in] allocator   the allocator callable that will be used to allocate new
    *                        active message buffers.
+   * @param[in] amId        the active message ID the allocator will be used for.
    */
-  void registerAmAllocator(ucs_memory_type_t memoryType, AmAllocatorType allocator);
+  void registerAmAllocator(ucs_memory_type_t memoryType,
+                           AmAllocatorType allocator,
+                           unsigned int amId = 0);
+
+  /**
+   * @brief Register an additional active message ID.
+   *
+   * Register an additional active message ID with its own UCP active message handler,
+   * receive queues and allocators, the default ID `0` is always registered when the
+   * context enables active messages. Messages sent to different IDs are dispatched
+   * independently, thus a slow consumer of one ID does not delay consumers of other IDs.
+   *
+   * If `receiverCallback` is specified, each completed message received on `amId` is
+   * delivered to it as a `ucxx::Request` instead of being queued for a subsequent
+   * `ucxx::Endpoint::amRecv()` call, which is then not allowed for that ID. The callback
+   * executes on the thread progressing the worker and thus must not block.
+   *
+   * @code{.cpp}
+   * // `worker` is `std::shared_ptr<ucxx::Worker>`
+   * worker->registerAmHandler(1, [](std::shared_ptr<ucxx::Request> request) {
+   *   auto buffer = request->getRecvBuffer();
+   * });
+   * @endcode
+   *
+   * @throws std::runtime_error if active messages are not enabled or the active message
+   *                            ID is already registered.
+   * @throws std::invalid_argument if the active message ID is `0xffff`, reserved for
+   *                               flow control, see `ucxx::Endpoint::setAmFlowControl()`.
+   *
+   * @param[in] amId              the active message ID to register.
+   * @param[in] receiverCallback  the callback to deliver completed messages to, or
+   *                              `nullptr` to queue them for `ucxx::Endpoint::amRecv()`.
+   */
+  void registerAmHandler(unsigned int amId, AmReceiverCallbackType receiverCallback = nullptr);
+
+  /**
+   * @brief Enable or disable zero-copy receive of eager active messages.
+   *
+   * By default, eager active messages are copied from UCX's receive buffers into a new
+   * buffer allocated with the host allocator upon arrival. When enabled, UCX is asked to
+   * keep the data of eager messages persistent, and the data is delivered to the user in a
+   * `ucxx::AmDataBuffer` without allocation or copy, the data is then returned to UCX once
+   * the buffer is destroyed. Holding many such buffers for long periods may exhaust UCX's
+   * receive buffers, thus they should be consumed and destroyed promptly. Rendezvous
+   * messages are not affected and continue to use the registered allocators. Messages that
+   * UCX cannot keep persistent are still copied.
+   *
+   * @throws std::runtime_error if the active message ID is not registered.
+   * @throws ucxx::Error        if the UCP active message handler could not be updated.
+   *
+   * @param[in] enable  whether to enable zero-copy receive of eager messages.
+   * @param[in] amId    the active message ID to configure.
+   */
+  void setAmZeroCopyEager(const bool enable, unsigned int amId = 0);
+
+  /**
+   * @brief Register a buffer pool for internally-allocated buffers.
+   *
+   * Register a buffer pool that UCXX will use for receive buffers it allocates internally,
+   * such as the frames received by `ucxx::RequestTagMulti`, instead of allocating new
+   * memory for each buffer. The pool is used for buffers of the pool's type, replacing any
+   * pool previously registered for that type. To also use the pool for active messages
+   * register `ucxx::BufferPool::getAmAllocator()` with `registerAmAllocator()`.
+   *
+   * @param[in] pool  the buffer pool to register, or `nullptr` to disable pooling of all
+   *                  buffer types.
+   */
+  void registerBufferPool(std::shared_ptr<BufferPool> pool);
+
+  /**
+   * @brief Get the buffer pool registered for a buffer type.
+   *
+   * @param[in] bufferType  the buffer type.
+   *
+   * @returns The registered buffer pool, or `nullptr` if none is registered for the type.
+   */
+  std::shared_ptr<BufferPool> getBufferPool(const BufferType bufferType) const;
+
+  /**
+   * @brief Register an allocator for internally-allocated buffers.
+   *
+   * Register an allocator that UCXX will use for receive buffers of type `bufferType` it
+   * allocates internally, such as the frames received by `ucxx::RequestTagMulti`, taking
+   * precedence over a buffer pool registered for the same type. This allows, for example,
+   * allocating received CUDA frames ordered on an application stream from a specific
+   * memory resource with `ucxx::createRMMAllocator()`, rather than on the default stream.
+   * Allocators may also be specified per request, see `ucxx::Endpoint::tagMultiRecv()`.
+   *
+   * @code{.cpp}
+   * // `worker` is `std::shared_ptr<ucxx::Worker>`, `stream` is `rmm::cuda_stream_view`
+   * worker->registerBufferAllocator(ucxx::BufferType::RMM, ucxx::createRMMAllocator(stream));
+   * @endcode
+   *
+   * @param[in] bufferType  the buffer type the allocator will be used for.
+   * @param[in] allocator   the allocator, or `nullptr` to restore the default allocation.
+   */
+  void registerBufferAllocator(const BufferType bufferType, AmAllocatorType allocator);
+
+  /**
+   * @brief Allocate a buffer for internal use.
+   *
+   * Allocate a buffer of the specified type and size with the allocator registered with
+   * `registerBufferAllocator()` for the type, if any, otherwise from the buffer pool
+   * registered with `registerBufferPool()`, if any, or with `ucxx::allocateBuffer()`
+   * otherwise.
+   *
+   * @param[in] bufferType  the type of buffer to allocate.
+   * @param[in] size        the size (in bytes) of the buffer to allocate.
+   *
+   * @returns the `std::shared_ptr` to the allocated buffer.
+   */
+  std::shared_ptr<Buffer> allocateInternalBuffer(const BufferType bufferType, const size_t size);
 
   /**
    * @brief Check for uncaught active messages.
@@ -816,9 +2188,14 @@ class Worker : public Component {
    * assert(worker->amProbe(0));
    * @endcode
    *
+   * @throws std::runtime_error if the active message ID is not registered.
+   *
+   * @param[in] endpointHandle  the endpoint handle to check for uncaught messages.
+   * @param[in] amId            the active message ID to check for uncaught messages.
+   *
    * @returns `true` if any uncaught messages were received, `false` otherwise.
    */
-  bool amProbe(const ucp_ep_h endpointHandle) const;
+  bool amProbe(const ucp_ep_h endpointHandle, unsigned int amId = 0) const;
 };
 
 }  // namespace ucxx
@@ -0,0 +1,308 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/typedefs.h>
+
+namespace ucxx {
+
+class Address;
+class CompletionExecutor;
+class Context;
+class Endpoint;
+class Listener;
+class Worker;
+
+/**
+ * @brief A pool of workers with endpoint-affine scheduling.
+ *
+ * Own a fixed number of workers created from the same context, optionally each with its
+ * own progress thread, and place endpoints and listeners on them. All operations on an
+ * endpoint are then submitted to and progressed by the worker it was placed on, so that
+ * applications scale out by growing the pool instead of managing workers and progress
+ * threads manually. Running the progress threads of multiple workers concurrently requires
+ * the context to be created with `enableMtWorkersShared`, see `ucxx::createContext()`.
+ *
+ * UCP endpoints can't migrate between workers, thus load is balanced when placing new
+ * endpoints, according to the placement policy, see `ucxx::WorkerPoolPlacement`. With
+ * `ucxx::WorkerPoolPlacement::LeastLoaded` new endpoints avoid workers busy with hot
+ * endpoints.
+ *
+ * @code{.cpp}
+ * // Workers progressed concurrently require `enableMtWorkersShared`
+ * auto context = ucxx::createContext({}, ucxx::Context::defaultFeatureFlags, true);
+ * auto pool = ucxx::createWorkerPool(context, 4);
+ * pool->startProgressThreads();
+ * auto ep = pool->createEndpointFromHostname("10.0.0.1", 12345);
+ * auto request = ep->tagSend(buffer, length, ucxx::Tag{0});
+ * @endcode
+ */
+class WorkerPool {
+ private:
+  std::shared_ptr<Context> _context{nullptr};                       ///< The workers' context
+  std::vector<std::shared_ptr<Worker>> _workers{};                  ///< The pooled workers
+  WorkerPoolPlacement _placement{WorkerPoolPlacement::RoundRobin};  ///< The placement policy
+  std::mutex _mutex{};  ///< Mutex to access the placement state
+  std::vector<std::vector<std::weak_ptr<Endpoint>>>
+    _endpoints{};  ///< Endpoints placed on each worker, used to balance placement
+  std::vector<size_t> _listeners{};  ///< Number of listeners placed on each worker
+  size_t _next{0};                   ///< The next worker for round-robin placement
+
+  /**
+   * @brief Private constructor of `ucxx::WorkerPool`.
+   *
+   * This is the internal implementation of `ucxx::WorkerPool` constructor, made private
+   * not to be called directly. Instead the user should call `ucxx::createWorkerPool()`.
+   *
+   * @throws std::invalid_argument if `context` is `nullptr` or `numWorkers` is `0`.
+   *
+   * @param[in] context                 the context to create workers from.
+   * @param[in] numWorkers              the number of workers in the pool.
+   * @param[in] placement               the policy to place endpoints and listeners.
+   * @param[in] enableDelayedSubmission whether workers delay transfer requests to their
+   *                                    progress threads.
+   * @param[in] enableFuture            whether workers notify futures of requests.
+   * @param[in] factory                 function to create each worker, or `nullptr` to
+   *                                    create `ucxx::Worker` objects.
+   */
+  WorkerPool(std::shared_ptr<Context> context,
+             size_t numWorkers,
+             WorkerPoolPlacement placement,
+             const bool enableDelayedSubmission,
+             const bool enableFuture,
+             WorkerPoolFactory factory);
+
+  /**
+   * @brief Select the worker to place a new endpoint or listener on.
+   *
+   * Must be called with `_mutex` held.
+   *
+   * @param[in] listener  whether the selection is for a listener.
+   *
+   * @returns The index of the selected worker.
+   */
+  size_t selectWorkerIndex(bool listener);
+
+  /**
+   * @brief Track an endpoint placed on a worker.
+   *
+   * @param[in] index     the index of the worker the endpoint was placed on.
+   * @param[in] endpoint  the endpoint placed.
+   *
+   * @returns The endpoint placed.
+   */
+  std::shared_ptr<Endpoint> trackEndpoint(size_t index, std::shared_ptr<Endpoint> endpoint);
+
+ public:
+  WorkerPool()                             = delete;
+  WorkerPool(const WorkerPool&)            = delete;
+  WorkerPool& operator=(WorkerPool const&) = delete;
+  WorkerPool(WorkerPool&& o)               = delete;
+  WorkerPool& operator=(WorkerPool&& o)    = delete;
+
+  /**
+   * @brief Constructor of `shared_ptr<ucxx::WorkerPool>`.
+   *
+   * The constructor for a `shared_ptr<ucxx::WorkerPool>` object, creating `numWorkers`
+   * workers from `context`. Progress threads are not started, see
+   * `startProgressThreads()`.
+   *
+   * @throws std::invalid_argument if `context` is `nullptr` or `numWorkers` is `0`.
+   *
+   * @param[in] context                 the context to create workers from.
+   * @param[in] numWorkers              the number of workers in the pool.
+   * @param[in] placement               the policy to place endpoints and listeners.
+   * @param[in] enableDelayedSubmission whether workers delay transfer requests to their
+   *                                    progress threads.
+   * @param[in] enableFuture            whether workers notify futures of requests.
+   * @param[in] factory                 function to create each worker, or `nullptr` to
+   *                                    create `ucxx::Worker` objects.
+   *
+   * @returns The `shared_ptr<ucxx::WorkerPool>` object.
+   */
+  friend std::shared_ptr<WorkerPool> createWorkerPool(std::shared_ptr<Context> context,
+                                                      size_t numWorkers,
+                                                      WorkerPoolPlacement placement,
+                                                      const bool enableDelayedSubmission,
+                                                      const bool enableFuture,
+                                                      WorkerPoolFactory factory);
+
+  /**
+   * @brief `ucxx::WorkerPool` destructor.
+   *
+   * Stops progress threads of all workers.
+   */
+  ~WorkerPool();
+
+  /**
+   * @brief Get the number of workers in the pool.
+   *
+   * @returns The number of workers.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Get a worker of the pool.
+   *
+   * @throws std::out_of_range if `index` is not a valid worker index.
+   *
+   * @param[in] index the index of the worker.
+   *
+   * @returns The worker.
+   */
+  std::shared_ptr<Worker> getWorker(size_t index) const;
+
+  /**
+   * @brief Get all workers of the pool.
+   *
+   * @returns The workers, in index order.
+   */
+  const std::vector<std::shared_ptr<Worker>>& getWorkers() const;
+
+  /**
+   * @brief Get the number of live endpoints placed on each worker.
+   *
+   * @returns The number of live endpoints placed on each worker, in index order.
+   */
+  std::vector<size_t> getEndpointCounts();
+
+  /**
+   * @brief Select a worker according to the placement policy.
+   *
+   * Select the worker a new endpoint would be placed on, for applications creating
+   * resources not covered by the pool, such as endpoints from connection requests of
+   * listeners created directly on a worker.
+   *
+   * @returns The selected worker.
+   */
+  std::shared_ptr<Worker> selectWorker();
+
+  /**
+   * @brief Start progress threads of all workers.
+   *
+   * Start a progress thread for each worker, see `ucxx::Worker::startProgressThread()`.
+   * If `pinToNetworkDevices` is `true`, each progress thread is pinned to the CPUs local
+   * to the network devices, see `ucxx::Worker::getNetworkDevicesLocalCpus()`.
+   *
+   * @throws std::invalid_argument if the pool has multiple workers but its context was not
+   *                               created with `enableMtWorkersShared`, as UCX does not
+   *                               support progressing them concurrently otherwise.
+   *
+   * @param[in] pollingMode         use polling mode if `true`, or blocking mode if `false`.
+   * @param[in] epollTimeout        timeout in ms when waiting for worker event, or -1 to
+   *                                block indefinitely, only applicable in blocking mode.
+   * @param[in] spinPeriodNs        period in nanoseconds to spin after the last activity
+   *                                before blocking, only applicable in blocking mode.
+   * @param[in] pinToNetworkDevices whether to pin progress threads to the CPUs local to
+   *                                the network devices.
+   */
+  void startProgressThreads(const bool pollingMode         = false,
+                            const int epollTimeout         = 1,
+                            const uint64_t spinPeriodNs    = 0,
+                            const bool pinToNetworkDevices = false);
+
+  /**
+   * @brief Stop progress threads of all workers.
+   */
+  void stopProgressThreads();
+
+  /**
+   * @brief Execute request completion work of all workers on a shared executor.
+   *
+   * Set `completionExecutor` as the completion executor of all workers, see
+   * `ucxx::Worker::setCompletionExecutor()`, so that completion work is balanced among
+   * the executor threads independently of the number of workers.
+   *
+   * @throws std::invalid_argument if `completionExecutor` is `nullptr`.
+   *
+   * @param[in] completionExecutor  the completion executor.
+   * @param[in] notifyFutures       whether the executor also notifies futures of requests.
+   */
+  void setCompletionExecutor(std::shared_ptr<CompletionExecutor> completionExecutor,
+                             bool notifyFutures = false);
+
+  /**
+   * @brief Progress all workers.
+   *
+   * Progress each worker once, for pools without progress threads.
+   *
+   * @returns `true` if any worker progressed communication, `false` otherwise.
+   */
+  bool progress();
+
+  /**
+   * @brief Create an endpoint to a remote listener.
+   *
+   * Create an endpoint on the worker selected by the placement policy, see
+   * `ucxx::Worker::createEndpointFromHostname()`.
+   *
+   * @param[in] ipAddress             hostname or IP address the listener is bound to.
+   * @param[in] port                  port the listener is bound to.
+   * @param[in] endpointErrorHandling whether to enable endpoint error handling.
+   *
+   * @returns The `shared_ptr<ucxx::Endpoint>` object.
+   */
+  std::shared_ptr<Endpoint> createEndpointFromHostname(std::string ipAddress,
+                                                       uint16_t port,
+                                                       bool endpointErrorHandling = true);
+
+  /**
+   * @brief Create an endpoint to a remote worker address.
+   *
+   * Create an endpoint on the worker selected by the placement policy, see
+   * `ucxx::Worker::createEndpointFromWorkerAddress()`.
+   *
+   * @param[in] address               address of the remote worker.
+   * @param[in] endpointErrorHandling whether to enable endpoint error handling.
+   *
+   * @returns The `shared_ptr<ucxx::Endpoint>` object.
+   */
+  std::shared_ptr<Endpoint> createEndpointFromWorkerAddress(std::shared_ptr<Address> address,
+                                                            bool endpointErrorHandling = true);
+
+  /**
+   * @brief Listen for remote connections on given port.
+   *
+   * Create a listener on the worker selected by the placement policy, listeners being
+   * spread across workers independently of endpoints. Endpoints created from connection
+   * requests of the listener are created on the same worker, see
+   * `ucxx::Worker::createListener()`.
+   *
+   * @param[in] port          port number where to listen at.
+   * @param[in] callback      to handle each incoming connection.
+   * @param[in] callbackArgs  pointer to argument to pass to the callback.
+   *
+   * @returns The `shared_ptr<ucxx::Listener>` object.
+   */
+  std::shared_ptr<Listener> createListener(uint16_t port,
+                                           ucp_listener_conn_callback_t callback,
+                                           void* callbackArgs);
+
+  /**
+   * @brief Listen for remote connections on given port, queuing connection requests.
+   *
+   * Create a queuing listener on the worker selected by the placement policy, see
+   * `ucxx::Worker::createListener()`.
+   *
+   * @throws std::invalid_argument if `backlog` is `0`.
+   *
+   * @param[in] port    port number where to listen at.
+   * @param[in] backlog maximum number of connection requests to queue.
+   *
+   * @returns The `shared_ptr<ucxx::Listener>` object.
+   */
+  std::shared_ptr<Listener> createListener(uint16_t port, size_t backlog);
+};
+
+}  // namespace ucxx
@@ -8,6 +8,7 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <ucxx/delayed_submission.h>
 
@@ -59,16 +60,21 @@ class WorkerProgressThread {
     nullptr};  ///< Argument to pass to start callback
   std::shared_ptr<DelayedSubmissionCollection> _delayedSubmissionCollection{
     nullptr};  ///< Collection of enqueued delayed submissions
+  std::vector<int> _cpuAffinity{};  ///< CPUs the thread is pinned to, empty if unpinned
 
   /**
    * @brief The function executed in the new thread.
    *
-   * This function ensures the `startCallback` is executed once at the start of the thread,
-   * subsequently starting a continuous loop that processes any delayed submission requests
-   * that are pending in the `delayedSubmissionCollection` followed by the execution of the
-   * `progressFunction`, the loop repeats until `stop` is set.
+   * This function ensures the thread is pinned to `cpuAffinity` and the `startCallback` is
+   * executed once at the start of the thread, subsequently starting a continuous loop that
+   * processes any delayed submission requests that are pending in the
+   * `delayedSubmissionCollection` followed by the execution of the `progressFunction`, the
+   * loop repeats until `stop` is set.
    *
    * @param[in] progressFunction            user-defined progress function implementation.
+   * @param[in] signalWorkerFunction        user-defined function to wake the worker,
+   *                                        called when delayed submissions exceeded the
+   *                                        per-iteration budget and remain pending.
    * @param[in] stop                        reference to the stop signal causing the
    *                                        progress loop to terminate.
    * @param[in] startCallback               user-defined callback function to be executed
@@ -76,13 +82,17 @@ class WorkerProgressThread {
    * @param[in] startCallbackArg            an argument to be passed to the start callback.
    * @param[in] delayedSubmissionCollection collection of delayed submissions to be
    *                                        processed during progress.
+   * @param[in] cpuAffinity                 CPUs to pin the thread to, or empty to leave
+   *                                        the thread unpinned.
    */
   static void progressUntilSync(
     std::function<bool(void)> progressFunction,
+    std::function<void(void)> signalWorkerFunction,
     const bool& stop,
     ProgressThreadStartCallback startCallback,
     ProgressThreadStartCallbackArg startCallbackArg,
-    std::shared_ptr<DelayedSubmissionCollection> delayedSubmissionCollection);
+    std::shared_ptr<DelayedSubmissionCollection> delayedSubmissionCollection,
+    std::vector<int> cpuAffinity);
 
  public:
   WorkerProgressThread() = delete;
@@ -119,13 +129,16 @@ class WorkerProgressThread {
    * @param[in] startCallbackArg            an argument to be passed to the start callback.
    * @param[in] delayedSubmissionCollection collection of delayed submissions to be
    *                                        processed during progress.
+   * @param[in] cpuAffinity                 CPUs to pin the thread to, or empty to leave
+   *                                        the thread unpinned.
    */
   WorkerProgressThread(const bool pollingMode,
                        std::function<bool(void)> progressFunction,
                        std::function<void(void)> signalWorkerFunction,
                        ProgressThreadStartCallback startCallback,
                        ProgressThreadStartCallbackArg startCallbackArg,
-                       std::shared_ptr<DelayedSubmissionCollection> delayedSubmissionCollection);
+                       std::shared_ptr<DelayedSubmissionCollection> delayedSubmissionCollection,
+                       const std::vector<int>& cpuAffinity = {});
 
   /**
    * @brief `ucxx::WorkerProgressThread` destructor.
@@ -147,6 +160,13 @@ class WorkerProgressThread {
    * @returns the progress thread ID.
    */
   std::thread::id getId() const;
+
+  /**
+   * @brief Returns the CPUs the thread is pinned to.
+   *
+   * @returns The CPUs the thread was pinned to at start, or an empty vector if unpinned.
+   */
+  const std::vector<int>& getCpuAffinity() const;
 };
 
 }  // namespace ucxx
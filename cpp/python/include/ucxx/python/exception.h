@@ -71,7 +71,10 @@ void raise_py_error();
 /**
  * @brief Get a Python exception from UCS status.
  *
- * Given a UCS status, get a matching Python exception object.
+ * Given a UCS status, get a matching Python exception object, the same that is raised
+ * when the C++ exception thrown by `ucxx::utils::ucsErrorThrow()` for the status is
+ * translated by `raise_py_error()`. Allows raising exceptions for statuses without
+ * throwing and translating C++ exceptions.
  *
  * @param[in] status UCS status from which to get exception.
  */
@@ -111,6 +111,28 @@ PyObject* future_set_exception_with_event_loop(PyObject* event_loop,
                                                PyObject* exception,
                                                const char* message) noexcept;
 
+/**
+ * @brief Set the results of multiple Python futures with associated event loop.
+ *
+ * Schedule setting the results of all Python futures in `batch` with a single call to the
+ * threadsafe method `event_loop.call_soon_threadsafe`, so that waking the event loop and
+ * its thread handoff are paid once for the entire batch instead of once per future. All
+ * futures must belong to `event_loop`. Futures that are already done by the time the
+ * callback runs in the event loop, e.g., cancelled by the user, are skipped.
+ *
+ * Each element of `batch` is a 3-tuple `(future, exception, message)`, where `exception`
+ * and `message` are `None` for a successful completion, or otherwise a Python exception
+ * derived of the `Exception` class and a human-readable error message for it.
+ *
+ * Note that this may be called from any thread and will take the Python GIL to run.
+ *
+ * @param[in] event_loop  the Python asyncio event loop to which the futures belong to.
+ * @param[in] batch       Python list of 3-tuples as described above.
+ *
+ * @returns The result of the call to `event_loop.call_soon_threadsafe()`.
+ */
+PyObject* future_set_results_with_event_loop(PyObject* event_loop, PyObject* batch) noexcept;
+
 }  // namespace python
 
 }  // namespace ucxx
@@ -29,6 +29,7 @@ class Notifier : public ::ucxx::Notifier {
   std::vector<std::pair<std::shared_ptr<::ucxx::Future>, ucs_status_t>>
     _notifierThreadFutureStatus{};               ///< Container with futures and statuses to set
   bool _notifierThreadFutureStatusReady{false};  ///< Whether a future is scheduled for notification
+  bool _futuresPoolRefillRequested{false};  ///< Whether the futures pool must be refilled
   RequestNotifierThreadState _notifierThreadFutureStatusFinished{
     RequestNotifierThreadState::NotRunning};  ///< State of the notifier thread
   std::condition_variable
@@ -129,9 +130,21 @@ class Notifier : public ::ucxx::Notifier {
    * futures. Notifying the event loop requires taking the Python GIL, thus it cannot run
    * indefinitely but must instead run periodically. Futures that completed must first be
    * scheduled with `scheduleFutureNotify()`.
+   *
+   * The GIL is acquired once per call, and futures belonging to the same event loop are
+   * completed in batch by a single `call_soon_threadsafe` callback.
    */
   void runRequestNotifier() override;
 
+  /**
+   * @brief Wake the notifier thread to refill the futures pool.
+   *
+   * Wake the notifier thread blocked in `waitRequestNotifier()`, which then returns
+   * `RequestNotifierWaitState::Timeout` unless there are also futures to notify, so that
+   * the thread refills the futures pool without notifying the Python event loop.
+   */
+  void requestFuturesPoolRefill() override;
+
   /**
    * @brief Make known to the notifier thread that it should stop.
    *
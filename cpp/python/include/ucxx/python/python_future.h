@@ -129,6 +129,16 @@ class Future : public ::ucxx::Future {
    */
   void* getHandle();
 
+  /**
+   * @brief Get the asyncio event loop the Python future belongs to.
+   *
+   * Get the asyncio event loop the Python future belongs to, or `nullptr` if the future
+   * was created without an event loop. Ownership is not transferred.
+   *
+   * @returns The asyncio event loop or `nullptr`.
+   */
+  PyObject* getAsyncioEventLoop() const;
+
   /**
    * @brief Get the underlying `PyObject*` handle and release ownership.
    *
@@ -51,20 +51,26 @@ struct PythonFutureTask {
    * Set the result value of the underlying Python future using the `pythonConvert` function
    * specified in the constructor to convert the C++ result into the `PyObject*`.
    *
-   * This function will take the GIL to convert the C++ result into the `PyObject*`.
+   * The result is delivered via `PythonFutureTaskCollector::deliver()`, which takes the GIL
+   * once to deliver results of tasks completing concurrently.
    *
    * @param[in] result the C++ value that will be converted and set as the result of the
    *                   Python future.
    */
   void setResult(const ReturnType result)
   {
-    // PyLong_FromSize_t requires the GIL
     if (_handle == nullptr) throw std::runtime_error("Invalid object or already released");
 
-    PyGILState_STATE state = PyGILState_Ensure();
-    ucxx::python::future_set_result_with_event_loop(
-      _asyncioEventLoop, _handle, _pythonConvert(result));
-    PyGILState_Release(state);
+    // Conversion, e.g., PyLong_FromSize_t, requires the GIL and thus is also deferred.
+    // Capture by value, this object may be destroyed before the result is delivered.
+    ucxx::python::PythonFutureTaskCollector::get().deliver(
+      [asyncioEventLoop = _asyncioEventLoop,
+       handle           = _handle,
+       pythonConvert    = _pythonConvert,
+       result]() {
+        ucxx::python::future_set_result_with_event_loop(
+          asyncioEventLoop, handle, pythonConvert(result));
+      });
   }
 
   /**
@@ -73,6 +79,9 @@ struct PythonFutureTask {
    * Set the exception of the underlying Python future. Currently any exceptions that the
    * task may raise must be derived from `std::exception`.
    *
+   * The exception is delivered via `PythonFutureTaskCollector::deliver()`, batched with
+   * results of other tasks.
+   *
    * @param[in] pythonException the Python exception type to raise.
    * @param[in] message the message of the exception.
    */
@@ -80,10 +89,11 @@ struct PythonFutureTask {
   {
     if (_handle == nullptr) throw std::runtime_error("Invalid object or already released");
 
-    PyGILState_STATE state = PyGILState_Ensure();
-    ucxx::python::future_set_exception_with_event_loop(
-      _asyncioEventLoop, _handle, pythonException, message.c_str());
-    PyGILState_Release(state);
+    ucxx::python::PythonFutureTaskCollector::get().deliver(
+      [asyncioEventLoop = _asyncioEventLoop, handle = _handle, pythonException, message]() {
+        ucxx::python::future_set_exception_with_event_loop(
+          asyncioEventLoop, handle, pythonException, message.c_str());
+      });
   }
 
   /**
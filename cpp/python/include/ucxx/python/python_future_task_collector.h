@@ -4,6 +4,7 @@
  */
 #pragma once
 
+#include <functional>
 #include <mutex>
 #include <vector>
 
@@ -22,11 +23,17 @@ namespace python {
  * deadlocks if it can't be done at appropriate stages. The application is thus responsible
  * to ensure `PythonFutureTaskCollector::push()` is regularly called and ultimately
  * responsible for cleaning up before terminating, otherwise a resource leakage may occur.
+ *
+ * Results of Python futures completed from C++ threads are also delivered through the
+ * collector, so that many tasks completing concurrently share a single GIL acquisition
+ * instead of each competing for the GIL with the Python thread, see `deliver()`.
  */
 class PythonFutureTaskCollector {
  public:
-  std::vector<PyObject*> _toCollect{};  ///< Tasks to be collected
-  std::mutex _mutex{};                  ///< Mutex to provide safe access to `_toCollect`.
+  std::vector<PyObject*> _toCollect{};                ///< Tasks to be collected
+  std::vector<std::function<void()>> _toDeliver{};    ///< Results pending delivery
+  bool _delivering{false};                            ///< Whether a thread is draining
+  std::mutex _mutex{};  ///< Mutex to provide safe access to `_toCollect` and `_toDeliver`.
 
   /**
    * Get reference to `PythonFutureTaskCollector` instance.
@@ -47,7 +54,10 @@ class PythonFutureTaskCollector {
    * Decrement each reference previously pushed exactly once.
    *
    * Decrement each reference (i.e., garbage collect) that was previously pushed via the
-   * `push()` method exactly once, cleaning internal references at the end.
+   * `push()` method exactly once, cleaning internal references at the end. If another
+   * thread is currently delivering results, the references are decremented by that thread
+   * instead, after the results queued before them were delivered, and this method returns
+   * immediately.
    *
    * WARNING: Calling this method will attempt to take the GIL, so make sure no other thread
    * currently owns it while this thread also competes for other resources that the Python
@@ -55,7 +65,33 @@ class PythonFutureTaskCollector {
    */
   void collect();
 
+  /**
+   * Deliver a result to Python, batched with other concurrently delivered results.
+   *
+   * Queue a function that requires the GIL, such as setting the result of a Python future,
+   * to be executed together with other queued functions and collected handles under a
+   * single GIL acquisition. If no other thread is currently delivering, the calling thread
+   * takes the GIL and executes all queued functions, including those queued by other
+   * threads while it runs, before returning. Otherwise the function is executed by the
+   * delivering thread and this method returns immediately.
+   *
+   * WARNING: Calling this method may attempt to take the GIL, the same precautions of
+   * `collect()` apply.
+   *
+   * @param[in] function the function to execute while holding the GIL.
+   */
+  void deliver(std::function<void()> function);
+
  private:
+  /**
+   * Execute queued functions and decrement queued references until none are left.
+   *
+   * Execute all functions queued via `deliver()`, then decrement all references queued via
+   * `push()`, repeating until both queues are empty. Must be called with the GIL held and
+   * by the single thread that set `_delivering`, which is reset once both queues are empty.
+   */
+  void drain();
+
   /**
    * Private constructor.
    *
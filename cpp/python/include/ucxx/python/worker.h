@@ -47,6 +47,17 @@ class Worker : public ::ucxx::Worker {
          const bool enableDelayedSubmission = false,
          const bool enableFuture            = false);
 
+  /**
+   * @brief Pop a future from the pool.
+   *
+   * Pop a future from the pool, first moving all futures handed off by refills into the
+   * pool if it is empty.
+   *
+   * @returns The `shared_ptr<ucxx::python::Future>` object, or `nullptr` if no futures
+   *          are available.
+   */
+  std::shared_ptr<::ucxx::Future> popFuture();
+
  public:
   Worker()                         = delete;
   Worker(const Worker&)            = delete;
@@ -63,7 +74,7 @@ class Worker : public ::ucxx::Worker {
    *
    * @code{.cpp}
    * // context is `std::shared_ptr<ucxx::Context>`
-   * auto worker = ucxx::createWorker(context, false, false);
+   * auto worker = ucxx::python::createWorker(context, false, false);
    * @endcode
    *
    * @param[in] context the context from which to create the worker.
@@ -84,8 +95,13 @@ class Worker : public ::ucxx::Worker {
    *
    * To avoid taking the Python GIL for every new future required by each `ucxx::Request`,
    * the `ucxx::python::Worker` maintains a pool of futures that can be acquired when a new
-   * `ucxx::Request` is created. Currently the pool has a maximum size of 100 objects, and
-   * will refill once it goes under 50, otherwise calling this functions results in a no-op.
+   * `ucxx::Request` is created. By default the pool has a maximum size of 100 objects, and
+   * will refill once it goes under 50, otherwise calling this functions results in a no-op,
+   * see `ucxx::Worker::setFuturesPoolSize()`.
+   *
+   * All missing futures are created with a single acquisition of the GIL and then handed
+   * off to `getFuture()` without locking, thus threads submitting requests never wait for
+   * a refill to complete.
    */
   void populateFuturesPool() override;
 
@@ -95,6 +111,8 @@ class Worker : public ::ucxx::Worker {
    * Get a Python future from the pool. If the pool is empty,
    * `ucxx::python::Worker::populateFuturesPool()` is called and a warning is raised, since
    * that likely means the user is missing to call the aforementioned method regularly.
+   * Once the pool crosses its low watermark the notifier thread is woken to refill it
+   * before it runs out.
    *
    * @returns The `shared_ptr<ucxx::python::Future>` object
    */
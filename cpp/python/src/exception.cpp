@@ -195,10 +195,38 @@ void raise_py_error()
 
 PyObject* get_python_exception_from_ucs_status(ucs_status_t status)
 {
+  // The same exceptions `raise_py_error()` raises for `ucxx::utils::ucsErrorThrow()`.
   switch (status) {
+    case UCS_ERR_NO_MESSAGE: return UCXXNoMessageError;
+    case UCS_ERR_NO_RESOURCE: return UCXXNoResourceError;
+    case UCS_ERR_IO_ERROR: return UCXXIOError;
+    case UCS_ERR_NO_MEMORY: return UCXXNoMemoryError;
+    case UCS_ERR_INVALID_PARAM: return UCXXInvalidParamError;
+    case UCS_ERR_UNREACHABLE: return UCXXUnreachableError;
+    case UCS_ERR_INVALID_ADDR: return UCXXInvalidAddrError;
+    case UCS_ERR_NOT_IMPLEMENTED: return UCXXNotImplementedError;
+    case UCS_ERR_MESSAGE_TRUNCATED: return UCXXMessageTruncatedError;
+    case UCS_ERR_NO_PROGRESS: return UCXXNoProgressError;
+    case UCS_ERR_BUFFER_TOO_SMALL: return UCXXBufferTooSmallError;
+    case UCS_ERR_NO_ELEM: return UCXXNoElemError;
+    case UCS_ERR_SOME_CONNECTS_FAILED: return UCXXSomeConnectsFailedError;
+    case UCS_ERR_NO_DEVICE: return UCXXNoDeviceError;
+    case UCS_ERR_BUSY: return UCXXBusyError;
     case UCS_ERR_CANCELED: return UCXXCanceledError;
+    case UCS_ERR_SHMEM_SEGMENT: return UCXXShmemSegmentError;
+    case UCS_ERR_ALREADY_EXISTS: return UCXXAlreadyExistsError;
+    case UCS_ERR_OUT_OF_RANGE: return UCXXOutOfRangeError;
+    case UCS_ERR_TIMED_OUT: return UCXXTimedOutError;
+    case UCS_ERR_EXCEEDS_LIMIT: return UCXXExceedsLimitError;
+    case UCS_ERR_UNSUPPORTED: return UCXXUnsupportedError;
+    case UCS_ERR_REJECTED: return UCXXRejectedError;
+    case UCS_ERR_NOT_CONNECTED: return UCXXNotConnectedError;
     case UCS_ERR_CONNECTION_RESET: return UCXXConnectionResetError;
-    case UCS_ERR_MESSAGE_TRUNCATED: return UCXXMessageTruncatedError;
+    case UCS_ERR_FIRST_LINK_FAILURE: return UCXXFirstLinkFailureError;
+    case UCS_ERR_LAST_LINK_FAILURE: return UCXXLastLinkFailureError;
+    case UCS_ERR_FIRST_ENDPOINT_FAILURE: return UCXXFirstEndpointFailureError;
+    case UCS_ERR_ENDPOINT_TIMEOUT: return UCXXEndpointTimeoutError;
+    case UCS_ERR_LAST_ENDPOINT_FAILURE: return UCXXLastEndpointFailureError;
     default: return UCXXError;
   }
 }
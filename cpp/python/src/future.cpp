@@ -14,6 +14,7 @@ PyObject* asyncio_str              = NULL;
 PyObject* asyncio_future_object    = NULL;
 PyObject* call_soon_threadsafe_str = NULL;
 PyObject* create_future_str        = NULL;
+PyObject* done_str                 = NULL;
 PyObject* future_str               = NULL;
 PyObject* set_exception_str        = NULL;
 PyObject* set_result_str           = NULL;
@@ -26,6 +27,8 @@ static int intern_strings(void)
   if (call_soon_threadsafe_str == NULL) { return -1; }
   create_future_str = PyUnicode_InternFromString("create_future");
   if (create_future_str == NULL) { return -1; }
+  done_str = PyUnicode_InternFromString("done");
+  if (done_str == NULL) { return -1; }
   future_str = PyUnicode_InternFromString("Future");
   if (future_str == NULL) { return -1; }
   set_exception_str = PyUnicode_InternFromString("set_exception");
@@ -321,6 +324,95 @@ finish:
   return result;
 }
 
+static PyObject* set_results_batch(PyObject* self, PyObject* batch)
+{
+  Py_ssize_t size = PyList_Size(batch);
+  if (size < 0) return NULL;
+
+  for (Py_ssize_t i = 0; i < size; ++i) {
+    PyObject* future           = NULL;
+    PyObject* exception        = NULL;
+    PyObject* message          = NULL;
+    PyObject* done             = NULL;
+    PyObject* result           = NULL;
+    PyObject* message_tuple    = NULL;
+    PyObject* formed_exception = NULL;
+
+    // Borrowed references, owned by the batch list
+    if (!PyArg_ParseTuple(PyList_GET_ITEM(batch, i), "OOO", &future, &exception, &message))
+      goto next;
+
+    // A future may have been cancelled by the user while its result was pending, setting it
+    // would raise `asyncio.InvalidStateError` and prevent the remaining futures from completing.
+    done = PyObject_CallMethodObjArgs(future, done_str, NULL);
+    if (done == NULL) goto next;
+    if (PyObject_IsTrue(done)) goto next;
+
+    if (exception == Py_None) {
+      result = PyObject_CallMethodObjArgs(future, set_result_str, Py_True, NULL);
+    } else {
+      message_tuple = PyTuple_Pack(1, message);
+      if (message_tuple == NULL) goto next;
+      formed_exception = PyObject_Call(exception, message_tuple, NULL);
+      if (formed_exception == NULL) goto next;
+      result = PyObject_CallMethodObjArgs(future, set_exception_str, formed_exception, NULL);
+    }
+
+  next:
+    if (PyErr_Occurred()) {
+      ucxx_trace_req("ucxx::python::%s, error setting result of future %ld of batch",
+                     __func__,
+                     static_cast<long>(i));
+      PyErr_Print();
+    }
+    Py_XDECREF(done);
+    Py_XDECREF(result);
+    Py_XDECREF(message_tuple);
+    Py_XDECREF(formed_exception);
+  }
+
+  Py_RETURN_NONE;
+}
+
+static PyMethodDef set_results_batch_def = {
+  "_ucxx_set_results_batch", set_results_batch, METH_O, NULL};
+
+PyObject* future_set_results_with_event_loop(PyObject* event_loop, PyObject* batch)
+{
+  static PyObject* set_results_batch_callable = NULL;
+  PyObject* result                            = NULL;
+
+  PyGILState_STATE state = PyGILState_Ensure();
+
+  if (init_ucxx_python() < 0) {
+    if (!PyErr_Occurred()) PyErr_SetString(PyExc_RuntimeError, "could not allocate internals.");
+    goto finish;
+  }
+
+  if (set_results_batch_callable == NULL) {
+    set_results_batch_callable = PyCFunction_New(&set_results_batch_def, NULL);
+    if (set_results_batch_callable == NULL) {
+      ucxx_trace_req("ucxx::python::%s, error creating batch callable", __func__);
+      PyErr_Print();
+      goto finish;
+    }
+  }
+
+  result = PyObject_CallMethodObjArgs(
+    event_loop, call_soon_threadsafe_str, set_results_batch_callable, batch, NULL);
+  if (PyErr_Occurred()) {
+    ucxx_trace_req(
+      "ucxx::python::%s, error calling `call_soon_threadsafe` from event loop object to set "
+      "futures results",
+      __func__);
+    PyErr_Print();
+  }
+
+finish:
+  PyGILState_Release(state);
+  return result;
+}
+
 }  // namespace python
 
 }  // namespace ucxx
@@ -2,13 +2,21 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
+
+#include <Python.h>
 
 #include <ucxx/log.h>
+#include <ucxx/python/exception.h>
+#include <ucxx/python/future.h>
 #include <ucxx/python/notifier.h>
 #include <ucxx/python/python_future.h>
+#include <ucxx/utils/nvtx.h>
 
 namespace ucxx {
 
@@ -42,6 +50,8 @@ void Notifier::scheduleFutureNotify(std::shared_ptr<::ucxx::Future> future, ucs_
 
 void Notifier::runRequestNotifier()
 {
+  UCXX_NVTX_RANGE("ucxx::python::Notifier::runRequestNotifier");
+
   decltype(_notifierThreadFutureStatus) notifierThreadFutureStatus;
   {
     std::unique_lock<std::mutex> lock(_notifierThreadMutex);
@@ -50,14 +60,65 @@ void Notifier::runRequestNotifier()
 
   ucxx_trace_req(
     "ucxx::python::Notifier::%s, notifying %lu", __func__, notifierThreadFutureStatus.size());
+
+  // Futures with an event loop are grouped per loop and completed in a single
+  // `call_soon_threadsafe` callback, instead of one callback (and event loop wakeup) per future.
+  std::vector<std::pair<PyObject*, std::vector<std::pair<PyObject*, ucs_status_t>>>> batches;
   for (auto& p : notifierThreadFutureStatus) {
-    // r->future_set_result;
-    p.first->set(p.second);
-    ucxx_trace_req("ucxx::python::Notifier::%s, notified future: %p, handle: %p",
+    auto future    = std::dynamic_pointer_cast<Future>(p.first);
+    auto eventLoop = future == nullptr ? nullptr : future->getAsyncioEventLoop();
+    if (eventLoop == nullptr) {
+      p.first->set(p.second);
+      ucxx_trace_req("ucxx::python::Notifier::%s, notified future: %p, handle: %p",
+                     __func__,
+                     p.first.get(),
+                     p.first->getHandle());
+      continue;
+    }
+
+    auto handle = reinterpret_cast<PyObject*>(future->getHandle());
+    auto batch  = std::find_if(
+      batches.begin(), batches.end(), [eventLoop](auto& b) { return b.first == eventLoop; });
+    if (batch == batches.end()) {
+      batches.emplace_back(eventLoop, decltype(batches)::value_type::second_type{});
+      batch = std::prev(batches.end());
+    }
+    batch->second.emplace_back(handle, p.second);
+  }
+
+  if (batches.empty()) return;
+
+  PyGILState_STATE state = PyGILState_Ensure();
+  for (auto& batch : batches) {
+    PyObject* list = PyList_New(0);
+    if (list == NULL) {
+      PyErr_Print();
+      continue;
+    }
+    for (auto& [handle, status] : batch.second) {
+      // The tuple holds a reference to the Python future, keeping it alive until the event
+      // loop runs the callback, even if the `ucxx::python::Future` is destroyed before that.
+      PyObject* entry = NULL;
+      if (status == UCS_OK)
+        entry = Py_BuildValue("(OOO)", handle, Py_None, Py_None);
+      else
+        entry = Py_BuildValue("(OOs)",
+                              handle,
+                              get_python_exception_from_ucs_status(status),
+                              ucs_status_string(status));
+      if (entry == NULL || PyList_Append(list, entry) < 0) PyErr_Print();
+      Py_XDECREF(entry);
+    }
+
+    PyObject* result = future_set_results_with_event_loop(batch.first, list);
+    Py_XDECREF(result);
+    Py_DECREF(list);
+    ucxx_trace_req("ucxx::python::Notifier::%s, notified %lu futures of event loop %p",
                    __func__,
-                   p.first.get(),
-                   p.first->getHandle());
+                   batch.second.size(),
+                   batch.first);
   }
+  PyGILState_Release(state);
 }
 
 RequestNotifierWaitState Notifier::waitRequestNotifierWithoutTimeout()
@@ -66,15 +127,18 @@ RequestNotifierWaitState Notifier::waitRequestNotifierWithoutTimeout()
 
   std::unique_lock<std::mutex> lock(_notifierThreadMutex);
   _notifierThreadConditionVariable.wait(lock, [this] {
-    return _notifierThreadFutureStatusReady ||
+    return _notifierThreadFutureStatusReady || _futuresPoolRefillRequested ||
            _notifierThreadFutureStatusFinished == RequestNotifierThreadState::Stopping;
   });
 
   auto state = _notifierThreadFutureStatusReady ? RequestNotifierWaitState::Ready
-                                                : RequestNotifierWaitState::Shutdown;
+               : _notifierThreadFutureStatusFinished == RequestNotifierThreadState::Stopping
+                 ? RequestNotifierWaitState::Shutdown
+                 : RequestNotifierWaitState::Timeout;
 
   ucxx_trace_req("ucxx::python::Notifier::%s, unlock: %d", __func__, static_cast<int>(state));
   _notifierThreadFutureStatusReady = false;
+  _futuresPoolRefillRequested      = false;
 
   return state;
 }
@@ -86,16 +150,20 @@ RequestNotifierWaitState Notifier::waitRequestNotifierWithTimeout(uint64_t perio
   std::unique_lock<std::mutex> lock(_notifierThreadMutex);
   bool condition = _notifierThreadConditionVariable.wait_for(
     lock, std::chrono::duration<uint64_t, std::nano>(period), [this] {
-      return _notifierThreadFutureStatusReady ||
+      return _notifierThreadFutureStatusReady || _futuresPoolRefillRequested ||
              _notifierThreadFutureStatusFinished == RequestNotifierThreadState::Stopping;
     });
 
-  auto state = (condition ? (_notifierThreadFutureStatusReady ? RequestNotifierWaitState::Ready
-                                                              : RequestNotifierWaitState::Shutdown)
-                          : RequestNotifierWaitState::Timeout);
+  // A refill request is reported as a timeout, letting the thread refill the futures pool
+  auto state =
+    (condition && _notifierThreadFutureStatusReady) ? RequestNotifierWaitState::Ready
+    : (condition && _notifierThreadFutureStatusFinished == RequestNotifierThreadState::Stopping)
+      ? RequestNotifierWaitState::Shutdown
+      : RequestNotifierWaitState::Timeout;
 
   ucxx_trace_req("ucxx::python::Notifier::%s, unlock: %d", __func__, static_cast<int>(state));
   if (state == RequestNotifierWaitState::Ready) _notifierThreadFutureStatusReady = false;
+  _futuresPoolRefillRequested = false;
 
   return state;
 }
@@ -113,6 +181,15 @@ RequestNotifierWaitState Notifier::waitRequestNotifier(uint64_t period)
                       : waitRequestNotifierWithoutTimeout();
 }
 
+void Notifier::requestFuturesPoolRefill()
+{
+  {
+    std::lock_guard<std::mutex> lock(_notifierThreadMutex);
+    _futuresPoolRefillRequested = true;
+  }
+  _notifierThreadConditionVariable.notify_one();
+}
+
 void Notifier::stopRequestNotifierThread()
 {
   {
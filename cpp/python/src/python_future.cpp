@@ -96,6 +96,8 @@ void* Future::getHandle()
   return _handle;
 }
 
+PyObject* Future::getAsyncioEventLoop() const { return _asyncioEventLoop; }
+
 void* Future::release()
 {
   if (_handle == nullptr) throw std::runtime_error("Invalid object or already released");
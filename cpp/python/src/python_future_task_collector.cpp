@@ -3,7 +3,10 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <functional>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include <Python.h>
 
@@ -28,21 +31,68 @@ void PythonFutureTaskCollector::push(PyObject* handle)
 
 void PythonFutureTaskCollector::collect()
 {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // The delivering thread collects all pushed handles before it stops delivering, a
+    // concurrent drain could decrement a handle before the result it belongs to is set,
+    // as delivered functions may release the GIL.
+    if (_delivering) return;
+    _delivering = true;
+  }
+
   PyGILState_STATE state = PyGILState_Ensure();
+  drain();
+  PyGILState_Release(state);
+}
 
+void PythonFutureTaskCollector::deliver(std::function<void()> function)
+{
   {
     std::lock_guard<std::mutex> lock(_mutex);
-    for (auto& handle : _toCollect)
-      Py_XDECREF(handle);
-    ucxx_trace("ucxx::python::PythonFutureTaskCollector::%s, collected %lu PythonFutureTasks",
-               __func__,
-               _toCollect.size());
-    _toCollect.clear();
+    _toDeliver.push_back(std::move(function));
+    // The delivering thread will pick up this function before it stops delivering.
+    if (_delivering) return;
+    _delivering = true;
   }
 
+  PyGILState_STATE state = PyGILState_Ensure();
+  drain();
   PyGILState_Release(state);
 }
 
+void PythonFutureTaskCollector::drain()
+{
+  std::vector<std::function<void()>> toDeliver{};
+  std::vector<PyObject*> toCollect{};
+
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_toDeliver.empty() && _toCollect.empty()) {
+        _delivering = false;
+        return;
+      }
+      // Swapping retains the capacity of both sides, avoiding reallocations.
+      std::swap(toDeliver, _toDeliver);
+      std::swap(toCollect, _toCollect);
+    }
+
+    // Results are delivered before collecting, a task's handle is pushed after its result.
+    for (auto& function : toDeliver)
+      function();
+    for (auto& handle : toCollect)
+      Py_XDECREF(handle);
+    ucxx_trace(
+      "ucxx::python::PythonFutureTaskCollector::%s, delivered %lu results, collected %lu "
+      "PythonFutureTasks",
+      __func__,
+      toDeliver.size(),
+      toCollect.size());
+    toDeliver.clear();
+    toCollect.clear();
+  }
+}
+
 PythonFutureTaskCollector::PythonFutureTaskCollector() {}
 
 PythonFutureTaskCollector::~PythonFutureTaskCollector()
@@ -53,6 +103,9 @@ PythonFutureTaskCollector::~PythonFutureTaskCollector()
     if (_toCollect.size() > 0)
       ucxx_warn("Destroying PythonFutureTaskCollector with %lu uncollected tasks",
                 _toCollect.size());
+    if (_toDeliver.size() > 0)
+      ucxx_warn("Destroying PythonFutureTaskCollector with %lu undelivered results",
+                _toDeliver.size());
   }
 }
 
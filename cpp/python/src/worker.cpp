@@ -3,10 +3,10 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include <functional>
-#include <ios>
 #include <memory>
 #include <mutex>
-#include <sstream>
+#include <utility>
+#include <vector>
 
 #include <Python.h>
 
@@ -38,13 +38,8 @@ std::shared_ptr<::ucxx::Worker> createWorker(std::shared_ptr<Context> context,
 
   // We can only get a `shared_ptr<Worker>` for the Active Messages callback after it's
   // been created, thus this cannot be in the constructor.
-  if (worker->_amData != nullptr) {
-    worker->_amData->_worker = worker;
-
-    std::stringstream ownerStream;
-    ownerStream << "worker " << worker->getHandle();
-    worker->_amData->_ownerString = ownerStream.str();
-  }
+  for (auto& [amId, amData] : worker->_amData)
+    amData->_worker = worker;
 
   return worker;
 }
@@ -56,13 +51,22 @@ void Worker::populateFuturesPool()
                    __func__,
                    this,
                    shared_from_this().get());
-    // If the pool goes under half expected size, fill it up again.
-    if (_futuresPool.size() < 50) {
-      std::lock_guard<std::mutex> lock(_futuresPoolMutex);
+    // If the pool goes under the low watermark, fill it up again.
+    const size_t available = _futuresPoolAvailable.load();
+    const size_t size      = _futuresPoolSize.load();
+    if (available < _futuresPoolLowWatermark.load() && available < size) {
+      // Create all futures with a single GIL acquisition and no locks held, they are then
+      // handed off to `getFuture()` lock-free, so submitters never wait on the GIL.
+      std::vector<std::shared_ptr<::ucxx::Future>> futures;
+      futures.reserve(size - available);
       PyGILState_STATE state = PyGILState_Ensure();
-      while (_futuresPool.size() < 100)
-        _futuresPool.emplace(createFuture(_notifier));
+      while (futures.size() < size - available)
+        futures.push_back(createFuture(_notifier));
       PyGILState_Release(state);
+
+      _futuresPoolAvailable += futures.size();
+      _futuresPoolRefills.push(std::move(futures));
+      _futuresPoolRefillCount.fetch_add(1, std::memory_order_relaxed);
     }
   } else {
     throw std::runtime_error(
@@ -71,25 +75,42 @@ void Worker::populateFuturesPool()
   }
 }
 
+std::shared_ptr<::ucxx::Future> Worker::popFuture()
+{
+  std::lock_guard<std::mutex> lock(_futuresPoolMutex);
+  if (_futuresPool.empty()) {
+    _futuresPoolRefills.consume([this](std::vector<std::shared_ptr<::ucxx::Future>>& futures) {
+      for (auto& future : futures)
+        _futuresPool.push(std::move(future));
+    });
+    if (_futuresPool.empty()) return nullptr;
+  }
+
+  auto ret = std::move(_futuresPool.front());
+  _futuresPool.pop();
+  return ret;
+}
+
 std::shared_ptr<::ucxx::Future> Worker::getFuture()
 {
   if (_enableFuture) {
-    if (_futuresPool.size() == 0) {
+    auto ret = popFuture();
+    while (ret == nullptr) {
       ucxx_warn(
         "No Futures available during getFuture(), make sure the Notifier is running "
-        "running and calling populateFuturesPool() periodically. Filling futures pool "
-        "now, but this may be inefficient.");
+        "running and calling populateFuturesPool() periodically, or increase the pool "
+        "size with setFuturesPoolSize(). Filling futures pool now, but this may be "
+        "inefficient.");
       populateFuturesPool();
+      ret = popFuture();
     }
 
-    std::shared_ptr<::ucxx::Future> ret{nullptr};
-    {
-      std::lock_guard<std::mutex> lock(_futuresPoolMutex);
-      ret = _futuresPool.front();
-      _futuresPool.pop();
-    }
+    // Wake the notifier to refill ahead of time once the pool crosses the low watermark.
+    if (_futuresPoolAvailable.fetch_sub(1) == _futuresPoolLowWatermark.load())
+      _notifier->requestFuturesPoolRefill();
+
     ucxx_trace_req("getFuture: %p %p", ret.get(), ret->getHandle());
-    return std::dynamic_pointer_cast<::ucxx::Future>(ret);
+    return ret;
   } else {
     throw std::runtime_error(
       "Worker future support disabled, please set enableFuture=true when creating the "
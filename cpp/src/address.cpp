@@ -4,8 +4,10 @@
  */
 #include <memory>
 #include <string>
+#include <utility>
 
 #include <ucxx/address.h>
+#include <ucxx/worker.h>
 #include <ucxx/utils/ucx.h>
 
 namespace ucxx {
@@ -16,16 +18,21 @@ Address::Address(std::shared_ptr<Worker> worker, ucp_address_t* address, size_t
   if (worker != nullptr) setParent(worker);
 }
 
+Address::Address(std::string addressString)
+  : _length{addressString.length()}, _buffer{std::move(addressString)}
+{
+  _handle = reinterpret_cast<ucp_address_t*>(_buffer.data());
+}
+
 Address::~Address()
 {
   if (_handle == nullptr) return;
 
+  // Addresses created from strings are owned by `_buffer`
   auto worker = std::dynamic_pointer_cast<Worker>(getParent());
-  if (worker == nullptr) {
-    std::free(_handle);
-  } else {
-    ucp_worker_release_address(worker->getHandle(), _handle);
-  }
+  if (worker != nullptr)
+    worker->scheduleSerialized(
+      [worker, handle = _handle]() { ucp_worker_release_address(worker->getHandle(), handle); });
 }
 
 std::shared_ptr<Address> createAddressFromWorker(std::shared_ptr<Worker> worker)
@@ -34,17 +41,15 @@ std::shared_ptr<Address> createAddressFromWorker(std::shared_ptr<Worker> worker)
   ucp_address_t* address{nullptr};
   size_t length = 0;
 
-  utils::ucsErrorThrow(ucp_worker_get_address(ucp_worker, &address, &length));
+  worker->invokeSerialized([ucp_worker, &address, &length]() {
+    utils::ucsErrorThrow(ucp_worker_get_address(ucp_worker, &address, &length));
+  });
   return std::shared_ptr<Address>(new Address(worker, address, length));
 }
 
 std::shared_ptr<Address> createAddressFromString(std::string addressString)
 {
-  char* address = new char[addressString.length()];
-  size_t length = addressString.length();
-  memcpy(reinterpret_cast<char*>(address), addressString.c_str(), length);
-  return std::shared_ptr<Address>(
-    new Address(nullptr, reinterpret_cast<ucp_address_t*>(address), length));
+  return std::shared_ptr<Address>(new Address(std::move(addressString)));
 }
 
 ucp_address_t* Address::getHandle() const { return _handle; }
@@ -2,18 +2,150 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <new>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
+
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #include <ucxx/buffer.h>
+#include <ucxx/worker.h>
 
 #if UCXX_ENABLE_RMM
+#include <cuda_runtime_api.h>
+
+#include <rmm/cuda_stream_view.hpp>
 #include <rmm/device_buffer.hpp>
 #endif
 
 namespace ucxx {
 
+namespace {
+
+size_t getHugePageSize(const HugePages hugePages)
+{
+  switch (hugePages) {
+    case HugePages::Transparent:
+    case HugePages::Size2MB: return 2 << 20;
+    case HugePages::Size1GB: return 1 << 30;
+    default: return 0;
+  }
+}
+
+size_t roundUp(const size_t size, const size_t alignment)
+{
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Map anonymous memory aligned to `alignment`.
+ *
+ * Over-map by `alignment` and unmap the unaligned head and tail, as `mmap` only aligns to
+ * the regular page size.
+ */
+void* mapAligned(const size_t size, const size_t alignment)
+{
+  const size_t pageSize = sysconf(_SC_PAGESIZE);
+  if (alignment <= pageSize) {
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  }
+
+  void* ptr =
+    mmap(nullptr, size + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED) return nullptr;
+
+  auto start   = reinterpret_cast<uintptr_t>(ptr);
+  auto aligned = roundUp(start, alignment);
+  if (aligned > start) munmap(ptr, aligned - start);
+  if (start + alignment > aligned)
+    munmap(reinterpret_cast<void*>(aligned + size), start + alignment - aligned);
+  return reinterpret_cast<void*>(aligned);
+}
+
+/**
+ * @brief Map host memory as specified by `options`.
+ *
+ * Map the memory of a host buffer and bind it to the NUMA node before it is touched,
+ * so that pages are allocated on that node.
+ *
+ * @returns The mapping of `mappedSize` bytes, or `nullptr` if regular `malloc`ed memory
+ *          should be used instead.
+ */
+void* mapHostBuffer(const size_t size, const HostAllocationOptions& options, size_t& mappedSize)
+{
+  size_t hugePageSize = getHugePageSize(options.hugePages);
+  if (size < hugePageSize / 2) hugePageSize = 0;
+  if (hugePageSize == 0 && options.numaNode < 0) return nullptr;
+
+  // Stride at which pages are faulted in, huge pages are only guaranteed with `MAP_HUGETLB`
+  size_t faultSize = sysconf(_SC_PAGESIZE);
+
+  void* ptr = nullptr;
+  if (hugePageSize > 0 && options.hugePages != HugePages::Transparent) {
+    const int pageShift = options.hugePages == HugePages::Size1GB ? 30 : 21;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (pageShift << MAP_HUGE_SHIFT);
+    mappedSize      = roundUp(std::max<size_t>(size, 1), hugePageSize);
+    ptr             = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (ptr == MAP_FAILED) {
+      ucxx_debug("ucxx::HostBuffer: no %s huge pages available (%s), using transparent ones",
+                 options.hugePages == HugePages::Size1GB ? "1GiB" : "2MiB",
+                 strerror(errno));
+      ptr = nullptr;
+    } else {
+      faultSize = hugePageSize;
+    }
+  }
+  if (ptr == nullptr) {
+    // Transparent huge pages are always 2MiB
+    const size_t alignment = hugePageSize > 0 ? getHugePageSize(HugePages::Transparent) : 0;
+    mappedSize             = roundUp(std::max<size_t>(size, 1), std::max(alignment, faultSize));
+    ptr                    = mapAligned(mappedSize, alignment);
+    if (ptr == nullptr) throw std::bad_alloc();
+    if (hugePageSize > 0) madvise(ptr, mappedSize, MADV_HUGEPAGE);
+  }
+
+  if (options.numaNode >= 0) {
+    constexpr size_t bitsPerMask = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> nodeMask(options.numaNode / bitsPerMask + 1);
+    nodeMask[options.numaNode / bitsPerMask] = 1ul << (options.numaNode % bitsPerMask);
+    if (syscall(SYS_mbind,
+                ptr,
+                mappedSize,
+                MPOL_BIND,
+                nodeMask.data(),
+                nodeMask.size() * bitsPerMask + 1,
+                0) != 0) {
+      const int error = errno;
+      munmap(ptr, mappedSize);
+      throw std::runtime_error("Failed to bind host buffer to NUMA node " +
+                               std::to_string(options.numaNode) + ": " + strerror(error));
+    }
+  }
+
+  if (options.prefault) {
+    // Anonymous memory is zero-initialized, writing zeros only faults the pages in.
+    auto bytes = static_cast<volatile char*>(ptr);
+    for (size_t offset = 0; offset < mappedSize; offset += faultSize)
+      bytes[offset] = 0;
+  }
+
+  return ptr;
+}
+
+}  // namespace
+
 Buffer::Buffer(const BufferType bufferType, const size_t size)
   : _bufferType{bufferType}, _size{size}
 {
@@ -30,15 +162,35 @@ HostBuffer::HostBuffer(const size_t size) : Buffer(BufferType::Host, size), _buf
   ucxx_trace_data("ucxx::HostBuffer created: %p, buffer: %p, size: %lu", this, _buffer, size);
 }
 
+HostBuffer::HostBuffer(const size_t size, const HostAllocationOptions& options)
+  : Buffer(BufferType::Host, size), _buffer{mapHostBuffer(size, options, _mappedSize)}
+{
+  if (_buffer == nullptr) {
+    _mappedSize = 0;
+    if ((_buffer = malloc(size)) == nullptr && size > 0) throw std::bad_alloc();
+  }
+  ucxx_trace_data("ucxx::HostBuffer created: %p, buffer: %p, size: %lu, mapped size: %lu",
+                  this,
+                  _buffer,
+                  size,
+                  _mappedSize);
+}
+
 HostBuffer::~HostBuffer()
 {
-  if (_buffer) free(_buffer);
+  if (!_buffer) return;
+
+  if (_mappedSize > 0)
+    munmap(_buffer, _mappedSize);
+  else
+    free(_buffer);
 }
 
 void* HostBuffer::release()
 {
   ucxx_trace_data("ucxx::HostBuffer::%s, HostBuffer: %p, buffer: %p", __func__, this, _buffer);
   if (!_buffer) throw std::runtime_error("Invalid object or already released");
+  if (_mappedSize > 0) throw std::runtime_error("Mapped host buffers cannot be released");
 
   _bufferType = ucxx::BufferType::Invalid;
   _size       = 0;
@@ -46,6 +198,8 @@ void* HostBuffer::release()
   return std::exchange(_buffer, nullptr);
 }
 
+bool HostBuffer::isMapped() const noexcept { return _mappedSize > 0; }
+
 void* HostBuffer::data()
 {
   ucxx_trace_data("ucxx::HostBuffer::%s, HostBuffer: %p, buffer: %p", __func__, this, _buffer);
@@ -54,12 +208,102 @@ void* HostBuffer::data()
   return _buffer;
 }
 
+AmDataBuffer::AmDataBuffer(std::shared_ptr<Worker> worker, void* data, const size_t size)
+  : Buffer(BufferType::AmData, size), _worker{worker}, _buffer{data}
+{
+  ucxx_trace_data("ucxx::AmDataBuffer created: %p, buffer: %p, size: %lu", this, _buffer, size);
+}
+
+AmDataBuffer::~AmDataBuffer()
+{
+  // Still within the active message callback, which gives the data back by `UCS_OK`.
+  if (!_buffer || !_decided->exchange(true)) return;
+
+  _worker->scheduleSerialized(
+    [worker = _worker, buffer = _buffer]() { ucp_am_data_release(worker->getHandle(), buffer); });
+}
+
+bool AmDataBuffer::retain(std::shared_ptr<AmDataBuffer>&& buffer)
+{
+  auto decided = buffer->_decided;
+  buffer.reset();
+  return !decided->exchange(true);
+}
+
+void* AmDataBuffer::release()
+{
+  ucxx_trace_data("ucxx::AmDataBuffer::%s, AmDataBuffer: %p, buffer: %p", __func__, this, _buffer);
+  if (!_buffer) throw std::runtime_error("Invalid object or already released");
+
+  _bufferType = ucxx::BufferType::Invalid;
+  _size       = 0;
+
+  return std::exchange(_buffer, nullptr);
+}
+
+void* AmDataBuffer::data()
+{
+  ucxx_trace_data("ucxx::AmDataBuffer::%s, AmDataBuffer: %p, buffer: %p", __func__, this, _buffer);
+  if (!_buffer) throw std::runtime_error("Invalid object or already released");
+
+  return _buffer;
+}
+
 #if UCXX_ENABLE_RMM
-RMMBuffer::RMMBuffer(const size_t size)
-  : Buffer(BufferType::RMM, size),
-    _buffer{std::make_unique<rmm::device_buffer>(size, rmm::cuda_stream_default)}
+PinnedHostBuffer::PinnedHostBuffer(const size_t size) : Buffer(BufferType::Pinned, size)
+{
+  if (cudaHostAlloc(&_buffer, size, cudaHostAllocDefault) != cudaSuccess) {
+    // Clear the sticky error state so that subsequent CUDA calls are not affected
+    cudaGetLastError();
+    throw std::bad_alloc();
+  }
+  ucxx_trace_data(
+    "ucxx::PinnedHostBuffer created: %p, buffer: %p, size: %lu", this, _buffer, size);
+}
+
+PinnedHostBuffer::~PinnedHostBuffer()
 {
-  ucxx_trace_data("ucxx::RMMBuffer created: %p, buffer: %p, size: %lu", this, _buffer.get(), size);
+  if (_buffer) cudaFreeHost(_buffer);
+}
+
+void* PinnedHostBuffer::release()
+{
+  ucxx_trace_data(
+    "ucxx::PinnedHostBuffer::%s, PinnedHostBuffer: %p, buffer: %p", __func__, this, _buffer);
+  if (!_buffer) throw std::runtime_error("Invalid object or already released");
+
+  _bufferType = ucxx::BufferType::Invalid;
+  _size       = 0;
+
+  return std::exchange(_buffer, nullptr);
+}
+
+void* PinnedHostBuffer::data()
+{
+  ucxx_trace_data(
+    "ucxx::PinnedHostBuffer::%s, PinnedHostBuffer: %p, buffer: %p", __func__, this, _buffer);
+  if (!_buffer) throw std::runtime_error("Invalid object or already released");
+
+  return _buffer;
+}
+
+RMMBuffer::RMMBuffer(const size_t size,
+                     rmm::cuda_stream_view stream,
+                     rmm::mr::device_memory_resource* mr)
+  : Buffer(BufferType::RMM, size), _buffer{std::make_unique<rmm::device_buffer>(size, stream, mr)}
+{
+  ucxx_trace_data("ucxx::RMMBuffer created: %p, buffer: %p, size: %lu, stream: %p",
+                  this,
+                  _buffer.get(),
+                  size,
+                  stream.value());
+}
+
+rmm::cuda_stream_view RMMBuffer::getStream() const
+{
+  if (!_buffer) throw std::runtime_error("Invalid object or already released");
+
+  return _buffer->stream();
 }
 
 std::unique_ptr<rmm::device_buffer> RMMBuffer::release()
@@ -87,12 +331,48 @@ std::shared_ptr<Buffer> allocateBuffer(const BufferType bufferType, const size_t
 #if UCXX_ENABLE_RMM
   if (bufferType == BufferType::RMM)
     return std::make_shared<RMMBuffer>(size);
+  else if (bufferType == BufferType::Pinned)
+    return std::make_shared<PinnedHostBuffer>(size);
   else
 #else
-  if (bufferType == BufferType::RMM)
+  if (bufferType == BufferType::RMM || bufferType == BufferType::Pinned)
     throw std::runtime_error("RMM support not enabled, please compile with -DUCXX_ENABLE_RMM=1");
 #endif
     return std::make_shared<HostBuffer>(size);
 }
 
+std::shared_ptr<Buffer> allocateBuffer(const BufferType bufferType,
+                                       const size_t size,
+                                       const HostAllocationOptions& options)
+{
+  if (bufferType == BufferType::Host) return std::make_shared<HostBuffer>(size, options);
+  return allocateBuffer(bufferType, size);
+}
+
+AmAllocatorType createHostAllocator(const HostAllocationOptions& options)
+{
+  return [options](size_t size) -> std::shared_ptr<Buffer> {
+    return std::make_shared<HostBuffer>(size, options);
+  };
+}
+
+#if UCXX_ENABLE_RMM
+std::shared_ptr<Buffer> allocateBuffer(const BufferType bufferType,
+                                       const size_t size,
+                                       rmm::cuda_stream_view stream,
+                                       rmm::mr::device_memory_resource* mr)
+{
+  if (bufferType == BufferType::RMM) return std::make_shared<RMMBuffer>(size, stream, mr);
+  return allocateBuffer(bufferType, size);
+}
+
+AmAllocatorType createRMMAllocator(rmm::cuda_stream_view stream,
+                                   rmm::mr::device_memory_resource* mr)
+{
+  return [stream, mr](size_t size) -> std::shared_ptr<Buffer> {
+    return std::make_shared<RMMBuffer>(size, stream, mr);
+  };
+}
+#endif
+
 }  // namespace ucxx
@@ -0,0 +1,154 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <ucxx/buffer.h>
+#include <ucxx/buffer_pool.h>
+#include <ucxx/log.h>
+
+#if UCXX_ENABLE_RMM
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+#endif
+
+namespace ucxx {
+
+BufferPool::BufferPool(const BufferType bufferType,
+                       const size_t maxCachedBytes,
+                       const HostAllocationOptions& hostOptions)
+  : _bufferType(bufferType), _maxCachedBytes(maxCachedBytes), _hostOptions(hostOptions)
+{
+#if UCXX_ENABLE_RMM
+  if (bufferType != BufferType::Host && bufferType != BufferType::RMM &&
+      bufferType != BufferType::Pinned)
+    throw std::runtime_error("Buffer pools only support host, pinned and RMM buffers");
+#else
+  if (bufferType == BufferType::RMM || bufferType == BufferType::Pinned)
+    throw std::runtime_error("RMM support not enabled, please compile with -DUCXX_ENABLE_RMM=1");
+  if (bufferType != BufferType::Host)
+    throw std::runtime_error("Buffer pools only support host, pinned and RMM buffers");
+#endif
+}
+
+size_t BufferPool::getSizeClass(const size_t size)
+{
+  if (size > MaxBufferSize) return SizeClasses;
+
+  size_t sizeClass = 0;
+  while ((MinBufferSize << sizeClass) < size)
+    ++sizeClass;
+  return sizeClass;
+}
+
+std::unique_ptr<Buffer> BufferPool::createBuffer(const size_t size)
+{
+#if UCXX_ENABLE_RMM
+  if (_bufferType == BufferType::RMM) return std::make_unique<RMMBuffer>(size);
+  if (_bufferType == BufferType::Pinned) return std::make_unique<PinnedHostBuffer>(size);
+#endif
+  return std::make_unique<HostBuffer>(size, _hostOptions);
+}
+
+void BufferPool::setBufferSize(Buffer& buffer, const size_t size)
+{
+  buffer._size = size;
+#if UCXX_ENABLE_RMM
+  // Shrinking or growing within the capacity does not reallocate.
+  if (_bufferType == BufferType::RMM)
+    static_cast<RMMBuffer&>(buffer)._buffer->resize(size, rmm::cuda_stream_default);
+#endif
+}
+
+std::shared_ptr<Buffer> BufferPool::allocate(const size_t size)
+{
+  const size_t sizeClass = getSizeClass(size);
+
+  if (sizeClass == SizeClasses) {
+    // Too large to be cached
+    ++_misses;
+    return allocateBuffer(_bufferType, size, _hostOptions);
+  }
+
+  const size_t classSize = MinBufferSize << sizeClass;
+  std::unique_ptr<Buffer> buffer{nullptr};
+  {
+    auto& freeList = _freeLists[sizeClass];
+    std::lock_guard<std::mutex> lock(freeList.mutex);
+    if (!freeList.buffers.empty()) {
+      buffer = std::move(freeList.buffers.back());
+      freeList.buffers.pop_back();
+    }
+  }
+
+  if (buffer) {
+    ++_hits;
+    _cachedBytes -= classSize;
+  } else {
+    ++_misses;
+    buffer = createBuffer(classSize);
+  }
+  setBufferSize(*buffer, size);
+
+  ucxx_trace_data("ucxx::BufferPool::%s, BufferPool: %p, buffer: %p, size: %lu, class size: %lu",
+                  __func__,
+                  this,
+                  buffer.get(),
+                  size,
+                  classSize);
+
+  auto pool = shared_from_this();
+  return std::shared_ptr<Buffer>(buffer.release(), [pool, sizeClass](Buffer* ptr) {
+    pool->deallocate(std::unique_ptr<Buffer>(ptr), sizeClass);
+  });
+}
+
+void BufferPool::deallocate(std::unique_ptr<Buffer> buffer, const size_t sizeClass)
+{
+  // Buffers whose memory was released to the user cannot be reused.
+  if (buffer->getType() == BufferType::Invalid) return;
+
+  const size_t classSize = MinBufferSize << sizeClass;
+  if (_cachedBytes.fetch_add(classSize) + classSize > _maxCachedBytes) {
+    _cachedBytes -= classSize;
+    return;
+  }
+
+  auto& freeList = _freeLists[sizeClass];
+  std::lock_guard<std::mutex> lock(freeList.mutex);
+  freeList.buffers.push_back(std::move(buffer));
+}
+
+AmAllocatorType BufferPool::getAmAllocator()
+{
+  auto pool = shared_from_this();
+  return [pool](size_t length) { return pool->allocate(length); };
+}
+
+BufferType BufferPool::getType() const noexcept { return _bufferType; }
+
+size_t BufferPool::getHits() const noexcept { return _hits.load(); }
+
+size_t BufferPool::getMisses() const noexcept { return _misses.load(); }
+
+size_t BufferPool::getCachedBytes() const noexcept { return _cachedBytes.load(); }
+
+void BufferPool::clear()
+{
+  for (size_t sizeClass = 0; sizeClass < SizeClasses; ++sizeClass) {
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    {
+      auto& freeList = _freeLists[sizeClass];
+      std::lock_guard<std::mutex> lock(freeList.mutex);
+      std::swap(buffers, freeList.buffers);
+    }
+    _cachedBytes -= buffers.size() * (MinBufferSize << sizeClass);
+  }
+}
+
+}  // namespace ucxx
@@ -0,0 +1,373 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <ucxx/collectives.h>
+#include <ucxx/endpoint.h>
+#include <ucxx/log.h>
+#include <ucxx/request.h>
+#include <ucxx/utils/tag.h>
+#include <ucxx/worker.h>
+
+namespace ucxx {
+
+namespace {
+
+// Tags pack the sequence number of the operation, the rank of the sender and the index of
+// the message before being derived from the tag base.
+constexpr uint64_t CollectiveIndexBits    = 24;
+constexpr uint64_t CollectiveSourceBits   = 16;
+constexpr uint64_t CollectiveSequenceBits = 64 - CollectiveSourceBits - CollectiveIndexBits;
+constexpr uint64_t CollectiveMaxIndices   = uint64_t{1} << CollectiveIndexBits;
+constexpr uint64_t CollectiveMaxRanks     = uint64_t{1} << CollectiveSourceBits;
+
+size_t getNumChunks(size_t length, size_t chunkSize)
+{
+  return std::max<size_t>(1, (length + chunkSize - 1) / chunkSize);
+}
+
+char* offset(void* buffer, size_t bytes) { return reinterpret_cast<char*>(buffer) + bytes; }
+
+const char* offset(const void* buffer, size_t bytes)
+{
+  return reinterpret_cast<const char*>(buffer) + bytes;
+}
+
+}  // namespace
+
+CollectiveGroup::CollectiveGroup(std::shared_ptr<Worker> worker,
+                                 std::vector<std::shared_ptr<Endpoint>> endpoints,
+                                 size_t rank,
+                                 Tag tagBase,
+                                 CollectiveConfig config)
+  : _worker(worker), _endpoints(endpoints), _rank(rank), _tagBase(tagBase), _config(config)
+{
+  if (_worker == nullptr) throw std::invalid_argument("A worker is required");
+  if (_rank >= _endpoints.size())
+    throw std::invalid_argument("The rank must be smaller than the number of endpoints");
+  if (_endpoints.size() > CollectiveMaxRanks)
+    throw std::invalid_argument("The number of ranks exceeds the tags of the group");
+  if (_config.chunkSize == 0) throw std::invalid_argument("The chunk size must be positive");
+  if (_config.pairwiseWindow == 0)
+    throw std::invalid_argument("The pairwise window must be positive");
+  for (size_t peer = 0; peer < _endpoints.size(); ++peer)
+    if (peer != _rank && _endpoints[peer] == nullptr)
+      throw std::invalid_argument("An endpoint is required for each remote rank");
+
+  if (_endpoints[_rank] == nullptr)
+    _endpoints[_rank] = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+}
+
+std::shared_ptr<CollectiveGroup> createCollectiveGroup(
+  std::shared_ptr<Worker> worker,
+  std::vector<std::shared_ptr<Endpoint>> endpoints,
+  size_t rank,
+  Tag tagBase,
+  CollectiveConfig config)
+{
+  auto group = std::shared_ptr<CollectiveGroup>(
+    new CollectiveGroup(worker, endpoints, rank, tagBase, config));
+
+  ucxx_trace("ucxx::CollectiveGroup created: %p, rank: %lu, size: %lu, tagBase: 0x%lx",
+             group.get(),
+             rank,
+             endpoints.size(),
+             tagBase);
+
+  return group;
+}
+
+size_t CollectiveGroup::getRank() const { return _rank; }
+
+size_t CollectiveGroup::getSize() const { return _endpoints.size(); }
+
+Tag CollectiveGroup::getTag(size_t source, uint64_t index) const
+{
+  const uint64_t key = (_sequence << (CollectiveSourceBits + CollectiveIndexBits)) |
+                       (static_cast<uint64_t>(source) << CollectiveIndexBits) | index;
+  return utils::deriveTag(_tagBase, key);
+}
+
+size_t CollectiveGroup::getChunkSize(size_t length, size_t blocks) const
+{
+  const size_t maxChunksPerBlock = CollectiveMaxIndices / std::max<size_t>(1, blocks);
+  return std::max(_config.chunkSize, (length + maxChunksPerBlock - 1) / maxChunksPerBlock);
+}
+
+void CollectiveGroup::begin()
+{
+  _sequence = (_sequence + 1) & ((uint64_t{1} << CollectiveSequenceBits) - 1);
+}
+
+void CollectiveGroup::sendBlock(size_t peer,
+                                const void* buffer,
+                                size_t length,
+                                size_t chunkSize,
+                                uint64_t index,
+                                std::vector<std::shared_ptr<Request>>& requests)
+{
+  const size_t numChunks = getNumChunks(length, chunkSize);
+  for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+    const size_t chunkOffset = chunk * chunkSize;
+    requests.push_back(_endpoints[peer]->tagSend(const_cast<char*>(offset(buffer, chunkOffset)),
+                                                 std::min(chunkSize, length - chunkOffset),
+                                                 getTag(_rank, index + chunk)));
+  }
+}
+
+void CollectiveGroup::recvBlock(size_t peer,
+                                void* buffer,
+                                size_t length,
+                                size_t chunkSize,
+                                uint64_t index,
+                                std::vector<std::shared_ptr<Request>>& requests)
+{
+  const size_t numChunks = getNumChunks(length, chunkSize);
+  for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+    const size_t chunkOffset = chunk * chunkSize;
+    requests.push_back(_endpoints[peer]->tagRecv(offset(buffer, chunkOffset),
+                                                 std::min(chunkSize, length - chunkOffset),
+                                                 getTag(peer, index + chunk),
+                                                 TagMaskFull));
+  }
+}
+
+void CollectiveGroup::wait(const std::shared_ptr<Request>& request)
+{
+  while (!request->isCompleted()) {
+    if (_worker->isProgressThreadRunning())
+      std::this_thread::yield();
+    else
+      _worker->progress();
+  }
+  request->checkError();
+}
+
+void CollectiveGroup::waitAll(const std::vector<std::shared_ptr<Request>>& requests)
+{
+  try {
+    for (const auto& request : requests)
+      wait(request);
+  } catch (...) {
+    cancelAll(requests);
+    throw;
+  }
+}
+
+void CollectiveGroup::cancelAll(const std::vector<std::shared_ptr<Request>>& requests)
+{
+  for (const auto& request : requests)
+    if (!request->isCompleted()) request->cancel();
+  for (const auto& request : requests) {
+    try {
+      wait(request);
+    } catch (const std::exception&) {
+    }
+  }
+}
+
+CollectiveAlgorithm CollectiveGroup::getBroadcastAlgorithm(size_t length) const
+{
+  if (length <= _config.smallMessageSize || getSize() <= 2)
+    return CollectiveAlgorithm::BinomialTree;
+  return CollectiveAlgorithm::Chain;
+}
+
+CollectiveAlgorithm CollectiveGroup::getAllgatherAlgorithm(size_t length) const
+{
+  if (length * getSize() <= _config.smallMessageSize || getSize() <= 2)
+    return CollectiveAlgorithm::Direct;
+  return CollectiveAlgorithm::Ring;
+}
+
+CollectiveAlgorithm CollectiveGroup::getAllToAllAlgorithm(size_t length) const
+{
+  if (length * getSize() <= _config.smallMessageSize || getSize() <= _config.pairwiseWindow + 1)
+    return CollectiveAlgorithm::Direct;
+  return CollectiveAlgorithm::PairwiseExchange;
+}
+
+void CollectiveGroup::forward(
+  void* buffer, size_t length, size_t parent, bool isRoot, const std::vector<size_t>& children)
+{
+  const size_t chunkSize = getChunkSize(length);
+  const size_t numChunks = getNumChunks(length, chunkSize);
+
+  std::vector<std::shared_ptr<Request>> recvRequests;
+  if (!isRoot) recvBlock(parent, buffer, length, chunkSize, 0, recvRequests);
+
+  // Forward each chunk as soon as it is received, while the following ones are in flight.
+  std::vector<std::shared_ptr<Request>> sendRequests;
+  try {
+    for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+      if (!isRoot) wait(recvRequests[chunk]);
+      const size_t chunkOffset = chunk * chunkSize;
+      const size_t chunkLength = std::min(chunkSize, length - chunkOffset);
+      for (const auto child : children)
+        sendRequests.push_back(_endpoints[child]->tagSend(
+          offset(buffer, chunkOffset), chunkLength, getTag(_rank, chunk)));
+    }
+  } catch (...) {
+    cancelAll(recvRequests);
+    cancelAll(sendRequests);
+    throw;
+  }
+  waitAll(sendRequests);
+}
+
+void CollectiveGroup::broadcast(void* buffer,
+                                size_t length,
+                                size_t root,
+                                CollectiveAlgorithm algorithm)
+{
+  const size_t size = getSize();
+  if (root >= size) throw std::invalid_argument("The root must be a rank of the group");
+  if (algorithm == CollectiveAlgorithm::Auto) algorithm = getBroadcastAlgorithm(length);
+  if (algorithm != CollectiveAlgorithm::BinomialTree && algorithm != CollectiveAlgorithm::Chain)
+    throw std::invalid_argument("Unsupported broadcast algorithm");
+
+  begin();
+  if (size == 1 || length == 0) return;
+
+  // Ranks relative to the root, which is thus `0`.
+  const size_t relativeRank = (_rank + size - root) % size;
+  auto toRank               = [root, size](size_t relative) { return (relative + root) % size; };
+
+  std::vector<size_t> children;
+  if (algorithm == CollectiveAlgorithm::BinomialTree) {
+    // The parent clears the lowest set bit of the relative rank, children set a lower one.
+    size_t mask = 1;
+    while (mask < size && (relativeRank & mask) == 0)
+      mask <<= 1;
+    for (size_t child = mask >> 1; child > 0; child >>= 1)
+      if (relativeRank + child < size) children.push_back(toRank(relativeRank + child));
+
+    forward(buffer, length, toRank(relativeRank & ~mask), relativeRank == 0, children);
+  } else {
+    if (relativeRank + 1 < size) children.push_back(toRank(relativeRank + 1));
+
+    forward(buffer, length, toRank(relativeRank + size - 1), relativeRank == 0, children);
+  }
+}
+
+void CollectiveGroup::allgather(const void* sendBuffer,
+                                void* recvBuffer,
+                                size_t length,
+                                CollectiveAlgorithm algorithm)
+{
+  const size_t size = getSize();
+  if (algorithm == CollectiveAlgorithm::Auto) algorithm = getAllgatherAlgorithm(length);
+  if (algorithm != CollectiveAlgorithm::Direct && algorithm != CollectiveAlgorithm::Ring)
+    throw std::invalid_argument("Unsupported allgather algorithm");
+
+  begin();
+  if (length == 0) return;
+
+  auto block = [recvBuffer, length](size_t rank) { return offset(recvBuffer, rank * length); };
+
+  std::vector<std::shared_ptr<Request>> requests;
+  try {
+    if (sendBuffer != block(_rank)) {
+      const size_t chunkSize = getChunkSize(length);
+      recvBlock(_rank, block(_rank), length, chunkSize, 0, requests);
+      sendBlock(_rank, sendBuffer, length, chunkSize, 0, requests);
+    }
+
+    if (algorithm == CollectiveAlgorithm::Direct) {
+      const size_t chunkSize = getChunkSize(length);
+      for (size_t peer = 0; peer < size; ++peer) {
+        if (peer == _rank) continue;
+        recvBlock(peer, block(peer), length, chunkSize, 0, requests);
+        sendBlock(peer, sendBuffer, length, chunkSize, 0, requests);
+      }
+    } else {
+      // At step `s` each rank sends block `rank - s` to the next rank and receives block
+      // `rank - s - 1` from the previous one, forwarding each chunk once it is received.
+      const size_t next      = (_rank + 1) % size;
+      const size_t previous  = (_rank + size - 1) % size;
+      const size_t steps     = size - 1;
+      const size_t chunkSize = getChunkSize(length, steps);
+      const size_t numChunks = getNumChunks(length, chunkSize);
+      auto blockAtStep       = [this, size](size_t step) { return (_rank + size - step) % size; };
+
+      std::vector<std::shared_ptr<Request>> recvRequests;
+      for (size_t step = 0; step < steps; ++step)
+        recvBlock(previous,
+                  block(blockAtStep(step + 1)),
+                  length,
+                  chunkSize,
+                  step * numChunks,
+                  recvRequests);
+      requests.insert(requests.end(), recvRequests.begin(), recvRequests.end());
+
+      for (size_t step = 0; step < steps; ++step) {
+        const char* data = step == 0 ? offset(sendBuffer, 0) : block(blockAtStep(step));
+        for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+          if (step > 0) wait(recvRequests[(step - 1) * numChunks + chunk]);
+          const size_t chunkOffset = chunk * chunkSize;
+          requests.push_back(_endpoints[next]->tagSend(const_cast<char*>(data + chunkOffset),
+                                                       std::min(chunkSize, length - chunkOffset),
+                                                       getTag(_rank, step * numChunks + chunk)));
+        }
+      }
+    }
+  } catch (...) {
+    cancelAll(requests);
+    throw;
+  }
+  waitAll(requests);
+}
+
+void CollectiveGroup::allToAll(const void* sendBuffer,
+                               void* recvBuffer,
+                               size_t length,
+                               CollectiveAlgorithm algorithm)
+{
+  const size_t size = getSize();
+  if (algorithm == CollectiveAlgorithm::Auto) algorithm = getAllToAllAlgorithm(length);
+  if (algorithm != CollectiveAlgorithm::Direct &&
+      algorithm != CollectiveAlgorithm::PairwiseExchange)
+    throw std::invalid_argument("Unsupported all-to-all algorithm");
+
+  begin();
+  if (length == 0) return;
+
+  const size_t chunkSize = getChunkSize(length);
+  const size_t window = algorithm == CollectiveAlgorithm::Direct ? size : _config.pairwiseWindow;
+
+  // At step `s` each rank sends to rank `rank + s` and receives from rank `rank - s`, the
+  // first step copying the block of the local rank. Steps are waited for in order, keeping
+  // at most `window` of them in flight.
+  std::vector<std::vector<std::shared_ptr<Request>>> steps(size);
+  try {
+    for (size_t step = 0; step < size; ++step) {
+      if (step >= window) waitAll(steps[step - window]);
+
+      const size_t destination = (_rank + step) % size;
+      const size_t source      = (_rank + size - step) % size;
+      recvBlock(
+        source, offset(recvBuffer, source * length), length, chunkSize, 0, steps[step]);
+      sendBlock(destination,
+                offset(sendBuffer, destination * length),
+                length,
+                chunkSize,
+                0,
+                steps[step]);
+    }
+    for (size_t step = size > window ? size - window : 0; step < size; ++step)
+      waitAll(steps[step]);
+  } catch (...) {
+    for (const auto& requests : steps)
+      cancelAll(requests);
+    throw;
+  }
+}
+
+}  // namespace ucxx
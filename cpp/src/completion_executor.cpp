@@ -0,0 +1,145 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <ucxx/completion_executor.h>
+#include <ucxx/log.h>
+
+namespace ucxx {
+
+CompletionExecutor::CompletionExecutor(CompletionCallbackExecutor executor, size_t batchSize)
+  : _batchSize(batchSize), _executor(executor)
+{
+  if (!_executor) throw std::invalid_argument("The completion callback executor is empty");
+  if (_batchSize == 0) throw std::invalid_argument("The batch size must be positive");
+}
+
+CompletionExecutor::CompletionExecutor(size_t numThreads, size_t batchSize)
+  : _batchSize(batchSize)
+{
+  if (numThreads == 0) throw std::invalid_argument("The number of threads must be positive");
+  if (_batchSize == 0) throw std::invalid_argument("The batch size must be positive");
+
+  _queues.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i)
+    _queues.push_back(std::make_unique<WorkQueue>());
+
+  _threads.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i)
+    _threads.emplace_back(&CompletionExecutor::run, this, i);
+}
+
+CompletionExecutor::~CompletionExecutor()
+{
+  flush();
+
+  if (_threads.empty()) return;
+
+  {
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+    _stop = true;
+  }
+  _sleepCondition.notify_all();
+  for (auto& thread : _threads)
+    thread.join();
+}
+
+void CompletionExecutor::enqueue(CompletionCallback callback)
+{
+  _pending.push(std::move(callback));
+}
+
+size_t CompletionExecutor::flush()
+{
+  std::lock_guard<std::mutex> lock(_flushMutex);
+
+  std::vector<CompletionCallback> batch;
+  size_t total = _pending.consume([this, &batch](CompletionCallback& callback) {
+    batch.push_back(std::move(callback));
+    if (batch.size() == _batchSize) dispatch(std::exchange(batch, {}));
+  });
+  if (!batch.empty()) dispatch(std::move(batch));
+
+  return total;
+}
+
+void CompletionExecutor::dispatch(std::vector<CompletionCallback> batch)
+{
+  if (_executor) {
+    _executor(std::move(batch));
+    return;
+  }
+
+  // Called with `_flushMutex` held, thus distributing batches in turn needs no atomics.
+  auto& queue = *_queues[_nextQueue++ % _queues.size()];
+  {
+    // Counted with the queue locked, so that taking a batch never precedes counting it.
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.batches.push_back(std::move(batch));
+    _queuedBatches.fetch_add(1, std::memory_order_release);
+  }
+
+  // Synchronize with threads about to wait, so the notification can't be missed.
+  { std::lock_guard<std::mutex> lock(_sleepMutex); }
+  _sleepCondition.notify_one();
+}
+
+bool CompletionExecutor::take(size_t index, std::vector<CompletionCallback>& batch)
+{
+  for (size_t i = 0; i < _queues.size(); ++i) {
+    auto& queue = *_queues[(index + i) % _queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.batches.empty()) continue;
+
+    if (i == 0) {
+      batch = std::move(queue.batches.front());
+      queue.batches.pop_front();
+    } else {
+      // Steal from the opposite end the owner takes from, reducing contention with it.
+      batch = std::move(queue.batches.back());
+      queue.batches.pop_back();
+      _stolenBatches.fetch_add(1, std::memory_order_relaxed);
+    }
+    _queuedBatches.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+  }
+  return false;
+}
+
+void CompletionExecutor::run(size_t index)
+{
+  while (true) {
+    std::vector<CompletionCallback> batch;
+    if (!take(index, batch)) {
+      std::unique_lock<std::mutex> lock(_sleepMutex);
+      _sleepCondition.wait(
+        lock, [this]() { return _stop || _queuedBatches.load(std::memory_order_acquire) > 0; });
+      if (_stop && _queuedBatches.load(std::memory_order_acquire) == 0) return;
+      continue;
+    }
+
+    for (auto& callback : batch) {
+      try {
+        callback();
+      } catch (const std::exception& e) {
+        ucxx_error(
+          "ucxx::CompletionExecutor::%s, completion callback raised: %s", __func__, e.what());
+      }
+    }
+  }
+}
+
+size_t CompletionExecutor::getNumThreads() const { return _threads.size(); }
+
+uint64_t CompletionExecutor::getStolenBatches() const
+{
+  return _stolenBatches.load(std::memory_order_relaxed);
+}
+
+}  // namespace ucxx
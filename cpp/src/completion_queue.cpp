@@ -0,0 +1,176 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <ucxx/completion_queue.h>
+#include <ucxx/log.h>
+
+namespace ucxx {
+
+CompletionFuture::CompletionFuture(std::shared_ptr<CompletionQueue> completionQueue)
+  : Future(completionQueue)
+{
+}
+
+std::shared_ptr<CompletionFuture> createCompletionFuture(
+  std::shared_ptr<CompletionQueue> completionQueue)
+{
+  return std::shared_ptr<CompletionFuture>(new CompletionFuture(completionQueue));
+}
+
+void CompletionFuture::notify(ucs_status_t status)
+{
+  _notifier->scheduleFutureNotify(shared_from_this(), status);
+}
+
+void CompletionFuture::set(ucs_status_t status)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _status.store(status, std::memory_order_release);
+  }
+  _conditionVariable.notify_all();
+}
+
+void* CompletionFuture::getHandle() { return this; }
+
+void* CompletionFuture::release() { return this; }
+
+bool CompletionFuture::isReady() const { return getStatus() != UCS_INPROGRESS; }
+
+ucs_status_t CompletionFuture::getStatus() const
+{
+  return _status.load(std::memory_order_acquire);
+}
+
+ucs_status_t CompletionFuture::wait()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _conditionVariable.wait(lock, [this]() { return isReady(); });
+  return getStatus();
+}
+
+bool CompletionFuture::waitFor(std::chrono::nanoseconds timeout)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  return _conditionVariable.wait_for(lock, timeout, [this]() { return isReady(); });
+}
+
+std::shared_ptr<CompletionQueue> createCompletionQueue()
+{
+  return std::shared_ptr<CompletionQueue>(new CompletionQueue());
+}
+
+void CompletionQueue::setHarvestEnabled(bool enabled)
+{
+  _harvestEnabled.store(enabled, std::memory_order_release);
+}
+
+bool CompletionQueue::isHarvestEnabled() const
+{
+  return _harvestEnabled.load(std::memory_order_acquire);
+}
+
+void CompletionQueue::scheduleFutureNotify(std::shared_ptr<Future> future, ucs_status_t status)
+{
+  ucxx_trace_req("ucxx::CompletionQueue::%s, future: %p, status: %s",
+                 __func__,
+                 future.get(),
+                 ucs_status_string(status));
+
+  // Complete the future first, so that harvested futures are always ready.
+  future->set(status);
+  if (!isHarvestEnabled()) return;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _completions.push_back({std::move(future), status});
+  }
+  _conditionVariable.notify_one();
+}
+
+RequestNotifierWaitState CompletionQueue::waitRequestNotifier(uint64_t period)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  if (_state == RequestNotifierThreadState::Stopping) {
+    _state = RequestNotifierThreadState::Running;
+    return RequestNotifierWaitState::Shutdown;
+  }
+
+  auto ready = [this]() {
+    return !_completions.empty() || _futuresPoolRefillRequested ||
+           _state == RequestNotifierThreadState::Stopping;
+  };
+  if (period > 0)
+    _conditionVariable.wait_for(lock, std::chrono::nanoseconds(period), ready);
+  else
+    _conditionVariable.wait(lock, ready);
+  _futuresPoolRefillRequested = false;
+
+  if (!_completions.empty()) return RequestNotifierWaitState::Ready;
+  if (_state == RequestNotifierThreadState::Stopping) return RequestNotifierWaitState::Shutdown;
+  return RequestNotifierWaitState::Timeout;
+}
+
+void CompletionQueue::runRequestNotifier() {}
+
+void CompletionQueue::requestFuturesPoolRefill()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _futuresPoolRefillRequested = true;
+  }
+  _conditionVariable.notify_one();
+}
+
+void CompletionQueue::stopRequestNotifierThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _state = RequestNotifierThreadState::Stopping;
+  }
+  _conditionVariable.notify_all();
+}
+
+size_t CompletionQueue::harvest(std::vector<Completion>& completions, size_t maxCompletions)
+{
+  const size_t count = std::min(maxCompletions, _completions.size());
+  completions.reserve(completions.size() + count);
+  std::move(
+    _completions.begin(), _completions.begin() + count, std::back_inserter(completions));
+  _completions.erase(_completions.begin(), _completions.begin() + count);
+  return count;
+}
+
+size_t CompletionQueue::poll(std::vector<Completion>& completions, size_t maxCompletions)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return harvest(completions, maxCompletions);
+}
+
+size_t CompletionQueue::waitFor(std::vector<Completion>& completions,
+                                std::chrono::nanoseconds timeout,
+                                size_t maxCompletions)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _conditionVariable.wait_for(lock, timeout, [this]() {
+    return !_completions.empty() || _state == RequestNotifierThreadState::Stopping;
+  });
+  return harvest(completions, maxCompletions);
+}
+
+size_t CompletionQueue::size() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _completions.size();
+}
+
+}  // namespace ucxx
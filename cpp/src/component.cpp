@@ -15,4 +15,8 @@ void Component::setParent(std::shared_ptr<Component> parent) { _parent = parent;
 
 std::shared_ptr<Component> Component::getParent() const { return _parent; }
 
+Endpoint* Component::asEndpoint() noexcept { return nullptr; }
+
+Worker* Component::asWorker() noexcept { return nullptr; }
+
 }  // namespace ucxx
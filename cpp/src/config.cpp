@@ -2,29 +2,95 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <ucxx/config.h>
 #include <ucxx/exception.h>
 #include <ucxx/utils/file_descriptor.h>
 #include <ucxx/utils/ucx.h>
 
+extern char** environ;
+
 namespace ucxx {
 
+struct Config::Cached {
+  ucp_config_t* handle{nullptr};  ///< Handle to the UCP config
+  std::once_flag parseFlag{};     ///< Ensures `configMap` is parsed only once
+  ConfigMap configMap{};          ///< Map containing all visible UCP configurations
+
+  ~Cached()
+  {
+    if (handle != nullptr) ucp_config_release(handle);
+  }
+};
+
+namespace {
+
+std::mutex cacheMutex{};
+
+std::map<std::string, std::shared_ptr<void>>& getCache()
+{
+  // Never destroyed, releasing UCP configurations at exit may happen after UCX has been
+  // unloaded.
+  static auto cache = new std::map<std::string, std::shared_ptr<void>>();
+  return *cache;
+}
+
+std::string getCacheKey(const ConfigMap& userOptions)
+{
+  std::vector<std::string> entries;
+  for (const auto& kv : userOptions)
+    entries.push_back(kv.first + "=" + kv.second);
+  std::sort(entries.begin(), entries.end());
+
+  // The environment is read by `ucp_config_read()` and may change between contexts.
+  std::vector<std::string> environment;
+  for (char** env = environ; env != nullptr && *env != nullptr; ++env)
+    if (strncmp(*env, "UCX_", 4) == 0) environment.push_back(*env);
+  std::sort(environment.begin(), environment.end());
+
+  std::string key;
+  for (const auto& entry : entries)
+    key += entry + '\n';
+  key += '\n';
+  for (const auto& entry : environment)
+    key += entry + '\n';
+
+  return key;
+}
+
+}  // namespace
+
 ucp_config_t* Config::readUCXConfig(ConfigMap userOptions)
 {
+  auto key = getCacheKey(userOptions);
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  auto& cache = getCache();
+  auto it     = cache.find(key);
+  if (it != cache.end()) {
+    _cached = std::static_pointer_cast<Cached>(it->second);
+    _handle = _cached->handle;
+    return _handle;
+  }
+
+  auto cached = std::make_shared<Cached>();
   ucs_status_t status;
 
-  status = ucp_config_read(NULL, NULL, &_handle);
+  status = ucp_config_read(NULL, NULL, &cached->handle);
   utils::ucsErrorThrow(status);
 
   // Modify the UCX configuration options based on `userOptions`
   for (const auto& kv : userOptions) {
-    status = ucp_config_modify(_handle, kv.first.c_str(), kv.second.c_str());
+    status = ucp_config_modify(cached->handle, kv.first.c_str(), kv.second.c_str());
     if (status != UCS_OK) {
-      ucp_config_release(_handle);
-
       if (status == UCS_ERR_NO_ELEM)
         utils::ucsErrorThrow(status,
                              std::string("Option ") + kv.first + std::string("doesn't exist"));
@@ -33,12 +99,15 @@ ucp_config_t* Config::readUCXConfig(ConfigMap userOptions)
     }
   }
 
+  cache.emplace(std::move(key), cached);
+  _cached = std::move(cached);
+  _handle = _cached->handle;
   return _handle;
 }
 
-ConfigMap Config::ucxConfigToMap()
+const ConfigMap& Config::ucxConfigToMap()
 {
-  if (_configMap.empty()) {
+  std::call_once(_cached->parseFlag, [this]() {
     FILE* textFileDescriptor = utils::createTextFileDescriptor();
     ucp_config_print(_handle, textFileDescriptor, NULL, UCS_CONFIG_PRINT_CONFIG);
     std::istringstream text{utils::decodeTextFileDescriptor(textFileDescriptor)};
@@ -49,22 +118,25 @@ ConfigMap Config::ucxConfigToMap()
       size_t split  = line.find(delim);
       std::string k = line.substr(4, split - 4);  // 4 to strip "UCX_" prefix
       std::string v = line.substr(split + delim.length(), std::string::npos);
-      _configMap[k] = v;
+      _cached->configMap[k] = v;
     }
-  }
+  });
 
-  return _configMap;
+  return _cached->configMap;
 }
 
 Config::Config(ConfigMap userOptions) { readUCXConfig(userOptions); }
 
-Config::~Config()
+Config::~Config() = default;
+
+const ConfigMap& Config::get() { return ucxConfigToMap(); }
+
+void Config::clearCache()
 {
-  if (this->_handle != nullptr) ucp_config_release(this->_handle);
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  getCache().clear();
 }
 
-ConfigMap Config::get() { return ucxConfigToMap(); }
-
 ucp_config_t* Config::getHandle() { return _handle; }
 
 }  // namespace ucxx
@@ -2,25 +2,38 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 
+#include <ucxx/address.h>
 #include <ucxx/context.h>
 #include <ucxx/log.h>
+#include <ucxx/memory_handle.h>
 #include <ucxx/utils/file_descriptor.h>
 #include <ucxx/utils/ucx.h>
+#include <ucxx/worker_pool.h>
 
 namespace ucxx {
 
-Context::Context(const ConfigMap ucxConfig, const uint64_t featureFlags)
-  : _config{ucxConfig}, _featureFlags{featureFlags}
+Context::Context(const ConfigMap ucxConfig,
+                 const uint64_t featureFlags,
+                 const bool enableMtWorkersShared)
+  : _config{ucxConfig}, _featureFlags{featureFlags}, _mtWorkersShared{enableMtWorkersShared}
 {
   parseLogLevel();
 
   // UCP
   ucp_params_t params = {.field_mask = UCP_PARAM_FIELD_FEATURES, .features = featureFlags};
+  if (_mtWorkersShared) {
+    // Workers created from the context may be progressed concurrently by their own threads
+    params.field_mask |= UCP_PARAM_FIELD_MT_WORKERS_SHARED;
+    params.mt_workers_shared = 1;
+  }
 
   utils::ucsErrorThrow(ucp_init(&params, _config.getHandle(), &_handle));
   ucxx_trace("ucxx::Context created: %p, UCP handle: %p", this, _handle);
@@ -33,9 +46,9 @@ Context::Context(const ConfigMap ucxConfig, const uint64_t featureFlags)
   // "cuda_copy", "cuda_ipc"} is in the active transports.
   // If the transport list is negated ("^" at start), then it is to be
   // interpreted as all \ given
-  auto configMap = _config.get();
-  auto tls       = configMap.find("TLS");
   if (_cudaSupport) {
+    const auto& configMap = _config.get();
+    auto tls              = configMap.find("TLS");
     if (tls != configMap.end()) {
       auto tls_value = tls->second;
       if (!tls_value.empty() && tls_value[0] == '^') {
@@ -60,14 +73,19 @@ Context::Context(const ConfigMap ucxConfig, const uint64_t featureFlags)
     }
   }
 
-  ucxx_info("UCP initialized using config: ");
-  for (const auto& kv : configMap)
-    ucxx_info("  %s: %s", kv.first.c_str(), kv.second.c_str());
+  // Avoid parsing the configuration only to discard the log messages
+  if (ucxx_log_is_enabled(UCXX_LOG_LEVEL_INFO)) {
+    ucxx_info("UCP initialized using config: ");
+    for (const auto& kv : _config.get())
+      ucxx_info("  %s: %s", kv.first.c_str(), kv.second.c_str());
+  }
 }
 
-std::shared_ptr<Context> createContext(const ConfigMap ucxConfig, const uint64_t featureFlags)
+std::shared_ptr<Context> createContext(const ConfigMap ucxConfig,
+                                       const uint64_t featureFlags,
+                                       const bool enableMtWorkersShared)
 {
-  return std::shared_ptr<Context>(new Context(ucxConfig, featureFlags));
+  return std::shared_ptr<Context>(new Context(ucxConfig, featureFlags, enableMtWorkersShared));
 }
 
 Context::~Context()
@@ -91,12 +109,61 @@ uint64_t Context::getFeatureFlags() const { return _featureFlags; }
 
 bool Context::hasCudaSupport() const { return _cudaSupport; }
 
+bool Context::isMtWorkersSharedEnabled() const { return _mtWorkersShared; }
+
 std::shared_ptr<Worker> Context::createWorker(const bool enableDelayedSubmission,
-                                              const bool enableFuture)
+                                              const bool enableFuture,
+                                              const bool enableSerializedThreadMode)
 {
   auto context = std::dynamic_pointer_cast<Context>(shared_from_this());
-  auto worker  = ucxx::createWorker(context, enableDelayedSubmission, enableFuture);
+  auto worker  = ucxx::createWorker(
+    context, enableDelayedSubmission, enableFuture, enableSerializedThreadMode);
   return worker;
 }
 
+std::shared_ptr<WorkerPool> Context::createWorkerPool(size_t numWorkers,
+                                                      WorkerPoolPlacement placement,
+                                                      const bool enableDelayedSubmission,
+                                                      const bool enableFuture,
+                                                      WorkerPoolFactory factory)
+{
+  auto context = std::static_pointer_cast<Context>(shared_from_this());
+  return ucxx::createWorkerPool(
+    context, numWorkers, placement, enableDelayedSubmission, enableFuture, factory);
+}
+
+std::shared_ptr<MemoryHandle> Context::createMemoryHandle(const size_t size,
+                                                          void* buffer,
+                                                          const ucs_memory_type_t memoryType)
+{
+  auto context = std::dynamic_pointer_cast<Context>(shared_from_this());
+  return ucxx::createMemoryHandle(context, size, buffer, memoryType);
+}
+
+std::shared_ptr<Address> Context::internAddress(const std::string& addressString)
+{
+  std::lock_guard<std::mutex> lock(_addressCacheMutex);
+
+  auto it = _addressCache.find(addressString);
+  if (it != _addressCache.end()) {
+    if (auto address = it->second.lock()) return address;
+  }
+
+  auto address = ucxx::createAddressFromString(addressString);
+  if (it != _addressCache.end()) {
+    it->second = address;
+    return address;
+  }
+
+  // Amortize the removal of released addresses over insertions
+  if (_addressCache.size() >= _addressCachePruneSize) {
+    for (auto c = _addressCache.begin(); c != _addressCache.end();)
+      c = c->second.expired() ? _addressCache.erase(c) : std::next(c);
+    _addressCachePruneSize = std::max<size_t>(64, 2 * _addressCache.size());
+  }
+  _addressCache.emplace(addressString, address);
+
+  return address;
+}
+
 }  // namespace ucxx
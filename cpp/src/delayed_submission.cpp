@@ -2,6 +2,9 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -10,6 +13,7 @@
 
 #include <ucxx/delayed_submission.h>
 #include <ucxx/log.h>
+#include <ucxx/utils/nvtx.h>
 
 namespace ucxx {
 
@@ -55,8 +59,11 @@ void GenericDelayedSubmissionCollection::processItem(DelayedSubmissionCallbackTy
 }
 
 DelayedSubmissionCollection::DelayedSubmissionCollection(bool enableDelayedRequestSubmission)
-  : _enableDelayedRequestSubmission(enableDelayedRequestSubmission),
-    _requests(RequestDelayedSubmissionCollection{"request", enableDelayedRequestSubmission})
+  : _requests{{RequestDelayedSubmissionCollection{"high priority request",
+                                                  enableDelayedRequestSubmission},
+               RequestDelayedSubmissionCollection{"request", enableDelayedRequestSubmission},
+               RequestDelayedSubmissionCollection{"bulk request", enableDelayedRequestSubmission}}},
+    _enableDelayedRequestSubmission(enableDelayedRequestSubmission)
 {
 }
 
@@ -65,29 +72,115 @@ bool DelayedSubmissionCollection::isDelayedRequestSubmissionEnabled() const
   return _enableDelayedRequestSubmission;
 }
 
-void DelayedSubmissionCollection::processPre()
+bool DelayedSubmissionCollection::requireSignal(std::atomic<bool>& pending)
 {
-  _requests.process();
+  // Pairs with the fence in `processPre()`/`processPost()`: either the processing thread
+  // observes the item just scheduled, or this thread observes the cleared flag.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return !pending.exchange(true);
+}
+
+void DelayedSubmissionCollection::updateStatistics(size_t processed,
+                                                   std::chrono::steady_clock::time_point start)
+{
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start);
+  _processedCallbacks.fetch_add(processed, std::memory_order_relaxed);
+  _processNanoseconds.fetch_add(elapsed.count(), std::memory_order_relaxed);
+}
+
+bool DelayedSubmissionCollection::processPre()
+{
+  auto& high   = _requests[static_cast<size_t>(SubmissionPriority::High)];
+  auto& normal = _requests[static_cast<size_t>(SubmissionPriority::Normal)];
+  auto& bulk   = _requests[static_cast<size_t>(SubmissionPriority::Bulk)];
+
+  _preSignalPending.store(false);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  // Avoid reading the clock on every iteration of an idle progress loop.
+  if (high.empty() && normal.empty() && bulk.empty() && _genericPre.empty()) return false;
+
+  UCXX_NVTX_RANGE("ucxx::DelayedSubmissionCollection::processPre");
+
+  auto start = std::chrono::steady_clock::now();
+
+  size_t processed = high.process();
+
+  const size_t budget = _requestBudget.load(std::memory_order_relaxed);
+  if (budget == 0) {
+    processed += normal.process();
+    processed += bulk.process();
+  } else {
+    const size_t bulkShare = (budget > 1 && !bulk.empty()) ? std::max<size_t>(1, budget / 4) : 0;
+    const size_t normalProcessed = normal.process(budget - bulkShare);
+    processed += normalProcessed;
+    if (budget > normalProcessed) processed += bulk.process(budget - normalProcessed);
+  }
+
+  processed += _genericPre.process();
+
+  updateStatistics(processed, start);
+
+  // Requests left over by the budget must be processed without waiting for registrations,
+  // which therefore need not signal in the meantime.
+  const bool backlog = normal.hasBacklog() || bulk.hasBacklog();
+  if (backlog) _preSignalPending.store(true);
+  return backlog;
+}
 
-  _genericPre.process();
+void DelayedSubmissionCollection::processPost()
+{
+  _postSignalPending.store(false);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (_genericPost.empty()) return;
+
+  UCXX_NVTX_RANGE("ucxx::DelayedSubmissionCollection::processPost");
+
+  auto start = std::chrono::steady_clock::now();
+
+  updateStatistics(_genericPost.process(), start);
+}
+
+bool DelayedSubmissionCollection::registerRequest(std::shared_ptr<Request> request,
+                                                  DelayedSubmissionCallbackType callback,
+                                                  SubmissionPriority priority)
+{
+  _requests.at(static_cast<size_t>(priority)).schedule({request, callback});
+  return requireSignal(_preSignalPending);
 }
 
-void DelayedSubmissionCollection::processPost() { _genericPost.process(); }
+void DelayedSubmissionCollection::setRequestBudget(size_t budget)
+{
+  _requestBudget.store(budget, std::memory_order_relaxed);
+}
 
-void DelayedSubmissionCollection::registerRequest(std::shared_ptr<Request> request,
-                                                  DelayedSubmissionCallbackType callback)
+size_t DelayedSubmissionCollection::getRequestBudget() const
 {
-  _requests.schedule({request, callback});
+  return _requestBudget.load(std::memory_order_relaxed);
 }
 
-void DelayedSubmissionCollection::registerGenericPre(DelayedSubmissionCallbackType callback)
+bool DelayedSubmissionCollection::registerGenericPre(DelayedSubmissionCallbackType callback)
 {
   _genericPre.schedule(callback);
+  return requireSignal(_preSignalPending);
 }
 
-void DelayedSubmissionCollection::registerGenericPost(DelayedSubmissionCallbackType callback)
+bool DelayedSubmissionCollection::registerGenericPost(DelayedSubmissionCallbackType callback)
 {
   _genericPost.schedule(callback);
+  return requireSignal(_postSignalPending);
+}
+
+uint64_t DelayedSubmissionCollection::getProcessedCallbacks() const
+{
+  return _processedCallbacks.load(std::memory_order_relaxed);
+}
+
+uint64_t DelayedSubmissionCollection::getProcessNanoseconds() const
+{
+  return _processNanoseconds.load(std::memory_order_relaxed);
 }
 
 }  // namespace ucxx
@@ -2,10 +2,17 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -14,15 +21,24 @@
 #include <ucxx/component.h>
 #include <ucxx/endpoint.h>
 #include <ucxx/exception.h>
+#include <ucxx/header.h>
+#include <ucxx/internal/request_am.h>
 #include <ucxx/listener.h>
+#include <ucxx/remote_key.h>
 #include <ucxx/request_am.h>
 #include <ucxx/request_data.h>
+#include <ucxx/request_endpoint_close.h>
+#include <ucxx/request_file.h>
+#include <ucxx/request_flush.h>
+#include <ucxx/request_mem.h>
 #include <ucxx/request_stream.h>
 #include <ucxx/request_tag.h>
 #include <ucxx/request_tag_multi.h>
 #include <ucxx/typedefs.h>
 #include <ucxx/utils/callback_notifier.h>
+#include <ucxx/utils/file_descriptor.h>
 #include <ucxx/utils/sockaddr.h>
+#include <ucxx/utils/tag.h>
 #include <ucxx/utils/ucx.h>
 #include <ucxx/worker.h>
 
@@ -42,9 +58,7 @@ static std::shared_ptr<Worker> getWorker(std::shared_ptr<Component> workerOrList
   return worker;
 }
 
-Endpoint::Endpoint(std::shared_ptr<Component> workerOrListener,
-                   ucp_ep_params_t* params,
-                   bool endpointErrorHandling)
+Endpoint::Endpoint(std::shared_ptr<Component> workerOrListener, bool endpointErrorHandling)
   : _endpointErrorHandling{endpointErrorHandling}
 {
   auto worker = ::ucxx::getWorker(workerOrListener);
@@ -54,21 +68,23 @@ Endpoint::Endpoint(std::shared_ptr<Component> workerOrListener,
 
   setParent(workerOrListener);
 
-  _callbackData = std::make_unique<ErrorCallbackData>(
-    (ErrorCallbackData){.status = UCS_OK, .inflightRequests = _inflightRequests, .worker = worker});
+  _callbackData.worker = worker;
+}
 
-  params->err_mode =
-    (endpointErrorHandling ? UCP_ERR_HANDLING_MODE_PEER : UCP_ERR_HANDLING_MODE_NONE);
-  params->err_handler.cb  = Endpoint::errorCallback;
-  params->err_handler.arg = _callbackData.get();
+Endpoint::Endpoint(std::shared_ptr<Component> workerOrListener,
+                   ucp_ep_params_t* params,
+                   bool endpointErrorHandling)
+  : Endpoint(workerOrListener, endpointErrorHandling)
+{
+  auto& worker = _callbackData.worker;
+
+  setErrorHandlerParams(params);
 
   if (worker->isProgressThreadRunning()) {
     ucs_status_t status = UCS_INPROGRESS;
     utils::CallbackNotifier callbackNotifier{};
-    auto worker = ::ucxx::getWorker(_parent);
     worker->registerGenericPre([this, &params, &callbackNotifier, &status]() {
-      auto worker = ::ucxx::getWorker(_parent);
-      status      = ucp_ep_create(worker->getHandle(), params, &_handle);
+      status = ucp_ep_create(_callbackData.worker->getHandle(), params, &_handle);
       callbackNotifier.set();
     });
     callbackNotifier.wait();
@@ -84,6 +100,61 @@ Endpoint::Endpoint(std::shared_ptr<Component> workerOrListener,
              endpointErrorHandling);
 }
 
+void Endpoint::setErrorHandlerParams(ucp_ep_params_t* params)
+{
+  params->err_mode =
+    (_endpointErrorHandling ? UCP_ERR_HANDLING_MODE_PEER : UCP_ERR_HANDLING_MODE_NONE);
+  params->err_handler.cb  = Endpoint::errorCallback;
+  params->err_handler.arg = &_callbackData;
+}
+
+std::vector<std::shared_ptr<Endpoint>> Endpoint::createEndpoints(
+  std::shared_ptr<Component> workerOrListener,
+  std::vector<ucp_ep_params_t>& params,
+  bool endpointErrorHandling)
+{
+  auto worker = ::ucxx::getWorker(workerOrListener);
+
+  std::vector<std::shared_ptr<Endpoint>> endpoints;
+  endpoints.reserve(params.size());
+  for (auto& p : params) {
+    endpoints.push_back(
+      std::shared_ptr<Endpoint>(new Endpoint(workerOrListener, endpointErrorHandling)));
+    endpoints.back()->setErrorHandlerParams(&p);
+  }
+
+  std::vector<ucs_status_t> statuses(params.size(), UCS_INPROGRESS);
+  auto create = [&worker, &endpoints, &params, &statuses]() {
+    for (size_t i = 0; i < params.size(); ++i)
+      statuses[i] = ucp_ep_create(worker->getHandle(), &params[i], &endpoints[i]->_handle);
+  };
+
+  if (worker->isProgressThreadRunning()) {
+    utils::CallbackNotifier callbackNotifier{};
+    worker->registerGenericPre([&create, &callbackNotifier]() {
+      create();
+      callbackNotifier.set();
+    });
+    callbackNotifier.wait();
+  } else {
+    create();
+  }
+
+  // Endpoints that were created successfully are closed on destruction if any failed
+  for (const auto& status : statuses)
+    utils::ucsErrorThrow(status);
+
+  for (const auto& endpoint : endpoints)
+    ucxx_trace(
+      "ucxx::Endpoint created: %p, UCP handle: %p, parent: %p, endpointErrorHandling: %d",
+      endpoint.get(),
+      endpoint->_handle,
+      endpoint->_parent.get(),
+      endpointErrorHandling);
+
+  return endpoints;
+}
+
 std::shared_ptr<Endpoint> createEndpointFromHostname(std::shared_ptr<Worker> worker,
                                                      std::string ipAddress,
                                                      uint16_t port,
@@ -120,6 +191,26 @@ std::shared_ptr<Endpoint> createEndpointFromConnRequest(std::shared_ptr<Listener
   return std::shared_ptr<Endpoint>(new Endpoint(listener, &params, endpointErrorHandling));
 }
 
+std::vector<std::shared_ptr<Endpoint>> createEndpointsFromConnRequests(
+  std::shared_ptr<Listener> listener,
+  const std::vector<ucp_conn_request_h>& connRequests,
+  bool endpointErrorHandling)
+{
+  if (listener == nullptr || listener->getHandle() == nullptr)
+    throw ucxx::Error("Worker not initialized");
+
+  std::vector<ucp_ep_params_t> params;
+  params.reserve(connRequests.size());
+  for (const auto& connRequest : connRequests)
+    params.push_back({.field_mask = UCP_EP_PARAM_FIELD_FLAGS | UCP_EP_PARAM_FIELD_CONN_REQUEST |
+                                    UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE |
+                                    UCP_EP_PARAM_FIELD_ERR_HANDLER,
+                      .flags        = UCP_EP_PARAMS_FLAGS_NO_LOOPBACK,
+                      .conn_request = connRequest});
+
+  return Endpoint::createEndpoints(listener, params, endpointErrorHandling);
+}
+
 std::shared_ptr<Endpoint> createEndpointFromWorkerAddress(std::shared_ptr<Worker> worker,
                                                           std::shared_ptr<Address> address,
                                                           bool endpointErrorHandling)
@@ -137,16 +228,92 @@ std::shared_ptr<Endpoint> createEndpointFromWorkerAddress(std::shared_ptr<Worker
   return std::shared_ptr<Endpoint>(new Endpoint(worker, &params, endpointErrorHandling));
 }
 
+std::vector<std::shared_ptr<Endpoint>> createEndpointsFromHostnames(
+  std::shared_ptr<Worker> worker,
+  const std::vector<std::pair<std::string, uint16_t>>& hosts,
+  bool endpointErrorHandling)
+{
+  if (worker == nullptr || worker->getHandle() == nullptr)
+    throw ucxx::Error("Worker not initialized");
+
+  // The address information must outlive the creation of the UCP endpoints
+  std::vector<std::unique_ptr<struct addrinfo, void (*)(struct addrinfo*)>> infos;
+  std::vector<ucp_ep_params_t> params;
+  infos.reserve(hosts.size());
+  params.reserve(hosts.size());
+  for (const auto& [ipAddress, port] : hosts) {
+    infos.push_back(ucxx::utils::get_addrinfo(ipAddress.c_str(), port));
+    params.push_back({.field_mask = UCP_EP_PARAM_FIELD_FLAGS | UCP_EP_PARAM_FIELD_SOCK_ADDR |
+                                    UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE |
+                                    UCP_EP_PARAM_FIELD_ERR_HANDLER,
+                      .flags      = UCP_EP_PARAMS_FLAGS_CLIENT_SERVER});
+    params.back().sockaddr.addrlen = infos.back()->ai_addrlen;
+    params.back().sockaddr.addr    = infos.back()->ai_addr;
+  }
+
+  return Endpoint::createEndpoints(worker, params, endpointErrorHandling);
+}
+
+std::vector<std::shared_ptr<Endpoint>> createEndpointsFromWorkerAddresses(
+  std::shared_ptr<Worker> worker,
+  const std::vector<std::shared_ptr<Address>>& addresses,
+  bool endpointErrorHandling)
+{
+  if (worker == nullptr || worker->getHandle() == nullptr)
+    throw ucxx::Error("Worker not initialized");
+
+  std::vector<ucp_ep_params_t> params;
+  params.reserve(addresses.size());
+  for (const auto& address : addresses) {
+    if (address == nullptr || address->getHandle() == nullptr || address->getLength() == 0)
+      throw ucxx::Error("Address not initialized");
+    params.push_back({.field_mask = UCP_EP_PARAM_FIELD_REMOTE_ADDRESS |
+                                    UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE |
+                                    UCP_EP_PARAM_FIELD_ERR_HANDLER,
+                      .address    = address->getHandle()});
+  }
+
+  return Endpoint::createEndpoints(worker, params, endpointErrorHandling);
+}
+
 Endpoint::~Endpoint()
 {
   close(10000000000 /* 10s */);
   ucxx_trace("ucxx::Endpoint destroyed: %p, UCP handle: %p", this, _originalHandle);
 }
 
-void Endpoint::close(uint64_t period, uint64_t maxAttempts)
+void Endpoint::close(uint64_t period,
+                     uint64_t maxAttempts,
+                     EndpointCloseMode mode,
+                     uint64_t flushTimeout)
 {
   if (_handle == nullptr) return;
 
+  // Aggregated messages are submitted, and thus canceled if the close is forced.
+  flushAmAggregation();
+
+  // Preposted headers are canceled with the remaining inflight requests.
+  {
+    std::lock_guard<std::mutex> lock(_tagMultiPrepostMutex);
+    _tagMultiPrepostEnabled = false;
+    _tagMultiPrepostedHeaders.clear();
+  }
+
+  // Let inflight operations complete before closing, forcing the close if that fails
+  unsigned closeMode = UCP_EP_CLOSE_MODE_FORCE;
+  if (mode == EndpointCloseMode::Flush && _callbackData.status == UCS_OK) {
+    if (flushWithTimeout(flushTimeout))
+      closeMode = UCP_EP_CLOSE_MODE_FLUSH;
+    else
+      ucxx_debug(
+        "ucxx::Endpoint::%s, Endpoint: %p, UCP handle: %p, flush did not complete within %lu "
+        "ns, forcing close",
+        __func__,
+        this,
+        _handle,
+        flushTimeout);
+  }
+
   size_t canceled = cancelInflightRequests(3000000000 /* 3s */, 3);
   ucxx_debug("ucxx::Endpoint::%s, Endpoint: %p, UCP handle: %p, canceled %lu requests",
              __func__,
@@ -155,14 +322,13 @@ void Endpoint::close(uint64_t period, uint64_t maxAttempts)
              canceled);
 
   // Close the endpoint
-  unsigned closeMode = UCP_EP_CLOSE_MODE_FORCE;
-  if (_endpointErrorHandling && _callbackData->status != UCS_OK) {
+  if (_endpointErrorHandling && _callbackData.status != UCS_OK) {
     // We force close endpoint if endpoint error handling is enabled and
     // the endpoint status is not UCS_OK
     closeMode = UCP_EP_CLOSE_MODE_FORCE;
   }
 
-  auto worker = ::ucxx::getWorker(_parent);
+  auto& worker = _callbackData.worker;
   ucs_status_ptr_t status;
 
   if (worker->isProgressThreadRunning()) {
@@ -181,7 +347,7 @@ void Endpoint::close(uint64_t period, uint64_t maxAttempts)
           ucs_status_t s = ucp_request_check_status(status);
           if (UCS_PTR_STATUS(s) != UCS_INPROGRESS) {
             ucp_request_free(status);
-            _callbackData->status = UCS_PTR_STATUS(s);
+            _callbackData.status = UCS_PTR_STATUS(s);
             if (UCS_PTR_STATUS(status) != UCS_OK) {
               ucxx_error(
                 "ucxx::Endpoint::%s, Endpoint: %p, UCP handle: %p, error while closing "
@@ -202,7 +368,7 @@ void Endpoint::close(uint64_t period, uint64_t maxAttempts)
     }
 
     if (!closeSuccess) {
-      _callbackData->status = UCS_ERR_ENDPOINT_TIMEOUT;
+      _callbackData.status = UCS_ERR_ENDPOINT_TIMEOUT;
       ucxx_debug(
         "ucxx::Endpoint::%s, Endpoint: %p, UCP handle: %p, all attempts to close timed out",
         __func__,
@@ -216,7 +382,7 @@ void Endpoint::close(uint64_t period, uint64_t maxAttempts)
       while ((s = ucp_request_check_status(status)) == UCS_INPROGRESS)
         worker->progress();
       ucp_request_free(status);
-      _callbackData->status = s;
+      _callbackData.status = s;
     } else if (UCS_PTR_STATUS(status) != UCS_OK) {
       ucxx_error(
         "ucxx::Endpoint::%s, Endpoint: %p, UCP handle: %p, Error while closing endpoint: %s",
@@ -228,17 +394,66 @@ void Endpoint::close(uint64_t period, uint64_t maxAttempts)
   }
   ucxx_trace("ucxx::Endpoint::%s, Endpoint: %p, UCP handle: %p, closed", __func__, this, _handle);
 
-  if (_callbackData->closeCallback) {
+  invokeCloseCallback();
+
+  std::swap(_handle, _originalHandle);
+
+  // Submit sends still awaiting credits, they are canceled now that the handle is released.
+  std::deque<std::pair<size_t, std::function<void()>>> pendingSends;
+  {
+    std::lock_guard<std::mutex> lock(_amFlowControlMutex);
+    if (_amFlowControlEnabled) worker->unregisterAmFlowControlEndpoint(_originalHandle);
+    _amFlowControlEnabled = false;
+    std::swap(pendingSends, _amPendingSends);
+  }
+  for (auto& [_, submit] : pendingSends)
+    submit();
+}
+
+bool Endpoint::flushWithTimeout(uint64_t timeout)
+{
+  auto& worker  = _callbackData.worker;
+  auto request  = flush();
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout);
+
+  bool progressWorker = !worker->isProgressThreadRunning() ||
+                        std::this_thread::get_id() == worker->getProgressThreadId();
+  while (!request->isCompleted() && std::chrono::steady_clock::now() < deadline) {
+    if (progressWorker)
+      worker->progress();
+    else
+      std::this_thread::yield();
+  }
+
+  return request->isCompleted() && request->getStatus() == UCS_OK;
+}
+
+ucp_ep_h Endpoint::detachHandle()
+{
+  if (_handle == nullptr) return nullptr;
+
+  size_t canceled = _callbackData.inflightRequests.cancelAll();
+  ucxx_debug("ucxx::Endpoint::%s, Endpoint: %p, UCP handle: %p, canceled %lu requests",
+             __func__,
+             this,
+             _handle,
+             canceled);
+
+  std::swap(_handle, _originalHandle);
+  return _originalHandle;
+}
+
+void Endpoint::invokeCloseCallback()
+{
+  if (_callbackData.closeCallback) {
     ucxx_debug("ucxx::Endpoint::%s, Endpoint: %p, UCP handle: %p, calling user close callback",
                __func__,
                this,
-               _handle);
-    _callbackData->closeCallback(_callbackData->closeCallbackArg);
-    _callbackData->closeCallback    = nullptr;
-    _callbackData->closeCallbackArg = nullptr;
+               _handle != nullptr ? _handle : _originalHandle);
+    _callbackData.closeCallback(_callbackData.closeCallbackArg);
+    _callbackData.closeCallback    = nullptr;
+    _callbackData.closeCallbackArg = nullptr;
   }
-
-  std::swap(_handle, _originalHandle);
 }
 
 ucp_ep_h Endpoint::getHandle() { return _handle; }
@@ -247,70 +462,478 @@ bool Endpoint::isAlive() const
 {
   if (!_endpointErrorHandling) return true;
 
-  return _callbackData->status == UCS_OK;
+  return _callbackData.status == UCS_OK;
 }
 
 void Endpoint::raiseOnError()
 {
-  ucs_status_t status = _callbackData->status;
+  std::string message;
+  ucs_status_t status = getError(&message);
+
+  if (status != UCS_OK) utils::ucsErrorThrow(status, message);
+}
+
+ucs_status_t Endpoint::getError(std::string* message) noexcept
+{
+  ucs_status_t status = _callbackData.status;
 
-  if (status == UCS_OK || !_endpointErrorHandling) return;
+  if (status == UCS_OK || !_endpointErrorHandling) return UCS_OK;
 
-  std::string statusString{ucs_status_string(status)};
-  std::stringstream errorMsgStream;
-  errorMsgStream << "Endpoint " << std::hex << _handle << " error: " << statusString;
+  if (message != nullptr) {
+    std::stringstream errorMsgStream;
+    errorMsgStream << "Endpoint " << std::hex << _handle << " error: " << ucs_status_string(status);
+    *message = errorMsgStream.str();
+  }
 
-  utils::ucsErrorThrow(status, errorMsgStream.str());
+  return status;
 }
 
 void Endpoint::setCloseCallback(std::function<void(void*)> closeCallback, void* closeCallbackArg)
 {
-  _callbackData->closeCallback    = closeCallback;
-  _callbackData->closeCallbackArg = closeCallbackArg;
+  _callbackData.closeCallback    = closeCallback;
+  _callbackData.closeCallbackArg = closeCallbackArg;
+}
+
+void Endpoint::setSendHints(const SendHints& sendHints)
+{
+  std::lock_guard<std::mutex> lock(_sendHintsMutex);
+  _sendHints = sendHints;
+}
+
+SendHints Endpoint::getSendHints() const
+{
+  std::lock_guard<std::mutex> lock(_sendHintsMutex);
+  return _sendHints;
+}
+
+void Endpoint::setTagBases(Tag sendTagBase, Tag recvTagBase)
+{
+  _sendTagBase.store(sendTagBase, std::memory_order_relaxed);
+  _recvTagBase.store(recvTagBase, std::memory_order_relaxed);
+}
+
+Tag Endpoint::getSendTagBase() const { return Tag{_sendTagBase.load(std::memory_order_relaxed)}; }
+
+Tag Endpoint::getRecvTagBase() const { return Tag{_recvTagBase.load(std::memory_order_relaxed)}; }
+
+Tag Endpoint::deriveSendTag(uint64_t userTag) const
+{
+  return utils::deriveTag(getSendTagBase(), userTag);
+}
+
+Tag Endpoint::deriveRecvTag(uint64_t userTag) const
+{
+  return utils::deriveTag(getRecvTagBase(), userTag);
+}
+
+void Endpoint::setAmFlowControl(uint64_t maxMessages, uint64_t maxBytes)
+{
+  auto& worker = _callbackData.worker;
+  std::deque<std::pair<size_t, std::function<void()>>> pendingSends;
+  {
+    std::lock_guard<std::mutex> lock(_amFlowControlMutex);
+    if (_handle == nullptr) throw ucxx::Error("Endpoint is closed");
+    if ((maxMessages > 0 || maxBytes > 0) && isAmAggregationEnabled())
+      throw std::runtime_error("Active message flow control can not be used with aggregation");
+
+    _amFlowControlMaxMessages = maxMessages;
+    _amFlowControlMaxBytes    = maxBytes;
+
+    if (maxMessages == 0 && maxBytes == 0) {
+      if (_amFlowControlEnabled) worker->unregisterAmFlowControlEndpoint(_handle);
+      _amFlowControlEnabled = false;
+      _amInflightMessages   = 0;
+      _amInflightBytes      = 0;
+      std::swap(pendingSends, _amPendingSends);
+    } else if (!_amFlowControlEnabled) {
+      worker->registerAmFlowControlEndpoint(
+        _handle, std::weak_ptr<Endpoint>(std::static_pointer_cast<Endpoint>(shared_from_this())));
+      _amFlowControlEnabled = true;
+    }
+  }
+
+  for (auto& [_, submit] : pendingSends)
+    submit();
+}
+
+bool Endpoint::isAmFlowControlEnabled() const
+{
+  std::lock_guard<std::mutex> lock(_amFlowControlMutex);
+  return _amFlowControlEnabled;
+}
+
+size_t Endpoint::getAmPendingSendCount() const
+{
+  std::lock_guard<std::mutex> lock(_amFlowControlMutex);
+  return _amPendingSends.size();
+}
+
+/**
+ * @brief Check whether a message fits the active message flow control budget.
+ *
+ * A message always fits if nothing is in flight, so that messages larger than the budget
+ * can still be sent.
+ */
+static bool fitsAmBudget(uint64_t inflightMessages,
+                         uint64_t inflightBytes,
+                         uint64_t maxMessages,
+                         uint64_t maxBytes,
+                         size_t length)
+{
+  if (inflightMessages == 0) return true;
+  return (maxMessages == 0 || inflightMessages + 1 <= maxMessages) &&
+         (maxBytes == 0 || inflightBytes + length <= maxBytes);
+}
+
+bool Endpoint::submitWithAmCredits(size_t length, std::function<void()> submit)
+{
+  {
+    std::lock_guard<std::mutex> lock(_amFlowControlMutex);
+    if (!_amFlowControlEnabled) return false;
+
+    // Preserve ordering, sends are never submitted ahead of pending ones.
+    if (!_amPendingSends.empty() || !fitsAmBudget(_amInflightMessages,
+                                                  _amInflightBytes,
+                                                  _amFlowControlMaxMessages,
+                                                  _amFlowControlMaxBytes,
+                                                  length)) {
+      _amPendingSends.emplace_back(length, std::move(submit));
+      return true;
+    }
+
+    ++_amInflightMessages;
+    _amInflightBytes += length;
+  }
+
+  submit();
+  return true;
+}
+
+void Endpoint::grantAmCredits(uint64_t messages, uint64_t bytes)
+{
+  std::vector<std::function<void()>> submits;
+  {
+    std::lock_guard<std::mutex> lock(_amFlowControlMutex);
+    if (!_amFlowControlEnabled) return;
+
+    _amInflightMessages -= std::min(messages, _amInflightMessages);
+    _amInflightBytes -= std::min(bytes, _amInflightBytes);
+
+    while (!_amPendingSends.empty() && fitsAmBudget(_amInflightMessages,
+                                                    _amInflightBytes,
+                                                    _amFlowControlMaxMessages,
+                                                    _amFlowControlMaxBytes,
+                                                    _amPendingSends.front().first)) {
+      ++_amInflightMessages;
+      _amInflightBytes += _amPendingSends.front().first;
+      submits.push_back(std::move(_amPendingSends.front().second));
+      _amPendingSends.pop_front();
+    }
+  }
+
+  for (auto& submit : submits)
+    submit();
+}
+
+void Endpoint::setAmAggregation(size_t maxMessageSize, size_t maxBatchBytes, uint64_t window)
+{
+  if (maxMessageSize > 0 &&
+      (maxMessageSize > maxBatchBytes ||
+       maxBatchBytes - maxMessageSize < sizeof(internal::AmAggregationRecord) +
+                                          sizeof(ucs_memory_type_t)))
+    throw std::invalid_argument("Messages of maxMessageSize bytes do not fit in maxBatchBytes");
+  if (maxMessageSize > 0 && isAmFlowControlEnabled())
+    throw std::runtime_error("Active message aggregation can not be used with flow control");
+
+  std::shared_ptr<internal::AmAggregationBatch> batch{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(_amAggregationMutex);
+    if (_handle == nullptr) throw ucxx::Error("Endpoint is closed");
+
+    // Submit messages aggregated with the previous configuration.
+    batch                        = takeAmAggregationBatch();
+    _amAggregationMaxMessageSize = maxMessageSize;
+    _amAggregationMaxBatchBytes  = maxBatchBytes;
+    _amAggregationWindow         = std::chrono::nanoseconds(window);
+  }
+
+  submitAmAggregationBatch(std::move(batch));
+}
+
+bool Endpoint::isAmAggregationEnabled() const
+{
+  std::lock_guard<std::mutex> lock(_amAggregationMutex);
+  return _amAggregationMaxMessageSize > 0;
+}
+
+void Endpoint::flushAmAggregation()
+{
+  std::shared_ptr<internal::AmAggregationBatch> batch{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(_amAggregationMutex);
+    batch = takeAmAggregationBatch();
+  }
+
+  submitAmAggregationBatch(std::move(batch));
+}
+
+bool Endpoint::aggregateAmSend(std::shared_ptr<Request> request, const data::AmSend& amSend)
+{
+  const size_t recordLength = sizeof(internal::AmAggregationRecord) +
+                              sizeof(ucs_memory_type_t) + amSend._header.size() + amSend._length;
+  std::shared_ptr<internal::AmAggregationBatch> batch{nullptr};
+  bool aggregated = false, wake = false;
+
+  {
+    std::lock_guard<std::mutex> lock(_amAggregationMutex);
+
+    // Fast path, nothing to aggregate nor to submit before the caller sends.
+    if (_amAggregationBatch == nullptr && _amAggregationMaxMessageSize == 0) return false;
+
+    const bool eligible = _amAggregationMaxMessageSize > 0 &&
+                          amSend._length <= _amAggregationMaxMessageSize &&
+                          recordLength <= _amAggregationMaxBatchBytes &&
+                          amSend._memoryType == UCS_MEMORY_TYPE_HOST &&
+                          amSend._memoryHandle == nullptr;
+
+    // Submit the pending batch before messages that do not fit it, preserving ordering.
+    if (!eligible || (_amAggregationBatch != nullptr &&
+                      _amAggregationBatch->buffer.size() + recordLength >
+                        _amAggregationMaxBatchBytes))
+      batch = takeAmAggregationBatch();
+
+    if (eligible) {
+      if (_amAggregationBatch == nullptr) {
+        _amAggregationBatch          = std::make_shared<internal::AmAggregationBatch>();
+        _amAggregationBatch->created = std::chrono::steady_clock::now();
+        _amAggregationBatch->buffer.reserve(_amAggregationMaxBatchBytes);
+        _callbackData.worker->registerAmAggregationEndpoint(
+          this, std::weak_ptr<Endpoint>(std::static_pointer_cast<Endpoint>(shared_from_this())));
+        wake = true;
+      }
+
+      internal::AmAggregationRecord record{
+        amSend._amId,
+        static_cast<uint32_t>(sizeof(ucs_memory_type_t) + amSend._header.size()),
+        static_cast<uint32_t>(amSend._length)};
+      uint32_t memoryType = amSend._memoryType;
+
+      auto& buffer = _amAggregationBatch->buffer;
+      buffer.append(reinterpret_cast<const char*>(&record), sizeof(record));
+      buffer.append(reinterpret_cast<const char*>(&memoryType), sizeof(memoryType));
+      buffer.append(amSend._header);
+      buffer.append(static_cast<const char*>(amSend._buffer), amSend._length);
+      _amAggregationBatch->requests.push_back(std::move(request));
+      aggregated = true;
+    }
+  }
+
+  submitAmAggregationBatch(std::move(batch));
+
+  // Wake the worker so that it progresses and submits the new batch in time.
+  if (wake) _callbackData.worker->signal();
+
+  return aggregated;
+}
+
+std::shared_ptr<internal::AmAggregationBatch> Endpoint::takeAmAggregationBatch()
+{
+  if (_amAggregationBatch == nullptr) return nullptr;
+
+  _callbackData.worker->unregisterAmAggregationEndpoint(this);
+  return std::exchange(_amAggregationBatch, nullptr);
+}
+
+void Endpoint::submitAmAggregationBatch(std::shared_ptr<internal::AmAggregationBatch> batch)
+{
+  if (batch == nullptr) return;
+
+  ucxx_trace_req("ucxx::Endpoint::%s, Endpoint: %p, UCP handle: %p, submitting %lu messages",
+                 __func__,
+                 this,
+                 _handle,
+                 batch->requests.size());
+
+  // The batch owns the buffer until the send completes, it is then kept alive by the callback.
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  auto request  = createRequestAm(
+    endpoint,
+    data::AmSend(batch->buffer.data(),
+                 batch->buffer.size(),
+                 UCS_MEMORY_TYPE_HOST,
+                 {},
+                 internal::AmAggregationId),
+    false,
+    [](ucs_status_t status, std::shared_ptr<void> data) {
+      auto batch = std::static_pointer_cast<internal::AmAggregationBatch>(data);
+      for (auto& request : batch->requests)
+        request->callback(nullptr, status);
+    },
+    batch);
+  registerInflightRequest(request);
+}
+
+bool Endpoint::flushExpiredAmAggregation(std::chrono::steady_clock::time_point now)
+{
+  std::shared_ptr<internal::AmAggregationBatch> batch{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(_amAggregationMutex);
+    if (_amAggregationBatch == nullptr) return false;
+    if (now - _amAggregationBatch->created < _amAggregationWindow) return true;
+    batch = takeAmAggregationBatch();
+  }
+
+  submitAmAggregationBatch(std::move(batch));
+  return false;
+}
+
+void Endpoint::setTagMultiPrepost(bool enable)
+{
+  std::lock_guard<std::mutex> lock(_tagMultiPrepostMutex);
+  if (enable && _handle == nullptr) throw ucxx::Error("Endpoint is closed");
+  _tagMultiPrepostEnabled = enable;
+}
+
+bool Endpoint::isTagMultiPrepostEnabled() const
+{
+  std::lock_guard<std::mutex> lock(_tagMultiPrepostMutex);
+  return _tagMultiPrepostEnabled;
+}
+
+void Endpoint::setTrafficCaptureEnabled(bool enable) { _trafficCaptureEnabled = enable; }
+
+bool Endpoint::isTrafficCaptureEnabled() const { return _trafficCaptureEnabled; }
+
+void Endpoint::prepostTagMultiHeader(Tag tag, TagMask tagMask)
+{
+  auto key = std::make_pair(static_cast<ucp_tag_t>(tag), static_cast<ucp_tag_t>(tagMask));
+
+  // Post while holding the lock so that the header is never taken before its request is set,
+  // the completion callback only acquires the lock of the preposted header itself.
+  std::lock_guard<std::mutex> lock(_tagMultiPrepostMutex);
+  if (!_tagMultiPrepostEnabled || _tagMultiPrepostedHeaders.count(key)) return;
+
+  auto preposted          = std::make_shared<internal::TagMultiPrepostedHeader>();
+  auto stringBuffer       = std::make_shared<std::string>(Header::dataSize(), 0);
+  preposted->stringBuffer = stringBuffer;
+
+  std::weak_ptr<internal::TagMultiPrepostedHeader> weakPreposted = preposted;
+  preposted->request =
+    tagRecv(&stringBuffer->front(),
+            stringBuffer->size(),
+            tag,
+            tagMask,
+            false,
+            [weakPreposted](ucs_status_t status, RequestCallbackUserData arg) {
+              if (auto preposted = weakPreposted.lock()) preposted->complete(status);
+            });
+  _tagMultiPrepostedHeaders.emplace(key, preposted);
+
+  ucxx_trace_req("ucxx::Endpoint::%s, Endpoint: %p, UCP handle: %p, tag: 0x%lx, tagMask: 0x%lx, "
+                 "preposted header request: %p",
+                 __func__,
+                 this,
+                 _handle,
+                 key.first,
+                 key.second,
+                 preposted->request.get());
+}
+
+std::shared_ptr<internal::TagMultiPrepostedHeader> Endpoint::takeTagMultiPrepostedHeader(
+  Tag tag, TagMask tagMask)
+{
+  auto key = std::make_pair(static_cast<ucp_tag_t>(tag), static_cast<ucp_tag_t>(tagMask));
+
+  std::lock_guard<std::mutex> lock(_tagMultiPrepostMutex);
+  auto it = _tagMultiPrepostedHeaders.find(key);
+  if (it == _tagMultiPrepostedHeaders.end()) return nullptr;
+
+  auto preposted = std::move(it->second);
+  _tagMultiPrepostedHeaders.erase(it);
+  return preposted;
+}
+
+void Endpoint::applySendHints(ucp_request_param_t& param,
+                              size_t length,
+                              bool activeMessage) const
+{
+  const SendHints sendHints = getSendHints();
+
+  if (sendHints.fastCompletion) param.op_attr_mask |= UCP_OP_ATTR_FLAG_FAST_CMPL;
+  if (sendHints.multiSend) param.op_attr_mask |= UCP_OP_ATTR_FLAG_MULTI_SEND;
+
+  if (!activeMessage) return;
+
+  SendProtocol protocol = sendHints.amProtocol;
+  if (protocol == SendProtocol::Auto && sendHints.amRendezvousThreshold > 0)
+    protocol =
+      length >= sendHints.amRendezvousThreshold ? SendProtocol::Rendezvous : SendProtocol::Eager;
+
+  if (protocol == SendProtocol::Auto) return;
+  param.op_attr_mask |= UCP_OP_ATTR_FIELD_FLAGS;
+  param.flags |= protocol == SendProtocol::Eager ? UCP_AM_SEND_FLAG_EAGER : UCP_AM_SEND_FLAG_RNDV;
 }
 
 std::shared_ptr<Request> Endpoint::registerInflightRequest(std::shared_ptr<Request> request)
 {
-  if (!request->isCompleted()) _inflightRequests->insert(request);
+  if (!request->isCompleted()) _callbackData.inflightRequests.insert(request);
 
   /**
    * If the endpoint errored while the request was being submitted, the error
    * handler may have been called already and we need to register any new requests
-   * for cancelation, including the present one.
+   * for abortion, including the present one.
    */
-  if (_callbackData->status != UCS_OK)
-    _callbackData->worker->scheduleRequestCancel(_inflightRequests->release());
+  if (_callbackData.status != UCS_OK)
+    _callbackData.worker->abortInflightRequests(_callbackData.inflightRequests.release());
 
   return request;
 }
 
+std::vector<std::shared_ptr<Request>> Endpoint::registerInflightRequests(
+  std::vector<std::shared_ptr<Request>> requests)
+{
+  std::vector<std::shared_ptr<Request>> incomplete;
+  incomplete.reserve(requests.size());
+  for (const auto& request : requests)
+    if (!request->isCompleted()) incomplete.push_back(request);
+  if (!incomplete.empty()) _callbackData.inflightRequests.insert(incomplete);
+
+  // See `registerInflightRequest()`.
+  if (_callbackData.status != UCS_OK)
+    _callbackData.worker->abortInflightRequests(_callbackData.inflightRequests.release());
+
+  return requests;
+}
+
 void Endpoint::removeInflightRequest(const Request* const request)
 {
-  _inflightRequests->remove(request);
+  _callbackData.inflightRequests.remove(request);
 }
 
 size_t Endpoint::cancelInflightRequests(uint64_t period, uint64_t maxAttempts)
 {
-  auto worker     = ::ucxx::getWorker(this->_parent);
+  auto& worker    = _callbackData.worker;
   size_t canceled = 0;
 
   if (std::this_thread::get_id() == worker->getProgressThreadId()) {
-    canceled = _inflightRequests->cancelAll();
-    for (uint64_t i = 0; i < maxAttempts && _inflightRequests->getCancelingSize() > 0; ++i)
+    canceled = _callbackData.inflightRequests.cancelAll();
+    for (uint64_t i = 0;
+         i < maxAttempts && _callbackData.inflightRequests.getCancelingSize() > 0;
+         ++i)
       worker->progress();
   } else if (worker->isProgressThreadRunning()) {
     bool cancelSuccess = false;
     for (uint64_t i = 0; i < maxAttempts && !cancelSuccess; ++i) {
       utils::CallbackNotifier callbackNotifierPre{};
       worker->registerGenericPre([this, &callbackNotifierPre, &canceled]() {
-        canceled += _inflightRequests->cancelAll();
+        canceled += _callbackData.inflightRequests.cancelAll();
         callbackNotifierPre.set();
       });
       if (!callbackNotifierPre.wait(period)) continue;
 
       utils::CallbackNotifier callbackNotifierPost{};
       worker->registerGenericPost([this, &callbackNotifierPost, &cancelSuccess]() {
-        cancelSuccess = _inflightRequests->getCancelingSize() == 0;
+        cancelSuccess = _callbackData.inflightRequests.getCancelingSize() == 0;
         callbackNotifierPost.set();
       });
       if (!callbackNotifierPost.wait(period)) continue;
@@ -323,7 +946,7 @@ size_t Endpoint::cancelInflightRequests(uint64_t period, uint64_t maxAttempts)
         this,
         _handle);
   } else {
-    canceled = _inflightRequests->cancelAll();
+    canceled = _callbackData.inflightRequests.cancelAll();
   }
 
   return canceled;
@@ -334,30 +957,128 @@ std::shared_ptr<Request> Endpoint::amSend(void* buffer,
                                           ucs_memory_type_t memoryType,
                                           const bool enablePythonFuture,
                                           RequestCallbackUserFunction callbackFunction,
-                                          RequestCallbackUserData callbackData)
+                                          RequestCallbackUserData callbackData,
+                                          const std::string& header,
+                                          const unsigned int amId,
+                                          std::shared_ptr<MemoryHandle> memoryHandle,
+                                          RequestReadinessCallback readiness)
 {
-  auto endpoint = std::dynamic_pointer_cast<Endpoint>(shared_from_this());
-  return registerInflightRequest(createRequestAm(endpoint,
-                                                 data::AmSend(buffer, length, memoryType),
-                                                 enablePythonFuture,
-                                                 callbackFunction,
-                                                 callbackData));
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(createRequestAm(
+    endpoint,
+    data::AmSend(buffer, length, memoryType, header, amId, memoryHandle, readiness),
+                    enablePythonFuture,
+                    callbackFunction,
+                    callbackData));
 }
 
 std::shared_ptr<Request> Endpoint::amRecv(const bool enablePythonFuture,
                                           RequestCallbackUserFunction callbackFunction,
-                                          RequestCallbackUserData callbackData)
+                                          RequestCallbackUserData callbackData,
+                                          const unsigned int amId)
 {
-  auto endpoint = std::dynamic_pointer_cast<Endpoint>(shared_from_this());
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
   return registerInflightRequest(createRequestAm(
-    endpoint, data::AmReceive(), enablePythonFuture, callbackFunction, callbackData));
+    endpoint, data::AmReceive(amId), enablePythonFuture, callbackFunction, callbackData));
+}
+
+std::shared_ptr<Request> Endpoint::memPut(void* buffer,
+                                          size_t length,
+                                          uint64_t remoteAddr,
+                                          std::shared_ptr<RemoteKey> remoteKey,
+                                          const bool enablePythonFuture,
+                                          RequestCallbackUserFunction callbackFunction,
+                                          RequestCallbackUserData callbackData,
+                                          std::shared_ptr<MemoryHandle> memoryHandle)
+{
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(
+    createRequestMem(endpoint,
+                     data::MemPut(buffer, length, remoteAddr, remoteKey, memoryHandle),
+                     enablePythonFuture,
+                     callbackFunction,
+                     callbackData));
+}
+
+std::shared_ptr<Request> Endpoint::memGet(void* buffer,
+                                          size_t length,
+                                          uint64_t remoteAddr,
+                                          std::shared_ptr<RemoteKey> remoteKey,
+                                          const bool enablePythonFuture,
+                                          RequestCallbackUserFunction callbackFunction,
+                                          RequestCallbackUserData callbackData,
+                                          std::shared_ptr<MemoryHandle> memoryHandle)
+{
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(
+    createRequestMem(endpoint,
+                     data::MemGet(buffer, length, remoteAddr, remoteKey, memoryHandle),
+                     enablePythonFuture,
+                     callbackFunction,
+                     callbackData));
+}
+
+std::shared_ptr<Request> Endpoint::memAtomic(ucp_atomic_op_t opcode,
+                                             uint64_t value,
+                                             uint64_t remoteAddr,
+                                             std::shared_ptr<RemoteKey> remoteKey,
+                                             const bool fetch,
+                                             const uint64_t compare,
+                                             const bool enablePythonFuture,
+                                             RequestCallbackUserFunction callbackFunction,
+                                             RequestCallbackUserData callbackData)
+{
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(
+    createRequestMem(endpoint,
+                     data::MemAtomic(opcode, value, remoteAddr, remoteKey, fetch, compare),
+                     enablePythonFuture,
+                     callbackFunction,
+                     callbackData));
+}
+
+std::shared_ptr<Request> Endpoint::flush(const bool enablePythonFuture,
+                                         RequestCallbackUserFunction callbackFunction,
+                                         RequestCallbackUserData callbackData)
+{
+  // Aggregated messages are only issued once their batch is submitted.
+  flushAmAggregation();
+
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(createRequestFlush(
+    endpoint, data::Flush(), enablePythonFuture, callbackFunction, callbackData));
+}
+
+std::shared_ptr<Request> Endpoint::closeAsync(const bool enablePythonFuture,
+                                              RequestCallbackUserFunction callbackFunction,
+                                              RequestCallbackUserData callbackData)
+{
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return createRequestEndpointClose(
+    endpoint, data::EndpointClose(), enablePythonFuture, callbackFunction, callbackData);
+}
+
+std::shared_ptr<RemoteKey> Endpoint::createRemoteKeyFromSerialized(
+  const std::string& serializedRemoteKey)
+{
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return ucxx::createRemoteKeyFromSerialized(endpoint, serializedRemoteKey);
 }
 
 std::shared_ptr<Request> Endpoint::streamSend(void* buffer,
                                               size_t length,
                                               const bool enablePythonFuture)
 {
-  auto endpoint = std::dynamic_pointer_cast<Endpoint>(shared_from_this());
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(
+    createRequestStream(endpoint, data::StreamSend(buffer, length), enablePythonFuture));
+}
+
+std::shared_ptr<Request> Endpoint::streamSendIov(const std::vector<void*>& buffer,
+                                                 const std::vector<size_t>& length,
+                                                 const bool enablePythonFuture)
+{
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
   return registerInflightRequest(
     createRequestStream(endpoint, data::StreamSend(buffer, length), enablePythonFuture));
 }
@@ -366,24 +1087,50 @@ std::shared_ptr<Request> Endpoint::streamRecv(void* buffer,
                                               size_t length,
                                               const bool enablePythonFuture)
 {
-  auto endpoint = std::dynamic_pointer_cast<Endpoint>(shared_from_this());
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
   return registerInflightRequest(
     createRequestStream(endpoint, data::StreamReceive(buffer, length), enablePythonFuture));
 }
 
+std::shared_ptr<Request> Endpoint::streamRecvPartial(void* buffer,
+                                                     size_t length,
+                                                     const bool enablePythonFuture)
+{
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(createRequestStream(
+    endpoint, data::StreamReceive(buffer, length, true), enablePythonFuture));
+}
+
+std::shared_ptr<StreamData> Endpoint::streamRecvData()
+{
+  if (_handle == nullptr) throw ucxx::Error("Endpoint is closed");
+
+  size_t length           = 0;
+  ucs_status_ptr_t status = nullptr;
+  getWorker()->invokeSerialized(
+    [this, &status, &length]() { status = ucp_stream_recv_data_nb(_handle, &length); });
+  if (status == nullptr) return nullptr;
+  utils::ucsErrorThrow(UCS_PTR_STATUS(status));
+
+  return createStreamData(std::static_pointer_cast<Endpoint>(shared_from_this()), status, length);
+}
+
 std::shared_ptr<Request> Endpoint::tagSend(void* buffer,
                                            size_t length,
                                            Tag tag,
                                            const bool enablePythonFuture,
                                            RequestCallbackUserFunction callbackFunction,
-                                           RequestCallbackUserData callbackData)
+                                           RequestCallbackUserData callbackData,
+                                           std::shared_ptr<MemoryHandle> memoryHandle,
+                                           RequestReadinessCallback readiness)
 {
-  auto endpoint = std::dynamic_pointer_cast<Endpoint>(shared_from_this());
-  return registerInflightRequest(createRequestTag(endpoint,
-                                                  data::TagSend(buffer, length, tag),
-                                                  enablePythonFuture,
-                                                  callbackFunction,
-                                                  callbackData));
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(
+    createRequestTag(endpoint,
+                     data::TagSend(buffer, length, tag, memoryHandle, readiness),
+                     enablePythonFuture,
+                     callbackFunction,
+                     callbackData));
 }
 
 std::shared_ptr<Request> Endpoint::tagRecv(void* buffer,
@@ -392,9 +1139,43 @@ std::shared_ptr<Request> Endpoint::tagRecv(void* buffer,
                                            TagMask tagMask,
                                            const bool enablePythonFuture,
                                            RequestCallbackUserFunction callbackFunction,
-                                           RequestCallbackUserData callbackData)
+                                           RequestCallbackUserData callbackData,
+                                           std::shared_ptr<MemoryHandle> memoryHandle)
 {
-  auto endpoint = std::dynamic_pointer_cast<Endpoint>(shared_from_this());
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(
+    createRequestTag(endpoint,
+                     data::TagReceive(buffer, length, tag, tagMask, memoryHandle),
+                     enablePythonFuture,
+                     callbackFunction,
+                     callbackData));
+}
+
+std::shared_ptr<Request> Endpoint::tagSendIov(const std::vector<void*>& buffer,
+                                              const std::vector<size_t>& length,
+                                              Tag tag,
+                                              const bool enablePythonFuture,
+                                              RequestCallbackUserFunction callbackFunction,
+                                              RequestCallbackUserData callbackData,
+                                              RequestReadinessCallback readiness)
+{
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(createRequestTag(endpoint,
+                                                  data::TagSend(buffer, length, tag, readiness),
+                                                  enablePythonFuture,
+                                                  callbackFunction,
+                                                  callbackData));
+}
+
+std::shared_ptr<Request> Endpoint::tagRecvIov(const std::vector<void*>& buffer,
+                                              const std::vector<size_t>& length,
+                                              Tag tag,
+                                              TagMask tagMask,
+                                              const bool enablePythonFuture,
+                                              RequestCallbackUserFunction callbackFunction,
+                                              RequestCallbackUserData callbackData)
+{
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
   return registerInflightRequest(createRequestTag(endpoint,
                                                   data::TagReceive(buffer, length, tag, tagMask),
                                                   enablePythonFuture,
@@ -402,33 +1183,179 @@ std::shared_ptr<Request> Endpoint::tagRecv(void* buffer,
                                                   callbackData));
 }
 
+static void checkBatchSizes(const std::vector<void*>& buffer,
+                            const std::vector<size_t>& length,
+                            const std::vector<Tag>& tag)
+{
+  if (length.size() != buffer.size() || tag.size() != buffer.size())
+    throw std::runtime_error("All input vectors should be of equal size");
+}
+
+std::vector<std::shared_ptr<Request>> Endpoint::tagSendBatch(
+  const std::vector<void*>& buffer,
+  const std::vector<size_t>& length,
+  const std::vector<Tag>& tag,
+  const bool enablePythonFuture,
+  RequestCallbackUserFunction callbackFunction,
+  RequestCallbackUserData callbackData)
+{
+  checkBatchSizes(buffer, length, tag);
+
+  std::vector<std::variant<data::TagSend, data::TagReceive>> requestData;
+  requestData.reserve(buffer.size());
+  for (size_t i = 0; i < buffer.size(); ++i)
+    requestData.emplace_back(data::TagSend(buffer[i], length[i], tag[i]));
+
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  auto requests = createRequestTagBatch(
+    endpoint, requestData, enablePythonFuture, callbackFunction, callbackData);
+  return registerInflightRequests({requests.begin(), requests.end()});
+}
+
+std::vector<std::shared_ptr<Request>> Endpoint::tagRecvBatch(
+  const std::vector<void*>& buffer,
+  const std::vector<size_t>& length,
+  const std::vector<Tag>& tag,
+  const TagMask tagMask,
+  const bool enablePythonFuture,
+  RequestCallbackUserFunction callbackFunction,
+  RequestCallbackUserData callbackData)
+{
+  checkBatchSizes(buffer, length, tag);
+
+  std::vector<std::variant<data::TagSend, data::TagReceive>> requestData;
+  requestData.reserve(buffer.size());
+  for (size_t i = 0; i < buffer.size(); ++i)
+    requestData.emplace_back(data::TagReceive(buffer[i], length[i], tag[i], tagMask));
+
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  auto requests = createRequestTagBatch(
+    endpoint, requestData, enablePythonFuture, callbackFunction, callbackData);
+  return registerInflightRequests({requests.begin(), requests.end()});
+}
+
 std::shared_ptr<Request> Endpoint::tagMultiSend(const std::vector<void*>& buffer,
                                                 const std::vector<size_t>& size,
                                                 const std::vector<int>& isCUDA,
                                                 const Tag tag,
-                                                const bool enablePythonFuture)
+                                                const bool enablePythonFuture,
+                                                const size_t packThreshold,
+                                                RequestReadinessCallback readiness)
 {
-  auto endpoint = std::dynamic_pointer_cast<Endpoint>(shared_from_this());
-  return registerInflightRequest(createRequestTagMulti(
-    endpoint, data::TagMultiSend(buffer, size, isCUDA, tag), enablePythonFuture));
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(
+    createRequestTagMulti(endpoint,
+                          data::TagMultiSend(buffer, size, isCUDA, tag, packThreshold, readiness),
+                          enablePythonFuture));
 }
 
 std::shared_ptr<Request> Endpoint::tagMultiRecv(const Tag tag,
                                                 const TagMask tagMask,
-                                                const bool enablePythonFuture)
+                                                const bool enablePythonFuture,
+                                                TagMultiRecvAllocatorType allocator)
 {
-  auto endpoint = std::dynamic_pointer_cast<Endpoint>(shared_from_this());
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(createRequestTagMulti(
+    endpoint, data::TagMultiReceive(tag, tagMask, allocator), enablePythonFuture));
+}
+
+std::shared_ptr<Request> Endpoint::fileSend(const std::string& path,
+                                            const Tag tag,
+                                            const bool enablePythonFuture,
+                                            const size_t chunkSize,
+                                            const size_t numBuffers)
+{
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
+  return registerInflightRequest(createRequestFile(
+    endpoint, data::FileSend(path, tag, chunkSize, numBuffers), enablePythonFuture));
+}
+
+std::shared_ptr<Request> Endpoint::fileRecv(const std::string& path,
+                                            const Tag tag,
+                                            const bool enablePythonFuture,
+                                            const size_t numBuffers)
+{
+  auto endpoint = std::static_pointer_cast<Endpoint>(shared_from_this());
   return registerInflightRequest(
-    createRequestTagMulti(endpoint, data::TagMultiReceive(tag, tagMask), enablePythonFuture));
+    createRequestFile(endpoint, data::FileReceive(path, tag, numBuffers), enablePythonFuture));
+}
+
+const std::shared_ptr<Worker>& Endpoint::getWorker() const { return _callbackData.worker; }
+
+Endpoint* Endpoint::asEndpoint() noexcept { return this; }
+
+EndpointStatistics Endpoint::getStatistics() const
+{
+  EndpointStatistics statistics{};
+  _requestCounters.fill(statistics);
+  return statistics;
 }
 
-std::shared_ptr<Worker> Endpoint::getWorker() { return ::ucxx::getWorker(_parent); }
+std::string Endpoint::getInfo()
+{
+  if (_handle == nullptr) throw ucxx::Error("Endpoint not initialized");
+
+  FILE* TextFileDescriptor = utils::createTextFileDescriptor();
+  getWorker()->invokeSerialized(
+    [this, TextFileDescriptor]() { ucp_ep_print_info(_handle, TextFileDescriptor); });
+  return utils::decodeTextFileDescriptor(TextFileDescriptor);
+}
+
+std::vector<EndpointTransport> Endpoint::getTransports()
+{
+  if (_handle == nullptr) throw ucxx::Error("Endpoint not initialized");
+
+  // Larger than the maximum number of lanes UCX configures for an endpoint.
+  std::vector<ucp_transport_entry_t> entries(64);
+
+  ucp_ep_attr_t attr{};
+  attr.field_mask             = UCP_EP_ATTR_FIELD_TRANSPORTS;
+  attr.transports.entries     = entries.data();
+  attr.transports.num_entries = entries.size();
+  attr.transports.entry_size  = sizeof(ucp_transport_entry_t);
+  getWorker()->invokeSerialized(
+    [this, &attr]() { utils::ucsErrorThrow(ucp_ep_query(_handle, &attr)); });
+
+  // Names are owned by UCX and only valid while the endpoint is alive.
+  std::vector<EndpointTransport> transports;
+  transports.reserve(attr.transports.num_entries);
+  for (unsigned i = 0; i < attr.transports.num_entries; ++i)
+    transports.push_back({entries[i].transport_name, entries[i].device_name});
+
+  return transports;
+}
+
+bool Endpoint::isIntraNode()
+{
+  static const std::unordered_set<std::string> intraNodeTransports{
+    "sysv", "posix", "cma", "knem", "xpmem", "cuda_ipc", "self"};
+
+  for (const auto& transport : getTransports())
+    if (intraNodeTransports.count(transport.transportName)) return true;
+
+  return false;
+}
+
+bool Endpoint::usesTransport(const std::vector<std::string>& transportNames)
+{
+  if (transportNames.empty()) return true;
+
+  for (const auto& transport : getTransports())
+    if (std::find(transportNames.begin(), transportNames.end(), transport.transportName) !=
+        transportNames.end())
+      return true;
+
+  return false;
+}
 
 void Endpoint::errorCallback(void* arg, ucp_ep_h ep, ucs_status_t status)
 {
   ErrorCallbackData* data = reinterpret_cast<ErrorCallbackData*>(arg);
   data->status            = status;
-  data->worker->scheduleRequestCancel(data->inflightRequests->release());
+  // Fail all requests at once, those awaiting submission would otherwise linger until
+  // submitted to the failed endpoint.
+  data->worker->abortInflightRequests(data->inflightRequests.release());
+  data->worker->evictCachedEndpoint(data);
   if (data->closeCallback) {
     ucxx_debug("ucxx::Endpoint::%s, UCP handle: %p, calling user close callback", __func__, ep);
     data->closeCallback(data->closeCallbackArg);
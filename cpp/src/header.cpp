@@ -3,10 +3,11 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include <algorithm>
-#include <iostream>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <memory>
-#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -14,68 +15,279 @@
 
 namespace ucxx {
 
-Header::Header(bool next, size_t nframes, int* isCUDA, size_t* size) : next{next}, nframes{nframes}
+/**
+ * The compact format starts with a version byte, which is never `0` or `1` as the `bool
+ * next` that starts the legacy fixed-size format, allowing both to be told apart, followed
+ * by a flags byte, the number of frames as a varint, a bitmap of CUDA frames, a bitmap of
+ * packed frames (if any), and the size of each frame as a varint. Headers with compressed
+ * frames are then followed by the codec byte, a bitmap of compressed frames and the
+ * compressed size of each compressed frame as a varint.
+ */
+static constexpr uint8_t compactVersion = 2;
+static constexpr uint8_t flagNext       = 0x1;
+static constexpr uint8_t flagPacked     = 0x2;
+static constexpr uint8_t flagCompressed = 0x4;
+static constexpr size_t maxVarintSize   = (sizeof(size_t) * 8 + 6) / 7;
+static constexpr size_t bitmapDataSize  = (HeaderFramesSize + 7) / 8;
+static constexpr size_t legacyDataSize =
+  sizeof(bool) + sizeof(size_t) + HeaderFramesSize * (sizeof(int) + sizeof(size_t));
+static constexpr size_t compactDataSize =
+  2 + maxVarintSize + 2 * bitmapDataSize + HeaderFramesSize * maxVarintSize;
+
+static bool hasPackedFrames(const Header& header)
+{
+  return std::any_of(header.isCUDA.begin(),
+                     header.isCUDA.begin() + header.nframes,
+                     [](int isCUDA) { return isCUDA == HeaderFramePacked; });
+}
+
+static bool hasCompressedFrames(const Header& header)
+{
+  return std::any_of(header.compressedSize.begin(),
+                     header.compressedSize.begin() + header.nframes,
+                     [](size_t compressedSize) { return compressedSize > 0; });
+}
+
+static size_t varintSize(size_t value)
+{
+  size_t n = 1;
+  for (; value >= 0x80; value >>= 7)
+    ++n;
+  return n;
+}
+
+static uint8_t* writeVarint(uint8_t* ptr, size_t value)
+{
+  for (; value >= 0x80; value >>= 7)
+    *ptr++ = static_cast<uint8_t>(value | 0x80);
+  *ptr++ = static_cast<uint8_t>(value);
+  return ptr;
+}
+
+static const uint8_t* readVarint(const uint8_t* ptr, const uint8_t* end, size_t& value)
+{
+  value = 0;
+  for (size_t shift = 0; ptr < end && shift < sizeof(size_t) * 8; shift += 7) {
+    const uint8_t byte = *ptr++;
+    value |= static_cast<size_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) return ptr;
+  }
+  throw std::runtime_error("Malformed serialized header.");
+}
+
+Header::Header(bool next,
+               size_t nframes,
+               int* isCUDA,
+               size_t* size,
+               size_t* compressedSize,
+               uint8_t compression)
+  : next{next}, nframes{nframes}, compressedSize{}, compression{compression}
 {
   std::copy(isCUDA, isCUDA + nframes, this->isCUDA.begin());
   std::copy(size, size + nframes, this->size.begin());
+  if (compressedSize != nullptr)
+    std::copy(compressedSize, compressedSize + nframes, this->compressedSize.begin());
   if (nframes < HeaderFramesSize) {
     std::fill(this->isCUDA.begin() + nframes, this->isCUDA.begin() + HeaderFramesSize, false);
     std::fill(this->size.begin() + nframes, this->size.begin() + HeaderFramesSize, 0);
   }
 }
 
-Header::Header(std::string serializedHeader) { deserialize(serializedHeader); }
+Header::Header(std::string serializedHeader)
+{
+  deserialize(serializedHeader.data(), serializedHeader.size());
+}
+
+Header::Header(const void* serializedHeader, const size_t length)
+{
+  deserialize(serializedHeader, length);
+}
+
+size_t Header::dataSize() { return std::max(legacyDataSize, compactDataSize); }
+
+// Headers with compressed frames can only be described by the compact format.
+static HeaderFormat getFormat(const Header& header, const HeaderFormat format)
+{
+  return hasCompressedFrames(header) ? HeaderFormat::Compact : format;
+}
+
+size_t Header::serializedSize(const HeaderFormat format) const
+{
+  if (getFormat(*this, format) == HeaderFormat::Legacy) return legacyDataSize;
+
+  const bool hasPacked    = hasPackedFrames(*this);
+  const size_t bitmapSize = (nframes + 7) / 8;
 
-size_t Header::dataSize() { return sizeof(next) + sizeof(nframes) + sizeof(isCUDA) + sizeof(size); }
+  size_t total = 2 + varintSize(nframes) + bitmapSize * (hasPacked ? 2 : 1);
+  for (size_t i = 0; i < nframes; ++i)
+    total += varintSize(size[i]);
+  if (hasCompressedFrames(*this)) {
+    total += 1 + bitmapSize;
+    for (size_t i = 0; i < nframes; ++i)
+      if (compressedSize[i] > 0) total += varintSize(compressedSize[i]);
+  }
+  return total;
+}
 
-const std::string Header::serialize() const
+size_t Header::serialize(void* buffer, const size_t length, const HeaderFormat format) const
 {
-  std::stringstream ss;
+  const size_t total = serializedSize(format);
+  if (length < total)
+    throw std::length_error("Buffer is too small to contain the serialized header");
+
+  if (getFormat(*this, format) == HeaderFormat::Legacy) {
+    // The layout `deserialize()` parses when the first byte is not `compactVersion`.
+    const uint8_t legacyNext = next;
+    uint8_t* ptr             = reinterpret_cast<uint8_t*>(buffer);
+    std::memcpy(ptr, &legacyNext, sizeof(bool));
+    std::memcpy(ptr + sizeof(bool), &nframes, sizeof(nframes));
+    std::memcpy(ptr + sizeof(bool) + sizeof(nframes), isCUDA.data(), sizeof(isCUDA));
+    std::memcpy(ptr + sizeof(bool) + sizeof(nframes) + sizeof(isCUDA), size.data(), sizeof(size));
+    return total;
+  }
+
+  const bool hasPacked     = hasPackedFrames(*this);
+  const bool hasCompressed = hasCompressedFrames(*this);
+  const size_t bitmapSize  = (nframes + 7) / 8;
+
+  const uint8_t flags =
+    (next ? flagNext : 0) | (hasPacked ? flagPacked : 0) | (hasCompressed ? flagCompressed : 0);
 
-  ss.write((char const*)&next, sizeof(next));
-  ss.write((char const*)&nframes, sizeof(nframes));
-  for (size_t i = 0; i < HeaderFramesSize; ++i)
-    ss.write((char const*)&isCUDA[i], sizeof(isCUDA[i]));
-  for (size_t i = 0; i < HeaderFramesSize; ++i)
-    ss.write((char const*)&size[i], sizeof(size[i]));
+  uint8_t* ptr = reinterpret_cast<uint8_t*>(buffer);
+  *ptr++       = compactVersion;
+  *ptr++       = flags;
+  ptr          = writeVarint(ptr, nframes);
 
-  return ss.str();
+  uint8_t* cudaBitmap   = ptr;
+  uint8_t* packedBitmap = ptr + bitmapSize;
+  std::memset(ptr, 0, bitmapSize * (hasPacked ? 2 : 1));
+  for (size_t i = 0; i < nframes; ++i) {
+    if (isCUDA[i] == HeaderFramePacked)
+      packedBitmap[i / 8] |= 1 << (i % 8);
+    else if (isCUDA[i])
+      cudaBitmap[i / 8] |= 1 << (i % 8);
+  }
+  ptr += bitmapSize * (hasPacked ? 2 : 1);
+
+  for (size_t i = 0; i < nframes; ++i)
+    ptr = writeVarint(ptr, size[i]);
+
+  if (hasCompressed) {
+    *ptr++                    = compression;
+    uint8_t* compressedBitmap = ptr;
+    std::memset(ptr, 0, bitmapSize);
+    ptr += bitmapSize;
+    for (size_t i = 0; i < nframes; ++i) {
+      if (compressedSize[i] == 0) continue;
+      compressedBitmap[i / 8] |= 1 << (i % 8);
+      ptr = writeVarint(ptr, compressedSize[i]);
+    }
+  }
+
+  return total;
 }
 
-void Header::deserialize(const std::string& serializedHeader)
+const std::string Header::serialize(const HeaderFormat format) const
 {
-  std::stringstream ss{serializedHeader};
-
-  ss.read(reinterpret_cast<char*>(&next), sizeof(next));
-  ss.read(reinterpret_cast<char*>(&nframes), sizeof(nframes));
-  for (size_t i = 0; i < HeaderFramesSize; ++i)
-    ss.read(reinterpret_cast<char*>(&isCUDA[i]), sizeof(isCUDA[i]));
-  for (size_t i = 0; i < HeaderFramesSize; ++i)
-    ss.read(reinterpret_cast<char*>(&size[i]), sizeof(size[i]));
+  std::string serialized(serializedSize(format), '\0');
+  serialize(serialized.data(), serialized.size(), format);
+  return serialized;
+}
+
+void Header::deserialize(const void* serializedHeader, const size_t length)
+{
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(serializedHeader);
+  const uint8_t* end = ptr + length;
+
+  if (length == 0) throw std::runtime_error("Malformed serialized header.");
+
+  compressedSize.fill(0);
+  compression = 0;
+
+  if (*ptr != compactVersion) {
+    // Legacy fixed-size format, as sent by senders without compact header support.
+    if (length < legacyDataSize) throw std::runtime_error("Malformed serialized header.");
+    uint8_t legacyNext = *ptr;
+    std::memcpy(&nframes, ptr + sizeof(bool), sizeof(nframes));
+    std::memcpy(isCUDA.data(), ptr + sizeof(bool) + sizeof(nframes), sizeof(isCUDA));
+    std::memcpy(size.data(), ptr + sizeof(bool) + sizeof(nframes) + sizeof(isCUDA), sizeof(size));
+    next = legacyNext != 0;
+    if (nframes > HeaderFramesSize) throw std::runtime_error("Malformed serialized header.");
+    return;
+  }
+
+  if (length < 2) throw std::runtime_error("Malformed serialized header.");
+  const uint8_t flags = ptr[1];
+  ptr                 = readVarint(ptr + 2, end, nframes);
+  if (nframes > HeaderFramesSize) throw std::runtime_error("Malformed serialized header.");
+  next = flags & flagNext;
+
+  const bool hasPacked    = flags & flagPacked;
+  const size_t bitmapSize = (nframes + 7) / 8;
+  if (static_cast<size_t>(end - ptr) < bitmapSize * (hasPacked ? 2 : 1))
+    throw std::runtime_error("Malformed serialized header.");
+
+  const uint8_t* cudaBitmap   = ptr;
+  const uint8_t* packedBitmap = ptr + bitmapSize;
+  for (size_t i = 0; i < nframes; ++i) {
+    if (hasPacked && (packedBitmap[i / 8] >> (i % 8)) & 1)
+      isCUDA[i] = HeaderFramePacked;
+    else
+      isCUDA[i] = (cudaBitmap[i / 8] >> (i % 8)) & 1;
+  }
+  ptr += bitmapSize * (hasPacked ? 2 : 1);
+
+  for (size_t i = 0; i < nframes; ++i)
+    ptr = readVarint(ptr, end, size[i]);
+
+  if (flags & flagCompressed) {
+    if (static_cast<size_t>(end - ptr) < 1 + bitmapSize)
+      throw std::runtime_error("Malformed serialized header.");
+    compression                     = *ptr++;
+    const uint8_t* compressedBitmap = ptr;
+    ptr += bitmapSize;
+    for (size_t i = 0; i < nframes; ++i)
+      if ((compressedBitmap[i / 8] >> (i % 8)) & 1) ptr = readVarint(ptr, end, compressedSize[i]);
+  }
+
+  std::fill(isCUDA.begin() + nframes, isCUDA.end(), 0);
+  std::fill(size.begin() + nframes, size.end(), 0);
 }
 
 std::vector<Header> Header::buildHeaders(const std::vector<size_t>& size,
-                                         const std::vector<int>& isCUDA)
+                                         const std::vector<int>& isCUDA,
+                                         const std::vector<size_t>& compressedSize,
+                                         const uint8_t compression)
 {
   const size_t totalFrames = size.size();
 
   if (isCUDA.size() != totalFrames)
     throw std::length_error("size and isCUDA must have the same length");
+  if (!compressedSize.empty() && compressedSize.size() != totalFrames)
+    throw std::length_error("size and compressedSize must have the same length");
 
-  const size_t totalHeaders = (totalFrames + HeaderFramesSize - 1) / HeaderFramesSize;
+  auto buildHeader = [&](size_t idx, size_t headerFrames) {
+    return Header(idx + headerFrames < totalFrames,
+                  headerFrames,
+                  const_cast<int*>(reinterpret_cast<const int*>(&isCUDA[idx])),
+                  const_cast<size_t*>(reinterpret_cast<const size_t*>(&size[idx])),
+                  compressedSize.empty() ? nullptr : const_cast<size_t*>(&compressedSize[idx]),
+                  compression);
+  };
 
   std::vector<Header> headers;
 
-  for (size_t i = 0; i < totalHeaders; ++i) {
-    bool hasNext = totalFrames > (i + 1) * HeaderFramesSize;
-    size_t headerFrames =
-      hasNext ? HeaderFramesSize : HeaderFramesSize - (HeaderFramesSize * (i + 1) - totalFrames);
+  for (size_t idx = 0; idx < totalFrames;) {
+    size_t headerFrames = std::min(HeaderFramesSize, totalFrames - idx);
+    auto header         = buildHeader(idx, headerFrames);
+
+    // Compressed sizes are only bounded by `dataSize()` as a whole, thus headers with many
+    // compressed frames of large sizes carry fewer frames so they never exceed it.
+    while (header.serializedSize(HeaderFormat::Compact) > dataSize())
+      header = buildHeader(idx, --headerFrames);
 
-    size_t idx = i * HeaderFramesSize;
-    headers.push_back(Header(hasNext,
-                             headerFrames,
-                             const_cast<int*>(reinterpret_cast<const int*>(&isCUDA[idx])),
-                             const_cast<size_t*>(reinterpret_cast<const size_t*>(&size[idx]))));
+    headers.push_back(header);
+    idx += headerFrames;
   }
 
   return headers;
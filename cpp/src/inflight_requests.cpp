@@ -2,7 +2,12 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include <ucxx/inflight_requests.h>
 #include <ucxx/log.h>
@@ -10,27 +15,140 @@
 
 namespace ucxx {
 
+InflightRequestsList::~InflightRequestsList()
+{
+  /**
+   * Dropping a reference may destroy the request and, in turn, its parent which may
+   * access other lists, therefore first unlink all requests and only then drop references.
+   */
+  std::vector<std::shared_ptr<Request>> requests;
+  requests.reserve(_size);
+  while (_head != nullptr)
+    requests.push_back(unlink(_head));
+}
+
+size_t InflightRequestsList::size() const { return _size; }
+
+std::shared_ptr<Request> InflightRequestsList::unlink(InflightRequestHook* hook)
+{
+  if (hook->prev != nullptr)
+    hook->prev->next = hook->next;
+  else
+    _head = hook->next;
+  if (hook->next != nullptr)
+    hook->next->prev = hook->prev;
+  else
+    _tail = hook->prev;
+
+  hook->prev = hook->next = nullptr;
+  --_size;
+  hook->owner.store(nullptr, std::memory_order_release);
+
+  return std::exchange(hook->request, nullptr);
+}
+
+void InflightRequestsList::insert(std::shared_ptr<Request> request)
+{
+  for (auto& hook : request->_inflightHooks)
+    if (hook.owner.load(std::memory_order_acquire) == this) return;
+
+  for (auto& hook : request->_inflightHooks) {
+    InflightRequestsList* expected = nullptr;
+    if (hook.owner.compare_exchange_strong(expected, this, std::memory_order_acq_rel)) {
+      hook.request = request;
+      hook.prev    = _tail;
+      hook.next    = nullptr;
+      if (_tail != nullptr)
+        _tail->next = &hook;
+      else
+        _head = &hook;
+      _tail = &hook;
+      ++_size;
+      return;
+    }
+  }
+
+  throw std::runtime_error("Request is already tracked by the maximum number of owners");
+}
+
+std::shared_ptr<Request> InflightRequestsList::remove(const Request* const request)
+{
+  for (auto& hook : const_cast<Request*>(request)->_inflightHooks)
+    if (hook.owner.load(std::memory_order_acquire) == this) return unlink(&hook);
+
+  return nullptr;
+}
+
+void InflightRequestsList::merge(InflightRequestsList& other)
+{
+  if (&other == this || other._head == nullptr) return;
+
+  for (auto hook = other._head; hook != nullptr; hook = hook->next)
+    hook->owner.store(this, std::memory_order_release);
+
+  other._head->prev = _tail;
+  if (_tail != nullptr)
+    _tail->next = other._head;
+  else
+    _head = other._head;
+  _tail = other._tail;
+  _size += other._size;
+
+  other._head = other._tail = nullptr;
+  other._size               = 0;
+}
+
 InflightRequests::~InflightRequests() { cancelAll(); }
 
-size_t InflightRequests::size() { return _trackedRequests->_inflight->size(); }
+size_t InflightRequests::size()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _trackedRequests == nullptr ? 0 : _trackedRequests->_inflight->size();
+}
+
+std::unique_lock<std::mutex> InflightRequests::lockForInsertion()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  // Loop in case the container is released by another thread after allocation and before
+  // reacquiring the lock.
+  while (_trackedRequests == nullptr) {
+    lock.unlock();
+    {
+      std::scoped_lock allocationLock{_cancelMutex, _mutex};
+      if (_trackedRequests == nullptr) _trackedRequests = std::make_unique<TrackedRequests>();
+    }
+    lock.lock();
+  }
+  return lock;
+}
 
 void InflightRequests::insert(std::shared_ptr<Request> request)
 {
-  std::lock_guard<std::mutex> lock(_mutex);
+  auto lock = lockForInsertion();
+
+  _trackedRequests->_inflight->insert(request);
+}
+
+void InflightRequests::insert(const std::vector<std::shared_ptr<Request>>& requests)
+{
+  auto lock = lockForInsertion();
 
-  _trackedRequests->_inflight->insert({request.get(), request});
+  for (const auto& request : requests)
+    _trackedRequests->_inflight->insert(request);
 }
 
 void InflightRequests::merge(TrackedRequestsPtr trackedRequests)
 {
-  {
-    std::lock_guard<std::mutex> lock(_mutex);
-    _trackedRequests->_inflight->merge(*(trackedRequests->_inflight));
-  }
-  {
-    std::lock_guard<std::mutex> lock(_cancelMutex);
-    _trackedRequests->_canceling->merge(*(trackedRequests->_canceling));
+  if (trackedRequests == nullptr) return;
+
+  std::scoped_lock lock{_cancelMutex, _mutex};
+  if (_trackedRequests == nullptr) {
+    _trackedRequests = std::move(trackedRequests);
+    return;
   }
+  _trackedRequests->_inflight->merge(*(trackedRequests->_inflight));
+  _trackedRequests->_canceling->merge(*(trackedRequests->_canceling));
 }
 
 void InflightRequests::remove(const Request* const request)
@@ -51,20 +169,16 @@ void InflightRequests::remove(const Request* const request)
     if (result == 0) {
       return;
     } else if (result == -1) {
-      auto search = _trackedRequests->_inflight->find(request);
-      decltype(search->second) tmpRequest;
-      if (search != _trackedRequests->_inflight->end()) {
-        /**
-         * If this is the last request to hold `std::shared_ptr<ucxx::Endpoint>` erasing it
-         * may cause the `ucxx::Endpoint`s destructor and subsequently the `close()` method
-         * to be called which will in turn call `cancelAll()` and attempt to take the
-         * mutexes. For this reason we should make a temporary copy of the request being
-         * erased from `_trackedRequests->_inflight` to allow unlocking the mutexes and only then
-         * destroy the object upon this method's return.
-         */
-        tmpRequest = search->second;
-        _trackedRequests->_inflight->erase(search);
-      }
+      /**
+       * If this is the last request to hold `std::shared_ptr<ucxx::Endpoint>` erasing it
+       * may cause the `ucxx::Endpoint`s destructor and subsequently the `close()` method
+       * to be called which will in turn call `cancelAll()` and attempt to take the
+       * mutexes. For this reason we should keep the reference to the request being
+       * removed from `_trackedRequests->_inflight` to allow unlocking the mutexes and only
+       * then destroy the object upon this method's return.
+       */
+      std::shared_ptr<Request> tmpRequest{nullptr};
+      if (_trackedRequests != nullptr) tmpRequest = _trackedRequests->_inflight->remove(request);
       _cancelMutex.unlock();
       _mutex.unlock();
       return;
@@ -78,16 +192,10 @@ size_t InflightRequests::dropCanceled()
 
   {
     std::scoped_lock lock{_cancelMutex};
-    for (auto it = _trackedRequests->_canceling->begin();
-         it != _trackedRequests->_canceling->end();) {
-      auto request = it->second;
-      if (request != nullptr && request->getStatus() != UCS_INPROGRESS) {
-        it = _trackedRequests->_canceling->erase(it);
-        ++removed;
-      } else {
-        ++it;
-      }
-    }
+    if (_trackedRequests == nullptr) return 0;
+    removed = _trackedRequests->_canceling->removeIf([](const std::shared_ptr<Request>& request) {
+      return request->getStatus() != UCS_INPROGRESS;
+    });
   }
 
   return removed;
@@ -99,36 +207,47 @@ size_t InflightRequests::getCancelingSize()
   size_t cancelingSize = 0;
   {
     std::scoped_lock lock{_cancelMutex};
-    cancelingSize = _trackedRequests->_canceling->size();
+    if (_trackedRequests != nullptr) cancelingSize = _trackedRequests->_canceling->size();
   }
 
   return cancelingSize;
 }
 
 size_t InflightRequests::cancelAll()
+{
+  return cancelAllWith([](const std::shared_ptr<Request>& request) { request->cancel(); });
+}
+
+size_t InflightRequests::abortAll()
+{
+  return cancelAllWith([](const std::shared_ptr<Request>& request) { request->abort(); });
+}
+
+size_t InflightRequests::cancelAllWith(
+  const std::function<void(const std::shared_ptr<Request>&)>& function)
 {
   decltype(_trackedRequests->_inflight) toCancel;
   size_t total;
   {
     std::scoped_lock lock{_cancelMutex, _mutex};
+    if (_trackedRequests == nullptr) return 0;
     total = _trackedRequests->_inflight->size();
 
-    // Fast path when no requests have been registered or the map has been
+    // Fast path when no requests have been registered or the list has been
     // previously released.
     if (total == 0) return 0;
 
-    toCancel = std::exchange(_trackedRequests->_inflight, std::make_unique<InflightRequestsMap>());
+    toCancel = std::exchange(_trackedRequests->_inflight, std::make_unique<InflightRequestsList>());
   }
 
   ucxx_debug("ucxx::InflightRequests::%s, canceling %lu requests", __func__, total);
 
-  for (auto& r : *toCancel) {
-    auto request = r.second;
-    if (request != nullptr) { request->cancel(); }
-  }
+  toCancel->forEach(function);
 
   {
     std::scoped_lock lock{_cancelMutex, _mutex};
+    // The container may have been released while canceling.
+    if (_trackedRequests == nullptr) _trackedRequests = std::make_unique<TrackedRequests>();
     _trackedRequests->_canceling->merge(*toCancel);
   }
   dropCanceled();
@@ -140,7 +259,7 @@ TrackedRequestsPtr InflightRequests::release()
 {
   std::scoped_lock lock{_cancelMutex, _mutex};
 
-  return std::exchange(_trackedRequests, std::make_unique<TrackedRequests>());
+  return std::exchange(_trackedRequests, nullptr);
 }
 
 }  // namespace ucxx
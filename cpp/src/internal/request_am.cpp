@@ -2,6 +2,9 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <string>
+#include <utility>
+
 #include <ucxx/buffer.h>
 #include <ucxx/delayed_submission.h>
 #include <ucxx/internal/request_am.h>
@@ -14,11 +17,15 @@ namespace internal {
 RecvAmMessage::RecvAmMessage(internal::AmData* amData,
                              ucp_ep_h ep,
                              std::shared_ptr<RequestAm> request,
-                             std::shared_ptr<Buffer> buffer)
+                             std::shared_ptr<Buffer> buffer,
+                             std::string header)
   : _amData(amData), _ep(ep), _request(request)
 {
   std::visit(data::dispatch{
-               [this, buffer](data::AmReceive& amReceive) { amReceive._buffer = buffer; },
+               [this, buffer, &header](data::AmReceive& amReceive) {
+                 amReceive._buffer = buffer;
+                 amReceive._header = std::move(header);
+               },
                [](auto) { throw std::runtime_error("Unreachable"); },
              },
              _request->_requestData);
@@ -31,6 +38,7 @@ void RecvAmMessage::callback(void* request, ucs_status_t status)
   std::visit(data::dispatch{
                [this, request, status](data::AmReceive amReceive) {
                  _request->callback(request, status);
+                 if (_amData->_receiverCallback) _amData->_receiverCallback(_request);
                  {
                    std::lock_guard<std::mutex> lock(_amData->_mutex);
                    _amData->_recvAmMessageMap.erase(_request.get());
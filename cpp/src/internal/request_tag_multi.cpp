@@ -0,0 +1,47 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <functional>
+#include <mutex>
+#include <utility>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/internal/request_tag_multi.h>
+
+namespace ucxx {
+
+namespace internal {
+
+void TagMultiPrepostedHeader::complete(ucs_status_t status)
+{
+  std::function<void(ucs_status_t)> callback{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _completed = true;
+    _status    = status;
+    callback   = std::exchange(_callback, nullptr);
+  }
+
+  if (callback) callback(status);
+}
+
+void TagMultiPrepostedHeader::adopt(std::function<void(ucs_status_t)> callback)
+{
+  ucs_status_t status = UCS_INPROGRESS;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_completed) {
+      _callback = std::move(callback);
+      return;
+    }
+    status = _status;
+  }
+
+  callback(status);
+}
+
+}  // namespace internal
+
+}  // namespace ucxx
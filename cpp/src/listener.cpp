@@ -2,11 +2,16 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <netinet/in.h>
+#include <stdexcept>
 #include <string>
 #include <ucp/api/ucp.h>
+#include <vector>
 
+#include <ucxx/endpoint.h>
 #include <ucxx/exception.h>
 #include <ucxx/listener.h>
 #include <ucxx/utils/callback_notifier.h>
@@ -18,11 +23,18 @@ namespace ucxx {
 Listener::Listener(std::shared_ptr<Worker> worker,
                    uint16_t port,
                    ucp_listener_conn_callback_t callback,
-                   void* callbackArgs)
+                   void* callbackArgs,
+                   size_t backlog)
+  : _backlog{backlog}
 {
   if (worker == nullptr || worker->getHandle() == nullptr)
     throw ucxx::Error("Worker not initialized");
 
+  if (_backlog > 0) {
+    callback     = Listener::queueConnRequestCallback;
+    callbackArgs = this;
+  }
+
   ucp_listener_params_t params = {
     .field_mask   = UCP_LISTENER_PARAM_FIELD_SOCK_ADDR | UCP_LISTENER_PARAM_FIELD_CONN_HANDLER,
     .conn_handler = {.cb = callback, .arg = callbackArgs}};
@@ -30,11 +42,12 @@ Listener::Listener(std::shared_ptr<Worker> worker,
   params.sockaddr.addr    = info->ai_addr;
   params.sockaddr.addrlen = info->ai_addrlen;
 
-  utils::ucsErrorThrow(ucp_listener_create(worker->getHandle(), &params, &_handle));
-  ucxx_trace("ucxx::Listener created: %p, UCP handle: %p", this, _handle);
-
   ucp_listener_attr_t attr = {.field_mask = UCP_LISTENER_ATTR_FIELD_SOCKADDR};
-  utils::ucsErrorThrow(ucp_listener_query(_handle, &attr));
+  worker->invokeSerialized([this, &worker, &params, &attr]() {
+    utils::ucsErrorThrow(ucp_listener_create(worker->getHandle(), &params, &_handle));
+    utils::ucsErrorThrow(ucp_listener_query(_handle, &attr));
+  });
+  ucxx_trace("ucxx::Listener created: %p, UCP handle: %p", this, _handle);
 
   char ipString[INET6_ADDRSTRLEN];
   char portString[INET6_ADDRSTRLEN];
@@ -53,6 +66,7 @@ Listener::~Listener()
   if (worker->isProgressThreadRunning()) {
     utils::CallbackNotifier callbackNotifierPre{};
     worker->registerGenericPre([this, &callbackNotifierPre]() {
+      rejectConnRequests();
       ucp_listener_destroy(_handle);
       callbackNotifierPre.set();
     });
@@ -62,6 +76,7 @@ Listener::~Listener()
     worker->registerGenericPost([&callbackNotifierPost]() { callbackNotifierPost.set(); });
     callbackNotifierPost.wait(10000000000 /* 10s */);
   } else {
+    rejectConnRequests();
     ucp_listener_destroy(_handle);
     worker->progress();
   }
@@ -77,6 +92,37 @@ std::shared_ptr<Listener> createListener(std::shared_ptr<Worker> worker,
   return std::shared_ptr<Listener>(new Listener(worker, port, callback, callbackArgs));
 }
 
+std::shared_ptr<Listener> createListener(std::shared_ptr<Worker> worker,
+                                         uint16_t port,
+                                         size_t backlog)
+{
+  if (backlog == 0) throw std::invalid_argument("Listener backlog must be greater than 0");
+
+  return std::shared_ptr<Listener>(new Listener(worker, port, nullptr, nullptr, backlog));
+}
+
+void Listener::queueConnRequestCallback(ucp_conn_request_h connRequest, void* arg)
+{
+  auto listener = reinterpret_cast<Listener*>(arg);
+
+  std::lock_guard<std::mutex> lock(listener->_connRequestsMutex);
+  ++listener->_statistics.connectionRequestsReceived;
+  if (listener->_connRequests.size() >= listener->_backlog) {
+    ++listener->_statistics.connectionRequestsRejected;
+    ucxx_debug("ucxx::Listener::%s, Listener: %p, backlog of %lu full, rejecting: %p",
+               __func__,
+               listener,
+               listener->_backlog,
+               connRequest);
+    ucp_listener_reject(listener->_handle, connRequest);
+    return;
+  }
+
+  listener->_connRequests.push_back(connRequest);
+  listener->_statistics.maxQueueDepth =
+    std::max<uint64_t>(listener->_statistics.maxQueueDepth, listener->_connRequests.size());
+}
+
 std::shared_ptr<Endpoint> Listener::createEndpointFromConnRequest(ucp_conn_request_h connRequest,
                                                                   bool endpointErrorHandling)
 {
@@ -85,6 +131,49 @@ std::shared_ptr<Endpoint> Listener::createEndpointFromConnRequest(ucp_conn_reque
   return endpoint;
 }
 
+std::vector<std::shared_ptr<Endpoint>> Listener::acceptEndpoints(size_t maxEndpoints,
+                                                                 bool endpointErrorHandling)
+{
+  if (_backlog == 0)
+    throw std::runtime_error("Listener was not created with a connection request backlog");
+
+  std::vector<ucp_conn_request_h> connRequests;
+  {
+    std::lock_guard<std::mutex> lock(_connRequestsMutex);
+    auto count = std::min(maxEndpoints, _connRequests.size());
+    connRequests.assign(_connRequests.begin(), _connRequests.begin() + count);
+    _connRequests.erase(_connRequests.begin(), _connRequests.begin() + count);
+    _statistics.connectionRequestsAccepted += count;
+  }
+  if (connRequests.empty()) return {};
+
+  auto listener = std::dynamic_pointer_cast<Listener>(shared_from_this());
+  return ucxx::createEndpointsFromConnRequests(listener, connRequests, endpointErrorHandling);
+}
+
+size_t Listener::getPendingConnectionRequests()
+{
+  std::lock_guard<std::mutex> lock(_connRequestsMutex);
+  return _connRequests.size();
+}
+
+ListenerStatistics Listener::getStatistics()
+{
+  std::lock_guard<std::mutex> lock(_connRequestsMutex);
+  auto statistics       = _statistics;
+  statistics.queueDepth = _connRequests.size();
+  return statistics;
+}
+
+void Listener::rejectConnRequests()
+{
+  std::lock_guard<std::mutex> lock(_connRequestsMutex);
+  for (const auto& connRequest : _connRequests)
+    ucp_listener_reject(_handle, connRequest);
+  _statistics.connectionRequestsRejected += _connRequests.size();
+  _connRequests.clear();
+}
+
 ucp_listener_h Listener::getHandle() { return _handle; }
 
 uint16_t Listener::getPort() { return _port; }
@@ -26,12 +26,18 @@ void parseLogLevel()
       });
 
     auto level = logLevelNames.find(logLevelName);
-    if (!logLevelName.empty() && level != logLevelNames.end())
+    if (!logLevelName.empty() && level != logLevelNames.end()) {
       ucxx_log_component_config.log_level = (ucs_log_level_t)level->second;
-    else
+      if (!ucxx_log_level_is_compiled(level->second) && level->second < UCXX_LOG_LEVEL_LAST)
+        ucxx_warn(
+          "UCXX_LOG_LEVEL %s is more verbose than the maximum log level UCXX was built with, "
+          "see the UCXX_MAX_LOG_LEVEL CMake option",
+          logLevelName.c_str());
+    } else {
       ucxx_warn("UCXX_LOG_LEVEL %s unknown, defaulting to UCXX_LOG_LEVEL=%s",
                 logLevelName.c_str(),
                 logLevelNameDefault);
+    }
 
     ucxx_info("UCXX_LOG_LEVEL: %s", logLevelName.c_str());
   }
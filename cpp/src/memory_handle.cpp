@@ -0,0 +1,93 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <cstdint>
+#include <memory>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/log.h>
+#include <ucxx/memory_handle.h>
+#include <ucxx/remote_key.h>
+#include <ucxx/utils/ucx.h>
+
+namespace ucxx {
+
+MemoryHandle::MemoryHandle(std::shared_ptr<Context> context,
+                           const size_t size,
+                           void* buffer,
+                           const ucs_memory_type_t memoryType)
+{
+  ucp_mem_map_params_t params = {.field_mask = UCP_MEM_MAP_PARAM_FIELD_ADDRESS |
+                                               UCP_MEM_MAP_PARAM_FIELD_LENGTH |
+                                               UCP_MEM_MAP_PARAM_FIELD_FLAGS,
+                                 .address = buffer,
+                                 .length  = size,
+                                 .flags   = buffer == nullptr ? UCP_MEM_MAP_ALLOCATE : 0u};
+
+  if (memoryType != UCS_MEMORY_TYPE_UNKNOWN) {
+    params.field_mask |= UCP_MEM_MAP_PARAM_FIELD_MEMORY_TYPE;
+    params.memory_type = memoryType;
+  }
+
+  utils::ucsErrorThrow(ucp_mem_map(context->getHandle(), &params, &_handle));
+
+  ucp_mem_attr_t attr = {.field_mask = UCP_MEM_ATTR_FIELD_ADDRESS | UCP_MEM_ATTR_FIELD_LENGTH |
+                                       UCP_MEM_ATTR_FIELD_MEM_TYPE};
+  auto status         = ucp_mem_query(_handle, &attr);
+  if (status != UCS_OK) {
+    ucp_mem_unmap(context->getHandle(), _handle);
+    utils::ucsErrorThrow(status);
+  }
+
+  _baseAddress = attr.address;
+  _size        = attr.length;
+  _memoryType  = attr.mem_type;
+
+  ucxx_trace("ucxx::MemoryHandle created: %p, UCP handle: %p, base address: %p, size: %lu",
+             this,
+             _handle,
+             _baseAddress,
+             _size);
+
+  setParent(context);
+}
+
+MemoryHandle::~MemoryHandle()
+{
+  auto context = std::dynamic_pointer_cast<Context>(getParent());
+  ucp_mem_unmap(context->getHandle(), _handle);
+  ucxx_trace("ucxx::MemoryHandle destroyed: %p, UCP handle: %p", this, _handle);
+}
+
+std::shared_ptr<MemoryHandle> createMemoryHandle(std::shared_ptr<Context> context,
+                                                 const size_t size,
+                                                 void* buffer,
+                                                 const ucs_memory_type_t memoryType)
+{
+  return std::shared_ptr<MemoryHandle>(new MemoryHandle(context, size, buffer, memoryType));
+}
+
+ucp_mem_h MemoryHandle::getHandle() const { return _handle; }
+
+void* MemoryHandle::getBaseAddress() const { return _baseAddress; }
+
+size_t MemoryHandle::getSize() const { return _size; }
+
+ucs_memory_type_t MemoryHandle::getMemoryType() const { return _memoryType; }
+
+bool MemoryHandle::contains(const void* buffer, const size_t length) const
+{
+  auto begin = reinterpret_cast<uintptr_t>(_baseAddress);
+  auto ptr   = reinterpret_cast<uintptr_t>(buffer);
+  return ptr >= begin && length <= _size && ptr - begin <= _size - length;
+}
+
+std::shared_ptr<RemoteKey> MemoryHandle::createRemoteKey()
+{
+  auto memoryHandle = std::dynamic_pointer_cast<MemoryHandle>(shared_from_this());
+  return createRemoteKeyFromMemoryHandle(memoryHandle);
+}
+
+}  // namespace ucxx
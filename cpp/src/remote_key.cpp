@@ -0,0 +1,116 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/endpoint.h>
+#include <ucxx/log.h>
+#include <ucxx/remote_key.h>
+#include <ucxx/utils/ucx.h>
+#include <ucxx/worker.h>
+
+namespace ucxx {
+
+static constexpr size_t serializedHeaderSize = sizeof(uint64_t) + sizeof(uint64_t);
+
+RemoteKey::RemoteKey(std::shared_ptr<MemoryHandle> memoryHandle)
+  : _memoryBaseAddress(reinterpret_cast<uint64_t>(memoryHandle->getBaseAddress())),
+    _memorySize(memoryHandle->getSize())
+{
+  auto context = std::dynamic_pointer_cast<Context>(memoryHandle->getParent());
+
+  void* packedRemoteKey      = nullptr;
+  size_t packedRemoteKeySize = 0;
+  utils::ucsErrorThrow(ucp_rkey_pack(
+    context->getHandle(), memoryHandle->getHandle(), &packedRemoteKey, &packedRemoteKeySize));
+  _packedRemoteKey = std::string(reinterpret_cast<char*>(packedRemoteKey), packedRemoteKeySize);
+  ucp_rkey_buffer_release(packedRemoteKey);
+
+  ucxx_trace("ucxx::RemoteKey created (packed): %p, base address: 0x%lx, size: %lu",
+             this,
+             _memoryBaseAddress,
+             _memorySize);
+
+  setParent(memoryHandle);
+}
+
+RemoteKey::RemoteKey(std::shared_ptr<Endpoint> endpoint, const std::string& serializedRemoteKey)
+{
+  if (serializedRemoteKey.size() <= serializedHeaderSize)
+    throw std::runtime_error("Serialized remote key is malformed.");
+
+  uint64_t memorySize = 0;
+  std::memcpy(&_memoryBaseAddress, serializedRemoteKey.data(), sizeof(_memoryBaseAddress));
+  std::memcpy(&memorySize, serializedRemoteKey.data() + sizeof(uint64_t), sizeof(memorySize));
+  _memorySize      = memorySize;
+  _packedRemoteKey = serializedRemoteKey.substr(serializedHeaderSize);
+
+  endpoint->getWorker()->invokeSerialized([this, &endpoint]() {
+    utils::ucsErrorThrow(
+      ucp_ep_rkey_unpack(endpoint->getHandle(), _packedRemoteKey.data(), &_remoteKey));
+  });
+
+  ucxx_trace(
+    "ucxx::RemoteKey created (unpacked): %p, UCP handle: %p, base address: 0x%lx, size: %lu",
+    this,
+    _remoteKey,
+    _memoryBaseAddress,
+    _memorySize);
+
+  setParent(endpoint);
+}
+
+RemoteKey::~RemoteKey()
+{
+  if (_remoteKey != nullptr) {
+    auto endpoint = std::dynamic_pointer_cast<Endpoint>(getParent());
+    // The rkey was unpacked on the endpoint, which must outlive a deferred destruction.
+    endpoint->getWorker()->scheduleSerialized(
+      [endpoint, remoteKey = _remoteKey]() { ucp_rkey_destroy(remoteKey); });
+  }
+  ucxx_trace("ucxx::RemoteKey destroyed: %p, UCP handle: %p", this, _remoteKey);
+}
+
+std::shared_ptr<RemoteKey> createRemoteKeyFromMemoryHandle(
+  std::shared_ptr<MemoryHandle> memoryHandle)
+{
+  return std::shared_ptr<RemoteKey>(new RemoteKey(memoryHandle));
+}
+
+std::shared_ptr<RemoteKey> createRemoteKeyFromSerialized(std::shared_ptr<Endpoint> endpoint,
+                                                         const std::string& serializedRemoteKey)
+{
+  return std::shared_ptr<RemoteKey>(new RemoteKey(endpoint, serializedRemoteKey));
+}
+
+ucp_rkey_h RemoteKey::getHandle() const { return _remoteKey; }
+
+uint64_t RemoteKey::getBaseAddress() const { return _memoryBaseAddress; }
+
+size_t RemoteKey::getSize() const { return _memorySize; }
+
+bool RemoteKey::contains(const uint64_t remoteAddress, const size_t length) const
+{
+  return remoteAddress >= _memoryBaseAddress && length <= _memorySize &&
+         remoteAddress - _memoryBaseAddress <= _memorySize - length;
+}
+
+std::string RemoteKey::serialize() const
+{
+  const uint64_t memorySize = _memorySize;
+
+  std::string serialized(serializedHeaderSize, '\0');
+  std::memcpy(serialized.data(), &_memoryBaseAddress, sizeof(_memoryBaseAddress));
+  std::memcpy(serialized.data() + sizeof(uint64_t), &memorySize, sizeof(memorySize));
+  serialized.append(_packedRemoteKey);
+  return serialized;
+}
+
+}  // namespace ucxx
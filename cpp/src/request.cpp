@@ -4,14 +4,22 @@
  */
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
+#include <variant>
 
 #include <ucp/api/ucp.h>
 
+#include <ucxx/completion_executor.h>
 #include <ucxx/component.h>
 #include <ucxx/endpoint.h>
 #include <ucxx/typedefs.h>
+#include <ucxx/utils/cuda.h>
+#include <ucxx/utils/nvtx.h>
 #include <ucxx/utils/ucx.h>
 
 namespace ucxx {
@@ -24,41 +32,75 @@ Request::Request(std::shared_ptr<Component> endpointOrWorker,
     _operationName(operationName),
     _enablePythonFuture(enablePythonFuture)
 {
-  _endpoint = std::dynamic_pointer_cast<Endpoint>(endpointOrWorker);
-  _worker =
-    _endpoint ? _endpoint->getWorker() : std::dynamic_pointer_cast<Worker>(endpointOrWorker);
+  // Resolve the component type without RTTI, sharing ownership with `endpointOrWorker`.
+  Component* component = endpointOrWorker.get();
+  if (Endpoint* endpoint = component ? component->asEndpoint() : nullptr) {
+    _endpoint = std::shared_ptr<Endpoint>(endpointOrWorker, endpoint);
+    _worker   = endpoint->getWorker();
+  } else if (Worker* worker = component ? component->asWorker() : nullptr) {
+    _worker = std::shared_ptr<Worker>(endpointOrWorker, worker);
+  }
 
   if (_worker == nullptr || _worker->getHandle() == nullptr)
     throw ucxx::Error("Worker not initialized");
   if (_endpoint != nullptr && _endpoint->getHandle() == nullptr)
     throw ucxx::Error("Endpoint not initialized");
 
+  // Sends may await the data to be ready before they are submitted.
+  std::visit(data::dispatch{
+               [this](const data::AmSend& amSend) { _readiness = amSend._readiness; },
+               [this](const data::TagSend& tagSend) { _readiness = tagSend._readiness; },
+               [](const auto&) {},
+             },
+             _requestData);
+
+  _worker->_requestCounters.submitted();
+  if (_endpoint != nullptr) _endpoint->_requestCounters.submitted();
+
+  if (_worker->_trafficCapture.isEnabled() &&
+      (_endpoint == nullptr || _endpoint->isTrafficCaptureEnabled()))
+    _worker->_trafficCapture.record(_requestData, _endpoint.get());
+
+  if (_worker->_requestTracer.sample()) {
+    _trace                = std::make_unique<RequestTrace>();
+    _trace->operationName = _operationName;
+    _trace->created       = RequestTracer::now();
+  }
+
   _enablePythonFuture &= _worker->isFutureEnabled();
   if (_enablePythonFuture) {
     _future = _worker->getFuture();
-    ucxx_trace_req_f(
-      _ownerString.c_str(), this, _request, _operationName.c_str(), "future: %p", _future.get());
+    ucxx_trace_req_f(getOwnerString().c_str(),
+                     this,
+                     _request,
+                     _operationName.c_str(),
+                     "future: %p",
+                     _future.get());
   }
 
-  std::stringstream ss;
-
   if (_endpoint) {
     setParent(_endpoint);
-    ss << "ucxx::Endpoint: " << _endpoint->getHandle();
     ucxx_trace("ucxx::Request created (%s): %p on ucxx::Endpoint: %p",
                _operationName.c_str(),
                this,
                _endpoint.get());
   } else {
     setParent(_worker);
-    ss << "ucxx::Worker: " << _worker->getHandle();
     ucxx_trace("ucxx::Request created (%s): %p on ucxx::Worker: %p",
                _operationName.c_str(),
                this,
                _worker.get());
   }
+}
 
-  _ownerString = ss.str();
+std::shared_ptr<utils::MemoryPool> Request::getRequestMemoryPool(
+  std::shared_ptr<Component> endpointOrWorker)
+{
+  if (endpointOrWorker == nullptr) return nullptr;
+  if (auto endpoint = endpointOrWorker->asEndpoint())
+    return endpoint->getWorker()->getRequestMemoryPool();
+  if (auto worker = endpointOrWorker->asWorker()) return worker->getRequestMemoryPool();
+  return nullptr;
 }
 
 Request::~Request()
@@ -68,11 +110,29 @@ Request::~Request()
 
 void Request::cancel()
 {
+  // Only the progress thread may access a worker in serialized thread mode, where the
+  // request is canceled unless it completed in the meantime.
+  if (_worker->requiresSerializedAccess()) {
+    _worker->registerGenericPre(
+      [request = std::static_pointer_cast<Request>(shared_from_this())]() { request->cancel(); });
+    return;
+  }
+
   std::lock_guard<std::recursive_mutex> lock(_mutex);
-  if (_status == UCS_INPROGRESS) {
+  // Not submitted yet, the worker discards it once it finds it no longer awaits readiness.
+  if (_awaitingReadiness) {
+    ucxx_trace_req_f(
+      getOwnerString().c_str(), this, _request, _operationName.c_str(), "canceling unsubmitted");
+    _awaitingReadiness = false;
+    callback(nullptr, UCS_ERR_CANCELED);
+    return;
+  }
+
+  ucs_status_t currentStatus = _status.load(std::memory_order_acquire);
+  if (currentStatus == UCS_INPROGRESS) {
     if (UCS_PTR_IS_ERR(_request)) {
       ucs_status_t status = UCS_PTR_STATUS(_request);
-      ucxx_trace_req_f(_ownerString.c_str(),
+      ucxx_trace_req_f(getOwnerString().c_str(),
                        this,
                        _request,
                        _operationName.c_str(),
@@ -80,24 +140,113 @@ void Request::cancel()
                        status,
                        ucs_status_string(status));
     } else {
-      ucxx_trace_req_f(_ownerString.c_str(), this, _request, _operationName.c_str(), "canceling");
+      ucxx_trace_req_f(
+        getOwnerString().c_str(), this, _request, _operationName.c_str(), "canceling");
       if (_request != nullptr) ucp_request_cancel(_worker->getHandle(), _request);
     }
   } else {
-    ucxx_trace_req_f(_ownerString.c_str(),
+    ucxx_trace_req_f(getOwnerString().c_str(),
                      this,
                      _request,
                      _operationName.c_str(),
                      "already completed with status: %d (%s)",
-                     _status,
-                     ucs_status_string(_status));
+                     currentStatus,
+                     ucs_status_string(currentStatus));
+  }
+}
+
+void Request::abort()
+{
+  if (_worker->requiresSerializedAccess()) {
+    _worker->registerGenericPre(
+      [request = std::static_pointer_cast<Request>(shared_from_this())]() { request->abort(); });
+    return;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(_mutex);
+  if (_status.load(std::memory_order_acquire) != UCS_INPROGRESS) return;
+
+  // Submitted to UCX, only UCX may complete it once the cancelation is processed.
+  if (_submitted) {
+    cancel();
+    return;
+  }
+
+  ucxx_trace_req_f(
+    getOwnerString().c_str(), this, _request, _operationName.c_str(), "aborting unsubmitted");
+  // The worker discards it once it finds it no longer awaits readiness, while delayed
+  // submissions and aggregated messages are discarded as the request already completed.
+  _awaitingReadiness = false;
+  _aborted           = true;
+  setStatus(UCS_ERR_CANCELED);
+}
+
+void Request::setDeadline(std::chrono::steady_clock::time_point deadline)
+{
+  if (isCompleted()) return;
+
+  _worker->scheduleRequestDeadline(std::static_pointer_cast<Request>(shared_from_this()),
+                                   deadline);
+}
+
+void Request::setTimeout(uint64_t timeout)
+{
+  setDeadline(std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout));
+}
+
+void Request::setCompletionFlag(uint32_t* flag, uint32_t value)
+{
+  if (flag == nullptr) throw std::invalid_argument("The completion flag must not be null");
+  if (utils::getPointerMemoryType(flag) == UCS_MEMORY_TYPE_CUDA)
+    throw std::invalid_argument(
+      "Completion flags in device memory require ucxx::utils::cudaCompletionFlag()");
+
+  // Release semantics make the received data visible before the flag to host waiters.
+  setCompletionFlag([flag](uint32_t word) { __atomic_store_n(flag, word, __ATOMIC_RELEASE); },
+                    value);
+}
+
+void Request::setCompletionFlag(RequestCompletionFlagWriter writer, uint32_t value)
+{
+  if (value & CompletionFlagError)
+    throw std::invalid_argument("The completion value must not have the error bit set");
+
+  std::lock_guard<std::recursive_mutex> lock(_mutex);
+  if (_completionFlagSet) throw std::runtime_error("A completion flag was already set");
+
+  _completionFlagWriter = std::move(writer);
+  _completionFlagValue  = value;
+  _completionFlagSet    = true;
+
+  // Requests completing before the flag is set write it immediately.
+  ucs_status_t status = _status.load(std::memory_order_acquire);
+  if (status != UCS_INPROGRESS) writeCompletionFlag(status);
+}
+
+void Request::writeCompletionFlag(ucs_status_t status)
+{
+  RequestCompletionFlagWriter writer{nullptr};
+  {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    writer = std::exchange(_completionFlagWriter, nullptr);
   }
+  if (!writer) return;
+
+  writer(status == UCS_OK ? _completionFlagValue : (_completionFlagValue | CompletionFlagError));
 }
 
-ucs_status_t Request::getStatus()
+bool Request::startSubmission()
 {
   std::lock_guard<std::recursive_mutex> lock(_mutex);
-  return _status;
+  if (_status.load(std::memory_order_acquire) != UCS_INPROGRESS) return false;
+  _submitted = true;
+  return true;
+}
+
+ucs_status_t Request::getStatus() noexcept
+{
+  return _completed.load(std::memory_order_acquire) ? _status.load(std::memory_order_relaxed)
+                                                    : UCS_INPROGRESS;
 }
 
 void* Request::getFuture()
@@ -108,17 +257,27 @@ void* Request::getFuture()
 
 void Request::checkError()
 {
-  std::lock_guard<std::recursive_mutex> lock(_mutex);
+  // The status message is written before the status is published.
+  ucs_status_t status = _status.load(std::memory_order_acquire);
 
-  utils::ucsErrorThrow(_status, _status == UCS_ERR_MESSAGE_TRUNCATED ? _status_msg : std::string());
+  utils::ucsErrorThrow(status, status == UCS_ERR_MESSAGE_TRUNCATED ? _status_msg : std::string());
 }
 
-bool Request::isCompleted()
+ucs_status_t Request::getError(std::string* message) noexcept
 {
-  std::lock_guard<std::recursive_mutex> lock(_mutex);
-  return _status != UCS_INPROGRESS;
+  // The status message is written before the status is published.
+  ucs_status_t status = _status.load(std::memory_order_acquire);
+
+  if (message != nullptr && status != UCS_OK && status != UCS_INPROGRESS)
+    *message = status == UCS_ERR_MESSAGE_TRUNCATED && !_status_msg.empty()
+                 ? _status_msg
+                 : std::string(ucs_status_string(status));
+
+  return status;
 }
 
+bool Request::isCompleted() noexcept { return _completed.load(std::memory_order_acquire); }
+
 void Request::callback(void* request, ucs_status_t status)
 {
   /**
@@ -132,29 +291,38 @@ void Request::callback(void* request, ucs_status_t status)
     ucxx_debug("ucxx::Request: %p destroyed before callback() was executed", this);
     return;
   }
-  if (_status != UCS_INPROGRESS)
-    ucxx_trace_req_f(_ownerString.c_str(),
+  ucs_status_t currentStatus = _status.load(std::memory_order_acquire);
+  if (currentStatus != UCS_INPROGRESS)
+    ucxx_trace_req_f(getOwnerString().c_str(),
                      this,
                      _request,
                      _operationName.c_str(),
                      "has status already set to %d (%s), callback setting %d (%s)",
-                     _status,
-                     ucs_status_string(_status),
+                     currentStatus,
+                     ucs_status_string(currentStatus),
                      status,
                      ucs_status_string(status));
 
   if (UCS_PTR_IS_PTR(_request)) ucp_request_free(request);
 
-  ucxx_trace_req_f(_ownerString.c_str(), this, _request, _operationName.c_str(), "completed");
+  ucxx_trace_req_f(getOwnerString().c_str(), this, _request, _operationName.c_str(), "completed");
   setStatus(status);
-  ucxx_trace_req_f(
-    _ownerString.c_str(), this, _request, _operationName.c_str(), "isCompleted: %d", isCompleted());
+  ucxx_trace_req_f(getOwnerString().c_str(),
+                   this,
+                   _request,
+                   _operationName.c_str(),
+                   "isCompleted: %d",
+                   isCompleted());
 }
 
 void Request::process()
 {
+  UCXX_NVTX_RANGE("ucxx::Request::process");
+
   std::lock_guard<std::recursive_mutex> lock(_mutex);
 
+  if (_trace) _trace->submitted = RequestTracer::now();
+
   ucs_status_t status = UCS_INPROGRESS;
 
   if (UCS_PTR_IS_ERR(_request)) {
@@ -162,7 +330,7 @@ void Request::process()
     status = UCS_PTR_STATUS(_request);
   } else if (UCS_PTR_IS_PTR(_request)) {
     // Completion will be handled by callback
-    ucxx_trace_req_f(_ownerString.c_str(),
+    ucxx_trace_req_f(getOwnerString().c_str(),
                      this,
                      _request,
                      _operationName.c_str(),
@@ -173,7 +341,7 @@ void Request::process()
     status = UCS_OK;
   }
 
-  ucxx_trace_req_f(_ownerString.c_str(),
+  ucxx_trace_req_f(getOwnerString().c_str(),
                    this,
                    _request,
                    _operationName.c_str(),
@@ -186,7 +354,7 @@ void Request::process()
       "error on %s with status %d (%s)", _operationName.c_str(), status, ucs_status_string(status));
   } else {
     ucxx_trace_req_f(
-      _ownerString.c_str(), this, _request, _operationName.c_str(), "completed immediately");
+      getOwnerString().c_str(), this, _request, _operationName.c_str(), "completed immediately");
   }
 
   setStatus(status);
@@ -194,13 +362,21 @@ void Request::process()
 
 void Request::setStatus(ucs_status_t status)
 {
+  // Cancelation upon deadline expiration is reported as a timeout.
+  if (status == UCS_ERR_CANCELED && _deadlineExpired.load(std::memory_order_acquire))
+    status = UCS_ERR_TIMED_OUT;
+
+  std::shared_ptr<CompletionExecutor> completionExecutor{nullptr};
+  CompletionCallback deferredCompletion{nullptr};
   {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
 
+    if (_trace) _trace->completed = RequestTracer::now();
+
     if (_endpoint != nullptr) _endpoint->removeInflightRequest(this);
     _worker->removeInflightRequest(this);
 
-    ucxx_trace_req_f(_ownerString.c_str(),
+    ucxx_trace_req_f(getOwnerString().c_str(),
                      this,
                      _request,
                      _operationName.c_str(),
@@ -208,32 +384,136 @@ void Request::setStatus(ucs_status_t status)
                      status,
                      ucs_status_string(status));
 
-    if (_status != UCS_INPROGRESS)
+    ucs_status_t previousStatus = _status.load(std::memory_order_relaxed);
+    // Requests aborted before submission may still be completed by what held them, such
+    // as an aggregated message batch, the status set upon abortion prevails.
+    if (previousStatus != UCS_INPROGRESS && _aborted) {
+      ucxx_trace_req_f(getOwnerString().c_str(),
+                       this,
+                       _request,
+                       _operationName.c_str(),
+                       "already aborted, ignoring status %d (%s)",
+                       status,
+                       ucs_status_string(status));
+      return;
+    }
+    if (previousStatus != UCS_INPROGRESS) {
       ucxx_error(
         "ucxx::Request: %p, setStatus called with status: %d (%s) but status: %d (%s) was already "
         "set",
         this,
         status,
         ucs_status_string(status),
-        _status,
-        ucs_status_string(_status));
-    _status = status;
+        previousStatus,
+        ucs_status_string(previousStatus));
+    } else {
+      countCompletion(status);
+    }
+    // Publish the status for error queries, which may run as soon as the future is
+    // notified, completion is only published to pollers once notifying is done.
+    _status.store(status, std::memory_order_release);
+    writeCompletionFlag(status);
+
+    if (_callback || _enablePythonFuture) completionExecutor = _worker->getCompletionExecutor();
+    const bool deferFuture = _enablePythonFuture && completionExecutor != nullptr &&
+                             _worker->isCompletionExecutorNotifyingFutures();
 
-    if (_enablePythonFuture) {
+    if (_enablePythonFuture && !deferFuture) {
       auto future = std::static_pointer_cast<ucxx::Future>(_future);
       future->notify(status);
     }
 
-    if (_callback) {
-      ucxx_trace_req_f(
-        _ownerString.c_str(), this, _request, _operationName.c_str(), "invoking user callback");
-      _callback(status, _callbackData);
+    if (_callback || deferFuture) {
+      if (completionExecutor) {
+        ucxx_trace_req_f(getOwnerString().c_str(),
+                         this,
+                         _request,
+                         _operationName.c_str(),
+                         "enqueuing user callback");
+        // The future is notified before the callback executes, as when executing inline.
+        deferredCompletion = [future       = deferFuture ? _future : nullptr,
+                              callback     = _callback,
+                              status,
+                              callbackData = _callbackData]() {
+          if (future) future->notify(status);
+          if (callback) callback(status, callbackData);
+        };
+      } else {
+        ucxx_trace_req_f(getOwnerString().c_str(),
+                         this,
+                         _request,
+                         _operationName.c_str(),
+                         "invoking user callback");
+        _callback(status, _callbackData);
+      }
+    }
+
+    // Pairs with the acquire loads of `isCompleted()` and `getStatus()`. Completion is
+    // published before a deferred completion is enqueued, thus it is observed by the
+    // deferred future notification and user callback, but pollers may observe it while
+    // those are still pending; the deferred completion holds its own references to the
+    // future, callback and callback data. Inline, the future was notified and the callback
+    // executed already.
+    _completed.store(true, std::memory_order_release);
+
+    if (_trace) {
+      _trace->status   = status;
+      _trace->notified = RequestTracer::now();
+      _worker->_requestTracer.record(std::move(*_trace));
+      _trace.reset();
     }
   }
+
+  if (!deferredCompletion) return;
+
+  // Enqueued without holding `_mutex`, executors may run completions synchronously and
+  // completions may access the request.
+  completionExecutor->enqueue(std::move(deferredCompletion));
+
+  // The progress thread dispatches completion callbacks after each progress, but it may be
+  // blocked waiting for events when requests complete on other threads.
+  if (_worker->isProgressThreadRunning() &&
+      std::this_thread::get_id() != _worker->getProgressThreadId())
+    completionExecutor->flush();
 }
 
-const std::string& Request::getOwnerString() const { return _ownerString; }
+void Request::countCompletion(ucs_status_t status)
+{
+  _worker->_requestCounters.completed(status);
+  if (_endpoint != nullptr) _endpoint->_requestCounters.completed(status);
+}
+
+const std::string& Request::getOwnerString() const
+{
+  std::call_once(_ownerStringFlag, [this]() {
+    std::stringstream ss;
+    if (_endpoint)
+      ss << "ucxx::Endpoint: " << _endpoint->getHandle();
+    else
+      ss << "ucxx::Worker: " << _worker->getHandle();
+    _ownerString = ss.str();
+  });
+
+  return _ownerString;
+}
+
+SubmissionPriority Request::getSubmissionPriority() const
+{
+  return _endpoint ? _endpoint->getSendHints().submissionPriority : SubmissionPriority::Normal;
+}
 
 std::shared_ptr<Buffer> Request::getRecvBuffer() { return nullptr; }
 
+std::string Request::getRecvHeader() { return {}; }
+
+uint64_t Request::getAtomicResult()
+{
+  throw std::runtime_error("The request is not a fetching atomic operation.");
+}
+
+size_t Request::getRecvLength()
+{
+  throw std::runtime_error("The request is not a stream receive operation.");
+}
+
 }  // namespace ucxx
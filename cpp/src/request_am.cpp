@@ -2,16 +2,21 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <memory>
+#include <new>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include <ucp/api/ucp.h>
 
 #include <ucxx/buffer.h>
 #include <ucxx/delayed_submission.h>
 #include <ucxx/internal/request_am.h>
+#include <ucxx/memory_handle.h>
 #include <ucxx/request_am.h>
 
 namespace ucxx {
@@ -26,14 +31,27 @@ std::shared_ptr<RequestAm> createRequestAm(
   std::shared_ptr<RequestAm> req = std::visit(
     data::dispatch{
       [endpoint, enablePythonFuture, callbackFunction, callbackData](data::AmSend amSend) {
-        auto req = std::shared_ptr<RequestAm>(new RequestAm(
-          endpoint, amSend, "amSend", enablePythonFuture, callbackFunction, callbackData));
+        auto req = utils::makePooledShared<RequestAm>(
+          endpoint->getWorker()->getRequestMemoryPool(), [&](void* storage) {
+            return new (storage) RequestAm(
+              endpoint, amSend, "amSend", enablePythonFuture, callbackFunction, callbackData);
+          });
 
         // A delayed notification request is not populated immediately, instead it is
         // delayed to allow the worker progress thread to set its status, and more
         // importantly the Python future later on, so that we don't need the GIL here.
-        req->_worker->registerDelayedSubmission(
-          req, std::bind(std::mem_fn(&Request::populateDelayedSubmission), req.get()));
+        auto submit = [req]() {
+          req->_worker->registerDelayedSubmission(
+            req, std::bind(std::mem_fn(&Request::populateDelayedSubmission), req.get()));
+        };
+
+        // Small messages may be aggregated, submitting them with a batch later on.
+        if (amSend._amId != internal::AmAggregationId && endpoint->aggregateAmSend(req, amSend))
+          return req;
+
+        // With flow control the submission is deferred until the endpoint has credits.
+        req->_flowControlled = endpoint->submitWithAmCredits(amSend._length, submit);
+        if (!req->_flowControlled) submit();
 
         return req;
       },
@@ -45,10 +63,17 @@ std::shared_ptr<RequestAm> createRequestAm(
                               enablePythonFuture,
                               callbackFunction,
                               callbackData]() {
-          return std::shared_ptr<RequestAm>(new RequestAm(
-            endpoint, amReceive, "amReceive", enablePythonFuture, callbackFunction, callbackData));
+          return utils::makePooledShared<RequestAm>(
+            endpoint->getWorker()->getRequestMemoryPool(), [&](void* storage) {
+              return new (storage) RequestAm(endpoint,
+                                             amReceive,
+                                             "amReceive",
+                                             enablePythonFuture,
+                                             callbackFunction,
+                                             callbackData);
+            });
         };
-        return worker->getAmRecv(endpoint->getHandle(), createRequest);
+        return worker->getAmRecv(endpoint->getHandle(), amReceive._amId, createRequest);
       },
     },
     requestData);
@@ -84,6 +109,36 @@ static void _amSendCallback(void* request, ucs_status_t status, void* user_data)
   req->callback(request, status);
 }
 
+static void _amCreditSendCallback(void* request, ucs_status_t status, void* user_data)
+{
+  if (status != UCS_OK && status != UCS_ERR_CANCELED)
+    ucxx_debug("ucxx::internal::%s, sending active message credit failed: %s",
+               __func__,
+               ucs_status_string(status));
+  ucp_request_free(request);
+}
+
+namespace internal {
+
+void sendAmCredit(ucp_ep_h ep, size_t length)
+{
+  AmCredit credit{1, length};
+  ucp_request_param_t param = {
+    .op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_FLAGS,
+    .flags = UCP_AM_SEND_FLAG_REPLY | UCP_AM_SEND_FLAG_EAGER | UCP_AM_SEND_FLAG_COPY_HEADER,
+    .cb    = {.send = _amCreditSendCallback}};
+
+  ucs_status_ptr_t status =
+    ucp_am_send_nbx(ep, AmFlowControlId, &credit, sizeof(credit), nullptr, 0, &param);
+  if (UCS_PTR_IS_ERR(status))
+    ucxx_debug("ucxx::internal::%s, ep: %p, sending active message credit failed: %s",
+               __func__,
+               ep,
+               ucs_status_string(UCS_PTR_STATUS(status)));
+}
+
+}  // namespace internal
+
 static void _recvCompletedCallback(void* request,
                                    ucs_status_t status,
                                    size_t length,
@@ -118,28 +173,61 @@ ucs_status_t RequestAm::recvCallback(void* arg,
 
   bool is_rndv = param->recv_attr & UCP_AM_RECV_ATTR_FLAG_RNDV;
 
+  if (header_length < sizeof(ucs_memory_type_t)) {
+    ucxx_error("Active message header too short: %lu bytes", header_length);
+    return UCS_ERR_INVALID_PARAM;
+  }
+
   std::shared_ptr<Buffer> buf{nullptr};
-  auto allocatorType = *static_cast<const ucs_memory_type_t*>(header);
+  static_assert(sizeof(uint32_t) == sizeof(ucs_memory_type_t));
+  uint32_t headerMemoryType;
+  memcpy(&headerMemoryType, header, sizeof(headerMemoryType));
+  const bool flowControlled = headerMemoryType & internal::AmFlowControlFlag;
+  ucs_memory_type_t allocatorType =
+    static_cast<ucs_memory_type_t>(headerMemoryType & ~internal::AmFlowControlFlag);
+  std::string userHeader(static_cast<const char*>(header) + sizeof(allocatorType),
+                         header_length - sizeof(allocatorType));
 
   std::shared_ptr<RequestAm> req{nullptr};
+  bool returnCredit = false;
 
   {
     std::lock_guard<std::mutex> lock(amData->_mutex);
 
+    auto createRequest = [&worker, amData]() {
+      return utils::makePooledShared<RequestAm>(worker->getRequestMemoryPool(), [&](void* storage) {
+        return new (storage) RequestAm(worker,
+                                       data::AmReceive(amData->_amId),
+                                       "amReceive",
+                                       worker->isFutureEnabled(),
+                                       nullptr,
+                                       nullptr);
+      });
+    };
+
     auto reqs = recvWait.find(ep);
-    if (reqs != recvWait.end() && !reqs->second.empty()) {
+    if (amData->_receiverCallback) {
+      // Delivered to the receiver callback upon completion, bypassing the pools
+      req          = createRequest();
+      returnCredit = flowControlled;
+      ucxx_trace_req_f(ownerString.c_str(), req.get(), nullptr, "amRecv", "receiverCallback");
+    } else if (reqs != recvWait.end() && !reqs->second.empty()) {
       req = reqs->second.front();
       reqs->second.pop();
+      returnCredit = flowControlled;
       ucxx_trace_req_f(ownerString.c_str(), req.get(), nullptr, "amRecv", "recvWait");
     } else {
-      req             = std::shared_ptr<RequestAm>(new RequestAm(
-        worker, data::AmReceive(), "amReceive", worker->isFutureEnabled(), nullptr, nullptr));
+      req             = createRequest();
       auto [queue, _] = recvPool.try_emplace(ep, std::queue<std::shared_ptr<RequestAm>>());
       queue->second.push(req);
+      // The credit is only returned once the application receives the message.
+      if (flowControlled) amData->_pendingCredits.emplace(req.get(), std::make_pair(ep, length));
       ucxx_trace_req_f(ownerString.c_str(), req.get(), nullptr, "amRecv", "recvPool");
     }
   }
 
+  if (returnCredit) internal::sendAmCredit(ep, length);
+
   if (is_rndv) {
     if (amData->_allocators.find(allocatorType) == amData->_allocators.end()) {
       // TODO: Is a hard failure better?
@@ -155,7 +243,8 @@ ucs_status_t RequestAm::recvCallback(void* arg,
 
     std::shared_ptr<Buffer> buf = amData->_allocators.at(allocatorType)(length);
 
-    auto recvAmMessage = std::make_shared<internal::RecvAmMessage>(amData, ep, req, buf);
+    auto recvAmMessage =
+      std::make_shared<internal::RecvAmMessage>(amData, ep, req, buf, std::move(userHeader));
 
     ucp_request_param_t request_param = {.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
                                                          UCP_OP_ATTR_FIELD_USER_DATA |
@@ -206,8 +295,18 @@ ucs_status_t RequestAm::recvCallback(void* arg,
       return UCS_INPROGRESS;
     }
   } else {
-    std::shared_ptr<Buffer> buf = amData->_allocators.at(UCS_MEMORY_TYPE_HOST)(length);
-    if (length > 0) memcpy(buf->data(), data, length);
+    // With `UCP_AM_FLAG_PERSISTENT_DATA` UCX lets us hold the data until it is released by
+    // `ucp_am_data_release()`, signaled by returning `UCS_INPROGRESS`.
+    const bool holdData = (param->recv_attr & UCP_AM_RECV_ATTR_FLAG_DATA) && length > 0;
+
+    std::shared_ptr<AmDataBuffer> amDataBuffer{nullptr};
+    if (holdData) {
+      amDataBuffer = std::make_shared<AmDataBuffer>(worker, data, length);
+      buf          = amDataBuffer;
+    } else {
+      buf = amData->_allocators.at(UCS_MEMORY_TYPE_HOST)(length);
+      if (length > 0) memcpy(buf->data(), data, length);
+    }
 
     if (req->_enablePythonFuture)
       ucxx_trace_req_f(ownerString.c_str(),
@@ -230,9 +329,20 @@ ucs_status_t RequestAm::recvCallback(void* arg,
                        buf->data(),
                        length);
 
-    internal::RecvAmMessage recvAmMessage(amData, ep, req, buf);
-    recvAmMessage.callback(nullptr, UCS_OK);
-    return UCS_OK;
+    {
+      internal::RecvAmMessage recvAmMessage(amData, ep, std::move(req), buf, std::move(userHeader));
+      recvAmMessage.callback(nullptr, UCS_OK);
+    }
+    if (!holdData) return UCS_OK;
+
+    /**
+     * The data must not be released before `UCS_INPROGRESS` is returned. Dropping the local
+     * references decides atomically against the destructor of the buffer on any other
+     * thread: if the data was already dropped ownership is given back to UCX by returning
+     * `UCS_OK`, otherwise it is only released by the last reference to be dropped.
+     */
+    buf.reset();
+    return AmDataBuffer::retain(std::move(amDataBuffer)) ? UCS_INPROGRESS : UCS_OK;
   }
 }
 
@@ -246,6 +356,16 @@ std::shared_ptr<Buffer> RequestAm::getRecvBuffer()
     _requestData);
 }
 
+std::string RequestAm::getRecvHeader()
+{
+  return std::visit(
+    data::dispatch{
+      [](data::AmReceive amReceive) { return amReceive._header; },
+      [](auto) -> std::string { throw std::runtime_error("Unreachable"); },
+    },
+    _requestData);
+}
+
 void RequestAm::request()
 {
   std::visit(
@@ -258,11 +378,42 @@ void RequestAm::request()
                                      .datatype  = ucp_dt_make_contig(1),
                                      .user_data = this};
 
+        if (amSend._memoryHandle) {
+          param.op_attr_mask |= UCP_OP_ATTR_FIELD_MEMH;
+          param.memh = amSend._memoryHandle->getHandle();
+        }
+
+        /**
+         * The header is the memory type of the buffer, followed by the user-defined header,
+         * if any. Since `UCP_AM_SEND_FLAG_COPY_HEADER` is set, the header buffer only needs
+         * to be valid until `ucp_am_send_nbx()` returns.
+         */
+        uint32_t headerMemoryType = amSend._memoryType;
+        if (_flowControlled) headerMemoryType |= internal::AmFlowControlFlag;
+
+        std::string header;
+        const void* headerPtr = &headerMemoryType;
+        size_t headerLength   = sizeof(headerMemoryType);
+        if (!amSend._header.empty()) {
+          header.reserve(sizeof(headerMemoryType) + amSend._header.size());
+          header.append(reinterpret_cast<const char*>(&headerMemoryType),
+                        sizeof(headerMemoryType));
+          header.append(amSend._header);
+          headerPtr    = header.data();
+          headerLength = header.size();
+        }
+
+        _endpoint->applySendHints(param, amSend._length, true);
+        // Batches of aggregated messages are split by the receiver from the eager data.
+        if (amSend._amId == internal::AmAggregationId) {
+          param.flags &= ~UCP_AM_SEND_FLAG_RNDV;
+          param.flags |= UCP_AM_SEND_FLAG_EAGER;
+        }
         param.cb.send = _amSendCallback;
         void* request = ucp_am_send_nbx(_endpoint->getHandle(),
-                                        0,
-                                        &amSend._memoryType,
-                                        sizeof(amSend._memoryType),
+                                        amSend._amId,
+                                        headerPtr,
+                                        headerLength,
                                         amSend._buffer,
                                         amSend._length,
                                         &param);
@@ -277,6 +428,9 @@ void RequestAm::request()
 
 void RequestAm::populateDelayedSubmission()
 {
+  // Aborted while awaiting submission, e.g., because the endpoint failed.
+  if (!startSubmission()) return;
+
   bool terminate =
     std::visit(data::dispatch{
                  [this](data::AmSend amSend) {
@@ -296,7 +450,7 @@ void RequestAm::populateDelayedSubmission()
 
   auto log = [this](const void* buffer, const size_t length, const ucs_memory_type_t memoryType) {
     if (_enablePythonFuture)
-      ucxx_trace_req_f(_ownerString.c_str(),
+      ucxx_trace_req_f(getOwnerString().c_str(),
                        this,
                        _request,
                        _operationName.c_str(),
@@ -308,7 +462,7 @@ void RequestAm::populateDelayedSubmission()
                        _future.get(),
                        _future->getHandle());
     else
-      ucxx_trace_req_f(_ownerString.c_str(),
+      ucxx_trace_req_f(getOwnerString().c_str(),
                        this,
                        _request,
                        _operationName.c_str(),
@@ -2,10 +2,17 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <cstdint>
+#include <memory>
+#include <numeric>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <ucp/api/ucp.h>
 
+#include <ucxx/memory_handle.h>
+#include <ucxx/remote_key.h>
 #include <ucxx/request_data.h>
 #include <ucxx/typedefs.h>
 
@@ -13,12 +20,108 @@ namespace ucxx {
 
 namespace data {
 
-AmSend::AmSend(const void* buffer, const size_t length, const ucs_memory_type memoryType)
-  : _buffer(buffer), _length(length), _memoryType(memoryType)
+static void checkMemoryHandle(const std::shared_ptr<::ucxx::MemoryHandle>& memoryHandle,
+                              const void* buffer,
+                              const size_t length)
 {
+  if (memoryHandle != nullptr && !memoryHandle->contains(buffer, length))
+    throw std::runtime_error("Buffer is not contained in the registered memory handle.");
 }
 
-AmReceive::AmReceive() {}
+static std::vector<ucp_dt_iov_t> makeIov(const std::vector<void*>& buffer,
+                                         const std::vector<size_t>& length)
+{
+  if (length.size() != buffer.size())
+    throw std::runtime_error("All input vectors should be of equal size");
+
+  std::vector<ucp_dt_iov_t> iov(buffer.size());
+  for (size_t i = 0; i < buffer.size(); ++i)
+    iov[i] = {.buffer = buffer[i], .length = length[i]};
+  return iov;
+}
+
+static size_t totalLength(const std::vector<size_t>& length)
+{
+  return std::accumulate(length.begin(), length.end(), size_t{0});
+}
+
+AmSend::AmSend(const void* buffer,
+               const size_t length,
+               const ucs_memory_type memoryType,
+               const std::string header,
+               const unsigned int amId,
+               const std::shared_ptr<::ucxx::MemoryHandle> memoryHandle,
+               const ::ucxx::RequestReadinessCallback readiness)
+  : _buffer(buffer),
+    _length(length),
+    _memoryType(memoryType),
+    _header(header),
+    _amId(amId),
+    _memoryHandle(memoryHandle),
+    _readiness(readiness)
+{
+  checkMemoryHandle(memoryHandle, buffer, length);
+}
+
+AmReceive::AmReceive(const unsigned int amId) : _amId(amId) {}
+
+EndpointClose::EndpointClose(const bool submit) : _submit(submit) {}
+
+static void checkRemoteKey(const std::shared_ptr<::ucxx::RemoteKey>& remoteKey,
+                           const uint64_t remoteAddr,
+                           const size_t length)
+{
+  if (remoteKey == nullptr || remoteKey->getHandle() == nullptr)
+    throw std::runtime_error("An unpacked remote key is required for remote memory access.");
+  if (!remoteKey->contains(remoteAddr, length))
+    throw std::runtime_error("Remote memory is not contained in the remote key.");
+}
+
+MemPut::MemPut(const void* buffer,
+               const size_t length,
+               const uint64_t remoteAddr,
+               const std::shared_ptr<::ucxx::RemoteKey> remoteKey,
+               const std::shared_ptr<::ucxx::MemoryHandle> memoryHandle)
+  : _buffer(buffer),
+    _length(length),
+    _remoteAddr(remoteAddr),
+    _remoteKey(remoteKey),
+    _memoryHandle(memoryHandle)
+{
+  checkRemoteKey(remoteKey, remoteAddr, length);
+  checkMemoryHandle(memoryHandle, buffer, length);
+}
+
+MemGet::MemGet(void* buffer,
+               const size_t length,
+               const uint64_t remoteAddr,
+               const std::shared_ptr<::ucxx::RemoteKey> remoteKey,
+               const std::shared_ptr<::ucxx::MemoryHandle> memoryHandle)
+  : _buffer(buffer),
+    _length(length),
+    _remoteAddr(remoteAddr),
+    _remoteKey(remoteKey),
+    _memoryHandle(memoryHandle)
+{
+  checkRemoteKey(remoteKey, remoteAddr, length);
+  checkMemoryHandle(memoryHandle, buffer, length);
+}
+
+MemAtomic::MemAtomic(const ucp_atomic_op_t opcode,
+                     const uint64_t value,
+                     const uint64_t remoteAddr,
+                     const std::shared_ptr<::ucxx::RemoteKey> remoteKey,
+                     const bool fetch,
+                     const uint64_t compare)
+  : _opcode(opcode),
+    _value(value),
+    _remoteAddr(remoteAddr),
+    _fetch(fetch || opcode == UCP_ATOMIC_OP_SWAP || opcode == UCP_ATOMIC_OP_CSWAP),
+    _result(compare),
+    _remoteKey(remoteKey)
+{
+  checkRemoteKey(remoteKey, remoteAddr, sizeof(uint64_t));
+}
 
 StreamSend::StreamSend(const void* buffer, const size_t length) : _buffer(buffer), _length(length)
 {
@@ -30,7 +133,14 @@ StreamSend::StreamSend(const void* buffer, const size_t length) : _buffer(buffer
   if (length == 0) throw std::runtime_error("Length has to be a positive value.");
 }
 
-StreamReceive::StreamReceive(void* buffer, const size_t length) : _buffer(buffer), _length(length)
+StreamSend::StreamSend(const std::vector<void*>& buffer, const std::vector<size_t>& length)
+  : _length(totalLength(length)), _iov(makeIov(buffer, length))
+{
+  if (_length == 0) throw std::runtime_error("Length has to be a positive value.");
+}
+
+StreamReceive::StreamReceive(void* buffer, const size_t length, const bool partial)
+  : _buffer(buffer), _length(length), _partial(partial)
 {
   /**
    * Stream API does not support zero-sized messages. See
@@ -40,32 +150,97 @@ StreamReceive::StreamReceive(void* buffer, const size_t length) : _buffer(buffer
   if (length == 0) throw std::runtime_error("Length has to be a positive value.");
 }
 
-TagSend::TagSend(const void* buffer, const size_t length, const ::ucxx::Tag tag)
-  : _buffer(buffer), _length(length), _tag(tag)
+TagSend::TagSend(const void* buffer,
+                 const size_t length,
+                 const ::ucxx::Tag tag,
+                 const std::shared_ptr<::ucxx::MemoryHandle> memoryHandle,
+                 const ::ucxx::RequestReadinessCallback readiness)
+  : _buffer(buffer), _length(length), _tag(tag), _memoryHandle(memoryHandle), _readiness(readiness)
+{
+  checkMemoryHandle(memoryHandle, buffer, length);
+}
+
+TagSend::TagSend(const std::vector<void*>& buffer,
+                 const std::vector<size_t>& length,
+                 const ::ucxx::Tag tag,
+                 const ::ucxx::RequestReadinessCallback readiness)
+  : _length(totalLength(length)), _tag(tag), _iov(makeIov(buffer, length)), _readiness(readiness)
 {
 }
 
 TagReceive::TagReceive(void* buffer,
                        const size_t length,
                        const ::ucxx::Tag tag,
+                       const ::ucxx::TagMask tagMask,
+                       const std::shared_ptr<::ucxx::MemoryHandle> memoryHandle)
+  : _buffer(buffer), _length(length), _tag(tag), _tagMask(tagMask), _memoryHandle(memoryHandle)
+{
+  checkMemoryHandle(memoryHandle, buffer, length);
+}
+
+TagReceive::TagReceive(const std::vector<void*>& buffer,
+                       const std::vector<size_t>& length,
+                       const ::ucxx::Tag tag,
                        const ::ucxx::TagMask tagMask)
-  : _buffer(buffer), _length(length), _tag(tag), _tagMask(tagMask)
+  : _length(totalLength(length)), _tag(tag), _tagMask(tagMask), _iov(makeIov(buffer, length))
+{
+}
+
+TagReceive::TagReceive(const ::ucxx::TagMessage& message,
+                       void* buffer,
+                       const size_t length,
+                       const std::shared_ptr<::ucxx::MemoryHandle> memoryHandle)
+  : _buffer(buffer),
+    _length(length),
+    _tag(message.info.senderTag),
+    _tagMask(::ucxx::TagMaskFull),
+    _memoryHandle(memoryHandle),
+    _message(message.handle)
 {
+  if (_message == nullptr) throw std::invalid_argument("The tag message handle is invalid");
+  checkMemoryHandle(memoryHandle, buffer, length);
 }
 
 TagMultiSend::TagMultiSend(const std::vector<void*>& buffer,
                            const std::vector<size_t>& length,
                            const std::vector<int>& isCUDA,
-                           const ::ucxx::Tag tag)
-  : _buffer(buffer), _length(length), _isCUDA(isCUDA), _tag(tag)
+                           const ::ucxx::Tag tag,
+                           const size_t packThreshold,
+                           const ::ucxx::RequestReadinessCallback readiness)
+  : _buffer(buffer),
+    _length(length),
+    _isCUDA(isCUDA),
+    _tag(tag),
+    _packThreshold(packThreshold),
+    _readiness(readiness)
 {
   if (length.size() != buffer.size() || isCUDA.size() != buffer.size())
     throw std::runtime_error("All input vectors should be of equal size");
 }
 
-TagMultiReceive::TagMultiReceive(const ::ucxx::Tag tag, const ::ucxx::TagMask tagMask)
-  : _tag(tag), _tagMask(tagMask)
+TagMultiReceive::TagMultiReceive(const ::ucxx::Tag tag,
+                                 const ::ucxx::TagMask tagMask,
+                                 const ::ucxx::TagMultiRecvAllocatorType allocator)
+  : _tag(tag), _tagMask(tagMask), _allocator(allocator)
+{
+}
+
+FileSend::FileSend(const std::string& path,
+                   const ::ucxx::Tag tag,
+                   const size_t chunkSize,
+                   const size_t numBuffers)
+  : _path(path), _tag(tag), _chunkSize(chunkSize), _numBuffers(numBuffers)
+{
+  if (chunkSize == 0) throw std::invalid_argument("The chunk size must be positive");
+  if (numBuffers == 0) throw std::invalid_argument("The number of buffers must be positive");
+}
+
+FileReceive::FileReceive(const std::string& path,
+                         const ::ucxx::Tag tag,
+                         const size_t numBuffers)
+  : _path(path), _tag(tag), _numBuffers(numBuffers)
 {
+  if (numBuffers == 0) throw std::invalid_argument("The number of buffers must be positive");
 }
 
 }  // namespace data
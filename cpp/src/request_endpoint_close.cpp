@@ -0,0 +1,130 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/delayed_submission.h>
+#include <ucxx/endpoint.h>
+#include <ucxx/request_endpoint_close.h>
+#include <ucxx/worker.h>
+
+namespace ucxx {
+
+RequestEndpointClose::RequestEndpointClose(std::shared_ptr<Endpoint> endpoint,
+                                           const data::EndpointClose requestData,
+                                           const std::string operationName,
+                                           const bool enablePythonFuture,
+                                           RequestCallbackUserFunction callbackFunction,
+                                           RequestCallbackUserData callbackData)
+  : Request(endpoint, requestData, operationName, enablePythonFuture)
+{
+  _callback     = callbackFunction;
+  _callbackData = callbackData;
+}
+
+std::shared_ptr<RequestEndpointClose> createRequestEndpointClose(
+  std::shared_ptr<Endpoint> endpoint,
+  const data::EndpointClose requestData,
+  const bool enablePythonFuture                = false,
+  RequestCallbackUserFunction callbackFunction = nullptr,
+  RequestCallbackUserData callbackData         = nullptr)
+{
+  auto pool = RequestEndpointClose::getRequestMemoryPool(endpoint);
+  std::shared_ptr<RequestEndpointClose> req =
+    utils::makePooledShared<RequestEndpointClose>(pool, [&](void* storage) {
+      return new (storage) RequestEndpointClose(
+        endpoint, requestData, "endpointClose", enablePythonFuture, callbackFunction, callbackData);
+    });
+
+  // Submission is left to the creator, e.g., `Worker::closeEndpoints()` submits a batch.
+  if (!requestData._submit) return req;
+
+  // Closing the endpoint must happen in the progress thread if one is running, even if
+  // delayed submission is disabled, since it cancels the endpoint's inflight requests.
+  if (req->_worker->isProgressThreadRunning())
+    req->_worker->registerGenericPre([req]() { req->populateDelayedSubmission(); });
+  else
+    req->_worker->registerDelayedSubmission(
+      req, std::bind(std::mem_fn(&Request::populateDelayedSubmission), req.get()));
+
+  return req;
+}
+
+void RequestEndpointClose::request()
+{
+  ucp_request_param_t param = {.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                                               UCP_OP_ATTR_FIELD_USER_DATA |
+                                               UCP_OP_ATTR_FIELD_FLAGS,
+                               .flags        = UCP_EP_CLOSE_FLAG_FORCE,
+                               .user_data    = this};
+  param.cb.send             = endpointCloseCallback;
+
+  void* request = ucp_ep_close_nbx(_endpoint->detachHandle(), &param);
+
+  std::lock_guard<std::recursive_mutex> lock(_mutex);
+  _request = request;
+}
+
+void RequestEndpointClose::populateDelayedSubmission()
+{
+  // Aborted while awaiting submission, e.g., because the endpoint failed.
+  if (!startSubmission()) return;
+
+  if (_endpoint->getHandle() == nullptr) {
+    ucxx_debug("Endpoint was closed before the close request was submitted");
+    Request::callback(this, UCS_OK);
+    return;
+  }
+
+  request();
+
+  if (_enablePythonFuture)
+    ucxx_trace_req_f(getOwnerString().c_str(),
+                     this,
+                     _request,
+                     _operationName.c_str(),
+                     "populateDelayedSubmission, future %p, future handle %p",
+                     _future.get(),
+                     _future->getHandle());
+  else
+    ucxx_trace_req_f(getOwnerString().c_str(),
+                     this,
+                     _request,
+                     _operationName.c_str(),
+                     "populateDelayedSubmission");
+
+  // The close callback must be executed before the request completes, if UCP completed
+  // the close immediately `endpointCloseCallback()` is never called.
+  if (!UCS_PTR_IS_PTR(_request)) {
+    if (UCS_PTR_IS_ERR(_request)) _endpoint->_callbackData.status = UCS_PTR_STATUS(_request);
+    _endpoint->invokeCloseCallback();
+  }
+
+  process();
+}
+
+void RequestEndpointClose::endpointCloseCallback(void* request, ucs_status_t status, void* arg)
+{
+  RequestEndpointClose* req = reinterpret_cast<RequestEndpointClose*>(arg);
+  ucxx_trace_req_f(
+    req->getOwnerString().c_str(), nullptr, request, "endpointClose", "endpointCloseCallback");
+
+  if (status != UCS_OK) {
+    req->_endpoint->_callbackData.status = status;
+    ucxx_error("ucxx::RequestEndpointClose::%s, Endpoint: %p, error while closing endpoint: %s",
+               __func__,
+               req->_endpoint.get(),
+               ucs_status_string(status));
+  }
+  req->_endpoint->invokeCloseCallback();
+
+  return req->callback(request, status);
+}
+
+}  // namespace ucxx
@@ -0,0 +1,436 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ucxx/context.h>
+#include <ucxx/endpoint.h>
+#include <ucxx/request_data.h>
+#include <ucxx/request_file.h>
+#include <ucxx/utils/memory_pool.h>
+#include <ucxx/worker.h>
+
+namespace ucxx {
+
+namespace {
+
+/**
+ * @brief Read exactly `length` bytes from `fd` at `offset`, retrying short reads.
+ *
+ * @returns `true` if all bytes were read, `false` on error or premature end of file.
+ */
+bool readFully(int fd, void* buffer, size_t length, off_t offset)
+{
+  auto ptr = reinterpret_cast<char*>(buffer);
+  while (length > 0) {
+    const ssize_t bytesRead = pread(fd, ptr, length, offset);
+    if (bytesRead < 0 && errno == EINTR) continue;
+    if (bytesRead <= 0) return false;
+    ptr += bytesRead;
+    offset += bytesRead;
+    length -= bytesRead;
+  }
+  return true;
+}
+
+}  // namespace
+
+RequestFile::RequestFile(std::shared_ptr<Endpoint> endpoint,
+                         const std::variant<data::FileSend, data::FileReceive> requestData,
+                         const std::string operationName,
+                         const bool enablePythonFuture)
+  : Request(endpoint, data::getRequestData(requestData), operationName, enablePythonFuture)
+{
+  auto worker = endpoint->getWorker();
+  if (enablePythonFuture) _future = worker->getFuture();
+
+  std::visit(data::dispatch{
+               [this](const data::FileSend& fileSend) {
+                 _fileDescriptor = open(fileSend._path.c_str(), O_RDONLY | O_CLOEXEC);
+                 if (_fileDescriptor == -1)
+                   throw std::ios_base::failure("open() failed for " + fileSend._path + ": " +
+                                                std::strerror(errno));
+
+                 struct stat fileStat;
+                 if (fstat(_fileDescriptor, &fileStat) != 0) {
+                   const int error = errno;
+                   close(_fileDescriptor);
+                   throw std::ios_base::failure("fstat() failed for " + fileSend._path + ": " +
+                                                std::strerror(error));
+                 }
+                 _header = {static_cast<uint64_t>(fileStat.st_size), fileSend._chunkSize};
+               },
+               [this](const data::FileReceive& fileReceive) {
+                 _fileDescriptor =
+                   open(fileReceive._path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+                 if (_fileDescriptor == -1)
+                   throw std::ios_base::failure("open() failed for " + fileReceive._path + ": " +
+                                                std::strerror(errno));
+               },
+             },
+             requestData);
+}
+
+RequestFile::~RequestFile()
+{
+  if (_readerThread.joinable()) {
+    // The reader thread holds a reference to the request, thus it may release the last one
+    if (_readerThread.get_id() == std::this_thread::get_id())
+      _readerThread.detach();
+    else
+      _readerThread.join();
+  }
+  if (_mapping != nullptr) munmap(_mapping, _header[0]);
+  if (_fileDescriptor != -1) close(_fileDescriptor);
+}
+
+std::shared_ptr<RequestFile> createRequestFile(
+  std::shared_ptr<Endpoint> endpoint,
+  const std::variant<data::FileSend, data::FileReceive> requestData,
+  const bool enablePythonFuture)
+{
+  auto pool = endpoint->getWorker()->getRequestMemoryPool();
+  std::shared_ptr<RequestFile> req =
+    std::visit(data::dispatch{
+                 [&endpoint, &enablePythonFuture, &pool](data::FileSend fileSend) {
+                   auto req = utils::makePooledShared<RequestFile>(pool, [&](void* storage) {
+                     return new (storage)
+                       RequestFile(endpoint, fileSend, "fileSend", enablePythonFuture);
+                   });
+                   req->send();
+                   return req;
+                 },
+                 [&endpoint, &enablePythonFuture, &pool](data::FileReceive fileReceive) {
+                   auto req = utils::makePooledShared<RequestFile>(pool, [&](void* storage) {
+                     return new (storage)
+                       RequestFile(endpoint, fileReceive, "fileRecv", enablePythonFuture);
+                   });
+                   req->recvHeader();
+                   return req;
+                 },
+               },
+               requestData);
+
+  return req;
+}
+
+void RequestFile::send()
+{
+  const auto& fileSend = std::get<data::FileSend>(_requestData);
+  const size_t fileSize = _header[0];
+
+  std::lock_guard<std::recursive_mutex> lock(_transferMutex);
+
+  _totalChunks         = (fileSize + fileSend._chunkSize - 1) / fileSend._chunkSize;
+  const size_t numSlots = std::min(fileSend._numBuffers, _totalChunks);
+  if (numSlots > 0) {
+    auto context  = std::dynamic_pointer_cast<Context>(_worker->getParent());
+    _memoryHandle = context->createMemoryHandle(numSlots * fileSend._chunkSize);
+  }
+  _chunkRequests.resize(numSlots);
+  for (size_t slot = numSlots; slot > 0; --slot)
+    _freeSlots.push_back(slot - 1);
+
+  ucxx_trace_req_f(getOwnerString().c_str(),
+                   this,
+                   _request,
+                   _operationName.c_str(),
+                   "send, tag: 0x%lx, size: %lu, chunks: %lu, slots: %lu",
+                   fileSend._tag,
+                   fileSize,
+                   _totalChunks,
+                   numSlots);
+
+  _headerRequest = _endpoint->tagSend(
+    _header.data(),
+    sizeof(_header),
+    fileSend._tag,
+    false,
+    [this](ucs_status_t status, RequestCallbackUserData) { headerCompleted(status); });
+
+  if (_totalChunks > 0) {
+    // Reading from disk may block, thus chunks are read by a helper thread instead of the
+    // caller or the thread completing chunk sends, usually the worker progress thread.
+    _reading      = true;
+    _readerThread = std::thread([this, selfReference = shared_from_this()]() { readChunks(); });
+  }
+  checkCompleted();
+}
+
+void RequestFile::readChunks()
+{
+  const auto& fileSend   = std::get<data::FileSend>(_requestData);
+  const size_t fileSize  = _header[0];
+  const size_t chunkSize = _header[1];
+
+  std::unique_lock<std::recursive_mutex> lock(_transferMutex);
+  while (true) {
+    _slotAvailable.wait(lock, [this]() {
+      return _finalStatus != UCS_OK || _nextChunk >= _totalChunks || !_freeSlots.empty();
+    });
+    if (_finalStatus != UCS_OK || _nextChunk >= _totalChunks) break;
+
+    // Reserve the slot and count the chunk in flight, so that the request does not
+    // complete while reading it.
+    const size_t slot   = _freeSlots.back();
+    const size_t offset = _nextChunk * chunkSize;
+    const size_t length = std::min(chunkSize, fileSize - offset);
+    void* buffer = reinterpret_cast<char*>(_memoryHandle->getBaseAddress()) + slot * chunkSize;
+    _freeSlots.pop_back();
+    ++_nextChunk;
+    ++_inflightChunks;
+
+    lock.unlock();
+    const bool success = readFully(_fileDescriptor, buffer, length, offset);
+    const int error    = errno;
+    lock.lock();
+
+    if (!success || _finalStatus != UCS_OK) {
+      if (!success) {
+        ucxx_error("ucxx::RequestFile: %p failed to read %lu bytes at offset %lu: %s",
+                   this,
+                   length,
+                   offset,
+                   std::strerror(error));
+        if (_finalStatus == UCS_OK) _finalStatus = UCS_ERR_IO_ERROR;
+      }
+      --_inflightChunks;
+      _freeSlots.push_back(slot);
+      break;
+    }
+
+    _chunkRequests[slot] = _endpoint->tagSend(
+      buffer,
+      length,
+      fileSend._tag,
+      false,
+      [this, slot](ucs_status_t status, RequestCallbackUserData) { chunkCompleted(slot, status); },
+      nullptr,
+      _memoryHandle);
+  }
+
+  _reading = false;
+  checkCompleted();
+}
+
+void RequestFile::recvHeader()
+{
+  const auto& fileReceive = std::get<data::FileReceive>(_requestData);
+
+  std::lock_guard<std::recursive_mutex> lock(_transferMutex);
+
+  ucxx_trace_req_f(getOwnerString().c_str(),
+                   this,
+                   _request,
+                   _operationName.c_str(),
+                   "recvHeader, tag: 0x%lx",
+                   fileReceive._tag);
+
+  _headerRequest = _endpoint->tagRecv(
+    _header.data(),
+    sizeof(_header),
+    fileReceive._tag,
+    TagMaskFull,
+    false,
+    [this](ucs_status_t status, RequestCallbackUserData) { headerCompleted(status); });
+}
+
+void RequestFile::headerCompleted(ucs_status_t status)
+{
+  /**
+   * Prevent reference count to self from going to zero and thus cause self to be destroyed
+   * while `headerCompleted()` executes.
+   */
+  decltype(shared_from_this()) selfReference = nullptr;
+  try {
+    selfReference = shared_from_this();
+  } catch (std::bad_weak_ptr& exception) {
+    ucxx_debug("ucxx::RequestFile: %p destroyed before headerCompleted() was executed", this);
+    return;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(_transferMutex);
+  _headerCompleted = true;
+  if (_finalStatus == UCS_OK && status != UCS_OK) _finalStatus = status;
+
+  if (_finalStatus == UCS_OK && std::holds_alternative<data::FileReceive>(_requestData)) {
+    const auto& fileReceive = std::get<data::FileReceive>(_requestData);
+    const size_t fileSize   = _header[0];
+    const size_t chunkSize  = _header[1];
+
+    if (fileSize > 0 && chunkSize == 0) {
+      ucxx_error("ucxx::RequestFile: %p received invalid chunk size 0 for %lu bytes",
+                 this,
+                 fileSize);
+      _finalStatus = UCS_ERR_INVALID_PARAM;
+    } else if (!mapFile(fileSize)) {
+      ucxx_error("ucxx::RequestFile: %p failed to map %s with %lu bytes: %s",
+                 this,
+                 fileReceive._path.c_str(),
+                 fileSize,
+                 std::strerror(errno));
+      _finalStatus = UCS_ERR_IO_ERROR;
+    } else if (fileSize > 0) {
+      _totalChunks          = (fileSize + chunkSize - 1) / chunkSize;
+      const size_t numSlots = std::min(fileReceive._numBuffers, _totalChunks);
+      _chunkRequests.resize(numSlots);
+      for (size_t slot = numSlots; slot > 0; --slot)
+        _freeSlots.push_back(slot - 1);
+
+      ucxx_trace_req_f(getOwnerString().c_str(),
+                       this,
+                       _request,
+                       _operationName.c_str(),
+                       "headerCompleted, tag: 0x%lx, size: %lu, chunks: %lu, slots: %lu",
+                       fileReceive._tag,
+                       fileSize,
+                       _totalChunks,
+                       numSlots);
+    }
+
+    postChunks();
+  }
+
+  checkCompleted();
+}
+
+bool RequestFile::mapFile(size_t fileSize)
+{
+  if (ftruncate(_fileDescriptor, fileSize) != 0) return false;
+  if (fileSize == 0) return true;
+
+  void* mapping =
+    mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, _fileDescriptor, 0);
+  if (mapping == MAP_FAILED) return false;
+  _mapping = mapping;
+  return true;
+}
+
+void RequestFile::postChunks()
+{
+  if (_postingChunks) return;
+  _postingChunks = true;
+
+  const Tag tag          = std::get<data::FileReceive>(_requestData)._tag;
+  const size_t fileSize  = _header[0];
+  const size_t chunkSize = _header[1];
+
+  while (_finalStatus == UCS_OK && !_freeSlots.empty() && _nextChunk < _totalChunks) {
+    const size_t slot   = _freeSlots.back();
+    const size_t offset = _nextChunk * chunkSize;
+    const size_t length = std::min(chunkSize, fileSize - offset);
+    void* buffer        = reinterpret_cast<char*>(_mapping) + offset;
+
+    _freeSlots.pop_back();
+    ++_nextChunk;
+    ++_inflightChunks;
+    _chunkRequests[slot] = _endpoint->tagRecv(
+      buffer,
+      length,
+      tag,
+      TagMaskFull,
+      false,
+      [this, slot](ucs_status_t status, RequestCallbackUserData) { chunkCompleted(slot, status); });
+  }
+
+  _postingChunks = false;
+}
+
+void RequestFile::chunkCompleted(size_t slot, ucs_status_t status)
+{
+  /**
+   * Prevent reference count to self from going to zero and thus cause self to be destroyed
+   * while `chunkCompleted()` executes.
+   */
+  decltype(shared_from_this()) selfReference = nullptr;
+  try {
+    selfReference = shared_from_this();
+  } catch (std::bad_weak_ptr& exception) {
+    ucxx_debug("ucxx::RequestFile: %p destroyed before chunkCompleted() was executed", this);
+    return;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(_transferMutex);
+  --_inflightChunks;
+  _freeSlots.push_back(slot);
+  if (status == UCS_OK)
+    ++_completedChunks;
+  else if (_finalStatus == UCS_OK)
+    _finalStatus = status;
+
+  if (std::holds_alternative<data::FileSend>(_requestData))
+    _slotAvailable.notify_one();
+  else
+    postChunks();
+  checkCompleted();
+}
+
+void RequestFile::checkCompleted()
+{
+  if (_completed || _postingChunks || _reading || !_headerCompleted || _inflightChunks > 0)
+    return;
+  if (_finalStatus == UCS_OK && _completedChunks < _totalChunks) return;
+
+  _completed = true;
+  if (_mapping != nullptr) {
+    munmap(_mapping, _header[0]);
+    _mapping = nullptr;
+  }
+  if (_fileDescriptor != -1) {
+    close(_fileDescriptor);
+    _fileDescriptor = -1;
+  }
+  _memoryHandle = nullptr;
+
+  ucxx_trace_req_f(getOwnerString().c_str(),
+                   this,
+                   _request,
+                   _operationName.c_str(),
+                   "completed, chunks: %lu/%lu, final status: %d (%s)",
+                   _completedChunks,
+                   _totalChunks,
+                   _finalStatus,
+                   ucs_status_string(_finalStatus));
+  setStatus(_finalStatus);
+}
+
+void RequestFile::populateDelayedSubmission() {}
+
+void RequestFile::cancel()
+{
+  std::vector<std::shared_ptr<Request>> requests;
+  {
+    std::lock_guard<std::recursive_mutex> lock(_transferMutex);
+    if (_finalStatus == UCS_OK) _finalStatus = UCS_ERR_CANCELED;
+    requests = _chunkRequests;
+    requests.push_back(_headerRequest);
+  }
+  _slotAvailable.notify_all();
+
+  // Canceled without the lock as their completion callbacks acquire it.
+  for (auto& request : requests)
+    if (request != nullptr && !request->isCompleted()) request->cancel();
+
+  std::lock_guard<std::recursive_mutex> lock(_transferMutex);
+  checkCompleted();
+}
+
+void RequestFile::abort() { cancel(); }
+
+}  // namespace ucxx
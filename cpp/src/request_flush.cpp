@@ -0,0 +1,117 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <memory>
+#include <new>
+#include <string>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/delayed_submission.h>
+#include <ucxx/request_flush.h>
+
+namespace ucxx {
+
+RequestFlush::RequestFlush(std::shared_ptr<Component> endpointOrWorker,
+                           const data::Flush requestData,
+                           const std::string operationName,
+                           const bool enablePythonFuture,
+                           RequestCallbackUserFunction callbackFunction,
+                           RequestCallbackUserData callbackData)
+  : Request(endpointOrWorker, requestData, operationName, enablePythonFuture)
+{
+  _callback     = callbackFunction;
+  _callbackData = callbackData;
+}
+
+std::shared_ptr<RequestFlush> createRequestFlush(
+  std::shared_ptr<Component> endpointOrWorker,
+  const data::Flush requestData,
+  const bool enablePythonFuture                = false,
+  RequestCallbackUserFunction callbackFunction = nullptr,
+  RequestCallbackUserData callbackData         = nullptr)
+{
+  auto pool = RequestFlush::getRequestMemoryPool(endpointOrWorker);
+  std::shared_ptr<RequestFlush> req =
+    utils::makePooledShared<RequestFlush>(pool, [&](void* storage) {
+      auto operationName =
+        endpointOrWorker->asEndpoint() != nullptr ? "endpointFlush" : "workerFlush";
+      return new (storage) RequestFlush(endpointOrWorker,
+                                        requestData,
+                                        operationName,
+                                        enablePythonFuture,
+                                        callbackFunction,
+                                        callbackData);
+    });
+
+  // A delayed notification request is not populated immediately, instead it is
+  // delayed to allow the worker progress thread to set its status, and more
+  // importantly the Python future later on, so that we don't need the GIL here.
+  req->_worker->registerDelayedSubmission(
+    req, std::bind(std::mem_fn(&Request::populateDelayedSubmission), req.get()));
+
+  return req;
+}
+
+void RequestFlush::request()
+{
+  ucp_request_param_t param = {.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                                               UCP_OP_ATTR_FIELD_USER_DATA,
+                               .user_data    = this};
+  param.cb.send             = flushCallback;
+
+  void* request = nullptr;
+  if (_endpoint != nullptr)
+    request = ucp_ep_flush_nbx(_endpoint->getHandle(), &param);
+  else
+    request = ucp_worker_flush_nbx(_worker->getHandle(), &param);
+
+  std::lock_guard<std::recursive_mutex> lock(_mutex);
+  _request = request;
+}
+
+void RequestFlush::populateDelayedSubmission()
+{
+  // Aborted while awaiting submission, e.g., because the endpoint failed.
+  if (!startSubmission()) return;
+
+  if (_endpoint != nullptr && _endpoint->getHandle() == nullptr) {
+    ucxx_warn("Endpoint was closed before it could be flushed");
+    Request::callback(this, UCS_ERR_CANCELED);
+    return;
+  }
+  if (_worker->getHandle() == nullptr) {
+    ucxx_warn("Worker was closed before it could be flushed");
+    Request::callback(this, UCS_ERR_CANCELED);
+    return;
+  }
+
+  request();
+
+  if (_enablePythonFuture)
+    ucxx_trace_req_f(getOwnerString().c_str(),
+                     this,
+                     _request,
+                     _operationName.c_str(),
+                     "populateDelayedSubmission, future %p, future handle %p",
+                     _future.get(),
+                     _future->getHandle());
+  else
+    ucxx_trace_req_f(getOwnerString().c_str(),
+                     this,
+                     _request,
+                     _operationName.c_str(),
+                     "populateDelayedSubmission");
+
+  process();
+}
+
+void RequestFlush::flushCallback(void* request, ucs_status_t status, void* arg)
+{
+  Request* req = reinterpret_cast<Request*>(arg);
+  ucxx_trace_req_f(req->getOwnerString().c_str(), nullptr, request, "flush", "flushCallback");
+  return req->callback(request, status);
+}
+
+}  // namespace ucxx
@@ -0,0 +1,194 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/delayed_submission.h>
+#include <ucxx/memory_handle.h>
+#include <ucxx/remote_key.h>
+#include <ucxx/request_mem.h>
+
+namespace ucxx {
+
+RequestMem::RequestMem(
+  std::shared_ptr<Endpoint> endpoint,
+  const std::variant<data::MemPut, data::MemGet, data::MemAtomic> requestData,
+  const std::string operationName,
+  const bool enablePythonFuture,
+  RequestCallbackUserFunction callbackFunction,
+  RequestCallbackUserData callbackData)
+  : Request(endpoint, data::getRequestData(requestData), operationName, enablePythonFuture)
+{
+  if (_endpoint == nullptr)
+    throw ucxx::Error("A valid endpoint is required to access remote memory.");
+
+  _callback     = callbackFunction;
+  _callbackData = callbackData;
+}
+
+std::shared_ptr<RequestMem> createRequestMem(
+  std::shared_ptr<Endpoint> endpoint,
+  const std::variant<data::MemPut, data::MemGet, data::MemAtomic> requestData,
+  const bool enablePythonFuture                = false,
+  RequestCallbackUserFunction callbackFunction = nullptr,
+  RequestCallbackUserData callbackData         = nullptr)
+{
+  auto pool = endpoint->getWorker()->getRequestMemoryPool();
+  std::shared_ptr<RequestMem> req = utils::makePooledShared<RequestMem>(pool, [&](void* storage) {
+    auto operationName = std::holds_alternative<data::MemPut>(requestData)   ? "memPut"
+                         : std::holds_alternative<data::MemGet>(requestData) ? "memGet"
+                                                                             : "memAtomic";
+    return new (storage) RequestMem(
+      endpoint, requestData, operationName, enablePythonFuture, callbackFunction, callbackData);
+  });
+
+  // A delayed notification request is not populated immediately, instead it is
+  // delayed to allow the worker progress thread to set its status, and more
+  // importantly the Python future later on, so that we don't need the GIL here.
+  req->_worker->registerDelayedSubmission(
+    req, std::bind(std::mem_fn(&Request::populateDelayedSubmission), req.get()));
+
+  return req;
+}
+
+void RequestMem::request()
+{
+  ucp_request_param_t param = {.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                                               UCP_OP_ATTR_FIELD_DATATYPE |
+                                               UCP_OP_ATTR_FIELD_USER_DATA,
+                               .datatype  = ucp_dt_make_contig(1),
+                               .user_data = this};
+  void* request             = nullptr;
+
+  param.cb.send = memCallback;
+
+  std::visit(data::dispatch{
+               [this, &request, &param](data::MemPut memPut) {
+                 if (memPut._memoryHandle) {
+                   param.op_attr_mask |= UCP_OP_ATTR_FIELD_MEMH;
+                   param.memh = memPut._memoryHandle->getHandle();
+                 }
+                 request = ucp_put_nbx(_endpoint->getHandle(),
+                                       memPut._buffer,
+                                       memPut._length,
+                                       memPut._remoteAddr,
+                                       memPut._remoteKey->getHandle(),
+                                       &param);
+               },
+               [this, &request, &param](data::MemGet memGet) {
+                 if (memGet._memoryHandle) {
+                   param.op_attr_mask |= UCP_OP_ATTR_FIELD_MEMH;
+                   param.memh = memGet._memoryHandle->getHandle();
+                 }
+                 request = ucp_get_nbx(_endpoint->getHandle(),
+                                       memGet._buffer,
+                                       memGet._length,
+                                       memGet._remoteAddr,
+                                       memGet._remoteKey->getHandle(),
+                                       &param);
+               },
+               [this, &request, &param](data::MemAtomic& memAtomic) {
+                 // UCX requires the datatype to match the operand size
+                 param.datatype = ucp_dt_make_contig(sizeof(memAtomic._value));
+                 if (memAtomic._fetch) {
+                   param.op_attr_mask |= UCP_OP_ATTR_FIELD_REPLY_BUFFER;
+                   param.reply_buffer = &memAtomic._result;
+                 }
+                 request = ucp_atomic_op_nbx(_endpoint->getHandle(),
+                                             memAtomic._opcode,
+                                             &memAtomic._value,
+                                             1,
+                                             memAtomic._remoteAddr,
+                                             memAtomic._remoteKey->getHandle(),
+                                             &param);
+               },
+               [](auto) { throw std::runtime_error("Unreachable"); },
+             },
+             _requestData);
+
+  std::lock_guard<std::recursive_mutex> lock(_mutex);
+  _request = request;
+}
+
+void RequestMem::populateDelayedSubmission()
+{
+  // Aborted while awaiting submission, e.g., because the endpoint failed.
+  if (!startSubmission()) return;
+
+  if (_endpoint->getHandle() == nullptr) {
+    ucxx_warn("Endpoint was closed before remote memory could be accessed");
+    Request::callback(this, UCS_ERR_CANCELED);
+    return;
+  }
+
+  request();
+
+  auto log = [this](const void* buffer, const size_t length, const uint64_t remoteAddr) {
+    if (_enablePythonFuture)
+      ucxx_trace_req_f(getOwnerString().c_str(),
+                       this,
+                       _request,
+                       _operationName.c_str(),
+                       "populateDelayedSubmission, buffer %p, size %lu, remote address 0x%lx, "
+                       "future %p, future handle %p",
+                       buffer,
+                       length,
+                       remoteAddr,
+                       _future.get(),
+                       _future->getHandle());
+    else
+      ucxx_trace_req_f(getOwnerString().c_str(),
+                       this,
+                       _request,
+                       _operationName.c_str(),
+                       "populateDelayedSubmission, buffer %p, size %lu, remote address 0x%lx",
+                       buffer,
+                       length,
+                       remoteAddr);
+  };
+
+  std::visit(data::dispatch{
+               [this, &log](data::MemPut memPut) {
+                 log(memPut._buffer, memPut._length, memPut._remoteAddr);
+               },
+               [this, &log](data::MemGet memGet) {
+                 log(memGet._buffer, memGet._length, memGet._remoteAddr);
+               },
+               [this, &log](data::MemAtomic memAtomic) {
+                 log(&memAtomic._value, sizeof(memAtomic._value), memAtomic._remoteAddr);
+               },
+               [](auto) { throw std::runtime_error("Unreachable"); },
+             },
+             _requestData);
+
+  process();
+}
+
+void RequestMem::memCallback(void* request, ucs_status_t status, void* arg)
+{
+  Request* req = reinterpret_cast<Request*>(arg);
+  ucxx_trace_req_f(req->getOwnerString().c_str(), nullptr, request, "mem", "memCallback");
+  return req->callback(request, status);
+}
+
+uint64_t RequestMem::getAtomicResult()
+{
+  return std::visit(
+    data::dispatch{
+      [](data::MemAtomic memAtomic) {
+        if (!memAtomic._fetch)
+          throw std::runtime_error("The atomic operation did not fetch the remote value.");
+        return memAtomic._result;
+      },
+      [](auto) -> uint64_t { throw std::runtime_error("Not an atomic operation."); },
+    },
+    _requestData);
+}
+
+}  // namespace ucxx
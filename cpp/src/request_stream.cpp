@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include <memory>
+#include <new>
 #include <string>
 
 #include <ucp/api/ucp.h>
@@ -36,15 +37,20 @@ std::shared_ptr<RequestStream> createRequestStream(
   const std::variant<data::StreamSend, data::StreamReceive> requestData,
   const bool enablePythonFuture = false)
 {
+  auto pool = endpoint->getWorker()->getRequestMemoryPool();
   std::shared_ptr<RequestStream> req =
     std::visit(data::dispatch{
-                 [&endpoint, &enablePythonFuture](data::StreamSend streamSend) {
-                   return std::shared_ptr<RequestStream>(
-                     new RequestStream(endpoint, streamSend, "streamSend", enablePythonFuture));
+                 [&endpoint, &enablePythonFuture, &pool](data::StreamSend streamSend) {
+                   return utils::makePooledShared<RequestStream>(pool, [&](void* storage) {
+                     return new (storage)
+                       RequestStream(endpoint, streamSend, "streamSend", enablePythonFuture);
+                   });
                  },
-                 [&endpoint, &enablePythonFuture](data::StreamReceive streamReceive) {
-                   return std::shared_ptr<RequestStream>(new RequestStream(
-                     endpoint, streamReceive, "streamReceive", enablePythonFuture));
+                 [&endpoint, &enablePythonFuture, &pool](data::StreamReceive streamReceive) {
+                   return utils::makePooledShared<RequestStream>(pool, [&](void* storage) {
+                     return new (storage)
+                       RequestStream(endpoint, streamReceive, "streamReceive", enablePythonFuture);
+                   });
                  },
                  [](auto) -> decltype(req) { throw std::runtime_error("Unreachable"); },
                },
@@ -69,14 +75,23 @@ void RequestStream::request()
   void* request             = nullptr;
 
   std::visit(data::dispatch{
-               [this, &request, &param](data::StreamSend streamSend) {
+               // Taken by reference, the IOV array must remain valid until completion
+               [this, &request, &param](data::StreamSend& streamSend) {
+                 const void* buffer = streamSend._buffer;
+                 size_t count       = streamSend._length;
+                 if (!streamSend._iov.empty()) {
+                   param.datatype = ucp_dt_make_iov();
+                   buffer         = streamSend._iov.data();
+                   count          = streamSend._iov.size();
+                 }
+                 _endpoint->applySendHints(param, streamSend._length, false);
                  param.cb.send = streamSendCallback;
-                 request       = ucp_stream_send_nbx(
-                   _endpoint->getHandle(), streamSend._buffer, streamSend._length, &param);
+                 request       = ucp_stream_send_nbx(_endpoint->getHandle(), buffer, count, &param);
                },
-               [this, &request, &param](data::StreamReceive streamReceive) {
+               // Taken by reference, UCX writes the received length if completed immediately
+               [this, &request, &param](data::StreamReceive& streamReceive) {
                  param.op_attr_mask |= UCP_OP_ATTR_FIELD_FLAGS;
-                 param.flags          = UCP_STREAM_RECV_FLAG_WAITALL;
+                 param.flags          = streamReceive._partial ? 0 : UCP_STREAM_RECV_FLAG_WAITALL;
                  param.cb.recv_stream = streamRecvCallback;
                  request              = ucp_stream_recv_nbx(_endpoint->getHandle(),
                                                streamReceive._buffer,
@@ -94,6 +109,9 @@ void RequestStream::request()
 
 void RequestStream::populateDelayedSubmission()
 {
+  // Aborted while awaiting submission, e.g., because the endpoint failed.
+  if (!startSubmission()) return;
+
   bool terminate =
     std::visit(data::dispatch{
                  [this](data::StreamSend streamSend) {
@@ -122,7 +140,7 @@ void RequestStream::populateDelayedSubmission()
   auto log = [this](const void* buffer, const size_t length) {
     if (_enablePythonFuture)
       ucxx_trace_req_f(
-        _ownerString.c_str(),
+        getOwnerString().c_str(),
         this,
         _request,
         _operationName.c_str(),
@@ -132,7 +150,7 @@ void RequestStream::populateDelayedSubmission()
         _future.get(),
         _future->getHandle());
     else
-      ucxx_trace_req_f(_ownerString.c_str(),
+      ucxx_trace_req_f(getOwnerString().c_str(),
                        this,
                        _request,
                        _operationName.c_str(),
@@ -157,8 +175,10 @@ void RequestStream::populateDelayedSubmission()
 void RequestStream::callback(void* request, ucs_status_t status, size_t length)
 {
   std::visit(data::dispatch{
-               [this, &request, &status, &length](data::StreamReceive streamReceive) {
-                 status = length == streamReceive._length ? status : UCS_ERR_MESSAGE_TRUNCATED;
+               [this, &request, &status, &length](data::StreamReceive& streamReceive) {
+                 streamReceive._lengthReceived = length;
+                 if (!streamReceive._partial && length != streamReceive._length)
+                   status = UCS_ERR_MESSAGE_TRUNCATED;
 
                  if (status == UCS_ERR_MESSAGE_TRUNCATED) {
                    const char* fmt = "length mismatch: %llu (got) != %llu (expected)";
@@ -175,6 +195,14 @@ void RequestStream::callback(void* request, ucs_status_t status, size_t length)
              _requestData);
 }
 
+size_t RequestStream::getRecvLength()
+{
+  auto streamReceive = std::get_if<data::StreamReceive>(&_requestData);
+  if (streamReceive == nullptr)
+    throw std::runtime_error("The request is not a stream receive operation.");
+  return streamReceive->_lengthReceived;
+}
+
 void RequestStream::streamSendCallback(void* request, ucs_status_t status, void* arg)
 {
   Request* req = reinterpret_cast<Request*>(arg);
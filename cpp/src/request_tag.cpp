@@ -4,11 +4,15 @@
  */
 #include <cstdio>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <string>
+#include <vector>
 
 #include <ucp/api/ucp.h>
 
 #include <ucxx/delayed_submission.h>
+#include <ucxx/memory_handle.h>
 #include <ucxx/request_data.h>
 #include <ucxx/request_tag.h>
 
@@ -21,28 +25,20 @@ std::shared_ptr<RequestTag> createRequestTag(
   RequestCallbackUserFunction callbackFunction = nullptr,
   RequestCallbackUserData callbackData         = nullptr)
 {
-  std::shared_ptr<RequestTag> req =
-    std::visit(data::dispatch{
-                 [&endpointOrWorker, &enablePythonFuture, &callbackFunction, &callbackData](
-                   data::TagSend tagSend) {
-                   return std::shared_ptr<RequestTag>(new RequestTag(endpointOrWorker,
-                                                                     tagSend,
-                                                                     "tagSend",
-                                                                     enablePythonFuture,
-                                                                     callbackFunction,
-                                                                     callbackData));
-                 },
-                 [&endpointOrWorker, &enablePythonFuture, &callbackFunction, &callbackData](
-                   data::TagReceive tagReceive) {
-                   return std::shared_ptr<RequestTag>(new RequestTag(endpointOrWorker,
-                                                                     tagReceive,
-                                                                     "tagRecv",
-                                                                     enablePythonFuture,
-                                                                     callbackFunction,
-                                                                     callbackData));
-                 },
-               },
-               requestData);
+  auto pool = RequestTag::getRequestMemoryPool(endpointOrWorker);
+  std::shared_ptr<RequestTag> req = utils::makePooledShared<RequestTag>(
+    pool,
+    [&endpointOrWorker, &requestData, &enablePythonFuture, &callbackFunction, &callbackData](
+      void* storage) {
+      auto operationName =
+        std::holds_alternative<data::TagSend>(requestData) ? "tagSend" : "tagRecv";
+      return new (storage) RequestTag(endpointOrWorker,
+                                      requestData,
+                                      operationName,
+                                      enablePythonFuture,
+                                      callbackFunction,
+                                      callbackData);
+    });
 
   // A delayed notification request is not populated immediately, instead it is
   // delayed to allow the worker progress thread to set its status, and more
@@ -53,6 +49,38 @@ std::shared_ptr<RequestTag> createRequestTag(
   return req;
 }
 
+std::vector<std::shared_ptr<RequestTag>> createRequestTagBatch(
+  std::shared_ptr<Endpoint> endpoint,
+  const std::vector<std::variant<data::TagSend, data::TagReceive>>& requestData,
+  const bool enablePythonFuture,
+  RequestCallbackUserFunction callbackFunction,
+  RequestCallbackUserData callbackData)
+{
+  if (endpoint == nullptr) throw ucxx::Error("An endpoint is required to submit a tag batch");
+
+  auto pool = endpoint->getWorker()->getRequestMemoryPool();
+  std::vector<std::shared_ptr<RequestTag>> reqs;
+  reqs.reserve(requestData.size());
+  for (const auto& data : requestData) {
+    auto operationName = std::holds_alternative<data::TagSend>(data) ? "tagSend" : "tagRecv";
+    reqs.push_back(utils::makePooledShared<RequestTag>(pool, [&](void* storage) {
+      return new (storage) RequestTag(
+        endpoint, data, operationName, enablePythonFuture, callbackFunction, callbackData);
+    }));
+  }
+
+  if (reqs.empty()) return reqs;
+
+  // All requests are submitted by a single delayed submission callback, see
+  // `createRequestTag()` for details on delayed submission.
+  reqs.front()->_worker->registerDelayedSubmission(reqs.front(), [reqs]() {
+    for (auto& req : reqs)
+      req->populateDelayedSubmission();
+  });
+
+  return reqs;
+}
+
 RequestTag::RequestTag(std::shared_ptr<Component> endpointOrWorker,
                        const std::variant<data::TagSend, data::TagReceive> requestData,
                        const std::string operationName,
@@ -85,9 +113,20 @@ void RequestTag::callback(void* request, ucs_status_t status, const ucp_tag_recv
   //   std::snprintf(_status_msg.data(), _status_msg.size(), fmt, info->length, _length);
   // }
 
+  if (info != nullptr) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _recvInfo = {Tag{info->sender_tag}, info->length};
+  }
+
   Request::callback(request, status);
 }
 
+TagRecvInfo RequestTag::getRecvInfo()
+{
+  std::lock_guard<std::recursive_mutex> lock(_mutex);
+  return _recvInfo;
+}
+
 void RequestTag::tagSendCallback(void* request, ucs_status_t status, void* arg)
 {
   Request* req = reinterpret_cast<Request*>(arg);
@@ -115,19 +154,47 @@ void RequestTag::request()
   void* request             = nullptr;
 
   std::visit(data::dispatch{
-               [this, &request, &param](data::TagSend tagSend) {
+               // Taken by reference, the IOV array must remain valid until completion
+               [this, &request, &param](data::TagSend& tagSend) {
+                 if (tagSend._memoryHandle) {
+                   param.op_attr_mask |= UCP_OP_ATTR_FIELD_MEMH;
+                   param.memh = tagSend._memoryHandle->getHandle();
+                 }
+                 const void* buffer = tagSend._buffer;
+                 size_t count       = tagSend._length;
+                 if (!tagSend._iov.empty()) {
+                   param.datatype = ucp_dt_make_iov();
+                   buffer         = tagSend._iov.data();
+                   count          = tagSend._iov.size();
+                 }
+                 _endpoint->applySendHints(param, tagSend._length, false);
                  param.cb.send = tagSendCallback;
-                 request       = ucp_tag_send_nbx(
-                   _endpoint->getHandle(), tagSend._buffer, tagSend._length, tagSend._tag, &param);
+                 request =
+                   ucp_tag_send_nbx(_endpoint->getHandle(), buffer, count, tagSend._tag, &param);
                },
-               [this, &request, &param](data::TagReceive tagReceive) {
+               [this, &request, &param](data::TagReceive& tagReceive) {
+                 if (tagReceive._memoryHandle) {
+                   param.op_attr_mask |= UCP_OP_ATTR_FIELD_MEMH;
+                   param.memh = tagReceive._memoryHandle->getHandle();
+                 }
+                 void* buffer = tagReceive._buffer;
+                 size_t count = tagReceive._length;
+                 if (!tagReceive._iov.empty()) {
+                   param.datatype = ucp_dt_make_iov();
+                   buffer         = const_cast<ucp_dt_iov_t*>(tagReceive._iov.data());
+                   count          = tagReceive._iov.size();
+                 }
                  param.cb.recv = tagRecvCallback;
-                 request       = ucp_tag_recv_nbx(_worker->getHandle(),
-                                            tagReceive._buffer,
-                                            tagReceive._length,
-                                            tagReceive._tag,
-                                            tagReceive._tagMask,
-                                            &param);
+                 if (tagReceive._message != nullptr)
+                   request = ucp_tag_msg_recv_nbx(
+                     _worker->getHandle(), buffer, count, tagReceive._message, &param);
+                 else
+                   request = ucp_tag_recv_nbx(_worker->getHandle(),
+                                              buffer,
+                                              count,
+                                              tagReceive._tag,
+                                              tagReceive._tagMask,
+                                              &param);
                },
                [](auto) { throw std::runtime_error("Unreachable"); },
              },
@@ -141,6 +208,9 @@ static void logPopulateDelayedSubmission() {}
 
 void RequestTag::populateDelayedSubmission()
 {
+  // Aborted while awaiting submission, e.g., because the endpoint failed.
+  if (!startSubmission()) return;
+
   bool terminate =
     std::visit(data::dispatch{
                  [this](data::TagSend tagSend) {
@@ -168,7 +238,7 @@ void RequestTag::populateDelayedSubmission()
 
   auto log = [this](const void* buffer, const size_t length, const Tag tag, const TagMask tagMask) {
     if (_enablePythonFuture)
-      ucxx_trace_req_f(_ownerString.c_str(),
+      ucxx_trace_req_f(getOwnerString().c_str(),
                        this,
                        _request,
                        _operationName.c_str(),
@@ -182,7 +252,7 @@ void RequestTag::populateDelayedSubmission()
                        _future->getHandle());
     else
       ucxx_trace_req_f(
-        _ownerString.c_str(),
+        getOwnerString().c_str(),
         this,
         _request,
         _operationName.c_str(),
@@ -2,8 +2,12 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <new>
 #include <mutex>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -12,6 +16,8 @@
 #include <ucxx/header.h>
 #include <ucxx/request_data.h>
 #include <ucxx/request_tag_multi.h>
+#include <ucxx/utils/compression.h>
+#include <ucxx/utils/nvtx.h>
 #include <ucxx/utils/ucx.h>
 #include <ucxx/worker.h>
 
@@ -39,7 +45,7 @@ RequestTagMulti::~RequestTagMulti()
   for (auto& br : _bufferRequests) {
     const auto& ptr = br->request.get();
     if (ptr != nullptr)
-      ucxx_trace_req_f(_ownerString.c_str(),
+      ucxx_trace_req_f(getOwnerString().c_str(),
                        this,
                        _request,
                        _operationName.c_str(),
@@ -62,17 +68,22 @@ std::shared_ptr<RequestTagMulti> createRequestTagMulti(
   const std::variant<data::TagMultiSend, data::TagMultiReceive> requestData,
   const bool enablePythonFuture)
 {
+  auto pool = endpoint->getWorker()->getRequestMemoryPool();
   std::shared_ptr<RequestTagMulti> req =
     std::visit(data::dispatch{
-                 [&endpoint, &enablePythonFuture](data::TagMultiSend tagMultiSend) {
-                   auto req = std::shared_ptr<RequestTagMulti>(new RequestTagMulti(
-                     endpoint, tagMultiSend, "tagMultiSend", enablePythonFuture));
+                 [&endpoint, &enablePythonFuture, &pool](data::TagMultiSend tagMultiSend) {
+                   auto req = utils::makePooledShared<RequestTagMulti>(pool, [&](void* storage) {
+                     return new (storage)
+                       RequestTagMulti(endpoint, tagMultiSend, "tagMultiSend", enablePythonFuture);
+                   });
                    req->send();
                    return req;
                  },
-                 [&endpoint, &enablePythonFuture](data::TagMultiReceive tagMultiReceive) {
-                   auto req = std::shared_ptr<RequestTagMulti>(new RequestTagMulti(
-                     endpoint, tagMultiReceive, "tagMultiRecv", enablePythonFuture));
+                 [&endpoint, &enablePythonFuture, &pool](data::TagMultiReceive tagMultiReceive) {
+                   auto req = utils::makePooledShared<RequestTagMulti>(pool, [&](void* storage) {
+                     return new (storage) RequestTagMulti(
+                       endpoint, tagMultiReceive, "tagMultiRecv", enablePythonFuture);
+                   });
                    req->recvCallback(UCS_OK);
                    return req;
                  },
@@ -99,11 +110,13 @@ static TagPair checkAndGetTagPair(const data::RequestData& requestData,
 
 void RequestTagMulti::recvFrames()
 {
+  UCXX_NVTX_RANGE("ucxx::RequestTagMulti::recvFrames");
+
   auto tagPair = checkAndGetTagPair(_requestData, std::string("recvFrames"));
 
   std::vector<Header> headers;
 
-  ucxx_trace_req_f(_ownerString.c_str(),
+  ucxx_trace_req_f(getOwnerString().c_str(),
                    this,
                    _request,
                    _operationName.c_str(),
@@ -114,7 +127,7 @@ void RequestTagMulti::recvFrames()
                    _bufferRequests.size());
 
   for (auto& br : _bufferRequests) {
-    ucxx_trace_req_f(_ownerString.c_str(),
+    ucxx_trace_req_f(getOwnerString().c_str(),
                      this,
                      _request,
                      _operationName.c_str(),
@@ -123,19 +136,143 @@ void RequestTagMulti::recvFrames()
                      tagPair.first,
                      tagPair.second,
                      br->stringBuffer->size());
-    headers.push_back(Header(*br->stringBuffer));
+    headers.push_back(Header(br->stringBuffer->data(), br->stringBuffer->size()));
   }
 
+  std::vector<size_t> frameSize;
+  std::vector<int> frameIsCUDA;
   for (auto& h : headers) {
     _totalFrames += h.nframes;
     for (size_t i = 0; i < h.nframes; ++i) {
+      frameSize.push_back(h.size[i]);
+      frameIsCUDA.push_back(h.isCUDA[i] && h.isCUDA[i] != HeaderFramePacked);
+    }
+  }
+
+  /**
+   * This runs from the header receive callback, thus errors must not be thrown but set as
+   * the final status. Frames are then still received, into internal buffers, so that they
+   * are not matched by the next receive with the same tag.
+   */
+  auto allocator = std::get<data::TagMultiReceive>(_requestData)._allocator;
+  std::vector<std::shared_ptr<Buffer>> userBuffers;
+  if (allocator) {
+    std::string error{};
+    try {
+      userBuffers = allocator(frameSize, frameIsCUDA);
+      if (userBuffers.size() != _totalFrames)
+        error = "the allocator must return exactly one buffer per frame";
+      for (size_t i = 0; error.empty() && i < userBuffers.size(); ++i)
+        if (userBuffers[i] == nullptr || userBuffers[i]->getSize() < frameSize[i])
+          error = "the allocator returned a buffer smaller than its frame";
+    } catch (const std::exception& e) {
+      error = e.what();
+    }
+
+    if (!error.empty()) {
+      ucxx_error("ucxx::RequestTagMulti: %p, failed allocating frames: %s", this, error.c_str());
+      userBuffers.clear();
+      std::lock_guard<std::mutex> lock(_completedRequestsMutex);
+      if (_finalStatus == UCS_OK) _finalStatus = UCS_ERR_INVALID_PARAM;
+    }
+  }
+
+  std::vector<BufferRequestPtr> packedBufferRequests;
+  std::vector<void*> packedBuffer;
+  std::vector<size_t> packedSize;
+  std::vector<BufferRequestPtr> unpackedBufferRequests;
+  std::vector<size_t> unpackedSize;
+  std::vector<size_t> unpackedCompressedSize;
+  std::vector<CompressionCodec> unpackedCompression;
+
+  // Allocate all buffers first, frames the sender packed must be received by a single
+  // request posted before those of the remaining frames to match the order they were sent.
+  size_t frame = 0;
+  for (auto& h : headers) {
+    for (size_t i = 0; i < h.nframes; ++i, ++frame) {
       auto bufferRequest = std::make_shared<BufferRequest>();
       _bufferRequests.push_back(bufferRequest);
-      const auto bufferType  = h.isCUDA[i] ? ucxx::BufferType::RMM : ucxx::BufferType::Host;
-      auto buf               = allocateBuffer(bufferType, h.size[i]);
+      std::shared_ptr<Buffer> buf = nullptr;
+      if (!userBuffers.empty()) {
+        buf = userBuffers[frame];
+      } else {
+        const auto bufferType =
+          frameIsCUDA[frame] ? ucxx::BufferType::RMM : ucxx::BufferType::Host;
+        buf = _worker->allocateInternalBuffer(bufferType, h.size[i]);
+      }
+      bufferRequest->buffer = buf;
+
+      if (h.isCUDA[i] == HeaderFramePacked) {
+        packedBufferRequests.push_back(bufferRequest);
+        packedBuffer.push_back(buf->data());
+        packedSize.push_back(h.size[i]);
+      } else {
+        const auto codec = static_cast<CompressionCodec>(h.compression);
+        if (h.compressedSize[i] > 0) {
+          // Still received to be discarded by `decompressFrame()`, failing the request.
+          if (!utils::isCompressionCodecAvailable(codec)) {
+            ucxx_error("ucxx::RequestTagMulti: %p, frame compressed with unavailable codec %u",
+                       this,
+                       static_cast<unsigned>(h.compression));
+            std::lock_guard<std::mutex> lock(_completedRequestsMutex);
+            if (_finalStatus == UCS_OK) _finalStatus = UCS_ERR_UNSUPPORTED;
+          }
+          bufferRequest->compressedBuffer =
+            _worker->allocateInternalBuffer(ucxx::BufferType::Host, h.compressedSize[i]);
+        }
+        unpackedBufferRequests.push_back(bufferRequest);
+        unpackedSize.push_back(h.size[i]);
+        unpackedCompressedSize.push_back(h.compressedSize[i]);
+        unpackedCompression.push_back(codec);
+      }
+    }
+  }
+  _totalFrameRequests = unpackedBufferRequests.size() + (packedBuffer.empty() ? 0 : 1);
+
+  if (!packedBuffer.empty()) {
+    auto request = _endpoint->tagRecvIov(
+      packedBuffer,
+      packedSize,
+      tagPair.first,
+      tagPair.second,
+      false,
+      [this](ucs_status_t status, RequestCallbackUserData arg) {
+        return this->markCompleted(status, arg);
+      });
+    for (auto& bufferRequest : packedBufferRequests)
+      bufferRequest->request = request;
+    ucxx_trace_req_f(getOwnerString().c_str(),
+                     this,
+                     _request,
+                     _operationName.c_str(),
+                     "recvFrames, tag: 0x%lx, tagMask: 0x%lx, packed frames: %lu",
+                     tagPair.first,
+                     tagPair.second,
+                     packedBuffer.size());
+  }
+
+  for (size_t i = 0; i < unpackedBufferRequests.size(); ++i) {
+    auto& bufferRequest = unpackedBufferRequests[i];
+    auto& buf           = bufferRequest->buffer;
+    if (bufferRequest->compressedBuffer) {
+      // Received into a temporary host buffer and decompressed into the frame buffer.
+      const auto codec          = unpackedCompression[i];
+      const auto compressedSize = unpackedCompressedSize[i];
+      const auto size           = unpackedSize[i];
+      bufferRequest->request    = _endpoint->tagRecv(
+        bufferRequest->compressedBuffer->data(),
+        compressedSize,
+        tagPair.first,
+        tagPair.second,
+        false,
+        [this, codec, compressedSize, size](ucs_status_t status, RequestCallbackUserData arg) {
+          return this->decompressFrame(status, arg, codec, compressedSize, size);
+        },
+        bufferRequest);
+    } else {
       bufferRequest->request = _endpoint->tagRecv(
         buf->data(),
-        buf->getSize(),
+        unpackedSize[i],
         tagPair.first,
         tagPair.second,
         false,
@@ -143,20 +280,23 @@ void RequestTagMulti::recvFrames()
           return this->markCompleted(status, arg);
         },
         bufferRequest);
-      bufferRequest->buffer = buf;
-      ucxx_trace_req_f(_ownerString.c_str(),
-                       this,
-                       _request,
-                       _operationName.c_str(),
-                       "recvFrames, tag: 0x%lx, tagMask: 0x%lx, buffer: %p",
-                       tagPair.first,
-                       tagPair.second,
-                       bufferRequest->buffer.get());
     }
+    ucxx_trace_req_f(getOwnerString().c_str(),
+                     this,
+                     _request,
+                     _operationName.c_str(),
+                     "recvFrames, tag: 0x%lx, tagMask: 0x%lx, buffer: %p",
+                     tagPair.first,
+                     tagPair.second,
+                     buf.get());
   }
 
   _isFilled = true;
-  ucxx_trace_req_f(_ownerString.c_str(),
+
+  // Post the header receive of the next message behind the frames, if enabled.
+  _endpoint->prepostTagMultiHeader(tagPair.first, tagPair.second);
+
+  ucxx_trace_req_f(getOwnerString().c_str(),
                    this,
                    _request,
                    _operationName.c_str(),
@@ -194,7 +334,7 @@ void RequestTagMulti::markCompleted(ucs_status_t status, RequestCallbackUserData
                                },
                                _requestData);
 
-  ucxx_trace_req_f(_ownerString.c_str(),
+  ucxx_trace_req_f(getOwnerString().c_str(),
                    this,
                    _request,
                    _operationName.c_str(),
@@ -206,10 +346,10 @@ void RequestTagMulti::markCompleted(ucs_status_t status, RequestCallbackUserData
 
   if (_finalStatus == UCS_OK && status != UCS_OK) _finalStatus = status;
 
-  if (++_completedRequests == _totalFrames) {
+  if (++_completedRequests == _totalFrameRequests) {
     setStatus(_finalStatus);
 
-    ucxx_trace_req_f(_ownerString.c_str(),
+    ucxx_trace_req_f(getOwnerString().c_str(),
                      this,
                      _request,
                      _operationName.c_str(),
@@ -219,11 +359,11 @@ void RequestTagMulti::markCompleted(ucs_status_t status, RequestCallbackUserData
                      tagPair.first,
                      tagPair.second,
                      _completedRequests,
-                     _totalFrames,
+                     _totalFrameRequests,
                      _finalStatus,
                      ucs_status_string(_finalStatus));
   } else {
-    ucxx_trace_req_f(_ownerString.c_str(),
+    ucxx_trace_req_f(getOwnerString().c_str(),
                      this,
                      _request,
                      _operationName.c_str(),
@@ -231,15 +371,62 @@ void RequestTagMulti::markCompleted(ucs_status_t status, RequestCallbackUserData
                      tagPair.first,
                      tagPair.second,
                      _completedRequests,
-                     _totalFrames);
+                     _totalFrameRequests);
+  }
+}
+
+void RequestTagMulti::decompressFrame(ucs_status_t status,
+                                      RequestCallbackUserData request,
+                                      CompressionCodec codec,
+                                      size_t compressedSize,
+                                      size_t size)
+{
+  if (status != UCS_OK) return markCompleted(status, request);
+  if (!utils::isCompressionCodecAvailable(codec)) {
+    std::static_pointer_cast<BufferRequest>(request)->compressedBuffer = nullptr;
+    return markCompleted(UCS_ERR_UNSUPPORTED, request);
+  }
+
+  decltype(shared_from_this()) selfReference = nullptr;
+  try {
+    selfReference = shared_from_this();
+  } catch (std::bad_weak_ptr& exception) {
+    ucxx_debug(
+      "ucxx::RequestTagMulti: %p destroyed before all decompressFrame() callbacks were executed",
+      this);
+    return;
   }
+
+  _worker->runCompressionTask([this, selfReference, request, codec, compressedSize, size]() {
+    auto bufferRequest = std::static_pointer_cast<BufferRequest>(request);
+    auto status        = UCS_OK;
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+      utils::decompress(codec,
+                        bufferRequest->compressedBuffer->data(),
+                        compressedSize,
+                        bufferRequest->buffer->data(),
+                        size);
+    } catch (const std::exception& e) {
+      ucxx_error("ucxx::RequestTagMulti: %p, failed decompressing frame: %s", this, e.what());
+      status = UCS_ERR_IO_ERROR;
+    }
+    _worker->_compressionCounters.decompressed(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                           start)
+        .count());
+
+    bufferRequest->compressedBuffer = nullptr;
+    markCompleted(status, request);
+  });
 }
 
 void RequestTagMulti::recvHeader()
 {
   auto tagPair = checkAndGetTagPair(_requestData, std::string("recvHeader"));
 
-  ucxx_trace_req_f(_ownerString.c_str(),
+  ucxx_trace_req_f(getOwnerString().c_str(),
                    this,
                    _request,
                    _operationName.c_str(),
@@ -248,6 +435,27 @@ void RequestTagMulti::recvHeader()
                    tagPair.second);
 
   auto bufferRequest = std::make_shared<BufferRequest>();
+
+  // Adopt the first header receive if preposted by the previous receive request.
+  if (_bufferRequests.empty()) {
+    if (auto preposted = _endpoint->takeTagMultiPrepostedHeader(tagPair.first, tagPair.second)) {
+      ucxx_trace_req_f(getOwnerString().c_str(),
+                       this,
+                       _request,
+                       _operationName.c_str(),
+                       "recvHeader adopting preposted header, tag: 0x%lx, tagMask: 0x%lx",
+                       tagPair.first,
+                       tagPair.second);
+
+      _bufferRequests.push_back(bufferRequest);
+      bufferRequest->stringBuffer = preposted->stringBuffer;
+      bufferRequest->request      = preposted->request;
+      preposted->adopt(
+        [this, preposted](ucs_status_t status) { return this->recvCallback(status); });
+      return;
+    }
+  }
+
   _bufferRequests.push_back(bufferRequest);
   bufferRequest->stringBuffer = std::make_shared<std::string>(Header::dataSize(), 0);
   bufferRequest->request =
@@ -265,7 +473,7 @@ void RequestTagMulti::recvHeader()
     bufferRequest->request->checkError();
   }
 
-  ucxx_trace_req_f(_ownerString.c_str(),
+  ucxx_trace_req_f(getOwnerString().c_str(),
                    this,
                    _request,
                    _operationName.c_str(),
@@ -279,7 +487,7 @@ void RequestTagMulti::recvCallback(ucs_status_t status)
 {
   auto tagPair = checkAndGetTagPair(_requestData, std::string("recvCallback"));
 
-  ucxx_trace_req_f(_ownerString.c_str(),
+  ucxx_trace_req_f(getOwnerString().c_str(),
                    this,
                    _request,
                    _operationName.c_str(),
@@ -291,7 +499,7 @@ void RequestTagMulti::recvCallback(ucs_status_t status)
     recvHeader();
   } else {
     if (status == UCS_OK) {
-      ucxx_trace_req_f(_ownerString.c_str(),
+      ucxx_trace_req_f(getOwnerString().c_str(),
                        this,
                        _request,
                        _operationName.c_str(),
@@ -300,7 +508,7 @@ void RequestTagMulti::recvCallback(ucs_status_t status)
                        tagPair.first,
                        tagPair.second);
     } else {
-      ucxx_trace_req_f(_ownerString.c_str(),
+      ucxx_trace_req_f(getOwnerString().c_str(),
                        this,
                        _request,
                        _operationName.c_str(),
@@ -312,13 +520,19 @@ void RequestTagMulti::recvCallback(ucs_status_t status)
                        tagPair.first,
                        tagPair.second);
 
-      _status = status;
+      if (status == UCS_ERR_CANCELED && _deadlineExpired.load(std::memory_order_acquire))
+        status = UCS_ERR_TIMED_OUT;
+      _status.store(status, std::memory_order_release);
+      countCompletion(status);
+      writeCompletionFlag(status);
       if (_future) _future->notify(status);
+      _completed.store(true, std::memory_order_release);
 
       return;
     }
 
-    auto header = Header(*_bufferRequests.back()->stringBuffer);
+    const auto& stringBuffer = _bufferRequests.back()->stringBuffer;
+    auto header              = Header(stringBuffer->data(), stringBuffer->size());
 
     if (header.next)
       recvHeader();
@@ -334,10 +548,30 @@ void RequestTagMulti::send()
       [this](data::TagMultiSend tagMultiSend) {
         _totalFrames = tagMultiSend._buffer.size();
 
-        auto headers = Header::buildHeaders(tagMultiSend._length, tagMultiSend._isCUDA);
+        // Host frames up to the threshold are flagged in the header and packed together
+        std::vector<int> isCUDA = tagMultiSend._isCUDA;
+        std::vector<void*> packedBuffer;
+        std::vector<size_t> packedSize;
+        for (size_t i = 0; i < _totalFrames && tagMultiSend._packThreshold > 0; ++i) {
+          if (!isCUDA[i] && tagMultiSend._length[i] <= tagMultiSend._packThreshold) {
+            isCUDA[i] = HeaderFramePacked;
+            packedBuffer.push_back(tagMultiSend._buffer[i]);
+            packedSize.push_back(tagMultiSend._length[i]);
+          }
+        }
+        _totalFrameRequests = _totalFrames - packedBuffer.size() + (packedBuffer.empty() ? 0 : 1);
+
+        std::vector<size_t> compressedSize;
+        std::vector<std::shared_ptr<Buffer>> compressedBuffer;
+        auto compression = compressFrames(tagMultiSend, isCUDA, compressedSize, compressedBuffer);
 
+        auto headers = Header::buildHeaders(
+          tagMultiSend._length, isCUDA, compressedSize, static_cast<uint8_t>(compression));
+
+        const auto headerFormat =
+          _worker->isCompactHeadersEnabled() ? HeaderFormat::Compact : HeaderFormat::Legacy;
         for (const auto& header : headers) {
-          auto serializedHeader = std::make_shared<std::string>(header.serialize());
+          auto serializedHeader = std::make_shared<std::string>(header.serialize(headerFormat));
           auto bufferRequest    = std::make_shared<BufferRequest>();
           _bufferRequests.push_back(bufferRequest);
           bufferRequest->request = _endpoint->tagSend(
@@ -345,21 +579,43 @@ void RequestTagMulti::send()
           bufferRequest->stringBuffer = serializedHeader;
         }
 
+        if (!packedBuffer.empty()) {
+          auto bufferRequest = std::make_shared<BufferRequest>();
+          _bufferRequests.push_back(bufferRequest);
+          bufferRequest->request =
+            _endpoint->tagSendIov(packedBuffer,
+                                  packedSize,
+                                  tagMultiSend._tag,
+                                  false,
+                                  [this](ucs_status_t status, RequestCallbackUserData arg) {
+                                    return this->markCompleted(status, arg);
+                                  },
+                                  nullptr,
+                                  tagMultiSend._readiness);
+        }
+
         for (size_t i = 0; i < _totalFrames; ++i) {
+          if (isCUDA[i] == HeaderFramePacked) continue;
+
           auto bufferRequest = std::make_shared<BufferRequest>();
           _bufferRequests.push_back(bufferRequest);
+          const bool isCompressed = !compressedSize.empty() && compressedSize[i] > 0;
+          if (isCompressed) bufferRequest->compressedBuffer = compressedBuffer[i];
           bufferRequest->request =
-            _endpoint->tagSend(tagMultiSend._buffer[i],
-                               tagMultiSend._length[i],
+            _endpoint->tagSend(isCompressed ? compressedBuffer[i]->data() : tagMultiSend._buffer[i],
+                               isCompressed ? compressedSize[i] : tagMultiSend._length[i],
                                tagMultiSend._tag,
                                false,
                                [this](ucs_status_t status, RequestCallbackUserData arg) {
                                  return this->markCompleted(status, arg);
-                               });
+                               },
+                               nullptr,
+                               nullptr,
+                               tagMultiSend._readiness);
         }
 
         _isFilled = true;
-        ucxx_trace_req_f(_ownerString.c_str(),
+        ucxx_trace_req_f(getOwnerString().c_str(),
                          this,
                          _request,
                          _operationName.c_str(),
@@ -372,6 +628,71 @@ void RequestTagMulti::send()
     _requestData);
 }
 
+CompressionCodec RequestTagMulti::compressFrames(
+  const data::TagMultiSend& tagMultiSend,
+  const std::vector<int>& isCUDA,
+  std::vector<size_t>& compressedSize,
+  std::vector<std::shared_ptr<Buffer>>& compressedBuffer)
+{
+  const auto config = _worker->getCompressionConfig();
+  // Frames awaiting readiness may not hold their data yet.
+  if (config.codec == CompressionCodec::None || tagMultiSend._readiness) return config.codec;
+
+  std::vector<size_t> frames;
+  for (size_t i = 0; i < _totalFrames; ++i)
+    if (isCUDA[i] == 0 && tagMultiSend._length[i] >= config.minFrameSize &&
+        utils::getCompressBound(config.codec, tagMultiSend._length[i]) > 0)
+      frames.push_back(i);
+  if (frames.empty()) return config.codec;
+
+  try {
+    if (!_endpoint->usesTransport(config.transports)) return config.codec;
+  } catch (const ucxx::Error& e) {
+    return config.codec;
+  }
+
+  compressedSize.assign(_totalFrames, 0);
+  compressedBuffer.assign(_totalFrames, nullptr);
+
+  // Allocated upfront so that tasks can't fail, the worst size is temporary.
+  for (const auto i : frames)
+    compressedBuffer[i] = _worker->allocateInternalBuffer(
+      ucxx::BufferType::Host, utils::getCompressBound(config.codec, tagMultiSend._length[i]));
+
+  std::mutex pendingMutex;
+  std::condition_variable pendingCondition;
+  size_t pending = frames.size();
+
+  for (const auto i : frames) {
+    _worker->runCompressionTask([&, i]() {
+      const auto start = std::chrono::steady_clock::now();
+      size_t size      = utils::compress(config.codec,
+                                    config.level,
+                                    tagMultiSend._buffer[i],
+                                    tagMultiSend._length[i],
+                                    compressedBuffer[i]->data(),
+                                    compressedBuffer[i]->getSize());
+      // Frames that don't shrink are sent verbatim.
+      if (size >= tagMultiSend._length[i]) size = 0;
+      compressedSize[i] = size;
+      _worker->_compressionCounters.compressed(
+        tagMultiSend._length[i],
+        size,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                             start)
+          .count());
+
+      std::lock_guard<std::mutex> lock(pendingMutex);
+      if (--pending == 0) pendingCondition.notify_one();
+    });
+  }
+
+  std::unique_lock<std::mutex> lock(pendingMutex);
+  pendingCondition.wait(lock, [&pending]() { return pending == 0; });
+
+  return config.codec;
+}
+
 void RequestTagMulti::populateDelayedSubmission() {}
 
 void RequestTagMulti::cancel()
@@ -380,4 +701,6 @@ void RequestTagMulti::cancel()
     if (br->request) br->request->cancel();
 }
 
+void RequestTagMulti::abort() { cancel(); }
+
 }  // namespace ucxx
@@ -0,0 +1,101 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ucxx/log.h>
+#include <ucxx/request_trace.h>
+
+namespace ucxx {
+
+void RequestTracer::configure(uint64_t sampleRate, size_t capacity)
+{
+  if (sampleRate > 0 && capacity == 0)
+    throw std::runtime_error("The request trace capacity must be positive when tracing");
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _traces.clear();
+  _traces.shrink_to_fit();
+  _capacity = sampleRate > 0 ? capacity : 0;
+  _next     = 0;
+  _dropped  = 0;
+  _sampleRate.store(sampleRate, std::memory_order_relaxed);
+}
+
+void RequestTracer::configureFromEnvironment()
+{
+  const char* sampleRateEnv = std::getenv("UCXX_REQUEST_TRACE_SAMPLE_RATE");
+  if (sampleRateEnv == nullptr) return;
+
+  const char* capacityEnv = std::getenv("UCXX_REQUEST_TRACE_CAPACITY");
+  try {
+    uint64_t sampleRate = std::stoull(sampleRateEnv);
+    size_t capacity     = capacityEnv != nullptr ? std::stoull(capacityEnv) : 1024;
+    configure(sampleRate, capacity);
+    ucxx_info("UCXX_REQUEST_TRACE_SAMPLE_RATE: %lu, UCXX_REQUEST_TRACE_CAPACITY: %lu",
+              sampleRate,
+              capacity);
+  } catch (const std::exception& e) {
+    ucxx_warn("Invalid UCXX_REQUEST_TRACE_SAMPLE_RATE (%s) or UCXX_REQUEST_TRACE_CAPACITY (%s), "
+              "request tracing disabled",
+              sampleRateEnv,
+              capacityEnv != nullptr ? capacityEnv : "");
+  }
+}
+
+void RequestTracer::record(RequestTrace trace)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_capacity == 0) return;
+
+  if (_traces.size() < _capacity) {
+    _traces.push_back(std::move(trace));
+  } else {
+    _traces[_next] = std::move(trace);
+    ++_dropped;
+  }
+  _next = (_next + 1) % _capacity;
+}
+
+std::vector<RequestTrace> RequestTracer::getTraces(bool clear)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  std::vector<RequestTrace> traces;
+  if (clear) {
+    std::swap(traces, _traces);
+    _traces.reserve(traces.size());
+    _dropped = 0;
+  } else {
+    traces = _traces;
+  }
+
+  // Once the ring buffer is full the oldest trace is the one to be overwritten next.
+  if (traces.size() == _capacity) std::rotate(traces.begin(), traces.begin() + _next, traces.end());
+  if (clear) _next = 0;
+
+  return traces;
+}
+
+uint64_t RequestTracer::getDropped() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _dropped;
+}
+
+uint64_t RequestTracer::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+}  // namespace ucxx
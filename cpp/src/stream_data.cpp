@@ -0,0 +1,50 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <memory>
+
+#include <ucp/api/ucp.h>
+
+#include <ucxx/endpoint.h>
+#include <ucxx/log.h>
+#include <ucxx/stream_data.h>
+#include <ucxx/worker.h>
+
+namespace ucxx {
+
+StreamData::StreamData(std::shared_ptr<Endpoint> endpoint, void* data, size_t length)
+  : _endpoint(endpoint), _data(data), _length(length)
+{
+}
+
+std::shared_ptr<StreamData> createStreamData(std::shared_ptr<Endpoint> endpoint,
+                                             void* data,
+                                             size_t length)
+{
+  return std::shared_ptr<StreamData>(new StreamData(endpoint, data, length));
+}
+
+StreamData::~StreamData() { release(); }
+
+const void* StreamData::data() const { return _data; }
+
+size_t StreamData::size() const { return _length; }
+
+void StreamData::release()
+{
+  if (_data == nullptr) return;
+
+  // The data can only be returned to UCX while the endpoint handle is still valid.
+  _endpoint->getWorker()->scheduleSerialized([endpoint = _endpoint, data = _data]() {
+    if (auto handle = endpoint->getHandle())
+      ucp_stream_data_release(handle, data);
+    else
+      ucxx_debug("ucxx::StreamData::release, data: %p, endpoint closed before release", data);
+  });
+
+  _data   = nullptr;
+  _length = 0;
+}
+
+}  // namespace ucxx
@@ -0,0 +1,193 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <ucxx/log.h>
+#include <ucxx/request_tag.h>
+#include <ucxx/tag_recv_ring.h>
+#include <ucxx/worker.h>
+
+namespace ucxx {
+
+TagRecvRing::TagRecvRing(std::shared_ptr<Worker> worker,
+                         size_t numBuffers,
+                         size_t bufferSize,
+                         Tag tag,
+                         TagMask tagMask,
+                         TagRecvRingCallback callback)
+  : _worker(worker), _tag(tag), _tagMask(tagMask), _bufferSize(bufferSize), _callback(callback)
+{
+  if (_worker == nullptr) throw std::invalid_argument("A worker is required");
+  if (numBuffers == 0) throw std::invalid_argument("The number of buffers must be positive");
+  if (_bufferSize == 0) throw std::invalid_argument("The buffer size must be positive");
+
+  _slots.resize(numBuffers);
+  for (auto& slot : _slots)
+    slot.buffer = std::make_shared<std::vector<char>>(_bufferSize);
+}
+
+std::shared_ptr<TagRecvRing> createTagRecvRing(std::shared_ptr<Worker> worker,
+                                               size_t numBuffers,
+                                               size_t bufferSize,
+                                               Tag tag,
+                                               TagMask tagMask,
+                                               TagRecvRingCallback callback)
+{
+  auto ring = std::shared_ptr<TagRecvRing>(
+    new TagRecvRing(worker, numBuffers, bufferSize, tag, tagMask, callback));
+
+  for (size_t slot = 0; slot < ring->_slots.size(); ++slot)
+    ring->post(slot);
+
+  ucxx_trace("ucxx::TagRecvRing created: %p, buffers: %lu, size: %lu, tag: 0x%lx, tagMask: 0x%lx",
+             ring.get(),
+             numBuffers,
+             bufferSize,
+             tag,
+             tagMask);
+
+  return ring;
+}
+
+TagRecvRing::~TagRecvRing() { stop(); }
+
+void TagRecvRing::post(size_t slot)
+{
+  std::shared_ptr<std::vector<char>> buffer{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_stopped) return;
+    _slots[slot].request   = nullptr;
+    _slots[slot].completed = false;
+    buffer                 = _slots[slot].buffer;
+  }
+
+  // The request holds a reference to the buffer as its callback data, so that the buffer
+  // outlives the receive even if the ring is destroyed first.
+  std::weak_ptr<TagRecvRing> weakRing = shared_from_this();
+  auto request                        = std::static_pointer_cast<RequestTag>(_worker->tagRecv(
+    buffer->data(),
+    buffer->size(),
+    _tag,
+    _tagMask,
+    false,
+    [weakRing, slot](ucs_status_t status, RequestCallbackUserData) {
+      if (auto ring = weakRing.lock()) ring->onCompletion(slot, status);
+    },
+    buffer));
+
+  bool completed      = false;
+  bool stopped        = false;
+  ucs_status_t status = UCS_OK;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _slots[slot].request = request;
+    completed            = _slots[slot].completed;
+    status               = _slots[slot].status;
+    stopped              = _stopped;
+  }
+
+  if (completed)
+    deliver(slot, status);
+  else if (stopped)
+    request->cancel();
+}
+
+void TagRecvRing::onCompletion(size_t slot, ucs_status_t status)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_slots[slot].request == nullptr) {
+      // Completed before `post()` stored the request, let it deliver the completion.
+      _slots[slot].completed = true;
+      _slots[slot].status    = status;
+      return;
+    }
+  }
+
+  deliver(slot, status);
+}
+
+void TagRecvRing::deliver(size_t slot, ucs_status_t status)
+{
+  // Receives are only canceled when the ring or the worker are stopping.
+  if (status == UCS_ERR_CANCELED) return;
+
+  std::shared_ptr<RequestTag> request{nullptr};
+  TagRecvRingCompletion completion{};
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    request    = _slots[slot].request;
+    completion = {slot, _slots[slot].buffer->data(), {}, status};
+    ++_received;
+  }
+  completion.info = request->getRecvInfo();
+
+  if (!_callback) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _completions.push_back(completion);
+    return;
+  }
+
+  try {
+    _callback(completion);
+  } catch (const std::exception& e) {
+    ucxx_error("ucxx::TagRecvRing::%s, callback raised: %s", __func__, e.what());
+  }
+
+  post(slot);
+}
+
+size_t TagRecvRing::poll(std::vector<TagRecvRingCompletion>& completions, size_t maxCompletions)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const size_t count = std::min(maxCompletions, _completions.size());
+  std::move(
+    _completions.begin(), _completions.begin() + count, std::back_inserter(completions));
+  _completions.erase(_completions.begin(), _completions.begin() + count);
+  return count;
+}
+
+void TagRecvRing::release(size_t slot)
+{
+  if (_callback)
+    throw std::runtime_error("Ring buffers are released automatically when a callback is set");
+  if (slot >= _slots.size()) throw std::out_of_range("Invalid ring buffer index");
+
+  post(slot);
+}
+
+void TagRecvRing::stop()
+{
+  std::vector<std::shared_ptr<RequestTag>> requests;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_stopped) return;
+    _stopped = true;
+    for (const auto& slot : _slots)
+      if (slot.request != nullptr && !slot.request->isCompleted()) requests.push_back(slot.request);
+  }
+
+  for (auto& request : requests)
+    request->cancel();
+}
+
+size_t TagRecvRing::getNumBuffers() const { return _slots.size(); }
+
+size_t TagRecvRing::getBufferSize() const { return _bufferSize; }
+
+uint64_t TagRecvRing::getReceivedCount()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _received;
+}
+
+}  // namespace ucxx
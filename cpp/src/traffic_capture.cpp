@@ -0,0 +1,286 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <ucxx/log.h>
+#include <ucxx/memory_handle.h>
+#include <ucxx/traffic_capture.h>
+#include <ucxx/utils/cuda.h>
+
+namespace ucxx {
+
+namespace {
+
+constexpr char magic[]     = "UCXXCAP";
+constexpr uint8_t version  = 1;
+constexpr size_t blockSize = 64 << 10;
+
+void writeVarint(std::vector<uint8_t>& buffer, uint64_t value)
+{
+  for (; value >= 0x80; value >>= 7)
+    buffer.push_back(static_cast<uint8_t>(value | 0x80));
+  buffer.push_back(static_cast<uint8_t>(value));
+}
+
+const uint8_t* readVarint(const uint8_t* ptr, const uint8_t* end, uint64_t& value)
+{
+  value = 0;
+  for (size_t shift = 0; ptr < end && shift < sizeof(uint64_t) * 8; shift += 7) {
+    const uint8_t byte = *ptr++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) return ptr;
+  }
+  throw std::runtime_error("Malformed traffic capture trace.");
+}
+
+void replaceAll(std::string& str, const std::string& pattern, const std::string& replacement)
+{
+  for (auto pos = str.find(pattern); pos != std::string::npos;
+       pos      = str.find(pattern, pos + replacement.size()))
+    str.replace(pos, pattern.size(), replacement);
+}
+
+uint64_t now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+ucs_memory_type_t getMemoryType(const std::shared_ptr<MemoryHandle>& memoryHandle,
+                                const void* buffer,
+                                const std::vector<ucp_dt_iov_t>& iov)
+{
+  if (memoryHandle) return memoryHandle->getMemoryType();
+  return utils::getPointerMemoryType(iov.empty() ? buffer : iov.front().buffer);
+}
+
+}  // namespace
+
+TrafficCapture::~TrafficCapture() { stop(); }
+
+void TrafficCapture::start(const std::string& path)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (_file.is_open()) {
+    flushBuffer();
+    _file.close();
+  }
+
+  _file.open(path, std::ios::binary | std::ios::trunc);
+  if (!_file.is_open())
+    throw std::ios_base::failure("Failed to open traffic capture file " + path);
+  _path = path;
+
+  _buffer.assign(magic, magic + sizeof(magic) - 1);
+  _buffer.push_back(version);
+  _endpoints.clear();
+  _recorded = 0;
+  _lastNs   = now();
+  _enabled.store(true, std::memory_order_relaxed);
+}
+
+void TrafficCapture::startFromEnvironment()
+{
+  const char* pathEnv = std::getenv("UCXX_TRAFFIC_CAPTURE");
+  if (pathEnv == nullptr || *pathEnv == '\0') return;
+
+  // Workers of the same process would otherwise truncate and interleave the same trace
+  static std::atomic<uint64_t> nextIndex{0};
+  const uint64_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+
+  std::string path{pathEnv};
+  replaceAll(path, "%p", std::to_string(getpid()));
+  if (path.find("%w") != std::string::npos)
+    replaceAll(path, "%w", std::to_string(index));
+  else if (index > 0)
+    path += "." + std::to_string(index);
+
+  try {
+    start(path);
+    ucxx_info("UCXX_TRAFFIC_CAPTURE: %s", path.c_str());
+  } catch (const std::exception& e) {
+    ucxx_warn("Invalid UCXX_TRAFFIC_CAPTURE (%s), traffic capture disabled: %s",
+              pathEnv,
+              e.what());
+  }
+}
+
+void TrafficCapture::stop()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  _enabled.store(false, std::memory_order_relaxed);
+  if (!_file.is_open()) return;
+
+  flushBuffer();
+  _file.close();
+}
+
+void TrafficCapture::flushBuffer()
+{
+  _file.write(reinterpret_cast<const char*>(_buffer.data()), _buffer.size());
+  _buffer.clear();
+}
+
+void TrafficCapture::record(const data::RequestData& requestData, const void* endpoint)
+{
+  if (!isEnabled()) return;
+
+  CaptureRecord record{};
+  bool captured = std::visit(
+    data::dispatch{
+      [&record](const data::TagSend& tagSend) {
+        record.operation  = CaptureOperation::TagSend;
+        record.memoryType = getMemoryType(tagSend._memoryHandle, tagSend._buffer, tagSend._iov);
+        record.size       = tagSend._length;
+        record.count      = tagSend._iov.empty() ? 1 : tagSend._iov.size();
+        record.tag        = tagSend._tag;
+        return true;
+      },
+      [&record](const data::TagReceive& tagReceive) {
+        record.operation = CaptureOperation::TagReceive;
+        record.memoryType =
+          getMemoryType(tagReceive._memoryHandle, tagReceive._buffer, tagReceive._iov);
+        record.size  = tagReceive._length;
+        record.count = tagReceive._iov.empty() ? 1 : tagReceive._iov.size();
+        record.tag   = tagReceive._tag;
+        return true;
+      },
+      [&record](const data::StreamSend& streamSend) {
+        record.operation  = CaptureOperation::StreamSend;
+        record.memoryType = getMemoryType(nullptr, streamSend._buffer, streamSend._iov);
+        record.size       = streamSend._length;
+        record.count      = streamSend._iov.empty() ? 1 : streamSend._iov.size();
+        return true;
+      },
+      [&record](const data::StreamReceive& streamReceive) {
+        record.operation  = CaptureOperation::StreamReceive;
+        record.memoryType = getMemoryType(nullptr, streamReceive._buffer, {});
+        record.size       = streamReceive._length;
+        return true;
+      },
+      [&record](const data::AmSend& amSend) {
+        record.operation  = CaptureOperation::AmSend;
+        record.memoryType = amSend._memoryType;
+        record.size       = amSend._length;
+        return true;
+      },
+      [&record](const data::AmReceive&) {
+        // Size and memory type are only known once the message arrives.
+        record.operation = CaptureOperation::AmReceive;
+        record.size      = 0;
+        return true;
+      },
+      [&record](const data::MemPut& memPut) {
+        record.operation  = CaptureOperation::MemPut;
+        record.memoryType = getMemoryType(memPut._memoryHandle, memPut._buffer, {});
+        record.size       = memPut._length;
+        return true;
+      },
+      [&record](const data::MemGet& memGet) {
+        record.operation  = CaptureOperation::MemGet;
+        record.memoryType = getMemoryType(memGet._memoryHandle, memGet._buffer, {});
+        record.size       = memGet._length;
+        return true;
+      },
+      // Multi-buffer and file transfers are captured as the tag messages composing them.
+      [](const auto&) { return false; },
+    },
+    requestData);
+
+  if (captured) this->record(record, endpoint);
+}
+
+void TrafficCapture::record(CaptureRecord record, const void* endpoint)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_file.is_open()) return;
+
+  uint64_t endpointIndex = 0;
+  if (endpoint != nullptr) {
+    auto it = _endpoints.try_emplace(endpoint, _endpoints.size() + 1).first;
+    endpointIndex = it->second;
+  }
+
+  const uint64_t timestamp = now();
+
+  _buffer.push_back(static_cast<uint8_t>(record.operation));
+  _buffer.push_back(static_cast<uint8_t>(record.memoryType));
+  writeVarint(_buffer, endpointIndex);
+  writeVarint(_buffer, timestamp - _lastNs);
+  writeVarint(_buffer, record.size);
+  writeVarint(_buffer, record.count);
+  writeVarint(_buffer, record.tag);
+
+  _lastNs = timestamp;
+  ++_recorded;
+
+  if (_buffer.size() >= blockSize) flushBuffer();
+}
+
+uint64_t TrafficCapture::getRecorded()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _recorded;
+}
+
+std::string TrafficCapture::getPath()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _path;
+}
+
+std::vector<CaptureRecord> TrafficCapture::read(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) throw std::ios_base::failure("Failed to open traffic capture file " + path);
+
+  const std::vector<uint8_t> contents{std::istreambuf_iterator<char>(file),
+                                      std::istreambuf_iterator<char>()};
+
+  const size_t headerSize = sizeof(magic);
+  if (contents.size() < headerSize || std::memcmp(contents.data(), magic, headerSize - 1) != 0)
+    throw std::runtime_error(path + " is not a traffic capture trace.");
+  if (contents[headerSize - 1] != version)
+    throw std::runtime_error(path + " has an unsupported traffic capture version.");
+
+  std::vector<CaptureRecord> records;
+  const uint8_t* ptr = contents.data() + headerSize;
+  const uint8_t* end = contents.data() + contents.size();
+  while (ptr < end) {
+    if (end - ptr < 2) throw std::runtime_error("Malformed traffic capture trace.");
+
+    CaptureRecord record{};
+    record.operation  = static_cast<CaptureOperation>(*ptr++);
+    record.memoryType = static_cast<ucs_memory_type_t>(*ptr++);
+    if (record.operation > CaptureOperation::MemGet)
+      throw std::runtime_error("Malformed traffic capture trace.");
+
+    ptr = readVarint(ptr, end, record.endpoint);
+    ptr = readVarint(ptr, end, record.interArrivalNs);
+    ptr = readVarint(ptr, end, record.size);
+    ptr = readVarint(ptr, end, record.count);
+    ptr = readVarint(ptr, end, record.tag);
+    records.push_back(record);
+  }
+
+  return records;
+}
+
+}  // namespace ucxx
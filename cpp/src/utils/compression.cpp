@@ -0,0 +1,122 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#if UCXX_ENABLE_LZ4
+#include <lz4.h>
+#endif
+#if UCXX_ENABLE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <ucxx/utils/compression.h>
+
+namespace ucxx {
+
+namespace utils {
+
+bool isCompressionCodecAvailable(CompressionCodec codec)
+{
+  switch (codec) {
+    case CompressionCodec::None: return true;
+#if UCXX_ENABLE_LZ4
+    case CompressionCodec::LZ4: return true;
+#endif
+#if UCXX_ENABLE_ZSTD
+    case CompressionCodec::Zstd: return true;
+#endif
+    default: return false;
+  }
+}
+
+size_t getCompressBound(CompressionCodec codec, size_t length)
+{
+  switch (codec) {
+#if UCXX_ENABLE_LZ4
+    case CompressionCodec::LZ4:
+      // LZ4 sizes are `int`, larger frames are sent uncompressed.
+      if (length > LZ4_MAX_INPUT_SIZE) return 0;
+      return LZ4_compressBound(static_cast<int>(length));
+#endif
+#if UCXX_ENABLE_ZSTD
+    case CompressionCodec::Zstd: return ZSTD_compressBound(length);
+#endif
+    default: return 0;
+  }
+}
+
+size_t compress(CompressionCodec codec,
+                int level,
+                const void* source,
+                size_t length,
+                void* destination,
+                size_t destinationLength)
+{
+  switch (codec) {
+#if UCXX_ENABLE_LZ4
+    case CompressionCodec::LZ4: {
+      if (length > LZ4_MAX_INPUT_SIZE) return 0;
+      const int compressed = LZ4_compress_fast(reinterpret_cast<const char*>(source),
+                                               reinterpret_cast<char*>(destination),
+                                               static_cast<int>(length),
+                                               static_cast<int>(std::min<size_t>(
+                                                 destinationLength, LZ4_MAX_INPUT_SIZE)),
+                                               level);
+      return compressed > 0 ? compressed : 0;
+    }
+#endif
+#if UCXX_ENABLE_ZSTD
+    case CompressionCodec::Zstd: {
+      const size_t compressed =
+        ZSTD_compress(destination, destinationLength, source, length, level);
+      return ZSTD_isError(compressed) ? 0 : compressed;
+    }
+#endif
+    default: return 0;
+  }
+}
+
+void decompress(CompressionCodec codec,
+                const void* source,
+                size_t length,
+                void* destination,
+                size_t destinationLength)
+{
+  switch (codec) {
+#if UCXX_ENABLE_LZ4
+    case CompressionCodec::LZ4: {
+      if (length > LZ4_MAX_INPUT_SIZE || destinationLength > LZ4_MAX_INPUT_SIZE)
+        throw std::runtime_error("LZ4 frame is too large");
+      const int decompressed = LZ4_decompress_safe(reinterpret_cast<const char*>(source),
+                                                   reinterpret_cast<char*>(destination),
+                                                   static_cast<int>(length),
+                                                   static_cast<int>(destinationLength));
+      if (decompressed < 0 || static_cast<size_t>(decompressed) != destinationLength)
+        throw std::runtime_error("Malformed LZ4 frame");
+      return;
+    }
+#endif
+#if UCXX_ENABLE_ZSTD
+    case CompressionCodec::Zstd: {
+      const size_t decompressed = ZSTD_decompress(destination, destinationLength, source, length);
+      if (ZSTD_isError(decompressed))
+        throw std::runtime_error(std::string("Malformed Zstandard frame: ") +
+                                 ZSTD_getErrorName(decompressed));
+      if (decompressed != destinationLength) throw std::runtime_error("Malformed Zstandard frame");
+      return;
+    }
+#endif
+    default:
+      throw std::invalid_argument("Compression codec " + std::to_string(static_cast<int>(codec)) +
+                                  " is not available");
+  }
+}
+
+}  // namespace utils
+
+}  // namespace ucxx
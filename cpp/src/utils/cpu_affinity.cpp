@@ -0,0 +1,111 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <ucxx/log.h>
+#include <ucxx/utils/cpu_affinity.h>
+
+namespace ucxx {
+
+namespace utils {
+
+std::vector<int> parseCpuList(const std::string& cpuList)
+{
+  std::vector<int> cpus;
+  std::stringstream stream{cpuList};
+  std::string range;
+
+  while (std::getline(stream, range, ',')) {
+    range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+    if (range.empty()) continue;
+
+    try {
+      size_t split = range.find('-');
+      if (split == std::string::npos) {
+        cpus.push_back(std::stoi(range));
+      } else {
+        int first = std::stoi(range.substr(0, split));
+        int last  = std::stoi(range.substr(split + 1));
+        if (first > last) throw std::invalid_argument(range);
+        for (int cpu = first; cpu <= last; ++cpu)
+          cpus.push_back(cpu);
+      }
+    } catch (const std::logic_error&) {
+      throw std::invalid_argument(std::string("Invalid cpulist: ") + cpuList);
+    }
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+  return cpus;
+}
+
+static std::vector<int> getDeviceLocalCpus(const std::string& device)
+{
+  for (const auto& deviceClass : {"infiniband", "net"}) {
+    std::ifstream file{std::string("/sys/class/") + deviceClass + "/" + device +
+                       "/device/local_cpulist"};
+    std::string cpuList;
+    if (file && std::getline(file, cpuList)) return parseCpuList(cpuList);
+  }
+
+  ucxx_debug("ucxx::utils::%s, could not determine local CPUs of device %s",
+             __func__,
+             device.c_str());
+  return {};
+}
+
+std::vector<int> getNetworkDevicesLocalCpus(const std::string& netDevices)
+{
+  std::vector<int> cpus;
+  std::stringstream stream{netDevices};
+  std::string device;
+
+  while (std::getline(stream, device, ',')) {
+    // Strip port, e.g. "mlx5_0:1"
+    device = device.substr(0, device.find(':'));
+    if (device.empty() || device == "all") continue;
+
+    auto deviceCpus = getDeviceLocalCpus(device);
+    cpus.insert(cpus.end(), deviceCpus.begin(), deviceCpus.end());
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+  return cpus;
+}
+
+void setThreadCpuAffinity(const std::vector<int>& cpus)
+{
+  if (cpus.empty()) return;
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (const auto& cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+      throw std::runtime_error(std::string("Invalid CPU index: ") + std::to_string(cpu));
+    CPU_SET(cpu, &cpuSet);
+  }
+
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+  if (err != 0)
+    throw std::runtime_error(std::string("pthread_setaffinity_np() failed: ") + strerror(err));
+}
+
+}  // namespace utils
+
+}  // namespace ucxx
@@ -0,0 +1,205 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <dlfcn.h>
+
+#include <ucxx/log.h>
+#include <ucxx/utils/cuda.h>
+
+namespace ucxx {
+
+namespace utils {
+
+namespace {
+
+/**
+ * @brief The subset of the CUDA driver API used to set up CUDA contexts.
+ *
+ * Loaded at runtime from `libcuda.so.1`, with the types of `cuda.h` replaced by their
+ * underlying types, so that neither the CUDA toolkit is required to build nor the CUDA
+ * driver to run.
+ */
+struct CudaDriver {
+  typedef int (*InitFunction)(unsigned int);
+  typedef int (*DeviceGetFunction)(int*, int);
+  typedef int (*PrimaryCtxRetainFunction)(void**, int);
+  typedef int (*CtxSetCurrentFunction)(void*);
+  typedef int (*CtxGetCurrentFunction)(void**);
+  typedef int (*CtxGetDeviceFunction)(int*);
+
+  InitFunction init{nullptr};
+  DeviceGetFunction deviceGet{nullptr};
+  PrimaryCtxRetainFunction primaryCtxRetain{nullptr};
+  CtxSetCurrentFunction ctxSetCurrent{nullptr};
+  CtxGetCurrentFunction ctxGetCurrent{nullptr};
+  CtxGetDeviceFunction ctxGetDevice{nullptr};
+  bool available{false};
+};
+
+const CudaDriver& getCudaDriver()
+{
+  static CudaDriver driver{};
+  static std::once_flag loadFlag{};
+
+  std::call_once(loadFlag, []() {
+    void* lib = dlopen("libcuda.so.1", RTLD_LAZY | RTLD_LOCAL);
+    if (lib == nullptr) {
+      ucxx_debug("dlopen('libcuda.so.1') failed");
+      return;
+    }
+
+    driver.init = reinterpret_cast<CudaDriver::InitFunction>(dlsym(lib, "cuInit"));
+    driver.deviceGet =
+      reinterpret_cast<CudaDriver::DeviceGetFunction>(dlsym(lib, "cuDeviceGet"));
+    driver.primaryCtxRetain = reinterpret_cast<CudaDriver::PrimaryCtxRetainFunction>(
+      dlsym(lib, "cuDevicePrimaryCtxRetain"));
+    driver.ctxSetCurrent =
+      reinterpret_cast<CudaDriver::CtxSetCurrentFunction>(dlsym(lib, "cuCtxSetCurrent"));
+    driver.ctxGetCurrent =
+      reinterpret_cast<CudaDriver::CtxGetCurrentFunction>(dlsym(lib, "cuCtxGetCurrent"));
+    driver.ctxGetDevice =
+      reinterpret_cast<CudaDriver::CtxGetDeviceFunction>(dlsym(lib, "cuCtxGetDevice"));
+
+    if (driver.init == nullptr || driver.deviceGet == nullptr ||
+        driver.primaryCtxRetain == nullptr || driver.ctxSetCurrent == nullptr ||
+        driver.ctxGetCurrent == nullptr || driver.ctxGetDevice == nullptr) {
+      ucxx_debug("libcuda.so.1 is missing required symbols");
+      return;
+    }
+
+    const int result = driver.init(0);
+    if (result != 0) {
+      ucxx_debug("cuInit() failed with error %d", result);
+      return;
+    }
+
+    driver.available = true;
+  });
+
+  return driver;
+}
+
+}  // namespace
+
+int getCudaCurrentDevice()
+{
+  const auto& driver = getCudaDriver();
+  if (!driver.available) return -1;
+
+  void* context = nullptr;
+  int device    = -1;
+  if (driver.ctxGetCurrent(&context) != 0 || context == nullptr ||
+      driver.ctxGetDevice(&device) != 0)
+    return -1;
+
+  return device;
+}
+
+bool setCudaPrimaryContext(int device)
+{
+  const auto& driver = getCudaDriver();
+  if (!driver.available) return false;
+
+  int handle    = 0;
+  void* context = nullptr;
+  int result    = driver.deviceGet(&handle, device);
+  if (result == 0) result = driver.primaryCtxRetain(&context, handle);
+  if (result == 0) result = driver.ctxSetCurrent(context);
+  if (result != 0) {
+    ucxx_warn("Failed to make the primary CUDA context of device %d current: error %d",
+              device,
+              result);
+    return false;
+  }
+
+  return true;
+}
+
+ucs_memory_type_t getPointerMemoryType(const void* pointer)
+{
+#if UCXX_ENABLE_RMM
+  cudaPointerAttributes attributes{};
+  if (pointer == nullptr || cudaPointerGetAttributes(&attributes, pointer) != cudaSuccess) {
+    // Clear the error so it is not reported by unrelated CUDA calls.
+    cudaGetLastError();
+    return UCS_MEMORY_TYPE_HOST;
+  }
+  if (attributes.type == cudaMemoryTypeDevice) return UCS_MEMORY_TYPE_CUDA;
+  if (attributes.type == cudaMemoryTypeManaged) return UCS_MEMORY_TYPE_CUDA_MANAGED;
+#endif
+  return UCS_MEMORY_TYPE_HOST;
+}
+
+#if UCXX_ENABLE_RMM
+namespace {
+
+ucs_status_t queryEvent(cudaEvent_t event)
+{
+  const cudaError_t error = cudaEventQuery(event);
+  if (error == cudaSuccess) return UCS_OK;
+  if (error == cudaErrorNotReady) return UCS_INPROGRESS;
+
+  // Clear the error so it is not reported by unrelated CUDA calls.
+  cudaGetLastError();
+  ucxx_error("ucxx::utils::%s, CUDA event %p query failed: %s",
+             __func__,
+             static_cast<void*>(event),
+             cudaGetErrorString(error));
+  return UCS_ERR_IO_ERROR;
+}
+
+}  // namespace
+
+RequestReadinessCallback cudaEventReadiness(cudaEvent_t event)
+{
+  return [event]() { return queryEvent(event); };
+}
+
+RequestReadinessCallback cudaStreamReadiness(cudaStream_t stream)
+{
+  cudaEvent_t event;
+  cudaError_t error = cudaEventCreateWithFlags(&event, cudaEventDisableTiming);
+  if (error != cudaSuccess) {
+    cudaGetLastError();
+    throw std::runtime_error(std::string("cudaEventCreateWithFlags() failed: ") +
+                             cudaGetErrorString(error));
+  }
+
+  auto ownedEvent = std::shared_ptr<std::remove_pointer_t<cudaEvent_t>>(
+    event, [](cudaEvent_t event) { cudaEventDestroy(event); });
+
+  error = cudaEventRecord(event, stream);
+  if (error != cudaSuccess) {
+    cudaGetLastError();
+    throw std::runtime_error(std::string("cudaEventRecord() failed: ") +
+                             cudaGetErrorString(error));
+  }
+
+  return [ownedEvent]() { return queryEvent(ownedEvent.get()); };
+}
+
+RequestCompletionFlagWriter cudaCompletionFlag(uint32_t* flag, cudaStream_t stream)
+{
+  return [flag, stream](uint32_t word) {
+    // Copies from pageable memory return once staged, thus `word` may go out of scope.
+    cudaError_t error =
+      cudaMemcpyAsync(flag, &word, sizeof(word), cudaMemcpyHostToDevice, stream);
+    if (error != cudaSuccess) {
+      cudaGetLastError();
+      ucxx_error("ucxx::utils::cudaCompletionFlag: cudaMemcpyAsync() failed: %s",
+                 cudaGetErrorString(error));
+    }
+  };
+}
+#endif
+
+}  // namespace utils
+
+}  // namespace ucxx
@@ -0,0 +1,78 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#include <ucxx/utils/memory_pool.h>
+
+namespace ucxx {
+
+namespace utils {
+
+MemoryPool::MemoryPool(size_t maxCachedBlocks) : _maxCachedBlocks(maxCachedBlocks) {}
+
+MemoryPool::~MemoryPool()
+{
+  for (auto& freeList : _freeLists) {
+    std::lock_guard<std::mutex> lock(freeList.mutex);
+    for (auto& block : freeList.blocks)
+      ::operator delete(block);
+    freeList.blocks.clear();
+  }
+}
+
+void* MemoryPool::allocate(size_t size)
+{
+  if (size == 0 || size > MaxBlockSize) return ::operator new(size);
+
+  const size_t sizeClass = (size - 1) / BlockGranularity;
+  auto& freeList         = _freeLists[sizeClass];
+  {
+    std::lock_guard<std::mutex> lock(freeList.mutex);
+    if (!freeList.blocks.empty()) {
+      void* block = freeList.blocks.back();
+      freeList.blocks.pop_back();
+      return block;
+    }
+  }
+
+  return ::operator new((sizeClass + 1) * BlockGranularity);
+}
+
+void MemoryPool::deallocate(void* ptr, size_t size)
+{
+  if (ptr == nullptr) return;
+
+  if (size == 0 || size > MaxBlockSize) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  auto& freeList = _freeLists[(size - 1) / BlockGranularity];
+  {
+    std::lock_guard<std::mutex> lock(freeList.mutex);
+    if (freeList.blocks.size() < _maxCachedBlocks) {
+      freeList.blocks.push_back(ptr);
+      return;
+    }
+  }
+
+  ::operator delete(ptr);
+}
+
+size_t MemoryPool::getCachedBlocks()
+{
+  size_t cached = 0;
+  for (auto& freeList : _freeLists) {
+    std::lock_guard<std::mutex> lock(freeList.mutex);
+    cached += freeList.blocks.size();
+  }
+  return cached;
+}
+
+}  // namespace utils
+
+}  // namespace ucxx
@@ -0,0 +1,184 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <ucxx/log.h>
+#include <ucxx/utils/topology.h>
+
+namespace ucxx {
+
+namespace utils {
+
+static std::string getHostId()
+{
+  std::ifstream file{"/proc/sys/kernel/random/boot_id"};
+  std::string bootId;
+  if (file && std::getline(file, bootId) && !bootId.empty()) return bootId;
+
+  char hostname[HOST_NAME_MAX + 1]{};
+  if (gethostname(hostname, sizeof(hostname) - 1) == 0) return hostname;
+
+  return {};
+}
+
+static void addDevice(Topology& topology, const std::string& sysfsDevice)
+{
+  char* devicePath = realpath(sysfsDevice.c_str(), nullptr);
+  if (devicePath == nullptr) {
+    ucxx_debug("ucxx::utils::%s, could not determine location of device %s",
+               __func__,
+               sysfsDevice.c_str());
+    return;
+  }
+  std::string path{devicePath};
+  free(devicePath);
+
+  // Keep only the path from the root complex, e.g., "pci0000:00/0000:00:01.0/0000:01:00.0"
+  const std::string prefix{"/sys/devices/"};
+  if (path.compare(0, prefix.size(), prefix) == 0) path = path.substr(prefix.size());
+  if (path.compare(0, 3, "pci") == 0) topology.pciPaths.push_back(path);
+
+  std::ifstream file{sysfsDevice + "/numa_node"};
+  int numaNode = -1;
+  if (file >> numaNode && numaNode >= 0) topology.numaNodes.push_back(numaNode);
+}
+
+static std::string normalizePciBusId(std::string pciBusId)
+{
+  std::transform(pciBusId.begin(), pciBusId.end(), pciBusId.begin(), ::tolower);
+
+  // CUDA may report a 32-bit domain, e.g. "00000000:3b:00.0", sysfs uses 16 bits.
+  size_t split = pciBusId.find(':');
+  if (split != std::string::npos && split > 4) pciBusId = pciBusId.substr(split - 4);
+
+  return pciBusId;
+}
+
+Topology getTopology(const std::string& netDevices, const std::vector<std::string>& pciBusIds)
+{
+  Topology topology{};
+  topology.hostId = getHostId();
+
+  std::stringstream stream{netDevices};
+  std::string device;
+  while (std::getline(stream, device, ',')) {
+    // Strip port, e.g. "mlx5_0:1"
+    device = device.substr(0, device.find(':'));
+    if (device.empty() || device == "all") continue;
+
+    for (const auto& deviceClass : {"infiniband", "net"}) {
+      std::string sysfsDevice = std::string("/sys/class/") + deviceClass + "/" + device;
+      if (access(sysfsDevice.c_str(), F_OK) == 0) {
+        addDevice(topology, sysfsDevice + "/device");
+        break;
+      }
+    }
+  }
+
+  for (const auto& pciBusId : pciBusIds)
+    addDevice(topology, "/sys/bus/pci/devices/" + normalizePciBusId(pciBusId));
+
+  std::sort(topology.numaNodes.begin(), topology.numaNodes.end());
+  topology.numaNodes.erase(std::unique(topology.numaNodes.begin(), topology.numaNodes.end()),
+                           topology.numaNodes.end());
+
+  return topology;
+}
+
+static std::vector<std::string> splitPath(const std::string& path)
+{
+  std::vector<std::string> components;
+  std::stringstream stream{path};
+  std::string component;
+  while (std::getline(stream, component, '/'))
+    if (!component.empty()) components.push_back(component);
+  return components;
+}
+
+static bool isSamePcieSwitch(const std::string& path1, const std::string& path2)
+{
+  if (path1 == path2) return true;
+
+  // Devices behind the same switch share the root complex, root port and switch upstream
+  // port, e.g. "pci0000:00/0000:00:01.0/0000:01:00.0/...".
+  auto components1 = splitPath(path1);
+  auto components2 = splitPath(path2);
+  auto mismatch =
+    std::mismatch(components1.begin(), components1.end(), components2.begin(), components2.end());
+
+  return std::distance(components1.begin(), mismatch.first) >= 3;
+}
+
+TopologyLocality getTopologyLocality(const Topology& local, const Topology& remote)
+{
+  if (local.hostId.empty() || local.hostId != remote.hostId) return TopologyLocality::Remote;
+
+  for (const auto& localPath : local.pciPaths)
+    for (const auto& remotePath : remote.pciPaths)
+      if (isSamePcieSwitch(localPath, remotePath)) return TopologyLocality::SamePcieSwitch;
+
+  for (const auto& numaNode : local.numaNodes)
+    if (std::binary_search(remote.numaNodes.begin(), remote.numaNodes.end(), numaNode))
+      return TopologyLocality::SameNumaNode;
+
+  return TopologyLocality::SameHost;
+}
+
+std::string serializeTopology(const Topology& topology)
+{
+  std::stringstream stream;
+
+  stream << topology.hostId << "\n";
+  for (size_t i = 0; i < topology.numaNodes.size(); ++i)
+    stream << (i == 0 ? "" : ",") << topology.numaNodes[i];
+  stream << "\n";
+  for (size_t i = 0; i < topology.pciPaths.size(); ++i)
+    stream << (i == 0 ? "" : ",") << topology.pciPaths[i];
+  stream << "\n";
+
+  return stream.str();
+}
+
+Topology deserializeTopology(const std::string& serializedTopology)
+{
+  Topology topology{};
+  std::stringstream stream{serializedTopology};
+  std::string numaNodes, pciPaths;
+
+  if (!std::getline(stream, topology.hostId) || !std::getline(stream, numaNodes) ||
+      !std::getline(stream, pciPaths))
+    throw std::invalid_argument("Invalid serialized topology");
+
+  try {
+    std::stringstream numaStream{numaNodes};
+    std::string numaNode;
+    while (std::getline(numaStream, numaNode, ','))
+      topology.numaNodes.push_back(std::stoi(numaNode));
+  } catch (const std::logic_error&) {
+    throw std::invalid_argument("Invalid serialized topology");
+  }
+  std::sort(topology.numaNodes.begin(), topology.numaNodes.end());
+
+  std::stringstream pciStream{pciPaths};
+  std::string pciPath;
+  while (std::getline(pciStream, pciPath, ','))
+    if (!pciPath.empty()) topology.pciPaths.push_back(pciPath);
+
+  return topology;
+}
+
+}  // namespace utils
+
+}  // namespace ucxx
@@ -14,11 +14,12 @@ namespace utils {
 
 void ucsErrorThrow(const ucs_status_t status, const std::string& userMessage)
 {
+  // Avoid building the message on the common path.
+  if (status == UCS_OK || status == UCS_INPROGRESS) return;
+
   std::string message = userMessage.empty() ? ucs_status_string(status) : userMessage;
 
   switch (status) {
-    case UCS_OK: return;
-    case UCS_INPROGRESS: return;
     case UCS_ERR_NO_MESSAGE: throw ucxx::NoMessageError(message); return;
     case UCS_ERR_NO_RESOURCE: throw ucxx::NoResourceError(message); return;
     case UCS_ERR_IO_ERROR: throw ucxx::IOError(message); return;
@@ -2,14 +2,23 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <functional>
 #include <ios>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_set>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include <sys/epoll.h>
@@ -17,11 +26,22 @@
 #include <unistd.h>
 
 #include <ucxx/buffer.h>
+#include <ucxx/completion_queue.h>
+#include <ucxx/endpoint.h>
 #include <ucxx/internal/request_am.h>
 #include <ucxx/request_am.h>
+#include <ucxx/request_data.h>
+#include <ucxx/request_endpoint_close.h>
+#include <ucxx/request_flush.h>
 #include <ucxx/request_tag.h>
+#include <ucxx/tag_recv_ring.h>
 #include <ucxx/utils/callback_notifier.h>
+#include <ucxx/utils/compression.h>
+#include <ucxx/utils/cpu_affinity.h>
+#include <ucxx/utils/cuda.h>
 #include <ucxx/utils/file_descriptor.h>
+#include <ucxx/utils/topology.h>
+#include <ucxx/utils/nvtx.h>
 #include <ucxx/utils/ucx.h>
 #include <ucxx/worker.h>
 
@@ -29,43 +49,56 @@ namespace ucxx {
 
 Worker::Worker(std::shared_ptr<Context> context,
                const bool enableDelayedSubmission,
-               const bool enableFuture)
-  : _enableFuture(enableFuture)
+               const bool enableFuture,
+               const bool enableSerializedThreadMode)
+  : _enableSerializedThreadMode(enableSerializedThreadMode), _enableFuture(enableFuture)
 {
   if (context == nullptr || context->getHandle() == nullptr)
     throw std::runtime_error("Context not initialized");
+  if (enableSerializedThreadMode && !enableDelayedSubmission)
+    throw std::invalid_argument("Serialized thread mode requires delayed submission");
 
+  // With serialized thread mode UCXX guarantees only one thread accesses the UCP worker
+  // at a time, allowing UCX to skip locking the worker on every call.
+  const ucs_thread_mode_t threadMode =
+    enableSerializedThreadMode ? UCS_THREAD_MODE_SERIALIZED : UCS_THREAD_MODE_MULTI;
   ucp_worker_params_t params = {.field_mask  = UCP_WORKER_PARAM_FIELD_THREAD_MODE,
-                                .thread_mode = UCS_THREAD_MODE_MULTI};
+                                .thread_mode = threadMode};
   utils::ucsErrorThrow(ucp_worker_create(context->getHandle(), &params, &_handle));
 
   _delayedSubmissionCollection =
     std::make_shared<DelayedSubmissionCollection>(enableDelayedSubmission);
 
   if (context->getFeatureFlags() & UCP_FEATURE_AM) {
-    unsigned int AM_MSG_ID            = 0;
-    _amData                           = std::make_shared<internal::AmData>();
-    _amData->_registerInflightRequest = [this](std::shared_ptr<Request> req) {
-      this->registerInflightRequest(req);
-    };
-    registerAmAllocator(UCS_MEMORY_TYPE_HOST,
-                        [](size_t length) { return std::make_shared<HostBuffer>(length); });
-
-    ucp_am_handler_param_t am_handler_param = {.field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID |
-                                                             UCP_AM_HANDLER_PARAM_FIELD_CB |
-                                                             UCP_AM_HANDLER_PARAM_FIELD_ARG,
-                                               .id  = AM_MSG_ID,
-                                               .cb  = RequestAm::recvCallback,
-                                               .arg = _amData.get()};
+    createAmData(0, nullptr, {});
+
+    ucp_am_handler_param_t am_handler_param = {
+      .field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID | UCP_AM_HANDLER_PARAM_FIELD_CB |
+                    UCP_AM_HANDLER_PARAM_FIELD_ARG,
+      .id  = internal::AmFlowControlId,
+      .cb  = Worker::amCreditCallback,
+      .arg = this};
+    utils::ucsErrorThrow(ucp_worker_set_am_recv_handler(_handle, &am_handler_param));
+
+    am_handler_param.id = internal::AmAggregationId;
+    am_handler_param.cb = Worker::amAggregationCallback;
     utils::ucsErrorThrow(ucp_worker_set_am_recv_handler(_handle, &am_handler_param));
   }
 
+  // Specialized implementations, such as the Python worker, may replace the notifier.
+  if (_enableFuture) _notifier = createCompletionQueue();
+
+  _requestTracer.configureFromEnvironment();
+  _trafficCapture.startFromEnvironment();
+
   ucxx_trace(
-    "ucxx::Worker created: %p, UCP handle: %p, enableDelayedSubmission: %d, enableFuture: %d",
+    "ucxx::Worker created: %p, UCP handle: %p, enableDelayedSubmission: %d, enableFuture: %d, "
+    "enableSerializedThreadMode: %d",
     this,
     _handle,
     enableDelayedSubmission,
-    _enableFuture);
+    _enableFuture,
+    _enableSerializedThreadMode);
 
   setParent(std::dynamic_pointer_cast<Component>(context));
 }
@@ -75,56 +108,189 @@ static void _drainCallback(void* request,
                            const ucp_tag_recv_info_t* info,
                            void* arg)
 {
-  *reinterpret_cast<ucs_status_t*>(request) = status;
+  *reinterpret_cast<ucs_status_t*>(arg) = status;
 }
 
-void Worker::drainWorkerTagRecv()
+size_t Worker::drainWorkerTagRecv()
 {
   auto context = std::dynamic_pointer_cast<Context>(_parent);
-  if (!(context->getFeatureFlags() & UCP_FEATURE_TAG)) return;
-
-  ucp_tag_message_h message;
-  ucp_tag_recv_info_t info;
+  if (!(context->getFeatureFlags() & UCP_FEATURE_TAG)) return 0;
 
-  while ((message = ucp_tag_probe_nb(_handle, 0, 0, 1, &info)) != NULL) {
-    ucxx_debug(
-      "ucxx::Worker::%s, Worker: %p, UCP handle: %p, tag: 0x%lx, length: %lu, "
-      "draining tag receive messages",
-      __func__,
-      this,
-      _handle,
-      info.sender_tag,
-      info.length);
+  /**
+   * A message drained by a slot, each slot reuses its scratch buffer. In `Discard` mode
+   * no data is received and the message completes as truncated.
+   */
+  struct DrainSlot {
+    std::vector<char> buffer{};
+    ucs_status_t status{UCS_OK};
+    void* request{nullptr};
+  };
+  std::vector<DrainSlot> slots(_tagDrainMaxInflight);
+  const bool discard = _tagDrainMode == TagDrainMode::Discard;
+
+  size_t drained  = 0;
+  size_t inflight = 0;
+  while (true) {
+    bool exhausted = false;
+    for (auto& slot : slots) {
+      if (slot.request != nullptr) continue;
+
+      ucp_tag_recv_info_t info;
+      ucp_tag_message_h message = ucp_tag_probe_nb(_handle, 0, 0, 1, &info);
+      if (message == nullptr) {
+        exhausted = true;
+        break;
+      }
 
-    std::vector<char> buf(info.length);
+      ucxx_debug(
+        "ucxx::Worker::%s, Worker: %p, UCP handle: %p, tag: 0x%lx, length: %lu, "
+        "draining tag receive messages",
+        __func__,
+        this,
+        _handle,
+        info.sender_tag,
+        info.length);
+
+      const size_t length = discard ? 0 : info.length;
+      if (slot.buffer.size() < length) slot.buffer.resize(length);
+
+      ucp_request_param_t param = {.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                                                   UCP_OP_ATTR_FIELD_DATATYPE |
+                                                   UCP_OP_ATTR_FIELD_USER_DATA,
+                                   .cb           = {.recv = _drainCallback},
+                                   .datatype     = ucp_dt_make_contig(1),
+                                   .user_data    = &slot.status};
+
+      slot.status             = UCS_INPROGRESS;
+      ucs_status_ptr_t status = ucp_tag_msg_recv_nbx(
+        _handle, discard ? nullptr : slot.buffer.data(), length, message, &param);
+      if (UCS_PTR_IS_PTR(status)) {
+        slot.request = status;
+        ++inflight;
+      }
+      ++drained;
+    }
 
-    ucp_request_param_t param = {
-      .op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_DATATYPE,
-      .cb           = {.recv = _drainCallback},
-      .datatype     = ucp_dt_make_contig(1)};
+    if (inflight == 0 && exhausted) break;
 
-    ucs_status_ptr_t status =
-      ucp_tag_msg_recv_nbx(_handle, buf.data(), info.length, message, &param);
+    progress();
 
-    if (status != nullptr) {
-      while (UCS_PTR_STATUS(status) == UCS_INPROGRESS)
-        progress();
+    for (auto& slot : slots) {
+      if (slot.request == nullptr || slot.status == UCS_INPROGRESS) continue;
+      ucp_request_free(slot.request);
+      slot.request = nullptr;
+      --inflight;
     }
   }
+
+  if (drained > 0)
+    ucxx_debug("ucxx::Worker::%s, Worker: %p, UCP handle: %p, drained %lu tag messages",
+               __func__,
+               this,
+               _handle,
+               drained);
+
+  return drained;
+}
+
+void Worker::setTagDrainOptions(TagDrainMode mode, size_t maxInflight)
+{
+  if (maxInflight == 0)
+    throw std::invalid_argument("The maximum number of messages drained must be positive");
+  _tagDrainMode        = mode;
+  _tagDrainMaxInflight = maxInflight;
+}
+
+static void setAmRecvHandler(ucp_worker_h handle, internal::AmData* amData)
+{
+  ucp_am_handler_param_t am_handler_param = {
+    .field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID | UCP_AM_HANDLER_PARAM_FIELD_FLAGS |
+                  UCP_AM_HANDLER_PARAM_FIELD_CB | UCP_AM_HANDLER_PARAM_FIELD_ARG,
+    .id    = amData->_amId,
+    .flags = amData->_zeroCopyEager ? UCP_AM_FLAG_PERSISTENT_DATA : 0u,
+    .cb    = RequestAm::recvCallback,
+    .arg   = amData};
+  utils::ucsErrorThrow(ucp_worker_set_am_recv_handler(handle, &am_handler_param));
+}
+
+std::shared_ptr<internal::AmData> Worker::createAmData(unsigned int amId,
+                                                       AmReceiverCallbackType receiverCallback,
+                                                       std::weak_ptr<Worker> worker)
+{
+  std::stringstream ownerStream;
+  ownerStream << "worker " << _handle;
+
+  auto amData                      = std::make_shared<internal::AmData>();
+  amData->_worker                  = worker;
+  amData->_ownerString             = ownerStream.str();
+  amData->_amId                    = amId;
+  amData->_receiverCallback        = receiverCallback;
+  amData->_registerInflightRequest = [this](std::shared_ptr<Request> req) {
+    this->registerInflightRequest(req);
+  };
+  amData->_allocators.insert_or_assign(
+    UCS_MEMORY_TYPE_HOST, [](size_t length) { return std::make_shared<HostBuffer>(length); });
+
+  {
+    std::lock_guard<std::mutex> lock(_amDataMutex);
+    if (!_amData.try_emplace(amId, amData).second)
+      throw std::runtime_error("Active message ID " + std::to_string(amId) +
+                               " is already registered");
+  }
+
+  try {
+    invokeSerialized([this, &amData]() { setAmRecvHandler(_handle, amData.get()); });
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(_amDataMutex);
+    _amData.erase(amId);
+    throw;
+  }
+
+  return amData;
+}
+
+std::shared_ptr<internal::AmData> Worker::getAmData(unsigned int amId) const
+{
+  std::lock_guard<std::mutex> lock(_amDataMutex);
+  auto amData = _amData.find(amId);
+  if (amData == _amData.end()) {
+    if (_amData.empty())
+      throw std::runtime_error("Active Messages was not enabled during context creation");
+    throw std::runtime_error("Active message ID " + std::to_string(amId) + " is not registered");
+  }
+  return amData->second;
 }
 
 std::shared_ptr<RequestAm> Worker::getAmRecv(
-  ucp_ep_h ep, std::function<std::shared_ptr<RequestAm>()> createAmRecvRequestFunction)
+  ucp_ep_h ep,
+  unsigned int amId,
+  std::function<std::shared_ptr<RequestAm>()> createAmRecvRequestFunction)
 {
-  std::lock_guard<std::mutex> lock(_amData->_mutex);
+  auto amData = getAmData(amId);
+  if (amData->_receiverCallback)
+    throw std::runtime_error("Active message ID " + std::to_string(amId) +
+                             " delivers messages to a receiver callback");
+
+  std::unique_lock<std::mutex> lock(amData->_mutex);
 
-  auto& recvPool = _amData->_recvPool;
-  auto& recvWait = _amData->_recvWait;
+  auto& recvPool = amData->_recvPool;
+  auto& recvWait = amData->_recvWait;
 
   auto reqs = recvPool.find(ep);
   if (reqs != recvPool.end() && !reqs->second.empty()) {
     auto req = reqs->second.front();
     reqs->second.pop();
+
+    // Messages sent with flow control return their credit once handed to the application.
+    auto credit = amData->_pendingCredits.find(req.get());
+    if (credit != amData->_pendingCredits.end()) {
+      auto [creditEp, length] = credit->second;
+      amData->_pendingCredits.erase(credit);
+      lock.unlock();
+      scheduleSerialized([creditEp = creditEp, length = length]() {
+        internal::sendAmCredit(creditEp, length);
+      });
+    }
     return req;
   } else {
     auto req        = createAmRecvRequestFunction();
@@ -134,21 +300,201 @@ std::shared_ptr<RequestAm> Worker::getAmRecv(
   }
 }
 
+ucs_status_t Worker::amCreditCallback(void* arg,
+                                      const void* header,
+                                      size_t header_length,
+                                      void* data,
+                                      size_t length,
+                                      const ucp_am_recv_param_t* param)
+{
+  auto worker = static_cast<Worker*>(arg);
+
+  if (header_length != sizeof(internal::AmCredit) ||
+      !(param->recv_attr & UCP_AM_RECV_ATTR_FIELD_REPLY_EP)) {
+    ucxx_debug("ucxx::Worker::%s, worker: %p, malformed active message credit", __func__, worker);
+    return UCS_OK;
+  }
+
+  internal::AmCredit credit;
+  memcpy(&credit, header, sizeof(credit));
+
+  std::shared_ptr<Endpoint> endpoint{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(worker->_amFlowControlEndpointsMutex);
+    auto it = worker->_amFlowControlEndpoints.find(param->reply_ep);
+    if (it != worker->_amFlowControlEndpoints.end()) endpoint = it->second.lock();
+  }
+
+  if (endpoint != nullptr) endpoint->grantAmCredits(credit.messages, credit.bytes);
+
+  return UCS_OK;
+}
+
+void Worker::registerAmFlowControlEndpoint(ucp_ep_h handle, std::weak_ptr<Endpoint> endpoint)
+{
+  std::lock_guard<std::mutex> lock(_amFlowControlEndpointsMutex);
+  _amFlowControlEndpoints.insert_or_assign(handle, endpoint);
+}
+
+void Worker::unregisterAmFlowControlEndpoint(ucp_ep_h handle)
+{
+  std::lock_guard<std::mutex> lock(_amFlowControlEndpointsMutex);
+  _amFlowControlEndpoints.erase(handle);
+}
+
+ucs_status_t Worker::amAggregationCallback(void* arg,
+                                           const void* header,
+                                           size_t header_length,
+                                           void* data,
+                                           size_t length,
+                                           const ucp_am_recv_param_t* param)
+{
+  auto worker = static_cast<Worker*>(arg);
+
+  if ((param->recv_attr & UCP_AM_RECV_ATTR_FLAG_RNDV) ||
+      !(param->recv_attr & UCP_AM_RECV_ATTR_FIELD_REPLY_EP)) {
+    ucxx_error("ucxx::Worker::%s, worker: %p, malformed batch of active messages",
+               __func__,
+               worker);
+    return UCS_OK;
+  }
+
+  // Messages are delivered as eager messages without persistent data, thus copied.
+  ucp_am_recv_param_t messageParam{};
+  messageParam.recv_attr = UCP_AM_RECV_ATTR_FIELD_REPLY_EP;
+  messageParam.reply_ep  = param->reply_ep;
+
+  auto current = static_cast<char*>(data);
+  auto end     = current + length;
+  while (current < end) {
+    internal::AmAggregationRecord record;
+    if (static_cast<size_t>(end - current) < sizeof(record)) break;
+    memcpy(&record, current, sizeof(record));
+    current += sizeof(record);
+    if (static_cast<size_t>(end - current) < size_t{record.headerLength} + record.length) break;
+
+    char* messageHeader = current;
+    char* messageData   = current + record.headerLength;
+    current += record.headerLength + record.length;
+
+    std::shared_ptr<internal::AmData> amData{nullptr};
+    try {
+      amData = worker->getAmData(record.amId);
+    } catch (const std::runtime_error& e) {
+      ucxx_debug("ucxx::Worker::%s, worker: %p, dropping aggregated message: %s",
+                 __func__,
+                 worker,
+                 e.what());
+      continue;
+    }
+
+    RequestAm::recvCallback(
+      amData.get(), messageHeader, record.headerLength, messageData, record.length, &messageParam);
+  }
+
+  if (current != end)
+    ucxx_error("ucxx::Worker::%s, worker: %p, truncated batch of active messages",
+               __func__,
+               worker);
+
+  return UCS_OK;
+}
+
+void Worker::registerAmAggregationEndpoint(Endpoint* endpoint,
+                                           std::weak_ptr<Endpoint> weakPointer)
+{
+  std::lock_guard<std::mutex> lock(_amAggregationEndpointsMutex);
+  _amAggregationEndpoints.insert_or_assign(endpoint, weakPointer);
+  _hasAmAggregationPending.store(true, std::memory_order_release);
+}
+
+void Worker::unregisterAmAggregationEndpoint(Endpoint* endpoint)
+{
+  std::lock_guard<std::mutex> lock(_amAggregationEndpointsMutex);
+  _amAggregationEndpoints.erase(endpoint);
+  if (_amAggregationEndpoints.empty())
+    _hasAmAggregationPending.store(false, std::memory_order_release);
+}
+
+void Worker::flushExpiredAmAggregations()
+{
+  std::vector<std::shared_ptr<Endpoint>> endpoints;
+  {
+    std::lock_guard<std::mutex> lock(_amAggregationEndpointsMutex);
+    endpoints.reserve(_amAggregationEndpoints.size());
+    for (const auto& [_, weakPointer] : _amAggregationEndpoints)
+      if (auto endpoint = weakPointer.lock()) endpoints.push_back(std::move(endpoint));
+  }
+
+  // Endpoints unregister themselves once their batch is submitted.
+  auto now = std::chrono::steady_clock::now();
+  for (const auto& endpoint : endpoints)
+    endpoint->flushExpiredAmAggregation(now);
+}
+
+void Worker::scheduleRequestDeadline(std::shared_ptr<Request> request,
+                                     std::chrono::steady_clock::time_point deadline)
+{
+  // Round up so that requests never expire before their deadline.
+  const auto elapsed  = std::max(deadline - _requestDeadlinesEpoch,
+                                std::chrono::steady_clock::duration::zero());
+  const uint64_t tick = std::chrono::ceil<std::chrono::milliseconds>(elapsed).count();
+
+  std::lock_guard<std::mutex> lock(_requestDeadlinesMutex);
+  _requestDeadlines.schedule(tick, request);
+  _hasRequestDeadlines.store(true, std::memory_order_release);
+}
+
+void Worker::expireRequestDeadlines()
+{
+  const uint64_t tick = std::chrono::floor<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - _requestDeadlinesEpoch)
+                          .count();
+
+  // Requests are only released after unlocking, dropping the last reference may destroy them.
+  std::vector<std::shared_ptr<Request>> expired;
+  {
+    std::lock_guard<std::mutex> lock(_requestDeadlinesMutex);
+    _requestDeadlines.advance(tick, [&expired](std::weak_ptr<Request> weakRequest) {
+      if (auto request = weakRequest.lock()) expired.push_back(std::move(request));
+    });
+    if (_requestDeadlines.size() == 0) _hasRequestDeadlines.store(false, std::memory_order_release);
+  }
+
+  auto trackedRequests = std::make_unique<TrackedRequests>();
+  for (auto& request : expired) {
+    if (request->isCompleted()) continue;
+
+    ucxx_trace_req("ucxx::Worker::%s, Worker: %p, UCP handle: %p, request %p deadline expired",
+                   __func__,
+                   this,
+                   _handle,
+                   request.get());
+    request->_deadlineExpired.store(true, std::memory_order_release);
+    _requestDeadlinesExpired.fetch_add(1, std::memory_order_relaxed);
+    try {
+      trackedRequests->_inflight->insert(request);
+    } catch (const std::runtime_error&) {
+      // Already tracked by the maximum number of owners, cancel it right away instead.
+      request->cancel();
+    }
+  }
+
+  if (trackedRequests->_inflight->size() > 0) scheduleRequestCancel(std::move(trackedRequests));
+}
+
 std::shared_ptr<Worker> createWorker(std::shared_ptr<Context> context,
                                      const bool enableDelayedSubmission,
-                                     const bool enableFuture)
+                                     const bool enableFuture,
+                                     const bool enableSerializedThreadMode)
 {
-  auto worker = std::shared_ptr<Worker>(new Worker(context, enableDelayedSubmission, enableFuture));
+  auto worker = std::shared_ptr<Worker>(
+    new Worker(context, enableDelayedSubmission, enableFuture, enableSerializedThreadMode));
 
   // We can only get a `shared_ptr<Worker>` for the Active Messages callback after it's
   // been created, thus this cannot be in the constructor.
-  if (worker->_amData != nullptr) {
-    worker->_amData->_worker = worker;
-
-    std::stringstream ownerStream;
-    ownerStream << "worker " << worker->getHandle();
-    worker->_amData->_ownerString = ownerStream.str();
-  }
+  for (auto& [amId, amData] : worker->_amData)
+    amData->_worker = worker;
 
   return worker;
 }
@@ -165,6 +511,9 @@ Worker::~Worker()
   stopProgressThreadNoWarn();
   if (_notifier) _notifier->stopRequestNotifierThread();
 
+  // Execute all completion callbacks still pending before the worker is destroyed.
+  replaceCompletionExecutor(nullptr);
+
   drainWorkerTagRecv();
 
   ucp_worker_destroy(_handle);
@@ -175,10 +524,14 @@ Worker::~Worker()
 
 ucp_worker_h Worker::getHandle() { return _handle; }
 
+Worker* Worker::asWorker() noexcept { return this; }
+
 std::string Worker::getInfo()
 {
   FILE* TextFileDescriptor = utils::createTextFileDescriptor();
-  ucp_worker_print_info(this->_handle, TextFileDescriptor);
+  invokeSerialized([this, TextFileDescriptor]() {
+    ucp_worker_print_info(this->_handle, TextFileDescriptor);
+  });
   return utils::decodeTextFileDescriptor(TextFileDescriptor);
 }
 
@@ -187,8 +540,77 @@ bool Worker::isDelayedRequestSubmissionEnabled() const
   return _delayedSubmissionCollection->isDelayedRequestSubmissionEnabled();
 }
 
+void Worker::setDelayedSubmissionBudget(size_t budget)
+{
+  _delayedSubmissionCollection->setRequestBudget(budget);
+}
+
+size_t Worker::getDelayedSubmissionBudget() const
+{
+  return _delayedSubmissionCollection->getRequestBudget();
+}
+
+void Worker::setProgressBudget(const ProgressBudget& budget)
+{
+  _progressMaxCalls.store(budget.maxProgressCalls, std::memory_order_relaxed);
+  _progressMaxCompletions.store(budget.maxCompletions, std::memory_order_relaxed);
+  _delayedSubmissionCollection->setRequestBudget(budget.maxSubmissions);
+}
+
+ProgressBudget Worker::getProgressBudget() const
+{
+  ProgressBudget budget{};
+  budget.maxProgressCalls = _progressMaxCalls.load(std::memory_order_relaxed);
+  budget.maxSubmissions   = _delayedSubmissionCollection->getRequestBudget();
+  budget.maxCompletions   = _progressMaxCompletions.load(std::memory_order_relaxed);
+  return budget;
+}
+
+bool Worker::isSerializedThreadModeEnabled() const { return _enableSerializedThreadMode; }
+
+bool Worker::requiresSerializedAccess()
+{
+  return _enableSerializedThreadMode && isProgressThreadRunning() &&
+         std::this_thread::get_id() != getProgressThreadId();
+}
+
+void Worker::invokeSerialized(std::function<void()> function)
+{
+  if (!requiresSerializedAccess()) {
+    function();
+    return;
+  }
+
+  utils::CallbackNotifier callbackNotifier{};
+  std::exception_ptr exception{nullptr};
+  registerGenericPre([&function, &callbackNotifier, &exception]() {
+    try {
+      function();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    callbackNotifier.set();
+  });
+  callbackNotifier.wait();
+
+  if (exception) std::rethrow_exception(exception);
+}
+
+void Worker::scheduleSerialized(std::function<void()> function)
+{
+  if (requiresSerializedAccess())
+    registerGenericPre(std::move(function));
+  else
+    function();
+}
+
 bool Worker::isFutureEnabled() const { return _enableFuture; }
 
+std::shared_ptr<utils::MemoryPool> Worker::getRequestMemoryPool() const
+{
+  return _requestMemoryPool;
+}
+
 void Worker::initBlockingProgressMode()
 {
   // In blocking progress mode, we create an epoll file
@@ -226,6 +648,13 @@ bool Worker::arm()
   return true;
 }
 
+int Worker::getEpollFileDescriptor() const
+{
+  if (_epollFileDescriptor == -1)
+    throw std::runtime_error("Blocking progress mode has not been initialized");
+  return _epollFileDescriptor;
+}
+
 bool Worker::progressWorkerEvent(const int epollTimeout)
 {
   int ret;
@@ -233,15 +662,209 @@ bool Worker::progressWorkerEvent(const int epollTimeout)
 
   if (progress()) return true;
 
+  // Readiness of sends is not signaled by events, thus must be polled.
+  if (_hasRequestsAwaitingReadiness.load(std::memory_order_acquire)) return false;
+
+  if ((_epollFileDescriptor == -1) || !arm()) return false;
+
+  do {
+    ret = epoll_wait(_epollFileDescriptor, &ev, 1, epollTimeout);
+  } while ((ret == -1) && (errno == EINTR || errno == EAGAIN));
+
+  return false;
+}
+
+bool Worker::progressHybrid(const uint64_t spinPeriodNs, const int epollTimeout)
+{
+  int ret;
+  epoll_event ev;
+
+  auto now = std::chrono::steady_clock::now();
+  if (progress()) {
+    _lastProgressActivity = now;
+    ++_progressSpinHits;
+    return true;
+  }
+
+  // Keep spinning until the worker has been idle for longer than the spin period.
+  if (now - _lastProgressActivity < std::chrono::nanoseconds(spinPeriodNs)) return false;
+
+  // Readiness of sends is not signaled by events, thus must be polled.
+  if (_hasRequestsAwaitingReadiness.load(std::memory_order_acquire)) return false;
+
   if ((_epollFileDescriptor == -1) || !arm()) return false;
 
+  ++_progressSleeps;
   do {
     ret = epoll_wait(_epollFileDescriptor, &ev, 1, epollTimeout);
   } while ((ret == -1) && (errno == EINTR || errno == EAGAIN));
 
+  // Woke up due to an event, spin again expecting more activity to follow.
+  if (ret > 0) _lastProgressActivity = std::chrono::steady_clock::now();
+
   return false;
 }
 
+uint64_t Worker::getProgressSpinHits() const { return _progressSpinHits; }
+
+uint64_t Worker::getProgressSleeps() const { return _progressSleeps; }
+
+WorkerStatistics Worker::getStatistics() const
+{
+  WorkerStatistics statistics{};
+  _requestCounters.fill(statistics);
+  statistics.requestsDelayed  = _requestsDelayed.load(std::memory_order_relaxed);
+  statistics.requestsTimedOut = _requestDeadlinesExpired.load(std::memory_order_relaxed);
+
+  statistics.progressCalls = _progressCalls.load(std::memory_order_relaxed);
+  statistics.progressCallsWithProgress =
+    _progressCallsWithProgress.load(std::memory_order_relaxed);
+  statistics.progressSpinHits        = _progressSpinHits.load(std::memory_order_relaxed);
+  statistics.progressSleeps          = _progressSleeps.load(std::memory_order_relaxed);
+  statistics.progressBudgetExhausted = _progressBudgetExhausted.load(std::memory_order_relaxed);
+
+  statistics.delayedSubmissionCallbacks = _delayedSubmissionCollection->getProcessedCallbacks();
+  statistics.delayedSubmissionProcessNs = _delayedSubmissionCollection->getProcessNanoseconds();
+
+  statistics.futuresPoolRefills = _futuresPoolRefillCount.load(std::memory_order_relaxed);
+
+  _compressionCounters.fill(statistics);
+  return statistics;
+}
+
+void Worker::setRequestTracing(uint64_t sampleRate, size_t capacity)
+{
+  _requestTracer.configure(sampleRate, capacity);
+}
+
+std::vector<RequestTrace> Worker::getRequestTraces(bool clear)
+{
+  return _requestTracer.getTraces(clear);
+}
+
+void Worker::startTrafficCapture(const std::string& path) { _trafficCapture.start(path); }
+
+void Worker::stopTrafficCapture() { _trafficCapture.stop(); }
+
+bool Worker::isTrafficCaptureEnabled() const { return _trafficCapture.isEnabled(); }
+
+std::shared_ptr<CompletionExecutor> Worker::getCompletionExecutor()
+{
+  if (!_hasCompletionExecutor.load(std::memory_order_acquire)) return nullptr;
+
+  std::lock_guard<std::mutex> lock(_completionExecutorMutex);
+  return _completionExecutor;
+}
+
+void Worker::replaceCompletionExecutor(std::shared_ptr<CompletionExecutor> completionExecutor,
+                                       bool notifyFutures)
+{
+  {
+    std::lock_guard<std::mutex> lock(_completionExecutorMutex);
+    std::swap(_completionExecutor, completionExecutor);
+    _completionExecutorNotifiesFutures.store(_completionExecutor != nullptr && notifyFutures,
+                                             std::memory_order_release);
+    _hasCompletionExecutor.store(_completionExecutor != nullptr, std::memory_order_release);
+  }
+
+  // The previous executor dispatches its pending callbacks when destroyed, unless a
+  // request completing concurrently still holds a reference, in which case it is
+  // destroyed when that request releases it.
+  completionExecutor.reset();
+}
+
+void Worker::setCompletionCallbackExecutor(CompletionCallbackExecutor executor, size_t batchSize)
+{
+  replaceCompletionExecutor(std::make_shared<CompletionExecutor>(executor, batchSize));
+}
+
+void Worker::startCompletionCallbackThreads(size_t numThreads, size_t batchSize)
+{
+  replaceCompletionExecutor(std::make_shared<CompletionExecutor>(numThreads, batchSize));
+}
+
+void Worker::setCompletionExecutor(std::shared_ptr<CompletionExecutor> completionExecutor,
+                                   bool notifyFutures)
+{
+  if (completionExecutor == nullptr)
+    throw std::invalid_argument("The completion executor must not be nullptr");
+  replaceCompletionExecutor(completionExecutor, notifyFutures);
+}
+
+bool Worker::isCompletionExecutorNotifyingFutures() const
+{
+  return _completionExecutorNotifiesFutures.load(std::memory_order_acquire);
+}
+
+void Worker::resetCompletionCallbackExecutor() { replaceCompletionExecutor(nullptr); }
+
+void Worker::setCompression(const CompressionConfig& config, size_t numThreads)
+{
+  if (!utils::isCompressionCodecAvailable(config.codec))
+    throw std::invalid_argument("The compression codec is not available in this build");
+
+  auto executor = numThreads > 0 ? std::make_shared<CompletionExecutor>(numThreads, 1) : nullptr;
+
+  std::shared_ptr<CompletionExecutor> previous{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(_compressionMutex);
+    _compressionConfig = config;
+    previous           = std::exchange(_compressionExecutor, executor);
+  }
+
+  // Released unlocked, waits for the tasks still running on the previous threads.
+  previous = nullptr;
+}
+
+CompressionConfig Worker::getCompressionConfig()
+{
+  std::lock_guard<std::mutex> lock(_compressionMutex);
+  return _compressionConfig;
+}
+
+void Worker::setCompactHeaders(bool enable) { _compactHeaders.store(enable); }
+
+bool Worker::isCompactHeadersEnabled() const { return _compactHeaders.load(); }
+
+void Worker::runCompressionTask(std::function<void()> task)
+{
+  std::shared_ptr<CompletionExecutor> executor{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(_compressionMutex);
+    executor = _compressionExecutor;
+  }
+
+  if (executor == nullptr) {
+    task();
+    return;
+  }
+
+  executor->enqueue(std::move(task));
+  executor->flush();
+}
+
+void Worker::setEndpointCacheEnabled(bool enabled)
+{
+  std::lock_guard<std::mutex> lock(_endpointCacheMutex);
+  _endpointCacheEnabled = enabled;
+  if (!enabled) _endpointCache.clear();
+}
+
+bool Worker::isEndpointCacheEnabled() const { return _endpointCacheEnabled; }
+
+void Worker::evictCachedEndpoint(const ErrorCallbackData* callbackData)
+{
+  if (!_endpointCacheEnabled) return;
+
+  std::lock_guard<std::mutex> lock(_endpointCacheMutex);
+  for (auto it = _endpointCache.begin(); it != _endpointCache.end();) {
+    if (it->second.callbackData == callbackData || it->second.endpoint.expired())
+      it = _endpointCache.erase(it);
+    else
+      ++it;
+  }
+}
+
 void Worker::signal() { utils::ucsErrorThrow(ucp_worker_signal(_handle)); }
 
 bool Worker::waitProgress()
@@ -250,25 +873,74 @@ bool Worker::waitProgress()
   return progress();
 }
 
-bool Worker::progressOnce() { return ucp_worker_progress(_handle) != 0; }
+bool Worker::progressOnce()
+{
+  if (requiresSerializedAccess())
+    throw std::runtime_error(
+      "Worker with serialized thread mode may only be progressed by its progress thread");
+  return ucp_worker_progress(_handle) != 0;
+}
 
 bool Worker::progressPending()
 {
+  const size_t maxCalls       = _progressMaxCalls.load(std::memory_order_relaxed);
+  const size_t maxCompletions = _progressMaxCompletions.load(std::memory_order_relaxed);
+
+  // Fast path, no budget set.
+  if (maxCalls == 0 && maxCompletions == 0) {
+    bool ret = false, prog = false;
+    do {
+      prog = progressOnce();
+      ret |= prog;
+    } while (prog);
+    return ret;
+  }
+
+  const uint64_t finishedStart = maxCompletions > 0 ? _requestCounters.finished() : 0;
   bool ret = false, prog = false;
-  do {
+  for (size_t calls = 1;; ++calls) {
     prog = progressOnce();
     ret |= prog;
-  } while (prog);
+    if (!prog) break;
+    if ((maxCalls > 0 && calls >= maxCalls) ||
+        (maxCompletions > 0 && _requestCounters.finished() - finishedStart >= maxCompletions)) {
+      _progressBudgetExhausted.fetch_add(1, std::memory_order_relaxed);
+      break;
+    }
+  }
   return ret;
 }
 
 bool Worker::progress()
 {
+  UCXX_NVTX_RANGE("ucxx::Worker::progress");
+
   bool ret                     = progressPending();
   bool progressScheduledCancel = false;
 
+  _progressCalls.fetch_add(1, std::memory_order_relaxed);
+  if (ret) _progressCallsWithProgress.fetch_add(1, std::memory_order_relaxed);
+
+  // Dispatch completion callbacks of requests completed by this progress as one batch.
+  if (_hasCompletionExecutor.load(std::memory_order_acquire)) {
+    auto completionExecutor = getCompletionExecutor();
+    if (completionExecutor) completionExecutor->flush();
+  }
+
+  // Submit batches of aggregated active messages whose time window expired.
+  if (_hasAmAggregationPending.load(std::memory_order_acquire)) flushExpiredAmAggregations();
+
+  // Submit sends that became ready, or complete them if their readiness failed.
+  if (_hasRequestsAwaitingReadiness.load(std::memory_order_acquire)) submitReadyRequests();
+
+  // Schedule cancelation of requests whose deadline expired, canceled below.
+  if (_hasRequestDeadlines.load(std::memory_order_acquire)) expireRequestDeadlines();
+
+  // Fast path, avoid locking when no requests are scheduled for cancelation.
+  if (!_hasRequestsToCancel.load(std::memory_order_relaxed)) return ret;
+
   {
-    std::lock_guard<std::mutex> lock(_inflightRequestsMutex);
+    std::lock_guard<std::mutex> lock(_inflightRequestsToCancelMutex);
 
     // Before canceling requests scheduled for cancelation, attempt to let them complete.
     progressScheduledCancel =
@@ -285,19 +957,131 @@ bool Worker::progress()
 void Worker::registerDelayedSubmission(std::shared_ptr<Request> request,
                                        DelayedSubmissionCallbackType callback)
 {
-  if (_delayedSubmissionCollection->isDelayedRequestSubmissionEnabled()) {
-    _delayedSubmissionCollection->registerRequest(request, callback);
+  if (request != nullptr &&
+      (request->_readiness != nullptr ||
+       _hasRequestsAwaitingReadiness.load(std::memory_order_acquire)) &&
+      awaitRequestReadiness(request, callback))
+    return;
 
+  submitRequest(request, callback);
+}
+
+void Worker::submitRequest(std::shared_ptr<Request> request, DelayedSubmissionCallbackType callback)
+{
+  if (_delayedSubmissionCollection->isDelayedRequestSubmissionEnabled()) {
     /* Waking the progress event is needed here because the UCX request is
      * not dispatched immediately. Thus we must signal the progress task so
-     * it will ensure the request is dispatched.
+     * it will ensure the request is dispatched. Signaling is skipped if a
+     * previous registration already did so and the progress thread has not
+     * yet processed delayed submissions since, in which case this one will be
+     * processed with the previous ones.
      */
-    signal();
+    _requestsDelayed.fetch_add(1, std::memory_order_relaxed);
+    auto priority = request ? request->getSubmissionPriority() : SubmissionPriority::Normal;
+    if (_delayedSubmissionCollection->registerRequest(request, callback, priority)) signal();
   } else {
     callback();
   }
 }
 
+bool Worker::awaitRequestReadiness(std::shared_ptr<Request> request,
+                                   DelayedSubmissionCallbackType callback)
+{
+  // Only sends are ordered on their endpoint.
+  const Endpoint* endpoint = request->_endpoint.get();
+  if (endpoint == nullptr || !(std::holds_alternative<data::AmSend>(request->_requestData) ||
+                               std::holds_alternative<data::StreamSend>(request->_requestData) ||
+                               std::holds_alternative<data::TagSend>(request->_requestData)))
+    return false;
+
+  std::lock_guard<std::mutex> lock(_requestsAwaitingReadinessMutex);
+  auto it = _endpointsAwaitingReadiness.find(endpoint);
+  if (it == _endpointsAwaitingReadiness.end()) {
+    if (request->_readiness == nullptr) return false;
+    it = _endpointsAwaitingReadiness.emplace(endpoint, 0).first;
+  }
+  ++it->second;
+
+  {
+    std::lock_guard<std::recursive_mutex> requestLock(request->_mutex);
+    request->_awaitingReadiness = true;
+  }
+  _requestsAwaitingReadiness.emplace_back(std::move(request), std::move(callback));
+
+  // A progress thread blocked on events must wake up to check readiness.
+  if (!_hasRequestsAwaitingReadiness.exchange(true, std::memory_order_acq_rel) &&
+      _delayedSubmissionCollection->isDelayedRequestSubmissionEnabled())
+    signal();
+
+  return true;
+}
+
+void Worker::submitReadyRequests()
+{
+  std::vector<std::pair<std::shared_ptr<Request>, DelayedSubmissionCallbackType>> ready;
+  std::vector<std::pair<std::shared_ptr<Request>, ucs_status_t>> failed;
+  std::vector<const Endpoint*> releasedEndpoints;
+  {
+    std::lock_guard<std::mutex> lock(_requestsAwaitingReadinessMutex);
+    std::unordered_set<const Endpoint*> blockedEndpoints;
+    for (auto it = _requestsAwaitingReadiness.begin(); it != _requestsAwaitingReadiness.end();) {
+      auto& [request, callback] = *it;
+      const Endpoint* endpoint  = request->_endpoint.get();
+      if (blockedEndpoints.count(endpoint) > 0) {
+        ++it;
+        continue;
+      }
+
+      bool canceled       = false;
+      ucs_status_t status = UCS_OK;
+      {
+        std::lock_guard<std::recursive_mutex> requestLock(request->_mutex);
+        if (!request->_awaitingReadiness)
+          canceled = true;
+        else if (request->_readiness != nullptr)
+          status = request->_readiness();
+        if (status != UCS_INPROGRESS) request->_awaitingReadiness = false;
+      }
+      if (status == UCS_INPROGRESS) {
+        blockedEndpoints.insert(endpoint);
+        ++it;
+        continue;
+      }
+
+      if (!canceled && status == UCS_OK)
+        ready.emplace_back(std::move(request), std::move(callback));
+      else if (!canceled)
+        failed.emplace_back(std::move(request), status);
+      releasedEndpoints.push_back(endpoint);
+      it = _requestsAwaitingReadiness.erase(it);
+    }
+  }
+
+  // Submitting and completing requests may call user callbacks, which may register sends,
+  // thus is only done after unlocking. Endpoints are only released afterwards, sends
+  // registered on them in the meantime are thus still submitted after these.
+  for (auto& [request, callback] : ready)
+    submitRequest(request, std::move(callback));
+  for (auto& [request, status] : failed) {
+    ucxx_debug("ucxx::Worker::%s, Worker: %p, UCP handle: %p, request %p readiness failed: %s",
+               __func__,
+               this,
+               _handle,
+               request.get(),
+               ucs_status_string(status));
+    request->callback(nullptr, status);
+  }
+
+  std::lock_guard<std::mutex> lock(_requestsAwaitingReadinessMutex);
+  for (const auto endpoint : releasedEndpoints) {
+    auto it = _endpointsAwaitingReadiness.find(endpoint);
+    if (it != _endpointsAwaitingReadiness.end() && --it->second == 0)
+      _endpointsAwaitingReadiness.erase(it);
+  }
+  if (_requestsAwaitingReadiness.empty())
+    _hasRequestsAwaitingReadiness.store(false, std::memory_order_release);
+}
+
 void Worker::registerGenericPre(DelayedSubmissionCallbackType callback)
 {
   if (std::this_thread::get_id() == getProgressThreadId()) {
@@ -307,13 +1091,12 @@ void Worker::registerGenericPre(DelayedSubmissionCallbackType callback)
      */
     callback();
   } else {
-    _delayedSubmissionCollection->registerGenericPre(callback);
-
     /* Waking the progress event is needed here because the UCX request is
      * not dispatched immediately. Thus we must signal the progress task so
-     * it will ensure the request is dispatched.
+     * it will ensure the request is dispatched. See `registerDelayedSubmission()`
+     * for when signaling is skipped.
      */
-    signal();
+    if (_delayedSubmissionCollection->registerGenericPre(callback)) signal();
   }
 }
 
@@ -326,13 +1109,12 @@ void Worker::registerGenericPost(DelayedSubmissionCallbackType callback)
      */
     callback();
   } else {
-    _delayedSubmissionCollection->registerGenericPost(callback);
-
     /* Waking the progress event is needed here because the UCX request is
      * not dispatched immediately. Thus we must signal the progress task so
-     * it will ensure the request is dispatched.
+     * it will ensure the request is dispatched. See `registerDelayedSubmission()`
+     * for when signaling is skipped.
      */
-    signal();
+    if (_delayedSubmissionCollection->registerGenericPost(callback)) signal();
   }
 }
 
@@ -344,18 +1126,50 @@ void Worker::registerGenericPost(DelayedSubmissionCallbackType callback)
       "the Worker to use this method.");                                                    \
   } while (0)
 
-void Worker::populateFuturesPool() { THROW_FUTURE_NOT_IMPLEMENTED(); }
+void Worker::populateFuturesPool()
+{
+  // Native futures are cheap to create, thus they are created on demand by `getFuture()`.
+  if (!_enableFuture) THROW_FUTURE_NOT_IMPLEMENTED();
+}
+
+void Worker::setFuturesPoolSize(const size_t size, const size_t lowWatermark)
+{
+  if (size == 0 || size < lowWatermark)
+    throw std::runtime_error("The futures pool size must be positive and at least as large "
+                             "as the low watermark");
+  _futuresPoolSize         = size;
+  _futuresPoolLowWatermark = lowWatermark;
+}
 
-std::shared_ptr<Future> Worker::getFuture() { THROW_FUTURE_NOT_IMPLEMENTED(); }
+std::shared_ptr<Future> Worker::getFuture()
+{
+  auto completionQueue = getCompletionQueue();
+  if (completionQueue == nullptr) THROW_FUTURE_NOT_IMPLEMENTED();
+  return createCompletionFuture(completionQueue);
+}
 
 RequestNotifierWaitState Worker::waitRequestNotifier(uint64_t periodNs)
 {
-  THROW_FUTURE_NOT_IMPLEMENTED();
+  if (_notifier == nullptr) THROW_FUTURE_NOT_IMPLEMENTED();
+  return _notifier->waitRequestNotifier(periodNs);
 }
 
-void Worker::runRequestNotifier() { THROW_FUTURE_NOT_IMPLEMENTED(); }
+void Worker::runRequestNotifier()
+{
+  if (_notifier == nullptr) THROW_FUTURE_NOT_IMPLEMENTED();
+  _notifier->runRequestNotifier();
+}
+
+void Worker::stopRequestNotifierThread()
+{
+  if (_notifier == nullptr) THROW_FUTURE_NOT_IMPLEMENTED();
+  _notifier->stopRequestNotifierThread();
+}
 
-void Worker::stopRequestNotifierThread() { THROW_FUTURE_NOT_IMPLEMENTED(); }
+std::shared_ptr<CompletionQueue> Worker::getCompletionQueue() const
+{
+  return std::dynamic_pointer_cast<CompletionQueue>(_notifier);
+}
 
 void Worker::setProgressThreadStartCallback(std::function<void(void*)> callback, void* callbackArg)
 {
@@ -363,7 +1177,16 @@ void Worker::setProgressThreadStartCallback(std::function<void(void*)> callback,
   _progressThreadStartCallbackArg = callbackArg;
 }
 
-void Worker::startProgressThread(const bool pollingMode, const int epollTimeout)
+void Worker::setProgressThreadCudaDevice(const int device)
+{
+  _progressThreadCudaContext = true;
+  _progressThreadCudaDevice  = device;
+}
+
+void Worker::startProgressThread(const bool pollingMode,
+                                 const int epollTimeout,
+                                 const uint64_t spinPeriodNs,
+                                 const std::vector<int>& cpuAffinity)
 {
   if (_progressThread) {
     ucxx_debug(
@@ -382,16 +1205,35 @@ void Worker::startProgressThread(const bool pollingMode, const int epollTimeout)
     signalWorkerFunction = []() {};
   } else {
     initBlockingProgressMode();
-    progressFunction = [this, epollTimeout]() { return this->progressWorkerEvent(epollTimeout); };
+    if (spinPeriodNs > 0)
+      progressFunction = [this, spinPeriodNs, epollTimeout]() {
+        return this->progressHybrid(spinPeriodNs, epollTimeout);
+      };
+    else
+      progressFunction = [this, epollTimeout]() { return this->progressWorkerEvent(epollTimeout); };
     signalWorkerFunction = [this]() { return this->signal(); };
   }
 
+  auto startCallback = _progressThreadStartCallback;
+  auto context       = std::dynamic_pointer_cast<Context>(_parent);
+  if (_progressThreadCudaContext && context->hasCudaSupport()) {
+    int device = _progressThreadCudaDevice;
+    if (device < 0) device = std::max(utils::getCudaCurrentDevice(), 0);
+    // The CUDA context must be current before the user callback, which may rely on it.
+    startCallback = [device, callback = _progressThreadStartCallback](void* arg) {
+      if (utils::setCudaPrimaryContext(device))
+        ucxx_debug("ucxx::Worker progress thread bound to CUDA device %d", device);
+      if (callback) callback(arg);
+    };
+  }
+
   _progressThread = std::make_shared<WorkerProgressThread>(pollingMode,
                                                            progressFunction,
                                                            signalWorkerFunction,
-                                                           _progressThreadStartCallback,
+                                                           startCallback,
                                                            _progressThreadStartCallbackArg,
-                                                           _delayedSubmissionCollection);
+                                                           _delayedSubmissionCollection,
+                                                           cpuAffinity);
 
   /**
    * Ensure the progress thread's ID is available allowing generic callbacks to run
@@ -420,14 +1262,40 @@ bool Worker::isProgressThreadRunning() { return _progressThread != nullptr; }
 
 std::thread::id Worker::getProgressThreadId() { return _progressThreadId; }
 
+std::vector<int> Worker::getNetworkDevicesLocalCpus()
+{
+  auto context = std::dynamic_pointer_cast<Context>(_parent);
+  auto config  = context->getConfig();
+  auto it      = config.find("NET_DEVICES");
+  if (it == config.end()) return {};
+
+  return utils::getNetworkDevicesLocalCpus(it->second);
+}
+
+utils::Topology Worker::getTopology(const std::vector<std::string>& pciBusIds)
+{
+  auto context = std::dynamic_pointer_cast<Context>(_parent);
+  auto config  = context->getConfig();
+  auto it      = config.find("NET_DEVICES");
+
+  return utils::getTopology(it == config.end() ? std::string{} : it->second, pciBusIds);
+}
+
+TopologyLocality Worker::getTopologyLocality(const utils::Topology& remoteTopology,
+                                             const std::vector<std::string>& pciBusIds)
+{
+  return utils::getTopologyLocality(getTopology(pciBusIds), remoteTopology);
+}
+
 size_t Worker::cancelInflightRequests(uint64_t period, uint64_t maxAttempts)
 {
   size_t canceled = 0;
 
   auto inflightRequestsToCancel = std::make_unique<InflightRequests>();
   {
-    std::lock_guard<std::mutex> lock(_inflightRequestsMutex);
+    std::lock_guard<std::mutex> lock(_inflightRequestsToCancelMutex);
     std::swap(_inflightRequestsToCancel, inflightRequestsToCancel);
+    _hasRequestsToCancel.store(false, std::memory_order_relaxed);
   }
 
   if (std::this_thread::get_id() == getProgressThreadId()) {
@@ -465,8 +1333,9 @@ size_t Worker::cancelInflightRequests(uint64_t period, uint64_t maxAttempts)
   }
 
   if (inflightRequestsToCancel->getCancelingSize() > 0) {
-    std::lock_guard<std::mutex> lock(_inflightRequestsMutex);
+    std::lock_guard<std::mutex> lock(_inflightRequestsToCancelMutex);
     _inflightRequestsToCancel->merge(inflightRequestsToCancel->release());
+    _hasRequestsToCancel.store(true, std::memory_order_relaxed);
   }
 
   return canceled;
@@ -474,8 +1343,10 @@ size_t Worker::cancelInflightRequests(uint64_t period, uint64_t maxAttempts)
 
 void Worker::scheduleRequestCancel(TrackedRequestsPtr trackedRequests)
 {
+  if (trackedRequests == nullptr) return;
+
   {
-    std::lock_guard<std::mutex> lock(_inflightRequestsMutex);
+    std::lock_guard<std::mutex> lock(_inflightRequestsToCancelMutex);
     ucxx_debug(
       "ucxx::Worker::%s, Worker: %p, UCP handle: %p, scheduling cancelation of "
       "%lu requests",
@@ -484,28 +1355,52 @@ void Worker::scheduleRequestCancel(TrackedRequestsPtr trackedRequests)
       _handle,
       trackedRequests->_inflight->size() + trackedRequests->_canceling->size());
     _inflightRequestsToCancel->merge(std::move(trackedRequests));
+    _hasRequestsToCancel.store(true, std::memory_order_relaxed);
   }
 }
 
+size_t Worker::abortInflightRequests(TrackedRequestsPtr trackedRequests)
+{
+  if (trackedRequests == nullptr) return 0;
+
+  InflightRequests inflightRequests{};
+  inflightRequests.merge(std::move(trackedRequests));
+  size_t aborted   = inflightRequests.abortAll();
+  size_t canceling = inflightRequests.getCancelingSize();
+
+  ucxx_debug("ucxx::Worker::%s, Worker: %p, UCP handle: %p, aborted %lu requests, %lu pending",
+             __func__,
+             this,
+             _handle,
+             aborted,
+             canceling);
+
+  if (canceling > 0) scheduleRequestCancel(inflightRequests.release());
+
+  return aborted;
+}
+
+InflightRequests& Worker::getInflightRequestsShard(const Request* const request)
+{
+  // Fibonacci hashing, spreads addresses of equally-sized allocations across shards.
+  uint64_t key = static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(request));
+  key *= 0x9e3779b97f4a7c15ull;
+  return _inflightRequests[(key >> 32) % _inflightRequests.size()];
+}
+
 std::shared_ptr<Request> Worker::registerInflightRequest(std::shared_ptr<Request> request)
 {
-  if (!request->isCompleted()) {
-    std::lock_guard<std::mutex> lock(_inflightRequestsMutex);
-    _inflightRequests->insert(request);
-  }
+  if (!request->isCompleted()) getInflightRequestsShard(request.get()).insert(request);
 
   return request;
 }
 
 void Worker::removeInflightRequest(const Request* const request)
 {
-  {
-    std::lock_guard<std::mutex> lock(_inflightRequestsMutex);
-    _inflightRequests->remove(request);
-  }
+  getInflightRequestsShard(request).remove(request);
 }
 
-bool Worker::tagProbe(const Tag tag)
+void Worker::ensureProgressed()
 {
   if (!isProgressThreadRunning()) {
     progress();
@@ -523,32 +1418,127 @@ bool Worker::tagProbe(const Tag tag)
     registerGenericPost([&callbackNotifierPost]() { callbackNotifierPost.set(); });
     callbackNotifierPost.wait();
   }
+}
+
+bool Worker::tagProbe(const Tag tag)
+{
+  ensureProgressed();
 
   ucp_tag_recv_info_t info;
-  ucp_tag_message_h tag_message = ucp_tag_probe_nb(_handle, tag, -1, 0, &info);
+  ucp_tag_message_h tag_message = nullptr;
+  invokeSerialized([this, tag, &info, &tag_message]() {
+    tag_message = ucp_tag_probe_nb(_handle, tag, -1, 0, &info);
+  });
 
   return tag_message != NULL;
 }
 
+TagMessage Worker::tagProbeMessage(const Tag tag, const TagMask tagMask)
+{
+  ensureProgressed();
+
+  ucp_tag_recv_info_t info;
+  ucp_tag_message_h handle = nullptr;
+  invokeSerialized([this, tag, tagMask, &info, &handle]() {
+    handle = ucp_tag_probe_nb(_handle, tag, tagMask, 1, &info);
+  });
+  if (handle == nullptr) return TagMessage{};
+
+  return TagMessage{handle, {Tag{info.sender_tag}, info.length}};
+}
+
+std::shared_ptr<Request> Worker::tagMsgRecv(const TagMessage& message,
+                                            void* buffer,
+                                            size_t length,
+                                            const bool enableFuture,
+                                            RequestCallbackUserFunction callbackFunction,
+                                            RequestCallbackUserData callbackData,
+                                            std::shared_ptr<MemoryHandle> memoryHandle)
+{
+  auto worker = std::static_pointer_cast<Worker>(shared_from_this());
+  return registerInflightRequest(
+    createRequestTag(worker,
+                     data::TagReceive(message, buffer, length, memoryHandle),
+                     enableFuture,
+                     callbackFunction,
+                     callbackData));
+}
+
+void Worker::fence()
+{
+  invokeSerialized([this]() { utils::ucsErrorThrow(ucp_worker_fence(_handle)); });
+}
+
+std::shared_ptr<Request> Worker::flush(const bool enableFuture,
+                                       RequestCallbackUserFunction callbackFunction,
+                                       RequestCallbackUserData callbackData)
+{
+  auto worker = std::static_pointer_cast<Worker>(shared_from_this());
+  return registerInflightRequest(
+    createRequestFlush(worker, data::Flush(), enableFuture, callbackFunction, callbackData));
+}
+
+std::vector<std::shared_ptr<Request>> Worker::closeEndpoints(
+  const std::vector<std::shared_ptr<Endpoint>>& endpoints, const bool enableFuture)
+{
+  std::vector<std::shared_ptr<Request>> requests(endpoints.size());
+  std::vector<std::shared_ptr<RequestEndpointClose>> closes;
+  closes.reserve(endpoints.size());
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    const auto& endpoint = endpoints[i];
+    if (endpoint == nullptr || endpoint->getHandle() == nullptr) continue;
+    closes.push_back(createRequestEndpointClose(
+      endpoint, data::EndpointClose(false), enableFuture, nullptr, nullptr));
+    requests[i] = closes.back();
+  }
+  if (closes.empty()) return requests;
+
+  // Submit all closes from a single generic callback so that they are issued together by
+  // the progress thread, rather than possibly over multiple progress iterations.
+  if (isProgressThreadRunning()) {
+    registerGenericPre([closes]() {
+      for (const auto& req : closes)
+        req->populateDelayedSubmission();
+    });
+  } else {
+    for (const auto& req : closes)
+      registerDelayedSubmission(
+        req, std::bind(std::mem_fn(&Request::populateDelayedSubmission), req.get()));
+  }
+  return requests;
+}
+
 std::shared_ptr<Request> Worker::tagRecv(void* buffer,
                                          size_t length,
                                          Tag tag,
                                          TagMask tagMask,
                                          const bool enableFuture,
                                          RequestCallbackUserFunction callbackFunction,
-                                         RequestCallbackUserData callbackData)
+                                         RequestCallbackUserData callbackData,
+                                         std::shared_ptr<MemoryHandle> memoryHandle)
 {
-  auto worker = std::dynamic_pointer_cast<Worker>(shared_from_this());
-  return registerInflightRequest(createRequestTag(worker,
-                                                  data::TagReceive(buffer, length, tag, tagMask),
-                                                  enableFuture,
-                                                  callbackFunction,
-                                                  callbackData));
+  auto worker = std::static_pointer_cast<Worker>(shared_from_this());
+  return registerInflightRequest(
+    createRequestTag(worker,
+                     data::TagReceive(buffer, length, tag, tagMask, memoryHandle),
+                     enableFuture,
+                     callbackFunction,
+                     callbackData));
+}
+
+std::shared_ptr<TagRecvRing> Worker::createTagRecvRing(size_t numBuffers,
+                                                       size_t bufferSize,
+                                                       Tag tag,
+                                                       TagMask tagMask,
+                                                       TagRecvRingCallback callback)
+{
+  auto worker = std::static_pointer_cast<Worker>(shared_from_this());
+  return ucxx::createTagRecvRing(worker, numBuffers, bufferSize, tag, tagMask, callback);
 }
 
 std::shared_ptr<Address> Worker::getAddress()
 {
-  auto worker  = std::dynamic_pointer_cast<Worker>(shared_from_this());
+  auto worker  = std::static_pointer_cast<Worker>(shared_from_this());
   auto address = ucxx::createAddressFromWorker(worker);
   return address;
 }
@@ -557,7 +1547,7 @@ std::shared_ptr<Endpoint> Worker::createEndpointFromHostname(std::string ipAddre
                                                              uint16_t port,
                                                              bool endpointErrorHandling)
 {
-  auto worker   = std::dynamic_pointer_cast<Worker>(shared_from_this());
+  auto worker   = std::static_pointer_cast<Worker>(shared_from_this());
   auto endpoint = ucxx::createEndpointFromHostname(worker, ipAddress, port, endpointErrorHandling);
   return endpoint;
 }
@@ -565,30 +1555,179 @@ std::shared_ptr<Endpoint> Worker::createEndpointFromHostname(std::string ipAddre
 std::shared_ptr<Endpoint> Worker::createEndpointFromWorkerAddress(std::shared_ptr<Address> address,
                                                                   bool endpointErrorHandling)
 {
-  auto worker   = std::dynamic_pointer_cast<Worker>(shared_from_this());
+  auto worker = std::static_pointer_cast<Worker>(shared_from_this());
+  if (!_endpointCacheEnabled)
+    return ucxx::createEndpointFromWorkerAddress(worker, address, endpointErrorHandling);
+
+  auto isCachedAlive = [](const std::shared_ptr<Endpoint>& endpoint) {
+    return endpoint != nullptr && endpoint->getHandle() != nullptr && endpoint->isAlive();
+  };
+
+  // The error handling mode is part of the key, endpoints created with and without error
+  // handling to the same remote worker are not interchangeable.
+  std::string key = address->getString();
+  key.push_back(endpointErrorHandling ? '\1' : '\0');
+
+  // References obtained from the cache are declared outside of the locked scopes, the
+  // last reference to an endpoint may be released here and destroying an endpoint may
+  // wait for the progress thread, which may concurrently evict errored endpoints.
+  std::shared_ptr<Endpoint> cachedEndpoint{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(_endpointCacheMutex);
+    auto it = _endpointCache.find(key);
+    if (it != _endpointCache.end()) cachedEndpoint = it->second.endpoint.lock();
+  }
+  if (isCachedAlive(cachedEndpoint)) return cachedEndpoint;
+  cachedEndpoint = nullptr;
+
   auto endpoint = ucxx::createEndpointFromWorkerAddress(worker, address, endpointErrorHandling);
-  return endpoint;
+
+  {
+    std::lock_guard<std::mutex> lock(_endpointCacheMutex);
+    if (!_endpointCacheEnabled) return endpoint;
+    auto& cached   = _endpointCache[key];
+    cachedEndpoint = cached.endpoint.lock();
+    // Another thread may have created an endpoint to the same remote worker concurrently,
+    // return that one instead so that all callers share the same endpoint.
+    if (!isCachedAlive(cachedEndpoint)) {
+      cached = CachedEndpoint{.endpoint = endpoint, .callbackData = &endpoint->_callbackData};
+      return endpoint;
+    }
+  }
+  return cachedEndpoint;
+}
+
+std::vector<std::shared_ptr<Endpoint>> Worker::createEndpointsFromHostnames(
+  const std::vector<std::pair<std::string, uint16_t>>& hosts,
+  bool endpointErrorHandling,
+  bool eagerWireup)
+{
+  auto worker    = std::static_pointer_cast<Worker>(shared_from_this());
+  auto endpoints = ucxx::createEndpointsFromHostnames(worker, hosts, endpointErrorHandling);
+  if (eagerWireup)
+    for (const auto& endpoint : endpoints)
+      endpoint->flush();
+  return endpoints;
+}
+
+std::vector<std::shared_ptr<Endpoint>> Worker::createEndpointsFromWorkerAddresses(
+  const std::vector<std::shared_ptr<Address>>& addresses,
+  bool endpointErrorHandling,
+  bool eagerWireup)
+{
+  auto worker = std::static_pointer_cast<Worker>(shared_from_this());
+  auto endpoints =
+    ucxx::createEndpointsFromWorkerAddresses(worker, addresses, endpointErrorHandling);
+  if (eagerWireup)
+    for (const auto& endpoint : endpoints)
+      endpoint->flush();
+  return endpoints;
 }
 
 std::shared_ptr<Listener> Worker::createListener(uint16_t port,
                                                  ucp_listener_conn_callback_t callback,
                                                  void* callbackArgs)
 {
-  auto worker   = std::dynamic_pointer_cast<Worker>(shared_from_this());
+  auto worker   = std::static_pointer_cast<Worker>(shared_from_this());
   auto listener = ucxx::createListener(worker, port, callback, callbackArgs);
   return listener;
 }
 
-void Worker::registerAmAllocator(ucs_memory_type_t memoryType, AmAllocatorType allocator)
+std::shared_ptr<Listener> Worker::createListener(uint16_t port, size_t backlog)
 {
-  if (_amData == nullptr)
+  auto worker   = std::static_pointer_cast<Worker>(shared_from_this());
+  auto listener = ucxx::createListener(worker, port, backlog);
+  return listener;
+}
+
+void Worker::registerAmAllocator(ucs_memory_type_t memoryType,
+                                 AmAllocatorType allocator,
+                                 unsigned int amId)
+{
+  getAmData(amId)->_allocators.insert_or_assign(memoryType, allocator);
+}
+
+void Worker::registerAmHandler(unsigned int amId, AmReceiverCallbackType receiverCallback)
+{
+  auto context = std::dynamic_pointer_cast<Context>(_parent);
+  if (!(context->getFeatureFlags() & UCP_FEATURE_AM))
     throw std::runtime_error("Active Messages was not enabled during context creation");
-  _amData->_allocators.insert_or_assign(memoryType, allocator);
+  if (amId == internal::AmFlowControlId)
+    throw std::invalid_argument("Active message ID " + std::to_string(amId) +
+                                " is reserved for flow control");
+  if (amId == internal::AmAggregationId)
+    throw std::invalid_argument("Active message ID " + std::to_string(amId) +
+                                " is reserved for aggregation");
+
+  createAmData(amId, receiverCallback, std::static_pointer_cast<Worker>(shared_from_this()));
+}
+
+void Worker::setAmZeroCopyEager(const bool enable, unsigned int amId)
+{
+  auto amData = getAmData(amId);
+  std::lock_guard<std::mutex> lock(amData->_mutex);
+  if (amData->_zeroCopyEager == enable) return;
+
+  amData->_zeroCopyEager = enable;
+  try {
+    invokeSerialized([this, &amData]() { setAmRecvHandler(_handle, amData.get()); });
+  } catch (...) {
+    amData->_zeroCopyEager = !enable;
+    throw;
+  }
+}
+
+void Worker::registerBufferPool(std::shared_ptr<BufferPool> pool)
+{
+  std::lock_guard<std::mutex> lock(_bufferPoolsMutex);
+  if (pool == nullptr)
+    _bufferPools.clear();
+  else
+    _bufferPools.insert_or_assign(pool->getType(), pool);
+}
+
+std::shared_ptr<BufferPool> Worker::getBufferPool(const BufferType bufferType) const
+{
+  std::lock_guard<std::mutex> lock(_bufferPoolsMutex);
+  auto pool = _bufferPools.find(bufferType);
+  return pool == _bufferPools.end() ? nullptr : pool->second;
+}
+
+void Worker::registerBufferAllocator(const BufferType bufferType, AmAllocatorType allocator)
+{
+  std::lock_guard<std::mutex> lock(_bufferPoolsMutex);
+  if (allocator)
+    _bufferAllocators.insert_or_assign(bufferType, allocator);
+  else
+    _bufferAllocators.erase(bufferType);
+}
+
+std::shared_ptr<Buffer> Worker::allocateInternalBuffer(const BufferType bufferType,
+                                                       const size_t size)
+{
+  AmAllocatorType allocator{nullptr};
+  std::shared_ptr<BufferPool> pool{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(_bufferPoolsMutex);
+    auto it = _bufferAllocators.find(bufferType);
+    if (it != _bufferAllocators.end()) {
+      allocator = it->second;
+    } else {
+      auto poolIt = _bufferPools.find(bufferType);
+      if (poolIt != _bufferPools.end()) pool = poolIt->second;
+    }
+  }
+
+  if (allocator) return allocator(size);
+  if (pool != nullptr) return pool->allocate(size);
+  return allocateBuffer(bufferType, size);
 }
 
-bool Worker::amProbe(const ucp_ep_h endpointHandle) const
+bool Worker::amProbe(const ucp_ep_h endpointHandle, unsigned int amId) const
 {
-  return _amData->_recvPool.find(endpointHandle) != _amData->_recvPool.end();
+  auto amData = getAmData(amId);
+  std::lock_guard<std::mutex> lock(amData->_mutex);
+  return amData->_recvPool.find(endpointHandle) != amData->_recvPool.end();
 }
 
 }  // namespace ucxx
@@ -0,0 +1,226 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ucxx/address.h>
+#include <ucxx/context.h>
+#include <ucxx/endpoint.h>
+#include <ucxx/listener.h>
+#include <ucxx/log.h>
+#include <ucxx/worker.h>
+#include <ucxx/worker_pool.h>
+
+namespace ucxx {
+
+WorkerPool::WorkerPool(std::shared_ptr<Context> context,
+                       size_t numWorkers,
+                       WorkerPoolPlacement placement,
+                       const bool enableDelayedSubmission,
+                       const bool enableFuture,
+                       WorkerPoolFactory factory)
+  : _context(context), _placement(placement)
+{
+  if (context == nullptr) throw std::invalid_argument("A context is required");
+  if (numWorkers == 0) throw std::invalid_argument("The number of workers must be positive");
+
+  _workers.reserve(numWorkers);
+  for (size_t i = 0; i < numWorkers; ++i)
+    _workers.push_back(factory ? factory(context)
+                               : context->createWorker(enableDelayedSubmission, enableFuture));
+
+  _endpoints.resize(numWorkers);
+  _listeners.resize(numWorkers, 0);
+}
+
+std::shared_ptr<WorkerPool> createWorkerPool(std::shared_ptr<Context> context,
+                                             size_t numWorkers,
+                                             WorkerPoolPlacement placement,
+                                             const bool enableDelayedSubmission,
+                                             const bool enableFuture,
+                                             WorkerPoolFactory factory)
+{
+  auto pool = std::shared_ptr<WorkerPool>(new WorkerPool(
+    context, numWorkers, placement, enableDelayedSubmission, enableFuture, factory));
+
+  ucxx_trace("ucxx::WorkerPool created: %p, workers: %lu, placement: %d",
+             pool.get(),
+             numWorkers,
+             static_cast<int>(placement));
+
+  return pool;
+}
+
+WorkerPool::~WorkerPool() { stopProgressThreads(); }
+
+size_t WorkerPool::size() const { return _workers.size(); }
+
+std::shared_ptr<Worker> WorkerPool::getWorker(size_t index) const { return _workers.at(index); }
+
+const std::vector<std::shared_ptr<Worker>>& WorkerPool::getWorkers() const { return _workers; }
+
+std::vector<size_t> WorkerPool::getEndpointCounts()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::vector<size_t> counts;
+  counts.reserve(_endpoints.size());
+  for (auto& endpoints : _endpoints) {
+    endpoints.erase(std::remove_if(endpoints.begin(),
+                                   endpoints.end(),
+                                   [](const auto& endpoint) { return endpoint.expired(); }),
+                    endpoints.end());
+    counts.push_back(endpoints.size());
+  }
+  return counts;
+}
+
+size_t WorkerPool::selectWorkerIndex(bool listener)
+{
+  if (_placement == WorkerPoolPlacement::RoundRobin) return _next++ % _workers.size();
+
+  // Listeners are few and long-lived, spread them independently of endpoints.
+  if (listener)
+    return std::min_element(_listeners.begin(), _listeners.end()) - _listeners.begin();
+
+  size_t selected     = 0;
+  uint64_t minLoad    = std::numeric_limits<uint64_t>::max();
+  size_t minEndpoints = std::numeric_limits<size_t>::max();
+  for (size_t i = 0; i < _workers.size(); ++i) {
+    auto& endpoints = _endpoints[i];
+    endpoints.erase(std::remove_if(endpoints.begin(),
+                                   endpoints.end(),
+                                   [](const auto& endpoint) { return endpoint.expired(); }),
+                    endpoints.end());
+
+    uint64_t load = 0;
+    if (_placement == WorkerPoolPlacement::LeastLoaded) {
+      auto statistics = _workers[i]->getStatistics();
+      uint64_t done =
+        statistics.requestsCompleted + statistics.requestsFailed + statistics.requestsCanceled;
+      load = statistics.requestsSubmitted - done;
+    }
+
+    if (load < minLoad || (load == minLoad && endpoints.size() < minEndpoints)) {
+      selected     = i;
+      minLoad      = load;
+      minEndpoints = endpoints.size();
+    }
+  }
+  return selected;
+}
+
+std::shared_ptr<Worker> WorkerPool::selectWorker()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _workers[selectWorkerIndex(false)];
+}
+
+std::shared_ptr<Endpoint> WorkerPool::trackEndpoint(size_t index,
+                                                    std::shared_ptr<Endpoint> endpoint)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _endpoints[index].push_back(endpoint);
+  return endpoint;
+}
+
+void WorkerPool::startProgressThreads(const bool pollingMode,
+                                      const int epollTimeout,
+                                      const uint64_t spinPeriodNs,
+                                      const bool pinToNetworkDevices)
+{
+  if (_workers.size() > 1 && !_context->isMtWorkersSharedEnabled())
+    throw std::invalid_argument(
+      "Progressing multiple workers concurrently requires a context created with "
+      "enableMtWorkersShared");
+
+  for (auto& worker : _workers) {
+    auto cpuAffinity =
+      pinToNetworkDevices ? worker->getNetworkDevicesLocalCpus() : std::vector<int>{};
+    worker->startProgressThread(pollingMode, epollTimeout, spinPeriodNs, cpuAffinity);
+  }
+}
+
+void WorkerPool::stopProgressThreads()
+{
+  for (auto& worker : _workers)
+    if (worker->isProgressThreadRunning()) worker->stopProgressThread();
+}
+
+void WorkerPool::setCompletionExecutor(std::shared_ptr<CompletionExecutor> completionExecutor,
+                                       bool notifyFutures)
+{
+  for (auto& worker : _workers)
+    worker->setCompletionExecutor(completionExecutor, notifyFutures);
+}
+
+bool WorkerPool::progress()
+{
+  bool progressed = false;
+  for (auto& worker : _workers)
+    progressed |= worker->progress();
+  return progressed;
+}
+
+std::shared_ptr<Endpoint> WorkerPool::createEndpointFromHostname(std::string ipAddress,
+                                                                 uint16_t port,
+                                                                 bool endpointErrorHandling)
+{
+  size_t index;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    index = selectWorkerIndex(false);
+  }
+  return trackEndpoint(
+    index, _workers[index]->createEndpointFromHostname(ipAddress, port, endpointErrorHandling));
+}
+
+std::shared_ptr<Endpoint> WorkerPool::createEndpointFromWorkerAddress(
+  std::shared_ptr<Address> address, bool endpointErrorHandling)
+{
+  size_t index;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    index = selectWorkerIndex(false);
+  }
+  return trackEndpoint(
+    index, _workers[index]->createEndpointFromWorkerAddress(address, endpointErrorHandling));
+}
+
+std::shared_ptr<Listener> WorkerPool::createListener(uint16_t port,
+                                                     ucp_listener_conn_callback_t callback,
+                                                     void* callbackArgs)
+{
+  size_t index;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    index = selectWorkerIndex(true);
+  }
+  auto listener = _workers[index]->createListener(port, callback, callbackArgs);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  ++_listeners[index];
+  return listener;
+}
+
+std::shared_ptr<Listener> WorkerPool::createListener(uint16_t port, size_t backlog)
+{
+  size_t index;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    index = selectWorkerIndex(true);
+  }
+  auto listener = _workers[index]->createListener(port, backlog);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  ++_listeners[index];
+  return listener;
+}
+
+}  // namespace ucxx
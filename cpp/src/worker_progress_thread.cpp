@@ -2,25 +2,37 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <exception>
 #include <memory>
+#include <vector>
 
 #include <ucxx/log.h>
 #include <ucxx/utils/callback_notifier.h>
+#include <ucxx/utils/cpu_affinity.h>
 #include <ucxx/worker_progress_thread.h>
 
 namespace ucxx {
 
 void WorkerProgressThread::progressUntilSync(
   std::function<bool(void)> progressFunction,
+  std::function<void(void)> signalWorkerFunction,
   const bool& stop,
   ProgressThreadStartCallback startCallback,
   ProgressThreadStartCallbackArg startCallbackArg,
-  std::shared_ptr<DelayedSubmissionCollection> delayedSubmissionCollection)
+  std::shared_ptr<DelayedSubmissionCollection> delayedSubmissionCollection,
+  std::vector<int> cpuAffinity)
 {
+  try {
+    utils::setThreadCpuAffinity(cpuAffinity);
+  } catch (const std::exception& e) {
+    ucxx_error("Failed to set worker progress thread CPU affinity: %s", e.what());
+  }
+
   if (startCallback) startCallback(startCallbackArg);
 
   while (!stop) {
-    delayedSubmissionCollection->processPre();
+    // Wake the progress function immediately if submissions were left over by the budget.
+    if (delayedSubmissionCollection->processPre()) signalWorkerFunction();
 
     progressFunction();
 
@@ -34,19 +46,23 @@ WorkerProgressThread::WorkerProgressThread(
   std::function<void(void)> signalWorkerFunction,
   ProgressThreadStartCallback startCallback,
   ProgressThreadStartCallbackArg startCallbackArg,
-  std::shared_ptr<DelayedSubmissionCollection> delayedSubmissionCollection)
+  std::shared_ptr<DelayedSubmissionCollection> delayedSubmissionCollection,
+  const std::vector<int>& cpuAffinity)
   : _pollingMode(pollingMode),
     _signalWorkerFunction(signalWorkerFunction),
     _startCallback(startCallback),
     _startCallbackArg(startCallbackArg),
-    _delayedSubmissionCollection(delayedSubmissionCollection)
+    _delayedSubmissionCollection(delayedSubmissionCollection),
+    _cpuAffinity(cpuAffinity)
 {
   _thread = std::thread(WorkerProgressThread::progressUntilSync,
                         progressFunction,
+                        _signalWorkerFunction,
                         std::ref(_stop),
                         _startCallback,
                         _startCallbackArg,
-                        _delayedSubmissionCollection);
+                        _delayedSubmissionCollection,
+                        _cpuAffinity);
 }
 
 WorkerProgressThread::~WorkerProgressThread()
@@ -77,4 +93,6 @@ bool WorkerProgressThread::pollingMode() const { return _pollingMode; }
 
 std::thread::id WorkerProgressThread::getId() const { return _thread.get_id(); }
 
+const std::vector<int>& WorkerProgressThread::getCpuAffinity() const { return _cpuAffinity; }
+
 }  // namespace ucxx
@@ -3,13 +3,23 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <numeric>
 #include <utility>
 
+#include <unistd.h>
+
 #include <gtest/gtest.h>
 
 #include <ucxx/api.h>
 
+#if UCXX_ENABLE_RMM
+#include <cuda_runtime_api.h>
+
+#include <rmm/cuda_stream.hpp>
+#endif
+
 namespace {
 
 class BufferAllocator : public ::testing::Test,
@@ -148,7 +158,94 @@ INSTANTIATE_TEST_SUITE_P(Host,
                                          std::make_pair(ucxx::BufferType::Host, 1000),
                                          std::make_pair(ucxx::BufferType::Host, 1000000)));
 
+TEST(HostBufferTest, HugePages)
+{
+  const size_t size = 3 << 20;
+  for (auto hugePages : {ucxx::HugePages::Transparent, ucxx::HugePages::Size2MB}) {
+    auto buffer = ucxx::allocateBuffer(ucxx::BufferType::Host, size, {hugePages, -1, true});
+    ASSERT_EQ(buffer->getType(), ucxx::BufferType::Host);
+    ASSERT_EQ(buffer->getSize(), size);
+
+    auto hostBuffer = std::dynamic_pointer_cast<ucxx::HostBuffer>(buffer);
+    ASSERT_NE(hostBuffer, nullptr);
+    ASSERT_TRUE(hostBuffer->isMapped());
+    // Mapped with huge page alignment, with or without explicit huge pages available
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(hostBuffer->data()) % (2 << 20), 0u);
+
+    auto data = reinterpret_cast<char*>(hostBuffer->data());
+    ASSERT_EQ(std::accumulate(data, data + size, 0), 0);
+    std::fill(data, data + size, 1);
+    ASSERT_EQ(std::accumulate(data, data + size, 0), static_cast<int>(size));
+
+    EXPECT_THROW(hostBuffer->release(), std::runtime_error);
+  }
+
+  // Small buffers use regular pages
+  ucxx::HostBuffer small(1000, {ucxx::HugePages::Size2MB});
+  ASSERT_FALSE(small.isMapped());
+  free(small.release());
+}
+
+TEST(HostBufferTest, NumaNode)
+{
+  if (access("/sys/devices/system/node/node0", F_OK) != 0)
+    GTEST_SKIP() << "NUMA is not supported by the system";
+
+  auto allocator = ucxx::createHostAllocator({ucxx::HugePages::Disabled, 0});
+  auto buffer    = std::dynamic_pointer_cast<ucxx::HostBuffer>(allocator(1000));
+  ASSERT_NE(buffer, nullptr);
+  ASSERT_EQ(buffer->getSize(), 1000u);
+  ASSERT_TRUE(buffer->isMapped());
+  std::fill_n(reinterpret_cast<char*>(buffer->data()), 1000, 1);
+
+  EXPECT_THROW(ucxx::HostBuffer(1000, {ucxx::HugePages::Disabled, 1 << 20}), std::runtime_error);
+}
+
+TEST(PinnedHostBufferTest, Allocate)
+{
 #if UCXX_ENABLE_RMM
+  auto buffer = ucxx::allocateBuffer(ucxx::BufferType::Pinned, 1000);
+  ASSERT_EQ(buffer->getType(), ucxx::BufferType::Pinned);
+  ASSERT_EQ(buffer->getSize(), 1000u);
+
+  auto pinnedBuffer = std::dynamic_pointer_cast<ucxx::PinnedHostBuffer>(buffer);
+  ASSERT_NE(pinnedBuffer, nullptr);
+
+  // Pinned host memory is directly accessible by the host
+  auto data = reinterpret_cast<char*>(pinnedBuffer->data());
+  std::fill(data, data + 1000, 1);
+  ASSERT_EQ(std::accumulate(data, data + 1000, 0), 1000);
+
+  auto releasedBuffer = pinnedBuffer->release();
+  ASSERT_EQ(buffer->getType(), ucxx::BufferType::Invalid);
+  ASSERT_EQ(buffer->getSize(), 0u);
+  EXPECT_THROW(buffer->data(), std::runtime_error);
+  EXPECT_THROW(pinnedBuffer->release(), std::runtime_error);
+
+  cudaFreeHost(releasedBuffer);
+#else
+  EXPECT_THROW(ucxx::allocateBuffer(ucxx::BufferType::Pinned, 1000), std::runtime_error);
+#endif
+}
+
+#if UCXX_ENABLE_RMM
+TEST(RMMBufferTest, StreamOrderedAllocation)
+{
+  rmm::cuda_stream stream{};
+
+  auto buffer = ucxx::allocateBuffer(ucxx::BufferType::RMM, 1000, stream.view());
+  ASSERT_EQ(buffer->getType(), ucxx::BufferType::RMM);
+  ASSERT_EQ(std::dynamic_pointer_cast<ucxx::RMMBuffer>(buffer)->getStream(), stream.view());
+
+  auto allocator = ucxx::createRMMAllocator(stream.view());
+  auto allocated = std::dynamic_pointer_cast<ucxx::RMMBuffer>(allocator(1000));
+  ASSERT_NE(allocated, nullptr);
+  ASSERT_EQ(allocated->getSize(), 1000u);
+  ASSERT_EQ(allocated->getStream(), stream.view());
+
+  stream.synchronize();
+}
+
 INSTANTIATE_TEST_SUITE_P(RMM,
                          BufferAllocator,
                          testing::Values(std::make_pair(ucxx::BufferType::RMM, 1),
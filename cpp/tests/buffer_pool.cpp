@@ -0,0 +1,184 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ucxx/buffer.h>
+#include <ucxx/buffer_pool.h>
+
+namespace {
+
+TEST(BufferPoolTest, ReuseSameSizeClass)
+{
+  auto pool = std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Host);
+
+  void* ptr = nullptr;
+  {
+    auto buffer = pool->allocate(1000);
+    ASSERT_EQ(buffer->getType(), ucxx::BufferType::Host);
+    ASSERT_EQ(buffer->getSize(), 1000u);
+    ptr = buffer->data();
+  }
+  ASSERT_EQ(pool->getHits(), 0u);
+  ASSERT_EQ(pool->getMisses(), 1u);
+  ASSERT_EQ(pool->getCachedBytes(), 1024u);
+
+  // A different size of the same size class reuses the buffer.
+  auto buffer = pool->allocate(600);
+  ASSERT_EQ(buffer->data(), ptr);
+  ASSERT_EQ(buffer->getSize(), 600u);
+  ASSERT_EQ(pool->getHits(), 1u);
+  ASSERT_EQ(pool->getMisses(), 1u);
+  ASSERT_EQ(pool->getCachedBytes(), 0u);
+}
+
+TEST(BufferPoolTest, DifferentSizeClasses)
+{
+  auto pool = std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Host);
+
+  pool->allocate(100);
+  pool->allocate(10000);
+  ASSERT_EQ(pool->getMisses(), 2u);
+  ASSERT_EQ(pool->getCachedBytes(), 256u + 16384u);
+
+  pool->allocate(10000);
+  ASSERT_EQ(pool->getHits(), 1u);
+  ASSERT_EQ(pool->getMisses(), 2u);
+}
+
+TEST(BufferPoolTest, LargeBuffersNotCached)
+{
+  auto pool = std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Host);
+
+  auto buffer = pool->allocate(ucxx::BufferPool::MaxBufferSize + 1);
+  ASSERT_EQ(buffer->getSize(), ucxx::BufferPool::MaxBufferSize + 1);
+  buffer = nullptr;
+
+  ASSERT_EQ(pool->getMisses(), 1u);
+  ASSERT_EQ(pool->getCachedBytes(), 0u);
+}
+
+TEST(BufferPoolTest, CacheLimit)
+{
+  auto pool = std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Host, 1024);
+
+  {
+    auto buffer1 = pool->allocate(1024);
+    auto buffer2 = pool->allocate(1024);
+  }
+  ASSERT_EQ(pool->getCachedBytes(), 1024u);
+
+  pool->clear();
+  ASSERT_EQ(pool->getCachedBytes(), 0u);
+}
+
+TEST(BufferPoolTest, ReleasedBufferNotCached)
+{
+  auto pool = std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Host);
+
+  void* ptr = nullptr;
+  {
+    auto buffer = std::dynamic_pointer_cast<ucxx::HostBuffer>(pool->allocate(1024));
+    ASSERT_NE(buffer, nullptr);
+    ptr = buffer->release();
+  }
+  free(ptr);
+
+  ASSERT_EQ(pool->getCachedBytes(), 0u);
+}
+
+TEST(BufferPoolTest, PoolOutlivedByBuffers)
+{
+  auto pool   = std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Host);
+  auto buffer = pool->allocate(1024);
+  pool        = nullptr;
+
+  ASSERT_NE(buffer->data(), nullptr);
+}
+
+TEST(BufferPoolTest, AmAllocator)
+{
+  auto pool      = std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Host);
+  auto allocator = pool->getAmAllocator();
+
+  allocator(2048);
+  allocator(2048);
+  ASSERT_EQ(pool->getHits(), 1u);
+  ASSERT_EQ(pool->getMisses(), 1u);
+}
+
+TEST(BufferPoolTest, MultipleThreads)
+{
+  const size_t numThreads = 4;
+  const size_t numItems   = 1000;
+
+  auto pool = std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Host);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numThreads; ++t)
+    threads.emplace_back([&pool, numItems]() {
+      for (size_t i = 0; i < numItems; ++i)
+        pool->allocate(4096);
+    });
+  for (auto& t : threads)
+    t.join();
+
+  ASSERT_EQ(pool->getHits() + pool->getMisses(), numThreads * numItems);
+  ASSERT_LE(pool->getMisses(), numThreads);
+}
+
+TEST(BufferPoolTest, HostAllocationOptions)
+{
+  auto pool = std::make_shared<ucxx::BufferPool>(
+    ucxx::BufferType::Host, 64 << 20, ucxx::HostAllocationOptions{ucxx::HugePages::Transparent});
+
+  void* ptr = nullptr;
+  {
+    auto buffer = pool->allocate(3 << 20);
+    ASSERT_TRUE(std::dynamic_pointer_cast<ucxx::HostBuffer>(buffer)->isMapped());
+    ptr = buffer->data();
+  }
+
+  // Mapped buffers are reused as any other
+  auto buffer = pool->allocate(3 << 20);
+  ASSERT_EQ(buffer->data(), ptr);
+  ASSERT_EQ(pool->getHits(), 1u);
+
+  // Buffers too large to be cached are allocated with the same options
+  auto large = pool->allocate(ucxx::BufferPool::MaxBufferSize + 1);
+  ASSERT_TRUE(std::dynamic_pointer_cast<ucxx::HostBuffer>(large)->isMapped());
+}
+
+TEST(BufferPoolTest, InvalidType)
+{
+  EXPECT_THROW(ucxx::BufferPool(ucxx::BufferType::Invalid), std::runtime_error);
+}
+
+TEST(BufferPoolTest, PinnedHostBuffers)
+{
+#if UCXX_ENABLE_RMM
+  auto pool = std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Pinned);
+
+  void* ptr = nullptr;
+  {
+    auto buffer = pool->allocate(1000);
+    ASSERT_EQ(buffer->getType(), ucxx::BufferType::Pinned);
+    ASSERT_NE(std::dynamic_pointer_cast<ucxx::PinnedHostBuffer>(buffer), nullptr);
+    ptr = buffer->data();
+  }
+
+  auto buffer = pool->allocate(1000);
+  ASSERT_EQ(buffer->data(), ptr);
+  ASSERT_EQ(pool->getHits(), 1u);
+#else
+  EXPECT_THROW(ucxx::BufferPool(ucxx::BufferType::Pinned), std::runtime_error);
+#endif
+}
+
+}  // namespace
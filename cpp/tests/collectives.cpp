@@ -0,0 +1,221 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ucxx/api.h>
+
+namespace {
+
+constexpr size_t NumRanks = 5;
+
+class CollectiveGroupTest : public ::testing::TestWithParam<ucxx::CollectiveAlgorithm> {
+ protected:
+  std::shared_ptr<ucxx::Context> _context{
+    ucxx::createContext({}, ucxx::Context::defaultFeatureFlags)};
+  std::vector<std::shared_ptr<ucxx::Worker>> _workers{};
+  std::vector<std::shared_ptr<ucxx::CollectiveGroup>> _groups{};
+  ucxx::CollectiveAlgorithm _algorithm{ucxx::CollectiveAlgorithm::Auto};
+
+  void SetUp()
+  {
+    _algorithm = GetParam();
+
+    for (size_t rank = 0; rank < NumRanks; ++rank)
+      _workers.push_back(_context->createWorker());
+
+    // Small chunks and window to pipeline transfers of the test messages
+    ucxx::CollectiveConfig config{};
+    config.chunkSize      = 1024;
+    config.pairwiseWindow = 2;
+
+    for (size_t rank = 0; rank < NumRanks; ++rank) {
+      std::vector<std::shared_ptr<ucxx::Endpoint>> endpoints;
+      for (size_t peer = 0; peer < NumRanks; ++peer)
+        endpoints.push_back(peer == rank ? nullptr
+                                         : _workers[rank]->createEndpointFromWorkerAddress(
+                                             _workers[peer]->getAddress()));
+      _groups.push_back(
+        ucxx::createCollectiveGroup(_workers[rank], endpoints, rank, ucxx::Tag{0xc011}, config));
+    }
+  }
+
+  void runAllRanks(std::function<void(size_t rank)> function)
+  {
+    std::vector<std::thread> threads;
+    for (size_t rank = 0; rank < NumRanks; ++rank)
+      threads.emplace_back(function, rank);
+    for (auto& thread : threads)
+      thread.join();
+  }
+};
+
+class CollectiveGroupBroadcastTest : public CollectiveGroupTest {};
+class CollectiveGroupAllgatherTest : public CollectiveGroupTest {};
+class CollectiveGroupAllToAllTest : public CollectiveGroupTest {};
+
+TEST_P(CollectiveGroupBroadcastTest, Broadcast)
+{
+  const size_t root = 2;
+  std::vector<std::vector<int>> buffers(NumRanks, std::vector<int>(10000, 0));
+  std::iota(buffers[root].begin(), buffers[root].end(), 0);
+
+  runAllRanks([this, &buffers](size_t rank) {
+    _groups[rank]->broadcast(
+      buffers[rank].data(), buffers[rank].size() * sizeof(int), root, _algorithm);
+  });
+
+  for (size_t rank = 0; rank < NumRanks; ++rank)
+    ASSERT_EQ(buffers[rank], buffers[root]);
+}
+
+TEST_P(CollectiveGroupAllgatherTest, Allgather)
+{
+  const size_t count = 3000;
+  std::vector<std::vector<int>> send(NumRanks, std::vector<int>(count));
+  std::vector<std::vector<int>> recv(NumRanks, std::vector<int>(NumRanks * count, -1));
+  for (size_t rank = 0; rank < NumRanks; ++rank)
+    std::iota(send[rank].begin(), send[rank].end(), rank * count);
+
+  runAllRanks([this, &send, &recv](size_t rank) {
+    _groups[rank]->allgather(send[rank].data(), recv[rank].data(), count * sizeof(int), _algorithm);
+  });
+
+  std::vector<int> expected(NumRanks * count);
+  std::iota(expected.begin(), expected.end(), 0);
+  for (size_t rank = 0; rank < NumRanks; ++rank)
+    ASSERT_EQ(recv[rank], expected);
+}
+
+TEST_P(CollectiveGroupAllgatherTest, AllgatherInPlace)
+{
+  const size_t count = 3000;
+  std::vector<std::vector<int>> recv(NumRanks, std::vector<int>(NumRanks * count, -1));
+  for (size_t rank = 0; rank < NumRanks; ++rank)
+    std::iota(recv[rank].begin() + rank * count, recv[rank].begin() + (rank + 1) * count, 0);
+
+  runAllRanks([this, &recv](size_t rank) {
+    auto block = recv[rank].data() + rank * count;
+    _groups[rank]->allgather(block, recv[rank].data(), count * sizeof(int), _algorithm);
+  });
+
+  for (size_t rank = 0; rank < NumRanks; ++rank)
+    for (size_t block = 0; block < NumRanks; ++block)
+      for (size_t i = 0; i < count; ++i)
+        ASSERT_EQ(recv[rank][block * count + i], static_cast<int>(i));
+}
+
+TEST_P(CollectiveGroupAllToAllTest, AllToAll)
+{
+  const size_t count = 1000;
+  std::vector<std::vector<int>> send(NumRanks, std::vector<int>(NumRanks * count));
+  std::vector<std::vector<int>> recv(NumRanks, std::vector<int>(NumRanks * count, -1));
+  // Block `j` of rank `i` holds `(i * NumRanks + j) * count + k`
+  for (size_t rank = 0; rank < NumRanks; ++rank)
+    std::iota(send[rank].begin(), send[rank].end(), rank * NumRanks * count);
+
+  runAllRanks([this, &send, &recv](size_t rank) {
+    _groups[rank]->allToAll(send[rank].data(), recv[rank].data(), count * sizeof(int), _algorithm);
+  });
+
+  for (size_t rank = 0; rank < NumRanks; ++rank)
+    for (size_t source = 0; source < NumRanks; ++source)
+      for (size_t i = 0; i < count; ++i)
+        ASSERT_EQ(recv[rank][source * count + i],
+                  static_cast<int>((source * NumRanks + rank) * count + i));
+}
+
+TEST_P(CollectiveGroupBroadcastTest, RepeatedOperations)
+{
+  std::vector<std::vector<uint64_t>> buffers(NumRanks, std::vector<uint64_t>(512, 0));
+
+  // Consecutive operations are matched by their sequence number
+  runAllRanks([this, &buffers](size_t rank) {
+    for (size_t root = 0; root < NumRanks; ++root) {
+      if (rank == root) std::fill(buffers[rank].begin(), buffers[rank].end(), root + 1);
+      _groups[rank]->broadcast(
+        buffers[rank].data(), buffers[rank].size() * sizeof(uint64_t), root, _algorithm);
+      for (const auto value : buffers[rank])
+        ASSERT_EQ(value, root + 1);
+    }
+  });
+}
+
+INSTANTIATE_TEST_SUITE_P(Algorithms,
+                         CollectiveGroupBroadcastTest,
+                         testing::Values(ucxx::CollectiveAlgorithm::Auto,
+                                         ucxx::CollectiveAlgorithm::BinomialTree,
+                                         ucxx::CollectiveAlgorithm::Chain));
+
+INSTANTIATE_TEST_SUITE_P(Algorithms,
+                         CollectiveGroupAllgatherTest,
+                         testing::Values(ucxx::CollectiveAlgorithm::Auto,
+                                         ucxx::CollectiveAlgorithm::Direct,
+                                         ucxx::CollectiveAlgorithm::Ring));
+
+INSTANTIATE_TEST_SUITE_P(Algorithms,
+                         CollectiveGroupAllToAllTest,
+                         testing::Values(ucxx::CollectiveAlgorithm::Auto,
+                                         ucxx::CollectiveAlgorithm::Direct,
+                                         ucxx::CollectiveAlgorithm::PairwiseExchange));
+
+TEST(CollectiveGroupSelectionTest, SelectAlgorithm)
+{
+  auto context = ucxx::createContext({}, ucxx::Context::defaultFeatureFlags);
+  auto worker  = context->createWorker();
+
+  ucxx::CollectiveConfig config{};
+  config.smallMessageSize = 1024;
+  config.pairwiseWindow   = 2;
+
+  std::vector<std::shared_ptr<ucxx::Endpoint>> endpoints(NumRanks, nullptr);
+  for (size_t peer = 1; peer < NumRanks; ++peer)
+    endpoints[peer] = worker->createEndpointFromWorkerAddress(worker->getAddress());
+  auto group = ucxx::createCollectiveGroup(worker, endpoints, 0, ucxx::Tag{0xc011}, config);
+  ASSERT_EQ(group->getRank(), 0u);
+  ASSERT_EQ(group->getSize(), NumRanks);
+
+  // Latency algorithms for small messages, bandwidth algorithms for large
+  ASSERT_EQ(group->getBroadcastAlgorithm(1024), ucxx::CollectiveAlgorithm::BinomialTree);
+  ASSERT_EQ(group->getBroadcastAlgorithm(1025), ucxx::CollectiveAlgorithm::Chain);
+  ASSERT_EQ(group->getAllgatherAlgorithm(1024 / NumRanks), ucxx::CollectiveAlgorithm::Direct);
+  ASSERT_EQ(group->getAllgatherAlgorithm(1024), ucxx::CollectiveAlgorithm::Ring);
+  ASSERT_EQ(group->getAllToAllAlgorithm(1024 / NumRanks), ucxx::CollectiveAlgorithm::Direct);
+  ASSERT_EQ(group->getAllToAllAlgorithm(1024), ucxx::CollectiveAlgorithm::PairwiseExchange);
+
+  ASSERT_THROW(group->broadcast(nullptr, 0, NumRanks), std::invalid_argument);
+  ASSERT_THROW(group->broadcast(nullptr, 0, 0, ucxx::CollectiveAlgorithm::Ring),
+               std::invalid_argument);
+  ASSERT_THROW(group->allgather(nullptr, nullptr, 0, ucxx::CollectiveAlgorithm::PairwiseExchange),
+               std::invalid_argument);
+  ASSERT_THROW(group->allToAll(nullptr, nullptr, 0, ucxx::CollectiveAlgorithm::Chain),
+               std::invalid_argument);
+}
+
+TEST(CollectiveGroupSelectionTest, InvalidArguments)
+{
+  auto context = ucxx::createContext({}, ucxx::Context::defaultFeatureFlags);
+  auto worker  = context->createWorker();
+
+  std::vector<std::shared_ptr<ucxx::Endpoint>> endpoints(2, nullptr);
+  ASSERT_THROW(ucxx::createCollectiveGroup(worker, endpoints, 0, ucxx::Tag{0}, {}),
+               std::invalid_argument);
+  endpoints[1] = worker->createEndpointFromWorkerAddress(worker->getAddress());
+  ASSERT_THROW(ucxx::createCollectiveGroup(worker, endpoints, 2, ucxx::Tag{0}, {}),
+               std::invalid_argument);
+
+  ucxx::CollectiveConfig config{};
+  config.chunkSize = 0;
+  ASSERT_THROW(ucxx::createCollectiveGroup(worker, endpoints, 0, ucxx::Tag{0}, config),
+               std::invalid_argument);
+}
+
+}  // namespace
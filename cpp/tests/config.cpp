@@ -2,6 +2,8 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <cstdlib>
+
 #include <gtest/gtest.h>
 
 #include <ucxx/api.h>
@@ -44,4 +46,29 @@ TEST(ConfigTest, ConfigMapTLS)
   // }
 }
 
+TEST(ConfigTest, Cache)
+{
+  ucxx::ConfigMap configMap{{"UCX_TLS", "tcp"}};
+  ucxx::Config config{configMap};
+  ucxx::Config sameConfig{configMap};
+  ucxx::Config otherConfig{{{"UCX_TLS", "sm"}}};
+
+  ASSERT_EQ(config.getHandle(), sameConfig.getHandle());
+  ASSERT_EQ(&config.get(), &sameConfig.get());
+  ASSERT_NE(config.getHandle(), otherConfig.getHandle());
+  ASSERT_EQ(otherConfig.get().at("TLS"), "sm");
+
+  // Changes of `UCX_*` environment variables are reflected
+  ASSERT_EQ(setenv("UCX_ADDRESS_DEBUG_INFO", "y", 1), 0);
+  ucxx::Config environmentConfig{configMap};
+  ASSERT_EQ(unsetenv("UCX_ADDRESS_DEBUG_INFO"), 0);
+  ASSERT_NE(config.getHandle(), environmentConfig.getHandle());
+
+  ucxx::Config::clearCache();
+  ucxx::Config clearedConfig{configMap};
+  ASSERT_NE(config.getHandle(), clearedConfig.getHandle());
+  ASSERT_EQ(clearedConfig.get().at("TLS"), "tcp");
+  ASSERT_EQ(config.get().at("TLS"), "tcp");
+}
+
 }  // namespace
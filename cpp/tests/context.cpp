@@ -4,6 +4,7 @@
  */
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -22,6 +23,16 @@ TEST(ContextTest, HandleIsValid)
   ASSERT_TRUE(context->getHandle() != nullptr);
 }
 
+TEST(ContextTest, MtWorkersShared)
+{
+  auto context = ucxx::createContext({}, ucxx::Context::defaultFeatureFlags);
+  ASSERT_FALSE(context->isMtWorkersSharedEnabled());
+
+  context = ucxx::createContext({}, ucxx::Context::defaultFeatureFlags, true);
+  ASSERT_TRUE(context->isMtWorkersSharedEnabled());
+  ASSERT_TRUE(context->getHandle() != nullptr);
+}
+
 TEST(ContextTest, DefaultConfigsAndFlags)
 {
   static constexpr auto featureFlags = ucxx::Context::defaultFeatureFlags;
@@ -37,6 +48,23 @@ TEST(ContextTest, DefaultConfigsAndFlags)
   ASSERT_EQ(context->getFeatureFlags(), featureFlags);
 }
 
+TEST(ContextTest, CreateMemoryHandle)
+{
+  auto context = ucxx::createContext({}, ucxx::Context::defaultFeatureFlags);
+
+  auto allocated = context->createMemoryHandle(1 << 20);
+  ASSERT_NE(allocated->getHandle(), nullptr);
+  ASSERT_NE(allocated->getBaseAddress(), nullptr);
+  ASSERT_GE(allocated->getSize(), 1u << 20);
+  ASSERT_EQ(allocated->getMemoryType(), UCS_MEMORY_TYPE_HOST);
+
+  std::vector<char> buffer(1 << 20);
+  auto registered = context->createMemoryHandle(buffer.size(), buffer.data());
+  ASSERT_NE(registered->getHandle(), nullptr);
+  ASSERT_TRUE(registered->contains(buffer.data(), buffer.size()));
+  ASSERT_TRUE(registered->contains(buffer.data() + 1024, 1024));
+}
+
 TEST_P(ContextTestCustomConfig, TLS)
 {
   auto tls                           = GetParam();
@@ -77,6 +105,25 @@ TEST(ContextTest, CreateWorker)
   ASSERT_TRUE(worker2 != nullptr);
 }
 
+TEST(ContextTest, InternAddress)
+{
+  auto context = ucxx::createContext({}, ucxx::Context::defaultFeatureFlags);
+  auto worker  = context->createWorker();
+
+  auto addressString = worker->getAddress()->getString();
+  auto address       = context->internAddress(addressString);
+  ASSERT_EQ(address->getString(), addressString);
+  ASSERT_EQ(context->internAddress(addressString), address);
+
+  // Released addresses are recreated
+  address.reset();
+  address = context->internAddress(addressString);
+  ASSERT_EQ(address->getString(), addressString);
+
+  auto ep = worker->createEndpointFromWorkerAddress(address);
+  ASSERT_TRUE(ep->getHandle() != nullptr);
+}
+
 INSTANTIATE_TEST_SUITE_P(TLS, ContextTestCustomConfig, testing::ValuesIn(TlsConfig));
 
 }  // namespace
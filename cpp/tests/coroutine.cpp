@@ -0,0 +1,106 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ucxx/api.h>
+#include <ucxx/coroutine.h>
+
+namespace {
+
+class CoroutineTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<ucxx::Context> _context{
+    ucxx::createContext({}, ucxx::Context::defaultFeatureFlags)};
+  std::shared_ptr<ucxx::Worker> _worker{nullptr};
+  std::shared_ptr<ucxx::Endpoint> _ep{nullptr};
+
+  void SetUp()
+  {
+    _worker = _context->createWorker();
+    _ep     = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+  }
+};
+
+TEST_F(CoroutineTest, AwaitTagTransfers)
+{
+  ucxx::coro::Scheduler scheduler(_worker);
+
+  const size_t numMessages = 10;
+  std::vector<int> send(numMessages), recv(numMessages, -1);
+  size_t completed = 0;
+
+  auto transfer = [&](size_t i) -> ucxx::coro::DetachedTask {
+    send[i] = static_cast<int>(i);
+    std::vector<std::shared_ptr<ucxx::Request>> requests;
+    requests.push_back(_ep->tagSend(&send[i], sizeof(int), ucxx::Tag{i}));
+    requests.push_back(_ep->tagRecv(&recv[i], sizeof(int), ucxx::Tag{i}, ucxx::TagMaskFull));
+    co_await scheduler.wait(requests);
+    ++completed;
+  };
+
+  for (size_t i = 0; i < numMessages; ++i)
+    transfer(i);
+
+  scheduler.run();
+
+  ASSERT_EQ(completed, numMessages);
+  ASSERT_EQ(scheduler.getSuspendedCount(), 0u);
+  ASSERT_EQ(recv, send);
+}
+
+TEST_F(CoroutineTest, SequentialAwaits)
+{
+  ucxx::coro::Scheduler scheduler(_worker);
+
+  std::vector<int> buffer{1}, recv{0};
+  bool completed = false;
+
+  auto pingPong = [&]() -> ucxx::coro::DetachedTask {
+    for (int i = 0; i < 5; ++i) {
+      co_await scheduler.wait(_ep->tagSend(buffer.data(), sizeof(int), ucxx::Tag{0}));
+      co_await scheduler.wait(
+        _ep->tagRecv(recv.data(), sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull));
+      ++buffer[0];
+    }
+    completed = true;
+  };
+  pingPong();
+
+  scheduler.run();
+
+  ASSERT_TRUE(completed);
+  ASSERT_EQ(recv[0], 5);
+}
+
+TEST_F(CoroutineTest, ErrorRethrown)
+{
+  ucxx::coro::Scheduler scheduler(_worker);
+
+  std::vector<int> small{0}, large{1, 2, 3};
+  bool raised = false;
+
+  auto truncated = [&]() -> ucxx::coro::DetachedTask {
+    std::vector<std::shared_ptr<ucxx::Request>> requests;
+    requests.push_back(_ep->tagSend(large.data(), large.size() * sizeof(int), ucxx::Tag{0}));
+    requests.push_back(
+      _ep->tagRecv(small.data(), small.size() * sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull));
+    try {
+      co_await scheduler.wait(requests);
+    } catch (const ucxx::Error&) {
+      raised = true;
+    }
+  };
+  truncated();
+
+  scheduler.run();
+
+  ASSERT_TRUE(raised);
+}
+
+}  // namespace
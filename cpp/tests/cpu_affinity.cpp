@@ -0,0 +1,63 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <ucxx/utils/cpu_affinity.h>
+
+using ::testing::ContainerEq;
+
+namespace {
+
+TEST(CpuAffinityTest, ParseCpuList)
+{
+  ASSERT_THAT(ucxx::utils::parseCpuList(""), ContainerEq(std::vector<int>{}));
+  ASSERT_THAT(ucxx::utils::parseCpuList("3"), ContainerEq(std::vector<int>{3}));
+  ASSERT_THAT(ucxx::utils::parseCpuList("0-3,8,10-11\n"),
+              ContainerEq(std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+  ASSERT_THAT(ucxx::utils::parseCpuList("4,0-1,1"), ContainerEq(std::vector<int>{0, 1, 4}));
+}
+
+TEST(CpuAffinityTest, ParseInvalidCpuList)
+{
+  EXPECT_THROW(ucxx::utils::parseCpuList("a"), std::invalid_argument);
+  EXPECT_THROW(ucxx::utils::parseCpuList("3-1"), std::invalid_argument);
+  EXPECT_THROW(ucxx::utils::parseCpuList("0-"), std::invalid_argument);
+}
+
+TEST(CpuAffinityTest, UnknownNetworkDevice)
+{
+  ASSERT_TRUE(ucxx::utils::getNetworkDevicesLocalCpus("all").empty());
+  ASSERT_TRUE(ucxx::utils::getNetworkDevicesLocalCpus("ucxx_nonexistent_device:1").empty());
+}
+
+TEST(CpuAffinityTest, SetThreadCpuAffinity)
+{
+  cpu_set_t original;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(original), &original), 0);
+  int allowedCpu = 0;
+  while (!CPU_ISSET(allowedCpu, &original))
+    ++allowedCpu;
+
+  std::thread thread([allowedCpu]() {
+    ucxx::utils::setThreadCpuAffinity({allowedCpu});
+
+    cpu_set_t cpuSet;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(cpuSet), &cpuSet), 0);
+    ASSERT_EQ(CPU_COUNT(&cpuSet), 1);
+    ASSERT_TRUE(CPU_ISSET(allowedCpu, &cpuSet));
+  });
+  thread.join();
+
+  EXPECT_THROW(ucxx::utils::setThreadCpuAffinity({-1}), std::runtime_error);
+}
+
+}  // namespace
@@ -0,0 +1,208 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <atomic>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <ucxx/delayed_submission.h>
+#include <ucxx/utils/mpsc_queue.h>
+
+using ::testing::ContainerEq;
+
+namespace {
+
+TEST(MPSCQueueTest, ConsumeOrder)
+{
+  ucxx::utils::MPSCQueue<int> queue;
+  std::vector<int> expected(10);
+  std::iota(expected.begin(), expected.end(), 0);
+
+  ASSERT_TRUE(queue.empty());
+  for (const auto& i : expected)
+    queue.push(i);
+  ASSERT_FALSE(queue.empty());
+
+  std::vector<int> consumed;
+  ASSERT_EQ(queue.consume([&consumed](int& i) { consumed.push_back(i); }), expected.size());
+  ASSERT_THAT(consumed, ContainerEq(expected));
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(queue.consume([](int&) {}), 0u);
+}
+
+TEST(MPSCQueueTest, MultipleProducers)
+{
+  const size_t numThreads = 8;
+  const size_t numItems   = 10000;
+
+  ucxx::utils::MPSCQueue<size_t> queue;
+  std::atomic<bool> stop{false};
+  std::vector<size_t> consumed;
+
+  std::thread consumer([&queue, &stop, &consumed]() {
+    auto consume = [&consumed](size_t& i) { consumed.push_back(i); };
+    while (!stop)
+      queue.consume(consume);
+    queue.consume(consume);
+  });
+
+  std::vector<std::thread> producers;
+  for (size_t t = 0; t < numThreads; ++t)
+    producers.emplace_back([&queue, t, numItems]() {
+      for (size_t i = 0; i < numItems; ++i)
+        queue.push(t * numItems + i);
+    });
+  for (auto& p : producers)
+    p.join();
+  stop = true;
+  consumer.join();
+
+  ASSERT_EQ(consumed.size(), numThreads * numItems);
+
+  // Items from the same producer must be consumed in the order they were pushed.
+  std::vector<size_t> last(numThreads, 0);
+  std::vector<bool> seen(numThreads, false);
+  for (const auto& i : consumed) {
+    const size_t t = i / numItems;
+    if (seen[t]) { ASSERT_GT(i, last[t]); }
+    seen[t] = true;
+    last[t] = i;
+  }
+}
+
+TEST(DelayedSubmissionTest, GenericRescheduleDuringProcess)
+{
+  ucxx::DelayedSubmissionCollection collection{false};
+  size_t calls = 0;
+
+  collection.registerGenericPre([&collection, &calls]() {
+    ++calls;
+    collection.registerGenericPre([&calls]() { ++calls; });
+  });
+
+  // Callbacks registered while processing must only run on the next call.
+  collection.processPre();
+  ASSERT_EQ(calls, 1u);
+  collection.processPre();
+  ASSERT_EQ(calls, 2u);
+  collection.processPre();
+  ASSERT_EQ(calls, 2u);
+}
+
+TEST(DelayedSubmissionTest, CoalescedSignal)
+{
+  ucxx::DelayedSubmissionCollection collection{true};
+
+  // Only the first registration since the last processing requires a signal.
+  ASSERT_TRUE(collection.registerRequest(nullptr, []() {}));
+  ASSERT_FALSE(collection.registerRequest(nullptr, []() {}));
+  ASSERT_FALSE(collection.registerGenericPre([]() {}));
+  ASSERT_TRUE(collection.registerGenericPost([]() {}));
+  ASSERT_FALSE(collection.registerGenericPost([]() {}));
+
+  collection.processPre();
+  ASSERT_TRUE(collection.registerGenericPre([]() {}));
+  ASSERT_FALSE(collection.registerGenericPost([]() {}));
+
+  collection.processPost();
+  ASSERT_TRUE(collection.registerGenericPost([]() {}));
+}
+
+TEST(DelayedSubmissionTest, RequestsDisabled)
+{
+  ucxx::DelayedSubmissionCollection collection{false};
+
+  ASSERT_FALSE(collection.isDelayedRequestSubmissionEnabled());
+  EXPECT_THROW(collection.registerRequest(nullptr, []() {}), std::runtime_error);
+}
+
+TEST(DelayedSubmissionTest, RequestsFromMultipleThreads)
+{
+  const size_t numThreads = 4;
+  const size_t numItems   = 1000;
+
+  ucxx::DelayedSubmissionCollection collection{true};
+  std::atomic<size_t> calls{0};
+
+  std::vector<std::thread> producers;
+  for (size_t t = 0; t < numThreads; ++t)
+    producers.emplace_back([&collection, &calls, numItems]() {
+      for (size_t i = 0; i < numItems; ++i)
+        collection.registerRequest(nullptr, [&calls]() { ++calls; });
+    });
+  for (auto& p : producers)
+    p.join();
+
+  collection.processPre();
+  ASSERT_EQ(calls, numThreads * numItems);
+}
+
+TEST(DelayedSubmissionTest, PriorityOrder)
+{
+  ucxx::DelayedSubmissionCollection collection{true};
+  std::string order;
+
+  collection.registerRequest(nullptr, [&order]() { order += "b"; }, ucxx::SubmissionPriority::Bulk);
+  collection.registerRequest(nullptr, [&order]() { order += "n"; });
+  collection.registerRequest(nullptr, [&order]() { order += "h"; }, ucxx::SubmissionPriority::High);
+
+  ASSERT_FALSE(collection.processPre());
+  ASSERT_EQ(order, "hnb");
+}
+
+TEST(DelayedSubmissionTest, Budget)
+{
+  ucxx::DelayedSubmissionCollection collection{true};
+  std::vector<int> high, normal, bulk;
+
+  collection.setRequestBudget(4);
+  ASSERT_EQ(collection.getRequestBudget(), 4u);
+
+  for (int i = 0; i < 10; ++i) {
+    collection.registerRequest(nullptr, [&normal, i]() { normal.push_back(i); });
+    collection.registerRequest(
+      nullptr, [&bulk, i]() { bulk.push_back(i); }, ucxx::SubmissionPriority::Bulk);
+  }
+  for (int i = 0; i < 10; ++i)
+    collection.registerRequest(
+      nullptr, [&high, i]() { high.push_back(i); }, ucxx::SubmissionPriority::High);
+
+  // High priority requests are not limited by the budget, a share is reserved for bulk.
+  ASSERT_TRUE(collection.processPre());
+  ASSERT_EQ(high.size(), 10u);
+  ASSERT_EQ(normal.size(), 3u);
+  ASSERT_EQ(bulk.size(), 1u);
+
+  // Registrations need not signal while requests are left over by the budget.
+  ASSERT_FALSE(collection.registerRequest(
+    nullptr, [&high]() { high.push_back(10); }, ucxx::SubmissionPriority::High));
+
+  ASSERT_TRUE(collection.processPre());
+  ASSERT_EQ(high.size(), 11u);
+  ASSERT_EQ(normal.size(), 6u);
+  ASSERT_EQ(bulk.size(), 2u);
+
+  ASSERT_TRUE(collection.processPre());
+  ASSERT_EQ(normal.size(), 9u);
+  ASSERT_EQ(bulk.size(), 3u);
+
+  // Budget left unused by normal requests goes to bulk requests.
+  ASSERT_TRUE(collection.processPre());
+  ASSERT_EQ(normal.size(), 10u);
+  ASSERT_EQ(bulk.size(), 6u);
+  ASSERT_FALSE(collection.processPre());
+  ASSERT_EQ(bulk.size(), 10u);
+
+  std::vector<int> expected(10);
+  std::iota(expected.begin(), expected.end(), 0);
+  ASSERT_THAT(normal, ContainerEq(expected));
+  ASSERT_THAT(bulk, ContainerEq(expected));
+}
+
+}  // namespace
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include <memory>
+#include <set>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -56,4 +57,224 @@ TEST_F(EndpointTest, IsAlive)
   ASSERT_FALSE(ep->isAlive());
 }
 
+TEST_F(EndpointTest, DeriveTags)
+{
+  auto ep = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+  _worker->progress();
+
+  // Loopback endpoint, sends are received by itself
+  ep->setTagBases(ucxx::Tag{0x1234}, ucxx::Tag{0x1234});
+  ASSERT_EQ(ep->getSendTagBase(), ucxx::Tag{0x1234});
+  ASSERT_EQ(ep->getRecvTagBase(), ucxx::Tag{0x1234});
+  ASSERT_EQ(ep->deriveSendTag(7), ep->deriveRecvTag(7));
+  ASSERT_EQ(ep->deriveSendTag(7), ucxx::utils::deriveTag(ucxx::Tag{0x1234}, 7));
+
+  // Distinct user tags never derive the same tag
+  std::set<ucxx::Tag> tags;
+  for (uint64_t userTag = 0; userTag < 1024; ++userTag)
+    tags.insert(ep->deriveSendTag(userTag));
+  ASSERT_EQ(tags.size(), 1024u);
+
+  std::vector<int> send{123}, recv{0};
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(ep->tagSend(send.data(), sizeof(int), ep->deriveSendTag(42)));
+  requests.push_back(
+    ep->tagRecv(recv.data(), sizeof(int), ep->deriveRecvTag(42), ucxx::TagMaskFull));
+  while (!requests[0]->isCompleted() || !requests[1]->isCompleted())
+    _worker->progress();
+  requests[1]->checkError();
+  ASSERT_EQ(recv[0], send[0]);
+}
+
+TEST_F(EndpointTest, CreateEndpointsFromWorkerAddresses)
+{
+  std::vector<std::shared_ptr<ucxx::Address>> addresses(4, _remoteWorker->getAddress());
+
+  auto eps = _worker->createEndpointsFromWorkerAddresses(addresses, true, true);
+  ASSERT_EQ(eps.size(), addresses.size());
+  for (const auto& ep : eps) {
+    ASSERT_NE(ep->getHandle(), nullptr);
+    ASSERT_EQ(ep->getParent(), _worker);
+  }
+
+  // Eager wireup flushes are submitted without being awaited by the caller
+  for (const auto& ep : eps) {
+    while (ep->getStatistics().requestsCompleted + ep->getStatistics().requestsFailed == 0) {
+      _worker->progress();
+      _remoteWorker->progress();
+    }
+    ASSERT_EQ(ep->getStatistics().requestsCompleted, 1);
+  }
+
+  ASSERT_THROW(_worker->createEndpointsFromWorkerAddresses({nullptr}), ucxx::Error);
+}
+
+TEST_F(EndpointTest, EndpointCache)
+{
+  auto address = _remoteWorker->getAddress();
+
+  // Disabled by default
+  ASSERT_FALSE(_worker->isEndpointCacheEnabled());
+  auto uncached1 = _worker->createEndpointFromWorkerAddress(address);
+  auto uncached2 = _worker->createEndpointFromWorkerAddress(address);
+  ASSERT_NE(uncached1, uncached2);
+
+  _worker->setEndpointCacheEnabled(true);
+  ASSERT_TRUE(_worker->isEndpointCacheEnabled());
+
+  auto ep = _worker->createEndpointFromWorkerAddress(address);
+  ASSERT_EQ(_worker->createEndpointFromWorkerAddress(address), ep);
+  // Addresses with the same contents refer to the same remote worker
+  ASSERT_EQ(_worker->createEndpointFromWorkerAddress(
+              ucxx::createAddressFromString(address->getString())),
+            ep);
+
+  // Error handling modes are not interchangeable
+  auto epNoErrorHandling = _worker->createEndpointFromWorkerAddress(address, false);
+  ASSERT_NE(epNoErrorHandling, ep);
+  ASSERT_EQ(_worker->createEndpointFromWorkerAddress(address, false), epNoErrorHandling);
+
+  // Closed endpoints are not reused
+  ep->close();
+  auto newEp = _worker->createEndpointFromWorkerAddress(address);
+  ASSERT_NE(newEp, ep);
+  ASSERT_NE(newEp->getHandle(), nullptr);
+
+  // The cache doesn't hold references
+  std::weak_ptr<ucxx::Endpoint> weakEp = newEp;
+  newEp.reset();
+  ASSERT_TRUE(weakEp.expired());
+
+  _worker->setEndpointCacheEnabled(false);
+  ASSERT_NE(_worker->createEndpointFromWorkerAddress(address, false), epNoErrorHandling);
+}
+
+TEST_F(EndpointTest, CloseAsync)
+{
+  auto ep = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+  _worker->progress();
+
+  bool closeCallbackCalled = false;
+  ep->setCloseCallback([&closeCallbackCalled](void*) { closeCallbackCalled = true; }, nullptr);
+
+  auto req = ep->closeAsync();
+  ASSERT_EQ(ep->getHandle(), nullptr);
+  while (!req->isCompleted())
+    _worker->progress();
+  req->checkError();
+  ASSERT_TRUE(closeCallbackCalled);
+
+  // Closing again is a no-op
+  ep->close();
+  ASSERT_THROW(ep->closeAsync(), ucxx::Error);
+}
+
+TEST_F(EndpointTest, CloseFlush)
+{
+  auto ep = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+  _worker->progress();
+
+  std::vector<int> send(1024, 42);
+  std::vector<int> recv(send.size());
+  auto sendReq = ep->tagSend(send.data(), send.size() * sizeof(int), ucxx::Tag{0});
+
+  // Outstanding send completes successfully instead of being canceled
+  ep->close(0, 1, ucxx::EndpointCloseMode::Flush);
+  ASSERT_EQ(ep->getHandle(), nullptr);
+  ASSERT_TRUE(sendReq->isCompleted());
+  sendReq->checkError();
+
+  auto recvReq =
+    _worker->tagRecv(recv.data(), recv.size() * sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull);
+  while (!recvReq->isCompleted())
+    _worker->progress();
+  recvReq->checkError();
+  ASSERT_EQ(recv, send);
+}
+
+TEST_F(EndpointTest, AbortUnsubmitted)
+{
+  auto worker = _context->createWorker(true);
+  auto ep     = worker->createEndpointFromWorkerAddress(worker->getAddress());
+  worker->progress();
+
+  std::vector<int> send(1024, 42);
+  std::vector<int> recv(send.size());
+  auto sendReq = ep->tagSend(send.data(), send.size() * sizeof(int), ucxx::Tag{0});
+  auto recvReq =
+    ep->tagRecv(recv.data(), recv.size() * sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull);
+
+  // Awaiting delayed submission, aborting completes them immediately
+  sendReq->abort();
+  recvReq->abort();
+  ASSERT_EQ(sendReq->getStatus(), UCS_ERR_CANCELED);
+  ASSERT_EQ(recvReq->getStatus(), UCS_ERR_CANCELED);
+
+  // Aborted requests are not submitted
+  auto workerRecvReq =
+    worker->tagRecv(recv.data(), recv.size() * sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull);
+  for (size_t i = 0; i < 10; ++i)
+    worker->progress();
+  ASSERT_FALSE(workerRecvReq->isCompleted());
+
+  workerRecvReq->cancel();
+  while (!workerRecvReq->isCompleted())
+    worker->progress();
+  ASSERT_EQ(workerRecvReq->getStatus(), UCS_ERR_CANCELED);
+  ASSERT_EQ(sendReq->getStatus(), UCS_ERR_CANCELED);
+}
+
+TEST_F(EndpointTest, CloseEndpoints)
+{
+  std::vector<std::shared_ptr<ucxx::Endpoint>> eps;
+  for (size_t i = 0; i < 8; ++i)
+    eps.push_back(_worker->createEndpointFromWorkerAddress(_worker->getAddress()));
+  _worker->progress();
+
+  // Already closed endpoints are skipped, keeping remaining requests at their indices
+  eps.front()->close();
+
+  auto requests = _worker->closeEndpoints(eps);
+  ASSERT_EQ(requests.size(), eps.size());
+  ASSERT_EQ(requests.front(), nullptr);
+  for (size_t i = 1; i < requests.size(); ++i) {
+    auto& req = requests[i];
+    ASSERT_NE(req, nullptr);
+    while (!req->isCompleted())
+      _worker->progress();
+    req->checkError();
+  }
+  for (const auto& ep : eps)
+    ASSERT_EQ(ep->getHandle(), nullptr);
+}
+
+TEST_F(EndpointTest, Transports)
+{
+  auto ep = _worker->createEndpointFromWorkerAddress(_remoteWorker->getAddress());
+
+  std::vector<int> send{123};
+  std::vector<int> recv(send.size());
+  auto sendReq = ep->tagSend(send.data(), send.size() * sizeof(int), ucxx::Tag{0});
+  auto recvReq = _remoteWorker->tagRecv(
+    recv.data(), recv.size() * sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull);
+  while (!sendReq->isCompleted() || !recvReq->isCompleted()) {
+    _worker->progress();
+    _remoteWorker->progress();
+  }
+
+  auto transports = ep->getTransports();
+  ASSERT_FALSE(transports.empty());
+  for (const auto& transport : transports)
+    ASSERT_FALSE(transport.transportName.empty());
+  ASSERT_FALSE(ep->getInfo().empty());
+
+  // Both workers belong to the same process
+  ASSERT_TRUE(ep->isIntraNode());
+  ASSERT_NE(_worker->getTopologyLocality(_remoteWorker->getTopology()),
+            ucxx::TopologyLocality::Remote);
+
+  ep->close();
+  ASSERT_THROW(ep->getTransports(), ucxx::Error);
+}
+
 }  // namespace
@@ -3,7 +3,12 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <numeric>
+#include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -58,6 +63,165 @@ TEST(HeaderTest, PointerConstructor)
   ASSERT_THAT(deserialized.size, ContainerEq(header.size));
 }
 
+TEST(HeaderTest, CompactSerializedSize)
+{
+  const bool next         = false;
+  const size_t framesSize = 1;
+  std::vector<int> isCUDA{0};
+  std::vector<size_t> size{1};
+
+  const ucxx::Header header(next, framesSize, isCUDA.data(), size.data());
+
+  // Version, flags, number of frames, CUDA bitmap and frame size, all a single byte each
+  const auto compact = ucxx::HeaderFormat::Compact;
+  ASSERT_EQ(header.serializedSize(compact), size_t{5});
+  ASSERT_EQ(header.serialize(compact).size(), header.serializedSize(compact));
+  ASSERT_LT(header.serializedSize(compact), header.dataSize());
+}
+
+TEST(HeaderTest, LegacyByDefault)
+{
+  const bool next      = true;
+  const size_t nframes = 2;
+  std::array<int, ucxx::HeaderFramesSize> isCUDA{1, 0};
+  std::array<size_t, ucxx::HeaderFramesSize> size{123, 456};
+
+  const ucxx::Header header(next, nframes, isCUDA.data(), size.data());
+
+  // Fixed-size format, as parsed by peers without compact header support
+  std::string legacy;
+  legacy.append(reinterpret_cast<const char*>(&next), sizeof(next));
+  legacy.append(reinterpret_cast<const char*>(&nframes), sizeof(nframes));
+  legacy.append(reinterpret_cast<const char*>(isCUDA.data()), sizeof(isCUDA));
+  legacy.append(reinterpret_cast<const char*>(size.data()), sizeof(size));
+
+  ASSERT_EQ(header.serializedSize(), legacy.size());
+  ASSERT_EQ(header.serialize(), legacy);
+  ASSERT_EQ(header.serialize(ucxx::HeaderFormat::Legacy), legacy);
+
+  // Compressed frames are only described by the compact format
+  std::array<size_t, ucxx::HeaderFramesSize> compressedSize{0, 100};
+  const ucxx::Header compressed(
+    next, nframes, isCUDA.data(), size.data(), compressedSize.data(), 1);
+  ASSERT_EQ(compressed.serialize(), compressed.serialize(ucxx::HeaderFormat::Compact));
+  ASSERT_LT(compressed.serializedSize(), legacy.size());
+}
+
+TEST(HeaderTest, SerializeToBuffer)
+{
+  const bool next         = true;
+  const size_t framesSize = 3;
+  std::vector<int> isCUDA{0, ucxx::HeaderFramePacked, 1};
+  std::vector<size_t> size{0, 300, size_t{1} << 40};
+
+  const ucxx::Header header(next, framesSize, isCUDA.data(), size.data());
+
+  for (const auto format : {ucxx::HeaderFormat::Legacy, ucxx::HeaderFormat::Compact}) {
+    std::vector<char> buffer(header.dataSize(), 0);
+    EXPECT_THROW(header.serialize(buffer.data(), header.serializedSize(format) - 1, format),
+                 std::length_error);
+    ASSERT_EQ(header.serialize(buffer.data(), buffer.size(), format),
+              header.serializedSize(format));
+
+    // Deserialize from a receive buffer larger than the serialized header
+    const ucxx::Header deserialized(buffer.data(), buffer.size());
+
+    ASSERT_EQ(deserialized.next, header.next);
+    ASSERT_EQ(deserialized.nframes, header.nframes);
+    ASSERT_THAT(deserialized.isCUDA, ContainerEq(header.isCUDA));
+    ASSERT_THAT(deserialized.size, ContainerEq(header.size));
+  }
+}
+
+TEST(HeaderTest, DeserializeLegacy)
+{
+  const bool next      = true;
+  const size_t nframes = 2;
+  std::array<int, ucxx::HeaderFramesSize> isCUDA{1, 0};
+  std::array<size_t, ucxx::HeaderFramesSize> size{123, 456};
+
+  // Fixed-size format, as sent by peers without compact header support
+  std::string legacy;
+  legacy.append(reinterpret_cast<const char*>(&next), sizeof(next));
+  legacy.append(reinterpret_cast<const char*>(&nframes), sizeof(nframes));
+  legacy.append(reinterpret_cast<const char*>(isCUDA.data()), sizeof(isCUDA));
+  legacy.append(reinterpret_cast<const char*>(size.data()), sizeof(size));
+  ASSERT_EQ(legacy.size(), ucxx::Header::dataSize());
+
+  const ucxx::Header deserialized(legacy);
+
+  ASSERT_EQ(deserialized.next, next);
+  ASSERT_EQ(deserialized.nframes, nframes);
+  ASSERT_THAT(deserialized.isCUDA, ContainerEq(isCUDA));
+  ASSERT_THAT(deserialized.size, ContainerEq(size));
+}
+
+TEST(HeaderTest, DeserializeMalformed)
+{
+  const bool next         = false;
+  const size_t framesSize = 2;
+  std::vector<int> isCUDA{0, 0};
+  std::vector<size_t> size{1000, 2000};
+
+  const ucxx::Header header(next, framesSize, isCUDA.data(), size.data());
+
+  for (const auto format : {ucxx::HeaderFormat::Legacy, ucxx::HeaderFormat::Compact}) {
+    auto serialized = header.serialize(format);
+    EXPECT_THROW(ucxx::Header(serialized.substr(0, serialized.size() - 1)), std::runtime_error);
+  }
+  EXPECT_THROW(ucxx::Header(std::string{}), std::runtime_error);
+}
+
+TEST(HeaderTest, Compressed)
+{
+  std::vector<int> isCUDA{0, ucxx::HeaderFramePacked, 0, 1};
+  std::vector<size_t> size{100000, 10, 200000, 300000};
+  std::vector<size_t> compressedSize{5000, 0, 0, 0};
+  const auto codec = static_cast<uint8_t>(ucxx::CompressionCodec::LZ4);
+
+  auto headers = ucxx::Header::buildHeaders(size, isCUDA, compressedSize, codec);
+  ASSERT_EQ(headers.size(), size_t{1});
+
+  const auto uncompressed = ucxx::Header::buildHeaders(size, isCUDA);
+  ASSERT_GT(headers[0].serializedSize(),
+            uncompressed[0].serializedSize(ucxx::HeaderFormat::Compact));
+
+  const ucxx::Header deserialized(headers[0].serialize());
+
+  ASSERT_EQ(deserialized.nframes, size.size());
+  ASSERT_EQ(deserialized.compression, codec);
+  ASSERT_THAT(deserialized.isCUDA, ContainerEq(headers[0].isCUDA));
+  ASSERT_THAT(deserialized.size, ContainerEq(headers[0].size));
+  ASSERT_THAT(deserialized.compressedSize, ContainerEq(headers[0].compressedSize));
+  ASSERT_EQ(deserialized.compressedSize[0], compressedSize[0]);
+
+  // Headers without compressed frames carry no codec
+  const ucxx::Header deserializedUncompressed(uncompressed[0].serialize());
+  ASSERT_EQ(deserializedUncompressed.compression, 0);
+  ASSERT_EQ(deserializedUncompressed.compressedSize[0], size_t{0});
+
+  EXPECT_THROW(ucxx::Header::buildHeaders(size, isCUDA, {1, 2}, codec), std::length_error);
+}
+
+TEST(HeaderTest, CompressedFitsDataSize)
+{
+  // Frames and compressed sizes as large as possible yield headers with fewer frames
+  std::vector<int> isCUDA(ucxx::HeaderFramesSize, 0);
+  std::vector<size_t> size(ucxx::HeaderFramesSize, SIZE_MAX);
+  std::vector<size_t> compressedSize(ucxx::HeaderFramesSize, SIZE_MAX - 1);
+
+  auto headers = ucxx::Header::buildHeaders(size, isCUDA, compressedSize, 1);
+  ASSERT_GT(headers.size(), size_t{1});
+
+  size_t nframes = 0;
+  for (size_t i = 0; i < headers.size(); ++i) {
+    ASSERT_LE(headers[i].serializedSize(), ucxx::Header::dataSize());
+    ASSERT_EQ(headers[i].next, i < headers.size() - 1);
+    nframes += headers[i].nframes;
+  }
+  ASSERT_EQ(nframes, ucxx::HeaderFramesSize);
+}
+
 class FromPointerGenerator : public ::testing::Test, public ::testing::WithParamInterface<size_t> {
  private:
   void generateData()
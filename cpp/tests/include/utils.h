@@ -18,6 +18,7 @@ enum class ProgressMode {
   Wait,
   ThreadPolling,
   ThreadBlocking,
+  ThreadHybrid,
 };
 
 void createCudaContextCallback(void* callbackArg);
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -175,6 +176,11 @@ TEST_F(ListenerTest, RaiseOnError)
   });
 
   EXPECT_THROW(ep->raiseOnError(), ucxx::Error);
+
+  // The non-throwing variant reports the same error
+  std::string message;
+  EXPECT_NE(ep->getError(&message), UCS_OK);
+  EXPECT_NE(message.find("error"), std::string::npos);
 }
 
 TEST_F(ListenerTest, CloseCallback)
@@ -204,4 +210,46 @@ TEST_F(ListenerTest, CloseCallback)
   ASSERT_TRUE(isClosed);
 }
 
+TEST_F(ListenerTest, AcceptEndpointsBacklog)
+{
+  const size_t backlog = 2;
+  auto listener        = _worker->createListener(0, backlog);
+  _worker->progress();
+
+  ASSERT_THROW(_worker->createListener(0, 0), std::invalid_argument);
+  ASSERT_TRUE(listener->acceptEndpoints().empty());
+
+  std::vector<std::shared_ptr<ucxx::Endpoint>> eps;
+  for (size_t i = 0; i < 2 * backlog; ++i)
+    eps.push_back(_worker->createEndpointFromHostname("127.0.0.1", listener->getPort()));
+
+  loopWithTimeout(std::chrono::milliseconds(5000), [this, &listener, &eps]() {
+    _worker->progress();
+    return listener->getStatistics().connectionRequestsReceived == eps.size();
+  });
+
+  // Connection requests beyond the backlog are rejected
+  auto statistics = listener->getStatistics();
+  ASSERT_EQ(statistics.connectionRequestsReceived, eps.size());
+  ASSERT_EQ(statistics.connectionRequestsRejected, eps.size() - backlog);
+  ASSERT_EQ(statistics.queueDepth, backlog);
+  ASSERT_EQ(statistics.maxQueueDepth, backlog);
+  ASSERT_EQ(listener->getPendingConnectionRequests(), backlog);
+
+  auto serverEps = listener->acceptEndpoints(1);
+  ASSERT_EQ(serverEps.size(), 1);
+  auto remainingEps = listener->acceptEndpoints();
+  ASSERT_EQ(remainingEps.size(), backlog - 1);
+  serverEps.insert(serverEps.end(), remainingEps.begin(), remainingEps.end());
+
+  statistics = listener->getStatistics();
+  ASSERT_EQ(statistics.connectionRequestsAccepted, backlog);
+  ASSERT_EQ(statistics.queueDepth, 0);
+
+  for (const auto& serverEp : serverEps) {
+    ASSERT_NE(serverEp->getHandle(), nullptr);
+    ASSERT_EQ(serverEp->getParent(), listener);
+  }
+}
+
 }  // namespace
@@ -0,0 +1,127 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ucxx/utils/memory_pool.h>
+
+namespace {
+
+class PooledObject {
+ private:
+  PooledObject(int value, bool& destroyed) : _value(value), _destroyed(destroyed) {}
+
+ public:
+  int _value;
+  bool& _destroyed;
+
+  ~PooledObject() { _destroyed = true; }
+
+  static std::shared_ptr<PooledObject> create(std::shared_ptr<ucxx::utils::MemoryPool> pool,
+                                              int value,
+                                              bool& destroyed)
+  {
+    return ucxx::utils::makePooledShared<PooledObject>(pool, [&](void* storage) {
+      return new (storage) PooledObject(value, destroyed);
+    });
+  }
+};
+
+TEST(MemoryPoolTest, ReuseBlocks)
+{
+  ucxx::utils::MemoryPool pool;
+
+  void* block = pool.allocate(100);
+  ASSERT_NE(block, nullptr);
+  pool.deallocate(block, 100);
+  ASSERT_EQ(pool.getCachedBlocks(), 1u);
+
+  // Sizes in the same size class reuse the cached block.
+  ASSERT_EQ(pool.allocate(128), block);
+  ASSERT_EQ(pool.getCachedBlocks(), 0u);
+  pool.deallocate(block, 128);
+
+  // Allocations larger than the largest size class are not cached.
+  void* large = pool.allocate(ucxx::utils::MemoryPool::MaxBlockSize + 1);
+  pool.deallocate(large, ucxx::utils::MemoryPool::MaxBlockSize + 1);
+  ASSERT_EQ(pool.getCachedBlocks(), 1u);
+}
+
+TEST(MemoryPoolTest, MaxCachedBlocks)
+{
+  ucxx::utils::MemoryPool pool{2};
+
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < 4; ++i)
+    blocks.push_back(pool.allocate(64));
+  for (auto& block : blocks)
+    pool.deallocate(block, 64);
+
+  ASSERT_EQ(pool.getCachedBlocks(), 2u);
+}
+
+TEST(MemoryPoolTest, PooledShared)
+{
+  auto pool      = std::make_shared<ucxx::utils::MemoryPool>();
+  bool destroyed = false;
+
+  auto obj = PooledObject::create(pool, 42, destroyed);
+  ASSERT_EQ(obj->_value, 42);
+  ASSERT_EQ(pool.use_count(), 3);  // Held by the deleter and control block allocator
+
+  obj = nullptr;
+  ASSERT_TRUE(destroyed);
+  ASSERT_EQ(pool.use_count(), 1);
+  ASSERT_EQ(pool->getCachedBlocks(), 2u);  // Object and control block
+
+  // Subsequent objects are created from cached blocks.
+  destroyed = false;
+  obj       = PooledObject::create(pool, 1, destroyed);
+  ASSERT_EQ(pool->getCachedBlocks(), 0u);
+}
+
+TEST(MemoryPoolTest, PooledSharedWithoutPool)
+{
+  bool destroyed = false;
+
+  auto obj = PooledObject::create(nullptr, 42, destroyed);
+  ASSERT_EQ(obj->_value, 42);
+
+  obj = nullptr;
+  ASSERT_TRUE(destroyed);
+}
+
+TEST(MemoryPoolTest, ConstructorThrows)
+{
+  auto pool = std::make_shared<ucxx::utils::MemoryPool>();
+
+  EXPECT_THROW(ucxx::utils::makePooledShared<PooledObject>(
+                 pool, [](void*) -> PooledObject* { throw std::runtime_error("error"); }),
+               std::runtime_error);
+  ASSERT_EQ(pool->getCachedBlocks(), 1u);
+}
+
+TEST(MemoryPoolTest, MultipleThreads)
+{
+  auto pool = std::make_shared<ucxx::utils::MemoryPool>();
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t)
+    threads.emplace_back([&pool]() {
+      for (size_t i = 0; i < 10000; ++i)
+        pool->deallocate(pool->allocate(64 * (i % 8 + 1)), 64 * (i % 8 + 1));
+    });
+  for (auto& t : threads)
+    t.join();
+
+  ASSERT_LE(pool->getCachedBlocks(), 4u * 8u);
+}
+
+}  // namespace
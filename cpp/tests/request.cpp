@@ -3,11 +3,20 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <numeric>
+#include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -189,6 +198,283 @@ TEST_P(RequestTest, ProgressAm)
 #endif
 }
 
+TEST_P(RequestTest, ProgressAmSendHints)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Interrupting UCP worker progress operation in wait mode is not possible";
+  }
+
+#if !UCXX_ENABLE_RMM
+  GTEST_SKIP() << "UCXX was not built with RMM support";
+#else
+  if (_registerCustomAmAllocator && _memoryType == UCS_MEMORY_TYPE_CUDA) {
+    _worker->registerAmAllocator(UCS_MEMORY_TYPE_CUDA, [](size_t length) {
+      return std::make_shared<ucxx::RMMBuffer>(length);
+    });
+  }
+
+  // Send all non-empty messages with rendezvous, regardless of the context thresholds
+  ucxx::SendHints sendHints{};
+  sendHints.amRendezvousThreshold = 1;
+  sendHints.fastCompletion        = true;
+  sendHints.multiSend             = true;
+  _ep->setSendHints(sendHints);
+  ASSERT_EQ(_ep->getSendHints().amRendezvousThreshold, 1u);
+
+  allocate(1, false);
+
+  // Submit and wait for transfers to complete
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->amSend(_sendPtr[0], _messageSize, _memoryType));
+  requests.push_back(_ep->amRecv());
+  waitRequests(_worker, requests, _progressWorker);
+
+  auto recvReq = requests[1];
+  _recvPtr[0]  = recvReq->getRecvBuffer()->data();
+
+  // Rendezvous messages use the custom allocator
+  ASSERT_THAT(recvReq->getRecvBuffer()->getType(),
+              (_registerCustomAmAllocator && _messageSize > 0) ? _bufferType
+                                                               : ucxx::BufferType::Host);
+
+  copyResults();
+
+  // Assert data correctness
+  ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
+#endif
+}
+
+TEST_P(RequestTest, ProgressAmHeader)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Interrupting UCP worker progress operation in wait mode is not possible";
+  }
+
+#if !UCXX_ENABLE_RMM
+  GTEST_SKIP() << "UCXX was not built with RMM support";
+#else
+  allocate(1, false);
+
+  const std::string header = "ucxx-am-header";
+
+  // Submit and wait for transfers to complete
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(
+    _ep->amSend(_sendPtr[0], _messageSize, _memoryType, false, nullptr, nullptr, header));
+  requests.push_back(_ep->amRecv());
+  waitRequests(_worker, requests, _progressWorker);
+
+  auto recvReq = requests[1];
+  _recvPtr[0]  = recvReq->getRecvBuffer()->data();
+
+  copyResults();
+
+  // Assert data and header correctness
+  ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
+  ASSERT_EQ(recvReq->getRecvHeader(), header);
+#endif
+}
+
+TEST_P(RequestTest, ProgressAmZeroCopyEager)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Interrupting UCP worker progress operation in wait mode is not possible";
+  }
+
+#if !UCXX_ENABLE_RMM
+  GTEST_SKIP() << "UCXX was not built with RMM support";
+#else
+  _worker->setAmZeroCopyEager(true);
+
+  allocate(1, false);
+
+  // Submit and wait for transfers to complete
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->amSend(_sendPtr[0], _messageSize, _memoryType));
+  requests.push_back(_ep->amRecv());
+  waitRequests(_worker, requests, _progressWorker);
+
+  auto recvReq = requests[1];
+  _recvPtr[0]  = recvReq->getRecvBuffer()->data();
+
+  // Eager messages are either held by UCX or copied to a host buffer, depending on
+  // whether UCX is able to keep the data persistent.
+  if (_messageSize < _rndvThresh)
+    ASSERT_THAT(recvReq->getRecvBuffer()->getType(),
+                ::testing::AnyOf(ucxx::BufferType::AmData, ucxx::BufferType::Host));
+
+  copyResults();
+
+  // Assert data correctness
+  ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
+#endif
+}
+
+TEST_P(RequestTest, ProgressAmReceiverCallback)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Interrupting UCP worker progress operation in wait mode is not possible";
+  }
+
+#if !UCXX_ENABLE_RMM
+  GTEST_SKIP() << "UCXX was not built with RMM support";
+#else
+  allocate(1, false);
+
+  const unsigned int amId = 1;
+  std::mutex mutex;
+  std::shared_ptr<ucxx::Request> recvReq{nullptr};
+  _worker->registerAmHandler(amId, [&mutex, &recvReq](std::shared_ptr<ucxx::Request> request) {
+    std::lock_guard<std::mutex> lock(mutex);
+    recvReq = request;
+  });
+
+  // Messages are delivered to the callback, receiving explicitly is not allowed
+  EXPECT_THROW(_ep->amRecv(false, nullptr, nullptr, amId), std::runtime_error);
+
+  // Submit and wait for transfers to complete
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(
+    _ep->amSend(_sendPtr[0], _messageSize, _memoryType, false, nullptr, nullptr, {}, amId));
+  waitRequests(_worker, requests, _progressWorker);
+  loopWithTimeout(std::chrono::milliseconds(5000), [this, &mutex, &recvReq]() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (recvReq != nullptr) return true;
+    }
+    if (_progressWorker) _progressWorker();
+    return false;
+  });
+
+  ASSERT_NE(recvReq, nullptr);
+  recvReq->checkError();
+  _recvPtr[0] = recvReq->getRecvBuffer()->data();
+
+  copyResults();
+
+  // Assert data correctness and that the default ID did not receive the message
+  ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
+  ASSERT_FALSE(_worker->amProbe(_ep->getHandle()));
+#endif
+}
+
+TEST_P(RequestTest, ProgressMemGet)
+{
+  if (_messageLength == 0) GTEST_SKIP() << "Zero-sized memory cannot be registered";
+
+  allocate();
+
+  // Register and pack the memory to be accessed remotely
+  auto memoryHandle = _context->createMemoryHandle(_messageSize, _sendPtr[0], _memoryType);
+  auto serializedRemoteKey = memoryHandle->createRemoteKey()->serialize();
+
+  // Unpack the remote key and get the remote memory
+  EXPECT_THROW(_ep->createRemoteKeyFromSerialized("invalid"), std::runtime_error);
+  auto remoteKey = _ep->createRemoteKeyFromSerialized(serializedRemoteKey);
+  ASSERT_EQ(remoteKey->getBaseAddress(), reinterpret_cast<uint64_t>(_sendPtr[0]));
+  ASSERT_EQ(remoteKey->getSize(), _messageSize);
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(
+    _ep->memGet(_recvPtr[0], _messageSize, remoteKey->getBaseAddress(), remoteKey));
+  waitRequests(_worker, requests, _progressWorker);
+
+  copyResults();
+
+  // Assert data correctness
+  ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
+}
+
+TEST_P(RequestTest, ProgressMemPut)
+{
+  if (_messageLength == 0) GTEST_SKIP() << "Zero-sized memory cannot be registered";
+
+  allocate(2);
+
+  // Register and pack the memory to be accessed remotely
+  auto memoryHandle = _context->createMemoryHandle(_messageSize, _recvPtr[0], _memoryType);
+  auto remoteKey = _ep->createRemoteKeyFromSerialized(memoryHandle->createRemoteKey()->serialize());
+
+  // Accessing memory outside of the remote key is rejected
+  EXPECT_THROW(
+    _ep->memPut(_sendPtr[0], _messageSize, remoteKey->getBaseAddress() + 1, remoteKey),
+    std::runtime_error);
+
+  // Put the data and then get it back, the fence ensures the put completes remotely first
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(
+    _ep->memPut(_sendPtr[0], _messageSize, remoteKey->getBaseAddress(), remoteKey));
+  waitRequests(_worker, requests, _progressWorker);
+  _worker->fence();
+
+  requests.clear();
+  requests.push_back(
+    _ep->memGet(_recvPtr[1], _messageSize, remoteKey->getBaseAddress(), remoteKey));
+  waitRequests(_worker, requests, _progressWorker);
+
+  copyResults();
+
+  // Assert data correctness
+  ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
+  ASSERT_THAT(_recv[1], ContainerEq(_send[0]));
+}
+
+TEST_P(RequestTest, ProgressMemAtomic)
+{
+  uint64_t counter = 10;
+
+  auto memoryHandle =
+    _context->createMemoryHandle(sizeof(counter), &counter, UCS_MEMORY_TYPE_HOST);
+  auto remoteKey = _ep->createRemoteKeyFromSerialized(memoryHandle->createRemoteKey()->serialize());
+  auto remoteAddr = remoteKey->getBaseAddress();
+
+  // Add without fetching, the flush ensures it is completed remotely
+  auto add = _ep->memAtomic(UCP_ATOMIC_OP_ADD, 5, remoteAddr, remoteKey);
+  waitRequests<ucxx::Request>(_worker, {add}, _progressWorker);
+  waitRequests<ucxx::Request>(_worker, {_ep->flush()}, _progressWorker);
+  EXPECT_THROW(add->getAtomicResult(), std::runtime_error);
+  ASSERT_EQ(counter, 15u);
+
+  // Fetch-and-add
+  auto fetchAdd = _ep->memAtomic(UCP_ATOMIC_OP_ADD, 1, remoteAddr, remoteKey, true);
+  waitRequests<ucxx::Request>(_worker, {fetchAdd}, _progressWorker);
+  ASSERT_EQ(fetchAdd->getAtomicResult(), 15u);
+
+  // Compare-and-swap with a mismatching compare value does not swap
+  auto cswapMismatch = _ep->memAtomic(UCP_ATOMIC_OP_CSWAP, 100, remoteAddr, remoteKey, true, 0);
+  waitRequests<ucxx::Request>(_worker, {cswapMismatch}, _progressWorker);
+  ASSERT_EQ(cswapMismatch->getAtomicResult(), 16u);
+
+  auto cswap = _ep->memAtomic(UCP_ATOMIC_OP_CSWAP, 100, remoteAddr, remoteKey, true, 16);
+  waitRequests<ucxx::Request>(_worker, {cswap}, _progressWorker);
+  ASSERT_EQ(cswap->getAtomicResult(), 16u);
+
+  waitRequests<ucxx::Request>(_worker, {_ep->flush()}, _progressWorker);
+  ASSERT_EQ(counter, 100u);
+}
+
+TEST_P(RequestTest, ProgressWorkerFlush)
+{
+  if (_messageLength == 0) GTEST_SKIP() << "Zero-sized memory cannot be registered";
+
+  allocate();
+
+  auto memoryHandle = _context->createMemoryHandle(_messageSize, _recvPtr[0], _memoryType);
+  auto remoteKey = _ep->createRemoteKeyFromSerialized(memoryHandle->createRemoteKey()->serialize());
+
+  // The flush completes once the put is visible in the remote memory
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(
+    _ep->memPut(_sendPtr[0], _messageSize, remoteKey->getBaseAddress(), remoteKey));
+  requests.push_back(_worker->flush());
+  waitRequests(_worker, requests, _progressWorker);
+
+  copyResults();
+
+  // Assert data correctness
+  ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
+}
+
 TEST_P(RequestTest, ProgressStream)
 {
   allocate();
@@ -210,6 +496,31 @@ TEST_P(RequestTest, ProgressStream)
   }
 }
 
+TEST_P(RequestTest, ProgressStreamIov)
+{
+  if (_bufferType != ucxx::BufferType::Host) GTEST_SKIP() << "IOV is tested with host memory";
+
+  allocate(3);
+  std::vector<size_t> length(_numBuffers, _messageSize);
+
+  // Submit and wait for transfers to complete
+  if (_messageSize == 0) {
+    EXPECT_THROW(_ep->streamSendIov(_sendPtr, length), std::runtime_error);
+  } else {
+    std::vector<std::shared_ptr<ucxx::Request>> requests;
+    requests.push_back(_ep->streamSendIov(_sendPtr, length));
+    for (size_t i = 0; i < _numBuffers; ++i)
+      requests.push_back(_ep->streamRecv(_recvPtr[i], _messageSize, 0));
+    waitRequests(_worker, requests, _progressWorker);
+
+    copyResults();
+
+    // Assert data correctness
+    for (size_t i = 0; i < _numBuffers; ++i)
+      ASSERT_THAT(_recv[i], ContainerEq(_send[i]));
+  }
+}
+
 TEST_P(RequestTest, ProgressTag)
 {
   allocate();
@@ -226,6 +537,222 @@ TEST_P(RequestTest, ProgressTag)
   ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
 }
 
+TEST_P(RequestTest, ProgressTagDeadline)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Waiting for a deadline is not possible while blocking on worker events";
+  }
+
+  allocate();
+
+  // A receive that never matches expires with its deadline
+  auto expiring = _ep->tagRecv(_recvPtr[0], _messageSize, ucxx::Tag{1}, ucxx::TagMaskFull);
+  expiring->setTimeout(10000000 /* 10ms */);
+  ASSERT_TRUE(loopWithTimeout(std::chrono::seconds(10), [this, &expiring]() {
+    if (_progressWorker) _progressWorker();
+    return expiring->isCompleted();
+  }));
+  ASSERT_EQ(expiring->getStatus(), UCS_ERR_TIMED_OUT);
+  EXPECT_THROW(expiring->checkError(), ucxx::TimedOutError);
+  std::string message;
+  ASSERT_EQ(expiring->getError(&message), UCS_ERR_TIMED_OUT);
+  ASSERT_EQ(message, ucs_status_string(UCS_ERR_TIMED_OUT));
+  ASSERT_EQ(_worker->getStatistics().requestsTimedOut, 1u);
+
+  // Requests completing before their deadline are unaffected
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->tagSend(_sendPtr[0], _messageSize, ucxx::Tag{0}));
+  requests.push_back(_ep->tagRecv(_recvPtr[0], _messageSize, ucxx::Tag{0}, ucxx::TagMaskFull));
+  for (auto& request : requests)
+    request->setTimeout(60000000000 /* 60s */);
+  waitRequests(_worker, requests, _progressWorker);
+
+  copyResults();
+
+  ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
+  ASSERT_EQ(_worker->getStatistics().requestsTimedOut, 1u);
+}
+
+TEST_P(RequestTest, ProgressTagCompletionFlag)
+{
+  allocate();
+
+  // Flags set before and after completion are written once the request completes
+  std::vector<uint32_t> flags(4, 0);
+  auto recv = _ep->tagRecv(_recvPtr[0], _messageSize, ucxx::Tag{0}, ucxx::TagMaskFull);
+  recv->setCompletionFlag(&flags[0], 7);
+  auto send = _ep->tagSend(_sendPtr[0], _messageSize, ucxx::Tag{0});
+  waitRequests(_worker, std::vector<std::shared_ptr<ucxx::Request>>{send, recv}, _progressWorker);
+  send->setCompletionFlag(&flags[1]);
+
+  copyResults();
+
+  ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
+  ASSERT_EQ(flags[0], 7u);
+  ASSERT_EQ(flags[1], 1u);
+  EXPECT_THROW(send->setCompletionFlag(&flags[1]), std::runtime_error);
+  EXPECT_THROW(send->setCompletionFlag(nullptr), std::invalid_argument);
+
+  // Cancelation does not generate worker events to wake up from
+  if (_progressMode == ProgressMode::Wait) return;
+
+  // Errors set the error bit, user-defined writers receive the same word
+  auto canceled = _ep->tagRecv(_recvPtr[0], _messageSize, ucxx::Tag{1}, ucxx::TagMaskFull);
+  canceled->setCompletionFlag([&flags](uint32_t word) { flags[2] = word; }, 3);
+  EXPECT_THROW(canceled->setCompletionFlag(&flags[3], ucxx::CompletionFlagError),
+               std::invalid_argument);
+  canceled->cancel();
+  ASSERT_TRUE(loopWithTimeout(std::chrono::seconds(10), [this, &canceled]() {
+    if (_progressWorker) _progressWorker();
+    return canceled->isCompleted();
+  }));
+  ASSERT_EQ(flags[2], 3u | ucxx::CompletionFlagError);
+  ASSERT_EQ(flags[3], 0u);
+}
+
+TEST_P(RequestTest, ProgressTagReadiness)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Readiness of sends is not signaled while blocking on worker events";
+  }
+
+  allocate(2);
+
+  // The send is not submitted while its data is not ready
+  std::atomic<bool> ready{false};
+  auto readiness = [&ready]() { return ready.load() ? UCS_OK : UCS_INPROGRESS; };
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->tagSend(
+    _sendPtr[0], _messageSize, ucxx::Tag{0}, false, nullptr, nullptr, nullptr, readiness));
+  requests.push_back(_ep->tagRecv(_recvPtr[0], _messageSize, ucxx::Tag{0}, ucxx::TagMaskFull));
+  // Later sends on the same endpoint are submitted after it, matching the second receive
+  requests.push_back(_ep->tagSend(_sendPtr[1], _messageSize, ucxx::Tag{0}));
+  requests.push_back(_ep->tagRecv(_recvPtr[1], _messageSize, ucxx::Tag{0}, ucxx::TagMaskFull));
+  ASSERT_FALSE(loopWithTimeout(std::chrono::milliseconds(100), [this, &requests]() {
+    if (_progressWorker) _progressWorker();
+    return std::any_of(
+      requests.begin(), requests.end(), [](auto& request) { return request->isCompleted(); });
+  }));
+
+  ready = true;
+  waitRequests(_worker, requests, _progressWorker);
+
+  copyResults();
+
+  for (size_t i = 0; i < _numBuffers; ++i)
+    ASSERT_THAT(_recv[i], ContainerEq(_send[i]));
+
+  // A readiness error completes the send with it, without submitting it
+  auto failed = _ep->tagSend(_sendPtr[0],
+                             _messageSize,
+                             ucxx::Tag{1},
+                             false,
+                             nullptr,
+                             nullptr,
+                             nullptr,
+                             []() { return UCS_ERR_IO_ERROR; });
+  ASSERT_TRUE(loopWithTimeout(std::chrono::seconds(10), [this, &failed]() {
+    if (_progressWorker) _progressWorker();
+    return failed->isCompleted();
+  }));
+  ASSERT_EQ(failed->getStatus(), UCS_ERR_IO_ERROR);
+
+  // A send that is never ready may still be canceled
+  auto canceled = _ep->tagSend(_sendPtr[0],
+                               _messageSize,
+                               ucxx::Tag{1},
+                               false,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               []() { return UCS_INPROGRESS; });
+  canceled->cancel();
+  ASSERT_TRUE(loopWithTimeout(std::chrono::seconds(10), [this, &canceled]() {
+    if (_progressWorker) _progressWorker();
+    return canceled->isCompleted();
+  }));
+  ASSERT_EQ(canceled->getStatus(), UCS_ERR_CANCELED);
+}
+
+TEST_P(RequestTest, ProgressTagIov)
+{
+  if (_bufferType != ucxx::BufferType::Host) GTEST_SKIP() << "IOV is tested with host memory";
+
+  allocate(3);
+  std::vector<size_t> length(_numBuffers, _messageSize);
+
+  EXPECT_THROW(_ep->tagSendIov(_sendPtr, {_messageSize}, ucxx::Tag{0}), std::runtime_error);
+
+  // Submit and wait for transfers to complete
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->tagSendIov(_sendPtr, length, ucxx::Tag{0}));
+  requests.push_back(_ep->tagRecvIov(_recvPtr, length, ucxx::Tag{0}));
+  waitRequests(_worker, requests, _progressWorker);
+
+  copyResults();
+
+  // Assert data correctness
+  for (size_t i = 0; i < _numBuffers; ++i)
+    ASSERT_THAT(_recv[i], ContainerEq(_send[i]));
+}
+
+TEST_P(RequestTest, ProgressTagIovToContiguous)
+{
+  if (_bufferType != ucxx::BufferType::Host) GTEST_SKIP() << "IOV is tested with host memory";
+
+  allocate(2);
+  std::vector<size_t> length(_numBuffers, _messageSize);
+  std::vector<int> recv(_numBuffers * _messageLength);
+
+  // A vectored send is a single message on the wire, matched by a single contiguous receive
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->tagSendIov(_sendPtr, length, ucxx::Tag{0}));
+  requests.push_back(
+    _ep->tagRecv(recv.data(), _numBuffers * _messageSize, ucxx::Tag{0}, ucxx::TagMaskFull));
+  waitRequests(_worker, requests, _progressWorker);
+
+  // Assert data correctness
+  std::vector<int> expected(_send[0]);
+  expected.insert(expected.end(), _send[1].begin(), _send[1].end());
+  ASSERT_THAT(recv, ContainerEq(expected));
+}
+
+TEST_P(RequestTest, ProgressTagMemoryHandle)
+{
+  if (_messageLength == 0) GTEST_SKIP() << "Zero-sized memory cannot be registered";
+
+  allocate();
+
+  auto sendMemoryHandle = _context->createMemoryHandle(_messageSize, _sendPtr[0], _memoryType);
+  auto recvMemoryHandle = _context->createMemoryHandle(_messageSize, _recvPtr[0], _memoryType);
+
+  // Buffers outside of the registered memory are rejected
+  auto outsidePtr =
+    reinterpret_cast<char*>(sendMemoryHandle->getBaseAddress()) + sendMemoryHandle->getSize();
+  EXPECT_THROW(
+    _ep->tagSend(outsidePtr, _messageSize, ucxx::Tag{0}, false, nullptr, nullptr, sendMemoryHandle),
+    std::runtime_error);
+
+  // Submit and wait for transfers to complete
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->tagSend(
+    _sendPtr[0], _messageSize, ucxx::Tag{0}, false, nullptr, nullptr, sendMemoryHandle));
+  requests.push_back(_ep->tagRecv(_recvPtr[0],
+                                  _messageSize,
+                                  ucxx::Tag{0},
+                                  ucxx::TagMaskFull,
+                                  false,
+                                  nullptr,
+                                  nullptr,
+                                  recvMemoryHandle));
+  waitRequests(_worker, requests, _progressWorker);
+
+  copyResults();
+
+  // Assert data correctness
+  ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
+}
+
 TEST_P(RequestTest, ProgressTagMulti)
 {
   if (_progressMode == ProgressMode::Wait) {
@@ -273,6 +800,420 @@ TEST_P(RequestTest, ProgressTagMulti)
     ASSERT_THAT(_recv[i], ContainerEq(_send[i]));
 }
 
+TEST_P(RequestTest, ProgressTagMultiPrepost)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Interrupting UCP worker progress operation in wait mode is not possible";
+  }
+
+  const size_t numMulti         = 8;
+  const size_t numMessages      = 3;
+  const bool allocateRecvBuffer = false;
+
+  allocate(numMulti, allocateRecvBuffer);
+
+  std::vector<size_t> multiSize(numMulti, _messageSize);
+  std::vector<int> multiIsCUDA(numMulti, _bufferType == ucxx::BufferType::RMM);
+
+  _ep->setTagMultiPrepost(true);
+  ASSERT_TRUE(_ep->isTagMultiPrepostEnabled());
+
+  // Each receive but the first adopts the header receive preposted by the previous one
+  for (size_t message = 0; message < numMessages; ++message) {
+    std::vector<std::shared_ptr<ucxx::Request>> requests;
+    requests.push_back(_ep->tagMultiSend(_sendPtr, multiSize, multiIsCUDA, ucxx::Tag{0}, false));
+    requests.push_back(_ep->tagMultiRecv(ucxx::Tag{0}, ucxx::TagMaskFull, false));
+    waitRequests(_worker, requests, _progressWorker);
+
+    _recvPtr.resize(_numBuffers);
+    size_t transferIdx = 0;
+
+    for (const auto& br :
+         std::dynamic_pointer_cast<ucxx::RequestTagMulti>(requests[1])->_bufferRequests) {
+      // br->buffer == nullptr are headers
+      if (br->buffer) {
+        ASSERT_EQ(br->buffer->getSize(), _messageSize);
+        _recvPtr[transferIdx] = br->buffer->data();
+        ++transferIdx;
+      }
+    }
+    ASSERT_EQ(transferIdx, numMulti);
+
+    copyResults();
+
+    for (size_t i = 0; i < numMulti; ++i)
+      ASSERT_THAT(_recv[i], ContainerEq(_send[i]));
+  }
+
+  _ep->setTagMultiPrepost(false);
+  ASSERT_FALSE(_ep->isTagMultiPrepostEnabled());
+
+  // The header receive preposted before disabling is still adopted
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->tagMultiSend(_sendPtr, multiSize, multiIsCUDA, ucxx::Tag{0}, false));
+  requests.push_back(_ep->tagMultiRecv(ucxx::Tag{0}, ucxx::TagMaskFull, false));
+  waitRequests(_worker, requests, _progressWorker);
+  ASSERT_EQ(requests[1]->getStatus(), UCS_OK);
+}
+
+TEST_P(RequestTest, ProgressTagMultiCompressed)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Interrupting UCP worker progress operation in wait mode is not possible";
+  }
+  if (_bufferType != ucxx::BufferType::Host) {
+    GTEST_SKIP() << "Only host frames are compressed";
+  }
+
+  ucxx::CompressionConfig config{};
+  for (const auto codec : {ucxx::CompressionCodec::LZ4, ucxx::CompressionCodec::Zstd})
+    if (ucxx::utils::isCompressionCodecAvailable(codec)) config.codec = codec;
+  if (config.codec == ucxx::CompressionCodec::None) {
+    GTEST_SKIP() << "UCXX was built without compression codecs";
+  }
+  // Compress all frames on any transport of the loopback endpoint
+  config.minFrameSize = 0;
+  config.transports   = {};
+  _worker->setCompression(config, 2);
+
+  const size_t numMulti         = 8;
+  const bool allocateRecvBuffer = false;
+
+  allocate(numMulti, allocateRecvBuffer);
+
+  std::vector<size_t> multiSize(numMulti, _messageSize);
+  std::vector<int> multiIsCUDA(numMulti, 0);
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->tagMultiSend(_sendPtr, multiSize, multiIsCUDA, ucxx::Tag{0}, false));
+  requests.push_back(_ep->tagMultiRecv(ucxx::Tag{0}, ucxx::TagMaskFull, false));
+  waitRequests(_worker, requests, _progressWorker);
+
+  _recvPtr.resize(_numBuffers);
+  size_t transferIdx = 0;
+  for (const auto& br :
+       std::dynamic_pointer_cast<ucxx::RequestTagMulti>(requests[1])->_bufferRequests) {
+    if (br->buffer) {
+      ASSERT_EQ(br->buffer->getSize(), _messageSize);
+      _recvPtr[transferIdx++] = br->buffer->data();
+    }
+  }
+  ASSERT_EQ(transferIdx, numMulti);
+
+  copyResults();
+
+  for (size_t i = 0; i < numMulti; ++i)
+    ASSERT_THAT(_recv[i], ContainerEq(_send[i]));
+
+  // Frames that don't shrink are sent verbatim and not decompressed
+  auto statistics = _worker->getStatistics();
+  ASSERT_EQ(statistics.framesCompressed + statistics.framesNotCompressed, numMulti);
+  ASSERT_EQ(statistics.framesDecompressed, statistics.framesCompressed);
+  if (statistics.framesCompressed > 0) {
+    ASSERT_LT(statistics.compressionOutputBytes, statistics.compressionInputBytes);
+  }
+
+  _worker->setCompression(ucxx::CompressionConfig{});
+  ASSERT_EQ(_worker->getCompressionConfig().codec, ucxx::CompressionCodec::None);
+}
+
+TEST_P(RequestTest, ProgressTagMultiUnavailableCodec)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Interrupting UCP worker progress operation in wait mode is not possible";
+  }
+  if (_bufferType != ucxx::BufferType::Host) {
+    GTEST_SKIP() << "Only host frames are compressed";
+  }
+  if (_messageSize == 0) GTEST_SKIP() << "Empty frames are never compressed";
+
+  const size_t numMulti = 4;
+
+  allocate(numMulti, false);
+
+  // Send the header and frames of a transfer compressed with a codec no build provides
+  std::vector<size_t> multiSize(numMulti, _messageSize);
+  std::vector<int> multiIsCUDA(numMulti, 0);
+  auto header = std::make_shared<std::string>(
+    ucxx::Header::buildHeaders(multiSize, multiIsCUDA, multiSize, 0xff)[0].serialize());
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->tagSend(&header->front(), header->size(), ucxx::Tag{0}, false));
+  for (size_t i = 0; i < numMulti; ++i)
+    requests.push_back(_ep->tagSend(_sendPtr[i], _messageSize, ucxx::Tag{0}, false));
+  auto recvRequest = _ep->tagMultiRecv(ucxx::Tag{0}, ucxx::TagMaskFull, false);
+  requests.push_back(recvRequest);
+  ASSERT_TRUE(loopWithTimeout(std::chrono::seconds(10), [this, &requests]() {
+    if (_progressWorker) _progressWorker();
+    return std::all_of(
+      requests.begin(), requests.end(), [](const auto& r) { return r->isCompleted(); });
+  }));
+  ASSERT_EQ(recvRequest->getStatus(), UCS_ERR_UNSUPPORTED);
+
+  // The frames were discarded, a subsequent transfer with the same tag is not affected
+  requests.clear();
+  requests.push_back(_ep->tagMultiSend(_sendPtr, multiSize, multiIsCUDA, ucxx::Tag{0}, false));
+  requests.push_back(_ep->tagMultiRecv(ucxx::Tag{0}, ucxx::TagMaskFull, false));
+  waitRequests(_worker, requests, _progressWorker);
+
+  _recvPtr.resize(_numBuffers);
+  size_t transferIdx = 0;
+  for (const auto& br :
+       std::dynamic_pointer_cast<ucxx::RequestTagMulti>(requests[1])->_bufferRequests) {
+    if (br->buffer) _recvPtr[transferIdx++] = br->buffer->data();
+  }
+  ASSERT_EQ(transferIdx, numMulti);
+
+  copyResults();
+
+  for (size_t i = 0; i < numMulti; ++i)
+    ASSERT_THAT(_recv[i], ContainerEq(_send[i]));
+}
+
+TEST_P(RequestTest, ProgressTagMultiPacked)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Interrupting UCP worker progress operation in wait mode is not possible";
+  }
+
+  const size_t numMulti         = 8;
+  const bool allocateRecvBuffer = false;
+
+  allocate(numMulti, allocateRecvBuffer);
+
+  // Allocate buffers for request sizes/types, host frames are all packed into one message
+  std::vector<size_t> multiSize(numMulti, _messageSize);
+  std::vector<int> multiIsCUDA(numMulti, _bufferType == ucxx::BufferType::RMM);
+  const size_t packThreshold = std::max(_messageSize, size_t{1});
+
+  // Submit and wait for transfers to complete
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(
+    _ep->tagMultiSend(_sendPtr, multiSize, multiIsCUDA, ucxx::Tag{0}, false, packThreshold));
+  requests.push_back(_ep->tagMultiRecv(ucxx::Tag{0}, ucxx::TagMaskFull, false));
+  waitRequests(_worker, requests, _progressWorker);
+
+  // One header plus either one packed message or one message per frame
+  auto sendRequest = std::dynamic_pointer_cast<ucxx::RequestTagMulti>(requests[0]);
+  ASSERT_EQ(sendRequest->_bufferRequests.size(),
+            _bufferType == ucxx::BufferType::Host ? 2 : 1 + numMulti);
+
+  _recvPtr.resize(_numBuffers);
+  size_t transferIdx = 0;
+
+  // Populate recv pointers
+  for (const auto& br :
+       std::dynamic_pointer_cast<ucxx::RequestTagMulti>(requests[1])->_bufferRequests) {
+    // br->buffer == nullptr are headers
+    if (br->buffer) {
+      ASSERT_EQ(br->buffer->getType(), _bufferType);
+      ASSERT_EQ(br->buffer->getSize(), _messageSize);
+      ASSERT_TRUE(br->request->isCompleted());
+
+      _recvPtr[transferIdx] = br->buffer->data();
+
+      ++transferIdx;
+    }
+  }
+  ASSERT_EQ(transferIdx, numMulti);
+
+  copyResults();
+
+  // Assert data correctness
+  for (size_t i = 0; i < numMulti; ++i)
+    ASSERT_THAT(_recv[i], ContainerEq(_send[i]));
+}
+
+TEST_P(RequestTest, ProgressTagMultiAllocator)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Interrupting UCP worker progress operation in wait mode is not possible";
+  }
+  if (_bufferType != ucxx::BufferType::Host)
+    GTEST_SKIP() << "Allocator test only allocates host memory";
+
+  const size_t numMulti         = 8;
+  const bool allocateRecvBuffer = false;
+
+  allocate(numMulti, allocateRecvBuffer);
+
+  std::vector<size_t> multiSize(numMulti, _messageSize);
+  std::vector<int> multiIsCUDA(numMulti, false);
+
+  // Buffers larger than the frames are allowed
+  std::vector<std::shared_ptr<ucxx::Buffer>> userBuffers;
+  auto allocator = [&userBuffers](const std::vector<size_t>& size,
+                                  const std::vector<int>& isCUDA) {
+    for (size_t i = 0; i < size.size(); ++i) {
+      EXPECT_FALSE(isCUDA[i]);
+      userBuffers.push_back(ucxx::allocateBuffer(ucxx::BufferType::Host, size[i] + 8));
+    }
+    return userBuffers;
+  };
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->tagMultiSend(_sendPtr, multiSize, multiIsCUDA, ucxx::Tag{0}, false));
+  requests.push_back(_ep->tagMultiRecv(ucxx::Tag{0}, ucxx::TagMaskFull, false, allocator));
+  waitRequests(_worker, requests, _progressWorker);
+
+  ASSERT_EQ(userBuffers.size(), numMulti);
+
+  // Frames must have been received into the user-provided buffers, in order
+  _recvPtr.resize(_numBuffers);
+  size_t transferIdx = 0;
+  for (const auto& br :
+       std::dynamic_pointer_cast<ucxx::RequestTagMulti>(requests[1])->_bufferRequests) {
+    // br->buffer == nullptr are headers
+    if (br->buffer) {
+      ASSERT_EQ(br->buffer, userBuffers[transferIdx]);
+      _recvPtr[transferIdx] = br->buffer->data();
+      ++transferIdx;
+    }
+  }
+  ASSERT_EQ(transferIdx, numMulti);
+
+  copyResults();
+
+  for (size_t i = 0; i < numMulti; ++i)
+    ASSERT_THAT(_recv[i], ContainerEq(_send[i]));
+}
+
+TEST_P(RequestTest, ProgressTagMultiInvalidAllocator)
+{
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Interrupting UCP worker progress operation in wait mode is not possible";
+  }
+  if (_bufferType != ucxx::BufferType::Host)
+    GTEST_SKIP() << "Allocator test only allocates host memory";
+
+  const size_t numMulti = 4;
+
+  allocate(numMulti, false);
+
+  std::vector<size_t> multiSize(numMulti, _messageSize);
+  std::vector<int> multiIsCUDA(numMulti, false);
+
+  // Too few buffers, throwing, and buffers smaller than their frames
+  std::vector<ucxx::TagMultiRecvAllocatorType> allocators{
+    [](const std::vector<size_t>& size, const std::vector<int>& isCUDA) {
+      return std::vector<std::shared_ptr<ucxx::Buffer>>{
+        ucxx::allocateBuffer(ucxx::BufferType::Host, size[0])};
+    },
+    [](const std::vector<size_t>& size,
+       const std::vector<int>& isCUDA) -> std::vector<std::shared_ptr<ucxx::Buffer>> {
+      throw std::bad_alloc();
+    }};
+  if (_messageSize > 0) {
+    allocators.push_back([](const std::vector<size_t>& size, const std::vector<int>& isCUDA) {
+      std::vector<std::shared_ptr<ucxx::Buffer>> buffers;
+      for (size_t i = 0; i < size.size(); ++i)
+        buffers.push_back(ucxx::allocateBuffer(ucxx::BufferType::Host, size[i] - 1));
+      return buffers;
+    });
+  }
+
+  for (const auto& allocator : allocators) {
+    std::vector<std::shared_ptr<ucxx::Request>> requests;
+    requests.push_back(_ep->tagMultiSend(_sendPtr, multiSize, multiIsCUDA, ucxx::Tag{0}, false));
+    requests.push_back(_ep->tagMultiRecv(ucxx::Tag{0}, ucxx::TagMaskFull, false, allocator));
+    ASSERT_TRUE(loopWithTimeout(std::chrono::seconds(10), [this, &requests]() {
+      if (_progressWorker) _progressWorker();
+      return requests[0]->isCompleted() && requests[1]->isCompleted();
+    }));
+    ASSERT_EQ(requests[0]->getStatus(), UCS_OK);
+    ASSERT_EQ(requests[1]->getStatus(), UCS_ERR_INVALID_PARAM);
+  }
+
+  // The frames were discarded, a subsequent transfer with the same tag is not affected
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->tagMultiSend(_sendPtr, multiSize, multiIsCUDA, ucxx::Tag{0}, false));
+  requests.push_back(_ep->tagMultiRecv(ucxx::Tag{0}, ucxx::TagMaskFull, false));
+  waitRequests(_worker, requests, _progressWorker);
+
+  _recvPtr.resize(_numBuffers);
+  size_t transferIdx = 0;
+  for (const auto& br :
+       std::dynamic_pointer_cast<ucxx::RequestTagMulti>(requests[1])->_bufferRequests) {
+    if (br->buffer) _recvPtr[transferIdx++] = br->buffer->data();
+  }
+  ASSERT_EQ(transferIdx, numMulti);
+
+  copyResults();
+
+  for (size_t i = 0; i < numMulti; ++i)
+    ASSERT_THAT(_recv[i], ContainerEq(_send[i]));
+}
+
+TEST_P(RequestTest, ProgressTagBatch)
+{
+  const size_t numBatch = 8;
+
+  allocate(numBatch);
+
+  std::vector<size_t> batchSize(numBatch, _messageSize);
+  std::vector<ucxx::Tag> batchTag;
+  for (size_t i = 0; i < numBatch; ++i)
+    batchTag.push_back(ucxx::Tag{i});
+
+  // Submit and wait for transfers to complete
+  auto requests     = _ep->tagSendBatch(_sendPtr, batchSize, batchTag);
+  auto recvRequests = _ep->tagRecvBatch(_recvPtr, batchSize, batchTag, ucxx::TagMaskFull);
+  ASSERT_EQ(requests.size(), numBatch);
+  ASSERT_EQ(recvRequests.size(), numBatch);
+  requests.insert(requests.end(), recvRequests.begin(), recvRequests.end());
+  waitRequests(_worker, requests, _progressWorker);
+
+  copyResults();
+
+  // Assert data correctness
+  for (size_t i = 0; i < numBatch; ++i)
+    ASSERT_THAT(_recv[i], ContainerEq(_send[i]));
+
+  // Input vectors of mismatching sizes
+  batchTag.pop_back();
+  EXPECT_THROW(_ep->tagSendBatch(_sendPtr, batchSize, batchTag), std::runtime_error);
+}
+
+TEST_P(RequestTest, ProgressFile)
+{
+  if (_bufferType != ucxx::BufferType::Host) GTEST_SKIP() << "Files are tested with host memory";
+  if (_progressMode == ProgressMode::Wait) {
+    GTEST_SKIP() << "Interrupting UCP worker progress operation in wait mode is not possible";
+  }
+
+  allocate();
+
+  char sendPath[] = "/tmp/ucxx-file-send-XXXXXX";
+  char recvPath[] = "/tmp/ucxx-file-recv-XXXXXX";
+  int sendFd      = mkstemp(sendPath);
+  int recvFd      = mkstemp(recvPath);
+  ASSERT_NE(sendFd, -1);
+  ASSERT_NE(recvFd, -1);
+  close(recvFd);
+  ASSERT_EQ(write(sendFd, _send[0].data(), _messageSize), static_cast<ssize_t>(_messageSize));
+  close(sendFd);
+
+  // Chunks smaller than the ring of buffers and not dividing the file, more chunks than
+  // buffers are pipelined through the ring
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->fileRecv(recvPath, ucxx::Tag{0}, false, 2));
+  requests.push_back(_ep->fileSend(sendPath, ucxx::Tag{0}, false, 1000, 3));
+  waitRequests(_worker, requests, _progressWorker);
+
+  recvFd = open(recvPath, O_RDONLY);
+  ASSERT_NE(recvFd, -1);
+  ASSERT_EQ(lseek(recvFd, 0, SEEK_END), static_cast<off_t>(_messageSize));
+  ASSERT_EQ(pread(recvFd, _recv[0].data(), _messageSize, 0), static_cast<ssize_t>(_messageSize));
+  close(recvFd);
+  unlink(sendPath);
+  unlink(recvPath);
+
+  ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
+
+  EXPECT_THROW(_ep->fileSend(sendPath, ucxx::Tag{0}), std::ios_base::failure);
+  EXPECT_THROW(_ep->fileSend(sendPath, ucxx::Tag{0}, false, 0), std::invalid_argument);
+}
+
 TEST_P(RequestTest, TagUserCallback)
 {
   allocate();
@@ -306,6 +1247,36 @@ TEST_P(RequestTest, TagUserCallback)
   ASSERT_THAT(_recv[0], ContainerEq(_send[0]));
 }
 
+TEST_P(RequestTest, TagUserCallbackBeforeCompleted)
+{
+  allocate();
+
+  // Completion is only observed once the callback returned, so that its captures may be
+  // released as soon as the request is seen completed.
+  std::vector<std::atomic<bool>> callbackDone(2);
+  auto callback = [&callbackDone](ucs_status_t status, ::ucxx::RequestCallbackUserData data) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    callbackDone[*std::static_pointer_cast<size_t>(data)] = true;
+  };
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(_ep->tagSend(
+    _sendPtr[0], _messageSize, ucxx::Tag{0}, false, callback, std::make_shared<size_t>(0u)));
+  requests.push_back(_ep->tagRecv(_recvPtr[0],
+                                  _messageSize,
+                                  ucxx::Tag{0},
+                                  ucxx::TagMaskFull,
+                                  false,
+                                  callback,
+                                  std::make_shared<size_t>(1u)));
+  waitRequests(_worker, requests, _progressWorker);
+
+  for (size_t i = 0; i < requests.size(); ++i) {
+    ASSERT_TRUE(callbackDone[i]);
+    ASSERT_EQ(requests[i]->getStatus(), UCS_OK);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(ProgressModes,
                          RequestTest,
                          Combine(Values(ucxx::BufferType::Host),
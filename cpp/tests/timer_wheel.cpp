@@ -0,0 +1,106 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ucxx/timer_wheel.h>
+
+namespace {
+
+TEST(TimerWheelTest, ExpireAtDeadline)
+{
+  ucxx::TimerWheel<size_t> wheel{};
+
+  // Deadlines spanning all levels of the wheel
+  std::mt19937_64 generator(0);
+  std::uniform_int_distribution<uint64_t> distribution(1, 1 << 20);
+  std::vector<uint64_t> deadlines(1000);
+  for (size_t i = 0; i < deadlines.size(); ++i) {
+    deadlines[i] = distribution(generator);
+    wheel.schedule(deadlines[i], i);
+  }
+  ASSERT_EQ(wheel.size(), deadlines.size());
+
+  std::vector<uint64_t> expiredAt(deadlines.size(), 0);
+  uint64_t tick = 0;
+  size_t expired = 0;
+  while (wheel.size() > 0) {
+    tick += 37;
+    expired += wheel.advance(tick, [&expiredAt, &tick](size_t i) {
+      ASSERT_EQ(expiredAt[i], 0);
+      expiredAt[i] = tick;
+    });
+  }
+  ASSERT_EQ(expired, deadlines.size());
+
+  // Each value expires with the first advance reaching its deadline
+  for (size_t i = 0; i < deadlines.size(); ++i) {
+    ASSERT_GE(expiredAt[i], deadlines[i]);
+    ASSERT_LT(expiredAt[i] - deadlines[i], 37);
+  }
+}
+
+TEST(TimerWheelTest, ExpirePastDeadline)
+{
+  ucxx::TimerWheel<int> wheel{100};
+
+  wheel.schedule(50, 1);
+  wheel.schedule(100, 2);
+  wheel.schedule(101, 3);
+
+  std::vector<int> expired;
+  auto expire = [&expired](int value) { expired.push_back(value); };
+
+  ASSERT_EQ(wheel.advance(100, expire), 2);
+  ASSERT_EQ(expired.size(), 2);
+  ASSERT_EQ(wheel.size(), 1);
+
+  ASSERT_EQ(wheel.advance(101, expire), 1);
+  ASSERT_EQ(expired.back(), 3);
+  ASSERT_EQ(wheel.size(), 0);
+}
+
+TEST(TimerWheelTest, DeadlineBeyondRange)
+{
+  ucxx::TimerWheel<int> wheel{};
+
+  // Beyond the range of the highest level, cascading again once its furthest slot is reached
+  const uint64_t deadline = uint64_t{1} << 30;
+  wheel.schedule(deadline, 1);
+  wheel.schedule(5, 2);
+
+  std::vector<int> expired;
+  auto expire = [&expired](int value) { expired.push_back(value); };
+
+  ASSERT_EQ(wheel.advance(deadline - 1, expire), 1);
+  ASSERT_EQ(expired.back(), 2);
+  ASSERT_EQ(wheel.getCurrentTick(), deadline - 1);
+
+  ASSERT_EQ(wheel.advance(deadline, expire), 1);
+  ASSERT_EQ(expired.back(), 1);
+  ASSERT_EQ(wheel.size(), 0);
+}
+
+TEST(TimerWheelTest, ScheduleWhileExpiring)
+{
+  ucxx::TimerWheel<int> wheel{};
+
+  wheel.schedule(10, 1);
+
+  std::vector<int> expired;
+  ASSERT_EQ(wheel.advance(20,
+                          [&wheel, &expired](int value) {
+                            expired.push_back(value);
+                            if (value == 1) wheel.schedule(15, 2);
+                          }),
+            2);
+  ASSERT_EQ(expired, std::vector<int>({1, 2}));
+  ASSERT_EQ(wheel.size(), 0);
+}
+
+}  // namespace
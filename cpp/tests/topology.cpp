@@ -0,0 +1,65 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <ucxx/utils/topology.h>
+
+using ::testing::ContainerEq;
+
+namespace {
+
+TEST(TopologyTest, LocalTopology)
+{
+  auto topology = ucxx::utils::getTopology("all,ucxx_nonexistent_device:1", {"0000:ff:1f.7"});
+
+  ASSERT_FALSE(topology.hostId.empty());
+  ASSERT_EQ(ucxx::utils::getTopologyLocality(topology, topology),
+            topology.pciPaths.empty() ? ucxx::TopologyLocality::SameHost
+                                      : ucxx::TopologyLocality::SamePcieSwitch);
+}
+
+TEST(TopologyTest, SerializeDeserialize)
+{
+  ucxx::utils::Topology topology{
+    "host", {0, 1}, {"pci0000:00/0000:00:01.0/0000:01:00.0", "pci0000:80/0000:80:01.0"}};
+
+  auto deserialized =
+    ucxx::utils::deserializeTopology(ucxx::utils::serializeTopology(topology));
+  ASSERT_EQ(deserialized.hostId, topology.hostId);
+  ASSERT_THAT(deserialized.numaNodes, ContainerEq(topology.numaNodes));
+  ASSERT_THAT(deserialized.pciPaths, ContainerEq(topology.pciPaths));
+
+  auto empty = ucxx::utils::deserializeTopology(ucxx::utils::serializeTopology({}));
+  ASSERT_TRUE(empty.hostId.empty());
+  ASSERT_TRUE(empty.numaNodes.empty());
+  ASSERT_TRUE(empty.pciPaths.empty());
+
+  EXPECT_THROW(ucxx::utils::deserializeTopology("host\n"), std::invalid_argument);
+  EXPECT_THROW(ucxx::utils::deserializeTopology("host\na\n\n"), std::invalid_argument);
+}
+
+TEST(TopologyTest, Locality)
+{
+  ucxx::utils::Topology gpu{"host", {0}, {"pci0000:00/0000:00:01.0/0000:01:00.0/0000:02:08.0"}};
+  ucxx::utils::Topology nic{"host", {0}, {"pci0000:00/0000:00:01.0/0000:01:00.0/0000:02:10.0"}};
+  ucxx::utils::Topology sameNuma{"host", {0}, {"pci0000:00/0000:00:02.0/0000:05:00.0"}};
+  ucxx::utils::Topology otherNuma{"host", {1}, {"pci0000:80/0000:80:01.0/0000:81:00.0"}};
+  ucxx::utils::Topology otherHost{"other", {0}, gpu.pciPaths};
+
+  ASSERT_EQ(ucxx::utils::getTopologyLocality(gpu, gpu), ucxx::TopologyLocality::SamePcieSwitch);
+  ASSERT_EQ(ucxx::utils::getTopologyLocality(gpu, nic), ucxx::TopologyLocality::SamePcieSwitch);
+  ASSERT_EQ(ucxx::utils::getTopologyLocality(gpu, sameNuma),
+            ucxx::TopologyLocality::SameNumaNode);
+  ASSERT_EQ(ucxx::utils::getTopologyLocality(gpu, otherNuma), ucxx::TopologyLocality::SameHost);
+  ASSERT_EQ(ucxx::utils::getTopologyLocality(gpu, otherHost), ucxx::TopologyLocality::Remote);
+  ASSERT_EQ(ucxx::utils::getTopologyLocality({}, {}), ucxx::TopologyLocality::Remote);
+}
+
+}  // namespace
@@ -2,10 +2,20 @@
  * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
 #include <tuple>
 #include <vector>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <gtest/gtest.h>
 
 #include <ucxx/api.h>
@@ -62,6 +72,8 @@ class WorkerProgressTest : public WorkerTest,
       _worker->startProgressThread(true);
     else if (_progressMode == ProgressMode::ThreadBlocking)
       _worker->startProgressThread(false);
+    else if (_progressMode == ProgressMode::ThreadHybrid)
+      _worker->startProgressThread(false, 1, 100000 /* 100us */);
 
     _progressWorker = getProgressFunction(_worker, _progressMode);
   }
@@ -75,10 +87,256 @@ TEST_P(WorkerCapabilityTest, CheckCapability)
   ASSERT_EQ(_worker->isFutureEnabled(), _enableFuture);
 }
 
+TEST_F(WorkerTest, SetFuturesPoolSize)
+{
+  EXPECT_THROW(_worker->setFuturesPoolSize(0, 0), std::runtime_error);
+  EXPECT_THROW(_worker->setFuturesPoolSize(10, 20), std::runtime_error);
+  EXPECT_NO_THROW(_worker->setFuturesPoolSize(1000, 500));
+  EXPECT_NO_THROW(_worker->setFuturesPoolSize(1, 0));
+}
+
 INSTANTIATE_TEST_SUITE_P(Capabilities,
                          WorkerCapabilityTest,
                          Combine(Values(false, true), Values(false, true)));
 
+TEST_F(WorkerTest, RegisterBufferAllocator)
+{
+  size_t allocations = 0;
+  _worker->registerBufferAllocator(ucxx::BufferType::Host, [&allocations](size_t size) {
+    ++allocations;
+    return std::make_shared<ucxx::HostBuffer>(size);
+  });
+
+  auto buffer = _worker->allocateInternalBuffer(ucxx::BufferType::Host, 100);
+  ASSERT_EQ(allocations, 1u);
+  ASSERT_EQ(buffer->getSize(), 100u);
+
+  // Allocators take precedence over buffer pools
+  _worker->registerBufferPool(std::make_shared<ucxx::BufferPool>(ucxx::BufferType::Host));
+  _worker->allocateInternalBuffer(ucxx::BufferType::Host, 100);
+  ASSERT_EQ(allocations, 2u);
+
+  _worker->registerBufferAllocator(ucxx::BufferType::Host, nullptr);
+  _worker->allocateInternalBuffer(ucxx::BufferType::Host, 100);
+  ASSERT_EQ(allocations, 2u);
+  ASSERT_EQ(_worker->getBufferPool(ucxx::BufferType::Host)->getMisses(), 1u);
+}
+
+TEST_F(WorkerTest, EpollFileDescriptor)
+{
+  EXPECT_THROW(_worker->getEpollFileDescriptor(), std::runtime_error);
+
+  _worker->initBlockingProgressMode();
+  ASSERT_GE(_worker->getEpollFileDescriptor(), 0);
+}
+
+TEST_F(WorkerTest, ProgressHybrid)
+{
+  _worker->initBlockingProgressMode();
+
+  auto ep = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  std::vector<int> send{1, 2, 3};
+  std::vector<int> recv(send.size());
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(ep->tagSend(send.data(), send.size() * sizeof(int), ucxx::Tag{0}));
+  requests.push_back(
+    ep->tagRecv(recv.data(), recv.size() * sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull));
+  waitRequests(_worker, requests, [this]() { _worker->progressHybrid(1000000000 /* 1s */, 0); });
+
+  ASSERT_EQ(recv, send);
+  ASSERT_GT(_worker->getProgressSpinHits(), 0u);
+}
+
+TEST_F(WorkerTest, RequestTracer)
+{
+  ucxx::RequestTracer tracer{};
+  ASSERT_FALSE(tracer.sample());
+  EXPECT_THROW(tracer.configure(1, 0), std::runtime_error);
+
+  tracer.configure(2, 3);
+  std::vector<bool> sampled;
+  for (size_t i = 0; i < 4; ++i)
+    sampled.push_back(tracer.sample());
+  ASSERT_EQ(sampled, std::vector<bool>({true, false, true, false}));
+
+  for (uint64_t i = 0; i < 5; ++i) {
+    ucxx::RequestTrace trace{};
+    trace.created = i;
+    tracer.record(trace);
+  }
+  ASSERT_EQ(tracer.getDropped(), 2u);
+
+  auto traces = tracer.getTraces(true);
+  ASSERT_EQ(traces.size(), 3u);
+  for (size_t i = 0; i < traces.size(); ++i)
+    ASSERT_EQ(traces[i].created, i + 2);
+
+  ASSERT_TRUE(tracer.getTraces().empty());
+  ASSERT_EQ(tracer.getDropped(), 0u);
+}
+
+TEST_F(WorkerTest, RequestTracing)
+{
+  auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
+  auto ep             = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  _worker->setRequestTracing(1, 16);
+
+  std::vector<int> send{123};
+  std::vector<int> recv(1);
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(ep->tagSend(send.data(), send.size() * sizeof(int), ucxx::Tag{0}));
+  requests.push_back(
+    ep->tagRecv(recv.data(), recv.size() * sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull));
+  waitRequests(_worker, requests, progressWorker);
+
+  auto traces = _worker->getRequestTraces();
+  ASSERT_EQ(traces.size(), 2u);
+  for (const auto& trace : traces) {
+    ASSERT_EQ(trace.status, UCS_OK);
+    ASSERT_GT(trace.created, 0u);
+    ASSERT_GE(trace.submitted, trace.created);
+    ASSERT_GE(trace.completed, trace.submitted);
+    ASSERT_GE(trace.notified, trace.completed);
+  }
+
+  _worker->setRequestTracing(0);
+  ASSERT_TRUE(_worker->getRequestTraces().empty());
+}
+
+TEST_F(WorkerTest, TrafficCapture)
+{
+  char path[] = "/tmp/ucxx-capture-XXXXXX";
+  int fd      = mkstemp(path);
+  ASSERT_NE(fd, -1);
+  close(fd);
+
+  ucxx::TrafficCapture capture{};
+  ASSERT_FALSE(capture.isEnabled());
+  capture.start(path);
+  ASSERT_TRUE(capture.isEnabled());
+
+  int endpoints[2];
+  ucxx::CaptureRecord record{};
+  record.operation  = ucxx::CaptureOperation::TagSend;
+  record.memoryType = UCS_MEMORY_TYPE_HOST;
+  record.size       = 1 << 20;
+  record.tag        = 0xdeadbeefcafe;
+  capture.record(record, &endpoints[0]);
+  record.operation = ucxx::CaptureOperation::StreamReceive;
+  record.size      = 5;
+  record.count     = 3;
+  record.tag       = 0;
+  capture.record(record, &endpoints[1]);
+  record.operation = ucxx::CaptureOperation::TagReceive;
+  capture.record(record, nullptr);
+  capture.record(record, &endpoints[0]);
+  ASSERT_EQ(capture.getRecorded(), 4u);
+  capture.stop();
+  ASSERT_FALSE(capture.isEnabled());
+
+  auto records = ucxx::TrafficCapture::read(path);
+  ASSERT_EQ(records.size(), 4u);
+  ASSERT_EQ(records[0].operation, ucxx::CaptureOperation::TagSend);
+  ASSERT_EQ(records[0].memoryType, UCS_MEMORY_TYPE_HOST);
+  ASSERT_EQ(records[0].size, 1u << 20);
+  ASSERT_EQ(records[0].count, 1u);
+  ASSERT_EQ(records[0].tag, 0xdeadbeefcafeu);
+  ASSERT_EQ(records[1].operation, ucxx::CaptureOperation::StreamReceive);
+  ASSERT_EQ(records[1].size, 5u);
+  ASSERT_EQ(records[1].count, 3u);
+  ASSERT_EQ(records[2].operation, ucxx::CaptureOperation::TagReceive);
+  std::vector<uint64_t> endpointIndices;
+  for (const auto& r : records)
+    endpointIndices.push_back(r.endpoint);
+  ASSERT_EQ(endpointIndices, std::vector<uint64_t>({1, 2, 0, 1}));
+
+  // Records are ignored once capture stopped
+  capture.record(record, nullptr);
+  ASSERT_EQ(ucxx::TrafficCapture::read(path).size(), 4u);
+
+  fd = open(path, O_WRONLY | O_TRUNC);
+  ASSERT_NE(fd, -1);
+  ASSERT_EQ(write(fd, "UCXXPAC", 7), 7);
+  close(fd);
+  EXPECT_THROW(ucxx::TrafficCapture::read(path), std::runtime_error);
+  unlink(path);
+  EXPECT_THROW(ucxx::TrafficCapture::read(path), std::ios_base::failure);
+}
+
+TEST_F(WorkerTest, TrafficCaptureEnvironment)
+{
+  const std::string prefix = "/tmp/ucxx-capture-env-" + std::to_string(getpid());
+  ucxx::CaptureRecord record{};
+  record.operation  = ucxx::CaptureOperation::TagSend;
+  record.memoryType = UCS_MEMORY_TYPE_HOST;
+
+  // Each capture started from the environment writes its own trace
+  for (const auto& suffix : {std::string{"-%p-%w"}, std::string{}}) {
+    ASSERT_EQ(setenv("UCXX_TRAFFIC_CAPTURE", (prefix + suffix).c_str(), 1), 0);
+    ucxx::TrafficCapture captures[2];
+    for (size_t i = 0; i < 2; ++i) {
+      captures[i].startFromEnvironment();
+      ASSERT_TRUE(captures[i].isEnabled());
+      for (size_t j = 0; j <= i; ++j)
+        captures[i].record(record, nullptr);
+    }
+    ASSERT_NE(captures[0].getPath(), captures[1].getPath());
+    for (size_t i = 0; i < 2; ++i) {
+      captures[i].stop();
+      ASSERT_EQ(ucxx::TrafficCapture::read(captures[i].getPath()).size(), i + 1);
+      unlink(captures[i].getPath().c_str());
+    }
+  }
+  unsetenv("UCXX_TRAFFIC_CAPTURE");
+}
+
+TEST_F(WorkerTest, TrafficCaptureWorker)
+{
+  auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
+  auto ep             = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  char path[] = "/tmp/ucxx-capture-XXXXXX";
+  int fd      = mkstemp(path);
+  ASSERT_NE(fd, -1);
+  close(fd);
+
+  _worker->startTrafficCapture(path);
+  ASSERT_TRUE(_worker->isTrafficCaptureEnabled());
+
+  std::vector<int> send{123, 456};
+  std::vector<int> recv(2);
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(ep->tagSend(send.data(), send.size() * sizeof(int), ucxx::Tag{7}));
+  requests.push_back(
+    ep->tagRecv(recv.data(), recv.size() * sizeof(int), ucxx::Tag{7}, ucxx::TagMaskFull));
+  waitRequests(_worker, requests, progressWorker);
+
+  // Operations of endpoints with capture disabled are not recorded
+  ep->setTrafficCaptureEnabled(false);
+  requests.clear();
+  requests.push_back(ep->tagSend(send.data(), send.size() * sizeof(int), ucxx::Tag{8}));
+  requests.push_back(
+    ep->tagRecv(recv.data(), recv.size() * sizeof(int), ucxx::Tag{8}, ucxx::TagMaskFull));
+  waitRequests(_worker, requests, progressWorker);
+
+  _worker->stopTrafficCapture();
+  ASSERT_FALSE(_worker->isTrafficCaptureEnabled());
+
+  auto records = ucxx::TrafficCapture::read(path);
+  unlink(path);
+  ASSERT_EQ(records.size(), 2u);
+  ASSERT_EQ(records[0].operation, ucxx::CaptureOperation::TagSend);
+  ASSERT_EQ(records[1].operation, ucxx::CaptureOperation::TagReceive);
+  for (const auto& record : records) {
+    ASSERT_EQ(record.memoryType, UCS_MEMORY_TYPE_HOST);
+    ASSERT_EQ(record.endpoint, 1u);
+    ASSERT_EQ(record.size, send.size() * sizeof(int));
+    ASSERT_EQ(record.tag, 7u);
+  }
+}
+
 TEST_F(WorkerTest, TagProbe)
 {
   auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
@@ -99,6 +357,133 @@ TEST_F(WorkerTest, TagProbe)
   ASSERT_TRUE(_worker->tagProbe(ucxx::Tag{0}));
 }
 
+TEST_F(WorkerTest, TagProbeMessage)
+{
+  auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
+  auto ep             = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  ASSERT_EQ(_worker->tagProbeMessage(ucxx::Tag{0}).handle, nullptr);
+  EXPECT_THROW(_worker->tagMsgRecv(ucxx::TagMessage{}, nullptr, 0), std::invalid_argument);
+
+  std::vector<int> send{1, 2, 3};
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(ep->tagSend(send.data(), send.size() * sizeof(int), ucxx::Tag{0x12}));
+  waitRequests(_worker, requests, progressWorker);
+
+  ucxx::TagMessage message{};
+  loopWithTimeout(std::chrono::milliseconds(5000), [&]() {
+    progressWorker();
+    message = _worker->tagProbeMessage(ucxx::Tag{0x10}, ucxx::TagMask{0xf0});
+    return message.handle != nullptr;
+  });
+  ASSERT_NE(message.handle, nullptr);
+  ASSERT_EQ(message.info.senderTag, ucxx::Tag{0x12});
+  ASSERT_EQ(message.info.length, send.size() * sizeof(int));
+
+  // The message was removed, thus it's not matched again
+  ASSERT_FALSE(_worker->tagProbe(ucxx::Tag{0x12}));
+
+  std::vector<int> recv(message.info.length / sizeof(int));
+  requests.clear();
+  requests.push_back(_worker->tagMsgRecv(message, recv.data(), message.info.length));
+  waitRequests(_worker, requests, progressWorker);
+  ASSERT_EQ(recv, send);
+}
+
+TEST_F(WorkerTest, TagRecvRing)
+{
+  auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
+  auto ep             = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  EXPECT_THROW(_worker->createTagRecvRing(0, sizeof(int), ucxx::Tag{0}, ucxx::TagMask{0}),
+               std::invalid_argument);
+
+  std::vector<int> received;
+  std::vector<ucxx::Tag> senderTags;
+  auto callback = [&received, &senderTags](const ucxx::TagRecvRingCompletion& c) {
+    ASSERT_EQ(c.status, UCS_OK);
+    ASSERT_EQ(c.info.length, sizeof(int));
+    received.push_back(*reinterpret_cast<int*>(c.buffer));
+    senderTags.push_back(c.info.senderTag);
+  };
+  auto ring =
+    _worker->createTagRecvRing(2, sizeof(int), ucxx::Tag{0x10}, ucxx::TagMask{0xf0}, callback);
+  ASSERT_EQ(ring->getNumBuffers(), 2u);
+  EXPECT_THROW(ring->release(0), std::runtime_error);
+
+  // More messages than ring buffers, each completed buffer is posted again
+  std::vector<int> send{1, 2, 3, 4, 5};
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  for (size_t i = 0; i < send.size(); ++i)
+    requests.push_back(ep->tagSend(&send[i], sizeof(int), ucxx::Tag{0x10 | i}));
+  waitRequests(_worker, requests, progressWorker);
+  loopWithTimeout(std::chrono::milliseconds(5000), [&]() {
+    progressWorker();
+    return received.size() == send.size();
+  });
+
+  ASSERT_EQ(received, send);
+  for (size_t i = 0; i < send.size(); ++i)
+    ASSERT_EQ(senderTags[i], ucxx::Tag{0x10 | i});
+  ASSERT_EQ(ring->getReceivedCount(), send.size());
+
+  ring->stop();
+}
+
+TEST_F(WorkerTest, TagRecvRingPoll)
+{
+  auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
+  auto ep             = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  auto ring = _worker->createTagRecvRing(1, sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull);
+
+  std::vector<int> send{1, 2};
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  for (auto& value : send)
+    requests.push_back(ep->tagSend(&value, sizeof(int), ucxx::Tag{0}));
+
+  std::vector<ucxx::TagRecvRingCompletion> completions;
+  for (size_t i = 0; i < send.size(); ++i) {
+    loopWithTimeout(std::chrono::milliseconds(5000), [&]() {
+      progressWorker();
+      return ring->poll(completions) > 0;
+    });
+    ASSERT_EQ(completions.size(), i + 1);
+    ASSERT_EQ(*reinterpret_cast<int*>(completions.back().buffer), send[i]);
+
+    // The buffer is only posted again once released
+    ring->release(completions.back().slot);
+  }
+  waitRequests(_worker, requests, progressWorker);
+}
+
+TEST_F(WorkerTest, TagDrainOptions)
+{
+  EXPECT_THROW(_worker->setTagDrainOptions(ucxx::TagDrainMode::Copy, 0), std::invalid_argument);
+
+  for (const auto mode : {ucxx::TagDrainMode::Copy, ucxx::TagDrainMode::Discard}) {
+    auto worker         = _context->createWorker();
+    auto progressWorker = getProgressFunction(worker, ProgressMode::Polling);
+    auto ep             = worker->createEndpointFromWorkerAddress(worker->getAddress());
+    worker->setTagDrainOptions(mode, 2);
+
+    // Leave more unmatched messages than drained at once for the destructor to drain
+    std::vector<int> send(5, 123);
+    std::vector<std::shared_ptr<ucxx::Request>> requests;
+    for (size_t i = 0; i < send.size(); ++i)
+      requests.push_back(ep->tagSend(&send[i], sizeof(int), ucxx::Tag{i}));
+    waitRequests(worker, requests, progressWorker);
+    loopWithTimeout(std::chrono::milliseconds(5000), [&]() {
+      progressWorker();
+      return worker->tagProbe(ucxx::Tag{send.size() - 1});
+    });
+
+    requests.clear();
+    ep.reset();
+    ASSERT_NO_THROW(worker.reset());
+  }
+}
+
 TEST_F(WorkerTest, AmProbe)
 {
   auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
@@ -119,6 +504,102 @@ TEST_F(WorkerTest, AmProbe)
   ASSERT_TRUE(_worker->amProbe(ep->getHandle()));
 }
 
+TEST_F(WorkerTest, AmFlowControl)
+{
+  auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
+  auto ep             = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  EXPECT_THROW(_worker->registerAmHandler(0xffff, nullptr), std::invalid_argument);
+
+  ep->setAmFlowControl(2, 0);
+  ASSERT_TRUE(ep->isAmFlowControlEnabled());
+
+  std::vector<int> send{1, 2, 3, 4};
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  for (auto& value : send)
+    requests.push_back(ep->amSend(&value, sizeof(int), UCS_MEMORY_TYPE_HOST));
+
+  // Only the budget is sent while the receiver doesn't consume messages
+  loopWithTimeout(std::chrono::milliseconds(5000), [&]() {
+    progressWorker();
+    return requests[0]->isCompleted() && requests[1]->isCompleted();
+  });
+  for (size_t i = 0; i < 10; ++i)
+    progressWorker();
+  ASSERT_FALSE(requests[2]->isCompleted());
+  ASSERT_FALSE(requests[3]->isCompleted());
+  ASSERT_EQ(ep->getAmPendingSendCount(), 2u);
+
+  // Receiving messages returns credits, allowing the pending sends to complete
+  std::vector<std::shared_ptr<ucxx::Request>> recvRequests;
+  for (size_t i = 0; i < send.size(); ++i)
+    recvRequests.push_back(ep->amRecv());
+  requests.insert(requests.end(), recvRequests.begin(), recvRequests.end());
+  waitRequests(_worker, requests, progressWorker);
+  ASSERT_EQ(ep->getAmPendingSendCount(), 0u);
+
+  for (size_t i = 0; i < send.size(); ++i)
+    ASSERT_EQ(*reinterpret_cast<int*>(recvRequests[i]->getRecvBuffer()->data()), send[i]);
+
+  ep->setAmFlowControl(0, 0);
+  ASSERT_FALSE(ep->isAmFlowControlEnabled());
+}
+
+TEST_F(WorkerTest, AmAggregation)
+{
+  auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
+  auto ep             = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  EXPECT_THROW(_worker->registerAmHandler(0xfffe, nullptr), std::invalid_argument);
+  EXPECT_THROW(ep->setAmAggregation(256, 128), std::invalid_argument);
+
+  ep->setAmAggregation(sizeof(int), 128);
+  ASSERT_TRUE(ep->isAmAggregationEnabled());
+  EXPECT_THROW(ep->setAmFlowControl(2, 0), std::runtime_error);
+
+  // Small messages are aggregated, larger ones are sent individually and in order
+  std::vector<int> send{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  std::vector<int> large(256, 42);
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  for (size_t i = 0; i < send.size(); ++i) {
+    requests.push_back(ep->amSend(
+      &send[i], sizeof(int), UCS_MEMORY_TYPE_HOST, false, nullptr, nullptr, std::to_string(i)));
+    if (i == 5)
+      requests.push_back(
+        ep->amSend(large.data(), large.size() * sizeof(int), UCS_MEMORY_TYPE_HOST));
+  }
+  ASSERT_FALSE(requests.back()->isCompleted());
+
+  std::vector<std::shared_ptr<ucxx::Request>> recvRequests;
+  for (size_t i = 0; i < requests.size(); ++i)
+    recvRequests.push_back(ep->amRecv());
+  requests.insert(requests.end(), recvRequests.begin(), recvRequests.end());
+  waitRequests(_worker, requests, progressWorker);
+
+  for (size_t i = 0, j = 0; i < recvRequests.size(); ++i) {
+    auto buffer = recvRequests[i]->getRecvBuffer();
+    if (i == 6) {
+      ASSERT_EQ(buffer->getSize(), large.size() * sizeof(int));
+      continue;
+    }
+    ASSERT_EQ(buffer->getSize(), sizeof(int));
+    ASSERT_EQ(*reinterpret_cast<int*>(buffer->data()), send[j]);
+    ASSERT_EQ(recvRequests[i]->getRecvHeader(), std::to_string(j));
+    ++j;
+  }
+
+  // Pending messages are submitted by an explicit flush
+  int value = 11;
+  requests = {ep->amSend(&value, sizeof(value), UCS_MEMORY_TYPE_HOST)};
+  ep->flushAmAggregation();
+  requests.push_back(ep->amRecv());
+  waitRequests(_worker, requests, progressWorker);
+  ASSERT_EQ(*reinterpret_cast<int*>(requests[1]->getRecvBuffer()->data()), value);
+
+  ep->setAmAggregation(0);
+  ASSERT_FALSE(ep->isAmAggregationEnabled());
+}
+
 TEST_P(WorkerProgressTest, ProgressAm)
 {
   if (_progressMode == ProgressMode::Wait) {
@@ -161,6 +642,54 @@ TEST_P(WorkerProgressTest, ProgressStream)
   ASSERT_EQ(recv[0], send[0]);
 }
 
+TEST_F(WorkerTest, StreamRecvPartial)
+{
+  auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
+  auto ep             = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  std::vector<int> send{123};
+  std::vector<int> recv(4);
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(ep->streamSend(send.data(), send.size() * sizeof(int), 0));
+  requests.push_back(ep->streamRecvPartial(recv.data(), recv.size() * sizeof(int)));
+  waitRequests(_worker, requests, progressWorker);
+
+  // Completes with the data available, without waiting for the full buffer
+  ASSERT_EQ(requests[1]->getRecvLength(), send.size() * sizeof(int));
+  ASSERT_EQ(recv[0], send[0]);
+  EXPECT_THROW(requests[0]->getRecvLength(), std::runtime_error);
+}
+
+TEST_F(WorkerTest, StreamRecvData)
+{
+  auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
+  auto ep             = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  ASSERT_EQ(ep->streamRecvData(), nullptr);
+
+  std::vector<int> send{1, 2, 3};
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(ep->streamSend(send.data(), send.size() * sizeof(int), 0));
+  waitRequests(_worker, requests, progressWorker);
+
+  // Data may be delivered in multiple fragments
+  std::vector<char> recv;
+  loopWithTimeout(std::chrono::milliseconds(5000), [&]() {
+    progressWorker();
+    while (auto streamData = ep->streamRecvData()) {
+      auto data = static_cast<const char*>(streamData->data());
+      recv.insert(recv.end(), data, data + streamData->size());
+      streamData->release();
+      EXPECT_EQ(streamData->data(), nullptr);
+    }
+    return recv.size() == send.size() * sizeof(int);
+  });
+
+  ASSERT_EQ(recv.size(), send.size() * sizeof(int));
+  ASSERT_EQ(memcmp(recv.data(), send.data(), recv.size()), 0);
+}
+
 TEST_P(WorkerProgressTest, ProgressTag)
 {
   auto ep = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
@@ -177,6 +706,416 @@ TEST_P(WorkerProgressTest, ProgressTag)
   ASSERT_EQ(recv[0], send[0]);
 }
 
+TEST_P(WorkerProgressTest, CompletionCallbackThreads)
+{
+  _worker->startCompletionCallbackThreads(2, 1);
+
+  auto ep = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  std::vector<int> send{123};
+  std::vector<int> recv(1);
+
+  std::mutex threadIdsMutex;
+  std::vector<std::thread::id> threadIds;
+  auto callback = [&threadIdsMutex, &threadIds](ucs_status_t status, std::shared_ptr<void>) {
+    ASSERT_EQ(status, UCS_OK);
+    std::lock_guard<std::mutex> lock(threadIdsMutex);
+    threadIds.push_back(std::this_thread::get_id());
+  };
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(
+    ep->tagSend(send.data(), send.size() * sizeof(int), ucxx::Tag{0}, false, callback));
+  requests.push_back(ep->tagRecv(
+    recv.data(), recv.size() * sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull, false, callback));
+  waitRequests(_worker, requests, _progressWorker);
+  ASSERT_EQ(recv[0], send[0]);
+
+  // Callbacks execute asynchronously after requests complete
+  loopWithTimeout(std::chrono::milliseconds(5000), [this, &threadIdsMutex, &threadIds]() {
+    if (_progressWorker) _progressWorker();
+    std::lock_guard<std::mutex> lock(threadIdsMutex);
+    return threadIds.size() == 2;
+  });
+
+  // Blocks until all pending callbacks execute
+  _worker->resetCompletionCallbackExecutor();
+
+  ASSERT_EQ(threadIds.size(), 2u);
+  for (const auto& threadId : threadIds) {
+    ASSERT_NE(threadId, std::this_thread::get_id());
+    ASSERT_NE(threadId, _worker->getProgressThreadId());
+  }
+}
+
+TEST_F(WorkerTest, SharedCompletionExecutor)
+{
+  ASSERT_THROW(_worker->setCompletionExecutor(nullptr), std::invalid_argument);
+
+  auto executor = std::make_shared<ucxx::CompletionExecutor>(2, 1);
+  ASSERT_EQ(executor->getNumThreads(), 2u);
+
+  auto remote = _context->createWorker();
+  _worker->setCompletionExecutor(executor);
+  remote->setCompletionExecutor(executor, true);
+  ASSERT_FALSE(_worker->isCompletionExecutorNotifyingFutures());
+  ASSERT_TRUE(remote->isCompletionExecutorNotifyingFutures());
+
+  auto ep = _worker->createEndpointFromWorkerAddress(remote->getAddress());
+
+  std::vector<int> send{123};
+  std::vector<int> recv(1);
+
+  std::atomic<size_t> callbacksExecuted{0};
+  auto callback = [&callbacksExecuted](ucs_status_t status, std::shared_ptr<void>) {
+    ASSERT_EQ(status, UCS_OK);
+    ++callbacksExecuted;
+  };
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(ep->tagSend(send.data(), sizeof(int), ucxx::Tag{0}, false, callback));
+  requests.push_back(
+    remote->tagRecv(recv.data(), sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull, false, callback));
+
+  auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
+  auto progressRemote = getProgressFunction(remote, ProgressMode::Polling);
+  loopWithTimeout(std::chrono::milliseconds(5000), [&]() {
+    progressWorker();
+    progressRemote();
+    return callbacksExecuted == 2;
+  });
+  ASSERT_EQ(callbacksExecuted, 2u);
+  ASSERT_EQ(recv[0], send[0]);
+
+  _worker->resetCompletionCallbackExecutor();
+  remote->resetCompletionCallbackExecutor();
+  ASSERT_FALSE(remote->isCompletionExecutorNotifyingFutures());
+}
+
+TEST_F(WorkerTest, CompletionExecutorNotifyingFuturesCompleted)
+{
+  _worker       = _context->createWorker(false, true);
+  auto executor = std::make_shared<ucxx::CompletionExecutor>(2, 1);
+  _worker->setCompletionExecutor(executor, true);
+
+  auto ep = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  std::vector<int> send{123};
+  std::vector<int> recv(1);
+
+  // Deferred completions only run once flushed by `progress()`, after requests are stored
+  std::array<std::atomic<ucxx::Request*>, 2> requestPtrs{};
+  std::atomic<size_t> callbacksExecuted{0};
+  std::atomic<size_t> completedInCallback{0};
+  auto callback = [&](ucs_status_t status, std::shared_ptr<void> data) {
+    auto request = requestPtrs[*std::static_pointer_cast<size_t>(data)].load();
+    if (status == UCS_OK && request != nullptr && request->isCompleted() &&
+        request->getStatus() == UCS_OK)
+      ++completedInCallback;
+    ++callbacksExecuted;
+  };
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(ep->tagSend(
+    send.data(), sizeof(int), ucxx::Tag{0}, true, callback, std::make_shared<size_t>(0)));
+  requests.push_back(ep->tagRecv(recv.data(),
+                                 sizeof(int),
+                                 ucxx::Tag{0},
+                                 ucxx::TagMaskFull,
+                                 true,
+                                 callback,
+                                 std::make_shared<size_t>(1)));
+  for (size_t i = 0; i < requests.size(); ++i)
+    requestPtrs[i] = requests[i].get();
+
+  auto progressWorker = getProgressFunction(_worker, ProgressMode::Polling);
+  loopWithTimeout(std::chrono::milliseconds(5000), [&]() {
+    progressWorker();
+    return callbacksExecuted == 2;
+  });
+  ASSERT_EQ(callbacksExecuted, 2u);
+  ASSERT_EQ(completedInCallback, 2u);
+  ASSERT_EQ(recv[0], send[0]);
+
+  for (const auto& request : requests) {
+    ASSERT_EQ(static_cast<ucxx::CompletionFuture*>(request->getFuture())->wait(), UCS_OK);
+    ASSERT_TRUE(request->isCompleted());
+    ASSERT_EQ(request->getStatus(), UCS_OK);
+  }
+
+  _worker->resetCompletionCallbackExecutor();
+}
+
+TEST(CompletionExecutorTest, WorkStealing)
+{
+  constexpr size_t numCallbacks = 8;
+  std::atomic<size_t> executed{0};
+  {
+    // Batches are distributed among both threads in turn, the first blocks until all
+    // others executed, thus the other thread must steal the batches of the first.
+    ucxx::CompletionExecutor executor(2, 1);
+    executor.enqueue([&executed]() {
+      loopWithTimeout(std::chrono::milliseconds(5000),
+                      [&executed]() { return executed == numCallbacks - 1; });
+      ++executed;
+    });
+    for (size_t i = 1; i < numCallbacks; ++i)
+      executor.enqueue([&executed]() { ++executed; });
+    executor.flush();
+
+    loopWithTimeout(std::chrono::milliseconds(5000),
+                    [&executed]() { return executed == numCallbacks; });
+    ASSERT_GT(executor.getStolenBatches(), 0u);
+  }
+  ASSERT_EQ(executed, numCallbacks);
+}
+
+TEST_F(WorkerTest, CompletionCallbackExecutor)
+{
+  ASSERT_THROW(_worker->setCompletionCallbackExecutor(nullptr), std::invalid_argument);
+  ASSERT_THROW(_worker->startCompletionCallbackThreads(0), std::invalid_argument);
+
+  std::vector<size_t> batchSizes;
+  std::vector<ucxx::CompletionCallback> deferred;
+  _worker->setCompletionCallbackExecutor(
+    [&batchSizes, &deferred](std::vector<ucxx::CompletionCallback> callbacks) {
+      batchSizes.push_back(callbacks.size());
+      for (auto& callback : callbacks)
+        deferred.push_back(std::move(callback));
+    },
+    2);
+
+  auto ep = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  std::vector<int> send(3, 123);
+  std::vector<int> recv(3);
+
+  size_t callbacksExecuted = 0;
+  auto callback = [&callbacksExecuted](ucs_status_t, std::shared_ptr<void>) {
+    ++callbacksExecuted;
+  };
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  for (size_t i = 0; i < send.size(); ++i) {
+    requests.push_back(ep->tagSend(&send[i], sizeof(int), ucxx::Tag{i}, false, callback));
+    requests.push_back(
+      ep->tagRecv(&recv[i], sizeof(int), ucxx::Tag{i}, ucxx::TagMaskFull, false, callback));
+  }
+  waitRequests(_worker, requests, [this]() { _worker->progress(); });
+  ASSERT_EQ(recv, send);
+
+  // Callbacks are only handed over to the executor, in batches of at most 2
+  ASSERT_EQ(callbacksExecuted, 0u);
+  ASSERT_EQ(deferred.size(), requests.size());
+  for (const auto& batchSize : batchSizes)
+    ASSERT_LE(batchSize, 2u);
+
+  for (const auto& callback : deferred)
+    callback();
+  ASSERT_EQ(callbacksExecuted, requests.size());
+}
+
+TEST_F(WorkerTest, SerializedThreadMode)
+{
+  EXPECT_THROW(_context->createWorker(false, false, true), std::invalid_argument);
+  ASSERT_FALSE(_worker->isSerializedThreadModeEnabled());
+
+  auto worker = _context->createWorker(true, false, true);
+  ASSERT_TRUE(worker->isSerializedThreadModeEnabled());
+  ASSERT_FALSE(worker->requiresSerializedAccess());
+
+  worker->startProgressThread(true);
+  ASSERT_TRUE(worker->requiresSerializedAccess());
+  EXPECT_THROW(worker->progress(), std::runtime_error);
+
+  // Operations accessing the UCP worker are executed by the progress thread.
+  auto ep = worker->createEndpointFromWorkerAddress(worker->getAddress());
+  ASSERT_FALSE(worker->getInfo().empty());
+
+  std::vector<int> send{123};
+  std::vector<int> recv(1);
+  auto sendReq = ep->tagSend(send.data(), send.size() * sizeof(int), ucxx::Tag{0});
+  ASSERT_TRUE(loopWithTimeout(std::chrono::seconds(10), [&worker]() {
+    return worker->tagProbe(ucxx::Tag{0});
+  }));
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests{
+    sendReq, ep->tagRecv(recv.data(), recv.size() * sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull)};
+  waitRequests(worker, requests, nullptr);
+  ASSERT_EQ(recv[0], send[0]);
+
+  // Cancelation is routed to the progress thread as well.
+  auto cancelReq =
+    ep->tagRecv(recv.data(), recv.size() * sizeof(int), ucxx::Tag{1}, ucxx::TagMaskFull);
+  cancelReq->cancel();
+  ASSERT_TRUE(
+    loopWithTimeout(std::chrono::seconds(10), [&cancelReq]() { return cancelReq->isCompleted(); }));
+  ASSERT_EQ(cancelReq->getStatus(), UCS_ERR_CANCELED);
+
+  worker->stopProgressThread();
+  ASSERT_FALSE(worker->requiresSerializedAccess());
+}
+
+TEST_F(WorkerTest, ProgressThreadCudaDevice)
+{
+  struct StartState {
+    std::atomic<bool> started{false};
+    int device{-1};
+  } state;
+
+  _worker->setProgressThreadCudaDevice(0);
+  _worker->setProgressThreadStartCallback(
+    [](void* arg) {
+      auto state    = static_cast<StartState*>(arg);
+      state->device = ucxx::utils::getCudaCurrentDevice();
+      state->started.store(true, std::memory_order_release);
+    },
+    &state);
+  _worker->startProgressThread(true);
+  ASSERT_TRUE(loopWithTimeout(std::chrono::seconds(10), [&state]() {
+    return state.started.load(std::memory_order_acquire);
+  }));
+  _worker->stopProgressThread();
+
+  // The CUDA context is current before the user callback executes.
+  if (_context->hasCudaSupport() && ucxx::utils::setCudaPrimaryContext(0)) {
+    ASSERT_EQ(state.device, 0);
+  }
+}
+
+TEST_F(WorkerTest, CompletionQueue)
+{
+  ASSERT_EQ(_worker->getCompletionQueue(), nullptr);
+  ASSERT_THROW(_worker->getFuture(), std::runtime_error);
+
+  _worker = _context->createWorker(false, true);
+
+  auto completionQueue = _worker->getCompletionQueue();
+  ASSERT_NE(completionQueue, nullptr);
+
+  auto ep = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  std::vector<int> send(3, 123);
+  std::vector<int> recv(3);
+
+  // Completions are not retained until harvesting is enabled
+  ASSERT_FALSE(completionQueue->isHarvestEnabled());
+  auto unharvested = std::vector<std::shared_ptr<ucxx::Request>>{
+    ep->tagSend(&send[0], sizeof(int), ucxx::Tag{0}, true),
+    ep->tagRecv(&recv[0], sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull, true)};
+  waitRequests(_worker, unharvested, [this]() { _worker->progress(); });
+  for (const auto& request : unharvested)
+    ASSERT_EQ(static_cast<ucxx::CompletionFuture*>(request->getFuture())->wait(), UCS_OK);
+  ASSERT_EQ(completionQueue->size(), 0u);
+  recv[0] = 0;
+
+  completionQueue->setHarvestEnabled(true);
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  for (size_t i = 0; i < send.size(); ++i) {
+    requests.push_back(ep->tagSend(&send[i], sizeof(int), ucxx::Tag{i}, true));
+    requests.push_back(ep->tagRecv(&recv[i], sizeof(int), ucxx::Tag{i}, ucxx::TagMaskFull, true));
+  }
+  waitRequests(_worker, requests, [this]() { _worker->progress(); });
+  ASSERT_EQ(recv, send);
+
+  // Each request completion is enqueued exactly once, and harvested in batches
+  ASSERT_EQ(completionQueue->size(), requests.size());
+  ASSERT_EQ(_worker->waitRequestNotifier(1000000 /* 1ms */), ucxx::RequestNotifierWaitState::Ready);
+
+  std::vector<ucxx::Completion> completions;
+  ASSERT_EQ(completionQueue->poll(completions, 2), 2u);
+  ASSERT_EQ(completionQueue->waitFor(completions, std::chrono::milliseconds(1)),
+            requests.size() - 2);
+  ASSERT_EQ(completionQueue->size(), 0u);
+  ASSERT_EQ(completions.size(), requests.size());
+
+  for (const auto& request : requests) {
+    auto future = static_cast<ucxx::CompletionFuture*>(request->getFuture());
+    ASSERT_TRUE(future->isReady());
+    ASSERT_EQ(future->wait(), UCS_OK);
+
+    size_t matches = 0;
+    for (const auto& completion : completions)
+      if (completion.future->getHandle() == request->getFuture()) {
+        ASSERT_EQ(completion.status, UCS_OK);
+        ++matches;
+      }
+    ASSERT_EQ(matches, 1u);
+  }
+
+  // Nothing left to harvest, waiting times out until the queue is stopped
+  ASSERT_EQ(completionQueue->waitFor(completions, std::chrono::milliseconds(1)), 0u);
+  ASSERT_EQ(_worker->waitRequestNotifier(1000000 /* 1ms */),
+            ucxx::RequestNotifierWaitState::Timeout);
+  _worker->stopRequestNotifierThread();
+  ASSERT_EQ(_worker->waitRequestNotifier(0), ucxx::RequestNotifierWaitState::Shutdown);
+}
+
+TEST_P(WorkerProgressTest, Statistics)
+{
+  auto ep = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  std::vector<int> send{123};
+  std::vector<int> recv(1);
+
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  requests.push_back(ep->tagSend(send.data(), send.size() * sizeof(int), ucxx::Tag{0}));
+  requests.push_back(
+    ep->tagRecv(recv.data(), recv.size() * sizeof(int), ucxx::Tag{0}, ucxx::TagMaskFull));
+  waitRequests(_worker, requests, _progressWorker);
+
+  auto endpointStatistics = ep->getStatistics();
+  ASSERT_EQ(endpointStatistics.requestsSubmitted, 2u);
+  ASSERT_EQ(endpointStatistics.requestsCompleted, 2u);
+  ASSERT_EQ(endpointStatistics.requestsFailed, 0u);
+  ASSERT_EQ(endpointStatistics.requestsCanceled, 0u);
+
+  auto workerStatistics = _worker->getStatistics();
+  ASSERT_GE(workerStatistics.requestsSubmitted, endpointStatistics.requestsSubmitted);
+  ASSERT_GE(workerStatistics.requestsCompleted, endpointStatistics.requestsCompleted);
+  ASSERT_GT(workerStatistics.progressCalls, 0u);
+  ASSERT_GT(workerStatistics.progressCallsWithProgress, 0u);
+  ASSERT_LE(workerStatistics.progressCallsWithProgress, workerStatistics.progressCalls);
+  if (_enableDelayedSubmission) {
+    ASSERT_EQ(workerStatistics.requestsDelayed, 2u);
+    ASSERT_GE(workerStatistics.delayedSubmissionCallbacks, 2u);
+  } else {
+    ASSERT_EQ(workerStatistics.requestsDelayed, 0u);
+  }
+}
+
+TEST_P(WorkerProgressTest, ProgressBudget)
+{
+  ucxx::ProgressBudget budget{};
+  budget.maxProgressCalls = 1;
+  budget.maxSubmissions   = 2;
+  budget.maxCompletions   = 1;
+  _worker->setProgressBudget(budget);
+
+  auto currentBudget = _worker->getProgressBudget();
+  ASSERT_EQ(currentBudget.maxProgressCalls, 1u);
+  ASSERT_EQ(currentBudget.maxSubmissions, 2u);
+  ASSERT_EQ(currentBudget.maxCompletions, 1u);
+  ASSERT_EQ(_worker->getDelayedSubmissionBudget(), 2u);
+
+  auto ep = _worker->createEndpointFromWorkerAddress(_worker->getAddress());
+
+  const size_t numMessages = 16;
+  std::vector<int> send(numMessages);
+  std::iota(send.begin(), send.end(), 0);
+  std::vector<int> recv(numMessages, -1);
+
+  // Submissions exceeding the budget are resumed by the following iterations.
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  for (size_t i = 0; i < numMessages; ++i) {
+    requests.push_back(ep->tagSend(&send[i], sizeof(int), ucxx::Tag{i}));
+    requests.push_back(ep->tagRecv(&recv[i], sizeof(int), ucxx::Tag{i}, ucxx::TagMaskFull));
+  }
+  waitRequests(_worker, requests, _progressWorker);
+
+  ASSERT_EQ(recv, send);
+}
+
 TEST_P(WorkerProgressTest, ProgressTagMulti)
 {
   if (_progressMode == ProgressMode::Wait) {
@@ -227,11 +1166,14 @@ INSTANTIATE_TEST_SUITE_P(ProgressModes,
                                         ProgressMode::Blocking,
                                         ProgressMode::Wait,
                                         ProgressMode::ThreadPolling,
-                                        ProgressMode::ThreadBlocking)));
+                                        ProgressMode::ThreadBlocking,
+                                        ProgressMode::ThreadHybrid)));
 
-INSTANTIATE_TEST_SUITE_P(
-  DelayedSubmission,
-  WorkerProgressTest,
-  Combine(Values(true), Values(ProgressMode::ThreadPolling, ProgressMode::ThreadBlocking)));
+INSTANTIATE_TEST_SUITE_P(DelayedSubmission,
+                         WorkerProgressTest,
+                         Combine(Values(true),
+                                 Values(ProgressMode::ThreadPolling,
+                                        ProgressMode::ThreadBlocking,
+                                        ProgressMode::ThreadHybrid)));
 
 }  // namespace
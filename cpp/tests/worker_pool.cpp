@@ -0,0 +1,97 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ucxx/api.h>
+
+#include "include/utils.h"
+
+namespace {
+
+class WorkerPoolTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<ucxx::Context> _context{
+    ucxx::createContext({}, ucxx::Context::defaultFeatureFlags, true)};
+};
+
+TEST_F(WorkerPoolTest, InvalidArguments)
+{
+  auto context = ucxx::createContext({}, ucxx::Context::defaultFeatureFlags);
+  EXPECT_THROW(context->createWorkerPool(2)->startProgressThreads(), std::invalid_argument);
+  auto pool = context->createWorkerPool(1);
+  pool->startProgressThreads();
+  pool->stopProgressThreads();
+
+  EXPECT_THROW(_context->createWorkerPool(0), std::invalid_argument);
+  EXPECT_THROW(ucxx::createWorkerPool(
+                 nullptr, 1, ucxx::WorkerPoolPlacement::RoundRobin, false, false, nullptr),
+               std::invalid_argument);
+}
+
+TEST_F(WorkerPoolTest, RoundRobinPlacement)
+{
+  auto pool = _context->createWorkerPool(2);
+  ASSERT_EQ(pool->size(), 2u);
+  ASSERT_NE(pool->getWorker(0), pool->getWorker(1));
+  EXPECT_THROW(pool->getWorker(2), std::out_of_range);
+
+  auto remote = _context->createWorker();
+  auto ep0    = pool->createEndpointFromWorkerAddress(remote->getAddress());
+  auto ep1    = pool->createEndpointFromWorkerAddress(remote->getAddress());
+  auto ep2    = pool->createEndpointFromWorkerAddress(remote->getAddress());
+
+  ASSERT_EQ(ep0->getWorker(), pool->getWorker(0));
+  ASSERT_EQ(ep1->getWorker(), pool->getWorker(1));
+  ASSERT_EQ(ep2->getWorker(), pool->getWorker(0));
+  ASSERT_EQ(pool->getEndpointCounts(), (std::vector<size_t>{2, 1}));
+}
+
+TEST_F(WorkerPoolTest, LeastEndpointsPlacement)
+{
+  auto pool   = _context->createWorkerPool(2, ucxx::WorkerPoolPlacement::LeastEndpoints);
+  auto remote = _context->createWorker();
+
+  auto ep0 = pool->createEndpointFromWorkerAddress(remote->getAddress());
+  auto ep1 = pool->createEndpointFromWorkerAddress(remote->getAddress());
+  ASSERT_NE(ep0->getWorker(), ep1->getWorker());
+
+  // Released endpoints no longer count towards the load of their worker
+  auto worker0 = ep0->getWorker();
+  ep0.reset();
+  auto ep2 = pool->createEndpointFromWorkerAddress(remote->getAddress());
+  ASSERT_EQ(ep2->getWorker(), worker0);
+}
+
+TEST_F(WorkerPoolTest, Transfer)
+{
+  auto pool   = _context->createWorkerPool(2);
+  auto remote = _context->createWorker();
+
+  std::vector<std::shared_ptr<ucxx::Endpoint>> endpoints;
+  for (size_t i = 0; i < pool->size(); ++i)
+    endpoints.push_back(pool->createEndpointFromWorkerAddress(remote->getAddress()));
+
+  pool->startProgressThreads();
+
+  std::vector<int> send{1, 2};
+  std::vector<int> recv(send.size());
+  std::vector<std::shared_ptr<ucxx::Request>> requests;
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    requests.push_back(endpoints[i]->tagSend(&send[i], sizeof(int), ucxx::Tag{i}));
+    requests.push_back(remote->tagRecv(&recv[i], sizeof(int), ucxx::Tag{i}, ucxx::TagMaskFull));
+  }
+
+  auto progressRemote = getProgressFunction(remote, ProgressMode::Polling);
+  waitRequests(remote, requests, progressRemote);
+  ASSERT_EQ(recv, send);
+
+  pool->stopProgressThreads();
+}
+
+}  // namespace
@@ -165,6 +165,82 @@ async def test_ping_pong_data(ucxx_loop):
     await serv_com.close()
 
 
+@pytest.mark.parametrize("multi_buffer", [False, True])
+@pytest.mark.parametrize("pack_threshold", [0, 1024])
+@gen_test()
+async def test_ping_pong_mixed_frames(ucxx_loop, multi_buffer, pack_threshold):
+    np = pytest.importorskip("numpy")
+
+    small = np.arange(16, dtype=np.uint8)
+    large = np.arange(2**16, dtype=np.uint8)
+
+    # Initialize first, otherwise the patched settings are overwritten by the config
+    distributed_ucxx.ucxx.init_once()
+    with patch.multiple(
+        distributed_ucxx.ucxx,
+        multi_buffer=multi_buffer,
+        multi_buffer_pack_threshold=pack_threshold,
+    ):
+        com, serv_com = await get_comm_pair()
+        msg = {"op": "ping", "small": to_serialize(small), "large": to_serialize(large)}
+        await com.write(msg)
+        result = await serv_com.read()
+        np.testing.assert_array_equal(result.pop("small"), small)
+        np.testing.assert_array_equal(result.pop("large"), large)
+        result["op"] = "pong"
+
+        await serv_com.write(result)
+
+        result = await com.read()
+        assert result == {"op": "pong"}
+
+        await com.close()
+        await serv_com.close()
+
+
+@gen_test()
+async def test_endpoint_pool(ucxx_loop):
+    distributed_ucxx.ucxx.init_once()
+    pool = distributed_ucxx.ucxx.EndpointPool(idle_timeout=0.1)
+    q = asyncio.queues.Queue()
+
+    async def handle_comm(comm):
+        await q.put(comm)
+
+    with patch.object(distributed_ucxx.ucxx, "endpoint_pool", pool):
+        listener = listen(f"ucxx://{HOST}", handle_comm)
+        async with listener:
+            comms = [await connect(listener.contact_address) for _ in range(3)]
+            serv_comms = [await q.get() for _ in range(3)]
+
+            # All comms are multiplexed over a single endpoint
+            assert len(pool) == 1
+            assert len({c._ep_handle for c in comms}) == 1
+            assert len({c._ep_handle for c in serv_comms}) == 1
+
+            for i, serv_com in enumerate(serv_comms):
+                await serv_com.write({"op": "ping", "i": i})
+            # Messages are received by the matching comm only
+            for i, (com, serv_com) in enumerate(zip(comms, serv_comms)):
+                result = await com.read()
+                assert result == {"op": "ping", "i": i}
+                await com.write(result)
+                assert await serv_com.read() == result
+
+            # Closing a comm doesn't affect others sharing its endpoint
+            await comms[0].close()
+            await serv_comms[0].close()
+            await comms[1].write({"op": "pong"})
+            assert await serv_comms[1].read() == {"op": "pong"}
+
+            for com in comms[1:] + serv_comms[1:]:
+                await com.close()
+
+            # The idle endpoint is evicted after the timeout
+            while len(pool) > 0:
+                await asyncio.sleep(0.05)
+
+
 @gen_test()
 async def test_ucxx_deserialize(ucxx_loop):
     # Note we see this error on some systems with this test:
@@ -7,6 +7,7 @@ See :ref:`communications` for more.
 """
 from __future__ import annotations
 
+import asyncio
 import functools
 import logging
 import os
@@ -17,7 +18,7 @@ from typing import TYPE_CHECKING, Any
 from unittest.mock import patch
 
 import dask
-from dask.utils import parse_bytes
+from dask.utils import parse_bytes, parse_timedelta
 from distributed.comm.addressing import parse_host_port, unparse_host_port
 from distributed.comm.core import Comm, CommClosedError, Connector, Listener
 from distributed.comm.registry import Backend
@@ -48,6 +49,8 @@ device_array = None
 pre_existing_cuda_context = False
 cuda_context_created = False
 multi_buffer = None
+multi_buffer_pack_threshold = 0
+endpoint_pool = None
 
 
 _warning_suffix = (
@@ -94,7 +97,8 @@ def init_once():
     global ucxx, device_array
     global ucx_create_endpoint, ucx_create_listener
     global pre_existing_cuda_context, cuda_context_created
-    global multi_buffer
+    global multi_buffer, multi_buffer_pack_threshold
+    global endpoint_pool
 
     if ucxx is not None:
         return
@@ -147,7 +151,25 @@ def init_once():
                 cuda_visible_device, cuda_context_created.device_info, os.getpid()
             )
 
-    multi_buffer = dask.config.get("distributed.comm.ucx.multi-buffer", default=False)
+    # Multi-buffer transfers send all frames of a message with a single request,
+    # with no separate size exchange, and host frames of up to the pack threshold
+    # coalesced into a single network message together with the shutdown flag,
+    # making small control messages cost only a header and one data message.
+    multi_buffer = dask.config.get("distributed.comm.ucx.multi-buffer", default=True)
+    multi_buffer_pack_threshold = parse_bytes(
+        dask.config.get(
+            "distributed.comm.ucx.multi-buffer-pack-threshold", default="64KiB"
+        )
+    )
+
+    if dask.config.get("distributed.comm.ucx.endpoint-pool", default=False) is True:
+        endpoint_pool = EndpointPool(
+            parse_timedelta(
+                dask.config.get(
+                    "distributed.comm.ucx.endpoint-pool-idle-timeout", default="30s"
+                )
+            )
+        )
 
     import ucxx as _ucxx
 
@@ -211,6 +233,128 @@ def _close_comm(ref):
         comm._closed = True
 
 
+class PooledEndpoint:
+    """UCXX endpoint shared by multiple Dask comms connected to the same peer
+
+    Each comm multiplexed over the endpoint communicates on its own tag namespace,
+    or channel. The connecting side opens a new channel by sending its identifier
+    to the listener over the endpoint's default tag, the listener then creates a
+    new comm for that channel, see `UCXXListener`. Channel identifiers are never
+    reused during the lifetime of the endpoint, so that no message sent on a closed
+    channel is ever received by a newer comm.
+
+    Parameters
+    ----------
+    ep : ucxx.Endpoint
+        The UCXX endpoint to share.
+    address : str
+        The address of the remote peer, without the `ucxx://` prefix.
+    pool : EndpointPool or None
+        The pool owning the endpoint on the connecting side, responsible for
+        evicting it if it becomes idle. `None` on the listening side, where the
+        lifetime of the endpoint is controlled by the remote peer.
+    """
+
+    def __init__(self, ep, address, pool=None):
+        self.ep = ep
+        self.address = address
+        self._pool = pool
+        self._comms = {}
+        self._next_channel = 1
+        self._idle_handle = None
+        self.ep.set_close_callback(self._on_close)
+
+    @property
+    def closed(self):
+        return self.ep is None or self.ep.closed
+
+    async def open_channel(self):
+        """Open a new channel, informing the listener"""
+        self._cancel_idle_eviction()
+        channel = self._next_channel
+        self._next_channel += 1
+        await self.ep.send(struct.pack("Q", channel))
+        return channel
+
+    def attach(self, channel, comm):
+        """Register `comm` as the user of `channel`"""
+        self._cancel_idle_eviction()
+        self._comms[channel] = weakref.ref(comm)
+
+    def release(self, channel):
+        """Release `channel`, scheduling the endpoint eviction if it becomes idle"""
+        self._comms.pop(channel, None)
+        if self._pool is not None and len(self._comms) == 0 and not self.closed:
+            self._idle_handle = asyncio.get_event_loop().call_later(
+                self._pool.idle_timeout, self._evict_idle
+            )
+
+    def abort(self):
+        """Abort the endpoint, closing all comms multiplexed over it"""
+        self._cancel_idle_eviction()
+        if self._pool is not None:
+            self._pool.evict(self)
+        if self.ep is not None:
+            self.ep.abort()
+            self.ep = None
+        self._on_close()
+
+    def _cancel_idle_eviction(self):
+        if self._idle_handle is not None:
+            self._idle_handle.cancel()
+            self._idle_handle = None
+
+    def _evict_idle(self):
+        self._idle_handle = None
+        if len(self._comms) == 0:
+            logger.debug("Evicting idle endpoint to %s", self.address)
+            self.abort()
+
+    def _on_close(self):
+        for ref in tuple(self._comms.values()):
+            comm = ref()
+            if comm is not None:
+                comm._closed = True
+        self._comms.clear()
+        if self._pool is not None:
+            self._pool.evict(self)
+
+
+class EndpointPool:
+    """Cache of endpoints to reuse across comms connecting to the same peer
+
+    Parameters
+    ----------
+    idle_timeout : float
+        Time in seconds after which an endpoint with no comms is closed.
+    """
+
+    def __init__(self, idle_timeout):
+        self.idle_timeout = idle_timeout
+        self._endpoints = {}
+        self._locks = {}
+
+    async def get(self, address):
+        """Get the pooled endpoint to `address`, creating it if none is alive"""
+        lock = self._locks.setdefault(address, asyncio.Lock())
+        async with lock:
+            pooled = self._endpoints.get(address)
+            if pooled is None or pooled.closed:
+                ip, port = parse_host_port(address)
+                ep = await ucxx.create_endpoint(ip, port)
+                pooled = PooledEndpoint(ep, address, pool=self)
+                self._endpoints[address] = pooled
+            return pooled
+
+    def evict(self, pooled):
+        """Remove `pooled` from the pool, if still cached"""
+        if self._endpoints.get(pooled.address) is pooled:
+            del self._endpoints[pooled.address]
+
+    def __len__(self):
+        return len(self._endpoints)
+
+
 class UCXX(Comm):
     """Comm object using UCXX.
 
@@ -228,6 +372,11 @@ class UCXX(Comm):
         Enable close callback, required so that the endpoint object is notified
         when the remote endpoint closed or errored. This is required for proper
         lifetime handling of UCX-Py, but should be disabled for UCXX.
+    pooled : PooledEndpoint, optional
+        The pooled endpoint `ep` belongs to, if shared with other comms. The
+        close callback is then handled by the pooled endpoint.
+    channel : int, optional
+        The channel of `pooled` this comm communicates on.
 
     Notes
     -----
@@ -258,9 +407,13 @@ class UCXX(Comm):
         peer_addr: str,
         deserialize: bool = True,
         enable_close_callback: bool = True,
+        pooled: PooledEndpoint | None = None,
+        channel: int | None = None,
     ):
         super().__init__(deserialize=deserialize)
         self._ep = ep
+        self._pooled = pooled
+        self._channel = channel
         self._ep_handle = int(self._ep._ep.handle)
         if local_addr:
             assert local_addr.startswith("ucxx")
@@ -269,7 +422,11 @@ class UCXX(Comm):
         self._peer_addr = peer_addr
         self.comm_flag = None
 
-        if enable_close_callback:
+        if pooled is not None:
+            pooled.attach(channel, self)
+            self._closed = False
+            self._has_close_callback = True
+        elif enable_close_callback:
             # When the UCX endpoint closes or errors the registered callback
             # is called.
             ref = weakref.ref(self)
@@ -321,7 +478,11 @@ class UCXX(Comm):
                     synchronize_stream(0)
 
                 close = [struct.pack("?", False)]
-                await self.ep.send_multi(close + frames)
+                await self.ep.send_multi(
+                    close + frames,
+                    tag=self._channel,
+                    pack_threshold=multi_buffer_pack_threshold,
+                )
             else:
                 nframes = len(frames)
                 cuda_frames = tuple(
@@ -338,11 +499,14 @@ class UCXX(Comm):
                 # Send meta data
 
                 # Send close flag and number of frames (_Bool, int64)
-                await self.ep.send(struct.pack("?Q", False, nframes))
+                await self.ep.send(
+                    struct.pack("?Q", False, nframes), tag=self._channel
+                )
                 # Send which frames are CUDA (bool) and
                 # how large each frame is (uint64)
                 await self.ep.send(
-                    struct.pack(nframes * "?" + nframes * "Q", *cuda_frames, *sizes)
+                    struct.pack(nframes * "?" + nframes * "Q", *cuda_frames, *sizes),
+                    tag=self._channel,
                 )
 
                 # Send frames
@@ -356,7 +520,7 @@ class UCXX(Comm):
                     synchronize_stream(0)
 
                 for each_frame in send_frames:
-                    await self.ep.send(each_frame)
+                    await self.ep.send(each_frame, tag=self._channel)
             return sum(sizes)
         except ucxx.exceptions.UCXError:
             self.abort()
@@ -371,7 +535,9 @@ class UCXX(Comm):
             try:
                 # TODO: We don't know if any frames are CUDA, investigate whether
                 # we need to synchronize device here.
-                frames = await self.ep.recv_multi()
+                # Packed frames are unpacked by `recv_multi()`, the reader needs no
+                # knowledge of the writer's pack threshold.
+                frames = await self.ep.recv_multi(tag=self._channel)
                 shutdown_frame = frames[0]
                 frames = frames[1:]
 
@@ -393,7 +559,7 @@ class UCXX(Comm):
 
                 # Recv close flag and number of frames (_Bool, int64)
                 msg = host_array(struct.calcsize("?Q"))
-                await self.ep.recv(msg)
+                await self.ep.recv(msg, tag=self._channel)
                 (shutdown, nframes) = struct.unpack("?Q", msg)
 
                 if shutdown:  # The writer is closing the connection
@@ -403,7 +569,7 @@ class UCXX(Comm):
                 # how large each frame is (uint64)
                 header_fmt = nframes * "?" + nframes * "Q"
                 header = host_array(struct.calcsize(header_fmt))
-                await self.ep.recv(header)
+                await self.ep.recv(header, tag=self._channel)
                 header = struct.unpack(header_fmt, header)
                 cuda_frames, sizes = header[:nframes], header[nframes:]
             except BaseException as e:
@@ -436,7 +602,7 @@ class UCXX(Comm):
 
                 try:
                     for each_frame in recv_frames:
-                        await self.ep.recv(each_frame)
+                        await self.ep.recv(each_frame, tag=self._channel)
                 except BaseException as e:
                     # In addition to UCX exceptions, may be CancelledError or another
                     # "low-level" exception. The only safe thing to do is to abort.
@@ -463,9 +629,13 @@ class UCXX(Comm):
         if self._ep is not None:
             try:
                 if multi_buffer is True:
-                    await self.ep.send_multi([struct.pack("?", True)])
+                    await self.ep.send_multi(
+                        [struct.pack("?", True)],
+                        tag=self._channel,
+                        pack_threshold=multi_buffer_pack_threshold,
+                    )
                 else:
-                    await self.ep.send(struct.pack("?Q", True, 0))
+                    await self.ep.send(struct.pack("?Q", True, 0), tag=self._channel)
             except (
                 ucxx.exceptions.UCXError,
                 ucxx.exceptions.UCXCloseError,
@@ -476,13 +646,22 @@ class UCXX(Comm):
                 # UCX will sometimes raise a `Input/output` error,
                 # which we can ignore.
                 pass
-            self.abort()
+            if self._pooled is not None:
+                # Keep the endpoint open for other comms
+                self._pooled.release(self._channel)
+            else:
+                self.abort()
             self._ep = None
 
     def abort(self):
         self._closed = True
         if self._ep is not None:
-            self._ep.abort()
+            if self._pooled is not None:
+                # The state of the channel is unknown after a failure, it is only safe
+                # to abort the shared endpoint, closing all of its comms.
+                self._pooled.abort()
+            else:
+                self._ep.abort()
             self._ep = None
 
     def closed(self):
@@ -518,6 +697,17 @@ class UCXXConnector(Connector):
         init_once()
 
         try:
+            if endpoint_pool is not None:
+                pooled = await endpoint_pool.get(address)
+                channel = await pooled.open_channel()
+                return self.comm_class(
+                    pooled.ep,
+                    local_addr="",
+                    peer_addr=self.prefix + address,
+                    deserialize=deserialize,
+                    pooled=pooled,
+                    channel=channel,
+                )
             ep = await ucxx.create_endpoint(ip, port)
         except (
             ucxx.exceptions.UCXCloseError,
@@ -566,12 +756,14 @@ class UCXXListener(Listener):
         return f"{self.prefix}{self.ip}:{self.port}"
 
     async def start(self):
-        async def serve_forever(client_ep):
+        async def handle_comm(client_ep, pooled=None, channel=None):
             ucx = self.comm_class(
                 client_ep,
                 local_addr=self.address,
                 peer_addr=self.address,
                 deserialize=self.deserialize,
+                pooled=pooled,
+                channel=channel,
             )
             ucx.allow_offload = self.allow_offload
             try:
@@ -582,6 +774,31 @@ class UCXXListener(Listener):
             if self.comm_handler:
                 await self.comm_handler(ucx)
 
+        async def serve_forever(client_ep):
+            if endpoint_pool is None:
+                return await handle_comm(client_ep)
+
+            # The peer multiplexes comms over this endpoint, each announced by its
+            # channel until the peer closes the endpoint.
+            pooled = PooledEndpoint(client_ep, self.address)
+            comm_tasks = set()
+            while True:
+                msg = host_array(struct.calcsize("Q"))
+                try:
+                    await client_ep.recv(msg)
+                except (
+                    ucxx.exceptions.UCXError,
+                    ucxx.exceptions.UCXCloseError,
+                    ucxx.exceptions.UCXCanceledError,
+                    ucxx.exceptions.UCXConnectionResetError,
+                ):
+                    break
+                (channel,) = struct.unpack("Q", msg)
+                task = asyncio.ensure_future(handle_comm(client_ep, pooled, channel))
+                comm_tasks.add(task)
+                task.add_done_callback(comm_tasks.discard)
+            await asyncio.gather(*comm_tasks, return_exceptions=True)
+
         init_once()
         self.ucxx_server = ucxx.create_listener(serve_forever, port=self._input_port)
 
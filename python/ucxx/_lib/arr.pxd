@@ -3,6 +3,7 @@
 
 
 from libc.stdint cimport uintptr_t
+from libcpp.vector cimport vector
 
 
 cdef class Array:
@@ -22,3 +23,11 @@ cdef class Array:
     cpdef bint _f_contiguous(self)
     cpdef bint _contiguous(self)
     cpdef Py_ssize_t _nbytes(self)
+
+
+cdef int frames_to_vectors(
+    object frames,
+    vector[void*]& ptrs,
+    vector[size_t]& sizes,
+    vector[int]& is_cuda,
+) except -1
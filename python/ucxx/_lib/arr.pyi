@@ -1,7 +1,7 @@
 # SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
 # SPDX-License-Identifier: BSD-3-Clause
 
-from typing import Tuple
+from typing import Sequence, Tuple
 
 class Array:
     def __init__(self, obj: object): ...
@@ -17,3 +17,7 @@ class Array:
     def shape(self) -> Tuple[int]: ...
     @property
     def strides(self) -> Tuple[int]: ...
+
+def frames_info(
+    frames: Sequence[object],
+) -> Tuple[Tuple[int, ...], Tuple[int, ...], Tuple[bool, ...]]: ...
@@ -3,7 +3,12 @@
 
 
 from cpython.array cimport array, newarrayobject
-from cpython.buffer cimport PyBuffer_IsContiguous
+from cpython.buffer cimport (
+    PyBUF_ANY_CONTIGUOUS,
+    PyBuffer_IsContiguous,
+    PyBuffer_Release,
+    PyObject_GetBuffer,
+)
 from cpython.memoryview cimport (
     PyMemoryView_FromObject,
     PyMemoryView_GET_BUFFER,
@@ -20,6 +25,7 @@ from cython cimport (
 )
 from libc.stdint cimport uintptr_t
 from libc.string cimport memcpy
+from libcpp.vector cimport vector
 
 try:
     from numpy import dtype as numpy_dtype
@@ -295,3 +301,115 @@ cdef inline Py_ssize_t _nbytes(Py_ssize_t itemsize,
     for i in range(ndim):
         nbytes *= shape_mv[i]
     return nbytes
+
+
+cdef int _append_cuda_frame(
+    object obj,
+    dict iface,
+    vector[void*]& ptrs,
+    vector[size_t]& sizes,
+    vector[int]& is_cuda,
+) except -1:
+    cdef Array arr
+    cdef Py_ssize_t nbytes
+    cdef str typestr
+
+    if iface.get("strides") is not None or iface.get("mask") is not None:
+        # Uncommon case, let `Array` validate strides and reject masks
+        arr = Array(obj)
+        if not arr._contiguous():
+            raise ValueError("Non-contiguous frames are not supported")
+        ptrs.push_back(<void*>arr.ptr)
+        sizes.push_back(arr._nbytes())
+        is_cuda.push_back(True)
+        return 0
+
+    typestr = iface["typestr"]
+    try:
+        nbytes = itemsize_mapping[typestr]
+    except KeyError:
+        nbytes = Array(obj).itemsize
+    for extent in iface["shape"]:
+        nbytes *= <Py_ssize_t>extent
+
+    ptrs.push_back(<void*><uintptr_t>iface["data"][0])
+    sizes.push_back(nbytes)
+    is_cuda.push_back(True)
+    return 0
+
+
+cdef int frames_to_vectors(
+    object frames,
+    vector[void*]& ptrs,
+    vector[size_t]& sizes,
+    vector[int]& is_cuda,
+) except -1:
+    """Fill pointer, size and CUDA vectors describing a sequence of frames
+
+    Bulk alternative to wrapping each frame in an `Array`, avoiding the construction of
+    intermediate objects, shapes and strides. Frames may be `Array` objects or any
+    contiguous object exposing the buffer protocol or `__cuda_array_interface__`.
+    """
+    cdef Py_buffer pybuf
+    cdef Array arr
+    cdef dict iface
+    cdef Py_ssize_t n = len(frames)
+
+    ptrs.reserve(ptrs.size() + n)
+    sizes.reserve(sizes.size() + n)
+    is_cuda.reserve(is_cuda.size() + n)
+
+    for obj in frames:
+        if type(obj) is Array:
+            arr = <Array>obj
+            if not arr._contiguous():
+                raise ValueError("Non-contiguous frames are not supported")
+            ptrs.push_back(<void*>arr.ptr)
+            sizes.push_back(arr._nbytes())
+            is_cuda.push_back(arr.cuda)
+            continue
+
+        # Check the instance like `Array` does, the interface may be set per instance,
+        # e.g., by `_CudaBufferSlice`, or raise `AttributeError` for host instances.
+        iface = getattr(obj, "__cuda_array_interface__", None)
+        if iface is not None:
+            _append_cuda_frame(obj, iface, ptrs, sizes, is_cuda)
+            continue
+
+        try:
+            PyObject_GetBuffer(obj, &pybuf, PyBUF_ANY_CONTIGUOUS)
+        except BufferError as e:
+            raise ValueError(f"Non-contiguous frames are not supported: {e}")
+        ptrs.push_back(pybuf.buf)
+        sizes.push_back(<size_t>pybuf.len)
+        is_cuda.push_back(False)
+        PyBuffer_Release(&pybuf)
+
+    return 0
+
+
+def frames_info(frames):
+    """Describe a sequence of frames by their pointers, sizes and CUDA flags
+
+    Parameters
+    ----------
+    frames: list or tuple
+        `Array` objects or contiguous objects exposing the buffer protocol or
+        `__cuda_array_interface__`.
+
+    Returns
+    -------
+    A tuple of three tuples, containing the pointer, size in bytes, and whether the
+    frame is a CUDA buffer, for each frame.
+    """
+    cdef vector[void*] ptrs
+    cdef vector[size_t] sizes
+    cdef vector[int] is_cuda
+    cdef size_t i
+
+    frames_to_vectors(frames, ptrs, sizes, is_cuda)
+    return (
+        tuple([<uintptr_t>ptrs[i] for i in range(ptrs.size())]),
+        tuple([sizes[i] for i in range(sizes.size())]),
+        tuple([<bint>is_cuda[i] for i in range(is_cuda.size())]),
+    )
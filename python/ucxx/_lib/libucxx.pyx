@@ -6,13 +6,16 @@ import asyncio
 import enum
 import functools
 import logging
+import pickle
 import warnings
 import weakref
 
 from cpython.buffer cimport PyBUF_FORMAT, PyBUF_ND, PyBUF_WRITABLE
+from cpython.bytes cimport PyBytes_FromStringAndSize
 from cpython.ref cimport PyObject
 from cython.operator cimport dereference as deref
-from libc.stdint cimport uintptr_t
+from libc.stdint cimport SIZE_MAX, uintptr_t
+from libc.string cimport memcpy
 from libcpp cimport nullptr
 from libcpp.functional cimport function
 from libcpp.memory cimport (
@@ -30,7 +33,7 @@ import numpy as np
 
 from rmm._lib.device_buffer cimport DeviceBuffer
 
-from .arr cimport Array
+from .arr cimport Array, frames_to_vectors
 from .ucxx_api cimport *
 
 include "tag.pyx"
@@ -54,13 +57,76 @@ def _get_rmm_buffer(uintptr_t recv_buffer_ptr):
     return DeviceBuffer.c_from_unique_ptr(move(rmm_buffer.release()))
 
 
-def _get_host_buffer(uintptr_t recv_buffer_ptr):
-    cdef HostBuffer* host_buffer = <HostBuffer*>recv_buffer_ptr
+cdef class _HostBufferOwner:
+    """Owner of a received `HostBuffer` exposing it through the buffer protocol
+
+    Buffers mapped with huge pages or bound to a NUMA node cannot be freed by NumPy, thus
+    NumPy arrays view them through this object, which keeps the `HostBuffer` alive until
+    no views remain.
+    """
+    cdef shared_ptr[Buffer] _buffer
+    cdef Py_ssize_t _length
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags) -> None:
+        buffer.buf = (<HostBuffer*>self._buffer.get()).data()
+        buffer.len = self._length
+        buffer.obj = self
+        buffer.readonly = False
+        buffer.itemsize = 1
+        if bool(flags & PyBUF_FORMAT):
+            buffer.format = b"B"
+        else:
+            buffer.format = NULL
+        buffer.ndim = 1
+        if bool(flags & PyBUF_ND):
+            buffer.shape = &buffer.len
+        else:
+            buffer.shape = NULL
+        buffer.strides = NULL
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+
+    def __releasebuffer__(self, Py_buffer *buffer) -> None:
+        pass
+
+
+cdef _get_host_buffer(shared_ptr[Buffer] buf):
+    cdef HostBuffer* host_buffer = <HostBuffer*>buf.get()
     cdef size_t size = host_buffer.getSize()
-    return ptr_to_ndarray(host_buffer.release(), size)
+    cdef _HostBufferOwner owner
+    if not host_buffer.isMapped():
+        return ptr_to_ndarray(host_buffer.release(), size)
+
+    owner = _HostBufferOwner.__new__(_HostBufferOwner)
+    owner._buffer = buf
+    owner._length = size
+    return np.frombuffer(owner, dtype=np.uint8)
+
+
+def _get_am_data_buffer(uintptr_t recv_buffer_ptr):
+    # The data is owned by UCX and returned to it when the buffer is destroyed, thus it
+    # cannot be released to NumPy and is copied instead.
+    cdef AmDataBuffer* am_data_buffer = <AmDataBuffer*>recv_buffer_ptr
+    cdef size_t size = am_data_buffer.getSize()
+    cdef np.ndarray[np.uint8_t, ndim=1, mode="c"] arr = np.empty(size, dtype=np.uint8)
+    if size > 0:
+        memcpy(<void*>arr.data, am_data_buffer.data(), size)
+    return arr
 
 
-cdef shared_ptr[Buffer] _rmm_am_allocator(size_t length):
+def _get_pinned_host_buffer(uintptr_t recv_buffer_ptr):
+    # The pinned memory is allocated with `cudaHostAlloc` and must be freed with
+    # `cudaFreeHost`, thus it cannot be released to NumPy and is copied instead.
+    cdef PinnedHostBuffer* pinned_buffer = <PinnedHostBuffer*>recv_buffer_ptr
+    cdef size_t size = pinned_buffer.getSize()
+    cdef np.ndarray[np.uint8_t, ndim=1, mode="c"] arr = np.empty(size, dtype=np.uint8)
+    if size > 0:
+        memcpy(<void*>arr.data, pinned_buffer.data(), size)
+    return arr
+
+
+cdef shared_ptr[Buffer] _rmm_am_allocator(size_t length) noexcept nogil:
+    # Called by the worker progress thread, which does not hold the GIL
     cdef shared_ptr[RMMBuffer] rmm_buffer = make_shared[RMMBuffer](length)
     return dynamic_pointer_cast[Buffer, RMMBuffer](rmm_buffer)
 
@@ -195,6 +261,16 @@ def _create_exceptions():
     UCXMsgTruncated = UCXMessageTruncatedError
 
 
+cdef object _status_exception(ucs_status_t status, string message):
+    """Create the exception for an error status.
+
+    Create the same exception as translating the C++ exception for ``status``, used with
+    the non-throwing API variants so that routine failures, such as canceled or
+    truncated receives, don't pay for throwing and translating C++ exceptions.
+    """
+    return (<object>get_python_exception_from_ucs_status(status))(message.decode())
+
+
 ###############################################################################
 #                                   Types                                     #
 ###############################################################################
@@ -209,6 +285,47 @@ class Feature(enum.Enum):
     AM = UCP_FEATURE_AM
 
 
+class AtomicOperation(enum.Enum):
+    ADD = UCP_ATOMIC_OP_ADD
+    SWAP = UCP_ATOMIC_OP_SWAP
+    CSWAP = UCP_ATOMIC_OP_CSWAP
+    AND = UCP_ATOMIC_OP_AND
+    OR = UCP_ATOMIC_OP_OR
+    XOR = UCP_ATOMIC_OP_XOR
+
+
+class PythonSendProtocol(enum.Enum):
+    Auto = SendProtocol.Auto
+    Eager = SendProtocol.Eager
+    Rendezvous = SendProtocol.Rendezvous
+
+
+class PythonSubmissionPriority(enum.Enum):
+    High = SubmissionPriority.High
+    Normal = SubmissionPriority.Normal
+    Bulk = SubmissionPriority.Bulk
+
+
+class PythonCompressionCodec(enum.Enum):
+    Disabled = CompressionCodec.CompressionCodecNone
+    LZ4 = CompressionCodec.LZ4
+    Zstd = CompressionCodec.Zstd
+
+
+def is_compression_codec_available(codec) -> bool:
+    """Whether UCXX was built with support for the ``PythonCompressionCodec``."""
+    return isCompressionCodecAvailable(
+        <CompressionCodec>PythonCompressionCodec(codec).value
+    )
+
+
+class PythonHugePages(enum.Enum):
+    Disabled = HugePages.Disabled
+    Transparent = HugePages.Transparent
+    Size2MB = HugePages.Size2MB
+    Size1GB = HugePages.Size1GB
+
+
 class PythonRequestNotifierWaitState(enum.Enum):
     Ready = RequestNotifierWaitState.Ready
     Timeout = RequestNotifierWaitState.Timeout
@@ -237,7 +354,11 @@ cdef class UCXConfig():
 
     @property
     def config(self) -> dict:
-        cdef ConfigMap config_map = self._config.get().get()
+        cdef ConfigMap config_map
+
+        with nogil:
+            config_map = self._config.get().get()
+
         return {
             item.first.decode("utf-8"): item.second.decode("utf-8")
             for item in config_map
@@ -262,6 +383,9 @@ cdef class UCXContext():
         UCX options such as "MEMTYPE_CACHE=n" and "SEG_SIZE=3M"
     feature_flags: Iterable[Feature]
         Tuple of UCX feature flags
+    mt_workers_shared: bool
+        Whether multiple workers created from the context may be progressed
+        concurrently by different threads, e.g., each by its own progress thread.
     """
     cdef:
         shared_ptr[Context] _context
@@ -275,8 +399,10 @@ cdef class UCXContext():
             Feature.WAKEUP,
             Feature.STREAM,
             Feature.AM,
-            Feature.RMA
-        )
+            Feature.RMA,
+            Feature.AMO64,
+        ),
+        bint mt_workers_shared=False,
     ) -> None:
         cdef ConfigMap cpp_config_in, cpp_config_out
         cdef dict context_config
@@ -291,7 +417,9 @@ cdef class UCXContext():
         )
 
         with nogil:
-            self._context = createContext(cpp_config_in, feature_flags_uint)
+            self._context = createContext(
+                cpp_config_in, feature_flags_uint, mt_workers_shared
+            )
             cpp_config_out = self._context.get().getConfig()
 
         context_config = cpp_config_out
@@ -314,11 +442,30 @@ cdef class UCXContext():
 
     @property
     def feature_flags(self) -> int:
-        return int(self._context.get().getFeatureFlags())
+        cdef uint64_t feature_flags
+
+        with nogil:
+            feature_flags = self._context.get().getFeatureFlags()
+
+        return int(feature_flags)
 
     @property
     def cuda_support(self) -> bool:
-        return bool(self._context.get().hasCudaSupport())
+        cdef bint cuda_support
+
+        with nogil:
+            cuda_support = self._context.get().hasCudaSupport()
+
+        return cuda_support
+
+    @property
+    def mt_workers_shared(self) -> bool:
+        cdef bint mt_workers_shared
+
+        with nogil:
+            mt_workers_shared = self._context.get().isMtWorkersSharedEnabled()
+
+        return mt_workers_shared
 
     @property
     def handle(self) -> int:
@@ -349,13 +496,184 @@ cdef class UCXContext():
         )
         return self.config
 
+    def create_memory_handle(self, Array arr) -> UCXMemoryHandle:
+        """Register the memory of an array with the context
+
+        Register the memory of `arr` with the context, returning a memory handle that
+        can be passed to transfer operations involving that memory to skip looking up
+        its registration on every transfer. Useful for buffers that are reused across
+        many transfers, such as staging buffers.
+
+        Parameters
+        ----------
+        arr: Array
+            Array whose memory to register, must remain alive while the memory handle
+            is in use, a reference to it is kept by the memory handle.
+        """
+        return UCXMemoryHandle.create_from_array(self, arr)
+
+    def intern_address(self, buffer) -> UCXAddress:
+        """Get an interned address of a remote worker
+
+        Get the address of the remote worker serialized in `buffer`, like
+        `UCXAddress.create_from_buffer()`, but returning the same `UCXAddress`
+        object while it is alive for all calls with the same address. Useful for
+        applications that repeatedly receive addresses of the same workers, for
+        example to reconnect to them.
+
+        Parameters
+        ----------
+        buffer: buffer-like object
+            Object exposing the buffer protocol with the contents of the address,
+            such as the result of pickling or `bytes()` of a `UCXAddress`.
+        """
+        cdef UCXAddress address = UCXAddress.__new__(UCXAddress)
+        cdef string address_str = _address_string_from_buffer(buffer)
+
+        with nogil:
+            address._address = self._context.get().internAddress(address_str)
+            address._handle = address._address.get().getHandle()
+            address._length = address._address.get().getLength()
+
+        return address
+
+
+cdef class UCXMemoryHandle():
+    """Python representation of memory registered with `ucp_mem_map`
+
+    Should be created via `UCXContext.create_memory_handle()`.
+    """
+    cdef:
+        shared_ptr[MemoryHandle] _memory_handle
+        object _array
+
+    def __init__(self) -> None:
+        raise TypeError("UCXMemoryHandle cannot be instantiated directly.")
+
+    def __dealloc__(self) -> None:
+        with nogil:
+            self._memory_handle.reset()
+
+    @classmethod
+    def create_from_array(cls, UCXContext context, Array arr) -> UCXMemoryHandle:
+        cdef UCXMemoryHandle memory_handle = UCXMemoryHandle.__new__(UCXMemoryHandle)
+        cdef void* buf = <void*>arr.ptr
+        cdef size_t nbytes = arr.nbytes
+        cdef bint cuda_array = arr.cuda
+
+        if not arr.c_contiguous:
+            raise ValueError("Array must be C-contiguous to be registered")
+
+        memory_handle._array = arr
+
+        with nogil:
+            memory_handle._memory_handle = context._context.get().createMemoryHandle(
+                nbytes,
+                buf,
+                UCS_MEMORY_TYPE_CUDA if cuda_array else UCS_MEMORY_TYPE_HOST,
+            )
+
+        return memory_handle
+
+    @property
+    def handle(self) -> int:
+        cdef ucp_mem_h handle
+
+        with nogil:
+            handle = self._memory_handle.get().getHandle()
+
+        return int(<uintptr_t>handle)
+
+    @property
+    def base_address(self) -> int:
+        cdef void* base_address
+
+        with nogil:
+            base_address = self._memory_handle.get().getBaseAddress()
+
+        return int(<uintptr_t>base_address)
+
+    @property
+    def size(self) -> int:
+        cdef size_t size
+
+        with nogil:
+            size = self._memory_handle.get().getSize()
+
+        return int(size)
+
+    def create_remote_key(self) -> UCXRemoteKey:
+        """Pack the remote key of the registered memory
+
+        The remote key may be serialized with `UCXRemoteKey.serialize()` and sent to
+        remote processes, which may then unpack it with
+        `UCXEndpoint.create_remote_key_from_serialized()` to access the memory with
+        `UCXEndpoint.mem_put()` and `UCXEndpoint.mem_get()`.
+        """
+        cdef UCXRemoteKey remote_key = UCXRemoteKey.__new__(UCXRemoteKey)
+
+        with nogil:
+            remote_key._remote_key = self._memory_handle.get().createRemoteKey()
+
+        return remote_key
+
+
+cdef class UCXRemoteKey():
+    """Python representation of the remote key of registered memory
+
+    Should be created via `UCXMemoryHandle.create_remote_key()` or
+    `UCXEndpoint.create_remote_key_from_serialized()`.
+    """
+    cdef:
+        shared_ptr[RemoteKey] _remote_key
+
+    def __init__(self) -> None:
+        raise TypeError("UCXRemoteKey cannot be instantiated directly.")
+
+    def __dealloc__(self) -> None:
+        with nogil:
+            self._remote_key.reset()
+
+    @property
+    def base_address(self) -> int:
+        cdef uint64_t base_address
+
+        with nogil:
+            base_address = self._remote_key.get().getBaseAddress()
+
+        return int(base_address)
+
+    @property
+    def size(self) -> int:
+        cdef size_t size
+
+        with nogil:
+            size = self._remote_key.get().getSize()
+
+        return int(size)
+
+    def serialize(self) -> bytes:
+        cdef string serialized
+
+        with nogil:
+            serialized = self._remote_key.get().serialize()
+
+        return bytes(serialized)
+
+
+cdef string _address_string_from_buffer(buffer):
+    buf = Array(buffer)
+    assert buf.c_contiguous
+
+    return string(<char*>buf.ptr, <size_t>buf.nbytes)
+
 
 cdef class UCXAddress():
     cdef:
         shared_ptr[Address] _address
         size_t _length
         ucp_address_t *_handle
-        string _string
+        object _hash
 
     def __init__(self) -> None:
         raise TypeError("UCXListener cannot be instantiated directly.")
@@ -373,33 +691,36 @@ cdef class UCXAddress():
             address._address = worker._worker.get().getAddress()
             address._handle = address._address.get().getHandle()
             address._length = address._address.get().getLength()
-            address._string = address._address.get().getString()
 
         return address
 
     @classmethod
     def create_from_string(cls, string address_str) -> UCXAddress:
         cdef UCXAddress address = UCXAddress.__new__(UCXAddress)
-        cdef string cpp_address_str = address_str
 
         with nogil:
-            address._address = createAddressFromString(cpp_address_str)
+            address._address = createAddressFromString(move(address_str))
             address._handle = address._address.get().getHandle()
             address._length = address._address.get().getLength()
-            address._string = address._address.get().getString()
 
         return address
 
     @classmethod
-    def create_from_buffer(cls, bytes buffer) -> UCXAddress:
-        cdef string address_str
+    def create_from_buffer(cls, buffer) -> UCXAddress:
+        """Create an address from any object exposing the buffer protocol
 
-        buf = Array(buffer)
-        assert buf.c_contiguous
+        Copies the contents of `buffer`, which may be for example `bytes`, a
+        `memoryview` or a `pickle.PickleBuffer`, exactly once.
+        """
+        cdef UCXAddress address = UCXAddress.__new__(UCXAddress)
+        cdef string address_str = _address_string_from_buffer(buffer)
 
-        address_str = string(<char*>buf.ptr, <size_t>buf.nbytes)
+        with nogil:
+            address._address = createAddressFromString(move(address_str))
+            address._handle = address._address.get().getHandle()
+            address._length = address._address.get().getLength()
 
-        return UCXAddress.create_from_string(address_str)
+        return address
 
     # For old UCX-Py API compatibility
     @classmethod
@@ -423,7 +744,7 @@ cdef class UCXAddress():
 
     @property
     def string(self) -> bytes:
-        return bytes(self._string)
+        return PyBytes_FromStringAndSize(<char*>self._handle, self._length)
 
     def __getbuffer__(self, Py_buffer *buffer, int flags) -> None:
         if bool(flags & PyBUF_WRITABLE):
@@ -449,11 +770,18 @@ cdef class UCXAddress():
     def __releasebuffer__(self, Py_buffer *buffer) -> None:
         pass
 
-    def __reduce__(self) -> tuple:
+    def __reduce_ex__(self, protocol) -> tuple:
+        # Pickle protocol 5 serializes a view of the address without copying it first,
+        # and out-of-band if a `buffer_callback` is used.
+        if protocol >= 5:
+            return (UCXAddress.create_from_buffer, (pickle.PickleBuffer(self),))
         return (UCXAddress.create_from_buffer, (self.string,))
 
     def __hash__(self) -> int:
-        return hash(bytes(self.string))
+        if self._hash is None:
+            # Equal to hashing `self.string`, without copying the address
+            self._hash = hash(memoryview(self))
+        return self._hash
 
 
 cdef void _generic_callback(void *args) with gil:
@@ -548,6 +876,52 @@ cdef class UCXWorker():
     def enable_delayed_submission(self) -> bool:
         return self._enable_delayed_submission
 
+    @property
+    def delayed_submission_budget(self) -> int:
+        """Maximum delayed submissions of lower priority per progress iteration.
+
+        The maximum number of ``Normal`` and ``Bulk`` priority delayed request
+        submissions per iteration of the progress thread, ``High`` priority requests
+        are always submitted in the next iteration. ``0`` (default) for no limit.
+        """
+        return self._worker.get().getDelayedSubmissionBudget()
+
+    @delayed_submission_budget.setter
+    def delayed_submission_budget(self, size_t budget) -> None:
+        self._worker.get().setDelayedSubmissionBudget(budget)
+
+    def set_progress_budget(
+        self,
+        size_t max_progress_calls=0,
+        size_t max_submissions=0,
+        size_t max_completions=0,
+    ) -> None:
+        """Set the bounds on the work performed by each progress iteration.
+
+        Bound the work performed by each iteration of the progress loop, keeping the
+        latency of each iteration bounded under heavy load. Work left over when the
+        budget is exhausted is resumed by the next iteration, ``0`` leaves the
+        respective kind of work unbounded.
+
+        Parameters
+        ----------
+        max_progress_calls: int
+            Maximum calls to ``ucp_worker_progress()`` per iteration.
+        max_submissions: int
+            Maximum ``Normal`` and ``Bulk`` priority delayed request submissions per
+            iteration, same as ``delayed_submission_budget``.
+        max_completions: int
+            Stop progressing once at least this many requests completed within an
+            iteration.
+        """
+        cdef ProgressBudget budget
+        budget.maxProgressCalls = max_progress_calls
+        budget.maxSubmissions = max_submissions
+        budget.maxCompletions = max_completions
+
+        with nogil:
+            self._worker.get().setProgressBudget(budget)
+
     @property
     def enable_python_future(self) -> bool:
         return self._enable_python_future
@@ -582,6 +956,23 @@ cdef class UCXWorker():
         with nogil:
             self._worker.get().initBlockingProgressMode()
 
+    def arm(self) -> bool:
+        cdef bint armed
+
+        with nogil:
+            armed = self._worker.get().arm()
+
+        return armed
+
+    @property
+    def epoll_file_descriptor(self) -> int:
+        cdef int epoll_file_descriptor
+
+        with nogil:
+            epoll_file_descriptor = self._worker.get().getEpollFileDescriptor()
+
+        return epoll_file_descriptor
+
     def progress(self) -> None:
         with nogil:
             self._worker.get().progress()
@@ -603,15 +994,284 @@ cdef class UCXWorker():
     def start_progress_thread(
         self,
         bint polling_mode=False,
-        int epoll_timeout=-1
+        int epoll_timeout=-1,
+        uint64_t spin_period_ns=0,
+        cpu_affinity=None,
     ) -> None:
+        """Start the worker progress thread.
+
+        Parameters
+        ----------
+        polling_mode: bool
+            Use polling mode if ``True``, or blocking mode if ``False``.
+        epoll_timeout: int
+            Timeout in ms when waiting for worker event, or -1 to block indefinitely.
+        spin_period_ns: int
+            Period in nanoseconds to spin after the last activity before blocking.
+        cpu_affinity: iterable of int or "auto", optional
+            CPUs to pin the progress thread to. If ``"auto"``, pin to the CPUs local to
+            the network devices in ``UCX_NET_DEVICES``. If ``None`` (default), the thread
+            is not pinned.
+        """
         cdef int ucxx_epoll_timeout = epoll_timeout
+        cdef uint64_t ucxx_spin_period_ns = spin_period_ns
+        cdef vector[int] ucxx_cpu_affinity
+
+        if isinstance(cpu_affinity, str):
+            if cpu_affinity != "auto":
+                raise ValueError(
+                    f"Invalid cpu_affinity {cpu_affinity!r}, expected 'auto' or an "
+                    "iterable of CPU indices"
+                )
+            ucxx_cpu_affinity = self.network_devices_local_cpus
+        elif cpu_affinity is not None:
+            for cpu in cpu_affinity:
+                ucxx_cpu_affinity.push_back(cpu)
 
         with nogil:
             self._worker.get().startProgressThread(
-                polling_mode, epoll_timeout=ucxx_epoll_timeout
+                polling_mode,
+                ucxx_epoll_timeout,
+                ucxx_spin_period_ns,
+                ucxx_cpu_affinity,
             )
 
+    @property
+    def network_devices_local_cpus(self) -> list:
+        """CPUs local to the network devices in ``UCX_NET_DEVICES``."""
+        cdef vector[int] cpus
+
+        with nogil:
+            cpus = self._worker.get().getNetworkDevicesLocalCpus()
+
+        return cpus
+
+    @property
+    def progress_spin_hits(self) -> int:
+        cdef uint64_t spin_hits
+
+        with nogil:
+            spin_hits = self._worker.get().getProgressSpinHits()
+
+        return spin_hits
+
+    @property
+    def progress_sleeps(self) -> int:
+        cdef uint64_t sleeps
+
+        with nogil:
+            sleeps = self._worker.get().getProgressSleeps()
+
+        return sleeps
+
+    @property
+    def statistics(self) -> dict:
+        """Snapshot of the worker statistics.
+
+        Counters of the requests created by the worker and all its endpoints, of the
+        worker progress, of the delayed submissions processed and of the futures pool
+        refills, since the worker was created. Counters are monotonically increasing,
+        a rate of submitted requests consistently higher than the rate of completed,
+        failed and canceled requests indicates a growing backlog.
+        """
+        cdef WorkerStatistics statistics
+
+        with nogil:
+            statistics = self._worker.get().getStatistics()
+
+        return {
+            "requests_submitted": statistics.requestsSubmitted,
+            "requests_completed": statistics.requestsCompleted,
+            "requests_failed": statistics.requestsFailed,
+            "requests_canceled": statistics.requestsCanceled,
+            "requests_delayed": statistics.requestsDelayed,
+            "requests_timed_out": statistics.requestsTimedOut,
+            "progress_calls": statistics.progressCalls,
+            "progress_calls_with_progress": statistics.progressCallsWithProgress,
+            "progress_spin_hits": statistics.progressSpinHits,
+            "progress_sleeps": statistics.progressSleeps,
+            "progress_budget_exhausted": statistics.progressBudgetExhausted,
+            "delayed_submission_callbacks": statistics.delayedSubmissionCallbacks,
+            "delayed_submission_process_ns": statistics.delayedSubmissionProcessNs,
+            "futures_pool_refills": statistics.futuresPoolRefills,
+            "frames_compressed": statistics.framesCompressed,
+            "frames_not_compressed": statistics.framesNotCompressed,
+            "compression_input_bytes": statistics.compressionInputBytes,
+            "compression_output_bytes": statistics.compressionOutputBytes,
+            "compression_ns": statistics.compressionNs,
+            "frames_decompressed": statistics.framesDecompressed,
+            "decompression_ns": statistics.decompressionNs,
+        }
+
+    def set_request_tracing(self, uint64_t sample_rate, size_t capacity=1024) -> None:
+        """Trace the lifecycle of 1 in ``sample_rate`` requests.
+
+        Keep the traces of the ``capacity`` most recently completed sampled requests,
+        which may be exported with ``get_request_traces()``. A ``sample_rate`` of ``0``
+        disables tracing.
+        """
+        with nogil:
+            self._worker.get().setRequestTracing(sample_rate, capacity)
+
+    def start_traffic_capture(self, path: str) -> None:
+        """Capture the traffic of the worker to a binary trace at ``path``.
+
+        Record the type, size, tag, memory type, endpoint and inter-arrival time of every
+        operation of the worker and its endpoints, the trace can then be replayed across
+        processes with the ``ucxx_replay`` benchmark. Capture may also be started for
+        all workers by setting ``UCXX_TRAFFIC_CAPTURE`` to the trace path, where ``%p``
+        is replaced by the process ID and ``%w`` by the index of the worker within the
+        process, otherwise ``.<index>`` is appended for all workers but the first one.
+        """
+        cdef string cpp_path = path.encode("utf-8")
+        with nogil:
+            self._worker.get().startTrafficCapture(cpp_path)
+
+    def stop_traffic_capture(self) -> None:
+        """Stop capturing traffic, writing all buffered operations to the trace."""
+        with nogil:
+            self._worker.get().stopTrafficCapture()
+
+    @property
+    def traffic_capture_enabled(self) -> bool:
+        cdef bint enabled
+
+        with nogil:
+            enabled = self._worker.get().isTrafficCaptureEnabled()
+
+        return enabled
+
+    def start_completion_callback_threads(
+        self, size_t num_threads=1, size_t batch_size=64
+    ) -> None:
+        """Execute request completion callbacks on internal threads.
+
+        By default, completion callbacks execute when requests complete, usually on the
+        progress thread, where slow callbacks stall all communication on the worker.
+        Once started, completion callbacks are only enqueued by the completing thread and
+        executed in batches of at most ``batch_size`` by ``num_threads`` threads, with
+        more than one thread callbacks may execute out of completion order.
+        """
+        with nogil:
+            self._worker.get().startCompletionCallbackThreads(num_threads, batch_size)
+
+    def reset_completion_callback_executor(self) -> None:
+        """Execute request completion callbacks inline again.
+
+        Blocks until all completion callbacks enqueued before have executed.
+        """
+        with nogil:
+            self._worker.get().resetCompletionCallbackExecutor()
+
+    def set_compression(
+        self,
+        codec=PythonCompressionCodec.LZ4,
+        int level=1,
+        size_t min_frame_size=65536,
+        transports=("tcp",),
+        size_t num_threads=0,
+    ) -> None:
+        """Compress host frames of multi-buffer sends.
+
+        Host frames of at least ``min_frame_size`` bytes sent with ``send_multi`` by
+        endpoints using one of ``transports`` are compressed with ``codec`` before being
+        sent, an empty ``transports`` compresses frames on all endpoints. Receivers
+        decompress frames transparently but must have been built with the codec.
+
+        Parameters
+        ----------
+        codec: PythonCompressionCodec
+            Codec to compress frames with, ``Disabled`` to send frames verbatim.
+        level: int
+            Compression level of Zstandard or acceleration of LZ4.
+        min_frame_size: int
+            Smallest frame in bytes to compress.
+        transports: iterable of str
+            Names of the UCX transports to compress frames on, e.g. ``"tcp"``.
+        num_threads: int
+            Number of internal threads compressing and decompressing frames, ``0`` to
+            compress and decompress inline.
+        """
+        cdef CompressionConfig config
+        config.codec = <CompressionCodec>PythonCompressionCodec(codec).value
+        config.level = level
+        config.minFrameSize = min_frame_size
+        config.transports = [transport.encode() for transport in transports]
+
+        with nogil:
+            self._worker.get().setCompression(config, num_threads)
+
+    @property
+    def compact_headers_enabled(self) -> bool:
+        """Whether headers of multi-buffer sends are serialized compactly.
+
+        Headers of ``send_multi`` are serialized in a compact variable-length format
+        instead of the legacy fixed-size one. Receivers accept both formats, but peers
+        predating the compact format only parse the legacy one, thus it must only be
+        enabled when all peers support it. Disabled by default.
+        """
+        cdef bint enabled
+
+        with nogil:
+            enabled = self._worker.get().isCompactHeadersEnabled()
+
+        return enabled
+
+    @compact_headers_enabled.setter
+    def compact_headers_enabled(self, bint enabled) -> None:
+        with nogil:
+            self._worker.get().setCompactHeaders(enabled)
+
+    @property
+    def endpoint_cache_enabled(self) -> bool:
+        """Whether endpoints to remote workers are reused.
+
+        When enabled, ``UCXEndpoint.create_from_worker_address()`` returns a live
+        endpoint previously created to the same remote worker with the same error handling
+        mode, instead of creating a new one. The cache holds no references, endpoints are
+        still closed when the application releases them, and endpoints that error are
+        evicted. Disabled by default.
+        """
+        cdef bint enabled
+
+        with nogil:
+            enabled = self._worker.get().isEndpointCacheEnabled()
+
+        return enabled
+
+    @endpoint_cache_enabled.setter
+    def endpoint_cache_enabled(self, bint enabled) -> None:
+        with nogil:
+            self._worker.get().setEndpointCacheEnabled(enabled)
+
+    def get_request_traces(self, bint clear=False) -> list:
+        """Get the lifecycle traces of sampled requests.
+
+        Each trace is a dict with the operation name, the final status and the
+        ``created``, ``submitted`` (handed to UCX), ``completed`` (by UCX) and
+        ``notified`` (status set and future notified) timestamps in nanoseconds of
+        a monotonic clock, ``0`` if the request never reached that stage. Traces are
+        ordered from oldest to newest completion.
+        """
+        cdef vector[RequestTrace] traces
+        cdef RequestTrace trace
+        cdef list ret = []
+
+        with nogil:
+            traces = self._worker.get().getRequestTraces(clear)
+
+        for trace in traces:
+            ret.append({
+                "operation": trace.operationName.decode("utf-8"),
+                "status": ucs_status_string(trace.status).decode("utf-8"),
+                "created": trace.created,
+                "submitted": trace.submitted,
+                "completed": trace.completed,
+                "notified": trace.notified,
+            })
+
+        return ret
+
     def stop_progress_thread(self) -> None:
         with nogil:
             self._worker.get().stopProgressThread()
@@ -632,6 +1292,49 @@ cdef class UCXWorker():
 
         return num_canceled
 
+    def fence(self) -> None:
+        with nogil:
+            self._worker.get().fence()
+
+    def flush(self) -> UCXRequest:
+        cdef shared_ptr[Request] req
+
+        with nogil:
+            req = self._worker.get().flush(self._enable_python_future)
+
+        return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
+
+    def close_endpoints(self, endpoints) -> list:
+        """Close multiple endpoints without blocking.
+
+        Submit closing all ``endpoints`` together, returning one ``UCXRequest`` per
+        endpoint, each completing once its endpoint is closed, or ``None`` for endpoints
+        that are already closed.
+        Closing endpoints this way takes as long as closing the slowest of them, instead
+        of the sum of calling ``UCXEndpoint.close()`` on each.
+        """
+        cdef vector[shared_ptr[Endpoint]] cpp_endpoints
+        cdef vector[shared_ptr[Request]] reqs
+        cdef size_t i
+
+        for endpoint in endpoints:
+            cpp_endpoints.push_back((<UCXEndpoint?>endpoint)._endpoint)
+
+        with nogil:
+            reqs = self._worker.get().closeEndpoints(
+                cpp_endpoints, self._enable_python_future
+            )
+
+        ret = []
+        for i in range(reqs.size()):
+            if reqs[i] == nullptr:
+                ret.append(None)
+            else:
+                ret.append(
+                    UCXRequest(<uintptr_t><void*>&reqs[i], self._enable_python_future)
+                )
+        return ret
+
     def tag_probe(self, UCXXTag tag) -> bool:
         cdef bint tag_matched
         cdef Tag cpp_tag = <Tag><size_t>tag.value
@@ -641,6 +1344,82 @@ cdef class UCXWorker():
 
         return tag_matched
 
+    def register_am_handler(self, unsigned int am_id) -> None:
+        """Register an additional active message ID.
+
+        Register an additional active message ID with its own receive queues, messages
+        sent to it with ``UCXEndpoint.am_send(..., am_id=am_id)`` are received with
+        ``UCXEndpoint.am_recv(am_id=am_id)`` independently of other IDs.
+        """
+        cdef AmAllocatorType rmm_am_allocator
+
+        if not self._context_feature_flags & Feature.AM.value:
+            raise ValueError("UCXContext must be created with `Feature.AM`")
+
+        with nogil:
+            self._worker.get().registerAmHandler(am_id)
+            rmm_am_allocator = <AmAllocatorType>(&_rmm_am_allocator)
+            self._worker.get().registerAmAllocator(
+                UCS_MEMORY_TYPE_CUDA, rmm_am_allocator, am_id
+            )
+
+    def set_rmm_allocation_stream(self, uintptr_t stream) -> None:
+        """Allocate received CUDA buffers ordered on a CUDA stream.
+
+        By default, CUDA buffers allocated internally to receive multi-buffer frames and
+        active messages (default active message ID only) are allocated with RMM on the
+        default stream, serializing with work on the legacy default stream. Specify the
+        handle of a CUDA stream, for example ``cupy.cuda.Stream().ptr``, for those
+        allocations to be ordered on it instead, or ``0`` to restore the default stream.
+        """
+        cdef AmAllocatorType rmm_allocator
+
+        with nogil:
+            rmm_allocator = createRMMAllocator(
+                cuda_stream_view(<cudaStream_t><void*>stream)
+            )
+            self._worker.get().registerBufferAllocator(BufferType.RMM, rmm_allocator)
+            if self._context_feature_flags & UCP_FEATURE_AM:
+                self._worker.get().registerAmAllocator(
+                    UCS_MEMORY_TYPE_CUDA, rmm_allocator
+                )
+
+    def set_host_allocation(
+        self, huge_pages=PythonHugePages.Transparent, int numa_node=-1, bint prefault=False
+    ) -> None:
+        """Allocate received host buffers with huge pages and NUMA binding.
+
+        By default, host buffers allocated internally to receive multi-buffer frames and
+        active messages (default active message ID only) are allocated with ``malloc``.
+        Allocate them backed by ``huge_pages`` and bound to ``numa_node`` instead, or
+        ``-1`` for no binding, touching all pages when allocating if ``prefault``. Such
+        buffers cannot be freed by NumPy, thus are returned to Python as NumPy arrays
+        viewing them, which keep the buffers alive.
+
+        Parameters
+        ----------
+        huge_pages: PythonHugePages
+            The pages backing the buffers, explicit huge pages fall back to transparent
+            ones if none were reserved.
+        numa_node: int
+            The NUMA node to bind the buffers to, ``-1`` for no binding.
+        prefault: bool
+            Whether to fault all pages in when allocating the buffers.
+        """
+        cdef HostAllocationOptions options
+        cdef AmAllocatorType host_allocator
+        options.hugePages = <HugePages>PythonHugePages(huge_pages).value
+        options.numaNode = numa_node
+        options.prefault = prefault
+
+        with nogil:
+            host_allocator = createHostAllocator(options)
+            self._worker.get().registerBufferAllocator(BufferType.Host, host_allocator)
+            if self._context_feature_flags & UCP_FEATURE_AM:
+                self._worker.get().registerAmAllocator(
+                    UCS_MEMORY_TYPE_HOST, host_allocator
+                )
+
     def set_progress_thread_start_callback(
             self, cb_func, tuple cb_args=None, dict cb_kwargs=None
     ) -> None:
@@ -664,6 +1443,23 @@ cdef class UCXWorker():
             )
         del func_generic_callback
 
+    def set_progress_thread_cuda_device(self, int device=-1) -> None:
+        """Bind a CUDA device to progress threads started afterwards.
+
+        The primary CUDA context of ``device`` is made current on the progress
+        thread natively, without importing a CUDA Python library or acquiring
+        the GIL. Has no effect if the context has no CUDA support.
+
+        Parameters
+        ----------
+        device: int
+            The CUDA device ordinal, or ``-1`` for the device of the CUDA context
+            current on the thread starting the progress thread, falling back to
+            device ``0`` if none is current.
+        """
+        with nogil:
+            self._worker.get().setProgressThreadCudaDevice(device)
+
     def stop_request_notifier_thread(self) -> None:
         with nogil:
             self._worker.get().stopRequestNotifierThread()
@@ -689,6 +1485,16 @@ cdef class UCXWorker():
         with nogil:
             self._worker.get().populateFuturesPool()
 
+    def set_python_futures_pool_size(self, size_t size, size_t low_watermark) -> None:
+        """Configure the size of the Python futures pool.
+
+        The futures pool is refilled up to ``size`` futures whenever it drops under
+        ``low_watermark``, applications posting large bursts of requests should use a
+        size at least as large as the burst to prevent creating futures inline.
+        """
+        with nogil:
+            self._worker.get().setFuturesPoolSize(size, low_watermark)
+
     def is_delayed_submission_enabled(self) -> bool:
         warnings.warn(
             "UCXWorker.is_delayed_submission_enabled() is deprecated and will soon "
@@ -711,16 +1517,22 @@ cdef class UCXWorker():
         self,
         Array arr,
         UCXXTag tag,
-        UCXXTagMask tag_mask = UCXXTagMaskFull
+        UCXXTagMask tag_mask = UCXXTagMaskFull,
+        UCXMemoryHandle memory_handle = None,
     ) -> UCXRequest:
         cdef void* buf = <void*>arr.ptr
         cdef size_t nbytes = arr.nbytes
         cdef shared_ptr[Request] req
         cdef Tag cpp_tag = <Tag><size_t>tag.value
         cdef TagMask cpp_tag_mask = <TagMask><size_t>tag_mask.value
+        cdef RequestCallbackUserFunction callback_function
+        cdef RequestCallbackUserData callback_data
+        cdef shared_ptr[MemoryHandle] cpp_memory_handle
 
         if not self._context_feature_flags & Feature.TAG.value:
             raise ValueError("UCXContext must be created with `Feature.TAG`")
+        if memory_handle is not None:
+            cpp_memory_handle = memory_handle._memory_handle
 
         with nogil:
             req = self._worker.get().tagRecv(
@@ -728,12 +1540,62 @@ cdef class UCXWorker():
                 nbytes,
                 cpp_tag,
                 cpp_tag_mask,
-                self._enable_python_future
+                self._enable_python_future,
+                callback_function,
+                callback_data,
+                cpp_memory_handle,
             )
 
         return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
 
 
+cdef class _CompletedAwaitable:
+    """Stateless iterator returned by ``__await__`` of already completed requests.
+
+    Finishes on the first iteration without suspending, making it safe to share a single
+    instance among all requests.
+    """
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        raise StopIteration
+
+
+cdef _CompletedAwaitable _completed_awaitable = _CompletedAwaitable()
+
+
+cdef class _FutureAwaitable:
+    """Iterator returned by ``__await__`` of requests waiting on their Python future.
+
+    Delegates to the iterator of the future, discarding its result so that awaiting a
+    request always returns ``None``, as when the request had already completed.
+    """
+    cdef object _iterator
+
+    def __cinit__(self, object future):
+        self._iterator = future.__await__()
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        return self.send(None)
+
+    def send(self, value):
+        try:
+            return self._iterator.send(value)
+        except StopIteration:
+            raise StopIteration(None)
+
+    def throw(self, *args):
+        try:
+            return self._iterator.throw(*args)
+        except StopIteration:
+            raise StopIteration(None)
+
+
 cdef class UCXRequest():
     cdef:
         shared_ptr[Request] _request
@@ -795,7 +1657,29 @@ cdef class UCXRequest():
         elif bufType == BufferType.RMM:
             return _get_rmm_buffer(<uintptr_t><void*>buf.get())
         elif bufType == BufferType.Host:
-            return _get_host_buffer(<uintptr_t><void*>buf.get())
+            return _get_host_buffer(buf)
+        elif bufType == BufferType.AmData:
+            return _get_am_data_buffer(<uintptr_t><void*>buf.get())
+        elif bufType == BufferType.Pinned:
+            return _get_pinned_host_buffer(<uintptr_t><void*>buf.get())
+
+    @property
+    def recv_header(self) -> bytes:
+        cdef string header
+
+        with nogil:
+            header = self._request.get().getRecvHeader()
+
+        return header
+
+    @property
+    def atomic_result(self) -> int:
+        cdef uint64_t result
+
+        with nogil:
+            result = self._request.get().getAtomicResult()
+
+        return int(result)
 
     def is_completed(self) -> bool:
         warnings.warn(
@@ -815,9 +1699,37 @@ cdef class UCXRequest():
         )
         return self.status
 
-    def check_error(self) -> None:
+    def check_error(self) -> None:
+        cdef ucs_status_t status
+        cdef string message
+
+        with nogil:
+            status = self._request.get().getError(&message)
+
+        if status != UCS_OK and status != UCS_INPROGRESS:
+            raise _status_exception(status, message)
+
+    def set_timeout(self, uint64_t timeout) -> None:
+        """Cancel the request if not completed within ``timeout`` nanoseconds.
+
+        The request then completes with ``UCXTimedOutError``. Deadlines are enforced by
+        the worker progress without creating additional tasks or timers.
+        """
+        with nogil:
+            self._request.get().setTimeout(timeout)
+
+    def set_completion_flag(self, uintptr_t flag, uint32_t value=1) -> None:
+        """Write the completion of the request to a 32-bit flag at address ``flag``.
+
+        Write ``value`` to the flag when the request completes successfully, or
+        ``value | 0x80000000`` if it fails, so that a CUDA kernel launched beforehand may
+        wait on it instead of waiting on the host. The flag must be in host-accessible
+        memory, preferably pinned host memory, e.g., allocated with
+        ``cupy.cuda.alloc_pinned_memory()``, and remain valid until the request
+        completed.
+        """
         with nogil:
-            self._request.get().checkError()
+            self._request.get().setCompletionFlag(<uint32_t*>flag, value)
 
     async def wait_yield(self) -> None:
         while True:
@@ -834,11 +1746,25 @@ cdef class UCXRequest():
         )
         return self.future
 
-    async def wait(self) -> None:
+    def __await__(self):
+        # Requests often complete immediately (e.g., small eager messages), in which case
+        # awaiting must not suspend, nor create a coroutine or touch the Python future.
+        # Awaiting always returns `None` and raises if the request failed.
+        if self.completed:
+            self.check_error()
+            return _completed_awaitable
         if self._enable_python_future:
-            await self.future
+            return _FutureAwaitable(self.future)
         else:
-            await self.wait_yield()
+            return self.wait_yield().__await__()
+
+    async def wait(self) -> None:
+        """Wait for the request to complete.
+
+        The request itself is awaitable, this coroutine is equivalent to awaiting the
+        request directly and is kept for compatibility, e.g., with `asyncio.wait_for()`.
+        """
+        await self
 
     def get_recv_buffer(self) -> None|np.ndarray|DeviceBuffer:
         warnings.warn(
@@ -889,7 +1815,11 @@ cdef class UCXBufferRequest:
         elif bufType == BufferType.RMM:
             return _get_rmm_buffer(<uintptr_t><void*>buf.get())
         elif bufType == BufferType.Host:
-            return _get_host_buffer(<uintptr_t><void*>buf.get())
+            return _get_host_buffer(buf)
+        elif bufType == BufferType.AmData:
+            return _get_am_data_buffer(<uintptr_t><void*>buf.get())
+        elif bufType == BufferType.Pinned:
+            return _get_pinned_host_buffer(<uintptr_t><void*>buf.get())
 
     def get_request(self) -> UCXRequest:
         warnings.warn(
@@ -963,8 +1893,12 @@ cdef class UCXBufferRequests:
 
     @property
     def all_completed(self) -> bool:
+        cdef bint is_filled
+
         if self._completed is False:
-            if self._ucxx_request_tag_multi.get()._isFilled is False:
+            with nogil:
+                is_filled = self._ucxx_request_tag_multi.get()._isFilled
+            if is_filled is False:
                 return False
 
             self._populate_requests()
@@ -1028,8 +1962,14 @@ cdef class UCXBufferRequests:
         return self.all_completed
 
     def check_error(self) -> None:
+        cdef ucs_status_t status
+        cdef string message
+
         with nogil:
-            self._ucxx_request_tag_multi.get().checkError()
+            status = self._ucxx_request_tag_multi.get().getError(&message)
+
+        if status != UCS_OK and status != UCS_INPROGRESS:
+            raise _status_exception(status, message)
 
     def get_status(self) -> ucs_status_t:
         warnings.warn(
@@ -1043,9 +1983,9 @@ cdef class UCXBufferRequests:
     async def wait_yield(self) -> None:
         while True:
             if self.completed:
-                for r in self._requests:
-                    r.check_error()
-                return
+                # `_requests` may not be populated yet, the multi-request status
+                # reflects errors of all its requests
+                return self.check_error()
             await asyncio.sleep(0)
 
     def get_future(self) -> object:
@@ -1192,6 +2132,68 @@ cdef class UCXEndpoint():
 
         return endpoint
 
+    @classmethod
+    def create_many(
+            cls,
+            UCXWorker worker,
+            list hosts,
+            bint endpoint_error_handling,
+            bint eager_wireup=False,
+    ) -> list:
+        """Create endpoints to multiple listeners at once.
+
+        Create one endpoint to each ``(ip_address, port)`` pair in ``hosts``. If the
+        worker is running a progress thread, all endpoints are created by it in a
+        single batch. If ``eager_wireup`` is ``True`` connection establishment of all
+        endpoints is started immediately rather than upon their first operation.
+        """
+        cdef vector[pair[string, uint16_t]] cpp_hosts
+        cdef vector[shared_ptr[Endpoint]] cpp_endpoints
+
+        for ip_address, port in hosts:
+            cpp_hosts.push_back(
+                pair[string, uint16_t](ip_address.encode("utf-8"), port)
+            )
+
+        with nogil:
+            cpp_endpoints = worker._worker.get().createEndpointsFromHostnames(
+                cpp_hosts, endpoint_error_handling, eager_wireup
+            )
+
+        return _wrap_endpoints(
+            worker._worker, worker.enable_python_future, cpp_endpoints
+        )
+
+    @classmethod
+    def create_many_from_worker_address(
+            cls,
+            UCXWorker worker,
+            list addresses,
+            bint endpoint_error_handling,
+            bint eager_wireup=False,
+    ) -> list:
+        """Create endpoints to multiple workers at once.
+
+        Create one endpoint to each ``UCXAddress`` in ``addresses``. If the worker is
+        running a progress thread, all endpoints are created by it in a single batch.
+        If ``eager_wireup`` is ``True`` connection establishment of all endpoints is
+        started immediately rather than upon their first operation.
+        """
+        cdef vector[shared_ptr[Address]] cpp_addresses
+        cdef vector[shared_ptr[Endpoint]] cpp_endpoints
+
+        for address in addresses:
+            cpp_addresses.push_back((<UCXAddress?>address)._address)
+
+        with nogil:
+            cpp_endpoints = worker._worker.get().createEndpointsFromWorkerAddresses(
+                cpp_addresses, endpoint_error_handling, eager_wireup
+            )
+
+        return _wrap_endpoints(
+            worker._worker, worker.enable_python_future, cpp_endpoints
+        )
+
     @property
     def handle(self) -> int:
         cdef ucp_ep_h handle
@@ -1219,6 +2221,25 @@ cdef class UCXEndpoint():
 
         return int(<uintptr_t>handle)
 
+    @property
+    def statistics(self) -> dict:
+        """Snapshot of the endpoint statistics.
+
+        Counters of the requests created by the endpoint since it was created, the
+        same requests are also accounted for in ``UCXWorker.statistics``.
+        """
+        cdef EndpointStatistics statistics
+
+        with nogil:
+            statistics = self._endpoint.get().getStatistics()
+
+        return {
+            "requests_submitted": statistics.requestsSubmitted,
+            "requests_completed": statistics.requestsCompleted,
+            "requests_failed": statistics.requestsFailed,
+            "requests_canceled": statistics.requestsCanceled,
+        }
+
     @property
     def ucxx_worker_ptr(self) -> int:
         cdef Worker* worker
@@ -1237,14 +2258,45 @@ cdef class UCXEndpoint():
 
         return alive
 
-    def close(self, uint64_t period=0, uint64_t max_attempts=1) -> None:
+    def close(
+        self, uint64_t period=0, uint64_t max_attempts=1, flush_timeout=None
+    ) -> None:
+        """Close the endpoint.
+
+        If ``flush_timeout`` is ``None`` (default) all inflight requests are canceled
+        and the endpoint is closed immediately. Otherwise, inflight send operations are
+        given up to ``flush_timeout`` nanoseconds to complete before the endpoint is
+        closed gracefully, after which the close falls back to canceling them.
+        """
         cdef uint64_t c_period = period
         cdef uint64_t c_max_attempts = max_attempts
+        cdef EndpointCloseMode c_mode = EndpointCloseMode.Force
+        cdef uint64_t c_flush_timeout = 0
+
+        if flush_timeout is not None:
+            c_mode = EndpointCloseMode.Flush
+            c_flush_timeout = flush_timeout
 
         with nogil:
-            self._endpoint.get().close(c_period, c_max_attempts)
+            self._endpoint.get().close(
+                c_period, c_max_attempts, c_mode, c_flush_timeout
+            )
+
+    def close_async(self) -> UCXRequest:
+        """Close the endpoint without blocking.
+
+        Submit closing the endpoint, canceling all its inflight requests, returning a
+        ``UCXRequest`` that completes once the endpoint is closed, after the close
+        callback, if any, has been called.
+        """
+        cdef shared_ptr[Request] req
+
+        with nogil:
+            req = self._endpoint.get().closeAsync(self._enable_python_future)
+
+        return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
 
-    def am_probe(self) -> bool:
+    def am_probe(self, unsigned int am_id=0) -> bool:
         cdef ucp_ep_h handle
         cdef shared_ptr[Worker] worker
         cdef bint ep_matched
@@ -1252,14 +2304,19 @@ cdef class UCXEndpoint():
         with nogil:
             handle = self._endpoint.get().getHandle()
             worker = self._endpoint.get().getWorker()
-            ep_matched = worker.get().amProbe(handle)
+            ep_matched = worker.get().amProbe(handle, am_id)
 
         return ep_matched
 
-    def am_send(self, Array arr) -> UCXRequest:
+    def am_send(
+        self, Array arr, bytes header=b"", unsigned int am_id=0
+    ) -> UCXRequest:
         cdef void* buf = <void*>arr.ptr
         cdef size_t nbytes = arr.nbytes
         cdef bint cuda_array = arr.cuda
+        cdef string cpp_header = header
+        cdef RequestCallbackUserFunction callback_function
+        cdef RequestCallbackUserData callback_data
         cdef shared_ptr[Request] req
 
         if not self._context_feature_flags & Feature.AM.value:
@@ -1270,19 +2327,147 @@ cdef class UCXEndpoint():
                 buf,
                 nbytes,
                 UCS_MEMORY_TYPE_CUDA if cuda_array else UCS_MEMORY_TYPE_HOST,
-                self._enable_python_future
+                self._enable_python_future,
+                callback_function,
+                callback_data,
+                cpp_header,
+                am_id,
             )
 
         return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
 
-    def am_recv(self) -> UCXRequest:
+    def am_recv(self, unsigned int am_id=0) -> UCXRequest:
+        cdef RequestCallbackUserFunction callback_function
+        cdef RequestCallbackUserData callback_data
         cdef shared_ptr[Request] req
 
         if not self._context_feature_flags & Feature.AM.value:
             raise ValueError("UCXContext must be created with `Feature.AM`")
 
         with nogil:
-            req = self._endpoint.get().amRecv(self._enable_python_future)
+            req = self._endpoint.get().amRecv(
+                self._enable_python_future, callback_function, callback_data, am_id
+            )
+
+        return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
+
+    def mem_atomic(
+        self,
+        opcode: AtomicOperation,
+        uint64_t value,
+        uint64_t remote_addr,
+        UCXRemoteKey remote_key,
+        bint fetch=False,
+        uint64_t compare=0,
+    ) -> UCXRequest:
+        """Execute an atomic operation on a 64-bit remote value
+
+        The original remote value is available via `UCXRequest.atomic_result` once the
+        request completes if `fetch=True`, or always for `AtomicOperation.SWAP` and
+        `AtomicOperation.CSWAP`. The `compare` value is only used by
+        `AtomicOperation.CSWAP`.
+        """
+        cdef ucp_atomic_op_t cpp_opcode = <ucp_atomic_op_t>opcode.value
+        cdef shared_ptr[Request] req
+
+        if not self._context_feature_flags & Feature.AMO64.value:
+            raise ValueError("UCXContext must be created with `Feature.AMO64`")
+
+        with nogil:
+            req = self._endpoint.get().memAtomic(
+                cpp_opcode,
+                value,
+                remote_addr,
+                remote_key._remote_key,
+                fetch,
+                compare,
+                self._enable_python_future,
+            )
+
+        return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
+
+    def flush(self) -> UCXRequest:
+        cdef shared_ptr[Request] req
+
+        with nogil:
+            req = self._endpoint.get().flush(self._enable_python_future)
+
+        return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
+
+    def create_remote_key_from_serialized(self, bytes serialized) -> UCXRemoteKey:
+        cdef UCXRemoteKey remote_key = UCXRemoteKey.__new__(UCXRemoteKey)
+        cdef string cpp_serialized = serialized
+
+        with nogil:
+            remote_key._remote_key = self._endpoint.get().createRemoteKeyFromSerialized(
+                cpp_serialized
+            )
+
+        return remote_key
+
+    def mem_put(
+        self,
+        Array arr,
+        uint64_t remote_addr,
+        UCXRemoteKey remote_key,
+        UCXMemoryHandle memory_handle=None,
+    ) -> UCXRequest:
+        cdef void* buf = <void*>arr.ptr
+        cdef size_t nbytes = arr.nbytes
+        cdef RequestCallbackUserFunction callback_function
+        cdef RequestCallbackUserData callback_data
+        cdef shared_ptr[MemoryHandle] cpp_memory_handle
+        cdef shared_ptr[Request] req
+
+        if not self._context_feature_flags & Feature.RMA.value:
+            raise ValueError("UCXContext must be created with `Feature.RMA`")
+        if memory_handle is not None:
+            cpp_memory_handle = memory_handle._memory_handle
+
+        with nogil:
+            req = self._endpoint.get().memPut(
+                buf,
+                nbytes,
+                remote_addr,
+                remote_key._remote_key,
+                self._enable_python_future,
+                callback_function,
+                callback_data,
+                cpp_memory_handle,
+            )
+
+        return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
+
+    def mem_get(
+        self,
+        Array arr,
+        uint64_t remote_addr,
+        UCXRemoteKey remote_key,
+        UCXMemoryHandle memory_handle=None,
+    ) -> UCXRequest:
+        cdef void* buf = <void*>arr.ptr
+        cdef size_t nbytes = arr.nbytes
+        cdef RequestCallbackUserFunction callback_function
+        cdef RequestCallbackUserData callback_data
+        cdef shared_ptr[MemoryHandle] cpp_memory_handle
+        cdef shared_ptr[Request] req
+
+        if not self._context_feature_flags & Feature.RMA.value:
+            raise ValueError("UCXContext must be created with `Feature.RMA`")
+        if memory_handle is not None:
+            cpp_memory_handle = memory_handle._memory_handle
+
+        with nogil:
+            req = self._endpoint.get().memGet(
+                buf,
+                nbytes,
+                remote_addr,
+                remote_key._remote_key,
+                self._enable_python_future,
+                callback_function,
+                callback_data,
+                cpp_memory_handle,
+            )
 
         return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
 
@@ -1310,6 +2495,28 @@ cdef class UCXEndpoint():
 
         return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
 
+    def stream_send_iov(self, tuple arrays) -> UCXRequest:
+        cdef vector[void*] v_buffer
+        cdef vector[size_t] v_size
+        cdef shared_ptr[Request] req
+
+        if not self._context_feature_flags & Feature.STREAM.value:
+            raise ValueError("UCXContext must be created with `Feature.STREAM`")
+        self._check_iov_arrays(arrays)
+
+        for arr in arrays:
+            v_buffer.push_back(<void*><uintptr_t>arr.ptr)
+            v_size.push_back(arr.nbytes)
+
+        with nogil:
+            req = self._endpoint.get().streamSendIov(
+                v_buffer,
+                v_size,
+                self._enable_python_future
+            )
+
+        return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
+
     def stream_recv(self, Array arr) -> UCXRequest:
         cdef void* buf = <void*>arr.ptr
         cdef size_t nbytes = arr.nbytes
@@ -1334,11 +2541,16 @@ cdef class UCXEndpoint():
 
         return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
 
-    def tag_send(self, Array arr, UCXXTag tag) -> UCXRequest:
+    def tag_send(
+        self, Array arr, UCXXTag tag, UCXMemoryHandle memory_handle=None
+    ) -> UCXRequest:
         cdef void* buf = <void*>arr.ptr
         cdef size_t nbytes = arr.nbytes
         cdef shared_ptr[Request] req
         cdef Tag cpp_tag = <Tag><size_t>tag.value
+        cdef RequestCallbackUserFunction callback_function
+        cdef RequestCallbackUserData callback_data
+        cdef shared_ptr[MemoryHandle] cpp_memory_handle
 
         if not self._context_feature_flags & Feature.TAG.value:
             raise ValueError("UCXContext must be created with `Feature.TAG`")
@@ -1349,13 +2561,18 @@ cdef class UCXEndpoint():
                 "`cuda` or `cuda_copy` are present in `UCX_TLS` or that it is using "
                 "the default `UCX_TLS=all`."
             )
+        if memory_handle is not None:
+            cpp_memory_handle = memory_handle._memory_handle
 
         with nogil:
             req = self._endpoint.get().tagSend(
                 buf,
                 nbytes,
                 cpp_tag,
-                self._enable_python_future
+                self._enable_python_future,
+                callback_function,
+                callback_data,
+                cpp_memory_handle,
             )
 
         return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
@@ -1364,13 +2581,17 @@ cdef class UCXEndpoint():
         self,
         Array arr,
         UCXXTag tag,
-        UCXXTagMask tag_mask=UCXXTagMaskFull
+        UCXXTagMask tag_mask=UCXXTagMaskFull,
+        UCXMemoryHandle memory_handle=None,
     ) -> UCXRequest:
         cdef void* buf = <void*>arr.ptr
         cdef size_t nbytes = arr.nbytes
         cdef shared_ptr[Request] req
         cdef Tag cpp_tag = <Tag><size_t>tag.value
         cdef TagMask cpp_tag_mask = <TagMask><size_t>tag_mask.value
+        cdef RequestCallbackUserFunction callback_function
+        cdef RequestCallbackUserData callback_data
+        cdef shared_ptr[MemoryHandle] cpp_memory_handle
 
         if not self._context_feature_flags & Feature.TAG.value:
             raise ValueError("UCXContext must be created with `Feature.TAG`")
@@ -1381,6 +2602,8 @@ cdef class UCXEndpoint():
                 "`cuda` or `cuda_copy` are present in `UCX_TLS` or that it is using "
                 "the default `UCX_TLS=all`."
             )
+        if memory_handle is not None:
+            cpp_memory_handle = memory_handle._memory_handle
 
         with nogil:
             req = self._endpoint.get().tagRecv(
@@ -1388,18 +2611,15 @@ cdef class UCXEndpoint():
                 nbytes,
                 cpp_tag,
                 cpp_tag_mask,
-                self._enable_python_future
+                self._enable_python_future,
+                callback_function,
+                callback_data,
+                cpp_memory_handle,
             )
 
         return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
 
-    def tag_send_multi(self, tuple arrays, UCXXTag tag) -> UCXBufferRequests:
-        cdef vector[void*] v_buffer
-        cdef vector[size_t] v_size
-        cdef vector[int] v_is_cuda
-        cdef shared_ptr[Request] ucxx_buffer_requests
-        cdef Tag cpp_tag = <Tag><size_t>tag.value
-
+    def _check_iov_arrays(self, tuple arrays):
         for arr in arrays:
             if not isinstance(arr, Array):
                 raise ValueError(
@@ -1413,10 +2633,87 @@ cdef class UCXEndpoint():
                     "using the default `UCX_TLS=all`."
                 )
 
+    def tag_send_iov(self, tuple arrays, UCXXTag tag) -> UCXRequest:
+        cdef vector[void*] v_buffer
+        cdef vector[size_t] v_size
+        cdef shared_ptr[Request] req
+        cdef Tag cpp_tag = <Tag><size_t>tag.value
+
+        if not self._context_feature_flags & Feature.TAG.value:
+            raise ValueError("UCXContext must be created with `Feature.TAG`")
+        self._check_iov_arrays(arrays)
+
+        for arr in arrays:
+            v_buffer.push_back(<void*><uintptr_t>arr.ptr)
+            v_size.push_back(arr.nbytes)
+
+        with nogil:
+            req = self._endpoint.get().tagSendIov(
+                v_buffer,
+                v_size,
+                cpp_tag,
+                self._enable_python_future,
+            )
+
+        return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
+
+    def tag_recv_iov(
+        self,
+        tuple arrays,
+        UCXXTag tag,
+        UCXXTagMask tag_mask=UCXXTagMaskFull,
+    ) -> UCXRequest:
+        cdef vector[void*] v_buffer
+        cdef vector[size_t] v_size
+        cdef shared_ptr[Request] req
+        cdef Tag cpp_tag = <Tag><size_t>tag.value
+        cdef TagMask cpp_tag_mask = <TagMask><size_t>tag_mask.value
+
+        if not self._context_feature_flags & Feature.TAG.value:
+            raise ValueError("UCXContext must be created with `Feature.TAG`")
+        self._check_iov_arrays(arrays)
+
         for arr in arrays:
             v_buffer.push_back(<void*><uintptr_t>arr.ptr)
             v_size.push_back(arr.nbytes)
-            v_is_cuda.push_back(arr.cuda)
+
+        with nogil:
+            req = self._endpoint.get().tagRecvIov(
+                v_buffer,
+                v_size,
+                cpp_tag,
+                cpp_tag_mask,
+                self._enable_python_future,
+            )
+
+        return UCXRequest(<uintptr_t><void*>&req, self._enable_python_future)
+
+    def tag_send_multi(
+        self, arrays, UCXXTag tag, size_t pack_threshold=0
+    ) -> UCXBufferRequests:
+        cdef vector[void*] v_buffer
+        cdef vector[size_t] v_size
+        cdef vector[int] v_is_cuda
+        cdef shared_ptr[Request] ucxx_buffer_requests
+        cdef Tag cpp_tag = <Tag><size_t>tag.value
+        cdef size_t i
+
+        if not isinstance(arrays, (list, tuple)):
+            raise ValueError("The `arrays` argument must be a `list` or `tuple`")
+
+        # Elements may be `Array` objects or contiguous objects exposing the buffer
+        # protocol or `__cuda_array_interface__`, converted in bulk.
+        frames_to_vectors(arrays, v_buffer, v_size, v_is_cuda)
+
+        if not self._cuda_support:
+            for i in range(v_is_cuda.size()):
+                if v_is_cuda[i]:
+                    raise ValueError(
+                        "UCX is not configured with CUDA support, please ensure that "
+                        "the available UCX on your environment is built against CUDA "
+                        "and that `cuda` or `cuda_copy` are present in `UCX_TLS` or "
+                        "that it is using the default `UCX_TLS=all`."
+                    )
 
         with nogil:
             ucxx_buffer_requests = self._endpoint.get().tagMultiSend(
@@ -1425,6 +2722,7 @@ cdef class UCXEndpoint():
                 v_is_cuda,
                 cpp_tag,
                 self._enable_python_future,
+                pack_threshold,
             )
 
         return UCXBufferRequests(
@@ -1459,8 +2757,14 @@ cdef class UCXEndpoint():
         return self.alive
 
     def raise_on_error(self) -> None:
+        cdef ucs_status_t status
+        cdef string message
+
         with nogil:
-            self._endpoint.get().raiseOnError()
+            status = self._endpoint.get().getError(&message)
+
+        if status != UCS_OK:
+            raise _status_exception(status, message)
 
     def set_close_callback(
             self,
@@ -1488,6 +2792,104 @@ cdef class UCXEndpoint():
             )
         del func_close_callback
 
+    def set_send_hints(
+        self,
+        am_protocol=PythonSendProtocol.Auto,
+        size_t am_rendezvous_threshold=0,
+        bint fast_completion=False,
+        bint multi_send=False,
+        submission_priority=PythonSubmissionPriority.Normal,
+    ) -> None:
+        """Set hints on how the endpoint sends messages.
+
+        Hints apply to all messages sent after this call, allowing endpoints used for
+        messages of very different sizes to be tuned individually rather than through
+        the thresholds of the context.
+
+        Parameters
+        ----------
+        am_protocol: PythonSendProtocol
+            Protocol to send active messages with, ``Auto`` (default) leaves the
+            choice to UCX.
+        am_rendezvous_threshold: int
+            With ``am_protocol=Auto``, send active messages of at least this size with
+            rendezvous and smaller ones eagerly, ``0`` (default) leaves the choice to UCX.
+        fast_completion: bool
+            Favor fast local completion over bandwidth, suitable for small
+            latency-sensitive messages.
+        multi_send: bool
+            Favor bandwidth of many concurrently inflight messages.
+        submission_priority: PythonSubmissionPriority
+            Priority class of delayed submission of all requests of the endpoint, only
+            has effect if the worker was created with delayed submission enabled.
+        """
+        cdef SendHints send_hints
+        send_hints.amProtocol = <SendProtocol>PythonSendProtocol(am_protocol).value
+        send_hints.amRendezvousThreshold = am_rendezvous_threshold
+        send_hints.fastCompletion = fast_completion
+        send_hints.multiSend = multi_send
+        send_hints.submissionPriority = <SubmissionPriority>(
+            PythonSubmissionPriority(submission_priority).value
+        )
+
+        with nogil:
+            self._endpoint.get().setSendHints(send_hints)
+
+    def set_tag_bases(self, UCXXTag send_tag_base, UCXXTag recv_tag_base) -> None:
+        """Set the base tags to derive send and receive tags from.
+
+        The base tags namespace the messages of this endpoint, the send base tag of
+        one end must be the receive base tag of the other.
+        """
+        cdef Tag cpp_send_tag_base = <Tag><size_t>send_tag_base.value
+        cdef Tag cpp_recv_tag_base = <Tag><size_t>recv_tag_base.value
+
+        self._endpoint.get().setTagBases(cpp_send_tag_base, cpp_recv_tag_base)
+
+    def derive_send_tag(self, tag) -> UCXXTag:
+        """Derive the tag to send a message with from a user tag.
+
+        Non-negative integers below ``2**64`` are used as-is, other hashable objects
+        by their hash. The tag matches the one derived by ``derive_recv_tag()`` from
+        the same user tag on the remote endpoint.
+        """
+        return UCXXTag(<uint64_t>self._endpoint.get().deriveSendTag(_user_tag_value(tag)))
+
+    def derive_recv_tag(self, tag) -> UCXXTag:
+        """Derive the tag to receive a message with from a user tag.
+
+        See ``derive_send_tag()``.
+        """
+        return UCXXTag(<uint64_t>self._endpoint.get().deriveRecvTag(_user_tag_value(tag)))
+
+
+cdef inline uint64_t _user_tag_value(object tag):
+    if type(tag) is int and 0 <= tag < 2 ** 64:
+        return tag
+    return hash(tag) & 0xFFFFFFFFFFFFFFFF
+
+
+cdef list _wrap_endpoints(
+    shared_ptr[Worker] worker,
+    bint enable_python_future,
+    vector[shared_ptr[Endpoint]]& endpoints,
+):
+    cdef shared_ptr[Context] ucxx_context
+    cdef UCXEndpoint endpoint
+    cdef size_t i
+
+    ucxx_context = dynamic_pointer_cast[Context, Component](worker.get().getParent())
+
+    ret = []
+    for i in range(endpoints.size()):
+        endpoint = UCXEndpoint.__new__(UCXEndpoint)
+        endpoint._enable_python_future = enable_python_future
+        endpoint._context_feature_flags = ucxx_context.get().getFeatureFlags()
+        endpoint._cuda_support = ucxx_context.get().hasCudaSupport()
+        endpoint._endpoint = endpoints[i]
+        ret.append(endpoint)
+    return ret
+
 
 cdef void _listener_callback(ucp_conn_request_h conn_request, void *args) with gil:
     """Callback function used by UCXListener"""
@@ -1559,6 +2961,87 @@ cdef class UCXListener():
 
         return listener
 
+    @classmethod
+    def create_with_backlog(
+            cls,
+            UCXWorker worker,
+            uint16_t port,
+            size_t backlog,
+    ) -> UCXListener:
+        """Create a listener that queues incoming connection requests.
+
+        Instead of calling back for each client, up to ``backlog`` connection requests
+        are queued by the progress thread and any further requests are rejected while
+        the queue is full. Endpoints to queued clients are created in batches with
+        ``accept_endpoints()``.
+        """
+        cdef UCXListener listener = UCXListener.__new__(UCXListener)
+
+        listener._cb_data = None
+        listener._enable_python_future = worker.enable_python_future
+
+        with nogil:
+            listener._listener = worker._worker.get().createListener(port, backlog)
+
+        return listener
+
+    def accept_endpoints(
+            self,
+            max_endpoints=None,
+            bint endpoint_error_handling=True,
+    ) -> list:
+        """Create endpoints to queued clients.
+
+        Create one endpoint for each of up to ``max_endpoints`` (all if ``None``)
+        connection requests queued by a listener created with
+        ``create_with_backlog()``, returning a list of ``UCXEndpoint`` objects.
+        """
+        cdef size_t c_max_endpoints = (
+            SIZE_MAX if max_endpoints is None else max_endpoints
+        )
+        cdef vector[shared_ptr[Endpoint]] cpp_endpoints
+        cdef shared_ptr[Worker] ucxx_worker
+
+        with nogil:
+            ucxx_worker = dynamic_pointer_cast[Worker, Component](
+                self._listener.get().getParent()
+            )
+            cpp_endpoints = self._listener.get().acceptEndpoints(
+                c_max_endpoints, endpoint_error_handling
+            )
+
+        return _wrap_endpoints(ucxx_worker, self._enable_python_future, cpp_endpoints)
+
+    @property
+    def pending_connection_requests(self) -> int:
+        cdef size_t pending
+
+        with nogil:
+            pending = self._listener.get().getPendingConnectionRequests()
+
+        return pending
+
+    @property
+    def statistics(self) -> dict:
+        """Snapshot of the listener statistics.
+
+        Counters of connection requests received, accepted and rejected, and the
+        current and maximum depth of the connection request queue. Only listeners
+        created with ``create_with_backlog()`` keep track of statistics.
+        """
+        cdef ListenerStatistics statistics
+
+        with nogil:
+            statistics = self._listener.get().getStatistics()
+
+        return {
+            "connection_requests_received": statistics.connectionRequestsReceived,
+            "connection_requests_accepted": statistics.connectionRequestsAccepted,
+            "connection_requests_rejected": statistics.connectionRequestsRejected,
+            "queue_depth": statistics.queueDepth,
+            "max_queue_depth": statistics.maxQueueDepth,
+        }
+
     @property
     def port(self) -> int:
         cdef uint16_t port
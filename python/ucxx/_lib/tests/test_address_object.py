@@ -34,3 +34,32 @@ def test_pickle_ucx_address():
     assert org_address_hash == hash(new_address)
     assert bytes(org_address_str) == bytes(new_address_str)
     assert bytes(org_address) == bytes(new_address)
+
+
+def test_pickle_ucx_address_out_of_band():
+    ctx = ucx_api.UCXContext()
+    worker = ucx_api.UCXWorker(ctx)
+    org_address = worker.address
+
+    buffers = []
+    dumped_address = pickle.dumps(
+        org_address, protocol=5, buffer_callback=buffers.append
+    )
+    assert len(buffers) == 1
+    assert buffers[0].raw().tobytes() == org_address.string
+
+    new_address = pickle.loads(dumped_address, buffers=buffers)
+    assert hash(org_address) == hash(new_address)
+    assert new_address.string == org_address.string
+
+
+def test_intern_ucx_address():
+    ctx = ucx_api.UCXContext()
+    worker = ucx_api.UCXWorker(ctx)
+    org_address_str = worker.address.string
+
+    address = ctx.intern_address(org_address_str)
+    same_address = ctx.intern_address(memoryview(org_address_str))
+    assert address.string == org_address_str
+    assert address.address == same_address.address
+    assert hash(address) == hash(worker.address)
@@ -8,7 +8,7 @@ import mmap
 import operator
 
 import pytest
-from ucxx._lib.arr import Array
+from ucxx._lib.arr import Array, frames_info
 
 builtin_buffers = [
     b"",
@@ -178,3 +178,53 @@ def test_Array_ndarray_contiguous(xp, shape, dtype, strides):
     assert arr2.c_contiguous == arr.flags.c_contiguous
     assert arr2.f_contiguous == arr.flags.f_contiguous
     assert arr2.contiguous == (arr.flags.c_contiguous or arr.flags.f_contiguous)
+
+
+def test_frames_info_builtins():
+    buffers = [b for b in builtin_buffers if memoryview(b).contiguous]
+    ptrs, sizes, is_cuda = frames_info(buffers + [Array(b) for b in buffers])
+
+    expected_ptrs = tuple(Array(b).ptr for b in buffers)
+    expected_sizes = tuple(memoryview(b).nbytes for b in buffers)
+    assert ptrs == expected_ptrs * 2
+    assert sizes == expected_sizes * 2
+    assert is_cuda == (False,) * len(buffers) * 2
+
+
+def test_frames_info_non_contiguous():
+    mv = memoryview(bytearray(b"abcd"))[::2]
+    with pytest.raises(ValueError):
+        frames_info([mv])
+    with pytest.raises(ValueError):
+        frames_info([Array(mv)])
+
+
+def test_frames_info_instance_cuda_array_interface():
+    class Frame(bytearray):
+        pass
+
+    host_frame = Frame(b"abcd")
+    cuda_frame = Frame()
+    cuda_frame.__cuda_array_interface__ = {
+        "shape": (8,),
+        "typestr": "|u1",
+        "data": (0x1000, False),
+        "version": 3,
+    }
+
+    # The interface is set per instance, the type of a host frame must not be trusted
+    ptrs, sizes, is_cuda = frames_info([host_frame, cuda_frame])
+    assert ptrs == (Array(host_frame).ptr, 0x1000)
+    assert sizes == (4, 8)
+    assert is_cuda == (False, True)
+
+
+@pytest.mark.parametrize("xp", ["cupy", "numpy"])
+@pytest.mark.parametrize("shape, dtype, strides", array_params)
+def test_frames_info_ndarray(xp, shape, dtype, strides):
+    xp, arr, iface = create_array(xp, shape, dtype, strides)
+    ptrs, sizes, is_cuda = frames_info((arr, arr))
+
+    assert ptrs == (iface["data"][0],) * 2
+    assert sizes == (arr.nbytes,) * 2
+    assert is_cuda == (xp.__name__ == "cupy",) * 2
@@ -100,3 +100,51 @@ def test_close_callback(server_close_callback):
     server.join(timeout=10)
     terminate_process(client)
     terminate_process(server)
+
+
+@pytest.mark.parametrize("eager_wireup", [True, False])
+def test_create_many_from_worker_address(eager_wireup):
+    ctx = ucx_api.UCXContext(feature_flags=(ucx_api.Feature.TAG,))
+    worker = ucx_api.UCXWorker(ctx)
+    addresses = [worker.address] * 4
+
+    eps = ucx_api.UCXEndpoint.create_many_from_worker_address(
+        worker, addresses, endpoint_error_handling=True, eager_wireup=eager_wireup
+    )
+    assert len(eps) == len(addresses)
+
+    msgs = [bytearray(os.urandom(WireupMessageSize)) for _ in eps]
+    recv_msgs = [bytearray(WireupMessageSize) for _ in eps]
+    requests = []
+    for i, (ep, msg, recv_msg) in enumerate(zip(eps, msgs, recv_msgs)):
+        requests.append(ep.tag_send(Array(msg), tag=ucx_api.UCXXTag(i)))
+        requests.append(ep.tag_recv(Array(recv_msg), tag=ucx_api.UCXXTag(i)))
+    wait_requests(worker, "blocking", requests)
+
+    assert recv_msgs == msgs
+
+
+def test_endpoint_cache():
+    ctx = ucx_api.UCXContext(feature_flags=(ucx_api.Feature.TAG,))
+    worker = ucx_api.UCXWorker(ctx)
+    assert worker.endpoint_cache_enabled is False
+
+    worker.endpoint_cache_enabled = True
+    assert worker.endpoint_cache_enabled is True
+
+    ep = ucx_api.UCXEndpoint.create_from_worker_address(
+        worker, worker.address, endpoint_error_handling=True
+    )
+    cached_ep = ucx_api.UCXEndpoint.create_from_worker_address(
+        worker, worker.address, endpoint_error_handling=True
+    )
+    assert cached_ep.handle == ep.handle
+
+    msg = bytearray(os.urandom(WireupMessageSize))
+    recv_msg = bytearray(WireupMessageSize)
+    requests = [
+        ep.tag_send(Array(msg), tag=ucx_api.UCXXTag(0)),
+        cached_ep.tag_recv(Array(recv_msg), tag=ucx_api.UCXXTag(0)),
+    ]
+    wait_requests(worker, "blocking", requests)
+    assert recv_msg == msg
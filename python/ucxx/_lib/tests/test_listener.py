@@ -19,3 +19,35 @@ def test_listener_ip_port():
     assert (
         isinstance(listener.port, int) and listener.port >= 0 and listener.port <= 65535
     )
+
+
+def test_listener_backlog():
+    ctx = ucx_api.UCXContext(feature_flags=(ucx_api.Feature.TAG,))
+    worker = ucx_api.UCXWorker(ctx)
+    backlog = 2
+
+    listener = ucx_api.UCXListener.create_with_backlog(
+        worker=worker, port=0, backlog=backlog
+    )
+    assert listener.accept_endpoints() == []
+
+    eps = [
+        ucx_api.UCXEndpoint.create(
+            worker, "127.0.0.1", listener.port, endpoint_error_handling=True
+        )
+        for _ in range(2 * backlog)
+    ]
+    while listener.statistics["connection_requests_received"] < len(eps):
+        worker.progress()
+
+    statistics = listener.statistics
+    assert statistics["connection_requests_rejected"] == len(eps) - backlog
+    assert statistics["queue_depth"] == backlog
+    assert listener.pending_connection_requests == backlog
+
+    server_eps = listener.accept_endpoints(max_endpoints=1)
+    server_eps += listener.accept_endpoints()
+    assert len(server_eps) == backlog
+    assert all(isinstance(ep, ucx_api.UCXEndpoint) for ep in server_eps)
+    assert listener.statistics["connection_requests_accepted"] == backlog
+    assert listener.pending_connection_requests == 0
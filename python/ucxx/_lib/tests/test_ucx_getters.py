@@ -3,6 +3,8 @@
 
 import pytest
 import ucxx._lib.libucxx as ucx_api
+from ucxx._lib.arr import Array
+from ucxx.testing import wait_requests
 
 
 def _init_and_get_objects(progress_mode):
@@ -75,3 +77,58 @@ def test_get_ucxx_handles(progress_mode):
     )
     assert all([isinstance(ep.ucxx_ptr, int) for ep in [client_ep, listener_ep]])
     assert all([ep.ucxx_ptr > 0 for ep in [client_ep, listener_ep]])
+
+
+def test_statistics():
+    """Test worker and endpoint statistics.
+
+    Test that requests and worker progress are accounted for.
+    """
+    worker, client_ep, listener_ep = _init_and_get_objects("blocking")
+
+    send_msg = Array(bytearray(b"statistics"))
+    recv_msg = Array(bytearray(send_msg.nbytes))
+    requests = [
+        client_ep.tag_send(send_msg, tag=ucx_api.UCXXTag(0)),
+        listener_ep.tag_recv(recv_msg, tag=ucx_api.UCXXTag(0)),
+    ]
+    wait_requests(worker, "blocking", requests)
+
+    for ep in [client_ep, listener_ep]:
+        assert ep.statistics == {
+            "requests_submitted": 1,
+            "requests_completed": 1,
+            "requests_failed": 0,
+            "requests_canceled": 0,
+        }
+
+    statistics = worker.statistics
+    assert statistics["requests_submitted"] >= 2
+    assert statistics["requests_completed"] >= 2
+    assert statistics["requests_delayed"] == 0
+    assert statistics["progress_calls"] >= statistics["progress_calls_with_progress"]
+    assert statistics["progress_calls_with_progress"] > 0
+
+
+def test_request_traces():
+    """Test request lifecycle traces.
+
+    Test that sampled requests are traced through all lifecycle stages.
+    """
+    worker, client_ep, listener_ep = _init_and_get_objects("blocking")
+    worker.set_request_tracing(1, capacity=4)
+
+    send_msg = Array(bytearray(b"traces"))
+    recv_msg = Array(bytearray(send_msg.nbytes))
+    requests = [
+        client_ep.tag_send(send_msg, tag=ucx_api.UCXXTag(0)),
+        listener_ep.tag_recv(recv_msg, tag=ucx_api.UCXXTag(0)),
+    ]
+    wait_requests(worker, "blocking", requests)
+
+    traces = worker.get_request_traces(clear=True)
+    assert sorted(t["operation"] for t in traces) == ["tagRecv", "tagSend"]
+    for t in traces:
+        assert t["status"] == "Success"
+        assert 0 < t["created"] <= t["submitted"] <= t["completed"] <= t["notified"]
+    assert worker.get_request_traces() == []
@@ -5,12 +5,13 @@
 from posix cimport fcntl
 
 cimport numpy as np
-from libc.stdint cimport int64_t, uint16_t, uint64_t
+from libc.stdint cimport int64_t, uint16_t, uint32_t, uint64_t
 from libcpp cimport bool as cpp_bool
 from libcpp.functional cimport function
 from libcpp.memory cimport shared_ptr, unique_ptr
 from libcpp.string cimport string
 from libcpp.unordered_map cimport unordered_map as cpp_unordered_map
+from libcpp.utility cimport pair
 from libcpp.vector cimport vector
 
 
@@ -59,6 +60,16 @@ cdef extern from "ucp/api/ucp.h" nogil:
     ctypedef struct ucp_address_t:
         pass
 
+    ctypedef struct ucp_mem:
+        pass
+
+    ctypedef ucp_mem* ucp_mem_h
+
+    ctypedef struct ucp_rkey:
+        pass
+
+    ctypedef ucp_rkey* ucp_rkey_h
+
     ctypedef uint64_t ucp_tag_t
 
     ctypedef enum ucs_status_t:
@@ -67,9 +78,14 @@ cdef extern from "ucp/api/ucp.h" nogil:
     ctypedef enum ucs_memory_type_t:
         pass
 
+    ctypedef enum ucp_atomic_op_t:
+        pass
+
     # Constants
     ucs_status_t UCS_OK
+    ucs_status_t UCS_INPROGRESS
 
+    ucs_memory_type_t UCS_MEMORY_TYPE_UNKNOWN
     ucs_memory_type_t UCS_MEMORY_TYPE_HOST
     ucs_memory_type_t UCS_MEMORY_TYPE_CUDA
 
@@ -81,6 +97,13 @@ cdef extern from "ucp/api/ucp.h" nogil:
     int UCP_FEATURE_AMO64
     int UCP_FEATURE_AM
 
+    ucp_atomic_op_t UCP_ATOMIC_OP_ADD
+    ucp_atomic_op_t UCP_ATOMIC_OP_SWAP
+    ucp_atomic_op_t UCP_ATOMIC_OP_CSWAP
+    ucp_atomic_op_t UCP_ATOMIC_OP_AND
+    ucp_atomic_op_t UCP_ATOMIC_OP_OR
+    ucp_atomic_op_t UCP_ATOMIC_OP_XOR
+
     # Functions
     const char *ucs_status_string(ucs_status_t status)
 
@@ -89,6 +112,16 @@ cdef extern from "ucp/api/ucp.h" nogil:
                          unsigned *release_number)
 
 
+cdef extern from "<cuda_runtime_api.h>" nogil:
+    ctypedef void* cudaStream_t
+
+
+cdef extern from "rmm/cuda_stream_view.hpp" namespace "rmm" nogil:
+    cdef cppclass cuda_stream_view:
+        cuda_stream_view()
+        cuda_stream_view(cudaStream_t stream)
+
+
 cdef extern from "rmm/device_buffer.hpp" namespace "rmm" nogil:
     cdef cppclass device_buffer:
         pass
@@ -133,6 +166,7 @@ cdef extern from "<ucxx/python/exception.h>" namespace "ucxx::python" nogil:
 
     cdef void create_exceptions()
     cdef void raise_py_error()
+    cdef PyObject* get_python_exception_from_ucs_status(ucs_status_t status)
 
 
 cdef extern from "<ucxx/python/api.h>" namespace "ucxx::python" nogil:
@@ -147,8 +181,21 @@ cdef extern from "<ucxx/buffer.h>" namespace "ucxx" nogil:
     cdef enum class BufferType:
         Host
         RMM
+        AmData
+        Pinned
         Invalid
 
+    cdef enum class HugePages:
+        Disabled
+        Transparent
+        Size2MB
+        Size1GB
+
+    cdef cppclass HostAllocationOptions:
+        HugePages hugePages
+        int numaNode
+        bint prefault
+
     cdef cppclass Buffer:
         Buffer(const BufferType bufferType, const size_t size_t)
         BufferType getType()
@@ -159,6 +206,7 @@ cdef extern from "<ucxx/buffer.h>" namespace "ucxx" nogil:
         BufferType getType()
         size_t getSize()
         void* release() except +raise_py_error
+        bint isMapped()
         void* data() except +raise_py_error
 
     cdef cppclass RMMBuffer:
@@ -168,6 +216,16 @@ cdef extern from "<ucxx/buffer.h>" namespace "ucxx" nogil:
         unique_ptr[device_buffer] release() except +raise_py_error
         void* data() except +raise_py_error
 
+    cdef cppclass AmDataBuffer:
+        BufferType getType()
+        size_t getSize()
+        void* data() except +raise_py_error
+
+    cdef cppclass PinnedHostBuffer:
+        BufferType getType()
+        size_t getSize()
+        void* data() except +raise_py_error
+
 
 cdef extern from "<ucxx/notifier.h>" namespace "ucxx" nogil:
     cdef enum class RequestNotifierWaitState:
@@ -177,6 +235,43 @@ cdef extern from "<ucxx/notifier.h>" namespace "ucxx" nogil:
 
 
 cdef extern from "<ucxx/api.h>" namespace "ucxx" nogil:
+    cdef enum class EndpointCloseMode:
+        Force
+        Flush
+
+    cdef enum class SendProtocol:
+        Auto
+        Eager
+        Rendezvous
+
+    cdef enum class SubmissionPriority:
+        High
+        Normal
+        Bulk
+
+    cdef enum class CompressionCodec:
+        CompressionCodecNone "ucxx::CompressionCodec::None"
+        LZ4
+        Zstd
+
+    cdef cppclass CompressionConfig:
+        CompressionCodec codec
+        int level
+        size_t minFrameSize
+        vector[string] transports
+
+    cdef cppclass SendHints:
+        SendProtocol amProtocol
+        size_t amRendezvousThreshold
+        bint fastCompletion
+        bint multiSend
+        SubmissionPriority submissionPriority
+
+    cdef cppclass ProgressBudget:
+        size_t maxProgressCalls
+        size_t maxSubmissions
+        size_t maxCompletions
+
     cdef enum Tag:
         pass
     cdef enum TagMask:
@@ -190,11 +285,18 @@ cdef extern from "<ucxx/api.h>" namespace "ucxx" nogil:
     # See https://github.com/cython/cython/issues/2041 and
     # https://github.com/cython/cython/issues/3193
     ctypedef shared_ptr[Buffer] (*AmAllocatorType)(size_t)
+    AmAllocatorType createRMMAllocator(
+        cuda_stream_view stream
+    ) except +raise_py_error
+    AmAllocatorType createHostAllocator(const HostAllocationOptions& options)
+    cdef cppclass RequestCallbackUserFunction:
+        pass
+    ctypedef shared_ptr[void] RequestCallbackUserData
 
     ctypedef cpp_unordered_map[string, string] ConfigMap
 
     shared_ptr[Context] createContext(
-        ConfigMap ucx_config, uint64_t feature_flags
+        ConfigMap ucx_config, uint64_t feature_flags, bint enable_mt_workers_shared
     ) except +raise_py_error
 
     shared_ptr[Address] createAddressFromWorker(shared_ptr[Worker] worker)
@@ -219,6 +321,57 @@ cdef extern from "<ucxx/api.h>" namespace "ucxx" nogil:
         string getInfo() except +raise_py_error
         uint64_t getFeatureFlags()
         bint hasCudaSupport()
+        bint isMtWorkersSharedEnabled()
+        shared_ptr[MemoryHandle] createMemoryHandle(
+            size_t size, void* buffer, ucs_memory_type_t memory_type
+        ) except +raise_py_error
+        shared_ptr[Address] internAddress(
+            const string& address_string
+        ) except +raise_py_error
+
+    cdef cppclass EndpointStatistics:
+        uint64_t requestsSubmitted
+        uint64_t requestsCompleted
+        uint64_t requestsFailed
+        uint64_t requestsCanceled
+
+    cdef cppclass ListenerStatistics:
+        uint64_t connectionRequestsReceived
+        uint64_t connectionRequestsAccepted
+        uint64_t connectionRequestsRejected
+        uint64_t queueDepth
+        uint64_t maxQueueDepth
+
+    cdef cppclass WorkerStatistics:
+        uint64_t requestsSubmitted
+        uint64_t requestsCompleted
+        uint64_t requestsFailed
+        uint64_t requestsCanceled
+        uint64_t requestsDelayed
+        uint64_t requestsTimedOut
+        uint64_t progressCalls
+        uint64_t progressCallsWithProgress
+        uint64_t progressSpinHits
+        uint64_t progressSleeps
+        uint64_t progressBudgetExhausted
+        uint64_t delayedSubmissionCallbacks
+        uint64_t delayedSubmissionProcessNs
+        uint64_t futuresPoolRefills
+        uint64_t framesCompressed
+        uint64_t framesNotCompressed
+        uint64_t compressionInputBytes
+        uint64_t compressionOutputBytes
+        uint64_t compressionNs
+        uint64_t framesDecompressed
+        uint64_t decompressionNs
+
+    cdef cppclass RequestTrace:
+        string operationName
+        ucs_status_t status
+        uint64_t created
+        uint64_t submitted
+        uint64_t completed
+        uint64_t notified
 
     cdef cppclass Worker(Component):
         ucp_worker_h getHandle()
@@ -230,16 +383,57 @@ cdef extern from "<ucxx/api.h>" namespace "ucxx" nogil:
         shared_ptr[Endpoint] createEndpointFromWorkerAddress(
             shared_ptr[Address] address, bint endpoint_error_handling
         ) except +raise_py_error
+        vector[shared_ptr[Endpoint]] createEndpointsFromHostnames(
+            const vector[pair[string, uint16_t]]& hosts,
+            bint endpoint_error_handling,
+            bint eager_wireup,
+        ) except +raise_py_error
+        vector[shared_ptr[Endpoint]] createEndpointsFromWorkerAddresses(
+            const vector[shared_ptr[Address]]& addresses,
+            bint endpoint_error_handling,
+            bint eager_wireup,
+        ) except +raise_py_error
         shared_ptr[Listener] createListener(
             uint16_t port, ucp_listener_conn_callback_t callback, void *callback_args
         ) except +raise_py_error
+        shared_ptr[Listener] createListener(
+            uint16_t port, size_t backlog
+        ) except +raise_py_error
         void initBlockingProgressMode() except +raise_py_error
+        bint arm() except +raise_py_error
+        int getEpollFileDescriptor() except +raise_py_error
         void progress()
         bint progressOnce()
         void progressWorkerEvent(int epoll_timeout)
         void startProgressThread(
-            bint pollingMode, int epoll_timeout
+            bint pollingMode,
+            int epoll_timeout,
+            uint64_t spinPeriodNs,
+            const vector[int]& cpuAffinity,
+        ) except +raise_py_error
+        vector[int] getNetworkDevicesLocalCpus() except +raise_py_error
+        uint64_t getProgressSpinHits() const
+        uint64_t getProgressSleeps() const
+        WorkerStatistics getStatistics() const
+        void setRequestTracing(
+            uint64_t sampleRate, size_t capacity
+        ) except +raise_py_error
+        vector[RequestTrace] getRequestTraces(bint clear)
+        void startTrafficCapture(const string& path) except +raise_py_error
+        void stopTrafficCapture()
+        bint isTrafficCaptureEnabled()
+        void startCompletionCallbackThreads(
+            size_t numThreads, size_t batchSize
         ) except +raise_py_error
+        void resetCompletionCallbackExecutor()
+        void setCompression(
+            const CompressionConfig& config, size_t numThreads
+        ) except +raise_py_error
+        CompressionConfig getCompressionConfig()
+        void setCompactHeaders(bint enable)
+        bint isCompactHeadersEnabled() const
+        void setEndpointCacheEnabled(bint enabled)
+        bint isEndpointCacheEnabled() const
         void stopProgressThread() except +raise_py_error
         size_t cancelInflightRequests(
             uint64_t period, uint64_t maxAttempts
@@ -248,47 +442,161 @@ cdef extern from "<ucxx/api.h>" namespace "ucxx" nogil:
         void setProgressThreadStartCallback(
             function[void(void*)] callback, void* callbackArg
         )
+        void setProgressThreadCudaDevice(int device)
         void stopRequestNotifierThread() except +raise_py_error
         RequestNotifierWaitState waitRequestNotifier(
             uint64_t periodNs
         ) except +raise_py_error
         void runRequestNotifier() except +raise_py_error
         void populateFuturesPool() except +raise_py_error
+        void setFuturesPoolSize(
+            size_t size, size_t low_watermark
+        ) except +raise_py_error
+        shared_ptr[Request] tagRecv(
+            void* buffer,
+            size_t length,
+            Tag tag,
+            TagMask tag_mask,
+            bint enable_python_future
+        ) except +raise_py_error
         shared_ptr[Request] tagRecv(
             void* buffer,
             size_t length,
             Tag tag,
             TagMask tag_mask,
+            bint enable_python_future,
+            RequestCallbackUserFunction callback_function,
+            RequestCallbackUserData callback_data,
+            shared_ptr[MemoryHandle] memory_handle,
+        ) except +raise_py_error
+        void fence() except +raise_py_error
+        shared_ptr[Request] flush(
             bint enable_python_future
         ) except +raise_py_error
+        vector[shared_ptr[Request]] closeEndpoints(
+            const vector[shared_ptr[Endpoint]]& endpoints, bint enable_python_future
+        ) except +raise_py_error
         bint isDelayedRequestSubmissionEnabled() const
+        void setDelayedSubmissionBudget(size_t budget)
+        size_t getDelayedSubmissionBudget() const
+        void setProgressBudget(const ProgressBudget& budget)
+        ProgressBudget getProgressBudget() const
         bint isFutureEnabled() const
         bint amProbe(ucp_ep_h) const
+        bint amProbe(ucp_ep_h, unsigned int am_id) except +raise_py_error
         void registerAmAllocator(
             ucs_memory_type_t memoryType, AmAllocatorType allocator
         )
+        void registerAmAllocator(
+            ucs_memory_type_t memoryType, AmAllocatorType allocator, unsigned int am_id
+        ) except +raise_py_error
+        void registerBufferAllocator(
+            BufferType bufferType, AmAllocatorType allocator
+        ) except +raise_py_error
+        void registerAmHandler(unsigned int am_id) except +raise_py_error
 
     cdef cppclass Endpoint(Component):
         ucp_ep_h getHandle()
-        void close(uint64_t period, uint64_t maxAttempts)
+        EndpointStatistics getStatistics() const
+        void close(
+            uint64_t period,
+            uint64_t maxAttempts,
+            EndpointCloseMode mode,
+            uint64_t flushTimeout,
+        )
+        shared_ptr[Request] closeAsync(bint enable_python_future) except +raise_py_error
         shared_ptr[Request] amSend(
             void* buffer,
             size_t length,
             ucs_memory_type_t memory_type,
             bint enable_python_future
         ) except +raise_py_error
+        shared_ptr[Request] amSend(
+            void* buffer,
+            size_t length,
+            ucs_memory_type_t memory_type,
+            bint enable_python_future,
+            RequestCallbackUserFunction callback_function,
+            RequestCallbackUserData callback_data,
+            const string& header,
+        ) except +raise_py_error
+        shared_ptr[Request] amSend(
+            void* buffer,
+            size_t length,
+            ucs_memory_type_t memory_type,
+            bint enable_python_future,
+            RequestCallbackUserFunction callback_function,
+            RequestCallbackUserData callback_data,
+            const string& header,
+            unsigned int am_id,
+        ) except +raise_py_error
+        shared_ptr[Request] amRecv(
+            bint enable_python_future
+        ) except +raise_py_error
         shared_ptr[Request] amRecv(
+            bint enable_python_future,
+            RequestCallbackUserFunction callback_function,
+            RequestCallbackUserData callback_data,
+            unsigned int am_id,
+        ) except +raise_py_error
+        shared_ptr[Request] memPut(
+            void* buffer,
+            size_t length,
+            uint64_t remote_addr,
+            shared_ptr[RemoteKey] remote_key,
+            bint enable_python_future,
+            RequestCallbackUserFunction callback_function,
+            RequestCallbackUserData callback_data,
+            shared_ptr[MemoryHandle] memory_handle,
+        ) except +raise_py_error
+        shared_ptr[Request] memGet(
+            void* buffer,
+            size_t length,
+            uint64_t remote_addr,
+            shared_ptr[RemoteKey] remote_key,
+            bint enable_python_future,
+            RequestCallbackUserFunction callback_function,
+            RequestCallbackUserData callback_data,
+            shared_ptr[MemoryHandle] memory_handle,
+        ) except +raise_py_error
+        shared_ptr[Request] memAtomic(
+            ucp_atomic_op_t opcode,
+            uint64_t value,
+            uint64_t remote_addr,
+            shared_ptr[RemoteKey] remote_key,
+            bint fetch,
+            uint64_t compare,
+            bint enable_python_future,
+        ) except +raise_py_error
+        shared_ptr[Request] flush(
             bint enable_python_future
         ) except +raise_py_error
+        shared_ptr[RemoteKey] createRemoteKeyFromSerialized(
+            const string& serialized_remote_key
+        ) except +raise_py_error
         shared_ptr[Request] streamSend(
             void* buffer, size_t length, bint enable_python_future
         ) except +raise_py_error
         shared_ptr[Request] streamRecv(
             void* buffer, size_t length, bint enable_python_future
         ) except +raise_py_error
+        shared_ptr[Request] streamSendIov(
+            const vector[void*]& buffer,
+            const vector[size_t]& length,
+            bint enable_python_future
+        ) except +raise_py_error
         shared_ptr[Request] tagSend(
             void* buffer, size_t length, Tag tag, bint enable_python_future
         ) except +raise_py_error
+        shared_ptr[Request] tagSend(
+            void* buffer,
+            size_t length,
+            Tag tag,
+            bint enable_python_future,
+            RequestCallbackUserFunction callback_function,
+            RequestCallbackUserData callback_data,
+            shared_ptr[MemoryHandle] memory_handle,
+        ) except +raise_py_error
         shared_ptr[Request] tagRecv(
             void* buffer,
             size_t length,
@@ -296,6 +604,29 @@ cdef extern from "<ucxx/api.h>" namespace "ucxx" nogil:
             TagMask tag_mask,
             bint enable_python_future
         ) except +raise_py_error
+        shared_ptr[Request] tagRecv(
+            void* buffer,
+            size_t length,
+            Tag tag,
+            TagMask tag_mask,
+            bint enable_python_future,
+            RequestCallbackUserFunction callback_function,
+            RequestCallbackUserData callback_data,
+            shared_ptr[MemoryHandle] memory_handle,
+        ) except +raise_py_error
+        shared_ptr[Request] tagSendIov(
+            const vector[void*]& buffer,
+            const vector[size_t]& length,
+            Tag tag,
+            bint enable_python_future
+        ) except +raise_py_error
+        shared_ptr[Request] tagRecvIov(
+            const vector[void*]& buffer,
+            const vector[size_t]& length,
+            Tag tag,
+            TagMask tag_mask,
+            bint enable_python_future
+        ) except +raise_py_error
         shared_ptr[Request] tagMultiSend(
             const vector[void*]& buffer,
             const vector[size_t]& length,
@@ -303,23 +634,55 @@ cdef extern from "<ucxx/api.h>" namespace "ucxx" nogil:
             Tag tag,
             bint enable_python_future
         ) except +raise_py_error
+        shared_ptr[Request] tagMultiSend(
+            const vector[void*]& buffer,
+            const vector[size_t]& length,
+            const vector[int]& isCUDA,
+            Tag tag,
+            bint enable_python_future,
+            size_t pack_threshold,
+        ) except +raise_py_error
         shared_ptr[Request] tagMultiRecv(
             Tag tag, TagMask tagMask, bint enable_python_future
         ) except +raise_py_error
         bint isAlive()
         void raiseOnError() except +raise_py_error
+        ucs_status_t getError(string* message)
         void setCloseCallback(
             function[void(void*)] close_callback, void* close_callback_arg
         )
+        void setSendHints(const SendHints& send_hints)
+        void setTagBases(Tag send_tag_base, Tag recv_tag_base)
+        Tag deriveSendTag(uint64_t user_tag) const
+        Tag deriveRecvTag(uint64_t user_tag) const
+        SendHints getSendHints()
         shared_ptr[Worker] getWorker()
 
     cdef cppclass Listener(Component):
         shared_ptr[Endpoint] createEndpointFromConnRequest(
             ucp_conn_request_h conn_request, bint endpoint_error_handling
         ) except +raise_py_error
+        vector[shared_ptr[Endpoint]] acceptEndpoints(
+            size_t max_endpoints, bint endpoint_error_handling
+        ) except +raise_py_error
+        size_t getPendingConnectionRequests()
+        ListenerStatistics getStatistics()
         uint16_t getPort()
         string getIp()
 
+    cdef cppclass MemoryHandle(Component):
+        ucp_mem_h getHandle()
+        void* getBaseAddress()
+        size_t getSize()
+        ucs_memory_type_t getMemoryType()
+        shared_ptr[RemoteKey] createRemoteKey() except +raise_py_error
+
+    cdef cppclass RemoteKey(Component):
+        ucp_rkey_h getHandle()
+        uint64_t getBaseAddress()
+        size_t getSize()
+        string serialize() except +raise_py_error
+
     cdef cppclass Address(Component):
         ucp_address_t* getHandle()
         size_t getLength()
@@ -329,9 +692,14 @@ cdef extern from "<ucxx/api.h>" namespace "ucxx" nogil:
         cpp_bool isCompleted()
         ucs_status_t getStatus()
         void checkError() except +raise_py_error
+        ucs_status_t getError(string* message)
         void* getFuture() except +raise_py_error
         shared_ptr[Buffer] getRecvBuffer() except +raise_py_error
+        string getRecvHeader() except +raise_py_error
+        uint64_t getAtomicResult() except +raise_py_error
         void cancel()
+        void setTimeout(uint64_t timeout) except +raise_py_error
+        void setCompletionFlag(uint32_t* flag, uint32_t value) except +raise_py_error
 
 
 cdef extern from "<ucxx/request_tag_multi.h>" namespace "ucxx" nogil:
@@ -354,8 +722,13 @@ cdef extern from "<ucxx/request_tag_multi.h>" namespace "ucxx" nogil:
         cpp_bool isCompleted()
         ucs_status_t getStatus()
         void checkError() except +raise_py_error
+        ucs_status_t getError(string* message)
         void* getFuture() except +raise_py_error
 
 
 cdef extern from "<ucxx/utils/python.h>" namespace "ucxx::utils" nogil:
     cpp_bool isPythonAvailable()
+
+
+cdef extern from "<ucxx/utils/compression.h>" namespace "ucxx::utils" nogil:
+    cpp_bool isCompressionCodecAvailable(CompressionCodec codec)
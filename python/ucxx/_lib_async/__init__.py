@@ -5,3 +5,4 @@
 from .application_context import ApplicationContext  # noqa
 from .endpoint import Endpoint  # noqa
 from .listener import Listener  # noqa
+from .striped_endpoint import StripedEndpoint  # noqa
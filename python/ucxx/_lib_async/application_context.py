@@ -1,6 +1,7 @@
 # SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
 # SPDX-License-Identifier: BSD-3-Clause
 
+import asyncio
 import logging
 import os
 import threading
@@ -13,9 +14,9 @@ from ucxx._lib.arr import Array
 from ucxx.exceptions import UCXMessageTruncatedError
 from ucxx.types import Tag
 
-from .continuous_ucx_progress import PollingMode, ThreadMode
-from .endpoint import Endpoint
-from .exchange_peer_info import exchange_peer_info
+from .continuous_ucx_progress import BlockingMode, PollingMode, ThreadMode
+from .endpoint import OBJ_AM_ID, Endpoint
+from .exchange_peer_info import exchange_peer_info, exchange_peer_info_one_way
 from .listener import ActiveClients, Listener, _listener_handler
 from .notifier_thread import _notifierThread
 from .utils import get_event_loop, hash64bits
@@ -31,6 +32,9 @@ class ApplicationContext:
     _progress_mode = None
     _enable_delayed_submission = None
     _enable_python_future = None
+    _n_workers = None
+    _worker_selection = None
+    _exchange_peer_info_mode = None
 
     def __init__(
         self,
@@ -39,26 +43,43 @@ class ApplicationContext:
         enable_delayed_submission=None,
         enable_python_future=None,
         exchange_peer_info_timeout=10.0,
+        n_workers=None,
+        worker_selection=None,
+        exchange_peer_info_mode=None,
     ):
         self.progress_tasks = []
-        self.notifier_thread_q = None
-        self.notifier_thread = None
+        self.notifier_threads = []
         self._listener_active_clients = ActiveClients()
         self._next_listener_id = 0
+        self._next_worker = 0
 
         self.progress_mode = progress_mode
         self.enable_delayed_submission = enable_delayed_submission
         self.enable_python_future = enable_python_future
+        self.n_workers = n_workers
+        self.worker_selection = worker_selection
+        self.exchange_peer_info_mode = exchange_peer_info_mode
 
         self.exchange_peer_info_timeout = exchange_peer_info_timeout
 
-        # For now, a application context only has one worker
-        self.context = ucx_api.UCXContext(config_dict)
-        self.worker = ucx_api.UCXWorker(
-            self.context,
-            enable_delayed_submission=self._enable_delayed_submission,
-            enable_python_future=self._enable_python_future,
+        # Each worker is progressed independently (e.g., by its own progress thread),
+        # endpoints and listeners are distributed among them by `select_worker()`.
+        self.context = ucx_api.UCXContext(
+            config_dict, mt_workers_shared=self._n_workers > 1
         )
+        self.workers = [
+            ucx_api.UCXWorker(
+                self.context,
+                enable_delayed_submission=self._enable_delayed_submission,
+                enable_python_future=self._enable_python_future,
+            )
+            for _ in range(self._n_workers)
+        ]
+        # The first worker is the default one, e.g., used by `ApplicationContext.recv()`
+        self.worker = self.workers[0]
+        # Objects sent with `Endpoint.send_obj(am=True)` are queued separately.
+        for worker in self.workers:
+            worker.register_am_handler(OBJ_AM_ID)
 
         self.start_notifier_thread()
 
@@ -82,7 +103,7 @@ class ApplicationContext:
                 else:
                     progress_mode = "thread"
 
-            valid_progress_modes = ["polling", "thread", "thread-polling"]
+            valid_progress_modes = ["blocking", "polling", "thread", "thread-polling"]
             if not isinstance(progress_mode, str) or not any(
                 progress_mode == m for m in valid_progress_modes
             ):
@@ -164,6 +185,102 @@ class ApplicationContext:
                 "Enable Python future already set, modifying not allowed"
             )
 
+    @property
+    def n_workers(self):
+        return self._n_workers
+
+    @n_workers.setter
+    def n_workers(self, n_workers):
+        if self._n_workers is None:
+            if n_workers is None:
+                n_workers = int(os.environ.get("UCXPY_N_WORKERS", "1"))
+            if not isinstance(n_workers, int) or n_workers < 1:
+                raise ValueError(
+                    f"Invalid number of workers {n_workers}, must be a positive integer"
+                )
+            self._n_workers = n_workers
+        else:
+            raise RuntimeError("Number of workers already set, modifying not allowed")
+
+    @property
+    def worker_selection(self):
+        return self._worker_selection
+
+    @worker_selection.setter
+    def worker_selection(self, worker_selection):
+        if self._worker_selection is None:
+            if worker_selection is None:
+                worker_selection = os.environ.get(
+                    "UCXPY_WORKER_SELECTION", "round-robin"
+                )
+            valid_worker_selections = ["round-robin", "hash"]
+            if worker_selection not in valid_worker_selections:
+                raise ValueError(
+                    f"Unknown worker selection {worker_selection}, valid selections "
+                    "are: 'round-robin' or 'hash'"
+                )
+            self._worker_selection = worker_selection
+        else:
+            raise RuntimeError("Worker selection already set, modifying not allowed")
+
+    @property
+    def exchange_peer_info_mode(self):
+        return self._exchange_peer_info_mode
+
+    @exchange_peer_info_mode.setter
+    def exchange_peer_info_mode(self, exchange_peer_info_mode):
+        if self._exchange_peer_info_mode is None:
+            if exchange_peer_info_mode is None:
+                exchange_peer_info_mode = os.environ.get(
+                    "UCXPY_EXCHANGE_PEER_INFO_MODE", "round-trip"
+                )
+            valid_modes = ["round-trip", "one-way"]
+            if exchange_peer_info_mode not in valid_modes:
+                raise ValueError(
+                    f"Unknown exchange peer info mode {exchange_peer_info_mode}, "
+                    "valid modes are: 'round-trip' or 'one-way'"
+                )
+            self._exchange_peer_info_mode = exchange_peer_info_mode
+        else:
+            raise RuntimeError(
+                "Exchange peer info mode already set, modifying not allowed"
+            )
+
+    def select_worker(self, *key):
+        """Select the worker for a new endpoint or listener
+
+        With the 'round-robin' selection each call returns the next worker, with
+        the 'hash' selection the worker is chosen by hashing `key`, so that the
+        same peer always maps to the same worker.
+
+        Parameters
+        ----------
+        key: hashable
+            Identification of the peer, only used with the 'hash' selection.
+
+        Returns
+        -------
+        UCXWorker
+            The selected worker.
+        """
+        if self._n_workers == 1:
+            return self.worker
+        if self._worker_selection == "hash" and len(key) > 0:
+            return self.workers[hash64bits(*key) % self._n_workers]
+        worker = self.workers[self._next_worker]
+        self._next_worker = (self._next_worker + 1) % self._n_workers
+        return worker
+
+    def _get_endpoint_worker(self, ucx_ep):
+        """Get the `UCXWorker` that owns the `UCXEndpoint`"""
+        if self._n_workers == 1:
+            return self.worker
+        worker_handle = ucx_ep.worker_handle
+        for worker in self.workers:
+            if worker.handle == worker_handle:
+                return worker
+        raise ValueError("Endpoint does not belong to any worker of this context")
+
     @property
     def config(self):
         """UCX configuration options as a dict."""
@@ -184,6 +301,11 @@ class ApplicationContext:
         """The underlying UCXX worker pointer (ucxx::Worker*) as a Python integer."""
         return self.worker.ucxx_ptr
 
+    @property
+    def worker_statistics(self):
+        """Snapshot of the statistics of each worker, see ``UCXWorker.statistics``."""
+        return [worker.statistics for worker in self.workers]
+
     @property
     def ucp_worker_info(self):
         """Return low-level UCX info about this endpoint as a string."""
@@ -197,13 +319,16 @@ class ApplicationContext:
         if self.worker.enable_python_future:
             logger.debug("UCXX_ENABLE_PYTHON available, enabling notifier thread")
             loop = get_event_loop()
-            self.notifier_thread_q = Queue()
-            self.notifier_thread = threading.Thread(
-                target=_notifierThread,
-                args=(loop, self.worker, self.notifier_thread_q),
-                name="UCX-Py Async Notifier Thread",
-            )
-            self.notifier_thread.start()
+            for i, worker in enumerate(self.workers):
+                notifier_thread_q = Queue()
+                notifier_thread = threading.Thread(
+                    target=_notifierThread,
+                    args=(loop, worker, notifier_thread_q),
+                    name="UCX-Py Async Notifier Thread"
+                    + ("" if self._n_workers == 1 else f" {i}"),
+                )
+                notifier_thread.start()
+                self.notifier_threads.append((notifier_thread_q, notifier_thread))
         else:
             logger.debug(
                 "UCXX not compiled with UCXX_ENABLE_PYTHON, disabling notifier thread"
@@ -223,15 +348,18 @@ class ApplicationContext:
                      the thread to terminate. Executing `ucxx.reset()` will also run
                      this method, so it's not necessary to have both.
         """
-        if self.notifier_thread_q and self.notifier_thread:
-            self.notifier_thread_q.put("shutdown")
-            while True:
-                # Having a timeout is required. During the notifier thread shutdown
-                # it may require the GIL, which will cause a deadlock with the `join()`
-                # call otherwise.
-                self.notifier_thread.join(timeout=0.01)
-                if not self.notifier_thread.is_alive():
-                    break
+        if self.notifier_threads:
+            for notifier_thread_q, _ in self.notifier_threads:
+                notifier_thread_q.put("shutdown")
+            for _, notifier_thread in self.notifier_threads:
+                while True:
+                    # Having a timeout is required. During the notifier thread shutdown
+                    # it may require the GIL, which will cause a deadlock with the
+                    # `join()` call otherwise.
+                    notifier_thread.join(timeout=0.01)
+                    if not notifier_thread.is_alive():
+                        break
+            self.notifier_threads = []
             logger.debug("Notifier thread stopped")
         else:
             logger.debug("Notifier thread not running")
@@ -289,7 +417,7 @@ class ApplicationContext:
         self._next_listener_id += 1
         ret = Listener(
             ucx_api.UCXListener.create(
-                worker=self.worker,
+                worker=self.select_worker(port),
                 port=port,
                 cb_func=_listener_handler,
                 cb_args=(
@@ -344,11 +472,12 @@ class ApplicationContext:
         """
         self.continuous_ucx_progress()
 
+        worker = self.select_worker(ip_address, port)
         ucx_ep = ucx_api.UCXEndpoint.create(
-            self.worker, ip_address, port, endpoint_error_handling
+            worker, ip_address, port, endpoint_error_handling
         )
         if not self.progress_mode.startswith("thread"):
-            self.worker.progress()
+            worker.progress()
 
         # We create the Endpoint in three steps:
         #  1) Generate unique IDs to use as tags
@@ -357,19 +486,28 @@ class ApplicationContext:
         seed = os.urandom(16)
         msg_tag = hash64bits("msg_tag", seed, ucx_ep.handle)
         ctrl_tag = hash64bits("ctrl_tag", seed, ucx_ep.handle)
-        try:
-            peer_info = await exchange_peer_info(
+        if self.exchange_peer_info_mode == "one-way":
+            peer_info = await exchange_peer_info_one_way(
                 endpoint=ucx_ep,
                 msg_tag=msg_tag,
                 ctrl_tag=ctrl_tag,
                 listener=False,
                 stream_timeout=exchange_peer_info_timeout,
             )
-        except UCXMessageTruncatedError:
-            # A truncated message occurs if the remote endpoint closed before
-            # exchanging peer info, in that case we should raise the endpoint
-            # error instead.
-            ucx_ep.raise_on_error()
+        else:
+            try:
+                peer_info = await exchange_peer_info(
+                    endpoint=ucx_ep,
+                    msg_tag=msg_tag,
+                    ctrl_tag=ctrl_tag,
+                    listener=False,
+                    stream_timeout=exchange_peer_info_timeout,
+                )
+            except UCXMessageTruncatedError:
+                # A truncated message occurs if the remote endpoint closed before
+                # exchanging peer info, in that case we should raise the endpoint
+                # error instead.
+                ucx_ep.raise_on_error()
         tags = {
             "msg_send": peer_info["msg_tag"],
             "msg_recv": msg_tag,
@@ -417,13 +555,14 @@ class ApplicationContext:
         """
         self.continuous_ucx_progress()
 
+        worker = self.select_worker(hash(address))
         ucx_ep = ucx_api.UCXEndpoint.create_from_worker_address(
-            self.worker,
+            worker,
             address,
             endpoint_error_handling,
         )
         if not self.progress_mode.startswith("thread"):
-            self.worker.progress()
+            worker.progress()
 
         ep = Endpoint(endpoint=ucx_ep, ctx=self, tags=None)
 
@@ -434,6 +573,36 @@ class ApplicationContext:
 
         return ep
 
+    async def close_endpoints(self, endpoints):
+        """Close multiple endpoints concurrently
+
+        Close all `endpoints` without telling peers to shutdown, like
+        `Endpoint.abort()`, but without blocking the event loop, and submitting
+        all closes together so that closing many endpoints takes as long as
+        closing the slowest of them.
+
+        Parameters
+        ----------
+        endpoints: iterable of Endpoint
+            The endpoints to close, endpoints already closed are ignored.
+        """
+        endpoints = [ep for ep in endpoints if ep._ep is not None]
+        requests = []
+        for worker in self.workers:
+            requests += [
+                req
+                for req in worker.close_endpoints(
+                    [ep._ep for ep in endpoints if ep._worker is worker]
+                )
+                if req is not None
+            ]
+        try:
+            await asyncio.gather(*requests)
+        finally:
+            for ep in endpoints:
+                ep._ep = None
+                ep._ctx = None
+
     def continuous_ucx_progress(self, event_loop=None):
         """Guarantees continuous UCX progress
 
@@ -454,14 +623,17 @@ class ApplicationContext:
         if loop in self.progress_tasks:
             return  # Progress has already been guaranteed for the current event loop
 
-        if self.progress_mode == "thread":
-            task = ThreadMode(self.worker, loop, polling_mode=False)
-        elif self.progress_mode == "thread-polling":
-            task = ThreadMode(self.worker, loop, polling_mode=True)
-        elif self.progress_mode == "polling":
-            task = PollingMode(self.worker, loop)
-
-        self.progress_tasks.append(task)
+        for worker in self.workers:
+            if self.progress_mode == "thread":
+                task = ThreadMode(worker, loop, polling_mode=False)
+            elif self.progress_mode == "thread-polling":
+                task = ThreadMode(worker, loop, polling_mode=True)
+            elif self.progress_mode == "polling":
+                task = PollingMode(worker, loop)
+            elif self.progress_mode == "blocking":
+                task = BlockingMode(worker, loop)
+
+            self.progress_tasks.append(task)
 
     def get_ucp_worker(self):
         """Returns the underlying UCP worker handle (ucp_worker_h)
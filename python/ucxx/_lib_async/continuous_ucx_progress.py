@@ -3,6 +3,8 @@
 
 
 import asyncio
+import socket
+import weakref
 
 
 class ProgressTask(object):
@@ -39,16 +41,10 @@ class ProgressTask(object):
         return hash(self) == hash(other)
 
 
-def _create_context():
-    import numba.cuda
-
-    numba.cuda.current_context()
-
-
 class ThreadMode(ProgressTask):
     def __init__(self, worker, event_loop, polling_mode=False):
         super().__init__(worker, event_loop)
-        worker.set_progress_thread_start_callback(_create_context)
+        worker.set_progress_thread_cuda_device()
         worker.start_progress_thread(polling_mode=polling_mode, epoll_timeout=1)
 
     def __del__(self):
@@ -70,3 +66,66 @@ class PollingMode(ProgressTask):
             worker.progress()
             # Give other co-routines a chance to run.
             await asyncio.sleep(0)
+
+
+class BlockingMode(ProgressTask):
+    def __init__(self, worker, event_loop):
+        """Progress the worker only when its epoll file descriptor is readable
+
+        The worker's epoll file descriptor is registered with the event loop via
+        `add_reader()`, so that UCX is only progressed when events arrive, without
+        additional threads or busy-looping on `worker.progress()`.
+        """
+        super().__init__(worker, event_loop)
+        worker.init_blocking_progress_mode()
+        epoll_fd = worker.epoll_file_descriptor
+
+        # Creating a job that is ready straightaway but with low priority.
+        # Calling `await self.event_loop.sock_recv(self.rsock, 1)` will
+        # return when all non-IO tasks are finished.
+        # See <https://stackoverflow.com/a/48491563>.
+        self.rsock, wsock = socket.socketpair()
+        self.rsock.setblocking(0)
+        wsock.setblocking(0)
+        wsock.close()
+
+        event_loop.add_reader(epoll_fd, self._fd_reader_callback)
+
+        # Remove the reader and close socket on finalization
+        weakref.finalize(self, event_loop.remove_reader, epoll_fd)
+        weakref.finalize(self, self.rsock.close)
+
+        # Events may have arrived before the reader was registered
+        self._fd_reader_callback()
+
+    def _fd_reader_callback(self):
+        worker = self.worker
+        if worker is None:
+            return
+        worker.progress()
+
+        # Only a single arm task is needed, a pending one will progress again before arming
+        if self.asyncio_task is None or self.asyncio_task.done():
+            self.asyncio_task = self.event_loop.create_task(self._arm_worker())
+
+    async def _arm_worker(self):
+        # When arming the worker, the following must be true:
+        #  - No more progress in UCX (see doc of ucp_worker_arm())
+        #  - All asyncio tasks that aren't waiting on UCX must be executed
+        #    so that the asyncio's next state is epoll wait.
+        while True:
+            worker = self.worker
+            if worker is None:
+                return
+            worker.progress()
+            del worker
+
+            # This IO task returns when all non-IO tasks are finished.
+            await self.event_loop.sock_recv(self.rsock, 1)
+
+            worker = self.worker
+            if worker is None:
+                return
+            if worker.arm():
+                # At this point we know that asyncio's next state is epoll wait.
+                break
@@ -8,14 +8,35 @@ import logging
 import warnings
 
 import ucxx._lib.libucxx as ucx_api
-from ucxx._lib.arr import Array
+from ucxx._lib.arr import Array, frames_info
 from ucxx._lib.libucxx import UCXCanceled, UCXCloseError, UCXError
 from ucxx.types import Tag, TagMaskFull
 
-from .utils import hash64bits
+from . import serialize
 
 logger = logging.getLogger("ucx")
 
+# Active message ID reserved for objects sent by `Endpoint.send_obj(am=True)`,
+# registered with all workers of the `ApplicationContext`.
+OBJ_AM_ID = 0xFFF0
+
+
+def _copy_obj(dst, src):
+    """Copy the received `src` into `dst`, either may be host or CUDA memory"""
+    dst, src = Array(dst), Array(src)
+    if dst.nbytes < src.nbytes:
+        raise ValueError("The allocated buffer is smaller than the received object")
+    if src.nbytes == 0:
+        return
+    if not dst.cuda and not src.cuda:
+        memoryview(dst.obj).cast("B")[: src.nbytes] = memoryview(src.obj).cast("B")
+    else:
+        import cupy
+
+        cupy.cuda.runtime.memcpy(
+            dst.ptr, src.ptr, src.nbytes, cupy.cuda.runtime.memcpyDefault
+        )
+
 
 class Endpoint:
     """An endpoint represents a connection to a peer
@@ -34,12 +55,16 @@ class Endpoint:
 
         self._ep = endpoint
         self._ctx = ctx
+        self._worker = ctx._get_endpoint_worker(endpoint)
         self._send_count = 0  # Number of calls to self.send()
         self._recv_count = 0  # Number of calls to self.recv()
         self._finished_recv_count = 0  # Number of returned (finished) self.recv() calls
         self._shutting_down_peer = False  # Told peer to shutdown
         self._close_after_n_recv = None
         self._tags = tags
+        if tags is not None:
+            # User tags are derived from the message tags by the C++ endpoint.
+            self._ep.set_tag_bases(Tag(tags["msg_send"]), Tag(tags["msg_recv"]))
 
     def __del__(self):
         self.abort()
@@ -61,7 +86,7 @@ class Endpoint:
     @property
     def ucp_worker(self):
         """The underlying UCP worker handle (ucp_worker_h) as a Python integer."""
-        return self._ctx.worker.handle
+        return self._worker.handle
 
     @property
     def ucxx_endpoint(self):
@@ -75,7 +100,14 @@ class Endpoint:
         """Returns the underlying UCXX worker pointer (ucxx::Worker*)
         as a Python integer.
         """
-        return self._ctx.worker.ucxx_ptr
+        return self._worker.ucxx_ptr
+
+    @property
+    def statistics(self):
+        """Snapshot of the statistics of the underlying UCXX endpoint, see
+        ``UCXEndpoint.statistics``.
+        """
+        return self._ep.statistics
 
     @property
     def uid(self):
@@ -108,12 +140,18 @@ class Endpoint:
         """
         if self._ep is not None:
             logger.debug("Endpoint.abort(): 0x%x" % self.uid)
+        self._close(period=period, max_attempts=max_attempts)
+
+    def _close(self, period, max_attempts, flush_timeout=None):
+        if self._ep is not None:
             # Wait for a maximum of `period` ns
-            self._ep.close(period=period, max_attempts=max_attempts)
+            self._ep.close(
+                period=period, max_attempts=max_attempts, flush_timeout=flush_timeout
+            )
         self._ep = None
         self._ctx = None
 
-    async def close(self, period=10**10, max_attempts=1):
+    async def close(self, period=10**10, max_attempts=1, flush_timeout=None):
         """Close the endpoint cleanly.
         This will attempt to flush outgoing buffers before actually
         closing the underlying UCX endpoint.
@@ -131,6 +169,11 @@ class Endpoint:
         max_attempts: int
             maximum number of attempts to close endpoint, only applicable
             if worker is running a progress thread and `period > 0`.
+        flush_timeout: int or None
+            if not `None`, maximum period to wait (in ns) for outstanding
+            send operations to complete before closing the endpoint gracefully,
+            after which they are canceled. If `None` (default), outstanding
+            operations are canceled immediately.
         """
         if self.closed:
             self.abort(period=period, max_attempts=max_attempts)
@@ -145,11 +188,17 @@ class Endpoint:
             if not self.closed:
                 # Give all current outstanding send() calls a chance to return
                 if not self._ctx.progress_mode.startswith("thread"):
-                    self._ctx.worker.progress()
+                    self._worker.progress()
                 await asyncio.sleep(0)
-                self.abort(period=period, max_attempts=max_attempts)
-
-    async def am_send(self, buffer):
+                if self._ep is not None:
+                    logger.debug("Endpoint.close(): 0x%x" % self.uid)
+                self._close(
+                    period=period,
+                    max_attempts=max_attempts,
+                    flush_timeout=flush_timeout,
+                )
+
+    async def am_send(self, buffer, am_id=0):
         """Send `buffer` to connected peer via active messages.
 
         Parameters
@@ -157,6 +206,9 @@ class Endpoint:
         buffer: exposing the buffer protocol or array/cuda interface
             The buffer to send. Raise ValueError if buffer is smaller
             than nbytes.
+        am_id: int
+            The active message ID to send to, must be registered with the worker of
+            the peer, received there with `am_recv(am_id=am_id)`.
         """
         self._ep.raise_on_error()
         if self.closed:
@@ -178,8 +230,8 @@ class Endpoint:
         self._send_count += 1
 
         try:
-            request = self._ep.am_send(buffer)
-            return await request.wait()
+            request = self._ep.am_send(buffer, am_id=am_id)
+            return await request
         except UCXCanceled as e:
             # If self._ep has already been closed and destroyed, we reraise the
             # UCXCanceled exception.
@@ -197,12 +249,12 @@ class Endpoint:
             than nbytes.
         tag: hashable, optional
             Set a tag that the receiver must match. Currently the tag
-            is hashed together with the internal Endpoint tag that is
+            is combined with the internal Endpoint tag that is
             agreed with the remote end at connection time. To enforce
             using the user tag, make sure to specify `force_tag=True`.
         force_tag: bool
             If true, force using `tag` as is, otherwise the value
-            specified with `tag` (if any) will be hashed with the
+            specified with `tag` (if any) will be combined with the
             internal Endpoint tag.
         """
         self._ep.raise_on_error()
@@ -213,7 +265,7 @@ class Endpoint:
         if tag is None:
             tag = self._tags["msg_send"]
         elif not force_tag:
-            tag = hash64bits(self._tags["msg_send"], hash(tag))
+            tag = self._ep.derive_send_tag(tag)
         if not isinstance(tag, Tag):
             tag = Tag(tag)
 
@@ -233,14 +285,14 @@ class Endpoint:
 
         try:
             request = self._ep.tag_send(buffer, tag)
-            return await request.wait()
+            return await request
         except UCXCanceled as e:
             # If self._ep has already been closed and destroyed, we reraise the
             # UCXCanceled exception.
             if self._ep is None:
                 raise e
 
-    async def send_multi(self, buffers, tag=None, force_tag=False):
+    async def send_multi(self, buffers, tag=None, force_tag=False, pack_threshold=0):
         """Send `buffer` to connected peer.
 
         Parameters
@@ -250,24 +302,28 @@ class Endpoint:
             than nbytes.
         tag: hashable, optional
             Set a tag that the receiver must match. Currently the tag
-            is hashed together with the internal Endpoint tag that is
+            is combined with the internal Endpoint tag that is
             agreed with the remote end at connection time. To enforce
             using the user tag, make sure to specify `force_tag=True`.
         force_tag: bool
             If true, force using `tag` as is, otherwise the value
-            specified with `tag` (if any) will be hashed with the
+            specified with `tag` (if any) will be combined with the
             internal Endpoint tag.
+        pack_threshold: int
+            Host buffers of up to `pack_threshold` bytes are packed together into a
+            single message instead of one message each, reducing the number of
+            network operations when sending many small buffers. Packed messages can
+            be received by any `recv_multi()`. `0` (default) disables packing.
         """
         self._ep.raise_on_error()
         if self.closed:
             raise UCXCloseError("Endpoint closed")
         if not (isinstance(buffers, list) or isinstance(buffers, tuple)):
             raise ValueError("The `buffers` argument must be a `list` or `tuple`")
-        buffers = tuple([Array(b) if not isinstance(b, Array) else b for b in buffers])
         if tag is None:
             tag = self._tags["msg_send"]
         elif not force_tag:
-            tag = hash64bits(self._tags["msg_send"], hash(tag))
+            tag = self._ep.derive_send_tag(tag)
         if not isinstance(tag, Tag):
             tag = Tag(tag)
 
@@ -277,15 +333,17 @@ class Endpoint:
                 self._send_count,
                 self.uid,
                 tag.value,
-                tuple([b.nbytes for b in buffers]),  # nbytes,
-                tuple([type(b.obj) for b in buffers]),
+                frames_info(buffers)[1],  # nbytes,
+                tuple([type(b.obj if isinstance(b, Array) else b) for b in buffers]),
             )
             logger.debug(log)
 
         self._send_count += 1
 
         try:
-            buffer_requests = self._ep.tag_send_multi(buffers, tag)
+            buffer_requests = self._ep.tag_send_multi(
+                buffers, tag, pack_threshold=pack_threshold
+            )
             await buffer_requests.wait()
             buffer_requests.check_error()
         except UCXCanceled as e:
@@ -294,11 +352,11 @@ class Endpoint:
             if self._ep is None:
                 raise e
 
-    async def send_obj(self, obj, tag=None):
+    async def send_obj(self, obj, tag=None, am=False):
         """Send `obj` to connected peer that calls `recv_obj()`.
 
         The transfer includes an extra message containing the size of `obj`,
-        which increases the overhead slightly.
+        which increases the overhead slightly, unless `am=True`.
 
         Parameters
         ----------
@@ -306,20 +364,37 @@ class Endpoint:
             The object to send.
         tag: hashable, optional
             Set a tag that the receiver must match.
+        am: bool, optional
+            Send `obj` as a single active message instead, which the peer must
+            receive with `recv_obj(am=True)`. Peers predating this option do not
+            receive it, thus it must only be used when all peers support it.
+            Cannot be combined with `tag`.
 
         Example
         -------
         >>> await ep.send_obj(pickle.dumps([1,2,3]))
         """
+        if am and tag is not None:
+            raise ValueError("Objects sent as active messages cannot be tagged")
         if not isinstance(obj, Array):
             obj = Array(obj)
+        if am:
+            # The receiver learns the size from the active message itself.
+            await self.am_send(obj, am_id=OBJ_AM_ID)
+            return
         nbytes = Array(array.array("Q", [obj.nbytes]))
         await self.send(nbytes, tag=tag)
         await self.send(obj, tag=tag)
 
-    async def am_recv(self):
-        """Receive from connected peer via active messages."""
-        if not self._ep.am_probe():
+    async def am_recv(self, am_id=0):
+        """Receive from connected peer via active messages.
+
+        Parameters
+        ----------
+        am_id: int
+            The active message ID to receive from, must be registered with the worker.
+        """
+        if not self._ep.am_probe(am_id):
             self._ep.raise_on_error()
             if self.closed:
                 raise UCXCloseError("Endpoint closed")
@@ -334,8 +409,8 @@ class Endpoint:
 
         self._recv_count += 1
 
-        req = self._ep.am_recv()
-        await req.wait()
+        req = self._ep.am_recv(am_id=am_id)
+        await req
         buffer = req.recv_buffer
 
         if logger.isEnabledFor(logging.DEBUG):
@@ -366,19 +441,19 @@ class Endpoint:
             is smaller than nbytes or read-only.
         tag: hashable, optional
             Set a tag that must match the received message. Currently
-            the tag is hashed together with the internal Endpoint tag
+            the tag is combined with the internal Endpoint tag
             that is agreed with the remote end at connection time.
             To enforce using the user tag, make sure to specify
             `force_tag=True`.
         force_tag: bool
             If true, force using `tag` as is, otherwise the value
-            specified with `tag` (if any) will be hashed with the
+            specified with `tag` (if any) will be combined with the
             internal Endpoint tag.
         """
         if tag is None:
             tag = self._tags["msg_recv"]
         elif not force_tag:
-            tag = hash64bits(self._tags["msg_recv"], hash(tag))
+            tag = self._ep.derive_recv_tag(tag)
         if not isinstance(tag, Tag):
             tag = Tag(tag)
 
@@ -389,7 +464,7 @@ class Endpoint:
         except Exception as e:
             # Only probe the worker as last resort. To be reliable, probing for the tag
             # requires progressing the worker, thus prevent that happening too often.
-            if not self._ctx.worker.tag_probe(tag):
+            if not self._worker.tag_probe(tag):
                 raise e
 
         if not isinstance(buffer, Array):
@@ -410,7 +485,7 @@ class Endpoint:
         self._recv_count += 1
 
         req = self._ep.tag_recv(buffer, tag, TagMaskFull)
-        ret = await req.wait()
+        ret = await req
 
         self._finished_recv_count += 1
         if (
@@ -427,19 +502,19 @@ class Endpoint:
         ----------
         tag: hashable, optional
             Set a tag that must match the received message. Currently
-            the tag is hashed together with the internal Endpoint tag
+            the tag is combined with the internal Endpoint tag
             that is agreed with the remote end at connection time.
             To enforce using the user tag, make sure to specify
             `force_tag=True`.
         force_tag: bool
             If true, force using `tag` as is, otherwise the value
-            specified with `tag` (if any) will be hashed with the
+            specified with `tag` (if any) will be combined with the
             internal Endpoint tag.
         """
         if tag is None:
             tag = self._tags["msg_recv"]
         elif not force_tag:
-            tag = hash64bits(self._tags["msg_recv"], hash(tag))
+            tag = self._ep.derive_recv_tag(tag)
         if not isinstance(tag, Tag):
             tag = Tag(tag)
 
@@ -450,7 +525,7 @@ class Endpoint:
         except Exception as e:
             # Only probe the worker as last resort. To be reliable, probing for the tag
             # requires progressing the worker, thus prevent that happening too often.
-            if not self._ctx.worker.tag_probe(tag):
+            if not self._worker.tag_probe(tag):
                 raise e
 
         # Optimization to eliminate producing logger string overhead
@@ -479,14 +554,14 @@ class Endpoint:
             self.abort()
         return buffers
 
-    async def recv_obj(self, tag=None, allocator=bytearray):
+    async def recv_obj(self, tag=None, allocator=bytearray, am=False):
         """Receive from connected peer that calls `send_obj()`.
 
         As opposed to `recv()`, this function returns the received object.
         Data is received into a buffer allocated by `allocator`.
 
         The transfer includes an extra message containing the size of `obj`,
-        which increases the overhead slightly.
+        which increases the overhead slightly, unless `am=True`.
 
         Parameters
         ----------
@@ -498,11 +573,22 @@ class Endpoint:
             Function to allocate the received object. The function should
             take the number of bytes to allocate as input and return a new
             buffer of that size as output.
+        am: bool, optional
+            Receive an object the peer sent with `send_obj(am=True)`, as a single
+            active message that is then copied into the buffer allocated by
+            `allocator`, in host or CUDA memory. Cannot be combined with `tag`.
 
         Example
         -------
         >>> await pickle.loads(ep.recv_obj())
         """
+        if am and tag is not None:
+            raise ValueError("Objects sent as active messages cannot be tagged")
+        if am:
+            buffer = await self.am_recv(am_id=OBJ_AM_ID)
+            ret = allocator(buffer.nbytes)
+            _copy_obj(ret, buffer)
+            return ret
         nbytes = array.array("Q", [0])
         await self.recv(nbytes, tag=tag)
         nbytes = nbytes[0]
@@ -510,6 +596,55 @@ class Endpoint:
         await self.recv(ret, tag=tag)
         return ret
 
+    async def send_pickled(self, obj, tag=None, force_tag=False, pack_threshold=0):
+        """Send a Python object to connected peer that calls `recv_pickled()`.
+
+        The object is serialized with pickle protocol 5, its buffers exposing the
+        buffer protocol (e.g., NumPy arrays) and C-contiguous CuPy arrays are gathered
+        out-of-band and sent as individual frames with `send_multi()`, without copying
+        them into a contiguous buffer.
+
+        Parameters
+        ----------
+        obj: object
+            The object to send, must be picklable.
+        tag: hashable, optional
+            Set a tag that the receiver must match, see `send_multi()`.
+        force_tag: bool
+            If true, force using `tag` as is, see `send_multi()`.
+        pack_threshold: int
+            Pack host frames of up to `pack_threshold` bytes together, see
+            `send_multi()`.
+
+        Example
+        -------
+        >>> await ep.send_pickled({"data": numpy.arange(10**6)})
+        """
+        frames = serialize.dumps(obj)
+        await self.send_multi(
+            frames, tag=tag, force_tag=force_tag, pack_threshold=pack_threshold
+        )
+
+    async def recv_pickled(self, tag=None, force_tag=False):
+        """Receive a Python object from connected peer that calls `send_pickled()`.
+
+        Out-of-band buffers are reconstructed directly on the received frames without
+        intermediate copies, CUDA frames are reconstructed as CuPy arrays.
+
+        Parameters
+        ----------
+        tag: hashable, optional
+            Set a tag that must match the received message, see `recv_multi()`.
+        force_tag: bool
+            If true, force using `tag` as is, see `recv_multi()`.
+
+        Example
+        -------
+        >>> obj = await ep.recv_pickled()
+        """
+        frames = await self.recv_multi(tag=tag, force_tag=force_tag)
+        return serialize.loads(frames)
+
     def get_ucp_worker(self):
         """Returns the underlying UCP worker handle (ucp_worker_h)
         as a Python integer.
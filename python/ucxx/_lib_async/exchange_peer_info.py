@@ -4,6 +4,7 @@
 
 import asyncio
 import logging
+import os
 import struct
 
 from ucxx._lib.arr import Array
@@ -48,3 +49,72 @@ async def exchange_peer_info(endpoint, msg_tag, ctrl_tag, listener, stream_timeo
         )
 
     return ret
+
+
+async def exchange_peer_info_one_way(
+    endpoint, msg_tag, ctrl_tag, listener, stream_timeout=5.0
+):
+    """Help function that sends endpoint information from client to listener
+
+    Unlike `exchange_peer_info()`, the client chooses the tags of both ends and
+    sends them to the listener in a single message, the listener doesn't reply.
+    The client doesn't wait for the listener and the listener waits only for the
+    message in flight, instead of a full round trip. The tags chosen by the client
+    are random 64-bit values, just as the ones chosen locally by the listener
+    would be. Both ends of an endpoint must use the same exchange mode.
+
+    Returns
+    -------
+    dict
+        The peer's `msg_tag` and `ctrl_tag`, to send to, and the `local_msg_tag`
+        and `local_ctrl_tag` to receive from the peer. For the client the latter
+        are the `msg_tag` and `ctrl_tag` arguments, for the listener they are
+        chosen by the client and the arguments are ignored.
+    """
+
+    fmt = "QQQQQ"
+    info = bytearray(struct.calcsize(fmt))
+    info_arr = Array(info)
+
+    if listener is True:
+        req = endpoint.stream_recv(info_arr)
+        await asyncio.wait_for(req.wait(), timeout=stream_timeout)
+
+        ret = {}
+        (
+            ret["msg_tag"],
+            ret["ctrl_tag"],
+            ret["local_msg_tag"],
+            ret["local_ctrl_tag"],
+            checksum,
+        ) = struct.unpack(fmt, info)
+
+        expected_checksum = hash64bits(
+            ret["msg_tag"], ret["ctrl_tag"], ret["local_msg_tag"], ret["local_ctrl_tag"]
+        )
+        if expected_checksum != checksum:
+            raise RuntimeError(
+                f"Checksum invalid! {hex(expected_checksum)} != {hex(checksum)}"
+            )
+    else:
+        seed = os.urandom(16)
+        ret = {
+            "msg_tag": hash64bits("msg_tag", seed, msg_tag),
+            "ctrl_tag": hash64bits("ctrl_tag", seed, ctrl_tag),
+            "local_msg_tag": msg_tag,
+            "local_ctrl_tag": ctrl_tag,
+        }
+        struct.pack_into(
+            fmt,
+            info,
+            0,
+            msg_tag,
+            ctrl_tag,
+            ret["msg_tag"],
+            ret["ctrl_tag"],
+            hash64bits(msg_tag, ctrl_tag, ret["msg_tag"], ret["ctrl_tag"]),
+        )
+        req = endpoint.stream_send(info_arr)
+        await asyncio.wait_for(req.wait(), timeout=stream_timeout)
+
+    return ret
@@ -10,7 +10,7 @@ import ucxx._lib.libucxx as ucx_api
 from ucxx.exceptions import UCXMessageTruncatedError
 
 from .endpoint import Endpoint
-from .exchange_peer_info import exchange_peer_info
+from .exchange_peer_info import exchange_peer_info, exchange_peer_info_one_way
 from .utils import hash64bits
 
 logger = logging.getLogger("ucx")
@@ -141,13 +141,25 @@ async def _listener_handler_coroutine(
     ctrl_tag = hash64bits("ctrl_tag", seed, endpoint.handle)
 
     try:
-        peer_info = await exchange_peer_info(
-            endpoint=endpoint,
-            msg_tag=msg_tag,
-            ctrl_tag=ctrl_tag,
-            listener=True,
-            stream_timeout=exchange_peer_info_timeout,
-        )
+        if ctx.exchange_peer_info_mode == "one-way":
+            peer_info = await exchange_peer_info_one_way(
+                endpoint=endpoint,
+                msg_tag=msg_tag,
+                ctrl_tag=ctrl_tag,
+                listener=True,
+                stream_timeout=exchange_peer_info_timeout,
+            )
+            # Tags to receive from the client were chosen by the client
+            msg_tag = peer_info["local_msg_tag"]
+            ctrl_tag = peer_info["local_ctrl_tag"]
+        else:
+            peer_info = await exchange_peer_info(
+                endpoint=endpoint,
+                msg_tag=msg_tag,
+                ctrl_tag=ctrl_tag,
+                listener=True,
+                stream_timeout=exchange_peer_info_timeout,
+            )
     except UCXMessageTruncatedError:
         # A truncated message occurs if the remote endpoint closed before
         # exchanging peer info, in that case we should raise the endpoint
@@ -0,0 +1,90 @@
+# SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Serialization of Python objects into frames with pickle protocol 5.
+
+Buffers of the object exposing the buffer protocol, such as NumPy arrays, are gathered
+out-of-band by ``buffer_callback`` and C-contiguous CuPy arrays by ``persistent_id``,
+each becoming a frame of its own that can be sent and received without copies. The
+first frame holds the pickled object, followed by the host and then the CUDA frames.
+"""
+
+import io
+import pickle
+
+_CUDA_FRAME = "ucxx-cuda-frame"
+
+
+def _is_cuda_frame(frame):
+    return hasattr(frame, "__cuda_array_interface__")
+
+
+class _OutOfBandPickler(pickle.Pickler):
+    def __init__(self, file, host_frames, cuda_frames):
+        super().__init__(file, protocol=5, buffer_callback=self._buffer_callback)
+        self._host_frames = host_frames
+        self._cuda_frames = cuda_frames
+
+    def _buffer_callback(self, buffer):
+        # Returning a true value serializes the buffer in-band.
+        try:
+            raw = buffer.raw()
+        except BufferError:
+            return True
+        if raw.nbytes == 0:
+            return True
+        self._host_frames.append(raw)
+        return False
+
+    def persistent_id(self, obj):
+        if (
+            type(obj).__module__.startswith("cupy")
+            and _is_cuda_frame(obj)
+            and obj.nbytes > 0
+            and obj.flags.c_contiguous
+        ):
+            self._cuda_frames.append(obj)
+            return (_CUDA_FRAME, len(self._cuda_frames) - 1, obj.shape, obj.dtype.str)
+        return None
+
+
+class _OutOfBandUnpickler(pickle.Unpickler):
+    def __init__(self, file, host_frames, cuda_frames):
+        super().__init__(file, buffers=host_frames)
+        self._cuda_frames = cuda_frames
+
+    def persistent_load(self, pid):
+        if not isinstance(pid, tuple) or len(pid) != 4 or pid[0] != _CUDA_FRAME:
+            raise pickle.UnpicklingError(f"Unsupported persistent ID: {pid!r}")
+        import cupy
+
+        _, index, shape, dtype = pid
+        return cupy.asarray(self._cuda_frames[index]).view(dtype).reshape(shape)
+
+
+def dumps(obj):
+    """Serialize ``obj`` into a list of frames.
+
+    Returns
+    -------
+    A list whose first element is the pickled object, followed by its out-of-band host
+    buffers and then its out-of-band CUDA arrays, in the order they were pickled.
+    """
+    host_frames = []
+    cuda_frames = []
+    file = io.BytesIO()
+    _OutOfBandPickler(file, host_frames, cuda_frames).dump(obj)
+    return [file.getbuffer()] + host_frames + cuda_frames
+
+
+def loads(frames):
+    """Deserialize an object from frames produced by ``dumps()``.
+
+    Out-of-band buffers are reconstructed as views of the frames, without copies.
+    """
+    host_frames = []
+    cuda_frames = []
+    for frame in frames[1:]:
+        (cuda_frames if _is_cuda_frame(frame) else host_frames).append(frame)
+    file = io.BytesIO(memoryview(frames[0]).cast("B"))
+    return _OutOfBandUnpickler(file, host_frames, cuda_frames).load()
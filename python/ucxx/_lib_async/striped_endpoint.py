@@ -0,0 +1,161 @@
+# SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+# SPDX-License-Identifier: BSD-3-Clause
+
+
+import asyncio
+import ctypes
+import logging
+
+from ucxx._lib.arr import Array
+
+from .endpoint import Endpoint
+
+logger = logging.getLogger("ucx")
+
+
+class _CudaBufferSlice:
+    """Contiguous byte range of a CUDA buffer exposing `__cuda_array_interface__`"""
+
+    def __init__(self, buffer, offset, nbytes):
+        self._owner = buffer  # Keep the original buffer alive
+        self.__cuda_array_interface__ = {
+            "data": (buffer.ptr + offset, buffer.readonly),
+            "shape": (nbytes,),
+            "strides": None,
+            "typestr": "|u1",
+            "version": 3,
+        }
+
+
+def _buffer_slice(buffer, offset, nbytes):
+    """Get an `Array` of `nbytes` starting at `offset` bytes of `buffer` without copy"""
+    if buffer.cuda:
+        return Array(_CudaBufferSlice(buffer, offset, nbytes))
+    else:
+        # The slice does not own the memory, `buffer` must be kept alive by the caller
+        return Array((ctypes.c_ubyte * nbytes).from_address(buffer.ptr + offset))
+
+
+class StripedEndpoint:
+    """Stripe large transfers over multiple endpoints connected to the same peer
+
+    Buffers of at least `stripe_threshold` bytes are split into one contiguous
+    stripe per endpoint (rail), which are all transferred concurrently, each
+    rail possibly belonging to a different worker or using a different network
+    device. The receiver reassembles the stripes directly into the destination
+    buffer, without any intermediate copies. Smaller buffers are transferred
+    entirely over the first rail.
+
+    Both peers must create their `StripedEndpoint` with the same number of rails,
+    in the same order, and the same `stripe_threshold`, for example by having
+    the client send the index of each rail after connecting. Buffers must be
+    contiguous and the receive buffer must have the same size as the send buffer.
+
+    Parameters
+    ----------
+    endpoints: list or tuple of Endpoint
+        The endpoints connected to the same peer to stripe transfers over.
+    stripe_threshold: int
+        Minimum size in bytes of a buffer for its transfer to be striped.
+    """
+
+    def __init__(self, endpoints, stripe_threshold=2**22):
+        if not isinstance(endpoints, (list, tuple)) or len(endpoints) == 0:
+            raise ValueError("`endpoints` must be a non-empty `list` or `tuple`")
+        if not all(isinstance(ep, Endpoint) for ep in endpoints):
+            raise ValueError("All endpoints must be instances of `Endpoint`")
+        if stripe_threshold < 0:
+            raise ValueError("`stripe_threshold` must be non-negative")
+
+        self._endpoints = tuple(endpoints)
+        self._stripe_threshold = stripe_threshold
+
+    @property
+    def endpoints(self):
+        """The endpoints (rails) transfers are striped over."""
+        return self._endpoints
+
+    @property
+    def stripe_threshold(self):
+        return self._stripe_threshold
+
+    @property
+    def closed(self):
+        """Is any of the striped endpoints closed?"""
+        return any(ep.closed for ep in self._endpoints)
+
+    def _stripes(self, buffer):
+        nbytes = buffer.nbytes
+        n_rails = len(self._endpoints)
+        if n_rails == 1 or nbytes < self._stripe_threshold or nbytes < n_rails:
+            return [(self._endpoints[0], buffer)]
+
+        if not buffer.c_contiguous:
+            raise ValueError("Striped transfers require contiguous buffers")
+
+        stripe_size = -(-nbytes // n_rails)
+        return [
+            (ep, _buffer_slice(buffer, offset, min(stripe_size, nbytes - offset)))
+            for ep, offset in zip(self._endpoints, range(0, nbytes, stripe_size))
+        ]
+
+    async def send(self, buffer, tag=None, force_tag=False):
+        """Send `buffer` to connected peer, striped over all rails.
+
+        Parameters
+        ----------
+        buffer: exposing the buffer protocol or array/cuda interface
+            The buffer to send. Raise ValueError if buffer is smaller
+            than nbytes.
+        tag: hashable, optional
+            Set a tag that the receiver must match, see `Endpoint.send()`.
+        force_tag: bool
+            If true, force using `tag` as is, see `Endpoint.send()`.
+        """
+        if not isinstance(buffer, Array):
+            buffer = Array(buffer)
+        stripes = self._stripes(buffer)
+        if logger.isEnabledFor(logging.DEBUG):
+            logger.debug(
+                "[Striped Send] nbytes: %d, stripes: %s"
+                % (buffer.nbytes, tuple(s.nbytes for _, s in stripes))
+            )
+        await asyncio.gather(
+            *[ep.send(s, tag=tag, force_tag=force_tag) for ep, s in stripes]
+        )
+
+    async def recv(self, buffer, tag=None, force_tag=False):
+        """Receive from connected peer into `buffer`, striped over all rails.
+
+        Parameters
+        ----------
+        buffer: exposing the buffer protocol or array/cuda interface
+            The buffer to receive into. Raise ValueError if buffer
+            is smaller than nbytes or read-only.
+        tag: hashable, optional
+            Set a tag that must match the received message, see `Endpoint.recv()`.
+        force_tag: bool
+            If true, force using `tag` as is, see `Endpoint.recv()`.
+        """
+        if not isinstance(buffer, Array):
+            buffer = Array(buffer)
+        if buffer.readonly:
+            raise ValueError("Cannot receive into a read-only buffer")
+        stripes = self._stripes(buffer)
+        if logger.isEnabledFor(logging.DEBUG):
+            logger.debug(
+                "[Striped Recv] nbytes: %d, stripes: %s"
+                % (buffer.nbytes, tuple(s.nbytes for _, s in stripes))
+            )
+        await asyncio.gather(
+            *[ep.recv(s, tag=tag, force_tag=force_tag) for ep, s in stripes]
+        )
+
+    async def close(self):
+        """Close all striped endpoints, see `Endpoint.close()`."""
+        await asyncio.gather(*[ep.close() for ep in self._endpoints])
+
+    def abort(self):
+        """Abort all striped endpoints, see `Endpoint.abort()`."""
+        for ep in self._endpoints:
+            ep.abort()
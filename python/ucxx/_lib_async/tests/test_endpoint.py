@@ -92,3 +92,31 @@ async def test_cancel(transfer_api):
     ):
         await client_node(listener.port)
     listener.close()
+
+
+@pytest.mark.asyncio
+async def test_close_endpoints():
+    n_endpoints = 8
+    closed = [0]
+
+    def _close_callback():
+        closed[0] += 1
+
+    async def server_node(ep):
+        await ep.recv(bytearray(1))
+
+    listener = ucxx.create_listener(server_node)
+    eps = [
+        await ucxx.create_endpoint(ucxx.get_address(), listener.port)
+        for i in range(n_endpoints)
+    ]
+    for ep in eps:
+        ep.set_close_callback(_close_callback)
+
+    await ucxx.close_endpoints(eps)
+    assert closed[0] == n_endpoints
+    assert all(ep.closed for ep in eps)
+
+    # Closing again is a no-op
+    await ucxx.close_endpoints(eps)
+    listener.close()
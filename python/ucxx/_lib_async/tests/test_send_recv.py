@@ -1,9 +1,12 @@
 # SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES.
 # SPDX-License-Identifier: BSD-3-Clause
 
+import asyncio
 import functools
+import os
 
 import pytest
+from ucxx._lib.arr import Array
 from ucxx._lib_async.utils_test import wait_listener_client_handlers
 
 import ucxx
@@ -39,6 +42,28 @@ def make_echo_server(create_empty_data):
     return echo_server
 
 
+@pytest.mark.asyncio
+@pytest.mark.parametrize("size", [0, 2**20])
+async def test_send_recv_request_wait(size):
+    async def server(ep):
+        await ep.am_recv()
+        await ep.close()
+
+    listener = ucxx.create_listener(server)
+    client = await ucxx.create_endpoint(ucxx.get_address(), listener.port)
+
+    req = client._ep.am_send(Array(bytearray(size)))
+    wait = req.wait()
+    assert asyncio.iscoroutine(wait)
+    assert await asyncio.wait_for(wait, timeout=10) is None
+    # Completed requests are awaitable as well, returning the same value
+    assert await req is None
+    assert await req.wait() is None
+
+    await client.close()
+    await wait_listener_client_handlers(listener)
+
+
 @pytest.mark.asyncio
 @pytest.mark.parametrize("size", msg_sizes)
 async def test_send_recv_bytes(size):
@@ -159,18 +184,84 @@ async def test_send_recv_obj():
 
 
 @pytest.mark.asyncio
-async def test_send_recv_obj_numpy():
+@pytest.mark.parametrize("tag,am", [(None, False), (42, False), (None, True)])
+async def test_send_recv_obj_sizes(tag, am):
+    sizes = [0, 1, 1000, 100000]
+
+    async def echo_obj_server(ep):
+        for _ in sizes:
+            obj = await ep.recv_obj(tag=tag, am=am)
+            await ep.send_obj(obj, tag=tag, am=am)
+
+    listener = ucxx.create_listener(echo_obj_server)
+    client = await ucxx.create_endpoint(ucxx.get_address(), listener.port)
+
+    for size in sizes:
+        msg = bytearray(os.urandom(size))
+        await client.send_obj(msg, tag=tag, am=am)
+        got = await client.recv_obj(tag=tag, am=am)
+        assert msg == got
+    await wait_listener_client_handlers(listener)
+
+
+@pytest.mark.asyncio
+@pytest.mark.parametrize("am", [False, True])
+async def test_send_recv_obj_numpy(am):
     allocator = functools.partial(np.empty, dtype=np.uint8)
 
     async def echo_obj_server(ep):
-        obj = await ep.recv_obj(allocator=allocator)
-        await ep.send_obj(obj)
+        obj = await ep.recv_obj(allocator=allocator, am=am)
+        await ep.send_obj(obj, am=am)
 
     listener = ucxx.create_listener(echo_obj_server)
     client = await ucxx.create_endpoint(ucxx.get_address(), listener.port)
 
     msg = bytearray(b"hello")
-    await client.send_obj(msg)
-    got = await client.recv_obj(allocator=allocator)
+    await client.send_obj(msg, am=am)
+    got = await client.recv_obj(allocator=allocator, am=am)
     assert msg == got
     await wait_listener_client_handlers(listener)
+
+
+@pytest.mark.asyncio
+async def test_send_recv_pickled():
+    async def echo_pickled_server(ep):
+        obj = await ep.recv_pickled()
+        await ep.send_pickled(obj)
+
+    listener = ucxx.create_listener(echo_pickled_server)
+    client = await ucxx.create_endpoint(ucxx.get_address(), listener.port)
+
+    msg = {
+        "array": np.arange(10**6),
+        "strided": np.arange(100)[::2],
+        "empty": np.empty(0),
+        "list": [1, "two", 3.0],
+    }
+    await client.send_pickled(msg)
+    got = await client.recv_pickled()
+    assert got.keys() == msg.keys()
+    for key in ("array", "strided", "empty"):
+        np.testing.assert_array_equal(got[key], msg[key])
+    assert got["list"] == msg["list"]
+    await wait_listener_client_handlers(listener)
+
+
+@pytest.mark.asyncio
+async def test_send_recv_pickled_cupy():
+    cupy = pytest.importorskip("cupy")
+
+    async def echo_pickled_server(ep):
+        obj = await ep.recv_pickled()
+        await ep.send_pickled(obj)
+
+    listener = ucxx.create_listener(echo_pickled_server)
+    client = await ucxx.create_endpoint(ucxx.get_address(), listener.port)
+
+    msg = {"device": cupy.arange(10**6).reshape(1000, 1000), "host": np.arange(10)}
+    await client.send_pickled(msg)
+    got = await client.recv_pickled()
+    assert isinstance(got["device"], cupy.ndarray)
+    cupy.testing.assert_array_equal(got["device"], msg["device"])
+    np.testing.assert_array_equal(got["host"], msg["host"])
+    await wait_listener_client_handlers(listener)
@@ -95,3 +95,24 @@ async def test_send_recv_am(size, recv_wait, data):
 
     await asyncio.gather(*(c.close() for c in clients))
     await wait_listener_client_handlers(listener)
+
+
+@pytest.mark.asyncio
+async def test_send_recv_am_host_allocation():
+    ucxx.init()
+    ucxx.core._get_ctx().worker.set_host_allocation()
+
+    # Large enough to be backed by huge pages, thus viewed rather than freed by NumPy
+    msg = np.arange(2**20, dtype=np.int64)
+
+    listener = ucxx.create_listener(simple_server(msg.nbytes, []))
+    client = await ucxx.create_endpoint(ucxx.get_address(), listener.port)
+    await client.am_send(msg)
+    recv_msg = await client.am_recv()
+
+    assert isinstance(recv_msg, np.ndarray)
+    assert recv_msg.flags.writeable
+    np.testing.assert_equal(recv_msg.view(np.int64), msg)
+
+    await client.close()
+    await wait_listener_client_handlers(listener)
@@ -0,0 +1,68 @@
+# SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+# SPDX-License-Identifier: BSD-3-Clause
+
+import asyncio
+
+import pytest
+from ucxx._lib_async.utils_test import wait_listener_client_handlers
+
+import ucxx
+
+np = pytest.importorskip("numpy")
+
+msg_sizes = [0, 10, 2**20 + 1]
+
+
+@pytest.mark.asyncio
+@pytest.mark.parametrize("size", msg_sizes)
+@pytest.mark.parametrize("n_rails", [1, 3])
+async def test_striped_send_recv(size, n_rails):
+    ucxx.init(n_workers=2)
+
+    server_rails = [None] * n_rails
+    server_rails_ready = asyncio.Event()
+    server_done = asyncio.Event()
+
+    async def server_node(ep):
+        rail_index = np.empty(1, dtype=np.uint64)
+        await ep.recv(rail_index)
+        server_rails[int(rail_index[0])] = ep
+        if all(r is not None for r in server_rails):
+            server_rails_ready.set()
+        await server_done.wait()
+
+    async def echo():
+        await server_rails_ready.wait()
+        striped = ucxx.StripedEndpoint(server_rails, stripe_threshold=1024)
+        msg = np.empty(size, dtype=np.uint8)
+        await striped.recv(msg)
+        await striped.send(msg)
+        await striped.close()
+        server_done.set()
+
+    listener = ucxx.create_listener(server_node)
+    echo_task = asyncio.create_task(echo())
+
+    client_rails = []
+    for i in range(n_rails):
+        ep = await ucxx.create_endpoint(ucxx.get_address(), listener.port)
+        await ep.send(np.array([i], dtype=np.uint64))
+        client_rails.append(ep)
+    striped = ucxx.StripedEndpoint(client_rails, stripe_threshold=1024)
+
+    msg = np.arange(size, dtype=np.uint8)
+    resp = np.empty_like(msg)
+    await striped.send(msg)
+    await striped.recv(resp)
+    np.testing.assert_array_equal(resp, msg)
+
+    await echo_task
+    await striped.close()
+    await wait_listener_client_handlers(listener)
+
+
+def test_striped_endpoint_invalid_args():
+    with pytest.raises(ValueError, match="non-empty"):
+        ucxx.StripedEndpoint([])
+    with pytest.raises(ValueError, match="instances of `Endpoint`"):
+        ucxx.StripedEndpoint([object()])
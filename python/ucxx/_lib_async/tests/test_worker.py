@@ -5,9 +5,12 @@ import os
 from unittest.mock import patch
 
 import pytest
+from ucxx._lib_async.utils_test import wait_listener_client_handlers
 
 import ucxx
 
+np = pytest.importorskip("numpy")
+
 
 @pytest.mark.asyncio
 @pytest.mark.parametrize("enable_delayed_submission", [True, False])
@@ -66,3 +69,73 @@ async def test_worker_capabilities_env(enable_delayed_submission, enable_python_
                 assert worker.enable_python_future is enable_python_future
             else:
                 assert worker.enable_python_future is False
+
+
+@pytest.mark.asyncio
+@pytest.mark.parametrize("worker_selection", ["round-robin", "hash"])
+async def test_multiple_workers(worker_selection):
+    ucxx.init(n_workers=2, worker_selection=worker_selection)
+
+    ctx = ucxx.core._get_ctx()
+    assert len(ctx.workers) == 2
+    assert ctx.worker is ctx.workers[0]
+    assert ctx.context.mt_workers_shared
+
+    async def echo_server(ep):
+        msg = np.empty(10, dtype="u1")
+        await ep.recv(msg)
+        await ep.send(msg)
+        await ep.close()
+
+    listener = ucxx.create_listener(echo_server)
+    clients = [
+        await ucxx.create_endpoint(ucxx.get_address(), listener.port) for _ in range(2)
+    ]
+
+    for client in clients:
+        msg = np.arange(10, dtype="u1")
+        resp = np.empty_like(msg)
+        await client.send(msg)
+        await client.recv(resp)
+        np.testing.assert_array_equal(resp, msg)
+
+    client_workers = {client.ucp_worker for client in clients}
+    if worker_selection == "round-robin":
+        assert client_workers == {w.handle for w in ctx.workers}
+    else:
+        # Endpoints to the same peer are always assigned to the same worker
+        assert len(client_workers) == 1
+
+    for client in clients:
+        await client.close()
+    await wait_listener_client_handlers(listener)
+
+
+@pytest.mark.asyncio
+@pytest.mark.parametrize("exchange_peer_info_mode", ["round-trip", "one-way"])
+async def test_exchange_peer_info_mode(exchange_peer_info_mode):
+    ucxx.init(exchange_peer_info_mode=exchange_peer_info_mode)
+    assert ucxx.core._get_ctx().exchange_peer_info_mode == exchange_peer_info_mode
+
+    async def echo_server(ep):
+        msg = np.empty(10, dtype="u1")
+        await ep.recv(msg)
+        await ep.send(msg)
+        await ep.close()
+
+    listener = ucxx.create_listener(echo_server)
+    client = await ucxx.create_endpoint(ucxx.get_address(), listener.port)
+
+    msg = np.arange(10, dtype="u1")
+    resp = np.empty_like(msg)
+    await client.send(msg)
+    await client.recv(resp)
+    np.testing.assert_array_equal(resp, msg)
+
+    await client.close()
+    await wait_listener_client_handlers(listener)
+
+
+def test_invalid_exchange_peer_info_mode():
+    with pytest.raises(ValueError, match="Unknown exchange peer info mode"):
+        ucxx.init(exchange_peer_info_mode="invalid")
@@ -0,0 +1,441 @@
+# SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""
+Benchmark all-to-all shuffle between multiple processes on one machine
+
+Each rank runs in its own process and creates endpoints to all other ranks, then
+in each iteration sends one message of `--n-bytes` to every other rank while
+receiving one message from each of them, as in the shuffle stage of a distributed
+join or sort. Each rank sends to its peers in a staggered order (rank + 1, rank + 2,
+...) so that no single rank receives from all others at once.
+"""
+import argparse
+import asyncio
+import multiprocessing as mp
+from time import monotonic
+
+import numpy as np
+from ucxx._lib.arr import Array
+from ucxx._lib_async.utils import get_event_loop
+from ucxx.benchmarks.backends.ucxx_async import (
+    register_am_allocators as register_am_allocators_async,
+)
+from ucxx.benchmarks.backends.ucxx_core import (
+    _create_cuda_context,
+    _wait_requests,
+    register_am_allocators,
+)
+from ucxx.benchmarks.utils import _ensure_cuda_device, get_allocator
+from ucxx.utils import (
+    format_bytes,
+    parse_bytes,
+    print_key_value,
+    print_separator,
+)
+
+import ucxx
+
+mp = mp.get_context("spawn")
+
+
+def _peers(rank, n_ranks):
+    return [(rank + i) % n_ranks for i in range(1, n_ranks)]
+
+
+def _progress(worker, progress_mode):
+    if progress_mode == "blocking":
+        worker.progress_worker_event()
+    elif progress_mode == "polling":
+        worker.progress()
+
+
+def _run_core(rank, address, port_queue, rank_queue, args):
+    import ucxx._lib.libucxx as ucx_api
+
+    # Active Messages are always enabled, they are required to identify the rank
+    # of endpoints created by the listener.
+    ctx = ucx_api.UCXContext(
+        feature_flags=(
+            ucx_api.Feature.TAG,
+            ucx_api.Feature.AM,
+            ucx_api.Feature.WAKEUP,
+        )
+    )
+    worker = ucx_api.UCXWorker(ctx)
+
+    xp = get_allocator(
+        args.object_type, args.rmm_init_pool_size, args.rmm_managed_memory
+    )
+    register_am_allocators(args, worker)
+
+    if args.progress_mode.startswith("thread"):
+        worker.set_progress_thread_start_callback(
+            _create_cuda_context, cb_args=(rank,)
+        )
+        polling_mode = args.progress_mode == "thread-polling"
+        worker.start_progress_thread(polling_mode=polling_mode)
+    else:
+        worker.init_blocking_progress_mode()
+
+    accepted = []
+
+    def _listener_handler(conn_request):
+        accepted.append(
+            listener.create_endpoint_from_conn_request(
+                conn_request, endpoint_error_handling=args.error_handling
+            )
+        )
+
+    listener = ucx_api.UCXListener.create(
+        worker=worker, port=0, cb_func=_listener_handler
+    )
+    port_queue.put((rank, listener.port))
+    ports = rank_queue.get()
+
+    # Connect to all higher ranks, and accept connections from all lower ranks.
+    eps = {}
+    send_requests = []
+    rank_msg = Array(np.array([rank], dtype=np.uint64))
+    for peer in range(rank + 1, args.n_ranks):
+        eps[peer] = ucx_api.UCXEndpoint.create(
+            worker,
+            address,
+            ports[peer],
+            endpoint_error_handling=args.error_handling,
+        )
+        send_requests.append(eps[peer].am_send(rank_msg))
+    while len(accepted) != rank:
+        _progress(worker, args.progress_mode)
+    recv_requests = [ep.am_recv() for ep in accepted]
+    _wait_requests(worker, args.progress_mode, send_requests + recv_requests)
+    for r in send_requests:
+        r.check_error()
+    for ep, r in zip(accepted, recv_requests):
+        r.check_error()
+        peer = int(np.frombuffer(r.recv_buffer, dtype=np.uint64)[0])
+        eps[peer] = ep
+
+    peers = _peers(rank, args.n_ranks)
+    send_msg = Array(xp.arange(args.n_bytes, dtype="u1"))
+    recv_msgs = {p: Array(xp.zeros(args.n_bytes, dtype="u1")) for p in peers}
+
+    times = []
+    for i in range(args.n_iter + args.n_warmup_iter):
+        start = monotonic()
+
+        if args.enable_am:
+            requests = [eps[p].am_recv() for p in peers]
+            requests += [eps[p].am_send(send_msg) for p in peers]
+        else:
+            requests = [
+                eps[p].tag_recv(recv_msgs[p], tag=ucx_api.UCXXTag(p)) for p in peers
+            ]
+            requests += [
+                eps[p].tag_send(send_msg, tag=ucx_api.UCXXTag(rank)) for p in peers
+            ]
+        _wait_requests(worker, args.progress_mode, requests)
+
+        stop = monotonic()
+        for r in requests:
+            r.check_error()
+        if i >= args.n_warmup_iter:
+            times.append(stop - start)
+
+    return times
+
+
+async def _run_async(rank, address, port_queue, rank_queue, args):
+    ucxx.init(progress_mode=args.progress_mode)
+
+    xp = get_allocator(
+        args.object_type, args.rmm_init_pool_size, args.rmm_managed_memory
+    )
+    register_am_allocators_async(args)
+
+    eps = {}
+
+    async def _listener_handler(ep):
+        peer = np.empty((1,), dtype=np.uint64)
+        await ep.recv(peer)
+        eps[int(peer[0])] = ep
+
+    listener = ucxx.create_listener(_listener_handler)
+    port_queue.put((rank, listener.port))
+    ports = await get_event_loop().run_in_executor(None, rank_queue.get)
+
+    # Connect to all higher ranks, and accept connections from all lower ranks.
+    for peer in range(rank + 1, args.n_ranks):
+        ep = await ucxx.create_endpoint(
+            address, ports[peer], endpoint_error_handling=args.error_handling
+        )
+        await ep.send(np.array([rank], dtype=np.uint64))
+        eps[peer] = ep
+    while len(eps) != args.n_ranks - 1:
+        await asyncio.sleep(0.01)
+
+    peers = _peers(rank, args.n_ranks)
+    send_msg = xp.arange(args.n_bytes, dtype="u1")
+    recv_msgs = {p: xp.zeros(args.n_bytes, dtype="u1") for p in peers}
+
+    times = []
+    for i in range(args.n_iter + args.n_warmup_iter):
+        start = monotonic()
+
+        if args.enable_am:
+            await asyncio.gather(
+                *[eps[p].am_recv() for p in peers],
+                *[eps[p].am_send(send_msg) for p in peers],
+            )
+        else:
+            await asyncio.gather(
+                *[eps[p].recv(recv_msgs[p]) for p in peers],
+                *[eps[p].send(send_msg) for p in peers],
+            )
+
+        stop = monotonic()
+        if i >= args.n_warmup_iter:
+            times.append(stop - start)
+
+    return times
+
+
+def rank_process(rank, address, port_queue, rank_queue, result_queue, args):
+    if args.object_type != "numpy":
+        _ensure_cuda_device(args.devs, rank)
+
+    if args.backend == "ucxx-core":
+        times = _run_core(rank, address, port_queue, rank_queue, args)
+    else:
+        loop = get_event_loop()
+        times = loop.run_until_complete(
+            _run_async(rank, address, port_queue, rank_queue, args)
+        )
+
+    result_queue.put((rank, times))
+
+    # Wait for all ranks to complete before tearing down endpoints, otherwise
+    # peers may see their endpoints closed while still transferring.
+    rank_queue.get()
+
+    if args.backend == "ucxx-async":
+        ucxx.stop_notifier_thread()
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="All-to-all shuffle benchmark")
+    if callable(parse_bytes):
+        parser.add_argument(
+            "-n",
+            "--n-bytes",
+            metavar="BYTES",
+            default="10 Mb",
+            type=parse_bytes,
+            help="Message size sent to each peer. Default '10 Mb'.",
+        )
+    else:
+        parser.add_argument(
+            "-n",
+            "--n-bytes",
+            metavar="BYTES",
+            default=10_000_000,
+            type=int,
+            help="Message size sent to each peer in bytes. Default '10_000_000'.",
+        )
+    parser.add_argument(
+        "-r",
+        "--n-ranks",
+        metavar="N",
+        default=None,
+        type=int,
+        help="Number of ranks (processes) participating in the shuffle (default: "
+        "number of devices in `--devs`, or 2 if that is a single device).",
+    )
+    parser.add_argument(
+        "--n-iter",
+        metavar="N",
+        default=10,
+        type=int,
+        help="Number of shuffle iterations (default 10).",
+    )
+    parser.add_argument(
+        "--n-warmup-iter",
+        default=10,
+        type=int,
+        help="Number of shuffle warmup iterations (default 10).",
+    )
+    parser.add_argument(
+        "-o",
+        "--object_type",
+        default="numpy",
+        choices=["numpy", "cupy", "rmm"],
+        help="In-memory array type.",
+    )
+    parser.add_argument(
+        "-d",
+        "--devs",
+        metavar="LIST",
+        default="0",
+        type=str,
+        help='GPU devices to use, ranks are assigned round-robin (default "0").',
+    )
+    parser.add_argument(
+        "-s",
+        "--address",
+        metavar="ip",
+        default=ucxx.utils.get_address(),
+        type=str,
+        help="Address ranks listen on (default `ucxx.utils.get_address()`).",
+    )
+    parser.add_argument(
+        "--rmm-init-pool-size",
+        metavar="BYTES",
+        default=None,
+        type=int,
+        help="Initial RMM pool size (default  1/2 total GPU memory)",
+    )
+    parser.add_argument(
+        "--rmm-managed-memory",
+        default=False,
+        action="store_true",
+        help="Use RMM managed memory (requires `--object-type rmm`)",
+    )
+    parser.add_argument(
+        "--enable-am",
+        default=False,
+        action="store_true",
+        help="Use Active Message API instead of TAG for transfers",
+    )
+    parser.add_argument(
+        "--no-detailed-report",
+        default=False,
+        action="store_true",
+        help="Disable detailed report per iteration.",
+    )
+    parser.add_argument(
+        "-l",
+        "--backend",
+        default="ucxx-async",
+        type=str,
+        help="Backend Library (-l) to use, options are: 'ucxx-async' (default) "
+        "and 'ucxx-core'.",
+    )
+    parser.add_argument(
+        "--progress-mode",
+        default="thread",
+        help="Progress mode for the UCP worker. Valid options are: "
+        "'thread' (default), 'thread-polling', 'blocking' and 'polling'.",
+        type=str,
+    )
+    parser.add_argument(
+        "--error-handling",
+        action=argparse.BooleanOptionalAction,
+        default=True,
+        help="Enable endpoint error handling.",
+    )
+
+    args = parser.parse_args()
+
+    args.devs = [int(d) for d in args.devs.split(",")]
+    if args.n_ranks is None:
+        args.n_ranks = max(len(args.devs), 2)
+
+    if args.n_ranks < 2:
+        raise RuntimeError("`--n-ranks` must be greater than 1")
+    if args.rmm_managed_memory and args.object_type != "rmm":
+        raise RuntimeError("`--rmm-managed-memory` requires `--object_type=rmm`")
+    if args.backend not in ["ucxx-async", "ucxx-core"]:
+        raise RuntimeError(f"Invalid `--backend`: '{args.backend}'")
+    if args.progress_mode not in ["blocking", "polling", "thread", "thread-polling"]:
+        raise RuntimeError(f"Invalid `--progress-mode`: '{args.progress_mode}'")
+
+    return args
+
+
+def main():
+    args = parse_args()
+
+    port_queue = mp.Queue()
+    result_queue = mp.Queue()
+    rank_queues = [mp.Queue() for _ in range(args.n_ranks)]
+    processes = [
+        mp.Process(
+            target=rank_process,
+            args=(
+                rank,
+                args.address,
+                port_queue,
+                rank_queues[rank],
+                result_queue,
+                args,
+            ),
+        )
+        for rank in range(args.n_ranks)
+    ]
+    for p in processes:
+        p.start()
+
+    # Distribute the listener ports of all ranks, then wait for all to complete.
+    ports = dict(port_queue.get() for _ in range(args.n_ranks))
+    for q in rank_queues:
+        q.put(ports)
+    results = dict(result_queue.get() for _ in range(args.n_ranks))
+    for q in rank_queues:
+        q.put(None)
+
+    for p in processes:
+        p.join()
+        assert not p.exitcode
+
+    # Each rank sends `n_bytes` to and receives `n_bytes` from every other rank per
+    # iteration, the aggregate bandwidth is bound by the slowest rank.
+    times = np.array([results[rank] for rank in range(args.n_ranks)])
+    assert times.shape == (args.n_ranks, args.n_iter)
+    rank_bytes = (args.n_ranks - 1) * args.n_bytes
+    total_bytes = args.n_ranks * rank_bytes
+    iter_times = times.max(axis=0)
+
+    bw_rank = rank_bytes * args.n_iter / times.sum(axis=1)
+    bw_avg = format_bytes(total_bytes * args.n_iter / iter_times.sum())
+    bw_med = format_bytes(total_bytes / np.median(iter_times))
+
+    print("All-to-all shuffle benchmark")
+    print_separator(separator="=")
+    print_key_value(key="Iterations", value=f"{args.n_iter}")
+    print_key_value(key="Ranks", value=f"{args.n_ranks}")
+    print_key_value(key="Bytes per peer", value=f"{format_bytes(args.n_bytes)}")
+    print_key_value(key="Bytes per iteration", value=f"{format_bytes(total_bytes)}")
+    print_key_value(key="Object type", value=f"{args.object_type}")
+    print_key_value(key="Backend", value=f"{args.backend}")
+    print_key_value(
+        key="Transfer API", value=f"{'AM' if args.enable_am else 'TAG'}"
+    )
+    print_key_value(key="Progress mode", value=f"{args.progress_mode}")
+    print_key_value(key="UCX_TLS", value=f"{ucxx.get_config()['TLS']}")
+    print_key_value(key="UCX_NET_DEVICES", value=f"{ucxx.get_config()['NET_DEVICES']}")
+    print_separator(separator="=")
+    if args.object_type == "numpy":
+        print_key_value(key="Device(s)", value="CPU-only")
+    else:
+        print_key_value(key="Device(s)", value=f"{args.devs}")
+    print_separator(separator="=")
+    print_key_value("Aggregate bandwidth (average)", value=f"{bw_avg}/s")
+    print_key_value("Aggregate bandwidth (median)", value=f"{bw_med}/s")
+    print_key_value("Rank bandwidth (min)", value=f"{format_bytes(bw_rank.min())}/s")
+    print_key_value("Rank bandwidth (max)", value=f"{format_bytes(bw_rank.max())}/s")
+    print_separator(separator="=")
+    print_key_value(key="Ranks", value="Bandwidth")
+    print_separator(separator="-")
+    for rank, bw in enumerate(bw_rank):
+        print_key_value(key=rank, value=f"{format_bytes(bw)}/s")
+    if not args.no_detailed_report:
+        print_separator(separator="=")
+        print_key_value(key="Iterations", value="Aggregate bandwidth, Wall-clock")
+        print_separator(separator="-")
+        for i, t in enumerate(iter_times):
+            ts = format_bytes(total_bytes / t)
+            print_key_value(key=i, value=f"{ts}/s, {int(t * 1e9)}ns")
+
+
+if __name__ == "__main__":
+    main()
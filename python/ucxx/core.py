@@ -9,7 +9,7 @@ import weakref
 
 from ._lib import libucxx as ucx_api
 from ._lib.libucxx import UCXError
-from ._lib_async import ApplicationContext
+from ._lib_async import ApplicationContext, StripedEndpoint  # noqa
 
 logger = logging.getLogger("ucx")
 
@@ -35,6 +35,9 @@ def init(
     progress_mode=None,
     enable_delayed_submission=None,
     enable_python_future=None,
+    n_workers=None,
+    worker_selection=None,
+    exchange_peer_info_mode=None,
 ):
     """Initiate UCX.
 
@@ -59,6 +62,21 @@ def init(
     enable_python_future: boolean, optional
         If None, request notification via Python futures is disabled unless
         `UCXPY_ENABLE_PYTHON_FUTURE` is defined with a value other than `0`.
+    n_workers: int, optional
+        If None, a single worker is used unless `UCXPY_N_WORKERS` is defined.
+        Otherwise the number of UCX workers to create, each progressed
+        independently, that endpoints and listeners are distributed among.
+    worker_selection: string, optional
+        If None, 'round-robin' is used unless `UCXPY_WORKER_SELECTION` is
+        defined. Otherwise the options are 'round-robin' or 'hash', the latter
+        always assigning endpoints to the same peer to the same worker.
+    exchange_peer_info_mode: string, optional
+        If None, 'round-trip' is used unless `UCXPY_EXCHANGE_PEER_INFO_MODE` is
+        defined. Otherwise the options are 'round-trip', where both ends exchange
+        their tags after connecting, or 'one-way', where the client chooses the
+        tags of both ends and sends them to the listener without waiting for a
+        reply, saving a round trip before endpoints are ready. All processes that
+        connect to each other must use the same mode.
     """
     global _ctx
     if _ctx is not None:
@@ -86,6 +104,9 @@ def init(
         progress_mode=progress_mode,
         enable_delayed_submission=enable_delayed_submission,
         enable_python_future=enable_python_future,
+        n_workers=n_workers,
+        worker_selection=worker_selection,
+        exchange_peer_info_mode=exchange_peer_info_mode,
     )
 
 
@@ -138,7 +159,8 @@ def progress():
     Warning, it is illegal to call this from a call-back function such as
     the call-back function given to create_listener.
     """
-    return _get_ctx().worker.progress()
+    for worker in _get_ctx().workers:
+        worker.progress()
 
 
 def get_config():
@@ -195,6 +217,13 @@ async def create_endpoint_from_worker_address(
     )
 
 
+async def close_endpoints(endpoints):
+    """Close multiple endpoints concurrently, see
+    `ApplicationContext.close_endpoints()`.
+    """
+    await _get_ctx().close_endpoints(endpoints)
+
+
 def get_ucp_context_info():
     """Gets information on the current UCX context, obtained from
     `ucp_context_print_info`.
@@ -231,12 +260,20 @@ def get_ucxx_worker():
     return _get_ctx().ucxx_worker
 
 
+def get_worker_statistics():
+    """Returns a snapshot of the statistics of each worker as a list of dicts,
+    with counters of requests submitted, completed, failed, canceled and delayed,
+    of worker progress and of delayed submission processing time.
+    """
+    return _get_ctx().worker_statistics
+
+
 def get_worker_address():
     return _get_ctx().worker_address
 
 
 def get_ucx_address_from_buffer(buffer):
-    return ucx_api.UCXAddress.create_from_buffer(bytes(buffer))
+    return ucx_api.UCXAddress.create_from_buffer(buffer)
 
 
 async def recv(buffer, tag):